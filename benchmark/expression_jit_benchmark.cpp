@@ -15,7 +15,8 @@ int main() {
     std::cout << "llvm_jit=unavailable\n";
     return 0;
   }
-  std::cout << "compile_ms=" << kernel->CompileMilliseconds() << "\n";
+  std::cout << "compile_ms=" << kernel->CompileMilliseconds()
+            << " object_cache_hit=" << kernel->LoadedFromCache() << "\n";
   size_t break_even = 0;
   volatile uint64_t checksum = 0;
   for (size_t rows : {64U, 256U, 1024U, 4096U, 16384U, 65536U,
@@ -0,0 +1,94 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+// Build sizes from 1K to 100M rows joined by a chained hash table (the
+// kInMemory join's structure) and by the radix join. An optional argument
+// caps the largest build size, e.g. `tinylamb_radix_join_benchmark 10000000`
+// on machines without ~8 GiB to spare for the 100M step.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "executor/hash_join_mode.hpp"
+#include "executor/join_hash_table.hpp"
+#include "executor/radix_join.hpp"
+
+namespace {
+
+// Per-slot match counter on its own cache line.
+struct alignas(64) SlotCount {
+  size_t value{0};
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  using Clock = std::chrono::steady_clock;
+  const size_t max_rows =
+      argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+  const size_t workers = tinylamb::JoinWorkerCount(max_rows);
+  std::cout << "partition_bytes=" << tinylamb::RadixPartitionBytes()
+            << " radix_threshold_bytes="
+            << tinylamb::RadixJoinThresholdBytes() << " workers=" << workers
+            << "\n";
+  std::mt19937_64 random(42);
+  for (size_t rows = 1000; rows <= max_rows; rows *= 10) {
+    // Every probe key matches exactly one build key, in shuffled order.
+    std::vector<int64_t> build_keys(rows);
+    std::iota(build_keys.begin(), build_keys.end(), int64_t{0});
+    std::vector<int64_t> probe_keys = build_keys;
+    std::shuffle(probe_keys.begin(), probe_keys.end(), random);
+
+    const auto chained_begin = Clock::now();
+    size_t chained_matches = 0;
+    {
+      std::unordered_multimap<int64_t, uint64_t> table;
+      table.reserve(rows);
+      for (size_t i = 0; i < rows; ++i) table.emplace(build_keys[i], i);
+      for (const int64_t key : probe_keys) {
+        const auto [begin, end] = table.equal_range(key);
+        chained_matches += static_cast<size_t>(std::distance(begin, end));
+      }
+    }
+    const double chained_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - chained_begin)
+            .count();
+
+    const auto radix_begin = Clock::now();
+    std::vector<SlotCount> slot_matches(workers);
+    const std::vector<int> pass_bits =
+        tinylamb::RadixPassBits(rows, tinylamb::RadixPartitionBytes());
+    {
+      std::vector<tinylamb::RadixTuple> build(rows);
+      std::vector<tinylamb::RadixTuple> probe(rows);
+      for (size_t i = 0; i < rows; ++i) {
+        build[i] = {tinylamb::FlatHash(build_keys[i]), i};
+        probe[i] = {tinylamb::FlatHash(probe_keys[i]), i};
+      }
+      tinylamb::RadixHashJoin(
+          std::move(build), std::move(probe), pass_bits, workers,
+          [&](size_t slot, uint64_t probe_index, uint64_t build_index) {
+            slot_matches[slot].value +=
+                probe_keys[probe_index] == build_keys[build_index];
+          },
+          [] {});
+    }
+    const double radix_ms =
+        std::chrono::duration<double, std::milli>(Clock::now() - radix_begin)
+            .count();
+    size_t radix_matches = 0;
+    for (const SlotCount& count : slot_matches) radix_matches += count.value;
+
+    int bits = 0;
+    for (const int pass : pass_bits) bits += pass;
+    std::cout << "rows=" << rows << " passes=" << pass_bits.size()
+              << " partitions=" << (size_t{1} << bits)
+              << " chained_ms=" << chained_ms << " radix_ms=" << radix_ms
+              << " matches=" << chained_matches << "/" << radix_matches
+              << "\n";
+  }
+}
@@ -0,0 +1,22 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_COMMON_HASH_HPP
+#define TINYLAMB_COMMON_HASH_HPP
+
+#include <cstdint>
+
+namespace tinylamb {
+
+// MurmurHash3's fmix64 finalizer: every input bit reaches every output bit,
+// so both the low and the high bits of the result are usable.
+[[nodiscard]] constexpr uint64_t Fmix64(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_COMMON_HASH_HPP
@@ -63,6 +63,7 @@ Database::Database(std::string_view dbname)
     LOG(FATAL) << "Failed to initialize relations";
     exit(1);
   }
+  storage_.tm_.SetTableWriteObserver(&materialized_views_);
 }
 
 std::ostream& operator<<(std::ostream& o, const Database& db) {
@@ -150,6 +151,7 @@ StatusOr<Table> Database::CreateTable(TransactionContext& ctx,
       Status::kNotExists) {
     return Status::kConflicts;
   }
+  ctx.txn_.NoteTableWrite(schema.Name());
   PageRef table_page =
       storage_.pm_.AllocateNewPage(ctx.txn_, PageType::kRowPage);
   Table new_table(schema, table_page->PageID());
@@ -178,6 +180,7 @@ StatusOr<Table> Database::CreateTable(TransactionContext& ctx,
 Status Database::DropTable(TransactionContext& ctx,
                            std::string_view schema_name) {
   ASSIGN_OR_RETURN(Table, tbl, GetTable(ctx, schema_name));
+  ctx.txn_.NoteTableWrite(schema_name);
   const Schema& schema = tbl.GetSchema();
   for (slot_t column = 0; column < schema.ColumnCount(); ++column) {
     const Status deleted = statistics_.Delete(
@@ -192,9 +195,20 @@ Status Database::DropTable(TransactionContext& ctx,
       return deleted;
     }
   }
+  materialized_views_.TableDropped(schema_name);
   return catalog_.Delete(ctx.txn_, schema_name);
 }
 
+Status Database::CreateMaterializedView(TransactionContext& ctx,
+                                        const std::string& name,
+                                        const SelectStatement& definition) {
+  return materialized_views_.Create(ctx, name, definition);
+}
+
+Status Database::DropMaterializedView(std::string_view name) {
+  return materialized_views_.Drop(name);
+}
+
 Status Database::CreateIndex(TransactionContext& ctx,
                              std::string_view schema_name,
                              const IndexSchema& idx) {
@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "common/constants.hpp"
+#include "database/materialized_view.hpp"
 #include "database/page_storage.hpp"
 #include "database/transaction_context.hpp"
 #include "index/b_plus_tree.hpp"
@@ -41,6 +42,7 @@ class IndexSchema;
 class TableStatistics;
 class PageStorage;
 class Function;
+class SelectStatement;
 
 class Database {
  public:
@@ -59,6 +61,18 @@ class Database {
   Status CreateIndex(TransactionContext& ctx, std::string_view schema_name,
                      const IndexSchema& idx);
 
+  // Creates an incrementally maintained view of `definition`, a GROUP BY
+  // query over one table or two joined tables (see MaterializedView).
+  // Views are kept in memory, not in the catalog. Throws
+  // std::invalid_argument for definitions it cannot maintain.
+  Status CreateMaterializedView(TransactionContext& ctx,
+                                const std::string& name,
+                                const SelectStatement& definition);
+
+  Status DropMaterializedView(std::string_view name);
+
+  MaterializedViews& GetMaterializedViews() { return materialized_views_; }
+
   StatusOr<Function> GetOrAddFunction(TransactionContext& ctx,
                                       std::string_view function_name,
                                       int argument_count);
@@ -100,6 +114,10 @@ class Database {
   // Persistent { Name => Function } storage.
   BPlusTree functions_;
 
+  // Declared before storage_ so it outlives the TransactionManager that
+  // reports writes to it.
+  MaterializedViews materialized_views_;
+
   PageStorage storage_;
 };
 
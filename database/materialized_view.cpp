@@ -0,0 +1,733 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+
+#include "database/materialized_view.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_set>
+#include <utility>
+
+#include "database/transaction_context.hpp"
+#include "executor/sort_key.hpp"
+#include "expression/aggregate_expression.hpp"
+#include "expression/binary_expression.hpp"
+#include "expression/column_value.hpp"
+#include "expression/named_expression.hpp"
+#include "expression/rewrite.hpp"
+#include "parser/ast.hpp"
+#include "table/iterator.hpp"
+#include "table/table.hpp"
+#include "transaction/transaction.hpp"
+#include "transaction/transaction_manager.hpp"
+
+namespace tinylamb {
+namespace {
+
+// Source tables of a statement and the names its columns may use for them.
+struct Sources {
+  std::vector<std::string> tables;
+  const std::vector<Schema>* schemas;
+  std::unordered_map<std::string, std::string> aliases;
+};
+
+bool HasColumn(const Schema& schema, const std::string& name) {
+  return schema.Offset(ColumnName(name)) >= 0;
+}
+
+// `expression` with every column reference qualified by its table name.
+Expression Qualify(const Expression& expression, const Sources& sources) {
+  if (!expression) return expression;
+  if (expression->Type() == TypeTag::kQueryExp) {
+    throw std::invalid_argument("subqueries are not supported");
+  }
+  if (expression->Type() == TypeTag::kColumnValue) {
+    const ColumnName& column = expression->AsColumnValue().GetColumnName();
+    if (column.name == "*") return expression;
+    if (!column.schema.empty()) {
+      const auto alias = sources.aliases.find(column.schema);
+      if (alias == sources.aliases.end()) {
+        throw std::invalid_argument("unknown table " + column.schema);
+      }
+      return ColumnValueExp(ColumnName(alias->second, column.name));
+    }
+    const std::string* found = nullptr;
+    for (size_t i = 0; i < sources.tables.size(); ++i) {
+      if (!HasColumn((*sources.schemas)[i], column.name)) continue;
+      if (found != nullptr) {
+        throw std::invalid_argument("ambiguous column " + column.name);
+      }
+      found = &sources.tables[i];
+    }
+    if (found == nullptr) {
+      throw std::invalid_argument("unknown column " + column.name);
+    }
+    return ColumnValueExp(ColumnName(*found, column.name));
+  }
+  std::vector<Expression> children = ExpressionChildren(expression);
+  if (children.empty()) return expression;
+  for (Expression& child : children) child = Qualify(child, sources);
+  return WithExpressionChildren(expression, std::move(children));
+}
+
+bool TouchesColumns(const Expression& expression) {
+  return !expression->TouchedColumns().empty();
+}
+
+std::vector<std::string> Texts(const std::vector<Expression>& expressions) {
+  std::vector<std::string> texts;
+  texts.reserve(expressions.size());
+  for (const Expression& expression : expressions) {
+    texts.push_back(expression->ToString());
+  }
+  return texts;
+}
+
+std::vector<std::string> SortedTexts(
+    const std::vector<Expression>& expressions) {
+  std::vector<std::string> texts = Texts(expressions);
+  std::ranges::sort(texts);
+  return texts;
+}
+
+bool Numeric(const Value& value) {
+  return value.IsNull() || value.type == ValueType::kInt64 ||
+         value.type == ValueType::kDouble;
+}
+
+}  // namespace
+
+AggregateShape::AggregateShape(const SelectStatement& select,
+                               const std::vector<Schema>& source_schemas)
+    : schemas(source_schemas) {
+  if (!select.WithQueries().empty() || select.Distinct() || select.Having()) {
+    throw std::invalid_argument(
+        "WITH, SELECT DISTINCT and HAVING are not supported");
+  }
+  const std::vector<SelectSource>& sources = select.Sources();
+  if (sources.empty() || 2 < sources.size()) {
+    throw std::invalid_argument("one or two tables are supported");
+  }
+  Sources resolver{{}, &schemas, select.Aliases()};
+  std::vector<Expression> conjuncts = SplitConjuncts(select.WhereClause());
+  for (const SelectSource& source : sources) {
+    if (source.query || source.table.empty() || source.sample ||
+        (source.join_type != JoinType::kCross &&
+         source.join_type != JoinType::kInner)) {
+      throw std::invalid_argument(
+          "only inner joins of unsampled tables are supported");
+    }
+    tables.push_back(source.table);
+    resolver.aliases[source.table] = source.table;
+    resolver.aliases[source.alias.empty() ? source.table : source.alias] =
+        source.table;
+    for (Expression& conjunct : SplitConjuncts(source.join_condition)) {
+      conjuncts.push_back(std::move(conjunct));
+    }
+  }
+  if (schemas.size() != tables.size()) {
+    throw std::invalid_argument("schema count does not match tables");
+  }
+  if (tables.size() == 2 && tables[0] == tables[1]) {
+    throw std::invalid_argument("self joins are not supported");
+  }
+  resolver.tables = tables;
+  input = tables.size() == 1 ? schemas[0] : schemas[0] + schemas[1];
+
+  for (const Expression& conjunct : conjuncts) {
+    Expression qualified = Qualify(conjunct, resolver);
+    if (tables.size() == 2 && join_keys.empty() &&
+        qualified->Type() == TypeTag::kBinaryExp &&
+        qualified->AsBinaryExpression().Op() == BinaryOperation::kEquals) {
+      const Expression& left = qualified->AsBinaryExpression().Left();
+      const Expression& right = qualified->AsBinaryExpression().Right();
+      if (TouchesColumns(left) && TouchesColumns(right)) {
+        if (ReferencesOnly(left, {tables[0]}) &&
+            ReferencesOnly(right, {tables[1]})) {
+          join_keys = {left, right};
+          continue;
+        }
+        if (ReferencesOnly(left, {tables[1]}) &&
+            ReferencesOnly(right, {tables[0]})) {
+          join_keys = {right, left};
+          continue;
+        }
+      }
+    }
+    filters.push_back(std::move(qualified));
+  }
+  if (tables.size() == 2 && join_keys.empty()) {
+    throw std::invalid_argument("a join needs an equality between its tables");
+  }
+
+  for (const Expression& group : select.GroupBy()) {
+    groups.push_back(Qualify(group, resolver));
+  }
+  const std::vector<std::string> group_texts = Texts(groups);
+  std::vector<std::string> item_texts;
+  for (const NamedExpression& select_item : select.SelectList()) {
+    const Expression qualified = Qualify(select_item.expression, resolver);
+    Item item;
+    item.name =
+        select_item.name.empty() ? qualified->ToString() : select_item.name;
+    if (qualified->Type() == TypeTag::kAggregateExp) {
+      const AggregateExpression& aggregate =
+          qualified->AsAggregateExpression();
+      if (aggregate.Distinct() ||
+          aggregate.GetType() == AggregationType::kApproxCountDistinct) {
+        throw std::invalid_argument("DISTINCT aggregates are not supported");
+      }
+      item.type = aggregate.GetType();
+      item.argument = aggregate.Child();
+      if (item.type == AggregationType::kCount &&
+          item.argument->Type() == TypeTag::kColumnValue &&
+          item.argument->AsColumnValue().GetColumnName().name == "*") {
+        item.argument = nullptr;
+      }
+    } else {
+      const auto found = std::ranges::find(group_texts, qualified->ToString());
+      if (found == group_texts.end()) {
+        throw std::invalid_argument(item.name +
+                                    " is neither grouped nor aggregated");
+      }
+      item.group = static_cast<int>(found - group_texts.begin());
+    }
+    item_texts.push_back(qualified->ToString());
+    items.push_back(std::move(item));
+  }
+
+  for (const SelectStatement::OrderByTerm& term : select.OrderBy()) {
+    std::optional<size_t> index;
+    if (term.expression->Type() == TypeTag::kColumnValue &&
+        term.expression->AsColumnValue().GetColumnName().schema.empty()) {
+      const std::string& name =
+          term.expression->AsColumnValue().GetColumnName().name;
+      for (size_t i = 0; i < items.size() && !index; ++i) {
+        if (items[i].name == name) index = i;
+      }
+    }
+    if (!index) {
+      const auto found = std::ranges::find(
+          item_texts, Qualify(term.expression, resolver)->ToString());
+      if (found == item_texts.end()) {
+        throw std::invalid_argument("ORDER BY must name an output column");
+      }
+      index = static_cast<size_t>(found - item_texts.begin());
+    }
+    order_by.push_back({*index, term.ascending});
+  }
+  limit = select.Limit();
+  offset = select.Offset();
+}
+
+MaterializedView::MaterializedView(std::string name,
+                                   const SelectStatement& definition,
+                                   const std::vector<Schema>& schemas)
+    : name_(std::move(name)), shape_(definition, schemas) {
+  if (!shape_.order_by.empty() || shape_.limit != 0 || shape_.offset != 0) {
+    throw std::invalid_argument(
+        "a materialized view cannot have ORDER BY, LIMIT or OFFSET");
+  }
+  for (const AggregateShape::Item& item : shape_.items) {
+    if (item.group >= 0 || !item.argument) continue;
+    const std::string text = item.argument->ToString();
+    auto argument = std::ranges::find(arguments_, text, &Argument::text);
+    if (argument == arguments_.end()) {
+      arguments_.push_back({item.argument, text});
+      argument = std::prev(arguments_.end());
+    }
+    argument->sum |= item.type == AggregationType::kSum ||
+                     item.type == AggregationType::kAvg;
+    argument->extremes |= item.type == AggregationType::kMin ||
+                          item.type == AggregationType::kMax;
+  }
+}
+
+bool MaterializedView::Reads(std::string_view table) const {
+  return std::ranges::find(shape_.tables, table) != shape_.tables.end();
+}
+
+void MaterializedView::RowWritten(const Transaction& txn,
+                                  std::string_view table, const Row* before,
+                                  const Row* after) {
+  std::scoped_lock lock(mutex_);
+  const auto [entry, inserted] = pending_.try_emplace(txn.ID());
+  Pending& pending = entry->second;
+  if (inserted) {
+    pending.generation = generation_;
+    // Rows written before the view was registered were never seen.
+    pending.unusable = txn.ID() < first_txn_;
+  }
+  if (pending.unusable) return;
+  // Deltas of a join view depend on the dimension map of the current state.
+  if (table != shape_.tables[0] ||
+      (IsJoin() && (stale_ || pending.generation != generation_))) {
+    pending.unusable = true;
+    pending.deltas.clear();
+    return;
+  }
+  try {
+    if ((before != nullptr &&
+         !AddDeltas(state_, *before, -1, &pending.deltas)) ||
+        (after != nullptr && !AddDeltas(state_, *after, 1, &pending.deltas))) {
+      pending.unusable = true;
+    }
+  } catch (const std::exception&) {
+    pending.unusable = true;
+  }
+  if (pending.unusable) pending.deltas.clear();
+}
+
+void MaterializedView::TransactionFinished(const Transaction& txn,
+                                           std::optional<uint64_t> commit_ts) {
+  std::scoped_lock lock(mutex_);
+  const auto found = pending_.find(txn.ID());
+  if (found == pending_.end()) {
+    // A writer begun before the view was registered can commit rows the
+    // view never saw, possibly after it was populated without them.
+    if (commit_ts && std::ranges::any_of(shape_.tables, [&](const auto& t) {
+          return txn.WroteTable(t);
+        })) {
+      last_write_ts_ = *commit_ts;
+      stale_ = true;
+      ++generation_;
+      state_ = State{};
+    }
+    return;
+  }
+  const Pending pending = std::move(found->second);
+  pending_.erase(found);
+  if (!commit_ts) return;
+  last_write_ts_ = *commit_ts;
+  if (stale_) return;
+  if (pending.unusable ||
+      (IsJoin() && pending.generation != generation_)) {
+    stale_ = true;
+    ++generation_;
+    state_ = State{};
+    return;
+  }
+  for (const Delta& delta : pending.deltas) Apply(delta, &state_);
+}
+
+void MaterializedView::MarkStale() {
+  std::scoped_lock lock(mutex_);
+  stale_ = true;
+  ++generation_;
+  state_ = State{};
+}
+
+void MaterializedView::ObserveFrom(txn_id_t first_txn) {
+  std::scoped_lock lock(mutex_);
+  first_txn_ = first_txn;
+}
+
+bool MaterializedView::IsStale() const {
+  std::scoped_lock lock(mutex_);
+  return stale_;
+}
+
+size_t MaterializedView::GroupCount() const {
+  std::scoped_lock lock(mutex_);
+  return state_.groups.size();
+}
+
+bool MaterializedView::AddDeltas(const State& state, const Row& row, int sign,
+                                 std::vector<Delta>* out) const {
+  const auto add = [&](const Row& input) {
+    for (const Expression& filter : shape_.filters) {
+      if (!filter->Evaluate(input, shape_.input).Truthy()) return true;
+    }
+    Delta delta;
+    delta.sign = sign;
+    delta.key.values_.reserve(shape_.groups.size());
+    for (const Expression& group : shape_.groups) {
+      delta.key.values_.push_back(group->Evaluate(input, shape_.input));
+    }
+    delta.arguments.reserve(arguments_.size());
+    for (const Argument& argument : arguments_) {
+      delta.arguments.push_back(
+          argument.expression->Evaluate(input, shape_.input));
+      if (argument.sum && !Numeric(delta.arguments.back())) return false;
+    }
+    out->push_back(std::move(delta));
+    return true;
+  };
+  if (!IsJoin()) return add(row);
+  const Value key = shape_.join_keys[0]->Evaluate(row, shape_.schemas[0]);
+  if (key.IsNull()) return true;
+  const auto matches = state.dimension.find(key);
+  if (matches == state.dimension.end()) return true;
+  for (const Row& dimension : matches->second) {
+    if (!add(row + dimension)) return false;
+  }
+  return true;
+}
+
+void MaterializedView::Apply(const Delta& delta, State* state) const {
+  Group& group = state->groups[delta.key];
+  if (group.accumulators.empty()) group.accumulators.resize(arguments_.size());
+  group.rows += delta.sign;
+  for (size_t i = 0; i < arguments_.size(); ++i) {
+    const Value& value = delta.arguments[i];
+    if (value.IsNull()) continue;
+    Accumulator& accumulator = group.accumulators[i];
+    accumulator.count += delta.sign;
+    if (arguments_[i].sum) {
+      if (value.type == ValueType::kDouble) {
+        accumulator.double_sum += delta.sign * value.value.double_value;
+        accumulator.doubles += delta.sign;
+      } else {
+        accumulator.integer_sum += delta.sign * value.value.int_value;
+      }
+    }
+    if (arguments_[i].extremes) {
+      const auto count = accumulator.values.try_emplace(value, 0).first;
+      count->second += delta.sign;
+      if (count->second == 0) accumulator.values.erase(count);
+    }
+  }
+  if (group.rows == 0) state->groups.erase(delta.key);
+}
+
+std::optional<MaterializedView::State> MaterializedView::Compute(
+    TransactionContext& ctx) const {
+  State state;
+  try {
+    std::vector<std::shared_ptr<Table>> tables;
+    for (size_t i = 0; i < shape_.tables.size(); ++i) {
+      StatusOr<std::shared_ptr<Table>> table = ctx.GetTable(shape_.tables[i]);
+      if (!table.HasValue() ||
+          table.Value()->GetSchema() != shape_.schemas[i]) {
+        return std::nullopt;
+      }
+      tables.push_back(table.Value());
+    }
+    if (IsJoin()) {
+      state.dimension_charge = QueryMemoryCharge(
+          MemoryContext::Process().Child("materialized_view"));
+      for (Iterator it = tables[1]->BeginFullScan(ctx.txn_); it.IsValid();
+           ++it) {
+        const Value key = shape_.join_keys[1]->Evaluate(*it, shape_.schemas[1]);
+        if (key.IsNull()) continue;
+        const size_t bytes = EstimateRowBytes(*it);
+        if (!state.dimension_charge.Context().CanReserve(bytes)) {
+          return std::nullopt;
+        }
+        state.dimension_charge.Add(bytes);
+        state.dimension[key].push_back(*it);
+      }
+    }
+    std::vector<Delta> deltas;
+    for (Iterator it = tables[0]->BeginFullScan(ctx.txn_); it.IsValid();
+         ++it) {
+      deltas.clear();
+      if (!AddDeltas(state, *it, 1, &deltas)) return std::nullopt;
+      for (const Delta& delta : deltas) Apply(delta, &state);
+    }
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+  return state;
+}
+
+bool MaterializedView::Refresh(TransactionContext& ctx) {
+  if (ctx.txn_.HasWrites()) return false;
+  const uint64_t snapshot = ctx.txn_.SnapshotTimestamp();
+  uint64_t generation = 0;
+  {
+    std::scoped_lock lock(mutex_);
+    if (!stale_) return last_write_ts_ <= snapshot;
+    generation = generation_;
+  }
+  // Scan without the lock: commits keep folding into pending deltas.
+  std::optional<State> computed = Compute(ctx);
+  if (!computed) return false;
+  std::scoped_lock lock(mutex_);
+  // Install only if no write committed after the scan's snapshot, so the
+  // result is the current state and pending deltas apply on top of it.
+  if (stale_ && generation_ == generation && last_write_ts_ <= snapshot) {
+    state_ = std::move(*computed);
+    stale_ = false;
+    ++generation_;
+    return true;
+  }
+  return !stale_ && last_write_ts_ <= snapshot;
+}
+
+std::optional<std::vector<Row>> MaterializedView::Answer(
+    TransactionContext& ctx, const AggregateShape& query) {
+  // Uncommitted writes of the reader are not in the view.
+  if (ctx.txn_.HasWrites()) return std::nullopt;
+  const uint64_t snapshot = ctx.txn_.SnapshotTimestamp();
+  {
+    std::scoped_lock lock(mutex_);
+    if (!stale_) {
+      if (snapshot < last_write_ts_) return std::nullopt;
+      return Emit(state_, query);
+    }
+  }
+  if (!Emit(State{}, query)) return std::nullopt;
+  if (!Refresh(ctx)) return std::nullopt;
+  std::scoped_lock lock(mutex_);
+  if (stale_ || snapshot < last_write_ts_) return std::nullopt;
+  return Emit(state_, query);
+}
+
+std::optional<std::vector<Row>> MaterializedView::Emit(
+    const State& state, const AggregateShape& query) const {
+  // Map the query onto the view: same tables, join and filters, grouping
+  // by a subset of the view's groups, and aggregates the view keeps.
+  std::vector<std::string> tables = query.tables;
+  std::vector<std::string> own_tables = shape_.tables;
+  std::ranges::sort(tables);
+  std::ranges::sort(own_tables);
+  if (tables != own_tables ||
+      SortedTexts(query.filters) != SortedTexts(shape_.filters)) {
+    return std::nullopt;
+  }
+  for (size_t i = 0; i < query.join_keys.size(); ++i) {
+    const size_t own = query.tables[i] == shape_.tables[i] ? i : 1 - i;
+    if (query.join_keys[i]->ToString() != shape_.join_keys[own]->ToString()) {
+      return std::nullopt;
+    }
+  }
+  const std::vector<std::string> group_texts = Texts(shape_.groups);
+  std::vector<size_t> groups;
+  for (const Expression& group : query.groups) {
+    const auto found = std::ranges::find(group_texts, group->ToString());
+    if (found == group_texts.end()) return std::nullopt;
+    groups.push_back(static_cast<size_t>(found - group_texts.begin()));
+  }
+  std::vector<int> accumulators;
+  for (const AggregateShape::Item& item : query.items) {
+    accumulators.push_back(-1);
+    if (item.group >= 0 || !item.argument) continue;
+    const auto argument = std::ranges::find(
+        arguments_, item.argument->ToString(), &Argument::text);
+    if (argument == arguments_.end()) return std::nullopt;
+    if (((item.type == AggregationType::kSum ||
+          item.type == AggregationType::kAvg) &&
+         !argument->sum) ||
+        ((item.type == AggregationType::kMin ||
+          item.type == AggregationType::kMax) &&
+         !argument->extremes)) {
+      return std::nullopt;
+    }
+    accumulators.back() = static_cast<int>(argument - arguments_.begin());
+  }
+
+  // Fold the view's groups into the query's coarser ones.
+  std::unordered_map<Row, Group> merged;
+  for (const auto& [key, group] : state.groups) {
+    Row projected;
+    projected.values_.reserve(groups.size());
+    for (const size_t index : groups) projected.values_.push_back(key[index]);
+    Group& into = merged[projected];
+    if (into.accumulators.empty()) {
+      into.accumulators.resize(arguments_.size());
+    }
+    into.rows += group.rows;
+    for (size_t i = 0; i < arguments_.size(); ++i) {
+      const Accumulator& from = group.accumulators[i];
+      Accumulator& to = into.accumulators[i];
+      to.count += from.count;
+      to.integer_sum += from.integer_sum;
+      to.double_sum += from.double_sum;
+      to.doubles += from.doubles;
+      for (const auto& [value, count] : from.values) to.values[value] += count;
+    }
+  }
+  // An aggregate without GROUP BY has one row even over no input.
+  if (merged.empty() && query.groups.empty()) {
+    merged[Row()].accumulators.resize(arguments_.size());
+  }
+
+  std::vector<Row> rows;
+  rows.reserve(merged.size());
+  for (const auto& [key, group] : merged) {
+    Row row;
+    row.values_.reserve(query.items.size());
+    for (size_t i = 0; i < query.items.size(); ++i) {
+      const AggregateShape::Item& item = query.items[i];
+      if (item.group >= 0) {
+        row.values_.push_back(key[static_cast<size_t>(item.group)]);
+      } else if (accumulators[i] < 0) {
+        row.values_.push_back(Value(group.rows));
+      } else {
+        row.values_.push_back(Finish(
+            group.accumulators[static_cast<size_t>(accumulators[i])],
+            item.type));
+      }
+    }
+    rows.push_back(std::move(row));
+  }
+
+  if (!query.order_by.empty()) {
+    std::vector<std::string> keys(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+      for (const AggregateShape::Order& order : query.order_by) {
+        AppendSortKey(rows[i][order.item], order.ascending, &keys[i]);
+      }
+    }
+    std::vector<size_t> order(rows.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&](size_t a, size_t b) {
+      return keys[a] < keys[b];
+    });
+    std::vector<Row> sorted;
+    sorted.reserve(rows.size());
+    for (const size_t index : order) sorted.push_back(std::move(rows[index]));
+    rows = std::move(sorted);
+  }
+  const size_t begin = std::min(query.offset, rows.size());
+  const size_t end = query.limit == 0
+                         ? rows.size()
+                         : std::min(rows.size(), begin + query.limit);
+  return std::vector<Row>(std::make_move_iterator(rows.begin() + begin),
+                          std::make_move_iterator(rows.begin() + end));
+}
+
+Value MaterializedView::Finish(const Accumulator& accumulator,
+                               AggregationType type) {
+  switch (type) {
+    case AggregationType::kCount:
+      return Value(accumulator.count);
+    case AggregationType::kSum:
+      if (accumulator.count == 0) return Value();
+      if (accumulator.doubles == 0) return Value(accumulator.integer_sum);
+      return Value(accumulator.double_sum +
+                   static_cast<double>(accumulator.integer_sum));
+    case AggregationType::kAvg:
+      if (accumulator.count == 0) return Value();
+      return Value((accumulator.double_sum +
+                    static_cast<double>(accumulator.integer_sum)) /
+                   static_cast<double>(accumulator.count));
+    case AggregationType::kMin:
+      return accumulator.values.empty() ? Value()
+                                        : accumulator.values.begin()->first;
+    case AggregationType::kMax:
+      return accumulator.values.empty() ? Value()
+                                        : accumulator.values.rbegin()->first;
+    case AggregationType::kApproxCountDistinct:
+      break;
+  }
+  return Value();
+}
+
+Status MaterializedViews::Create(TransactionContext& ctx,
+                                 const std::string& name,
+                                 const SelectStatement& definition) {
+  if (Find(name) != nullptr || ctx.GetTable(name).HasValue()) {
+    return Status::kConflicts;
+  }
+  std::vector<Schema> schemas;
+  for (const SelectSource& source : definition.Sources()) {
+    if (source.table.empty()) break;
+    ASSIGN_OR_RETURN(std::shared_ptr<Table>, table, ctx.GetTable(source.table));
+    schemas.push_back(table->GetSchema());
+  }
+  auto view = std::make_shared<MaterializedView>(name, definition, schemas);
+  {
+    std::unique_lock lock(mutex_);
+    if (std::ranges::any_of(views_, [&](const auto& existing) {
+          return existing->Name() == name;
+        })) {
+      return Status::kConflicts;
+    }
+    views_.push_back(view);
+  }
+  // Read after registering: every transaction from here on reports all of
+  // its writes to the view.
+  view->ObserveFrom(ctx.txn_.GetTransactionManager()->NextTransactionId());
+  // Populate now when this transaction sees only committed rows; otherwise
+  // the first reader does.
+  std::ignore = view->Refresh(ctx);
+  return Status::kSuccess;
+}
+
+Status MaterializedViews::Drop(std::string_view name) {
+  std::unique_lock lock(mutex_);
+  const auto found = std::ranges::find_if(
+      views_, [&](const auto& view) { return view->Name() == name; });
+  if (found == views_.end()) return Status::kNotExists;
+  views_.erase(found);
+  return Status::kSuccess;
+}
+
+std::shared_ptr<MaterializedView> MaterializedViews::Find(
+    std::string_view name) const {
+  std::shared_lock lock(mutex_);
+  for (const auto& view : views_) {
+    if (view->Name() == name) return view;
+  }
+  return nullptr;
+}
+
+std::optional<std::vector<Row>> MaterializedViews::Answer(
+    TransactionContext& ctx, const SelectStatement& query) const {
+  const std::vector<std::shared_ptr<MaterializedView>> views = Views();
+  if (views.empty() || query.Sources().empty() ||
+      (query.GroupBy().empty() &&
+       std::ranges::none_of(query.SelectList(), [](const auto& item) {
+         return item.expression->Type() == TypeTag::kAggregateExp;
+       }))) {
+    return std::nullopt;
+  }
+  std::optional<AggregateShape> shape;
+  try {
+    std::vector<Schema> schemas;
+    for (const SelectSource& source : query.Sources()) {
+      if (source.table.empty()) return std::nullopt;
+      StatusOr<std::shared_ptr<Table>> table = ctx.GetTable(source.table);
+      if (!table.HasValue()) return std::nullopt;
+      schemas.push_back(table.Value()->GetSchema());
+    }
+    shape.emplace(query, schemas);
+  } catch (const std::invalid_argument&) {
+    return std::nullopt;
+  }
+  for (const auto& view : views) {
+    if (std::optional<std::vector<Row>> rows = view->Answer(ctx, *shape)) {
+      return rows;
+    }
+  }
+  return std::nullopt;
+}
+
+void MaterializedViews::TableDropped(std::string_view table) {
+  for (const auto& view : Views()) {
+    if (view->Reads(table)) view->MarkStale();
+  }
+}
+
+bool MaterializedViews::Observes(std::string_view table) const {
+  std::shared_lock lock(mutex_);
+  return std::ranges::any_of(
+      views_, [&](const auto& view) { return view->Reads(table); });
+}
+
+void MaterializedViews::RowWritten(const Transaction& txn,
+                                   std::string_view table, const Row* before,
+                                   const Row* after) {
+  std::shared_lock lock(mutex_);
+  for (const auto& view : views_) {
+    if (view->Reads(table)) view->RowWritten(txn, table, before, after);
+  }
+}
+
+void MaterializedViews::TransactionFinished(
+    const Transaction& txn, std::optional<uint64_t> commit_ts) {
+  std::shared_lock lock(mutex_);
+  for (const auto& view : views_) view->TransactionFinished(txn, commit_ts);
+}
+
+std::vector<std::shared_ptr<MaterializedView>> MaterializedViews::Views()
+    const {
+  std::shared_lock lock(mutex_);
+  return views_;
+}
+
+}  // namespace tinylamb
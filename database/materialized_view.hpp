@@ -0,0 +1,231 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+
+#ifndef TINYLAMB_DATABASE_MATERIALIZED_VIEW_HPP
+#define TINYLAMB_DATABASE_MATERIALIZED_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/constants.hpp"
+#include "common/status_or.hpp"
+#include "executor/query_memory.hpp"
+#include "expression/expression.hpp"
+#include "transaction/table_write_observer.hpp"
+#include "type/row.hpp"
+#include "type/schema.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+
+class SelectStatement;
+class TransactionContext;
+
+// A GROUP BY query over one table, or over two tables joined on one
+// equality, with its source tables resolved: every column reference is
+// qualified with its table name, WHERE and ON conjuncts are split apart and
+// the join equality is pulled out of them. Both a view definition and a
+// query it might answer are put in this form to compare them.
+struct AggregateShape {
+  // One output column: a GROUP BY expression or an aggregate.
+  struct Item {
+    std::string name;
+    // Index into `groups`, or -1 for an aggregate.
+    int group{-1};
+    AggregationType type{AggregationType::kCount};
+    // Aggregate argument; null for COUNT(*).
+    Expression argument;
+  };
+  struct Order {
+    size_t item;
+    bool ascending;
+  };
+
+  // Throws std::invalid_argument unless `select` has a supported shape:
+  // one or two base tables (two joined by an equality between them),
+  // WHERE conjuncts, GROUP BY expressions and non-DISTINCT COUNT, SUM, AVG,
+  // MIN and MAX, with no subqueries, HAVING or SELECT DISTINCT. `schemas`
+  // are those of the tables in `select`, in order.
+  AggregateShape(const SelectStatement& select,
+                 const std::vector<Schema>& schemas);
+
+  // Table names in FROM order.
+  std::vector<std::string> tables;
+  // Source schemas, and for a join both concatenated.
+  std::vector<Schema> schemas;
+  Schema input;
+  // join_keys[i] is the side of the join equality on tables[i].
+  std::vector<Expression> join_keys;
+  std::vector<Expression> filters;
+  std::vector<Expression> groups;
+  std::vector<Item> items;
+  std::vector<Order> order_by;
+  size_t limit{0};
+  size_t offset{0};
+};
+
+// A materialized GROUP BY view kept current from the write path.
+//
+// Each row a transaction writes to the (first) source table becomes a delta
+// -- the row's group key and aggregate arguments with a sign -- buffered for
+// that transaction. Commit folds the buffered deltas into the per-group
+// state, abort drops them. AVG is held as a sum and count and MIN / MAX as
+// a count per distinct value, so deletes and updates retract exactly.
+//
+// For a join view the rows of the second table are kept in memory by join
+// key to compute deltas; a committed write to that table marks the view
+// stale, as does anything else the deltas cannot follow. A stale view is
+// recomputed from the tables by the next reader that asks it. A join view
+// whose second table does not fit the memory budget stays stale, and its
+// queries run against the tables.
+class MaterializedView {
+ public:
+  // Throws std::invalid_argument as AggregateShape does, and when the
+  // definition has ORDER BY, LIMIT, OFFSET or aggregates with DISTINCT.
+  MaterializedView(std::string name, const SelectStatement& definition,
+                   const std::vector<Schema>& schemas);
+  MaterializedView(const MaterializedView&) = delete;
+  MaterializedView& operator=(const MaterializedView&) = delete;
+
+  [[nodiscard]] const std::string& Name() const { return name_; }
+  [[nodiscard]] bool Reads(std::string_view table) const;
+
+  void RowWritten(const Transaction& txn, std::string_view table,
+                  const Row* before, const Row* after);
+  void TransactionFinished(const Transaction& txn,
+                           std::optional<uint64_t> commit_ts);
+  void MarkStale();
+  // Transactions with a smaller ID may have written the source tables
+  // before the view saw them; their commits leave the view stale.
+  void ObserveFrom(txn_id_t first_txn);
+
+  // The result of `query` read from this view, or nullopt when the view
+  // cannot answer it: the query differs in tables, join, filters or
+  // grouping, needs an aggregate the view does not keep, or its
+  // transaction has uncommitted writes or a snapshot older than the last
+  // commit the view folded in. A stale view is recomputed first.
+  [[nodiscard]] std::optional<std::vector<Row>> Answer(
+      TransactionContext& ctx, const AggregateShape& query);
+
+  // Recomputes a stale view from the tables at ctx's snapshot. Returns
+  // whether the view is now current for that snapshot.
+  bool Refresh(TransactionContext& ctx);
+
+  [[nodiscard]] bool IsStale() const;
+  [[nodiscard]] size_t GroupCount() const;
+
+ private:
+  // Running state of the aggregates over one argument expression.
+  struct Accumulator {
+    int64_t count{0};
+    int64_t integer_sum{0};
+    double double_sum{0.0};
+    int64_t doubles{0};
+    // Rows per distinct value, kept only when MIN or MAX is needed.
+    std::map<Value, int64_t> values;
+  };
+  struct Group {
+    int64_t rows{0};
+    std::vector<Accumulator> accumulators;
+  };
+  struct Delta {
+    Row key;
+    std::vector<Value> arguments;
+    int sign;
+  };
+  struct Pending {
+    std::vector<Delta> deltas;
+    // generation_ when the deltas were computed.
+    uint64_t generation{0};
+    // The deltas are incomplete; commit leaves the view stale.
+    bool unusable{false};
+  };
+  struct State {
+    std::unordered_map<Row, Group> groups;
+    // Join view: second-table rows by join key, charged to the process's
+    // "materialized_view" memory account for as long as the state lives.
+    std::unordered_map<Value, std::vector<Row>> dimension;
+    QueryMemoryCharge dimension_charge;
+  };
+  // What one accumulator has to keep, from the view's aggregates.
+  struct Argument {
+    Expression expression;
+    std::string text;
+    bool sum{false};
+    bool extremes{false};
+  };
+
+  [[nodiscard]] bool IsJoin() const { return shape_.tables.size() == 2; }
+  // Appends the deltas of one source row; false when it cannot, e.g. for
+  // a non-numeric SUM argument.
+  bool AddDeltas(const State& state, const Row& row, int sign,
+                 std::vector<Delta>* out) const;
+  void Apply(const Delta& delta, State* state) const;
+  // Builds the state of the tables as ctx's transaction sees them.
+  std::optional<State> Compute(TransactionContext& ctx) const;
+  // The rows of `query` from `state`; nullopt if the view cannot answer it.
+  [[nodiscard]] std::optional<std::vector<Row>> Emit(
+      const State& state, const AggregateShape& query) const;
+  [[nodiscard]] static Value Finish(const Accumulator& accumulator,
+                                    AggregationType type);
+
+  const std::string name_;
+  AggregateShape shape_;
+  std::vector<Argument> arguments_;
+
+  mutable std::mutex mutex_;
+  State state_;
+  bool stale_{true};
+  // Bumped whenever state_ is replaced or invalidated, so deltas computed
+  // against an older dimension map are not applied.
+  uint64_t generation_{0};
+  // Commit timestamp of the last committed write to a source table.
+  uint64_t last_write_ts_{0};
+  txn_id_t first_txn_{static_cast<txn_id_t>(-1)};
+  std::unordered_map<txn_id_t, Pending> pending_;
+};
+
+// The materialized views of one database: the write observer installed on
+// its TransactionManager and the lookup the SQL engine asks before planning
+// a SELECT. Definitions live in memory for the lifetime of the Database.
+class MaterializedViews final : public TableWriteObserver {
+ public:
+  // kConflicts if `name` is taken, kNotExists if a source table is
+  // missing; throws std::invalid_argument for unsupported definitions.
+  Status Create(TransactionContext& ctx, const std::string& name,
+                const SelectStatement& definition);
+  Status Drop(std::string_view name);
+  [[nodiscard]] std::shared_ptr<MaterializedView> Find(
+      std::string_view name) const;
+
+  // The result of `query` from the first view that can answer it.
+  [[nodiscard]] std::optional<std::vector<Row>> Answer(
+      TransactionContext& ctx, const SelectStatement& query) const;
+
+  // Marks views over `table` stale after it was dropped.
+  void TableDropped(std::string_view table);
+
+  [[nodiscard]] bool Observes(std::string_view table) const override;
+  void RowWritten(const Transaction& txn, std::string_view table,
+                  const Row* before, const Row* after) override;
+  void TransactionFinished(const Transaction& txn,
+                           std::optional<uint64_t> commit_ts) override;
+
+ private:
+  [[nodiscard]] std::vector<std::shared_ptr<MaterializedView>> Views() const;
+
+  mutable std::shared_mutex mutex_;
+  std::vector<std::shared_ptr<MaterializedView>> views_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_DATABASE_MATERIALIZED_VIEW_HPP
@@ -0,0 +1,461 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "database/materialized_view.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "common/random_string.hpp"
+#include "database/database.hpp"
+#include "database/transaction_context.hpp"
+#include "expression/expression.hpp"
+#include "expression/named_expression.hpp"
+#include "parser/ast.hpp"
+#include "query/googlesql_frontend.hpp"
+#include "query/sql_engine.hpp"
+#include "table/table.hpp"
+#include "type/column.hpp"
+#include "type/row.hpp"
+#include "type/schema.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+Expression Ref(const std::string& name) { return ColumnValueExp(name); }
+
+Expression Aggregate(AggregationType type, const std::string& column) {
+  return AggregateExpressionExp(type, ColumnValueExp(column));
+}
+
+// SELECT <groups>, <aggregates> FROM <tables> [WHERE] GROUP BY <groups>
+// ORDER BY <groups>.
+std::shared_ptr<SelectStatement> GroupQuery(
+    const std::vector<std::string>& groups,
+    std::vector<NamedExpression> aggregates,
+    const std::vector<std::string>& tables, Expression where = nullptr,
+    bool order = true) {
+  std::vector<NamedExpression> items;
+  std::vector<Expression> group_by;
+  std::vector<SelectStatement::OrderByTerm> order_by;
+  for (const std::string& group : groups) {
+    items.emplace_back(group, Ref(group));
+    group_by.push_back(Ref(group));
+    if (order) order_by.push_back({Ref(group), true});
+  }
+  for (NamedExpression& aggregate : aggregates) {
+    items.push_back(std::move(aggregate));
+  }
+  auto select = std::make_shared<SelectStatement>(
+      std::move(items), tables, std::move(where), std::move(order_by));
+  select->SetGroupBy(std::move(group_by));
+  return select;
+}
+
+class MaterializedViewTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    database_ =
+        std::make_unique<Database>("materialized_view_test-" + RandomString());
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_TRUE(database_
+                    ->CreateTable(ctx, Schema("lineitem",
+                                              {Column("flag", ValueType::kVarChar),
+                                               Column("status",
+                                                      ValueType::kVarChar),
+                                               Column("qty", ValueType::kInt64),
+                                               Column("price",
+                                                      ValueType::kDouble)}))
+                    .HasValue());
+    ASSERT_TRUE(database_
+                    ->CreateTable(ctx, Schema("orders",
+                                              {Column("id", ValueType::kInt64),
+                                               Column("region",
+                                                      ValueType::kVarChar)}))
+                    .HasValue());
+    ASSERT_TRUE(database_
+                    ->CreateTable(ctx,
+                                  Schema("sales",
+                                         {Column("order_id", ValueType::kInt64),
+                                          Column("amount", ValueType::kInt64)}))
+                    .HasValue());
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  void TearDown() override { database_->DeleteAll(); }
+
+  RowPosition Insert(TransactionContext& ctx, const std::string& table,
+                     Row row) {
+    StatusOr<RowPosition> position =
+        ctx.GetTable(table).Value()->Insert(ctx.txn_, row);
+    EXPECT_TRUE(position.HasValue());
+    return position.Value();
+  }
+
+  void Commit(TransactionContext& ctx) {
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+
+  std::optional<std::vector<Row>> Answer(TransactionContext& ctx,
+                                         const SelectStatement& query) {
+    return database_->GetMaterializedViews().Answer(ctx, query);
+  }
+
+  std::unique_ptr<Database> database_;
+};
+
+NamedExpression Named(const std::string& name, Expression expression) {
+  return {name, std::move(expression)};
+}
+
+TEST_F(MaterializedViewTest, FoldsCommittedInsertsIntoGroups) {
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Insert(ctx, "lineitem", Row({Value("A"), Value("F"), Value(3), Value(1.5)}));
+    Insert(ctx, "lineitem", Row({Value("A"), Value("F"), Value(4), Value(2.5)}));
+    Insert(ctx, "lineitem", Row({Value("R"), Value("O"), Value(5), Value(1.0)}));
+    Commit(ctx);
+  }
+  const auto definition = GroupQuery(
+      {"flag", "status"},
+      {Named("sum_qty", Aggregate(AggregationType::kSum, "qty")),
+       Named("avg_price", Aggregate(AggregationType::kAvg, "price")),
+       Named("n", Aggregate(AggregationType::kCount, "*"))},
+      {"lineitem"}, nullptr, false);
+  {
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_EQ(database_->CreateMaterializedView(ctx, "q1", *definition),
+              Status::kSuccess);
+    EXPECT_EQ(database_->CreateMaterializedView(ctx, "q1", *definition),
+              Status::kConflicts);
+    Commit(ctx);
+  }
+  const std::shared_ptr<MaterializedView> view =
+      database_->GetMaterializedViews().Find("q1");
+  ASSERT_NE(view, nullptr);
+  EXPECT_FALSE(view->IsStale());
+  EXPECT_EQ(view->GroupCount(), 2U);
+
+  const auto query = GroupQuery(
+      {"flag", "status"},
+      {Named("n", Aggregate(AggregationType::kCount, "*")),
+       Named("sum_qty", Aggregate(AggregationType::kSum, "lineitem.qty"))},
+      {"lineitem"});
+  TransactionContext before = database_->BeginContext();
+  {
+    TransactionContext writer = database_->BeginContext();
+    Insert(writer, "lineitem",
+           Row({Value("R"), Value("O"), Value(7), Value(3.0)}));
+    // The writer's own rows are not in the view yet.
+    EXPECT_FALSE(Answer(writer, *query).has_value());
+    Commit(writer);
+  }
+  // A snapshot from before the commit cannot read the view any more.
+  EXPECT_FALSE(Answer(before, *query).has_value());
+  Commit(before);
+
+  TransactionContext reader = database_->BeginContext();
+  const std::optional<std::vector<Row>> rows = Answer(reader, *query);
+  ASSERT_TRUE(rows.has_value());
+  ASSERT_EQ(rows->size(), 2U);
+  EXPECT_EQ((*rows)[0], Row({Value("A"), Value("F"), Value(2), Value(7)}));
+  EXPECT_EQ((*rows)[1], Row({Value("R"), Value("O"), Value(2), Value(12)}));
+  Commit(reader);
+}
+
+TEST_F(MaterializedViewTest, AbortDropsDeltas) {
+  const auto definition = GroupQuery(
+      {"flag"}, {Named("sum_qty", Aggregate(AggregationType::kSum, "qty"))},
+      {"lineitem"}, nullptr, false);
+  {
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_EQ(database_->CreateMaterializedView(ctx, "by_flag", *definition),
+              Status::kSuccess);
+    Insert(ctx, "lineitem", Row({Value("A"), Value("F"), Value(3), Value(1.0)}));
+    Commit(ctx);
+  }
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Insert(ctx, "lineitem", Row({Value("A"), Value("F"), Value(9), Value(1.0)}));
+    Insert(ctx, "lineitem", Row({Value("N"), Value("F"), Value(1), Value(1.0)}));
+    ctx.Abort();
+  }
+  const auto query = GroupQuery(
+      {"flag"}, {Named("sum_qty", Aggregate(AggregationType::kSum, "qty"))},
+      {"lineitem"});
+  TransactionContext reader = database_->BeginContext();
+  const std::optional<std::vector<Row>> rows = Answer(reader, *query);
+  ASSERT_TRUE(rows.has_value());
+  EXPECT_EQ(*rows, std::vector<Row>({Row({Value("A"), Value(3)})}));
+  Commit(reader);
+}
+
+TEST_F(MaterializedViewTest, WritersBegunBeforeCreateAreNotLost) {
+  const auto definition = GroupQuery(
+      {"flag"}, {Named("sum_qty", Aggregate(AggregationType::kSum, "qty"))},
+      {"lineitem"}, nullptr, false);
+  TransactionContext early = database_->BeginContext();
+  TransactionContext straddling = database_->BeginContext();
+  Insert(early, "lineitem", Row({Value("A"), Value("F"), Value(3), Value(1.0)}));
+  Insert(straddling, "lineitem",
+         Row({Value("N"), Value("F"), Value(4), Value(1.0)}));
+  {
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_EQ(database_->CreateMaterializedView(ctx, "by_flag", *definition),
+              Status::kSuccess);
+    Commit(ctx);
+  }
+  const std::shared_ptr<MaterializedView> view =
+      database_->GetMaterializedViews().Find("by_flag");
+  ASSERT_NE(view, nullptr);
+  EXPECT_FALSE(view->IsStale());
+
+  // Act -- one writer commits rows the view never saw, the other adds more
+  // rows after the view exists.
+  Commit(early);
+  EXPECT_TRUE(view->IsStale());
+  Insert(straddling, "lineitem",
+         Row({Value("N"), Value("F"), Value(5), Value(1.0)}));
+  Commit(straddling);
+
+  // Assert
+  const auto query = GroupQuery(
+      {"flag"}, {Named("sum_qty", Aggregate(AggregationType::kSum, "qty"))},
+      {"lineitem"});
+  TransactionContext reader = database_->BeginContext();
+  const std::optional<std::vector<Row>> rows = Answer(reader, *query);
+  ASSERT_TRUE(rows.has_value());
+  EXPECT_EQ(*rows, std::vector<Row>({Row({Value("A"), Value(3)}),
+                                     Row({Value("N"), Value(9)})}));
+  Commit(reader);
+}
+
+TEST_F(MaterializedViewTest, UpdatesAndDeletesRetractValues) {
+  const auto definition = GroupQuery(
+      {"flag", "status"},
+      {Named("lo", Aggregate(AggregationType::kMin, "qty")),
+       Named("hi", Aggregate(AggregationType::kMax, "qty")),
+       Named("total", Aggregate(AggregationType::kSum, "qty"))},
+      {"lineitem"}, nullptr, false);
+  RowPosition low;
+  RowPosition moved;
+  {
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_EQ(database_->CreateMaterializedView(ctx, "extremes", *definition),
+              Status::kSuccess);
+    low = Insert(ctx, "lineitem",
+                 Row({Value("A"), Value("F"), Value(1), Value(1.0)}));
+    Insert(ctx, "lineitem", Row({Value("A"), Value("F"), Value(5), Value(1.0)}));
+    moved = Insert(ctx, "lineitem",
+                   Row({Value("A"), Value("O"), Value(8), Value(1.0)}));
+    Commit(ctx);
+  }
+  {
+    TransactionContext ctx = database_->BeginContext();
+    std::shared_ptr<Table> table = ctx.GetTable("lineitem").Value();
+    ASSERT_EQ(table->Delete(ctx.txn_, low), Status::kSuccess);
+    ASSERT_TRUE(table
+                    ->Update(ctx.txn_, moved,
+                             Row({Value("A"), Value("F"), Value(9),
+                                  Value(1.0)}))
+                    .HasValue());
+    Commit(ctx);
+  }
+  // Coarser grouping than the view: its groups are merged.
+  const auto query = GroupQuery(
+      {"flag"},
+      {Named("lo", Aggregate(AggregationType::kMin, "qty")),
+       Named("hi", Aggregate(AggregationType::kMax, "qty")),
+       Named("mean", Aggregate(AggregationType::kAvg, "qty")),
+       Named("n", Aggregate(AggregationType::kCount, "qty"))},
+      {"lineitem"});
+  TransactionContext reader = database_->BeginContext();
+  const std::optional<std::vector<Row>> rows = Answer(reader, *query);
+  ASSERT_TRUE(rows.has_value());
+  EXPECT_EQ(*rows, std::vector<Row>({Row(
+                       {Value("A"), Value(5), Value(9), Value(7.0), Value(2)})}));
+  EXPECT_EQ(database_->GetMaterializedViews().Find("extremes")->GroupCount(),
+            1U);
+  Commit(reader);
+}
+
+TEST_F(MaterializedViewTest, JoinViewRecomputesAfterDimensionWrite) {
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Insert(ctx, "orders", Row({Value(1), Value("east")}));
+    Insert(ctx, "orders", Row({Value(2), Value("west")}));
+    Insert(ctx, "sales", Row({Value(1), Value(10)}));
+    Commit(ctx);
+  }
+  const auto definition = GroupQuery(
+      {"region"}, {Named("total", Aggregate(AggregationType::kSum, "amount"))},
+      {"sales", "orders"},
+      BinaryExpressionExp(ColumnValueExp("sales.order_id"),
+                          BinaryOperation::kEquals, ColumnValueExp("orders.id")),
+      false);
+  {
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_EQ(database_->CreateMaterializedView(ctx, "by_region", *definition),
+              Status::kSuccess);
+    Commit(ctx);
+  }
+  const std::shared_ptr<MaterializedView> view =
+      database_->GetMaterializedViews().Find("by_region");
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Insert(ctx, "sales", Row({Value(2), Value(5)}));
+    Insert(ctx, "sales", Row({Value(1), Value(1)}));
+    Commit(ctx);
+  }
+  EXPECT_FALSE(view->IsStale());
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Insert(ctx, "orders", Row({Value(3), Value("east")}));
+    Insert(ctx, "sales", Row({Value(3), Value(100)}));
+    Commit(ctx);
+  }
+  EXPECT_TRUE(view->IsStale());
+
+  // The same join written the other way round.
+  const auto query = GroupQuery(
+      {"region"}, {Named("total", Aggregate(AggregationType::kSum, "amount"))},
+      {"orders", "sales"},
+      BinaryExpressionExp(ColumnValueExp("id"), BinaryOperation::kEquals,
+                          ColumnValueExp("order_id")));
+  TransactionContext reader = database_->BeginContext();
+  const std::optional<std::vector<Row>> rows = Answer(reader, *query);
+  ASSERT_TRUE(rows.has_value());
+  EXPECT_EQ(*rows, std::vector<Row>({Row({Value("east"), Value(111)}),
+                                     Row({Value("west"), Value(5)})}));
+  EXPECT_FALSE(view->IsStale());
+  Commit(reader);
+}
+
+TEST_F(MaterializedViewTest, AnswersOnlyMatchingQueries) {
+  const auto definition = GroupQuery(
+      {"flag"}, {Named("total", Aggregate(AggregationType::kSum, "qty"))},
+      {"lineitem"},
+      BinaryExpressionExp(ColumnValueExp("status"), BinaryOperation::kEquals,
+                          ConstantValueExp(Value("F"))),
+      false);
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Insert(ctx, "lineitem", Row({Value("A"), Value("F"), Value(3), Value(1.0)}));
+    Insert(ctx, "lineitem", Row({Value("A"), Value("O"), Value(4), Value(1.0)}));
+    Commit(ctx);
+  }
+  {
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_EQ(database_->CreateMaterializedView(ctx, "shipped", *definition),
+              Status::kSuccess);
+    Commit(ctx);
+  }
+  TransactionContext reader = database_->BeginContext();
+  const auto filtered = [](const std::string& status) {
+    return BinaryExpressionExp(ColumnValueExp("lineitem.status"),
+                               BinaryOperation::kEquals,
+                               ConstantValueExp(Value(std::string(status))));
+  };
+  const auto same = GroupQuery(
+      {"flag"}, {Named("total", Aggregate(AggregationType::kSum, "qty"))},
+      {"lineitem"}, filtered("F"));
+  ASSERT_TRUE(Answer(reader, *same).has_value());
+  EXPECT_EQ(*Answer(reader, *same),
+            std::vector<Row>({Row({Value("A"), Value(3)})}));
+  // Another filter, no filter, an aggregate the view lacks, a group the
+  // view does not have.
+  EXPECT_FALSE(Answer(reader, *GroupQuery({"flag"},
+                                          {Named("total",
+                                                 Aggregate(AggregationType::kSum,
+                                                           "qty"))},
+                                          {"lineitem"}, filtered("O")))
+                   .has_value());
+  EXPECT_FALSE(Answer(reader, *GroupQuery({"flag"},
+                                          {Named("total",
+                                                 Aggregate(AggregationType::kSum,
+                                                           "qty"))},
+                                          {"lineitem"}))
+                   .has_value());
+  EXPECT_FALSE(Answer(reader, *GroupQuery({"flag"},
+                                          {Named("hi",
+                                                 Aggregate(AggregationType::kMax,
+                                                           "qty"))},
+                                          {"lineitem"}, filtered("F")))
+                   .has_value());
+  EXPECT_FALSE(Answer(reader, *GroupQuery({"status"},
+                                          {Named("total",
+                                                 Aggregate(AggregationType::kSum,
+                                                           "qty"))},
+                                          {"lineitem"}, filtered("F")))
+                   .has_value());
+  Commit(reader);
+
+  TransactionContext ctx = database_->BeginContext();
+  auto distinct = GroupQuery(
+      {"flag"},
+      {Named("n", AggregateExpressionExp(AggregationType::kCount,
+                                         ColumnValueExp("qty"), true))},
+      {"lineitem"}, nullptr, false);
+  EXPECT_THROW(std::ignore =
+                   database_->CreateMaterializedView(ctx, "bad", *distinct),
+               std::invalid_argument);
+  EXPECT_EQ(database_->CreateMaterializedView(
+                ctx, "missing",
+                *GroupQuery({"flag"},
+                            {Named("n", Aggregate(AggregationType::kCount,
+                                                  "*"))},
+                            {"nowhere"}, nullptr, false)),
+            Status::kNotExists);
+  EXPECT_EQ(database_->DropMaterializedView("shipped"), Status::kSuccess);
+  EXPECT_EQ(database_->DropMaterializedView("shipped"), Status::kNotExists);
+  Commit(ctx);
+}
+
+TEST_F(MaterializedViewTest, SqlCreatesAndAnswersViews) {
+  if (!GoogleSqlFrontend::Available()) {
+    GTEST_SKIP() << "GoogleSQL parser disabled for this platform";
+  }
+  const auto run = [&](TransactionContext& ctx, const std::string& sql) {
+    SqlEngine engine(*database_);
+    StatusOr<Executor> result = engine.Prepare(ctx, sql);
+    EXPECT_EQ(result.GetStatus(), Status::kSuccess) << sql << "\n"
+                                                    << engine.LastError();
+    std::vector<Row> rows;
+    if (!result.HasValue()) return rows;
+    Row row;
+    while (result.Value()->Next(&row, nullptr)) rows.push_back(row);
+    return rows;
+  };
+  {
+    TransactionContext ctx = database_->BeginContext();
+    run(ctx,
+        "INSERT INTO lineitem VALUES ('A', 'F', 3, 1.0), ('R', 'F', 4, 2.0);");
+    Commit(ctx);
+  }
+  {
+    TransactionContext ctx = database_->BeginContext();
+    run(ctx,
+        "CREATE MATERIALIZED VIEW q1 AS SELECT flag, SUM(qty) AS s "
+        "FROM lineitem GROUP BY flag;");
+    Commit(ctx);
+  }
+  ASSERT_NE(database_->GetMaterializedViews().Find("q1"), nullptr);
+  const std::string query =
+      "SELECT flag, SUM(qty) FROM lineitem GROUP BY flag ORDER BY flag;";
+  TransactionContext reader = database_->BeginContext();
+  EXPECT_EQ(run(reader, query),
+            std::vector<Row>({Row({Value("A"), Value(3)}),
+                              Row({Value("R"), Value(4)})}));
+  Commit(reader);
+  TransactionContext ctx = database_->BeginContext();
+  run(ctx, "DROP MATERIALIZED VIEW q1;");
+  EXPECT_EQ(database_->GetMaterializedViews().Find("q1"), nullptr);
+  Commit(ctx);
+}
+
+}  // namespace
+}  // namespace tinylamb
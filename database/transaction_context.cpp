@@ -26,6 +26,7 @@
 namespace tinylamb {
 StatusOr<std::shared_ptr<Table> > TransactionContext::GetTable(
     std::string_view table_name) {
+  std::scoped_lock guard(*lookup_mutex_);
   auto it = tables_.find(std::string(table_name));
   if (it != tables_.end()) {
     return it->second;
@@ -38,6 +39,7 @@ StatusOr<std::shared_ptr<Table> > TransactionContext::GetTable(
 
 StatusOr<std::shared_ptr<TableStatistics> > TransactionContext::GetStats(
     std::string_view table_name) {
+  std::scoped_lock guard(*lookup_mutex_);
   auto it = stats_.find(std::string(table_name));
   if (it != stats_.end()) {
     return it->second;
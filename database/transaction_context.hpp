@@ -17,6 +17,9 @@
 #ifndef TINYLAMB_TRANSACTION_CONTEXT_HPP
 #define TINYLAMB_TRANSACTION_CONTEXT_HPP
 
+#include <memory>
+#include <mutex>
+
 #include "transaction/transaction.hpp"
 // #include "transaction/transaction_manager.hpp"
 
@@ -53,6 +56,10 @@ class TransactionContext {
   Database* rs_;
   std::unordered_map<std::string, std::shared_ptr<Table>> tables_;
   std::unordered_map<std::string, std::shared_ptr<TableStatistics>> stats_;
+  // Guards tables_ and stats_: subqueries of one query may run on several
+  // threads under the same context.
+  std::unique_ptr<std::recursive_mutex> lookup_mutex_{
+      std::make_unique<std::recursive_mutex>()};
 };
 
 }  // namespace tinylamb
@@ -0,0 +1,28 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/adaptive_join_order.hpp"
+
+#include <algorithm>
+
+#include "executor/feature_flag.hpp"
+
+namespace tinylamb {
+namespace {
+
+FeatureFlag& Flag() {
+  static FeatureFlag flag("TINYLAMB_ADAPTIVE_JOINS");
+  return flag;
+}
+
+}  // namespace
+
+bool AdaptiveJoinsEnabled() { return Flag().Enabled(); }
+
+void SetAdaptiveJoinsForTest(int enabled) { Flag().SetForTest(enabled); }
+
+double JoinQError(double estimate, double actual) {
+  estimate = std::max(estimate, 1.0);
+  actual = std::max(actual, 1.0);
+  return std::max(estimate / actual, actual / estimate);
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,31 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_ADAPTIVE_JOIN_ORDER_HPP
+#define TINYLAMB_EXECUTOR_ADAPTIVE_JOIN_ORDER_HPP
+
+namespace tinylamb {
+
+// Whether the relational executor adapts joins to the row counts they
+// materialize. Each next join is always picked from exact estimates against
+// the materialized intermediate; when enabled, a join also builds on the
+// intermediate if that turned out much smaller than the relation joined into
+// it, and estimates missed by more than kAdaptiveJoinMaxQError are reported
+// as re-plans in EXPLAIN ANALYZE.
+//
+// Config: TINYLAMB_ADAPTIVE_JOINS
+//   - unset: enabled
+//   - "0": always build on the relation joined in
+[[nodiscard]] bool AdaptiveJoinsEnabled();
+
+// Test helper: 1 enables, 0 disables, -1 restores the environment default.
+void SetAdaptiveJoinsForTest(int enabled);
+
+// A materialized join whose rows are off from the estimate by more than this
+// factor is reported as a re-plan of the remaining joins.
+inline constexpr double kAdaptiveJoinMaxQError = 4.0;
+
+// max(estimate / actual, actual / estimate), both clamped to at least one.
+[[nodiscard]] double JoinQError(double estimate, double actual);
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_ADAPTIVE_JOIN_ORDER_HPP
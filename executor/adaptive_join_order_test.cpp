@@ -0,0 +1,23 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/adaptive_join_order.hpp"
+
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+TEST(AdaptiveJoinOrderTest, QErrorAndFlag) {
+  EXPECT_DOUBLE_EQ(JoinQError(10, 1000), 100);
+  EXPECT_DOUBLE_EQ(JoinQError(1000, 10), 100);
+  EXPECT_DOUBLE_EQ(JoinQError(0, 0), 1);
+  EXPECT_DOUBLE_EQ(JoinQError(0, 3), 3);
+
+  SetAdaptiveJoinsForTest(0);
+  EXPECT_FALSE(AdaptiveJoinsEnabled());
+  SetAdaptiveJoinsForTest(1);
+  EXPECT_TRUE(AdaptiveJoinsEnabled());
+  SetAdaptiveJoinsForTest(-1);
+}
+
+}  // namespace
+}  // namespace tinylamb
@@ -0,0 +1,178 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/aggregate_state.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "executor/query_memory.hpp"
+
+namespace tinylamb {
+
+AggregateState::AggregateState(AggregationType type, bool distinct)
+    : type_(type),
+      distinct_(distinct && type != AggregationType::kApproxCountDistinct
+                    ? std::make_unique<DistinctValues>()
+                    : nullptr),
+      sketch_(type == AggregationType::kApproxCountDistinct
+                  ? std::make_unique<HyperLogLog>()
+                  : nullptr) {}
+
+void AggregateState::Add(const Value& value) {
+  if (value.IsNull()) return;
+  if (sketch_) {
+    sketch_->Add(value);
+  } else if (!distinct_) {
+    Fold(value);
+  } else if (value.type == ValueType::kInt64) {
+    InsertDistinct(value.value.int_value);
+  } else {
+    InsertDistinct(value);
+  }
+}
+
+void AggregateState::Merge(AggregateState&& other) {
+  if (sketch_) {
+    sketch_->Merge(*other.sketch_);
+    return;
+  }
+  if (distinct_) {
+    other.distinct_->integers.ForEach(
+        [&](int64_t value) { InsertDistinct(value); });
+    // merge() leaves the values this state already had in `other`.
+    distinct_bytes_ += other.distinct_bytes_ -
+                       other.distinct_->integers.Size() * sizeof(int64_t);
+    distinct_->others.merge(other.distinct_->others);
+    for (const Value& value : other.distinct_->others) {
+      distinct_bytes_ -= EstimateValueBytes(value);
+    }
+    return;
+  }
+  count_ += other.count_;
+  total_ += other.total_;
+  total_is_double_ = total_is_double_ || other.total_is_double_;
+  if (other.extreme_.IsNull()) return;
+  if (extreme_.IsNull() ||
+      (type_ == AggregationType::kMin ? other.extreme_ < extreme_
+                                      : extreme_ < other.extreme_)) {
+    extreme_ = std::move(other.extreme_);
+  }
+}
+
+void AggregateState::AppendSpilled(std::vector<Value>* values) const {
+  if (sketch_) {
+    values->emplace_back(sketch_->Serialize());
+    return;
+  }
+  if (!distinct_) {
+    values->emplace_back(count_);
+    values->emplace_back(total_);
+    values->emplace_back(int64_t{total_is_double_});
+    values->push_back(extreme_);
+    return;
+  }
+  values->emplace_back(static_cast<int64_t>(distinct_->integers.Size()));
+  distinct_->integers.ForEach(
+      [&](int64_t value) { values->emplace_back(value); });
+  values->emplace_back(static_cast<int64_t>(distinct_->others.size()));
+  values->insert(values->end(), distinct_->others.begin(),
+                 distinct_->others.end());
+}
+
+void AggregateState::MergeSpilled(const std::vector<Value>& values,
+                                  size_t* offset) {
+  size_t at = *offset;
+  if (sketch_) {
+    sketch_->MergeSerialized(values[at].value.varchar_value);
+    *offset = at + 1;
+    return;
+  }
+  if (!distinct_) {
+    count_ += values[at].value.int_value;
+    total_ += values[at + 1].value.double_value;
+    total_is_double_ = total_is_double_ || values[at + 2].value.int_value != 0;
+    const Value& extreme = values[at + 3];
+    if (!extreme.IsNull() &&
+        (extreme_.IsNull() || (type_ == AggregationType::kMin
+                                   ? extreme < extreme_
+                                   : extreme_ < extreme))) {
+      extreme_ = extreme;
+    }
+    *offset = at + 4;
+    return;
+  }
+  const int64_t integers = values[at++].value.int_value;
+  for (int64_t i = 0; i < integers; ++i) {
+    InsertDistinct(values[at++].value.int_value);
+  }
+  const int64_t others = values[at++].value.int_value;
+  for (int64_t i = 0; i < others; ++i) InsertDistinct(values[at++]);
+  *offset = at;
+}
+
+Value AggregateState::Finish() const {
+  if (sketch_) return Value(static_cast<int64_t>(sketch_->Estimate()));
+  if (distinct_) {
+    AggregateState folded(type_, false);
+    distinct_->integers.ForEach(
+        [&](int64_t value) { folded.Fold(Value(value)); });
+    for (const Value& value : distinct_->others) folded.Fold(value);
+    return folded.Finish();
+  }
+  switch (type_) {
+    case AggregationType::kCount:
+      return Value(count_);
+    case AggregationType::kAvg:
+      return count_ == 0 ? Value()
+                         : Value(total_ / static_cast<double>(count_));
+    case AggregationType::kSum:
+      if (count_ == 0) return Value();
+      return total_is_double_ ? Value(total_)
+                              : Value(static_cast<int64_t>(total_));
+    case AggregationType::kMin:
+    case AggregationType::kMax:
+      return extreme_;
+    case AggregationType::kApproxCountDistinct:
+      break;
+  }
+  return Value();
+}
+
+void AggregateState::Fold(const Value& value) {
+  switch (type_) {
+    case AggregationType::kCount:
+      ++count_;
+      break;
+    case AggregationType::kSum:
+    case AggregationType::kAvg:
+      if (value.type == ValueType::kDouble) {
+        total_ += value.value.double_value;
+        total_is_double_ = true;
+      } else if (value.type == ValueType::kInt64) {
+        total_ += static_cast<double>(value.value.int_value);
+      } else {
+        throw std::runtime_error("numeric value required");
+      }
+      ++count_;
+      break;
+    case AggregationType::kMin:
+      if (extreme_.IsNull() || value < extreme_) extreme_ = value;
+      break;
+    case AggregationType::kMax:
+      if (extreme_.IsNull() || extreme_ < value) extreme_ = value;
+      break;
+    case AggregationType::kApproxCountDistinct:
+      break;
+  }
+}
+
+void AggregateState::InsertDistinct(int64_t value) {
+  if (distinct_->integers.Insert(value)) distinct_bytes_ += sizeof(int64_t);
+}
+
+void AggregateState::InsertDistinct(const Value& value) {
+  if (distinct_->others.insert(value).second) {
+    distinct_bytes_ += EstimateValueBytes(value);
+  }
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,80 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_AGGREGATE_STATE_HPP
+#define TINYLAMB_EXECUTOR_AGGREGATE_STATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "executor/flat_hash_table.hpp"
+#include "type/hyperloglog.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+
+// Partial state of one aggregate function. States built over disjoint parts
+// of an input merge into the state of the whole input, which is what lets a
+// GROUP BY pre-aggregate per thread: AVG is carried as sum and count, and a
+// DISTINCT aggregate keeps its distinct values and folds them only in
+// Finish(), so a value seen by several partial states still counts once.
+// APPROX_COUNT_DISTINCT keeps a HyperLogLog sketch instead, which merges the
+// same way in bounded memory.
+class AggregateState {
+ public:
+  AggregateState(AggregationType type, bool distinct);
+
+  // Adds one input value; NULLs are ignored. SUM and AVG throw on
+  // non-numeric values.
+  void Add(const Value& value);
+
+  // Folds `other`, a state of the same aggregate, into this one.
+  void Merge(AggregateState&& other);
+
+  // Appends this partial state as plain values, e.g. to spill it in a Row.
+  void AppendSpilled(std::vector<Value>* values) const;
+  // Merges a partial state written by AppendSpilled() at values[*offset]
+  // and advances *offset past it.
+  void MergeSpilled(const std::vector<Value>& values, size_t* offset);
+
+  // Result over everything added or merged so far: NULL for SUM, AVG, MIN
+  // and MAX over no values, 0 for COUNT and APPROX_COUNT_DISTINCT.
+  [[nodiscard]] Value Finish() const;
+
+  [[nodiscard]] AggregationType Type() const { return type_; }
+  [[nodiscard]] bool Distinct() const { return distinct_ != nullptr; }
+  // Estimated bytes of the distinct values kept so far; 0 unless DISTINCT.
+  [[nodiscard]] size_t DistinctBytes() const { return distinct_bytes_; }
+
+ private:
+  // Integers, the common DISTINCT argument, get a flat set of their own.
+  struct DistinctValues {
+    FlatHashSet<int64_t> integers;
+    std::unordered_set<Value> others;
+  };
+
+  void Fold(const Value& value);
+  void InsertDistinct(int64_t value);
+  void InsertDistinct(const Value& value);
+
+  AggregationType type_;
+  int64_t count_{0};
+  double total_{0.0};
+  bool total_is_double_{false};
+  Value extreme_;
+  std::unique_ptr<DistinctValues> distinct_;
+  size_t distinct_bytes_{0};
+  // APPROX_COUNT_DISTINCT only.
+  std::unique_ptr<HyperLogLog> sketch_;
+};
+
+// One aggregate of a hash aggregation: the AggregateState to create for it.
+struct AggregateSpec {
+  AggregationType type;
+  bool distinct;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_AGGREGATE_STATE_HPP
@@ -0,0 +1,155 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/aggregate_state.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "executor/query_memory.hpp"
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+
+TEST(AggregateStateTest, FinishOverNoValues) {
+  EXPECT_EQ(AggregateState(AggregationType::kCount, false).Finish(),
+            Value(int64_t{0}));
+  EXPECT_TRUE(AggregateState(AggregationType::kSum, false).Finish().IsNull());
+  EXPECT_TRUE(AggregateState(AggregationType::kAvg, true).Finish().IsNull());
+  EXPECT_TRUE(AggregateState(AggregationType::kMin, false).Finish().IsNull());
+}
+
+TEST(AggregateStateTest, NullsAreIgnored) {
+  AggregateState count(AggregationType::kCount, false);
+  count.Add(Value());
+  count.Add(Value(3));
+  EXPECT_EQ(count.Finish(), Value(int64_t{1}));
+}
+
+TEST(AggregateStateTest, CountDistinctIntegers) {
+  AggregateState state(AggregationType::kCount, true);
+  for (int64_t value : {1, 2, 1, 3, 2, 1}) state.Add(Value(value));
+  EXPECT_EQ(state.Finish(), Value(int64_t{3}));
+}
+
+TEST(AggregateStateTest, DistinctKeepsTypesApart) {
+  AggregateState state(AggregationType::kCount, true);
+  state.Add(Value(int64_t{7}));
+  state.Add(Value(7.0));
+  state.Add(Value("7"));
+  state.Add(Value("7"));
+  state.Add(Value(int64_t{7}));
+  EXPECT_EQ(state.Finish(), Value(int64_t{3}));
+}
+
+TEST(AggregateStateTest, MergedAverageIsSumOverCount) {
+  AggregateState left(AggregationType::kAvg, false);
+  AggregateState right(AggregationType::kAvg, false);
+  left.Add(Value(1));
+  left.Add(Value(2));
+  right.Add(Value(6));
+  left.Merge(std::move(right));
+  EXPECT_EQ(left.Finish(), Value(3.0));
+}
+
+TEST(AggregateStateTest, MergedSumAndExtremes) {
+  AggregateState sum(AggregationType::kSum, false);
+  AggregateState other_sum(AggregationType::kSum, false);
+  sum.Add(Value(4));
+  other_sum.Add(Value(1.5));
+  sum.Merge(std::move(other_sum));
+  EXPECT_EQ(sum.Finish(), Value(5.5));
+
+  AggregateState min(AggregationType::kMin, false);
+  AggregateState other_min(AggregationType::kMin, false);
+  AggregateState empty_min(AggregationType::kMin, false);
+  min.Add(Value(8));
+  other_min.Add(Value(3));
+  min.Merge(std::move(other_min));
+  min.Merge(std::move(empty_min));
+  EXPECT_EQ(min.Finish(), Value(3));
+
+  AggregateState max(AggregationType::kMax, false);
+  AggregateState other_max(AggregationType::kMax, false);
+  other_max.Add(Value("b"));
+  max.Merge(std::move(other_max));
+  EXPECT_EQ(max.Finish(), Value("b"));
+}
+
+TEST(AggregateStateTest, MergedDistinctCountsSharedValuesOnce) {
+  AggregateState left(AggregationType::kSum, true);
+  AggregateState right(AggregationType::kSum, true);
+  for (int64_t value : {1, 2, 3}) left.Add(Value(value));
+  for (int64_t value : {3, 4, 4}) right.Add(Value(value));
+  right.Add(Value(0.5));
+  EXPECT_EQ(right.DistinctBytes(),
+            2 * sizeof(int64_t) + EstimateValueBytes(Value(0.5)));
+  left.Merge(std::move(right));
+  EXPECT_EQ(left.Finish(), Value(10.5));
+  EXPECT_EQ(left.DistinctBytes(),
+            4 * sizeof(int64_t) + EstimateValueBytes(Value(0.5)));
+}
+
+TEST(AggregateStateTest, SpilledStatesMergeBack) {
+  AggregateState avg(AggregationType::kAvg, false);
+  AggregateState max(AggregationType::kMax, false);
+  AggregateState distinct(AggregationType::kCount, true);
+  for (int64_t value : {4, 8, 4}) {
+    avg.Add(Value(value));
+    max.Add(Value(value));
+    distinct.Add(Value(value));
+  }
+  distinct.Add(Value("x"));
+  std::vector<Value> values;
+  avg.AppendSpilled(&values);
+  max.AppendSpilled(&values);
+  distinct.AppendSpilled(&values);
+
+  AggregateState merged_avg(AggregationType::kAvg, false);
+  AggregateState merged_max(AggregationType::kMax, false);
+  AggregateState merged_distinct(AggregationType::kCount, true);
+  merged_avg.Add(Value(1.5));
+  merged_distinct.Add(Value(8));
+  merged_distinct.Add(Value(9));
+  size_t offset = 0;
+  merged_avg.MergeSpilled(values, &offset);
+  merged_max.MergeSpilled(values, &offset);
+  merged_distinct.MergeSpilled(values, &offset);
+  EXPECT_EQ(offset, values.size());
+  EXPECT_EQ(merged_avg.Finish(), Value(4.375));
+  EXPECT_EQ(merged_max.Finish(), Value(8));
+  EXPECT_EQ(merged_distinct.Finish(), Value(int64_t{4}));
+}
+
+TEST(AggregateStateTest, ApproxCountDistinctMergesAndSpills) {
+  AggregateState left(AggregationType::kApproxCountDistinct, true);
+  AggregateState right(AggregationType::kApproxCountDistinct, false);
+  EXPECT_FALSE(left.Distinct());
+  EXPECT_EQ(left.Finish(), Value(int64_t{0}));
+  for (int64_t value = 0; value < 30000; ++value) left.Add(Value(value));
+  for (int64_t value = 20000; value < 50000; ++value) right.Add(Value(value));
+  right.Add(Value());
+  std::vector<Value> values;
+  right.AppendSpilled(&values);
+  ASSERT_EQ(values.size(), 1U);
+
+  size_t offset = 0;
+  left.MergeSpilled(values, &offset);
+  EXPECT_EQ(offset, 1U);
+  const int64_t estimate = left.Finish().value.int_value;
+  EXPECT_NEAR(static_cast<double>(estimate), 50000.0, 2000.0);
+
+  AggregateState merged(AggregationType::kApproxCountDistinct, false);
+  merged.Add(Value("x"));
+  merged.Add(Value("x"));
+  merged.Merge(std::move(left));
+  EXPECT_NEAR(static_cast<double>(merged.Finish().value.int_value),
+              static_cast<double>(estimate), 2.0);
+}
+
+TEST(AggregateStateTest, SumOfTextThrows) {
+  AggregateState state(AggregationType::kSum, false);
+  EXPECT_THROW(state.Add(Value("x")), std::runtime_error);
+}
+
+}  // namespace tinylamb
@@ -22,6 +22,7 @@
 
 #include "expression/aggregate_expression.hpp"
 #include "executor/query_memory.hpp"
+#include "type/hyperloglog.hpp"
 #include "type/row.hpp"
 #include "type/schema.hpp"
 #include "type/value.hpp"
@@ -34,7 +35,8 @@ AggregationExecutor::AggregationExecutor(
     : child_(std::move(child)),
       input_schema_(std::move(input_schema)),
       aggregates_(std::move(aggregates)),
-      jit_threshold_rows_(jit_threshold_rows) {
+      jit_threshold_rows_(jit_threshold_rows),
+      charge_(MemoryContext::Current().Child("aggregation")) {
   if (aggregates_.size() == 1) {
     const auto& aggregate =
         aggregates_[0].expression->AsAggregateExpression();
@@ -85,10 +87,12 @@ bool AggregationExecutor::Next(Row* dst, RowPosition* /*rp*/) {
   results.resize(aggregates_.size());
   std::vector<int64_t> counts(aggregates_.size(), 0);
   std::vector<std::unordered_set<Value>> distinct_values(aggregates_.size());
+  std::vector<HyperLogLog> sketches(aggregates_.size());
   for (size_t i = 0; i < aggregates_.size(); ++i) {
     const auto& agg = aggregates_[i].expression->AsAggregateExpression();
     switch (agg.GetType()) {
       case AggregationType::kCount:
+      case AggregationType::kApproxCountDistinct:
         results[i] = Value(0);
         break;
       case AggregationType::kAvg:
@@ -128,13 +132,16 @@ bool AggregationExecutor::Next(Row* dst, RowPosition* /*rp*/) {
           val = agg.Child()->Evaluate(*materialized, input_schema_);
         }
         if (val.IsNull()) continue;
+        if (agg.GetType() == AggregationType::kApproxCountDistinct) {
+          const size_t before = sketches[i].Bytes();
+          sketches[i].Add(val);
+          const size_t after = sketches[i].Bytes();
+          if (before < after) charge_.Add(after - before);
+          continue;
+        }
         if (agg.Distinct()) {
-          const size_t bytes = EstimateValueBytes(val);
-          QueryMemoryBudget::Global().ReserveForced(bytes);
-          if (!distinct_values[i].insert(val).second) {
-            QueryMemoryBudget::Global().Release(bytes);
-            continue;
-          }
+          if (!distinct_values[i].insert(val).second) continue;
+          charge_.Add(EstimateValueBytes(val));
         }
         switch (agg.GetType()) {
           case AggregationType::kSum:
@@ -156,6 +163,8 @@ bool AggregationExecutor::Next(Row* dst, RowPosition* /*rp*/) {
           case AggregationType::kCount:
             ++results[i].value.int_value;
             break;
+          case AggregationType::kApproxCountDistinct:
+            break;
         }
       }
     }
@@ -170,6 +179,9 @@ bool AggregationExecutor::Next(Row* dst, RowPosition* /*rp*/) {
           results[i].value.double_value /= static_cast<double>(counts[i]);
         }
         break;
+      case AggregationType::kApproxCountDistinct:
+        results[i] = Value(static_cast<int64_t>(sketches[i].Estimate()));
+        break;
       default:
         // NOP
         break;
@@ -178,6 +190,8 @@ bool AggregationExecutor::Next(Row* dst, RowPosition* /*rp*/) {
 
   *dst = Row(results);
   executed_ = true;
+  // The DISTINCT sets and sketches go away with this frame.
+  charge_.ReleaseAll();
   return true;
 }
 
@@ -22,6 +22,7 @@
 #include <vector>
 
 #include "executor/executor_base.hpp"
+#include "executor/query_memory.hpp"
 #include "expression/named_expression.hpp"
 #include "expression/jit.hpp"
 #include "type/schema.hpp"
@@ -52,6 +53,9 @@ class AggregationExecutor : public ExecutorBase {
   bool jit_attempted_{false};
   std::optional<JitInt64Kernels> jit_sum_;
   size_t jit_batches_{0};
+  // DISTINCT values and sketches held while Next() aggregates, charged to
+  // the query that built this operator.
+  QueryMemoryCharge charge_;
 };
 
 }  // namespace tinylamb
@@ -38,6 +38,12 @@ class ColumnVector {
   [[nodiscard]] const std::vector<int64_t>& IntegerData() const {
     return integers_;
   }
+  [[nodiscard]] const std::vector<double>& DoubleData() const {
+    return doubles_;
+  }
+  [[nodiscard]] const std::vector<std::string>& StringData() const {
+    return strings_;
+  }
 
  private:
   void AppendDefault();
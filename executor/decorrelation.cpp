@@ -0,0 +1,654 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/decorrelation.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "common/constants.hpp"
+#include "executor/feature_flag.hpp"
+#include "expression/aggregate_expression.hpp"
+#include "expression/binary_expression.hpp"
+#include "expression/column_value.hpp"
+#include "expression/query_expression.hpp"
+#include "expression/rewrite.hpp"
+#include "executor/semi_join.hpp"
+#include "expression/unary_expression.hpp"
+#include "parser/ast.hpp"
+
+namespace tinylamb {
+namespace {
+
+FeatureFlag& Flag() {
+  static FeatureFlag flag("TINYLAMB_DECORRELATION");
+  return flag;
+}
+
+// Qualified columns visible in one statement's FROM clause.
+using ScopeColumns = std::vector<ColumnName>;
+using CteNames = std::unordered_set<std::string>;
+
+// Columns of `scope` that `name` may denote.
+size_t Matches(const ScopeColumns& scope, const ColumnName& name) {
+  size_t matches = 0;
+  for (const ColumnName& column : scope) {
+    if (column.name == name.name &&
+        (name.schema.empty() || column.schema == name.schema)) {
+      ++matches;
+    }
+  }
+  return matches;
+}
+
+std::string OutputName(const NamedExpression& item, size_t index) {
+  if (!item.name.empty()) return item.name;
+  if (item.expression->Type() == TypeTag::kColumnValue) {
+    return item.expression->AsColumnValue().GetColumnName().name;
+  }
+  return "$expr" + std::to_string(index);
+}
+
+bool IsStar(const Expression& expression) {
+  return expression->Type() == TypeTag::kColumnValue &&
+         expression->AsColumnValue().GetColumnName().name == "*";
+}
+
+bool IsArithmetic(BinaryOperation operation) {
+  switch (operation) {
+    case BinaryOperation::kAdd:
+    case BinaryOperation::kSubtract:
+    case BinaryOperation::kMultiply:
+    case BinaryOperation::kDivide:
+    case BinaryOperation::kModulo:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// True when `expression` is NULL whenever `target` (or, with
+// `aggregates`, any non-COUNT aggregate of an empty input) is NULL.
+bool NullPropagating(const Expression& expression, bool aggregates,
+                     const ExpressionBase* target) {
+  switch (expression->Type()) {
+    case TypeTag::kColumnValue:
+    case TypeTag::kConstantValue:
+      return true;
+    case TypeTag::kBinaryExp: {
+      const BinaryExpression& binary = expression->AsBinaryExpression();
+      return IsArithmetic(binary.Op()) &&
+             NullPropagating(binary.Left(), aggregates, target) &&
+             NullPropagating(binary.Right(), aggregates, target);
+    }
+    case TypeTag::kUnaryExp: {
+      const UnaryExpression& unary = expression->AsUnaryExpression();
+      return unary.Op() == UnaryOperation::kMinus &&
+             NullPropagating(unary.Child(), aggregates, target);
+    }
+    case TypeTag::kAggregateExp: {
+      // COUNTs are 0, not NULL, over no rows.
+      const AggregationType type =
+          expression->AsAggregateExpression().GetType();
+      return aggregates && type != AggregationType::kCount &&
+             type != AggregationType::kApproxCountDistinct;
+    }
+    case TypeTag::kQueryExp:
+      return expression.get() == target;
+    default:
+      return false;
+  }
+}
+
+// Scalar subqueries of `expression`, not looking into subquery bodies.
+void CollectScalarQueries(const Expression& expression,
+                          std::vector<const ExpressionBase*>* out) {
+  if (!expression) return;
+  if (expression->Type() == TypeTag::kQueryExp) {
+    const QueryExpression& query = expression->AsQueryExpression();
+    if (!query.Exists() && !query.Test()) out->push_back(expression.get());
+  }
+  for (const Expression& child : ExpressionChildren(expression)) {
+    CollectScalarQueries(child, out);
+  }
+}
+
+Expression ReplaceNode(const Expression& expression,
+                       const ExpressionBase* target,
+                       const Expression& replacement) {
+  if (expression.get() == target) return replacement;
+  std::vector<Expression> children = ExpressionChildren(expression);
+  bool changed = false;
+  for (Expression& child : children) {
+    Expression replaced = ReplaceNode(child, target, replacement);
+    if (replaced != child) {
+      child = std::move(replaced);
+      changed = true;
+    }
+  }
+  return changed ? WithExpressionChildren(expression, std::move(children))
+                 : expression;
+}
+
+struct StatementParts {
+  std::vector<NamedExpression> select_list;
+  std::vector<SelectSource> sources;
+  Expression where;
+  std::vector<Expression> group_by;
+  Expression having;
+  std::unordered_map<std::string, std::shared_ptr<SelectStatement>> with;
+  bool distinct{false};
+};
+
+StatementParts PartsOf(const SelectStatement& statement) {
+  return {statement.SelectList(), statement.Sources(),
+          statement.WhereClause(), statement.GroupBy(),
+          statement.Having(),     statement.WithQueries(),
+          statement.Distinct()};
+}
+
+// `like` with its parts replaced; ORDER BY, LIMIT and aliases are kept.
+std::shared_ptr<SelectStatement> Build(const SelectStatement& like,
+                                       StatementParts parts) {
+  auto statement = std::make_shared<SelectStatement>(
+      std::move(parts.select_list), like.FromClause(), std::move(parts.where),
+      like.OrderBy(), like.Limit(), like.Offset(), parts.distinct);
+  statement->SetSources(std::move(parts.sources));
+  for (const auto& [alias, table] : like.Aliases()) {
+    statement->AddAlias(alias, table);
+  }
+  if (!parts.group_by.empty()) statement->SetGroupBy(std::move(parts.group_by));
+  if (parts.having) statement->SetHaving(std::move(parts.having));
+  for (auto& [name, query] : parts.with) {
+    statement->AddWithQuery(name, std::move(query));
+  }
+  statement->MarkComplex();
+  return statement;
+}
+
+// Correlation of a subquery with the statement around it.
+struct Correlation {
+  // Pairs of `local = outer` columns.
+  std::vector<Expression> local_keys;
+  std::vector<Expression> outer_keys;
+  // The remaining conjuncts; they read the subquery's own sources only.
+  std::vector<Expression> local_conjuncts;
+};
+
+class Decorrelator {
+ public:
+  explicit Decorrelator(const TableSchemaLookup& tables) : tables_(tables) {}
+
+  // Returns the rewritten `statement`, or nullptr when nothing changed.
+  // `statement` must not reference columns of enclosing statements.
+  std::shared_ptr<SelectStatement> Rewrite(const SelectStatement& statement,
+                                           const CteNames& inherited);
+
+  std::vector<std::string> TakeRewrites() { return std::move(rewrites_); }
+
+ private:
+  std::optional<ScopeColumns> ScopeOf(const std::vector<SelectSource>& sources,
+                                      const CteNames& ctes) const;
+  bool ExpressionClosed(const Expression& expression,
+                        std::vector<const ScopeColumns*>* scopes,
+                        const CteNames& ctes,
+                        const std::vector<NamedExpression>* aliases) const;
+  bool StatementClosed(const SelectStatement& statement,
+                       std::vector<const ScopeColumns*>* scopes,
+                       const CteNames& inherited) const;
+  bool Uncorrelated(const SelectStatement& statement,
+                    const CteNames& ctes) const {
+    std::vector<const ScopeColumns*> scopes;
+    return StatementClosed(statement, &scopes, ctes);
+  }
+  std::optional<Correlation> Analyze(const SelectStatement& query,
+                                     const ScopeColumns& outer,
+                                     const CteNames& ctes) const;
+
+  // Rewrites one WHERE conjunct of a statement with sources `sources` and
+  // scope `scope`. Returns the conjunct to keep (nullptr to drop it) and
+  // appends joined derived tables to `sources`. Inner joins, which add
+  // columns, are not used when the statement selects `*`.
+  Expression DecorrelateConjunct(const Expression& conjunct,
+                                 const ScopeColumns& scope,
+                                 const CteNames& ctes, bool selects_star,
+                                 std::vector<SelectSource>* sources);
+  // SELECT keys [, value] FROM the subquery's sources, grouped by the keys
+  // when there is a value.
+  std::shared_ptr<SelectStatement> KeyedDerivedTable(
+      const SelectStatement& query, const Correlation& correlation,
+      std::vector<Expression> keys, const Expression& value,
+      const CteNames& ctes);
+  std::string NextAlias(std::string_view kind) {
+    return "$" + std::string(kind) + "_" + std::to_string(++aliases_);
+  }
+  Expression RewriteNested(const Expression& expression, const CteNames& ctes,
+                           bool* changed);
+
+  const TableSchemaLookup& tables_;
+  size_t aliases_{0};
+  std::vector<std::string> rewrites_;
+};
+
+std::optional<ScopeColumns> Decorrelator::ScopeOf(
+    const std::vector<SelectSource>& sources, const CteNames& ctes) const {
+  ScopeColumns scope;
+  for (const SelectSource& source : sources) {
+    const std::string qualifier =
+        source.alias.empty() ? source.table : source.alias;
+    if (source.query) {
+      const std::vector<NamedExpression>& items = source.query->SelectList();
+      for (size_t i = 0; i < items.size(); ++i) {
+        if (IsStar(items[i].expression)) return std::nullopt;
+        scope.emplace_back(qualifier, OutputName(items[i], i));
+      }
+      continue;
+    }
+    if (ctes.contains(source.table)) return std::nullopt;
+    const std::optional<Schema> schema = tables_(source.table);
+    if (!schema) return std::nullopt;
+    for (size_t i = 0; i < schema->ColumnCount(); ++i) {
+      scope.emplace_back(qualifier, schema->GetColumn(i).Name().name);
+    }
+  }
+  return scope;
+}
+
+bool Decorrelator::ExpressionClosed(
+    const Expression& expression, std::vector<const ScopeColumns*>* scopes,
+    const CteNames& ctes, const std::vector<NamedExpression>* aliases) const {
+  if (!expression) return true;
+  if (expression->Type() == TypeTag::kColumnValue) {
+    const ColumnName& name = expression->AsColumnValue().GetColumnName();
+    if (name.name == "*") return true;
+    // Innermost scope first, as column lookup does at execution.
+    for (auto scope = scopes->rbegin(); scope != scopes->rend(); ++scope) {
+      const size_t matches = Matches(**scope, name);
+      if (matches == 1) return true;
+      if (matches > 1) return false;
+    }
+    if (aliases && name.schema.empty()) {
+      for (size_t i = 0; i < aliases->size(); ++i) {
+        if (OutputName((*aliases)[i], i) == name.name) return true;
+      }
+    }
+    return false;
+  }
+  if (expression->Type() == TypeTag::kQueryExp) {
+    const QueryExpression& query = expression->AsQueryExpression();
+    return ExpressionClosed(query.Test(), scopes, ctes, aliases) &&
+           StatementClosed(*query.Query(), scopes, ctes);
+  }
+  for (const Expression& child : ExpressionChildren(expression)) {
+    if (!ExpressionClosed(child, scopes, ctes, aliases)) return false;
+  }
+  return true;
+}
+
+bool Decorrelator::StatementClosed(const SelectStatement& statement,
+                                   std::vector<const ScopeColumns*>* scopes,
+                                   const CteNames& inherited) const {
+  CteNames ctes = inherited;
+  for (const auto& [name, query] : statement.WithQueries()) ctes.insert(name);
+  for (const auto& [name, query] : statement.WithQueries()) {
+    if (!StatementClosed(*query, scopes, ctes)) return false;
+  }
+  for (const SelectSource& source : statement.Sources()) {
+    if (source.query && !StatementClosed(*source.query, scopes, ctes)) {
+      return false;
+    }
+  }
+  const std::optional<ScopeColumns> scope = ScopeOf(statement.Sources(), ctes);
+  if (!scope) return false;
+  scopes->push_back(&*scope);
+  bool closed = ExpressionClosed(statement.WhereClause(), scopes, ctes,
+                                 nullptr);
+  for (const SelectSource& source : statement.Sources()) {
+    closed = closed &&
+             ExpressionClosed(source.join_condition, scopes, ctes, nullptr);
+  }
+  for (const NamedExpression& item : statement.SelectList()) {
+    closed = closed && ExpressionClosed(item.expression, scopes, ctes, nullptr);
+  }
+  // GROUP BY, HAVING and ORDER BY may also name select-list outputs.
+  const std::vector<NamedExpression>* aliases = &statement.SelectList();
+  for (const Expression& key : statement.GroupBy()) {
+    closed = closed && ExpressionClosed(key, scopes, ctes, aliases);
+  }
+  closed = closed &&
+           ExpressionClosed(statement.Having(), scopes, ctes, aliases);
+  for (const SelectStatement::OrderByTerm& term : statement.OrderBy()) {
+    closed = closed && ExpressionClosed(term.expression, scopes, ctes, aliases);
+  }
+  scopes->pop_back();
+  return closed;
+}
+
+std::optional<Correlation> Decorrelator::Analyze(const SelectStatement& query,
+                                                 const ScopeColumns& outer,
+                                                 const CteNames& ctes) const {
+  if (!query.WithQueries().empty() || !query.GroupBy().empty() ||
+      query.Having() || !query.OrderBy().empty() || query.Limit() != 0 ||
+      query.Offset() != 0 || query.Sources().empty()) {
+    return std::nullopt;
+  }
+  for (const SelectSource& source : query.Sources()) {
+    if (source.query && !Uncorrelated(*source.query, ctes)) {
+      return std::nullopt;
+    }
+  }
+  const std::optional<ScopeColumns> local = ScopeOf(query.Sources(), ctes);
+  if (!local) return std::nullopt;
+  std::vector<const ScopeColumns*> scopes{&*local};
+  for (const SelectSource& source : query.Sources()) {
+    if (!ExpressionClosed(source.join_condition, &scopes, ctes, nullptr)) {
+      return std::nullopt;
+    }
+  }
+  // 0: a column of the subquery, 1: a column of the statement around it.
+  auto side = [&](const Expression& expression) -> int {
+    if (expression->Type() != TypeTag::kColumnValue) return -1;
+    const ColumnName& name = expression->AsColumnValue().GetColumnName();
+    const size_t local_matches = Matches(*local, name);
+    if (local_matches == 1) return 0;
+    if (local_matches == 0 && Matches(outer, name) == 1) return 1;
+    return -1;
+  };
+  Correlation correlation;
+  for (const Expression& conjunct : SplitConjuncts(query.WhereClause())) {
+    if (conjunct->Type() == TypeTag::kBinaryExp &&
+        conjunct->AsBinaryExpression().Op() == BinaryOperation::kEquals) {
+      const BinaryExpression& equality = conjunct->AsBinaryExpression();
+      const int left = side(equality.Left());
+      const int right = side(equality.Right());
+      if (left == 0 && right == 1) {
+        correlation.local_keys.push_back(equality.Left());
+        correlation.outer_keys.push_back(equality.Right());
+        continue;
+      }
+      if (left == 1 && right == 0) {
+        correlation.local_keys.push_back(equality.Right());
+        correlation.outer_keys.push_back(equality.Left());
+        continue;
+      }
+    }
+    if (!ExpressionClosed(conjunct, &scopes, ctes, nullptr)) {
+      return std::nullopt;
+    }
+    correlation.local_conjuncts.push_back(conjunct);
+  }
+  if (correlation.local_keys.empty()) return std::nullopt;
+  return correlation;
+}
+
+std::shared_ptr<SelectStatement> Decorrelator::KeyedDerivedTable(
+    const SelectStatement& query, const Correlation& correlation,
+    std::vector<Expression> keys, const Expression& value,
+    const CteNames& ctes) {
+  StatementParts parts;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    parts.select_list.emplace_back("$key_" + std::to_string(i), keys[i]);
+  }
+  if (value) {
+    parts.select_list.emplace_back("$value", value);
+    parts.group_by = std::move(keys);
+  }
+  parts.sources = query.Sources();
+  parts.where = correlation.local_conjuncts.empty()
+                    ? Expression()
+                    : CombineConjuncts(correlation.local_conjuncts);
+  std::shared_ptr<SelectStatement> derived = Build(query, std::move(parts));
+  // The derived table is uncorrelated, so its own subqueries may unnest.
+  if (std::shared_ptr<SelectStatement> rewritten = Rewrite(*derived, ctes)) {
+    return rewritten;
+  }
+  return derived;
+}
+
+Expression Decorrelator::DecorrelateConjunct(
+    const Expression& conjunct, const ScopeColumns& scope,
+    const CteNames& ctes, bool selects_star,
+    std::vector<SelectSource>* sources) {
+  const QueryExpression* query = nullptr;
+  bool anti = false;
+  if (conjunct->Type() == TypeTag::kQueryExp) {
+    query = &conjunct->AsQueryExpression();
+    anti = query->Negated();
+  } else if (conjunct->Type() == TypeTag::kUnaryExp &&
+             conjunct->AsUnaryExpression().Op() == UnaryOperation::kNot &&
+             conjunct->AsUnaryExpression().Child()->Type() ==
+                 TypeTag::kQueryExp) {
+    query = &conjunct->AsUnaryExpression().Child()->AsQueryExpression();
+    if (!query->Exists() || query->Negated()) return conjunct;
+    anti = true;
+  }
+
+  auto join = [&](JoinType type, const std::string& description,
+                  std::shared_ptr<SelectStatement> derived,
+                  const std::vector<Expression>& outer_keys) {
+    const std::string alias = NextAlias(type == JoinType::kInner ? "scalar"
+                                        : type == JoinType::kSemi ? "semi"
+                                                                  : "anti");
+    std::vector<Expression> equalities;
+    for (size_t i = 0; i < outer_keys.size(); ++i) {
+      equalities.push_back(BinaryExpressionExp(
+          ColumnValueExp(ColumnName(alias, "$key_" + std::to_string(i))),
+          BinaryOperation::kEquals, outer_keys[i]));
+    }
+    SelectSource source;
+    source.alias = alias;
+    source.query = std::move(derived);
+    source.join_type = type;
+    source.join_condition = CombineConjuncts(equalities);
+    std::ostringstream line;
+    line << description << " -> ";
+    if (type == JoinType::kSemi) {
+      line << SemiJoinKindName(SemiJoinKind::kSemi);
+    } else if (type == JoinType::kAnti) {
+      line << SemiJoinKindName(SemiJoinKind::kAnti);
+    } else if (type == JoinType::kAntiNullAware) {
+      line << SemiJoinKindName(SemiJoinKind::kNullAwareAnti);
+    } else {
+      line << "GroupJoin";
+    }
+    line << " " << alias << " on " << *source.join_condition;
+    rewrites_.push_back(line.str());
+    sources->push_back(std::move(source));
+    return alias;
+  };
+
+  if (query) {
+    if (query->Exists()) {
+      const std::optional<Correlation> correlation =
+          Analyze(*query->Query(), scope, ctes);
+      if (!correlation) return conjunct;
+      join(anti ? JoinType::kAnti : JoinType::kSemi,
+           anti ? "NOT EXISTS(...)" : "EXISTS(...)",
+           KeyedDerivedTable(*query->Query(), *correlation,
+                             correlation->local_keys, nullptr, ctes),
+           correlation->outer_keys);
+      return nullptr;
+    }
+    if (!query->Test() || query->Query()->SelectList().size() != 1) {
+      return conjunct;
+    }
+    const Expression& test = query->Test();
+    if (test->Type() != TypeTag::kColumnValue ||
+        Matches(scope, test->AsColumnValue().GetColumnName()) != 1) {
+      return conjunct;
+    }
+    if (anti) {
+      // `test NOT IN (SELECT item ...)` over an uncorrelated body becomes a
+      // NULL-aware anti join on the item, renamed to the join key.
+      const SelectStatement& body = *query->Query();
+      if (!Uncorrelated(body, ctes) ||
+          IsStar(body.SelectList()[0].expression) || !body.OrderBy().empty()) {
+        return conjunct;
+      }
+      StatementParts parts = PartsOf(body);
+      parts.select_list[0].name = "$key_0";
+      std::shared_ptr<SelectStatement> keys = Build(body, std::move(parts));
+      if (std::shared_ptr<SelectStatement> rewritten = Rewrite(*keys, ctes)) {
+        keys = std::move(rewritten);
+      }
+      join(JoinType::kAntiNullAware, conjunct->ToString(), std::move(keys),
+           {test});
+      return nullptr;
+    }
+    // `test IN (SELECT item ...)` with a correlated body.
+    std::optional<Correlation> correlation =
+        Analyze(*query->Query(), scope, ctes);
+    if (!correlation) return conjunct;
+    const Expression& item = query->Query()->SelectList()[0].expression;
+    const std::optional<ScopeColumns> local =
+        ScopeOf(query->Query()->Sources(), ctes);
+    std::vector<const ScopeColumns*> scopes{&*local};
+    if (IsStar(item) || ContainsAggregate(item) ||
+        !ExpressionClosed(item, &scopes, ctes, nullptr)) {
+      return conjunct;
+    }
+    std::vector<Expression> keys{item};
+    keys.insert(keys.end(), correlation->local_keys.begin(),
+                correlation->local_keys.end());
+    std::vector<Expression> outer_keys{test};
+    outer_keys.insert(outer_keys.end(), correlation->outer_keys.begin(),
+                      correlation->outer_keys.end());
+    join(JoinType::kSemi, conjunct->ToString(),
+         KeyedDerivedTable(*query->Query(), *correlation, std::move(keys),
+                           nullptr, ctes),
+         outer_keys);
+    return nullptr;
+  }
+
+  // `expr <cmp> (SELECT aggregate ...)`.
+  if (selects_star || conjunct->Type() != TypeTag::kBinaryExp ||
+      !IsComparison(conjunct->AsBinaryExpression().Op())) {
+    return conjunct;
+  }
+  std::vector<const ExpressionBase*> scalars;
+  CollectScalarQueries(conjunct, &scalars);
+  if (scalars.size() != 1) return conjunct;
+  const ExpressionBase* target = scalars[0];
+  const BinaryExpression& comparison = conjunct->AsBinaryExpression();
+  if (!NullPropagating(comparison.Left(), false, target) ||
+      !NullPropagating(comparison.Right(), false, target)) {
+    return conjunct;
+  }
+  const SelectStatement& body = *target->AsQueryExpression().Query();
+  if (body.SelectList().size() != 1 || body.Distinct()) return conjunct;
+  const Expression& value = body.SelectList()[0].expression;
+  if (!ContainsAggregate(value) || !NullPropagating(value, true, nullptr)) {
+    return conjunct;
+  }
+  std::optional<Correlation> correlation = Analyze(body, scope, ctes);
+  if (!correlation) return conjunct;
+  const std::optional<ScopeColumns> local = ScopeOf(body.Sources(), ctes);
+  std::vector<const ScopeColumns*> scopes{&*local};
+  if (!ExpressionClosed(value, &scopes, ctes, nullptr)) return conjunct;
+  const std::string alias =
+      join(JoinType::kInner, "SCALAR_SUBQUERY(...)",
+           KeyedDerivedTable(body, *correlation, correlation->local_keys,
+                             value, ctes),
+           correlation->outer_keys);
+  return ReplaceNode(conjunct, target,
+                     ColumnValueExp(ColumnName(alias, "$value")));
+}
+
+Expression Decorrelator::RewriteNested(const Expression& expression,
+                                       const CteNames& ctes, bool* changed) {
+  if (!expression) return expression;
+  if (expression->Type() == TypeTag::kQueryExp) {
+    const QueryExpression& query = expression->AsQueryExpression();
+    bool test_changed = false;
+    Expression test = RewriteNested(query.Test(), ctes, &test_changed);
+    std::shared_ptr<SelectStatement> body;
+    if (Uncorrelated(*query.Query(), ctes)) {
+      body = Rewrite(*query.Query(), ctes);
+    }
+    if (!body && !test_changed) return expression;
+    *changed = true;
+    return QueryExpressionExp(body ? std::move(body) : query.Query(),
+                              std::move(test), query.Exists(),
+                              query.Negated());
+  }
+  std::vector<Expression> children = ExpressionChildren(expression);
+  bool any = false;
+  for (Expression& child : children) {
+    child = RewriteNested(child, ctes, &any);
+  }
+  if (!any) return expression;
+  *changed = true;
+  return WithExpressionChildren(expression, std::move(children));
+}
+
+std::shared_ptr<SelectStatement> Decorrelator::Rewrite(
+    const SelectStatement& statement, const CteNames& inherited) {
+  CteNames ctes = inherited;
+  for (const auto& [name, query] : statement.WithQueries()) ctes.insert(name);
+  StatementParts parts = PartsOf(statement);
+  bool changed = false;
+  for (auto& [name, query] : parts.with) {
+    if (std::shared_ptr<SelectStatement> rewritten = Rewrite(*query, ctes)) {
+      query = std::move(rewritten);
+      changed = true;
+    }
+  }
+  for (SelectSource& source : parts.sources) {
+    if (!source.query) continue;
+    if (std::shared_ptr<SelectStatement> rewritten =
+            Rewrite(*source.query, ctes)) {
+      source.query = std::move(rewritten);
+      changed = true;
+    }
+  }
+
+  if (const std::optional<ScopeColumns> scope = ScopeOf(parts.sources, ctes);
+      scope && parts.where) {
+    const bool selects_star = std::any_of(
+        parts.select_list.begin(), parts.select_list.end(),
+        [](const NamedExpression& item) { return IsStar(item.expression); });
+    std::vector<Expression> kept;
+    for (const Expression& conjunct : SplitConjuncts(parts.where)) {
+      Expression rewritten = DecorrelateConjunct(conjunct, *scope, ctes,
+                                                 selects_star, &parts.sources);
+      if (rewritten != conjunct) changed = true;
+      if (rewritten) kept.push_back(std::move(rewritten));
+    }
+    if (changed) {
+      parts.where = kept.empty() ? Expression() : CombineConjuncts(kept);
+    }
+  }
+
+  parts.where = RewriteNested(parts.where, ctes, &changed);
+  for (NamedExpression& item : parts.select_list) {
+    item.expression = RewriteNested(item.expression, ctes, &changed);
+  }
+  parts.having = RewriteNested(parts.having, ctes, &changed);
+  if (!changed) return nullptr;
+  return Build(statement, std::move(parts));
+}
+
+}  // namespace
+
+bool DecorrelationEnabled() { return Flag().Enabled(); }
+
+void SetDecorrelationForTest(int enabled) { Flag().SetForTest(enabled); }
+
+DecorrelatedQuery Decorrelate(std::shared_ptr<const SelectStatement> statement,
+                              const TableSchemaLookup& tables) {
+  DecorrelatedQuery result;
+  if (DecorrelationEnabled()) {
+    Decorrelator decorrelator(tables);
+    if (std::shared_ptr<SelectStatement> rewritten =
+            decorrelator.Rewrite(*statement, {})) {
+      result.statement = std::move(rewritten);
+      result.rewrites = decorrelator.TakeRewrites();
+      return result;
+    }
+  }
+  result.statement = std::move(statement);
+  return result;
+}
+
+}  // namespace tinylamb
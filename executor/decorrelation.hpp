@@ -0,0 +1,62 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_DECORRELATION_HPP
+#define TINYLAMB_EXECUTOR_DECORRELATION_HPP
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "type/schema.hpp"
+
+namespace tinylamb {
+
+class SelectStatement;
+
+// Schema of base table `table`, or nullopt when there is no such table.
+using TableSchemaLookup =
+    std::function<std::optional<Schema>(const std::string& table)>;
+
+// Whether correlated subqueries are rewritten into joins before execution.
+//
+// Config: TINYLAMB_DECORRELATION
+//   - unset or "1": enabled
+//   - "0": correlated subqueries run per outer row (indexed and memoized)
+[[nodiscard]] bool DecorrelationEnabled();
+// Test helper: force the mode (-1 = back to the default).
+void SetDecorrelationForTest(int enabled);
+
+struct DecorrelatedQuery {
+  std::shared_ptr<const SelectStatement> statement;
+  // One line per subquery turned into a join, shown by EXPLAIN.
+  std::vector<std::string> rewrites;
+};
+
+// Unnests correlated subqueries of WHERE conjuncts into joins against
+// derived tables that are computed once for every correlation key.
+//
+// A subquery qualifies when its correlation is a conjunction of
+// `local_column = outer_column` equalities over the statement directly
+// around it and the rest of its WHERE clause is local:
+//
+//   - EXISTS (...) and `x IN (SELECT y ...)` become a JoinType::kSemi source
+//     selecting the key columns.
+//   - NOT EXISTS (...) becomes a JoinType::kAnti source.
+//   - `expr <cmp> (SELECT agg ...)` becomes an inner join with the
+//     aggregate grouped by the key columns. Only non-COUNT aggregates under
+//     null-propagating arithmetic qualify: a key without rows yields NULL,
+//     which the comparison rejects exactly as the dropped join row would.
+//     Statements selecting `*` keep these, since the join adds columns.
+//
+// `x NOT IN (SELECT y ...)` over an uncorrelated body becomes a
+// JoinType::kAntiNullAware source. Everything else, including statements
+// that remain correlated, is left to per-row evaluation. The input is never
+// modified; rewritten statements share every untouched subtree with it.
+[[nodiscard]] DecorrelatedQuery Decorrelate(
+    std::shared_ptr<const SelectStatement> statement,
+    const TableSchemaLookup& tables);
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_DECORRELATION_HPP
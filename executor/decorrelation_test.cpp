@@ -0,0 +1,259 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/decorrelation.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "expression/query_expression.hpp"
+#include "expression/rewrite.hpp"
+#include "gtest/gtest.h"
+#include "parser/ast.hpp"
+#include "type/column.hpp"
+
+namespace tinylamb {
+namespace {
+
+using B = BinaryOperation;
+
+std::optional<Schema> Tables(const std::string& table) {
+  auto columns = [](std::vector<std::string> names) {
+    std::vector<Column> out;
+    for (const std::string& name : names) {
+      out.emplace_back(name, ValueType::kInt64);
+    }
+    return out;
+  };
+  if (table == "orders") {
+    return Schema(table, columns({"o_orderkey", "o_custkey", "o_date"}));
+  }
+  if (table == "lineitem") {
+    return Schema(table, columns({"l_orderkey", "l_partkey", "l_suppkey",
+                                  "l_quantity", "l_commit", "l_receipt"}));
+  }
+  if (table == "part") return Schema(table, columns({"p_partkey", "p_size"}));
+  return std::nullopt;
+}
+
+Expression Col(std::string_view name) { return ColumnValueExp(name); }
+Expression Int(int64_t value) { return ConstantValueExp(Value(value)); }
+Expression Bin(Expression left, B op, Expression right) {
+  return BinaryExpressionExp(std::move(left), op, std::move(right));
+}
+
+std::shared_ptr<SelectStatement> Select(std::vector<NamedExpression> items,
+                                        std::vector<std::string> from,
+                                        Expression where) {
+  auto statement = std::make_shared<SelectStatement>(
+      std::move(items), std::move(from), std::move(where));
+  statement->MarkComplex();
+  return statement;
+}
+
+TEST(DecorrelationTest, ExistsBecomesSemiJoin) {
+  // SELECT o_orderkey FROM orders WHERE o_date < 10 AND EXISTS (
+  //   SELECT * FROM lineitem
+  //   WHERE l_orderkey = o_orderkey AND l_commit < l_receipt)
+  auto exists = Select(
+      {NamedExpression("*")}, {"lineitem"},
+      Bin(Bin(Col("l_orderkey"), B::kEquals, Col("o_orderkey")), B::kAnd,
+          Bin(Col("l_commit"), B::kLessThan, Col("l_receipt"))));
+  auto query = Select(
+      {NamedExpression("o_orderkey")}, {"orders"},
+      Bin(Bin(Col("o_date"), B::kLessThan, Int(10)), B::kAnd,
+          QueryExpressionExp(exists, nullptr, true)));
+
+  const DecorrelatedQuery result = Decorrelate(query, Tables);
+  ASSERT_EQ(result.rewrites.size(), 1U);
+  const SelectStatement& rewritten = *result.statement;
+  ASSERT_EQ(rewritten.Sources().size(), 2U);
+  const SelectSource& semi = rewritten.Sources()[1];
+  EXPECT_EQ(semi.alias, "$semi_1");
+  EXPECT_EQ(semi.join_type, JoinType::kSemi);
+  EXPECT_EQ(semi.join_condition->ToString(),
+            Bin(Col("$semi_1.$key_0"), B::kEquals, Col("o_orderkey"))
+                ->ToString());
+  ASSERT_NE(semi.query, nullptr);
+  // The semi join never emits duplicates, so the keys need no DISTINCT.
+  EXPECT_FALSE(semi.query->Distinct());
+  ASSERT_EQ(semi.query->SelectList().size(), 1U);
+  EXPECT_EQ(semi.query->SelectList()[0].name, "$key_0");
+  EXPECT_EQ(semi.query->WhereClause()->ToString(),
+            Bin(Col("l_commit"), B::kLessThan, Col("l_receipt"))->ToString());
+  EXPECT_EQ(rewritten.WhereClause()->ToString(),
+            Bin(Col("o_date"), B::kLessThan, Int(10))->ToString());
+  // The input statement is left untouched.
+  EXPECT_EQ(query->Sources().size(), 1U);
+}
+
+TEST(DecorrelationTest, ScalarAggregateBecomesGroupedJoin) {
+  // SELECT l_quantity FROM lineitem, part
+  // WHERE p_partkey = l_partkey AND l_quantity < (
+  //   SELECT 2 * AVG(l_quantity) FROM lineitem WHERE l_partkey = p_partkey)
+  auto average =
+      Select({NamedExpression(
+                 "", Bin(Int(2), B::kMultiply,
+                         AggregateExpressionExp(AggregationType::kAvg,
+                                                Col("l_quantity"))))},
+             {"lineitem"}, Bin(Col("l_partkey"), B::kEquals, Col("p_partkey")));
+  auto query = Select(
+      {NamedExpression("l_quantity")}, {"lineitem", "part"},
+      Bin(Bin(Col("p_partkey"), B::kEquals, Col("l_partkey")), B::kAnd,
+          Bin(Col("l_quantity"), B::kLessThan, QueryExpressionExp(average))));
+
+  const DecorrelatedQuery result = Decorrelate(query, Tables);
+  ASSERT_EQ(result.rewrites.size(), 1U);
+  const SelectStatement& rewritten = *result.statement;
+  ASSERT_EQ(rewritten.Sources().size(), 3U);
+  const SelectSource& grouped = rewritten.Sources()[2];
+  EXPECT_EQ(grouped.alias, "$scalar_1");
+  ASSERT_EQ(grouped.query->GroupBy().size(), 1U);
+  EXPECT_EQ(grouped.query->GroupBy()[0]->ToString(), "l_partkey");
+  EXPECT_EQ(grouped.query->SelectList()[1].name, "$value");
+  EXPECT_EQ(grouped.query->WhereClause(), nullptr);
+  const std::vector<Expression> conjuncts =
+      SplitConjuncts(rewritten.WhereClause());
+  ASSERT_EQ(conjuncts.size(), 2U);
+  EXPECT_EQ(conjuncts[1]->ToString(),
+            Bin(Col("l_quantity"), B::kLessThan, Col("$scalar_1.$value"))
+                ->ToString());
+}
+
+TEST(DecorrelationTest, SelectStarKeepsScalarSubqueries) {
+  // A semi join adds no columns, so it is fine under `*`.
+  auto lines = Select({NamedExpression("*")}, {"lineitem"},
+                      Bin(Col("l_orderkey"), B::kEquals, Col("o_orderkey")));
+  auto exists = Select({NamedExpression("*")}, {"orders"},
+                       QueryExpressionExp(lines, nullptr, true));
+  const DecorrelatedQuery semi = Decorrelate(exists, Tables);
+  ASSERT_EQ(semi.statement->Sources().size(), 2U);
+  EXPECT_EQ(semi.statement->Sources()[1].join_type, JoinType::kSemi);
+
+  // The grouped join's $key / $value columns would show up in `*`.
+  auto average = Select(
+      {NamedExpression("", AggregateExpressionExp(AggregationType::kAvg,
+                                                  Col("l_quantity")))},
+      {"lineitem"}, Bin(Col("l_orderkey"), B::kEquals, Col("o_orderkey")));
+  auto scalar = Select(
+      {NamedExpression("*")}, {"orders"},
+      Bin(Col("o_date"), B::kLessThan, QueryExpressionExp(average)));
+  EXPECT_EQ(Decorrelate(scalar, Tables).statement, scalar);
+}
+
+TEST(DecorrelationTest, NotExistsBecomesAntiJoin) {
+  // Two correlation keys: o_orderkey = l_orderkey AND o_custkey = l_suppkey.
+  auto orders = Select(
+      {NamedExpression("*")}, {"orders"},
+      Bin(Bin(Col("o_orderkey"), B::kEquals, Col("l_orderkey")), B::kAnd,
+          Bin(Col("o_custkey"), B::kEquals, Col("l_suppkey"))));
+  auto query = Select(
+      {NamedExpression("*")}, {"lineitem"},
+      UnaryExpressionExp(QueryExpressionExp(orders, nullptr, true),
+                         UnaryOperation::kNot));
+
+  const DecorrelatedQuery result = Decorrelate(query, Tables);
+  ASSERT_EQ(result.rewrites.size(), 1U);
+  EXPECT_NE(result.rewrites[0].find("HashAntiJoin $anti_1"),
+            std::string::npos);
+  EXPECT_EQ(result.statement->WhereClause(), nullptr);
+  ASSERT_EQ(result.statement->Sources().size(), 2U);
+  const SelectSource& anti = result.statement->Sources()[1];
+  EXPECT_EQ(anti.join_type, JoinType::kAnti);
+  EXPECT_EQ(SplitConjuncts(anti.join_condition).size(), 2U);
+  ASSERT_EQ(anti.query->SelectList().size(), 2U);
+  EXPECT_EQ(anti.query->WhereClause(), nullptr);
+}
+
+TEST(DecorrelationTest, NotInBecomesNullAwareAntiJoin) {
+  auto parts = Select({NamedExpression("p_partkey")}, {"part"},
+                      Bin(Col("p_size"), B::kLessThan, Int(5)));
+  auto query = Select({NamedExpression("l_orderkey")}, {"lineitem"},
+                      QueryExpressionExp(parts, Col("l_partkey"), false,
+                                         /*negated=*/true));
+
+  const DecorrelatedQuery result = Decorrelate(query, Tables);
+  ASSERT_EQ(result.rewrites.size(), 1U);
+  EXPECT_EQ(result.statement->WhereClause(), nullptr);
+  ASSERT_EQ(result.statement->Sources().size(), 2U);
+  const SelectSource& anti = result.statement->Sources()[1];
+  EXPECT_EQ(anti.join_type, JoinType::kAntiNullAware);
+  EXPECT_EQ(anti.join_condition->ToString(),
+            Bin(Col("$anti_1.$key_0"), B::kEquals, Col("l_partkey"))
+                ->ToString());
+  EXPECT_EQ(anti.query->SelectList()[0].name, "$key_0");
+  EXPECT_EQ(anti.query->WhereClause()->ToString(),
+            parts->WhereClause()->ToString());
+}
+
+TEST(DecorrelationTest, UnnestsInsideUncorrelatedSubqueries) {
+  // SELECT p_partkey FROM part WHERE p_partkey IN (
+  //   SELECT l_partkey FROM lineitem WHERE l_quantity > (
+  //     SELECT MAX(o_date) FROM orders WHERE o_orderkey = l_orderkey))
+  auto latest = Select(
+      {NamedExpression("", AggregateExpressionExp(AggregationType::kMax,
+                                                  Col("o_date")))},
+      {"orders"}, Bin(Col("o_orderkey"), B::kEquals, Col("l_orderkey")));
+  auto parts = Select(
+      {NamedExpression("l_partkey")}, {"lineitem"},
+      Bin(Col("l_quantity"), B::kGreaterThan, QueryExpressionExp(latest)));
+  auto query = Select({NamedExpression("p_partkey")}, {"part"},
+                      QueryExpressionExp(parts, Col("p_partkey")));
+
+  const DecorrelatedQuery result = Decorrelate(query, Tables);
+  ASSERT_EQ(result.rewrites.size(), 1U);
+  const Expression& where = result.statement->WhereClause();
+  ASSERT_EQ(where->Type(), TypeTag::kQueryExp);
+  const SelectStatement& inner = *where->AsQueryExpression().Query();
+  ASSERT_EQ(inner.Sources().size(), 2U);
+  EXPECT_EQ(inner.Sources()[1].alias, "$scalar_1");
+}
+
+TEST(DecorrelationTest, KeepsSubqueriesThatCannotBeJoined) {
+  // COUNT of no rows is 0, not NULL, so the join would drop outer rows.
+  auto count = Select(
+      {NamedExpression("", AggregateExpressionExp(AggregationType::kCount,
+                                                  Col("*")))},
+      {"lineitem"}, Bin(Col("l_orderkey"), B::kEquals, Col("o_orderkey")));
+  auto counted = Select(
+      {NamedExpression("o_orderkey")}, {"orders"},
+      Bin(Int(0), B::kLessThan, QueryExpressionExp(count)));
+  EXPECT_EQ(Decorrelate(counted, Tables).statement, counted);
+
+  // Correlated NOT IN stays per row.
+  auto matching = Select({NamedExpression("l_partkey")}, {"lineitem"},
+                         Bin(Col("l_orderkey"), B::kEquals, Col("o_orderkey")));
+  auto not_in = Select({NamedExpression("o_orderkey")}, {"orders"},
+                       QueryExpressionExp(matching, Col("o_custkey"), false,
+                                          /*negated=*/true));
+  EXPECT_EQ(Decorrelate(not_in, Tables).statement, not_in);
+
+  // A correlation that is not an equality.
+  auto other = Select({NamedExpression("*")}, {"lineitem"},
+                      Bin(Col("l_orderkey"), B::kNotEquals, Col("o_orderkey")));
+  auto unequal = Select({NamedExpression("o_orderkey")}, {"orders"},
+                        QueryExpressionExp(other, nullptr, true));
+  EXPECT_EQ(Decorrelate(unequal, Tables).statement, unequal);
+
+  // A scalar subquery under OR may be NULL without rejecting the row.
+  auto average = Select(
+      {NamedExpression("", AggregateExpressionExp(AggregationType::kAvg,
+                                                  Col("l_quantity")))},
+      {"lineitem"}, Bin(Col("l_orderkey"), B::kEquals, Col("o_orderkey")));
+  auto either = Select(
+      {NamedExpression("o_orderkey")}, {"orders"},
+      Bin(Bin(Col("o_date"), B::kLessThan, QueryExpressionExp(average)),
+          B::kOr, Bin(Col("o_date"), B::kEquals, Int(1))));
+  EXPECT_EQ(Decorrelate(either, Tables).statement, either);
+
+  SetDecorrelationForTest(0);
+  auto exists = Select({NamedExpression("*")}, {"lineitem"},
+                       Bin(Col("l_orderkey"), B::kEquals, Col("o_orderkey")));
+  auto query = Select({NamedExpression("o_orderkey")}, {"orders"},
+                      QueryExpressionExp(exists, nullptr, true));
+  EXPECT_EQ(Decorrelate(query, Tables).statement, query);
+  SetDecorrelationForTest(-1);
+}
+
+}  // namespace
+}  // namespace tinylamb
@@ -18,6 +18,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <unordered_set>
@@ -44,8 +45,10 @@
 #include "executor/parallel_scan.hpp"
 #include "executor/parallel_aggregation.hpp"
 #include "executor/projection.hpp"
+#include "executor/query_memory.hpp"
 #include "executor/selection.hpp"
 #include "executor/sort.hpp"
+#include "executor/top_n.hpp"
 #include "executor/update.hpp"
 #include "executor/zone_map.hpp"
 #include "expression/expression.hpp"
@@ -395,6 +398,52 @@ TEST_F(ExecutorTest, AggregationUsesJitForLargeIntegerSumBatches) {
   EXPECT_GE(aggregate.JitBatches(), 1U);
 }
 
+TEST_F(ExecutorTest, AggregationChargesDistinctToConstructingQuery) {
+  std::vector<Row> rows;
+  for (int64_t value = 0; value < 256; ++value) {
+    rows.emplace_back(std::vector<Value>{Value(value % 64)});
+  }
+  const Schema schema("distinct", {Column("value", ValueType::kInt64)});
+  std::vector<NamedExpression> aggregates = {NamedExpression(
+      "n", AggregateExpressionExp(AggregationType::kCount,
+                                   ColumnValueExp("value"), true))};
+  const std::shared_ptr<MemoryContext> query = MemoryContext::NewQuery(0);
+  std::optional<AggregationExecutor> aggregate;
+  {
+    // Plans are built under the statement's context and run after it closes.
+    const ScopedMemoryContext scope(query);
+    aggregate.emplace(std::make_shared<ConstantExecutor>(std::move(rows)),
+                      schema, std::move(aggregates));
+  }
+  Row result;
+  ASSERT_TRUE(aggregate->Next(&result, nullptr));
+  EXPECT_EQ(result[0], Value(64));
+  EXPECT_GE(query->Peak(), 64 * sizeof(int64_t));
+  EXPECT_EQ(query->Used(), 0U);
+}
+
+TEST_F(ExecutorTest, AggregationChargesSketchGrowthToConstructingQuery) {
+  std::vector<Row> rows;
+  for (int64_t value = 0; value < 4096; ++value) {
+    rows.emplace_back(std::vector<Value>{Value(value)});
+  }
+  const Schema schema("sketch", {Column("value", ValueType::kInt64)});
+  std::vector<NamedExpression> aggregates = {NamedExpression(
+      "n", AggregateExpressionExp(AggregationType::kApproxCountDistinct,
+                                   ColumnValueExp("value")))};
+  const std::shared_ptr<MemoryContext> query = MemoryContext::NewQuery(0);
+  std::optional<AggregationExecutor> aggregate;
+  {
+    const ScopedMemoryContext scope(query);
+    aggregate.emplace(std::make_shared<ConstantExecutor>(std::move(rows)),
+                      schema, std::move(aggregates));
+  }
+  Row result;
+  ASSERT_TRUE(aggregate->Next(&result, nullptr));
+  EXPECT_GT(query->Peak(), 0U);
+  EXPECT_EQ(query->Used(), 0U);
+}
+
 TEST_F(ExecutorTest, BasicJoin) {
   // Arrange
   TransactionContext ctx = rs_->BeginContext();
@@ -842,6 +891,50 @@ TEST_F(ExecutorTest, ParallelSortPreservesOrderAndStableTies) {
   EXPECT_EQ(previous_value, 99);
 }
 
+TEST_F(ExecutorTest, TopNKeepsFirstRowsWithStableTies) {
+  const Schema schema("synthetic", {Column("value", ValueType::kInt64)});
+  auto input = std::make_shared<SyntheticBatchExecutor>(10000);
+  TopNExecutor top_n(input, schema, {{ColumnValueExp("value"), false}},
+                     /*limit=*/250, /*offset=*/30, 4);
+
+  // Every value appears 100 times; descending, the first 280 rows are the
+  // values 99 and 98 in input order, then 80 rows of 97.
+  std::vector<std::pair<int64_t, slot_t>> rows;
+  Row row;
+  RowPosition position;
+  while (top_n.Next(&row, &position)) {
+    rows.emplace_back(row[0].value.int_value, position.slot);
+  }
+  ASSERT_EQ(rows.size(), 250U);
+  EXPECT_EQ(rows.front(), std::make_pair(int64_t{99}, slot_t{3099}));
+  EXPECT_EQ(rows[70], std::make_pair(int64_t{98}, slot_t{98}));
+  EXPECT_EQ(rows.back(), std::make_pair(int64_t{97}, slot_t{7997}));
+  for (size_t i = 1; i < rows.size(); ++i) {
+    EXPECT_GE(rows[i - 1].first, rows[i].first);
+    if (rows[i - 1].first == rows[i].first) {
+      EXPECT_LT(rows[i - 1].second, rows[i].second);
+    }
+  }
+}
+
+TEST_F(ExecutorTest, TopNDumpAndShortInput) {
+  const Schema schema("synthetic", {Column("value", ValueType::kInt64)});
+  auto input = std::make_shared<ConstantExecutor>(
+      std::vector<Row>{Row({Value(2)}), Row({Value(1)}), Row({Value(3)})});
+  TopNExecutor top_n(input, schema, {{ColumnValueExp("value"), true}},
+                     /*limit=*/5, /*offset=*/1);
+  Row row;
+  RowPosition pos;
+  ASSERT_TRUE(top_n.Next(&row, &pos));
+  EXPECT_EQ(row, Row({Value(2)}));
+  ASSERT_TRUE(top_n.Next(&row, &pos));
+  EXPECT_EQ(row, Row({Value(3)}));
+  ASSERT_FALSE(top_n.Next(&row, nullptr));
+  std::stringstream ss;
+  top_n.Dump(ss, 0);
+  EXPECT_NE(ss.str().find("TopN: 5 offset 1"), std::string::npos) << ss.str();
+}
+
 // ===== DistinctExecutor =====
 TEST_F(ExecutorTest, DistinctEmptyInput) {
   DistinctExecutor distinct(
@@ -1335,6 +1428,34 @@ TEST_F(ExecutorTest, ParallelAggregationNextBatchAndDump) {
   EXPECT_EQ(aggregate.NextBatch(&chunk, 8), 0U);
 }
 
+TEST_F(ExecutorTest, ParallelAggregationApproxCountDistinct) {
+  const Schema schema("synthetic", {Column("value", ValueType::kInt64)});
+  std::vector<Row> rows;
+  for (int64_t i = 0; i < 40000; ++i) rows.push_back(Row({Value(i)}));
+  auto input = std::make_shared<ConstantExecutor>(std::move(rows));
+  std::vector<NamedExpression> aggregates = {
+      NamedExpression("approx",
+                      AggregateExpressionExp(
+                          AggregationType::kApproxCountDistinct,
+                          BinaryExpressionExp(ColumnValueExp("value"),
+                                              BinaryOperation::kModulo,
+                                              ConstantValueExp(Value(30000))))),
+      NamedExpression("small", AggregateExpressionExp(
+                                   AggregationType::kApproxCountDistinct,
+                                   BinaryExpressionExp(
+                                       ColumnValueExp("value"),
+                                       BinaryOperation::kModulo,
+                                       ConstantValueExp(Value(7)))))};
+  ParallelAggregationExecutor aggregate(input, schema, std::move(aggregates),
+                                        3);
+  Row result;
+  ASSERT_TRUE(aggregate.Next(&result, nullptr));
+  // Workers see overlapping values; merged sketches count them once.
+  EXPECT_NEAR(static_cast<double>(result[0].value.int_value), 30000.0,
+              1200.0);
+  EXPECT_EQ(result[1], Value(7));
+}
+
 TEST_F(ExecutorTest, ParallelAggregationMissingColumnThrows) {
   const Schema schema("synthetic", {Column("value", ValueType::kInt64)});
   auto input = std::make_shared<ConstantExecutor>(
@@ -1523,6 +1644,7 @@ TEST_F(ExecutorTest, LimitDump) {
 }  // namespace tinylamb
 
 // ===== RelationalExecutor (complex SELECT plans) coverage =====
+#include "executor/parallel_hash_aggregation.hpp"
 #include "executor/query_memory.hpp"
 #include "query/sql_engine.hpp"
 
@@ -2230,6 +2352,120 @@ TEST_F(ExecutorTest, RelationalGroupByOrderBySpillsUnderBudget) {
   }
 }
 
+TEST_F(ExecutorTest, RelationalGroupBySpillsPartialGroups) {
+  CreateWideTable(*rs_, "WideSpillAgg", 3000);
+  ScopedQueryMemory memory(65536);
+  const std::string sql =
+      "SELECT a.key, COUNT(*), MAX(b.name) FROM WideSpillAgg AS a JOIN "
+      "WideSpillAgg AS b ON a.key = b.key GROUP BY a.key;";
+  const auto rows = RelationalRun(*rs_, sql);
+  ASSERT_EQ(rows.size(), 3000u);
+  std::unordered_set<int64_t> keys;
+  for (const Row& row : rows) {
+    keys.insert(row[0].value.int_value);
+    EXPECT_EQ(row[1], Value(1));
+  }
+  EXPECT_EQ(keys.size(), 3000u);
+  const std::string plan = RelationalExplain(*rs_, sql, /*analyze=*/true);
+  EXPECT_EQ(StatsValue(plan, "aggregate_groups="), 3000);
+  EXPECT_GT(StatsValue(plan, "aggregate_spilled_groups="), 0);
+  EXPECT_GT(StatsValue(plan, "aggregate_spill_partitions="), 0);
+  EXPECT_GE(StatsValue(plan, "aggregate_spill_depth="), 1);
+}
+
+TEST_F(ExecutorTest, RelationalOrderBySpillsSortedRuns) {
+  CreateWideTable(*rs_, "WideSpillSort", 3000);
+  ScopedQueryMemory memory(32768);
+  const std::string sql =
+      "SELECT key, name FROM WideSpillSort ORDER BY name DESC, key;";
+  const auto rows = RelationalRun(*rs_, sql);
+  ASSERT_EQ(rows.size(), 3000u);
+  for (size_t i = 1; i < rows.size(); ++i) {
+    ASSERT_FALSE(rows[i - 1][1] < rows[i][1]);
+    if (rows[i - 1][1] == rows[i][1]) {
+      ASSERT_LT(rows[i - 1][0].value.int_value, rows[i][0].value.int_value);
+    }
+  }
+  const std::string plan = RelationalExplain(*rs_, sql, /*analyze=*/true);
+  EXPECT_GT(StatsValue(plan, "sort_spilled_runs="), 1);
+  EXPECT_EQ(StatsValue(plan, "sort_spilled_rows="), 3000);
+}
+
+TEST_F(ExecutorTest, RelationalOrderByLimitUsesTopN) {
+  CreateWideTable(*rs_, "WideTopN", 2000);
+  const std::string sql =
+      "SELECT key, name FROM WideTopN ORDER BY key % 7 DESC, key LIMIT 5 "
+      "OFFSET 3;";
+  const auto rows = RelationalRun(*rs_, sql);
+  ASSERT_EQ(rows.size(), 5u);
+  const std::vector<int64_t> expected = {27, 34, 41, 48, 55};
+  for (size_t i = 0; i < rows.size(); ++i) {
+    EXPECT_EQ(rows[i][0], Value(expected[i]));
+  }
+  const std::string plan = RelationalExplain(*rs_, sql, /*analyze=*/true);
+  EXPECT_NE(plan.find("TopN keys=2 count=5 offset=3"), std::string::npos)
+      << plan;
+  EXPECT_EQ(StatsValue(plan, "top_n_sorts="), 1);
+}
+
+TEST_F(ExecutorTest, RelationalJoinPushesRuntimeFilterIntoScan) {
+  CreateWideTable(*rs_, "WideProbe", 2000);
+  CreateWideTable(*rs_, "WideBuild", 200);
+  // VARCHAR join keys cannot use an integer key set, so the filtered build
+  // side becomes a Bloom filter that the probe scan checks before decoding.
+  const std::string sql =
+      "SELECT COUNT(*) FROM WideProbe AS p JOIN WideBuild AS b "
+      "ON p.name = b.name WHERE b.key < 10;";
+  const auto rows = RelationalRun(*rs_, sql);
+  ASSERT_EQ(rows.size(), 1u);
+  EXPECT_EQ(rows[0][0], Value(10));
+  const std::string plan = RelationalExplain(*rs_, sql, /*analyze=*/true);
+  EXPECT_EQ(StatsValue(plan, "runtime_filter_scans="), 1);
+  EXPECT_GE(StatsValue(plan, "runtime_filter_rejected="), 1900);
+}
+
+TEST_F(ExecutorTest, RelationalParallelGroupByMatchesSerial) {
+  CreateWideTable(*rs_, "WidePar", 2000);
+  const std::string sql =
+      "SELECT key % 10, COUNT(*), SUM(key), AVG(key), MIN(name) FROM WidePar "
+      "WHERE key % 3 <> 0 GROUP BY key % 10;";
+  SetAggregationWorkersForTest(1);
+  const auto serial = RelationalRun(*rs_, sql);
+  SetAggregationWorkersForTest(4);
+  const auto parallel = RelationalRun(*rs_, sql);
+  const std::string plan = RelationalExplain(*rs_, sql, /*analyze=*/true);
+  SetAggregationWorkersForTest(0);
+  ASSERT_EQ(serial.size(), 10u);
+  EXPECT_EQ(std::unordered_multiset<Row>(parallel.begin(), parallel.end()),
+            std::unordered_multiset<Row>(serial.begin(), serial.end()));
+  EXPECT_EQ(StatsValue(plan, "parallel_aggregations="), 1);
+  EXPECT_EQ(StatsValue(plan, "aggregate_groups="), 10);
+}
+
+TEST_F(ExecutorTest, RelationalFinalJoinStreamsIntoPipeline) {
+  CreateWideTable(*rs_, "WidePipe", 200);
+  // The last join pushes its output straight into the aggregation and the
+  // ORDER BY / LIMIT tail instead of materializing the joined relation.
+  const std::string count_sql =
+      "SELECT COUNT(*) FROM WidePipe AS a JOIN WidePipe AS b ON a.key = b.key "
+      "WHERE b.key < 50;";
+  const auto counted = RelationalRun(*rs_, count_sql);
+  ASSERT_EQ(counted.size(), 1u);
+  EXPECT_EQ(counted[0][0], Value(50));
+  const std::string plan =
+      RelationalExplain(*rs_, count_sql, /*analyze=*/true);
+  EXPECT_EQ(StatsValue(plan, "pipelined_rows="), 50);
+  EXPECT_EQ(StatsValue(plan, "aggregate_input_rows="), 50);
+
+  const auto top = RelationalRun(
+      *rs_, "SELECT a.key FROM WidePipe AS a JOIN WidePipe AS b ON "
+            "a.key = b.key ORDER BY a.key DESC LIMIT 3 OFFSET 1;");
+  ASSERT_EQ(top.size(), 3u);
+  EXPECT_EQ(top[0][0], Value(198));
+  EXPECT_EQ(top[1][0], Value(197));
+  EXPECT_EQ(top[2][0], Value(196));
+}
+
 TEST_F(ExecutorTest, RelationalDistinctCrossJoinSpillsUnderBudget) {
   CreateWideTable(*rs_, "WideDistinct", 200);
   ScopedQueryMemory memory(65536);
@@ -2446,8 +2682,8 @@ TEST_F(ExecutorTest, RelationalStringKeyHybridLeftJoinSpillsUnderBudget) {
 }
 
 TEST_F(ExecutorTest, RelationalLikeWildcardBacktracking) {
-  // '%' and '_' wildcards that require backtracking through the Like matcher
-  // (relational.cpp Like), plus a mid-pattern '%' that is not a trailing match.
+  // '%' and '_' wildcards that require backtracking through LikeMatcher, plus
+  // a mid-pattern '%' that is not a trailing match.
   const auto back = RelationalRun(
       *rs_, "SELECT key FROM SampleTable WHERE name LIKE 'h%o' ORDER BY key;");
   ASSERT_EQ(back.size(), 1u);
@@ -2714,6 +2950,38 @@ TEST_F(ExecutorTest, HashJoinReactiveSpillStringKeyUnderBudget) {
   EXPECT_EQ(count, 300U);
 }
 
+TEST_F(ExecutorTest, HashJoinRadixMatchesInMemory) {
+  // Duplicate keys on both sides; the radix join must produce the in-memory
+  // join's output, as a bag.
+  std::vector<Row> left_rows;
+  std::vector<Row> right_rows;
+  for (int64_t i = 0; i < 2000; ++i) {
+    left_rows.emplace_back(std::vector<Value>{Value(i % 700), Value(i)});
+  }
+  for (int64_t i = 0; i < 3000; ++i) {
+    right_rows.emplace_back(
+        std::vector<Value>{Value(i % 1000), Value("r" + std::to_string(i))});
+  }
+  auto run = [&](HashJoinMode mode) {
+    HashJoin join(std::make_shared<ConstantExecutor>(left_rows), {0},
+                  std::make_shared<ConstantExecutor>(right_rows), {0}, mode,
+                  3);
+    std::unordered_multiset<Row> output;
+    Row got;
+    while (join.Next(&got, nullptr)) output.insert(got);
+    return output;
+  };
+  const std::unordered_multiset<Row> radix = run(HashJoinMode::kRadix);
+  EXPECT_EQ(radix.size(), 2000U * 3);
+  EXPECT_EQ(radix, run(HashJoinMode::kInMemory));
+  HashJoin join(std::make_shared<ConstantExecutor>(left_rows), {0},
+                std::make_shared<ConstantExecutor>(right_rows), {0},
+                HashJoinMode::kRadix, 3);
+  std::stringstream ss;
+  join.Dump(ss, 0);
+  EXPECT_NE(ss.str().find("RadixHashJoin"), std::string::npos);
+}
+
 TEST_F(ExecutorTest, HashJoinHybridAllSpilledUnderBudget) {
   // 256B budget: even partition 0 cannot stay resident, so every build and
   // probe row is spilled and all 32 partitions are joined back from disk.
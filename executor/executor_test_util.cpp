@@ -0,0 +1,27 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/executor_test_util.hpp"
+
+#include "executor/query_memory.hpp"
+
+namespace tinylamb {
+
+ScopedQueryMemoryBudget::ScopedQueryMemoryBudget(size_t limit)
+    : original_(QueryMemoryBudget::Global().Limit()) {
+  QueryMemoryBudget::Global().ResetForTest(limit);
+}
+
+ScopedQueryMemoryBudget::~ScopedQueryMemoryBudget() {
+  QueryMemoryBudget::Global().ResetForTest(original_);
+}
+
+std::vector<Row> ScrambledRows(size_t count, int64_t keys) {
+  std::vector<Row> rows;
+  rows.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto n = static_cast<int64_t>(i);
+    rows.push_back(Row({Value(n * 7919 % keys), Value(n)}));
+  }
+  return rows;
+}
+
+}  // namespace tinylamb
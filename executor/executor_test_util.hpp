@@ -0,0 +1,32 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_EXECUTOR_TEST_UTIL_HPP
+#define TINYLAMB_EXECUTOR_EXECUTOR_TEST_UTIL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Replaces the process-wide query memory budget for the lifetime of the
+// object (0 = unlimited).
+class ScopedQueryMemoryBudget {
+ public:
+  explicit ScopedQueryMemoryBudget(size_t limit);
+  ~ScopedQueryMemoryBudget();
+  ScopedQueryMemoryBudget(const ScopedQueryMemoryBudget&) = delete;
+  ScopedQueryMemoryBudget& operator=(const ScopedQueryMemoryBudget&) = delete;
+
+ private:
+  size_t original_;
+};
+
+// `count` rows (key, sequence) over `keys` keys in scrambled order; each
+// key repeats, so sorts can be checked for stability.
+[[nodiscard]] std::vector<Row> ScrambledRows(size_t count, int64_t keys);
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_EXECUTOR_TEST_UTIL_HPP
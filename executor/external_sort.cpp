@@ -0,0 +1,210 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/external_sort.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "executor/join_hash_table.hpp"
+
+namespace tinylamb {
+
+ExternalSort::ExternalSort(Less less, size_t workers)
+    : less_(std::move(less)), workers_(std::max<size_t>(1, workers)) {}
+
+ExternalSort::ExternalSort(SortKeyFn key_of, size_t workers)
+    : key_of_(std::move(key_of)), workers_(std::max<size_t>(1, workers)) {}
+
+void ExternalSort::Add(Row row, const RowPosition& position) {
+  Entry entry{std::move(row), position, {}};
+  if (key_of_) {
+    key_of_(entry.row, &entry.key.bytes);
+    entry.key.Seal();
+  }
+  const size_t bytes =
+      EstimateRowBytes(entry.row) + sizeof(Entry) + entry.key.bytes.size();
+  if (buffer_.size() >= kMinSortRunRows &&
+      !charge_.Context().CanReserve(bytes)) {
+    SpillBuffer();
+  }
+  charge_.Add(bytes);
+  buffer_.push_back(std::move(entry));
+}
+
+void ExternalSort::Finish() {
+  finished_ = true;
+  if (runs_.empty()) {
+    // Sort slices in parallel, then merge neighbours pairwise, which keeps
+    // equal rows in input order.
+    const std::vector<std::pair<size_t, size_t>> slices = SortSlices();
+    const auto before = [this](const Entry& left, const Entry& right) {
+      return Before(left, right);
+    };
+    const auto at = [&](size_t index) {
+      return buffer_.begin() + static_cast<std::ptrdiff_t>(index);
+    };
+    for (size_t width = 1; width < slices.size(); width *= 2) {
+      for (size_t left = 0; left + width < slices.size(); left += width * 2) {
+        const size_t right = std::min(slices.size(), left + width * 2) - 1;
+        std::inplace_merge(at(slices[left].first),
+                           at(slices[left + width].first),
+                           at(slices[right].second), before);
+      }
+    }
+    return;
+  }
+  if (!buffer_.empty()) SpillBuffer();
+  while (runs_.size() > kMaxMergeFanIn) {
+    // Merge pass: consecutive groups of runs become one run each, so ties
+    // still resolve in input order.
+    const size_t groups = (runs_.size() + kMaxMergeFanIn - 1) / kMaxMergeFanIn;
+    std::vector<SpillFile> merged(groups);
+    RunMorsels(groups, 1, workers_, [&](size_t, size_t group, size_t) {
+      const size_t begin = group * kMaxMergeFanIn;
+      const size_t end = std::min(runs_.size(), begin + kMaxMergeFanIn);
+      Merge merge(&runs_, begin, end, this);
+      Entry entry;
+      while (merge.Next(&entry)) Write(std::move(entry), &merged[group]);
+      merged[group].FinishWriting();
+      for (size_t run = begin; run < end; ++run) runs_[run] = SpillFile();
+    });
+    spilled_runs_ += groups;
+    runs_ = std::move(merged);
+  }
+  merge_ = std::make_unique<Merge>(&runs_, 0, runs_.size(), this);
+}
+
+bool ExternalSort::Next(Row* row, RowPosition* position) {
+  if (!finished_) Finish();
+  if (merge_) {
+    Entry entry;
+    if (!merge_->Next(&entry)) return false;
+    *row = std::move(entry.row);
+    if (position != nullptr) *position = entry.position;
+    return true;
+  }
+  if (offset_ >= buffer_.size()) {
+    if (!buffer_.empty()) {
+      buffer_.clear();
+      buffer_.shrink_to_fit();
+      charge_.ReleaseAll();
+    }
+    return false;
+  }
+  *row = std::move(buffer_[offset_].row);
+  if (position != nullptr) *position = buffer_[offset_].position;
+  ++offset_;
+  return true;
+}
+
+bool ExternalSort::Before(const Entry& left, const Entry& right) const {
+  if (key_of_) return left.key < right.key;
+  return less_(left.row, right.row);
+}
+
+void ExternalSort::Write(Entry&& entry, SpillFile* run) const {
+  if (key_of_) entry.row.values_.emplace_back(std::move(entry.key.bytes));
+  run->Append(entry.row, entry.position);
+}
+
+bool ExternalSort::Read(SpillFile* run, Entry* entry) const {
+  if (!run->ReadNext(&entry->row, &entry->position)) return false;
+  if (key_of_) {
+    entry->key.bytes = entry->row.values_.back().value.varchar_value;
+    entry->key.Seal();
+    entry->row.values_.pop_back();
+  }
+  return true;
+}
+
+std::vector<std::pair<size_t, size_t>> ExternalSort::SortSlices() {
+  const size_t rows = buffer_.size();
+  const size_t count =
+      rows < kMinParallelSortRows ? 1 : std::min(workers_, rows);
+  std::vector<std::pair<size_t, size_t>> slices;
+  slices.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    slices.emplace_back(i * rows / count, (i + 1) * rows / count);
+  }
+  RunMorsels(count, 1, workers_, [&](size_t, size_t slice, size_t) {
+    std::stable_sort(
+        buffer_.begin() + static_cast<std::ptrdiff_t>(slices[slice].first),
+        buffer_.begin() + static_cast<std::ptrdiff_t>(slices[slice].second),
+        [this](const Entry& left, const Entry& right) {
+          return Before(left, right);
+        });
+  });
+  return slices;
+}
+
+void ExternalSort::SpillBuffer() {
+  const std::vector<std::pair<size_t, size_t>> slices = SortSlices();
+  const size_t first = runs_.size();
+  runs_.resize(first + slices.size());
+  RunMorsels(slices.size(), 1, workers_, [&](size_t, size_t slice, size_t) {
+    SpillFile& run = runs_[first + slice];
+    for (size_t i = slices[slice].first; i < slices[slice].second; ++i) {
+      Write(std::move(buffer_[i]), &run);
+    }
+    run.FinishWriting();
+  });
+  spilled_runs_ += slices.size();
+  spilled_rows_ += buffer_.size();
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  charge_.ReleaseAll();
+}
+
+ExternalSort::Merge::Merge(std::vector<SpillFile>* runs, size_t begin,
+                           size_t end, const ExternalSort* sort)
+    : sort_(sort) {
+  cursors_.reserve(end - begin);
+  for (size_t run = begin; run < end; ++run) {
+    cursors_.push_back(Cursor{&(*runs)[run]});
+    cursors_.back().run->StartReading();
+    Advance(cursors_.size() - 1);
+  }
+  tree_.resize(cursors_.size());
+  if (!cursors_.empty()) tree_[0] = Build(1);
+}
+
+bool ExternalSort::Merge::Next(Entry* entry) {
+  if (cursors_.empty()) return false;
+  size_t winner = tree_[0];
+  Cursor& cursor = cursors_[winner];
+  if (!cursor.valid) return false;
+  *entry = std::move(cursor.entry);
+  Advance(winner);
+  for (size_t node = (winner + cursors_.size()) / 2; node > 0; node /= 2) {
+    if (Beats(tree_[node], winner)) std::swap(tree_[node], winner);
+  }
+  tree_[0] = winner;
+  return true;
+}
+
+bool ExternalSort::Merge::Beats(size_t left, size_t right) const {
+  const Cursor& a = cursors_[left];
+  const Cursor& b = cursors_[right];
+  if (!a.valid || !b.valid) return a.valid;
+  if (sort_->Before(a.entry, b.entry)) return true;
+  if (sort_->Before(b.entry, a.entry)) return false;
+  return left < right;
+}
+
+size_t ExternalSort::Merge::Build(size_t node) {
+  if (node >= cursors_.size()) return node - cursors_.size();
+  const size_t left = Build(node * 2);
+  const size_t right = Build(node * 2 + 1);
+  if (Beats(left, right)) {
+    tree_[node] = right;
+    return left;
+  }
+  tree_[node] = left;
+  return right;
+}
+
+void ExternalSort::Merge::Advance(size_t input) {
+  Cursor& cursor = cursors_[input];
+  cursor.valid = sort_->Read(cursor.run, &cursor.entry);
+}
+
+}  // namespace tinylamb
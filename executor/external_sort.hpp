@@ -0,0 +1,115 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_EXTERNAL_SORT_HPP
+#define TINYLAMB_EXECUTOR_EXTERNAL_SORT_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "executor/query_memory.hpp"
+#include "executor/sort_key.hpp"
+#include "executor/spill_file.hpp"
+#include "page/row_position.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Buffered rows below which sorting stays on the calling thread.
+inline constexpr size_t kMinParallelSortRows = 4096;
+// Fewest rows a spilled run holds, so a budget exhausted by other operators
+// does not write a run per row.
+inline constexpr size_t kMinSortRunRows = 64;
+// Most runs merged at once. More runs are first merged in groups of this
+// many into longer runs, so a merge holds one row per input at most.
+inline constexpr size_t kMaxMergeFanIn = 64;
+
+// Stable external merge sort within the query memory budget.
+//
+// Rows are buffered while the QueryMemoryBudget allows. When the next row
+// does not fit, the buffer is cut into one slice per worker; every worker
+// sorts its slice and writes it to a SpillFile as a sorted run. Finish()
+// either sorts a never-spilled buffer in memory, or spills the rest and
+// k-way merges the runs with a loser tree. Equal rows keep their input
+// order.
+//
+// Rows are ordered either by a comparator or by normalized sort keys. A key
+// is encoded once per row in Add(), on the calling thread, and travels with
+// the row into the runs; comparisons are then plain byte compares.
+class ExternalSort {
+ public:
+  // less(a, b) orders rows; it is called on worker threads.
+  using Less = std::function<bool(const Row&, const Row&)>;
+
+  ExternalSort(Less less, size_t workers);
+  ExternalSort(SortKeyFn key_of, size_t workers);
+  ExternalSort(const ExternalSort&) = delete;
+  ExternalSort& operator=(const ExternalSort&) = delete;
+
+  void Add(Row row, const RowPosition& position = RowPosition());
+  // Ends the input. Rows then come out in order from Next().
+  void Finish();
+  bool Next(Row* row, RowPosition* position = nullptr);
+
+  // Sorted runs written to disk, including those of merge passes.
+  [[nodiscard]] size_t SpilledRuns() const { return spilled_runs_; }
+  [[nodiscard]] size_t SpilledRows() const { return spilled_rows_; }
+
+ private:
+  struct Entry {
+    Row row;
+    RowPosition position;
+    // Normalized sort key; empty when ordering by `less_`.
+    SortKey key;
+  };
+
+  // Merges SpillFile runs; inputs earlier in `runs` win ties.
+  class Merge {
+   public:
+    Merge(std::vector<SpillFile>* runs, size_t begin, size_t end,
+          const ExternalSort* sort);
+    bool Next(Entry* entry);
+
+   private:
+    struct Cursor {
+      SpillFile* run{nullptr};
+      Entry entry{};
+      bool valid{false};
+    };
+    [[nodiscard]] bool Beats(size_t left, size_t right) const;
+    size_t Build(size_t node);
+    void Advance(size_t input);
+
+    std::vector<Cursor> cursors_;
+    // tree_[0] is the input whose row comes next; tree_[1, k) hold the
+    // loser of each internal node. Leaf i is node k + i.
+    std::vector<size_t> tree_;
+    const ExternalSort* sort_;
+  };
+
+  [[nodiscard]] bool Before(const Entry& left, const Entry& right) const;
+  // Runs store the key, if any, as an extra trailing value of the row.
+  void Write(Entry&& entry, SpillFile* run) const;
+  bool Read(SpillFile* run, Entry* entry) const;
+  // Sorts one slice of the buffer per worker and returns the slices.
+  std::vector<std::pair<size_t, size_t>> SortSlices();
+  void SpillBuffer();
+
+  Less less_;
+  SortKeyFn key_of_;
+  size_t workers_;
+  std::vector<Entry> buffer_;
+  QueryMemoryCharge charge_;
+  std::vector<SpillFile> runs_;
+  std::unique_ptr<Merge> merge_;
+  size_t offset_{0};
+  bool finished_{false};
+  size_t spilled_runs_{0};
+  size_t spilled_rows_{0};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_EXTERNAL_SORT_HPP
@@ -0,0 +1,111 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/external_sort.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "executor/executor_test_util.hpp"
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+bool KeyLess(const Row& left, const Row& right) { return left[0] < right[0]; }
+
+std::vector<Row> Sort(const std::vector<Row>& rows, ExternalSort* sort) {
+  for (const Row& row : rows) sort->Add(row);
+  sort->Finish();
+  std::vector<Row> sorted;
+  Row row;
+  while (sort->Next(&row)) sorted.push_back(row);
+  return sorted;
+}
+
+std::vector<Row> Expected(std::vector<Row> rows) {
+  std::stable_sort(rows.begin(), rows.end(), KeyLess);
+  return rows;
+}
+
+}  // namespace
+
+TEST(ExternalSortTest, SortsInMemoryStably) {
+  ScopedQueryMemoryBudget budget(0);
+  const std::vector<Row> rows = ScrambledRows(10000, 97);
+  ExternalSort sort(KeyLess, 4);
+  EXPECT_EQ(Sort(rows, &sort), Expected(rows));
+  EXPECT_EQ(sort.SpilledRuns(), 0U);
+  EXPECT_EQ(sort.SpilledRows(), 0U);
+}
+
+TEST(ExternalSortTest, MergesSpilledRunsStably) {
+  ScopedQueryMemoryBudget budget(64 << 10);
+  const std::vector<Row> rows = ScrambledRows(20000, 101);
+  ExternalSort sort(KeyLess, 2);
+  EXPECT_EQ(Sort(rows, &sort), Expected(rows));
+  EXPECT_GT(sort.SpilledRuns(), 1U);
+  EXPECT_EQ(sort.SpilledRows(), rows.size());
+}
+
+TEST(ExternalSortTest, MergePassesBeyondFanIn) {
+  ScopedQueryMemoryBudget budget(1);
+  const std::vector<Row> rows =
+      ScrambledRows(kMinSortRunRows * kMaxMergeFanIn * 3, 13);
+  ExternalSort sort(KeyLess, 1);
+  EXPECT_EQ(Sort(rows, &sort), Expected(rows));
+  // Runs of kMinSortRunRows each, then one merge pass into three runs.
+  EXPECT_EQ(sort.SpilledRuns(), kMaxMergeFanIn * 3 + 3);
+}
+
+TEST(ExternalSortTest, SortsByNormalizedKeysAcrossRuns) {
+  ScopedQueryMemoryBudget budget(1);
+  const std::vector<Row> rows =
+      ScrambledRows(kMinSortRunRows * kMaxMergeFanIn * 2, 61);
+  ExternalSort sort(
+      [](const Row& row, std::string* key) {
+        key->clear();
+        AppendSortKey(row[0], false, key);
+      },
+      2);
+  std::vector<Row> expected = rows;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const Row& left, const Row& right) {
+                     return right[0] < left[0];
+                   });
+  EXPECT_EQ(Sort(rows, &sort), expected);
+  EXPECT_GT(sort.SpilledRuns(), kMaxMergeFanIn);
+}
+
+TEST(ExternalSortTest, KeepsPositionsAndCustomOrder) {
+  ScopedQueryMemoryBudget budget(1);
+  ExternalSort sort(
+      [](const Row& left, const Row& right) {
+        return right[0].value.varchar_value < left[0].value.varchar_value;
+      },
+      1);
+  for (int i = 0; i < 500; ++i) {
+    sort.Add(Row({Value("k" + std::to_string(i % 50))}),
+             RowPosition(i, static_cast<uint16_t>(i % 7)));
+  }
+  Row row;
+  RowPosition position;
+  std::string previous = "~";
+  int previous_page = -1;
+  size_t count = 0;
+  while (sort.Next(&row, &position)) {
+    const std::string key(row[0].value.varchar_value);
+    ASSERT_LE(key, previous);
+    if (key != previous) previous_page = -1;
+    EXPECT_EQ(key, "k" + std::to_string(position.page_id % 50));
+    EXPECT_EQ(position.slot, position.page_id % 7);
+    EXPECT_GT(static_cast<int>(position.page_id), previous_page);
+    previous_page = static_cast<int>(position.page_id);
+    previous = key;
+    ++count;
+  }
+  EXPECT_EQ(count, 500U);
+  EXPECT_GT(sort.SpilledRuns(), 1U);
+}
+
+}  // namespace tinylamb
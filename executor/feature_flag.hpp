@@ -0,0 +1,39 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_FEATURE_FLAG_HPP
+#define TINYLAMB_EXECUTOR_FEATURE_FLAG_HPP
+
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+
+namespace tinylamb {
+
+// An executor feature that is on unless environment variable `env` is "0".
+// The variable is read when the flag is built; tests may override it.
+class FeatureFlag {
+ public:
+  explicit FeatureFlag(const char* env) : env_(env), mode_(Default()) {}
+  FeatureFlag(const FeatureFlag&) = delete;
+  FeatureFlag& operator=(const FeatureFlag&) = delete;
+
+  [[nodiscard]] bool Enabled() const {
+    return mode_.load(std::memory_order_relaxed) != 0;
+  }
+  // 0 turns the feature off, 1 on, and -1 restores the environment's choice.
+  void SetForTest(int enabled) {
+    mode_.store(enabled < 0 ? Default() : enabled, std::memory_order_relaxed);
+  }
+
+ private:
+  [[nodiscard]] int Default() const {
+    const char* value = std::getenv(env_);
+    return value != nullptr && std::string_view(value) == "0" ? 0 : 1;
+  }
+
+  const char* env_;
+  std::atomic<int> mode_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_FEATURE_FLAG_HPP
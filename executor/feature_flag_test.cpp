@@ -0,0 +1,30 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/feature_flag.hpp"
+
+#include <cstdlib>
+
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+
+TEST(FeatureFlagTest, OnUnlessTheVariableIsZero) {
+  unsetenv("TINYLAMB_FEATURE_FLAG_TEST");
+  EXPECT_TRUE(FeatureFlag("TINYLAMB_FEATURE_FLAG_TEST").Enabled());
+  ASSERT_EQ(setenv("TINYLAMB_FEATURE_FLAG_TEST", "1", 1), 0);
+  EXPECT_TRUE(FeatureFlag("TINYLAMB_FEATURE_FLAG_TEST").Enabled());
+  ASSERT_EQ(setenv("TINYLAMB_FEATURE_FLAG_TEST", "0", 1), 0);
+  EXPECT_FALSE(FeatureFlag("TINYLAMB_FEATURE_FLAG_TEST").Enabled());
+  unsetenv("TINYLAMB_FEATURE_FLAG_TEST");
+}
+
+TEST(FeatureFlagTest, TestOverridesRestoreTheEnvironment) {
+  ASSERT_EQ(setenv("TINYLAMB_FEATURE_FLAG_TEST", "0", 1), 0);
+  FeatureFlag flag("TINYLAMB_FEATURE_FLAG_TEST");
+  flag.SetForTest(1);
+  EXPECT_TRUE(flag.Enabled());
+  flag.SetForTest(-1);
+  EXPECT_FALSE(flag.Enabled());
+  unsetenv("TINYLAMB_FEATURE_FLAG_TEST");
+}
+
+}  // namespace tinylamb
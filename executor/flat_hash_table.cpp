@@ -0,0 +1,95 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/flat_hash_table.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace tinylamb {
+namespace {
+
+constexpr size_t kArenaBlockBytes = 64 * 1024;
+
+uint64_t MixWord(uint64_t hash, uint64_t word) {
+  word *= 0x87c37b91114253d5ULL;
+  word = std::rotl(word, 31);
+  word *= 0x4cf5ad432745937fULL;
+  hash ^= word;
+  return std::rotl(hash, 27) * 5 + 0x52dce729;
+}
+
+void AppendBytes(const void* bytes, size_t size, std::string* out) {
+  out->append(static_cast<const char*>(bytes), size);
+}
+
+}  // namespace
+
+uint64_t FlatHash(std::string_view key) {
+  uint64_t hash = 0x9E3779B97F4A7C15ULL;
+  const char* data = key.data();
+  size_t remaining = key.size();
+  for (; remaining >= 8; data += 8, remaining -= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, 8);
+    hash = MixWord(hash, word);
+  }
+  if (remaining > 0) {
+    uint64_t word = 0;
+    std::memcpy(&word, data, remaining);
+    hash = MixWord(hash, word);
+  }
+  return FlatHash(hash ^ key.size());
+}
+
+void AppendFlatKey(const Value& value, std::string* out) {
+  out->push_back(static_cast<char>(value.type));
+  switch (value.type) {
+    case ValueType::kNull:
+      return;
+    case ValueType::kInt64:
+    case ValueType::kDate:
+      AppendBytes(&value.value.int_value, sizeof(int64_t), out);
+      return;
+    case ValueType::kDouble: {
+      const double number =
+          value.value.double_value == 0.0 ? 0.0 : value.value.double_value;
+      AppendBytes(&number, sizeof(double), out);
+      return;
+    }
+    case ValueType::kVarChar: {
+      // Length prefix keeps adjacent strings of a row apart.
+      const auto size = static_cast<uint32_t>(value.value.varchar_value.size());
+      AppendBytes(&size, sizeof(size), out);
+      out->append(value.value.varchar_value);
+      return;
+    }
+  }
+}
+
+void AppendFlatKey(const Row& row, std::string* out) {
+  for (const Value& value : row.values_) AppendFlatKey(value, out);
+}
+
+namespace flat_internal {
+
+std::string_view KeyArena::Copy(std::string_view key) {
+  if (key.empty()) return {};
+  if (key.size() > capacity_ - used_) {
+    capacity_ = std::max(kArenaBlockBytes, key.size());
+    blocks_.push_back(std::make_unique<char[]>(capacity_));
+    used_ = 0;
+  }
+  char* destination = blocks_.back().get() + used_;
+  std::memcpy(destination, key.data(), key.size());
+  used_ += key.size();
+  return {destination, key.size()};
+}
+
+void KeyArena::Clear() {
+  blocks_.clear();
+  used_ = 0;
+  capacity_ = 0;
+}
+
+}  // namespace flat_internal
+
+}  // namespace tinylamb
@@ -0,0 +1,261 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_FLAT_HASH_TABLE_HPP
+#define TINYLAMB_EXECUTOR_FLAT_HASH_TABLE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/hash.hpp"
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+
+// Composite key of two integer columns.
+struct Int64Pair {
+  int64_t first;
+  int64_t second;
+  bool operator==(const Int64Pair&) const = default;
+};
+
+// In-tree hashes for the flat tables. Integers go through Fmix64 so every
+// key bit reaches both the low bits (slot) and the high bits (tag,
+// partition); strings are mixed eight bytes at a time.
+[[nodiscard]] inline uint64_t FlatHash(uint64_t key) { return Fmix64(key); }
+[[nodiscard]] inline uint64_t FlatHash(int64_t key) {
+  return FlatHash(static_cast<uint64_t>(key));
+}
+[[nodiscard]] inline uint64_t FlatHash(const Int64Pair& key) {
+  constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+  return FlatHash(static_cast<uint64_t>(key.first) * kGolden ^
+                  static_cast<uint64_t>(key.second));
+}
+[[nodiscard]] uint64_t FlatHash(std::string_view key);
+
+// Appends a byte encoding of `value` to `out` that is injective on what
+// Value::operator== distinguishes (type and payload; -0.0 folds into 0.0).
+// Unlike the memcomparable format it is cheap, never allocates a temporary
+// and accepts NULL, so it serves as the key of string-keyed flat tables.
+void AppendFlatKey(const Value& value, std::string* out);
+void AppendFlatKey(const Row& row, std::string* out);
+
+namespace flat_internal {
+
+// Owns the bytes of string_view keys; blocks never move, so views stay valid
+// while the owning table grows or is moved.
+class KeyArena {
+ public:
+  std::string_view Copy(std::string_view key);
+  void Clear();
+
+ private:
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  size_t used_{0};
+  size_t capacity_{0};
+};
+
+struct Empty {};
+
+}  // namespace flat_internal
+
+// Open-addressing hash map for int64_t, Int64Pair and std::string_view keys.
+// Entries live densely in insertion order; the probe array only holds
+// (32-bit hash tag, entry number) words, so a probe sequence reads 8-byte
+// slots and touches an entry only on a tag hit. string_view keys are copied
+// into a table-owned arena on insertion, so callers may probe and insert
+// from a reused buffer. Value pointers stay valid until the next insertion.
+template <typename Key, typename Value>
+class FlatHashMap {
+  static_assert(std::is_same_v<Key, int64_t> ||
+                    std::is_same_v<Key, Int64Pair> ||
+                    std::is_same_v<Key, std::string_view>,
+                "FlatHashMap is specialized for int64, two-int64 and "
+                "string_view keys");
+
+ public:
+  struct Entry {
+    Key key;
+    Value value;
+  };
+
+  [[nodiscard]] size_t Size() const { return entries_.size(); }
+  [[nodiscard]] bool Empty() const { return entries_.empty(); }
+
+  void Reserve(size_t entries) {
+    entries_.reserve(entries);
+    if (SlotsFor(entries) > slots_.size()) Rehash(SlotsFor(entries));
+  }
+
+  void Clear() {
+    entries_.clear();
+    slots_.clear();
+    mask_ = 0;
+    arena_.Clear();
+  }
+
+  // Returns the value stored under `key` and whether it was just inserted
+  // (value-initialized).
+  std::pair<Value*, bool> TryEmplace(Key key) {
+    if (SlotsFor(entries_.size() + 1) > slots_.size()) {
+      Rehash(SlotsFor(entries_.size() + 1));
+    }
+    const uint64_t hash = FlatHash(key);
+    const uint64_t tag = hash >> 32;
+    for (size_t slot = hash & mask_;; slot = (slot + 1) & mask_) {
+      const uint64_t word = slots_[slot];
+      if (word == 0) {
+        if constexpr (std::is_same_v<Key, std::string_view>) {
+          key = arena_.Copy(key);
+        }
+        entries_.push_back(Entry{key, Value{}});
+        slots_[slot] = (tag << 32) | entries_.size();
+        return {&entries_.back().value, true};
+      }
+      if ((word >> 32) == tag) {
+        Entry& entry = entries_[(word & 0xFFFFFFFFULL) - 1];
+        if (entry.key == key) return {&entry.value, false};
+      }
+    }
+  }
+
+  [[nodiscard]] Value* Find(Key key) {
+    return const_cast<Value*>(std::as_const(*this).Find(key));
+  }
+  [[nodiscard]] const Value* Find(Key key) const {
+    if (entries_.empty()) return nullptr;
+    const uint64_t hash = FlatHash(key);
+    const uint64_t tag = hash >> 32;
+    for (size_t slot = hash & mask_;; slot = (slot + 1) & mask_) {
+      const uint64_t word = slots_[slot];
+      if (word == 0) return nullptr;
+      if ((word >> 32) == tag) {
+        const Entry& entry = entries_[(word & 0xFFFFFFFFULL) - 1];
+        if (entry.key == key) return &entry.value;
+      }
+    }
+  }
+  [[nodiscard]] bool Contains(Key key) const { return Find(key) != nullptr; }
+
+  // Entries in insertion order.
+  auto begin() { return entries_.begin(); }
+  auto end() { return entries_.end(); }
+  auto begin() const { return entries_.begin(); }
+  auto end() const { return entries_.end(); }
+
+ private:
+  // Probe array size keeping the load factor at or below 1/2.
+  static size_t SlotsFor(size_t entries) {
+    return std::bit_ceil(std::max<size_t>(16, entries * 2));
+  }
+
+  void Rehash(size_t slots) {
+    slots_.assign(slots, 0);
+    mask_ = slots - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      const uint64_t hash = FlatHash(entries_[i].key);
+      size_t slot = hash & mask_;
+      while (slots_[slot] != 0) slot = (slot + 1) & mask_;
+      slots_[slot] = ((hash >> 32) << 32) | (i + 1);
+    }
+  }
+
+  std::vector<Entry> entries_;
+  std::vector<uint64_t> slots_;
+  size_t mask_{0};
+  flat_internal::KeyArena arena_;
+};
+
+template <typename Key>
+class FlatHashSet {
+ public:
+  [[nodiscard]] size_t Size() const { return map_.Size(); }
+  [[nodiscard]] bool Empty() const { return map_.Empty(); }
+  void Reserve(size_t keys) { map_.Reserve(keys); }
+  void Clear() { map_.Clear(); }
+  // Returns true when `key` was not in the set yet.
+  bool Insert(Key key) { return map_.TryEmplace(key).second; }
+  [[nodiscard]] bool Contains(Key key) const { return map_.Contains(key); }
+
+  // Calls fn(key) for every key in insertion order.
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (const auto& entry : map_) fn(entry.key);
+  }
+
+ private:
+  FlatHashMap<Key, flat_internal::Empty> map_;
+};
+
+// Multimap on FlatHashMap for hash-join builds: each distinct key maps to a
+// chain of values threaded through one dense array, visited in insertion
+// order. Holds up to 2^32 - 1 values.
+template <typename Key, typename T>
+class FlatMultiMap {
+ public:
+  [[nodiscard]] size_t Size() const { return items_.size(); }
+
+  void Reserve(size_t values) {
+    heads_.Reserve(values);
+    items_.reserve(values);
+  }
+
+  void Insert(Key key, T value) {
+    const auto item = static_cast<uint32_t>(items_.size());
+    items_.push_back(Item{std::move(value), kEnd});
+    auto [chain, inserted] = heads_.TryEmplace(key);
+    if (inserted) {
+      chain->first = item;
+    } else {
+      items_[chain->last].next = item;
+    }
+    chain->last = item;
+  }
+
+  // Calls fn(const T&) for every value stored under `key`.
+  template <typename Fn>
+  void ForEachMatch(Key key, Fn&& fn) const {
+    const Chain* chain = heads_.Find(key);
+    if (chain == nullptr) return;
+    for (uint32_t item = chain->first; item != kEnd; item = items_[item].next) {
+      fn(items_[item].value);
+    }
+  }
+
+  // Whether pred(const T&) holds for some value stored under `key`; stops at
+  // the first value that satisfies it.
+  template <typename Pred>
+  [[nodiscard]] bool AnyMatch(Key key, Pred&& pred) const {
+    const Chain* chain = heads_.Find(key);
+    if (chain == nullptr) return false;
+    for (uint32_t item = chain->first; item != kEnd; item = items_[item].next) {
+      if (pred(items_[item].value)) return true;
+    }
+    return false;
+  }
+
+ private:
+  static constexpr uint32_t kEnd = ~uint32_t{0};
+  struct Chain {
+    uint32_t first;
+    uint32_t last;
+  };
+  struct Item {
+    T value;
+    uint32_t next;
+  };
+
+  FlatHashMap<Key, Chain> heads_;
+  std::vector<Item> items_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_FLAT_HASH_TABLE_HPP
@@ -0,0 +1,104 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/flat_hash_table.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+
+TEST(FlatHashTableTest, MapGrowsAndKeepsInsertionOrder) {
+  FlatHashMap<int64_t, int64_t> map;
+  for (int64_t i = 0; i < 10000; ++i) {
+    auto [value, inserted] = map.TryEmplace(i * 7919 - 5000);
+    ASSERT_TRUE(inserted);
+    *value = i;
+  }
+  EXPECT_EQ(map.Size(), 10000U);
+  for (int64_t i = 0; i < 10000; ++i) {
+    const int64_t* value = map.Find(i * 7919 - 5000);
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_FALSE(map.Contains(1));
+  auto [again, inserted] = map.TryEmplace(-5000);
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*again, 0);
+  int64_t expected = 0;
+  for (const auto& entry : map) {
+    EXPECT_EQ(entry.value, expected++);
+  }
+  map.Clear();
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.Find(-5000), nullptr);
+}
+
+TEST(FlatHashTableTest, StringKeysAreCopiedIntoTheTable) {
+  FlatHashSet<std::string_view> set;
+  EXPECT_FALSE(set.Contains(""));
+  EXPECT_TRUE(set.Insert(""));
+  std::string buffer;
+  for (int i = 0; i < 1000; ++i) {
+    buffer = "key-" + std::to_string(i);
+    EXPECT_TRUE(set.Insert(buffer));
+  }
+  buffer = "key-1";
+  EXPECT_FALSE(set.Insert(buffer));
+  buffer.assign(100000, 'x');
+  EXPECT_TRUE(set.Insert(buffer));
+  buffer = "overwritten";
+  EXPECT_TRUE(set.Contains("key-0"));
+  EXPECT_TRUE(set.Contains("key-999"));
+  EXPECT_TRUE(set.Contains(std::string(100000, 'x')));
+  EXPECT_FALSE(set.Contains("overwritten"));
+  EXPECT_TRUE(set.Contains(""));
+  EXPECT_EQ(set.Size(), 1002U);
+}
+
+TEST(FlatHashTableTest, PairKeys) {
+  FlatHashMap<Int64Pair, int> map;
+  *map.TryEmplace({1, 2}).first = 12;
+  *map.TryEmplace({2, 1}).first = 21;
+  ASSERT_NE(map.Find({1, 2}), nullptr);
+  EXPECT_EQ(*map.Find({1, 2}), 12);
+  EXPECT_EQ(*map.Find({2, 1}), 21);
+  EXPECT_EQ(map.Find({1, 1}), nullptr);
+}
+
+TEST(FlatHashTableTest, MultiMapVisitsValuesInInsertionOrder) {
+  FlatMultiMap<int64_t, int> multimap;
+  for (int i = 0; i < 30; ++i) multimap.Insert(i % 3, i);
+  EXPECT_EQ(multimap.Size(), 30U);
+  std::vector<int> values;
+  multimap.ForEachMatch(1, [&](int value) { values.push_back(value); });
+  ASSERT_EQ(values.size(), 10U);
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], static_cast<int>(i * 3 + 1));
+  }
+  size_t misses = 0;
+  multimap.ForEachMatch(3, [&](int) { ++misses; });
+  EXPECT_EQ(misses, 0U);
+}
+
+TEST(FlatHashTableTest, FlatKeyFollowsValueEquality) {
+  const auto key = [](const Value& value) {
+    std::string out;
+    AppendFlatKey(value, &out);
+    return out;
+  };
+  EXPECT_EQ(key(Value(0.0)), key(Value(-0.0)));
+  EXPECT_NE(key(Value(int64_t{1})), key(Value(1.0)));
+  EXPECT_NE(key(Value()), key(Value(int64_t{0})));
+  EXPECT_NE(key(Value("")), key(Value()));
+  // Length prefixes keep column boundaries apart.
+  std::string ab;
+  std::string a_b;
+  AppendFlatKey(Row({Value("ab"), Value("")}), &ab);
+  AppendFlatKey(Row({Value("a"), Value("b")}), &a_b);
+  EXPECT_NE(ab, a_b);
+}
+
+}  // namespace tinylamb
@@ -27,6 +27,7 @@
 
 #include "common/debug.hpp"
 #include "executor/query_memory.hpp"
+#include "executor/radix_join.hpp"
 #include "executor/spill_file.hpp"
 
 namespace tinylamb {
@@ -59,6 +60,49 @@ void JoinPartition(
   }
 }
 
+// Radix-partitioned join of fully resident inputs (HashJoinMode::kRadix).
+void JoinRadix(const std::vector<slot_t>& left_cols,
+               const std::vector<slot_t>& right_cols,
+               const std::vector<std::pair<Row, RowPosition>>& left_rows,
+               const std::vector<Row>& right_rows, size_t workers,
+               std::vector<std::pair<Row, RowPosition>>* output) {
+  std::vector<std::string> right_keys;
+  std::vector<RadixTuple> build;
+  right_keys.reserve(right_rows.size());
+  build.reserve(right_rows.size());
+  for (const Row& right_row : right_rows) {
+    right_keys.push_back(
+        right_row.Extract(right_cols).EncodeMemcomparableFormat());
+    build.push_back({FlatHash(right_keys.back()), build.size()});
+  }
+  std::vector<std::string> left_keys;
+  std::vector<RadixTuple> probe;
+  left_keys.reserve(left_rows.size());
+  probe.reserve(left_rows.size());
+  for (const auto& left : left_rows) {
+    left_keys.push_back(
+        left.first.Extract(left_cols).EncodeMemcomparableFormat());
+    probe.push_back({FlatHash(left_keys.back()), probe.size()});
+  }
+  const std::vector<int> pass_bits =
+      RadixPassBits(build.size(), RadixPartitionBytes());
+  std::vector<std::vector<std::pair<Row, RowPosition>>> slots(workers);
+  RadixHashJoin(
+      std::move(build), std::move(probe), pass_bits, workers,
+      [&](size_t slot, uint64_t left_index, uint64_t right_index) {
+        if (left_keys[left_index] != right_keys[right_index]) return;
+        const auto& left = left_rows[left_index];
+        slots[slot].emplace_back(left.first + right_rows[right_index],
+                                 left.second);
+      },
+      [&] {
+        for (auto& slot : slots) {
+          std::move(slot.begin(), slot.end(), std::back_inserter(*output));
+          slot.clear();
+        }
+      });
+}
+
 void ChargeOutput(std::vector<std::pair<Row, RowPosition>>* output,
                   QueryMemoryCharge* output_charge) {
   size_t output_bytes = 0;
@@ -83,7 +127,8 @@ HashJoin::HashJoin(Executor left, std::vector<slot_t> left_cols, Executor right,
       right_(std::move(right)),
       right_cols_(std::move(right_cols)),
       mode_(mode),
-      worker_count_(std::max<size_t>(1, worker_count)) {}
+      worker_count_(std::max<size_t>(1, worker_count)),
+      memory_(MemoryContext::Current().Child("hash_join")) {}
 
 bool HashJoin::Next(Row* dst, RowPosition* rp) {
   if (!materialized_) Materialize();
@@ -107,6 +152,7 @@ size_t HashJoin::NextBatch(DataChunk* destination, size_t max_rows) {
 }
 
 void HashJoin::Materialize() {
+  const ScopedMemoryContext scope(memory_);
   if (mode_ == HashJoinMode::kHybrid) {
     MaterializeHybrid();
   } else {
@@ -116,7 +162,7 @@ void HashJoin::Materialize() {
 
 void HashJoin::MaterializeInMemory() {
   using PositionedRow = std::pair<Row, RowPosition>;
-  QueryMemoryBudget& budget = QueryMemoryBudget::Global();
+  const MemoryContext& budget = *memory_;
   QueryMemoryCharge charge;
 
   std::vector<PositionedRow> left_rows;
@@ -182,7 +228,10 @@ void HashJoin::MaterializeInMemory() {
     }
   }
 
-  if (!spilled) {
+  if (!spilled && mode_ == HashJoinMode::kRadix) {
+    JoinRadix(left_cols_, right_cols_, left_rows, right_rows, worker_count_,
+              &output_);
+  } else if (!spilled) {
     const size_t partitions = std::min(
         worker_count_,
         std::max<size_t>(1, left_rows.size() + right_rows.size()));
@@ -255,7 +304,7 @@ void HashJoin::MaterializeInMemory() {
 }
 
 void HashJoin::MaterializeHybrid() {
-  QueryMemoryBudget& budget = QueryMemoryBudget::Global();
+  const MemoryContext& budget = *memory_;
 
   // First pass estimate: stream right into spills with a provisional partition
   // count, keeping partition 0 resident when it fits.
@@ -365,6 +414,9 @@ void HashJoin::Dump(std::ostream& o, int indent) const {
     o << "HybridHashJoin (" << worker_count_ << " workers): " << ss.str()
       << "\n"
       << Indent(indent + 2);
+  } else if (mode_ == HashJoinMode::kRadix) {
+    o << "RadixHashJoin (" << worker_count_ << " workers): " << ss.str() << "\n"
+      << Indent(indent + 2);
   } else {
     o << "PartitionedHashJoin (" << worker_count_ << " workers): " << ss.str()
       << "\n"
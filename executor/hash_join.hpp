@@ -63,6 +63,8 @@ class HashJoin : public ExecutorBase {
 
   HashJoinMode mode_{HashJoinMode::kInMemory};
   size_t worker_count_;
+  // "hash_join" account of the query this join was built for.
+  std::shared_ptr<MemoryContext> memory_;
   bool materialized_{false};
   std::vector<std::pair<Row, RowPosition>> output_;
   size_t output_offset_{0};
@@ -16,9 +16,12 @@ namespace tinylamb {
 //            QueryMemoryBudget pressure).
 // kHybrid:   keep one resident partition in memory; spill the rest and join
 //            spilled partitions afterwards (DeWitt-style Hybrid Hash Join).
+// kRadix:    in memory, but both inputs are first radix partitioned so every
+//            build partition's table fits in cache (see radix_join.hpp).
 enum class HashJoinMode : uint8_t {
   kInMemory = 0,
   kHybrid = 1,
+  kRadix = 2,
 };
 
 inline std::string_view HashJoinModeName(HashJoinMode mode) {
@@ -27,6 +30,8 @@ inline std::string_view HashJoinModeName(HashJoinMode mode) {
       return "HashJoin";
     case HashJoinMode::kHybrid:
       return "HybridHashJoin";
+    case HashJoinMode::kRadix:
+      return "RadixHashJoin";
   }
   return "HashJoin";
 }
@@ -34,10 +39,29 @@ inline std::string_view HashJoinModeName(HashJoinMode mode) {
 // Rough per-row footprint used by the planner when TableStatistics lack width.
 inline constexpr size_t kHashJoinRowBytesEstimate = 128;
 
-// Prefer hybrid when the estimated build-side footprint exceeds the soft
-// query-memory budget (80% of TINYLAMB_QUERY_MEMORY_BYTES).
+// Prefer hybrid when the estimated build-side footprint exceeds what is left
+// of the current query's memory grant (see MemoryContext).
 [[nodiscard]] inline bool PreferHybridHashJoin(size_t estimated_build_bytes) {
-  return !QueryMemoryBudget::Global().CanReserve(estimated_build_bytes);
+  return !MemoryContext::Current().CanReserve(estimated_build_bytes);
+}
+
+// Build footprint above which a plain hash table no longer fits in cache and
+// the radix join pays off.
+//
+// Config: TINYLAMB_RADIX_JOIN_BYTES
+//   - unset: the last-level cache size reported by the OS (8 MiB if unknown)
+//   - "0": never prefer the radix join
+[[nodiscard]] size_t RadixJoinThresholdBytes();
+
+// Test helper: replace the threshold (0 = never prefer radix).
+void SetRadixJoinThresholdForTest(size_t bytes);
+
+// Prefer the radix join when the build outgrows the cache but still fits the
+// query memory budget (otherwise hybrid wins).
+[[nodiscard]] inline bool PreferRadixHashJoin(size_t estimated_build_bytes) {
+  const size_t threshold = RadixJoinThresholdBytes();
+  return threshold != 0 && estimated_build_bytes > threshold &&
+         !PreferHybridHashJoin(estimated_build_bytes);
 }
 
 // Partition count so a typical resident partition fits in ~half the remaining
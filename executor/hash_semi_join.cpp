@@ -0,0 +1,56 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/hash_semi_join.hpp"
+
+#include <ostream>
+#include <utility>
+
+#include "common/constants.hpp"
+#include "page/row_position.hpp"
+
+namespace tinylamb {
+
+HashSemiJoin::HashSemiJoin(Executor left, std::vector<slot_t> left_cols,
+                           Executor right, std::vector<slot_t> right_cols,
+                           SemiJoinKind kind)
+    : left_(std::move(left)),
+      left_cols_(std::move(left_cols)),
+      right_(std::move(right)),
+      right_cols_(std::move(right_cols)),
+      kind_(kind) {}
+
+bool HashSemiJoin::Next(Row* dst, RowPosition* rp) {
+  if (!table_) Build();
+  RowPosition position;
+  while (left_->Next(dst, &position)) {
+    if (table_->Passes(*dst, left_cols_)) {
+      if (rp) *rp = position;
+      return true;
+    }
+  }
+  return false;
+}
+
+void HashSemiJoin::Build() {
+  table_.emplace(kind_, right_cols_);
+  Row row;
+  while (right_->Next(&row, nullptr)) table_->Insert(row);
+}
+
+void HashSemiJoin::Dump(std::ostream& o, int indent) const {
+  o << SemiJoinKindName(kind_) << ": left: {";
+  for (size_t i = 0; i < left_cols_.size(); ++i) {
+    if (0 < i) o << ", ";
+    o << left_cols_[i];
+  }
+  o << "} right: {";
+  for (size_t i = 0; i < right_cols_.size(); ++i) {
+    if (0 < i) o << ", ";
+    o << right_cols_[i];
+  }
+  o << "}\n" << Indent(indent + 2);
+  left_->Dump(o, indent + 2);
+  o << "\n" << Indent(indent + 2);
+  right_->Dump(o, indent + 2);
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,41 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_HASH_SEMI_JOIN_HPP
+#define TINYLAMB_EXECUTOR_HASH_SEMI_JOIN_HPP
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "executor/executor_base.hpp"
+#include "executor/semi_join.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Hash semi, anti and NULL-aware anti join of the HashJoin family. `right` is
+// read once into a SemiJoinTable; `left` then streams through it, and each
+// surviving left row is emitted once, unchanged and with its RowPosition.
+class HashSemiJoin : public ExecutorBase {
+ public:
+  HashSemiJoin(Executor left, std::vector<slot_t> left_cols, Executor right,
+               std::vector<slot_t> right_cols, SemiJoinKind kind);
+
+  bool Next(Row* dst, RowPosition* rp) override;
+  void Dump(std::ostream& o, int indent) const override;
+
+  [[nodiscard]] SemiJoinKind Kind() const { return kind_; }
+
+ private:
+  void Build();
+
+  Executor left_;
+  std::vector<slot_t> left_cols_;
+  Executor right_;
+  std::vector<slot_t> right_cols_;
+  SemiJoinKind kind_;
+  std::optional<SemiJoinTable> table_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_HASH_SEMI_JOIN_HPP
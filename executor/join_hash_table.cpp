@@ -0,0 +1,78 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/join_hash_table.hpp"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "executor/query_memory.hpp"
+
+namespace tinylamb {
+
+size_t JoinWorkerCount(size_t rows) {
+  const size_t morsels = (rows + kJoinMorselRows - 1) / kJoinMorselRows;
+  return std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                            std::max<size_t>(1, morsels));
+}
+
+void RunMorsels(size_t count, size_t morsel_rows, size_t workers,
+                const std::function<void(size_t, size_t, size_t)>& fn) {
+  const size_t morsels = (count + morsel_rows - 1) / morsel_rows;
+  workers = std::min(std::max<size_t>(1, workers), morsels);
+  if (workers <= 1) {
+    for (size_t begin = 0; begin < count; begin += morsel_rows) {
+      fn(0, begin, std::min(count, begin + morsel_rows));
+    }
+    return;
+  }
+  std::atomic<size_t> next_morsel{0};
+  std::mutex error_mu;
+  std::exception_ptr error;
+  MemoryContext& memory = MemoryContext::Current();
+  {
+    std::vector<std::jthread> threads;
+    threads.reserve(workers);
+    for (size_t w = 0; w < workers; ++w) {
+      threads.emplace_back([&, w] {
+        const ScopedMemoryContext scope(memory);
+        try {
+          while (true) {
+            const size_t morsel = next_morsel.fetch_add(1);
+            if (morsel >= morsels) break;
+            const size_t begin = morsel * morsel_rows;
+            fn(w, begin, std::min(count, begin + morsel_rows));
+          }
+        } catch (...) {
+          std::scoped_lock lock(error_mu);
+          if (!error) error = std::current_exception();
+          next_morsel.store(morsels);
+        }
+      });
+    }
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+void ProbeMorsels(
+    size_t count, size_t workers,
+    const std::function<void(size_t, size_t, std::vector<Row>*)>& probe,
+    const std::function<void(Row&&)>& emit) {
+  workers = std::max<size_t>(1, workers);
+  const size_t wave_rows = workers * kJoinMorselRows;
+  std::vector<std::vector<Row>> outputs(workers);
+  for (size_t wave = 0; wave < count; wave += wave_rows) {
+    const size_t wave_end = std::min(count, wave + wave_rows);
+    RunMorsels(wave_end - wave, kJoinMorselRows, workers,
+               [&](size_t, size_t begin, size_t end) {
+                 probe(wave + begin, wave + end,
+                       &outputs[begin / kJoinMorselRows]);
+               });
+    for (std::vector<Row>& output : outputs) {
+      for (Row& row : output) emit(std::move(row));
+      output.clear();
+    }
+  }
+}
+
+}  // namespace tinylamb
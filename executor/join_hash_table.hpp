@@ -0,0 +1,136 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_JOIN_HASH_TABLE_HPP
+#define TINYLAMB_EXECUTOR_JOIN_HASH_TABLE_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "executor/flat_hash_table.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Rows handed to one worker at a time by the parallel join phases.
+inline constexpr size_t kJoinMorselRows = 16384;
+
+// Threads for a join whose larger input has `rows` rows: at most one per
+// morsel, capped at the hardware concurrency.
+[[nodiscard]] size_t JoinWorkerCount(size_t rows);
+
+// Calls fn(worker, begin, end) for every `morsel_rows`-sized slice of
+// [0, count) on `workers` threads claiming slices from a shared cursor. The
+// first exception thrown by a worker is rethrown on the caller.
+void RunMorsels(size_t count, size_t morsel_rows, size_t workers,
+                const std::function<void(size_t, size_t, size_t)>& fn);
+
+// Probes [0, count) in waves of one morsel per worker; probe(begin, end, &out)
+// appends that morsel's joined rows. After each wave the rows are handed to
+// `emit` in morsel order on the calling thread, so the output order matches a
+// serial probe and only one wave of output is buffered at a time.
+void ProbeMorsels(
+    size_t count, size_t workers,
+    const std::function<void(size_t, size_t, std::vector<Row>*)>& probe,
+    const std::function<void(Row&&)>& emit);
+
+// Hash table over the build rows of an in-memory join, on FlatMultiMap. Key
+// is the join key as KeyOf produces it: int64_t, Int64Pair or an encoded
+// std::string (stored as a string_view into the table's arena). The table is
+// split into partitions by key hash so several threads can build it without
+// locks: morsels of build rows are first scattered into per-partition runs,
+// then each partition is filled by a single worker. Runs are replayed in
+// morsel order, so duplicate keys match in input order whatever the worker
+// count.
+template <typename Key>
+class PartitionedJoinTable {
+  using View =
+      std::conditional_t<std::is_same_v<Key, std::string>, std::string_view,
+                         Key>;
+
+ public:
+  // Indexes `rows`, which must outlive the table. key_of(row, &key) returns
+  // false for rows that can never match (NULL join keys).
+  template <typename KeyOf>
+  void Build(const std::vector<Row>& rows, size_t workers,
+             const KeyOf& key_of) {
+    workers = std::max<size_t>(1, workers);
+    const size_t partitions = std::bit_ceil(workers);
+    partition_shift_ = 64 - std::countr_zero(partitions);
+    tables_.clear();
+    tables_.resize(partitions);
+    if (partitions == 1) {
+      tables_[0].Reserve(rows.size());
+      Key key;
+      for (const Row& row : rows) {
+        if (key_of(row, &key)) tables_[0].Insert(View(key), &row);
+      }
+      return;
+    }
+    // Runs hold row pointers only; the fill phase extracts keys again rather
+    // than carrying a copy of every (possibly string) key between phases.
+    const size_t morsels =
+        (rows.size() + kJoinMorselRows - 1) / kJoinMorselRows;
+    std::vector<std::vector<std::vector<const Row*>>> runs(
+        morsels, std::vector<std::vector<const Row*>>(partitions));
+    RunMorsels(rows.size(), kJoinMorselRows, workers,
+               [&](size_t, size_t begin, size_t end) {
+                 auto& run = runs[begin / kJoinMorselRows];
+                 Key key;
+                 for (size_t i = begin; i < end; ++i) {
+                   if (!key_of(rows[i], &key)) continue;
+                   run[PartitionOf(View(key))].push_back(&rows[i]);
+                 }
+               });
+    RunMorsels(partitions, 1, workers, [&](size_t, size_t partition, size_t) {
+      size_t size = 0;
+      for (const auto& run : runs) size += run[partition].size();
+      auto& table = tables_[partition];
+      table.Reserve(size);
+      Key key;
+      for (auto& run : runs) {
+        for (const Row* row : run[partition]) {
+          key_of(*row, &key);
+          table.Insert(View(key), row);
+        }
+        run[partition].clear();
+        run[partition].shrink_to_fit();
+      }
+    });
+  }
+
+  // Calls fn(const Row&) for every build row whose key equals `key`.
+  template <typename Fn>
+  void ForEachMatch(const Key& key, Fn&& fn) const {
+    const View view(key);
+    tables_[PartitionOf(view)].ForEachMatch(
+        view, [&](const Row* row) { fn(*row); });
+  }
+
+  [[nodiscard]] size_t PartitionCount() const { return tables_.size(); }
+  [[nodiscard]] size_t Size() const {
+    size_t size = 0;
+    for (const auto& table : tables_) size += table.Size();
+    return size;
+  }
+
+ private:
+  // High bits of the key hash; the tables pick slots from the low ones.
+  [[nodiscard]] size_t PartitionOf(View key) const {
+    if (tables_.size() == 1) return 0;
+    return static_cast<size_t>(FlatHash(key) >> partition_shift_);
+  }
+
+  std::vector<FlatMultiMap<View, const Row*>> tables_;
+  int partition_shift_{0};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_JOIN_HASH_TABLE_HPP
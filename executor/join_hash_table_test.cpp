@@ -0,0 +1,108 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/join_hash_table.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+bool IntegerKey(const Row& row, int64_t* key) {
+  if (row[0].IsNull()) return false;
+  *key = row[0].value.int_value;
+  return true;
+}
+
+std::vector<Row> BuildRows(size_t count) {
+  std::vector<Row> rows;
+  rows.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    rows.push_back(Row({Value(static_cast<int64_t>(i % 1000)),
+                        Value(static_cast<int64_t>(i))}));
+  }
+  rows.push_back(Row({Value(), Value(-1)}));
+  return rows;
+}
+
+}  // namespace
+
+TEST(JoinHashTableTest, PartitionedBuildMatchesSerialBuild) {
+  const std::vector<Row> rows = BuildRows(100000);
+  PartitionedJoinTable<int64_t> serial;
+  serial.Build(rows, 1, IntegerKey);
+  PartitionedJoinTable<int64_t> parallel;
+  parallel.Build(rows, 3, IntegerKey);
+  EXPECT_EQ(serial.PartitionCount(), 1U);
+  EXPECT_EQ(parallel.PartitionCount(), 4U);
+  // The NULL key row is never indexed.
+  EXPECT_EQ(serial.Size(), rows.size() - 1);
+  EXPECT_EQ(parallel.Size(), rows.size() - 1);
+  for (int64_t key : {0, 7, 999, 1000}) {
+    std::vector<int64_t> expected;
+    serial.ForEachMatch(key, [&](const Row& row) {
+      expected.push_back(row[1].value.int_value);
+    });
+    std::vector<int64_t> actual;
+    parallel.ForEachMatch(key, [&](const Row& row) {
+      actual.push_back(row[1].value.int_value);
+    });
+    EXPECT_EQ(actual, expected) << key;
+    EXPECT_EQ(actual.size(), key < 1000 ? 100U : 0U) << key;
+  }
+}
+
+TEST(JoinHashTableTest, StringKeys) {
+  std::vector<Row> rows;
+  for (int i = 0; i < 100; ++i) {
+    rows.push_back(Row({Value("k" + std::to_string(i % 10)), Value(i)}));
+  }
+  PartitionedJoinTable<std::string> table;
+  table.Build(rows, 2, [](const Row& row, std::string* key) {
+    *key = std::string(row[0].value.varchar_value);
+    return true;
+  });
+  size_t matches = 0;
+  table.ForEachMatch("k3", [&](const Row& row) {
+    EXPECT_EQ(row[1].value.int_value % 10, 3);
+    ++matches;
+  });
+  EXPECT_EQ(matches, 10U);
+}
+
+TEST(JoinHashTableTest, ProbeMorselsKeepsSerialOrder) {
+  const size_t count = 3 * kJoinMorselRows + 17;
+  std::vector<int64_t> emitted;
+  ProbeMorsels(
+      count, 2,
+      [](size_t begin, size_t end, std::vector<Row>* out) {
+        for (size_t i = begin; i < end; ++i) {
+          if (i % 3 == 0) out->push_back(Row({Value(static_cast<int64_t>(i))}));
+        }
+      },
+      [&](Row&& row) { emitted.push_back(row[0].value.int_value); });
+  ASSERT_EQ(emitted.size(), (count + 2) / 3);
+  for (size_t i = 0; i < emitted.size(); ++i) {
+    EXPECT_EQ(emitted[i], static_cast<int64_t>(i * 3));
+  }
+}
+
+TEST(JoinHashTableTest, RunMorselsCoversRangeAndRethrows) {
+  std::atomic<size_t> covered{0};
+  RunMorsels(1000, 64, 4, [&](size_t, size_t begin, size_t end) {
+    covered += end - begin;
+  });
+  EXPECT_EQ(covered.load(), 1000U);
+  EXPECT_THROW(RunMorsels(1000, 64, 4,
+                          [](size_t, size_t begin, size_t) {
+                            if (begin == 128) throw std::runtime_error("boom");
+                          }),
+               std::runtime_error);
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,121 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/join_pipeline.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "executor/flat_hash_table.hpp"
+#include "executor/join_hash_table.hpp"
+
+namespace tinylamb {
+
+namespace {
+
+bool AnyNull(const Row& row, const std::vector<slot_t>& columns) {
+  return std::any_of(columns.begin(), columns.end(),
+                     [&](slot_t column) { return row[column].IsNull(); });
+}
+
+}  // namespace
+
+struct JoinPipeline::Stage {
+  const std::vector<Row>* build;
+  std::vector<slot_t> probe_columns;
+  std::vector<slot_t> build_columns;
+  bool hashed;
+  bool integer_key;
+  MatchFn matches;
+  PartitionedJoinTable<int64_t> int_table;
+  PartitionedJoinTable<std::string> string_table;
+};
+
+JoinPipeline::JoinPipeline() = default;
+JoinPipeline::JoinPipeline(JoinPipeline&&) noexcept = default;
+JoinPipeline& JoinPipeline::operator=(JoinPipeline&&) noexcept = default;
+JoinPipeline::~JoinPipeline() = default;
+
+void JoinPipeline::AddHashStage(const std::vector<Row>& build,
+                                std::vector<slot_t> probe_columns,
+                                std::vector<slot_t> build_columns,
+                                bool integer_key, MatchFn matches) {
+  auto stage = std::make_unique<Stage>();
+  stage->build = &build;
+  stage->probe_columns = std::move(probe_columns);
+  stage->build_columns = std::move(build_columns);
+  stage->hashed = true;
+  stage->integer_key = integer_key;
+  stage->matches = std::move(matches);
+  const size_t workers = JoinWorkerCount(build.size());
+  const std::vector<slot_t>& columns = stage->build_columns;
+  if (integer_key) {
+    const slot_t column = columns[0];
+    stage->int_table.Build(build, workers, [column](const Row& row,
+                                                    int64_t* key) {
+      if (row[column].IsNull()) return false;
+      *key = row[column].value.int_value;
+      return true;
+    });
+  } else {
+    stage->string_table.Build(
+        build, workers, [&columns](const Row& row, std::string* key) {
+          if (AnyNull(row, columns)) return false;
+          key->clear();
+          for (const slot_t column : columns) AppendFlatKey(row[column], key);
+          return true;
+        });
+  }
+  stages_.push_back(std::move(stage));
+}
+
+void JoinPipeline::AddNestedLoopStage(const std::vector<Row>& build,
+                                      MatchFn matches) {
+  auto stage = std::make_unique<Stage>();
+  stage->build = &build;
+  stage->hashed = false;
+  stage->integer_key = false;
+  stage->matches = std::move(matches);
+  stages_.push_back(std::move(stage));
+}
+
+void JoinPipeline::Probe(const Row& row, const RowFn& emit,
+                         size_t* comparisons) const {
+  ProbeFrom(0, row, emit, comparisons);
+}
+
+void JoinPipeline::ProbeFrom(size_t stage, const Row& row, const RowFn& emit,
+                             size_t* comparisons) const {
+  if (stage == stages_.size()) {
+    emit(Row(row));
+    return;
+  }
+  const Stage& current = *stages_[stage];
+  auto join = [&](const Row& build_row) {
+    ++(*comparisons);
+    Row combined = row + build_row;
+    if (!current.matches || current.matches(combined)) {
+      if (stage + 1 == stages_.size()) {
+        emit(std::move(combined));
+      } else {
+        ProbeFrom(stage + 1, combined, emit, comparisons);
+      }
+    }
+  };
+  if (!current.hashed) {
+    for (const Row& build_row : *current.build) join(build_row);
+    return;
+  }
+  if (AnyNull(row, current.probe_columns)) return;
+  if (current.integer_key) {
+    current.int_table.ForEachMatch(
+        row[current.probe_columns[0]].value.int_value, join);
+    return;
+  }
+  std::string key;
+  for (const slot_t column : current.probe_columns) {
+    AppendFlatKey(row[column], &key);
+  }
+  current.string_table.ForEachMatch(key, join);
+}
+
+}  // namespace tinylamb
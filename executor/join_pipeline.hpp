@@ -0,0 +1,66 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_JOIN_PIPELINE_HPP
+#define TINYLAMB_EXECUTOR_JOIN_PIPELINE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/constants.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// A chain of inner joins that rows are streamed through one at a time. Each
+// stage joins the incoming row with a resident build side, so only the build
+// sides are held: nothing a stage produces is materialized before the next
+// stage sees it. A joined row is the incoming row followed by the build row.
+//
+// Probe() is const and keeps its key buffers on the stack, so several threads
+// may probe one pipeline at once as long as every MatchFn is thread safe.
+class JoinPipeline {
+ public:
+  // Whether a joined row passes the stage's residual predicates.
+  using MatchFn = std::function<bool(const Row&)>;
+  using RowFn = std::function<void(Row&&)>;
+
+  JoinPipeline();
+  JoinPipeline(const JoinPipeline&) = delete;
+  JoinPipeline& operator=(const JoinPipeline&) = delete;
+  JoinPipeline(JoinPipeline&&) noexcept;
+  JoinPipeline& operator=(JoinPipeline&&) noexcept;
+  ~JoinPipeline();
+
+  // Appends a hash join of `probe_columns` of the incoming rows with
+  // `build_columns` of `build`, which must outlive the pipeline. With
+  // `integer_key` both sides have one INT64 or DATE key column, hashed as an
+  // integer; other keys are hashed by their AppendFlatKey encoding. NULL keys
+  // never match.
+  void AddHashStage(const std::vector<Row>& build,
+                    std::vector<slot_t> probe_columns,
+                    std::vector<slot_t> build_columns, bool integer_key,
+                    MatchFn matches);
+  // Appends a join of every incoming row with every row of `build`, which
+  // must outlive the pipeline.
+  void AddNestedLoopStage(const std::vector<Row>& build, MatchFn matches);
+
+  [[nodiscard]] bool Empty() const { return stages_.empty(); }
+  [[nodiscard]] size_t Stages() const { return stages_.size(); }
+
+  // Pushes every row `row` joins into through all stages to `emit`, and adds
+  // the number of build rows it was compared with to `*comparisons`.
+  void Probe(const Row& row, const RowFn& emit, size_t* comparisons) const;
+
+ private:
+  struct Stage;
+
+  void ProbeFrom(size_t stage, const Row& row, const RowFn& emit,
+                 size_t* comparisons) const;
+
+  std::vector<std::unique_ptr<Stage>> stages_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_JOIN_PIPELINE_HPP
@@ -0,0 +1,91 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/join_pipeline.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+std::vector<Row> Probe(const JoinPipeline& pipeline,
+                       const std::vector<Row>& rows, size_t* comparisons) {
+  std::vector<Row> joined;
+  for (const Row& row : rows) {
+    pipeline.Probe(
+        row, [&](Row&& out) { joined.push_back(std::move(out)); },
+        comparisons);
+  }
+  return joined;
+}
+
+}  // namespace
+
+TEST(JoinPipelineTest, StreamsRowsThroughEveryStage) {
+  // orders(customer, order) -> customers(customer, nation) -> nations(id).
+  const std::vector<Row> customers = {Row({Value(1), Value(10)}),
+                                      Row({Value(2), Value(20)}),
+                                      Row({Value(2), Value(30)}),
+                                      Row({Value(), Value(10)})};
+  const std::vector<Row> nations = {Row({Value(10)}), Row({Value(20)})};
+  JoinPipeline pipeline;
+  EXPECT_TRUE(pipeline.Empty());
+  pipeline.AddHashStage(customers, {0}, {0}, true, nullptr);
+  pipeline.AddHashStage(nations, {3}, {0}, true, nullptr);
+  EXPECT_EQ(pipeline.Stages(), 2U);
+
+  const std::vector<Row> orders = {Row({Value(1), Value(100)}),
+                                   Row({Value(2), Value(200)}),
+                                   Row({Value(3), Value(300)}),
+                                   Row({Value(), Value(400)})};
+  size_t comparisons = 0;
+  const std::vector<Row> joined = Probe(pipeline, orders, &comparisons);
+  const std::vector<Row> expected = {
+      Row({Value(1), Value(100), Value(1), Value(10), Value(10)}),
+      Row({Value(2), Value(200), Value(2), Value(20), Value(20)})};
+  EXPECT_EQ(joined, expected);
+  // Customers 1, 2 and 2 match, then nations 10 and 20; NULL keys never do.
+  EXPECT_EQ(comparisons, 5U);
+}
+
+TEST(JoinPipelineTest, EncodedKeysAndResiduals) {
+  const Value a(std::string("a"));
+  const Value b(std::string("b"));
+  const std::vector<Row> build = {Row({a, Value(1), Value(5)}),
+                                  Row({a, Value(1), Value(50)}),
+                                  Row({b, Value(2), Value(7)})};
+  JoinPipeline pipeline;
+  pipeline.AddHashStage(build, {0, 1}, {0, 1}, false, [](const Row& row) {
+    return row[1].value.int_value < row[4].value.int_value &&
+           row[4].value.int_value < 10;
+  });
+  const std::vector<Row> probe = {Row({a, Value(1)}), Row({b, Value(3)})};
+  size_t comparisons = 0;
+  const std::vector<Row> joined = Probe(pipeline, probe, &comparisons);
+  ASSERT_EQ(joined.size(), 1U);
+  EXPECT_EQ(joined[0], Row({a, Value(1), a, Value(1), Value(5)}));
+  EXPECT_EQ(comparisons, 2U);
+}
+
+TEST(JoinPipelineTest, NestedLoopStage) {
+  const std::vector<Row> build = {Row({Value(1)}), Row({Value(2)}),
+                                  Row({Value(3)})};
+  JoinPipeline pipeline;
+  pipeline.AddNestedLoopStage(build, [](const Row& row) {
+    return row[0].value.int_value < row[1].value.int_value;
+  });
+  size_t comparisons = 0;
+  const std::vector<Row> joined =
+      Probe(pipeline, {Row({Value(1)}), Row({Value(2)})}, &comparisons);
+  const std::vector<Row> expected = {Row({Value(1), Value(2)}),
+                                     Row({Value(1), Value(3)}),
+                                     Row({Value(2), Value(3)})};
+  EXPECT_EQ(joined, expected);
+  EXPECT_EQ(comparisons, 6U);
+}
+
+}  // namespace tinylamb
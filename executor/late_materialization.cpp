@@ -0,0 +1,102 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/late_materialization.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "executor/feature_flag.hpp"
+#include "table/table.hpp"
+
+namespace tinylamb {
+namespace {
+
+// Slot bits of an encoded RowPosition; page ids take the rest.
+constexpr int kSlotBits = 16;
+
+FeatureFlag& Flag() {
+  static FeatureFlag flag("TINYLAMB_LATE_MATERIALIZATION");
+  return flag;
+}
+
+}  // namespace
+
+bool LateMaterializationEnabled() { return Flag().Enabled(); }
+
+void SetLateMaterializationForTest(int enabled) { Flag().SetForTest(enabled); }
+
+Value EncodeRowPosition(const RowPosition& position) {
+  return Value(static_cast<int64_t>(position.page_id << kSlotBits |
+                                    position.slot));
+}
+
+RowPosition DecodeRowPosition(const Value& value) {
+  const auto encoded = static_cast<uint64_t>(value.value.int_value);
+  return {encoded >> kSlotBits,
+          static_cast<slot_t>(encoded & ((1U << kSlotBits) - 1))};
+}
+
+LateMaterializer::LateMaterializer(Transaction& txn,
+                                   const std::vector<Fetch>& fetches,
+                                   const std::vector<Column>& layout,
+                                   Sink sink)
+    : txn_(txn),
+      fetches_(fetches),
+      layout_(layout),
+      sink_(std::move(sink)),
+      fetched_(fetches.size()) {
+  batch_.reserve(kLateMaterializationBatchRows);
+}
+
+void LateMaterializer::Add(Row&& row) {
+  batch_.push_back(std::move(row));
+  if (batch_.size() >= kLateMaterializationBatchRows) Flush();
+}
+
+void LateMaterializer::Finish() { Flush(); }
+
+void LateMaterializer::Flush() {
+  if (batch_.empty()) return;
+  std::vector<std::pair<RowPosition, size_t>> order(batch_.size());
+  for (size_t f = 0; f < fetches_.size(); ++f) {
+    const Fetch& fetch = fetches_[f];
+    for (size_t i = 0; i < batch_.size(); ++i) {
+      order[i] = {DecodeRowPosition(batch_[i][fetch.position]), i};
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) {
+      return a.first.page_id != b.first.page_id
+                 ? a.first.page_id < b.first.page_id
+                 : a.first.slot < b.first.slot;
+    });
+    std::vector<Row>& rows = fetched_[f];
+    rows.resize(batch_.size());
+    for (size_t k = 0; k < order.size(); ++k) {
+      const auto& [position, index] = order[k];
+      if (k > 0 && order[k - 1].first == position) {
+        rows[index] = rows[order[k - 1].second];
+        continue;
+      }
+      StatusOr<Row> row = fetch.table->Read(txn_, position);
+      if (!row.HasValue()) {
+        throw std::runtime_error("late materialization: cannot read row");
+      }
+      rows[index] = std::move(row.Value());
+      ++fetched_rows_;
+    }
+  }
+  for (size_t i = 0; i < batch_.size(); ++i) {
+    std::vector<Value> values;
+    values.reserve(layout_.size());
+    for (const Column& column : layout_) {
+      values.push_back(column.fetch == kJoined
+                           ? std::move(batch_[i][column.slot])
+                           : std::move(fetched_[column.fetch][i][column.slot]));
+    }
+    sink_(Row(std::move(values)));
+  }
+  batch_.clear();
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,90 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_LATE_MATERIALIZATION_HPP
+#define TINYLAMB_EXECUTOR_LATE_MATERIALIZATION_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "common/constants.hpp"
+#include "page/row_position.hpp"
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+class Table;
+class Transaction;
+
+// Joined rows collected before their payload columns are fetched.
+inline constexpr size_t kLateMaterializationBatchRows = 4096;
+// Name of the INT64 column carrying a scanned row's RowPosition through
+// joins. It cannot be written in SQL, so it never clashes with user columns.
+inline constexpr std::string_view kRowPositionColumn = "$row_position";
+
+// Whether joins scan wide base tables by key columns and RowPosition only.
+//
+// Config: TINYLAMB_LATE_MATERIALIZATION
+//   - unset or "1": enabled
+//   - "0": every required column is decoded at scan time
+[[nodiscard]] bool LateMaterializationEnabled();
+// Test helper: force the mode (-1 = back to the default).
+void SetLateMaterializationForTest(int enabled);
+
+[[nodiscard]] Value EncodeRowPosition(const RowPosition& position);
+[[nodiscard]] RowPosition DecodeRowPosition(const Value& value);
+
+// Rebuilds joined rows that carry RowPositions instead of payload columns.
+//
+// Every output column either copies a slot of the joined row or is fetched
+// from a base table through Table::Read at the RowPosition the joined row
+// holds for that table. Rows are buffered in batches; each table's reads are
+// issued in (page, slot) order so a page is pinned once per run of rows on
+// it, and repeated positions (one base row joined many times) are read once.
+// Rows leave in the order they arrived.
+class LateMaterializer {
+ public:
+  using Sink = std::function<void(Row&&)>;
+
+  struct Fetch {
+    std::shared_ptr<Table> table;
+    // Joined-row slot holding the encoded RowPosition into `table`.
+    slot_t position;
+  };
+  // Output column: slot `slot` of the joined row when `fetch` is kJoined,
+  // else column `slot` of the row fetched by fetches[fetch].
+  struct Column {
+    size_t fetch;
+    slot_t slot;
+  };
+  static constexpr size_t kJoined = ~size_t{0};
+
+  LateMaterializer(Transaction& txn, const std::vector<Fetch>& fetches,
+                   const std::vector<Column>& layout, Sink sink);
+  LateMaterializer(const LateMaterializer&) = delete;
+  LateMaterializer& operator=(const LateMaterializer&) = delete;
+
+  void Add(Row&& row);
+  // Emits the buffered rows.
+  void Finish();
+
+  // Table::Read calls made so far.
+  [[nodiscard]] size_t FetchedRows() const { return fetched_rows_; }
+
+ private:
+  void Flush();
+
+  Transaction& txn_;
+  const std::vector<Fetch>& fetches_;
+  const std::vector<Column>& layout_;
+  Sink sink_;
+  std::vector<Row> batch_;
+  // fetched_[f][i] is the row of fetches_[f] for batch_[i].
+  std::vector<std::vector<Row>> fetched_;
+  size_t fetched_rows_{0};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_LATE_MATERIALIZATION_HPP
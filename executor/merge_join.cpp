@@ -0,0 +1,213 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/merge_join.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include "common/constants.hpp"
+
+namespace tinylamb {
+namespace {
+
+// Lexicographic three-way comparison of two non-NULL keys.
+int CompareKeys(const Row& lhs, const std::vector<slot_t>& lhs_columns,
+                const Row& rhs, const std::vector<slot_t>& rhs_columns) {
+  for (size_t i = 0; i < lhs_columns.size(); ++i) {
+    const Value& left = lhs[lhs_columns[i]];
+    const Value& right = rhs[rhs_columns[i]];
+    if (left < right) return -1;
+    if (right < left) return 1;
+  }
+  return 0;
+}
+
+Row Nulls(size_t width) { return Row(std::vector<Value>(width)); }
+
+}  // namespace
+
+std::string_view MergeJoinTypeName(MergeJoinType type) {
+  switch (type) {
+    case MergeJoinType::kInner:
+      return "MergeJoin";
+    case MergeJoinType::kLeftOuter:
+      return "MergeLeftOuterJoin";
+    case MergeJoinType::kRightOuter:
+      return "MergeRightOuterJoin";
+    case MergeJoinType::kFull:
+      return "MergeFullOuterJoin";
+  }
+  return "MergeJoin";
+}
+
+MergeJoin::MergeJoin(Executor left, std::vector<slot_t> left_cols,
+                     Executor right, std::vector<slot_t> right_cols,
+                     MergeJoinType type, size_t left_width, size_t right_width)
+    : left_(std::move(left)),
+      left_cols_(std::move(left_cols)),
+      right_(std::move(right)),
+      right_cols_(std::move(right_cols)),
+      type_(type),
+      left_width_(left_width),
+      right_width_(right_width) {
+  if (left_cols_.empty() || left_cols_.size() != right_cols_.size()) {
+    throw std::invalid_argument("MergeJoin needs matching key columns");
+  }
+}
+
+bool MergeJoin::KeepLeft() const {
+  return type_ == MergeJoinType::kLeftOuter || type_ == MergeJoinType::kFull;
+}
+
+bool MergeJoin::KeepRight() const {
+  return type_ == MergeJoinType::kRightOuter || type_ == MergeJoinType::kFull;
+}
+
+void MergeJoin::AdvanceLeft() {
+  left_valid_ = left_->Next(&left_row_, &left_position_);
+}
+
+void MergeJoin::AdvanceRight() {
+  right_valid_ = right_->Next(&right_row_, nullptr);
+}
+
+bool MergeJoin::Next(Row* dst, RowPosition* rp) {
+  if (!started_) {
+    started_ = true;
+    AdvanceLeft();
+    AdvanceRight();
+  }
+  for (;;) {
+    if (flushing_) {
+      while (flush_offset_ < group_.size()) {
+        const size_t offset = flush_offset_++;
+        if (group_matched_[offset]) continue;
+        *dst = PadLeft(group_[offset]);
+        if (rp) *rp = RowPosition();
+        return true;
+      }
+      flushing_ = false;
+      group_.clear();
+      group_matched_.clear();
+      group_charge_.ReleaseAll();
+    }
+    if (emitting_) {
+      if (emit_offset_ < group_.size()) {
+        group_matched_[emit_offset_] = true;
+        *dst = left_row_ + group_[emit_offset_++];
+        if (rp) *rp = left_position_;
+        return true;
+      }
+      emitting_ = false;
+      AdvanceLeft();
+      continue;
+    }
+    if (!left_valid_) {
+      if (!group_.empty()) {
+        FinishGroup();
+        continue;
+      }
+      if (!KeepRight() || !right_valid_) return false;
+      *dst = PadLeft(right_row_);
+      if (rp) *rp = RowPosition();
+      AdvanceRight();
+      return true;
+    }
+    if (left_row_.AnyNull(left_cols_)) {
+      if (EmitLeftOnly(dst, rp)) return true;
+      continue;
+    }
+    if (!group_.empty()) {
+      const int order =
+          CompareKeys(left_row_, left_cols_, group_.front(), right_cols_);
+      if (order == 0) {
+        emitting_ = true;
+        emit_offset_ = 0;
+      } else if (0 < order) {
+        FinishGroup();
+      } else if (EmitLeftOnly(dst, rp)) {
+        return true;
+      }
+      continue;
+    }
+    if (!right_valid_) {
+      if (EmitLeftOnly(dst, rp)) return true;
+      continue;
+    }
+    const int order =
+        right_row_.AnyNull(right_cols_)
+            ? 1
+            : CompareKeys(left_row_, left_cols_, right_row_, right_cols_);
+    if (0 < order) {
+      // The right row is behind every remaining left key.
+      if (KeepRight()) {
+        *dst = PadLeft(right_row_);
+        if (rp) *rp = RowPosition();
+        AdvanceRight();
+        return true;
+      }
+      AdvanceRight();
+    } else if (order < 0) {
+      if (EmitLeftOnly(dst, rp)) return true;
+    } else {
+      LoadGroup();
+    }
+  }
+}
+
+void MergeJoin::LoadGroup() {
+  do {
+    group_charge_.Add(EstimateRowBytes(right_row_));
+    group_.push_back(std::move(right_row_));
+    AdvanceRight();
+  } while (right_valid_ && !right_row_.AnyNull(right_cols_) &&
+           CompareKeys(group_.front(), right_cols_, right_row_,
+                       right_cols_) == 0);
+  group_matched_.assign(group_.size(), false);
+  max_group_rows_ = std::max(max_group_rows_, group_.size());
+}
+
+void MergeJoin::FinishGroup() {
+  if (KeepRight()) {
+    flushing_ = true;
+    flush_offset_ = 0;
+    return;
+  }
+  group_.clear();
+  group_matched_.clear();
+  group_charge_.ReleaseAll();
+}
+
+bool MergeJoin::EmitLeftOnly(Row* dst, RowPosition* rp) {
+  const bool keep = KeepLeft();
+  if (keep) {
+    *dst = left_row_ + Nulls(right_width_);
+    if (rp) *rp = left_position_;
+  }
+  AdvanceLeft();
+  return keep;
+}
+
+Row MergeJoin::PadLeft(const Row& right) const {
+  return Nulls(left_width_) + right;
+}
+
+void MergeJoin::Dump(std::ostream& o, int indent) const {
+  o << MergeJoinTypeName(type_) << ": left: {";
+  for (size_t i = 0; i < left_cols_.size(); ++i) {
+    if (0 < i) o << ", ";
+    o << left_cols_[i];
+  }
+  o << "} right: {";
+  for (size_t i = 0; i < right_cols_.size(); ++i) {
+    if (0 < i) o << ", ";
+    o << right_cols_[i];
+  }
+  o << "}\n" << Indent(indent + 2);
+  left_->Dump(o, indent + 2);
+  o << "\n" << Indent(indent + 2);
+  right_->Dump(o, indent + 2);
+}
+
+}  // namespace tinylamb
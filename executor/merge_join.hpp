@@ -0,0 +1,91 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_MERGE_JOIN_HPP
+#define TINYLAMB_EXECUTOR_MERGE_JOIN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "executor/executor_base.hpp"
+#include "executor/query_memory.hpp"
+#include "page/row_position.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+enum class MergeJoinType : uint8_t { kInner, kLeftOuter, kRightOuter, kFull };
+
+// Operator name shown by Dump.
+[[nodiscard]] std::string_view MergeJoinTypeName(MergeJoinType type);
+
+// Equi-join of two inputs that both arrive in ascending order of their key
+// columns, such as index scans on the join key. Both sides are read once in
+// lockstep; only the run of right rows sharing the current key is buffered, so
+// many-to-many keys work without a hash table. Rows whose key contains NULL
+// match nothing.
+//
+// Outer variants pad the missing side with NULLs and therefore need the column
+// count of that side: `left_width` for kRightOuter and kFull, `right_width`
+// for kLeftOuter and kFull. Inputs that are not sorted produce wrong results
+// rather than an error.
+class MergeJoin : public ExecutorBase {
+ public:
+  MergeJoin(Executor left, std::vector<slot_t> left_cols, Executor right,
+            std::vector<slot_t> right_cols,
+            MergeJoinType type = MergeJoinType::kInner, size_t left_width = 0,
+            size_t right_width = 0);
+  MergeJoin(const MergeJoin&) = delete;
+  MergeJoin(MergeJoin&&) = delete;
+  MergeJoin& operator=(const MergeJoin&) = delete;
+  MergeJoin& operator=(MergeJoin&&) = delete;
+  ~MergeJoin() override = default;
+
+  bool Next(Row* dst, RowPosition* rp) override;
+  void Dump(std::ostream& o, int indent) const override;
+
+  [[nodiscard]] MergeJoinType Type() const { return type_; }
+  // Largest run of equal right keys held at once.
+  [[nodiscard]] size_t MaxGroupRows() const { return max_group_rows_; }
+
+ private:
+  [[nodiscard]] bool KeepLeft() const;
+  [[nodiscard]] bool KeepRight() const;
+  void AdvanceLeft();
+  void AdvanceRight();
+  void LoadGroup();
+  // Ends the current group; right-outer joins first emit its unmatched rows.
+  void FinishGroup();
+  // Consumes the current left row, which has no partner. Returns whether it
+  // was written to `dst`.
+  bool EmitLeftOnly(Row* dst, RowPosition* rp);
+  [[nodiscard]] Row PadLeft(const Row& right) const;
+
+  Executor left_;
+  std::vector<slot_t> left_cols_;
+  Executor right_;
+  std::vector<slot_t> right_cols_;
+  MergeJoinType type_;
+  size_t left_width_;
+  size_t right_width_;
+
+  bool started_{false};
+  Row left_row_;
+  RowPosition left_position_;
+  bool left_valid_{false};
+  Row right_row_;
+  bool right_valid_{false};
+
+  std::vector<Row> group_;
+  std::vector<bool> group_matched_;
+  size_t max_group_rows_{0};
+  QueryMemoryCharge group_charge_;
+  bool emitting_{false};
+  size_t emit_offset_{0};
+  bool flushing_{false};
+  size_t flush_offset_{0};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_MERGE_JOIN_HPP
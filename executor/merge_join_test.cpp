@@ -0,0 +1,171 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/merge_join.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "executor/constant_executor.hpp"
+#include "gtest/gtest.h"
+#include "page/row_position.hpp"
+
+namespace tinylamb {
+namespace {
+
+std::vector<Row> Drain(ExecutorBase& executor) {
+  std::vector<Row> rows;
+  Row row;
+  while (executor.Next(&row, nullptr)) rows.push_back(row);
+  return rows;
+}
+
+std::vector<Row> Join(const std::vector<Row>& left,
+                      const std::vector<Row>& right, MergeJoinType type) {
+  MergeJoin join(std::make_shared<ConstantExecutor>(left), {0},
+                 std::make_shared<ConstantExecutor>(right), {0}, type, 2, 2);
+  return Drain(join);
+}
+
+// Nested-loop reference for one-column keys in rows of width two.
+std::vector<Row> Reference(const std::vector<Row>& left,
+                           const std::vector<Row>& right, MergeJoinType type) {
+  std::vector<Row> result;
+  std::vector<bool> right_matched(right.size(), false);
+  for (const Row& l : left) {
+    bool matched = false;
+    for (size_t i = 0; i < right.size(); ++i) {
+      if (l[0].IsNull() || right[i][0].IsNull() || l[0] != right[i][0]) {
+        continue;
+      }
+      result.push_back(l + right[i]);
+      matched = true;
+      right_matched[i] = true;
+    }
+    if (!matched && (type == MergeJoinType::kLeftOuter ||
+                     type == MergeJoinType::kFull)) {
+      result.push_back(l + Row({Value(), Value()}));
+    }
+  }
+  if (type == MergeJoinType::kRightOuter || type == MergeJoinType::kFull) {
+    for (size_t i = 0; i < right.size(); ++i) {
+      if (right_matched[i]) continue;
+      result.push_back(Row({Value(), Value()}) + right[i]);
+    }
+  }
+  return result;
+}
+
+std::vector<std::string> Sorted(const std::vector<Row>& rows) {
+  std::vector<std::string> printed;
+  for (const Row& row : rows) {
+    std::stringstream ss;
+    ss << row;
+    printed.push_back(ss.str());
+  }
+  std::ranges::sort(printed);
+  return printed;
+}
+
+TEST(MergeJoinTest, ManyToManyInner) {
+  const std::vector<Row> left = {
+      Row({Value(1), Value("a")}), Row({Value(2), Value("b")}),
+      Row({Value(2), Value("c")}), Row({Value(4), Value("d")})};
+  const std::vector<Row> right = {
+      Row({Value(2), Value("x")}), Row({Value(2), Value("y")}),
+      Row({Value(3), Value("z")}), Row({Value(4), Value("w")})};
+  EXPECT_EQ(Join(left, right, MergeJoinType::kInner),
+            (std::vector<Row>{
+                Row({Value(2), Value("b"), Value(2), Value("x")}),
+                Row({Value(2), Value("b"), Value(2), Value("y")}),
+                Row({Value(2), Value("c"), Value(2), Value("x")}),
+                Row({Value(2), Value("c"), Value(2), Value("y")}),
+                Row({Value(4), Value("d"), Value(4), Value("w")})}));
+
+  MergeJoin join(std::make_shared<ConstantExecutor>(left), {0},
+                 std::make_shared<ConstantExecutor>(right), {0});
+  Drain(join);
+  EXPECT_EQ(join.MaxGroupRows(), 2U);
+  std::stringstream ss;
+  join.Dump(ss, 0);
+  EXPECT_NE(ss.str().find("MergeJoin: left: {0} right: {0}"),
+            std::string::npos);
+}
+
+TEST(MergeJoinTest, OuterVariantsPadWithNulls) {
+  const std::vector<Row> left = {Row({Value(), Value("n")}),
+                                 Row({Value(1), Value("a")}),
+                                 Row({Value(3), Value("c")})};
+  const std::vector<Row> right = {Row({Value(), Value("m")}),
+                                  Row({Value(2), Value("x")}),
+                                  Row({Value(3), Value("y")})};
+  EXPECT_EQ(Join(left, right, MergeJoinType::kLeftOuter),
+            (std::vector<Row>{
+                Row({Value(), Value("n"), Value(), Value()}),
+                Row({Value(1), Value("a"), Value(), Value()}),
+                Row({Value(3), Value("c"), Value(3), Value("y")})}));
+  EXPECT_EQ(Join(left, right, MergeJoinType::kRightOuter),
+            (std::vector<Row>{
+                Row({Value(), Value(), Value(), Value("m")}),
+                Row({Value(), Value(), Value(2), Value("x")}),
+                Row({Value(3), Value("c"), Value(3), Value("y")})}));
+  EXPECT_EQ(Sorted(Join(left, right, MergeJoinType::kFull)),
+            Sorted(Reference(left, right, MergeJoinType::kFull)));
+  EXPECT_TRUE(Join({}, right, MergeJoinType::kInner).empty());
+  EXPECT_EQ(Join(left, {}, MergeJoinType::kLeftOuter).size(), 3U);
+}
+
+TEST(MergeJoinTest, MatchesNestedLoopOnRandomInputs) {
+  std::mt19937 rng(42);
+  const auto generate = [&](size_t count) {
+    std::vector<Row> rows;
+    for (size_t i = 0; i < count; ++i) {
+      const int key = static_cast<int>(rng() % 12);
+      rows.push_back(Row({key == 0 ? Value() : Value(key),
+                          Value(static_cast<int>(i))}));
+    }
+    // Index order: NULL keys first, then ascending.
+    std::ranges::stable_sort(rows, [](const Row& a, const Row& b) {
+      if (a[0].IsNull() || b[0].IsNull()) {
+        return a[0].IsNull() && !b[0].IsNull();
+      }
+      return a[0] < b[0];
+    });
+    return rows;
+  };
+  for (int round = 0; round < 20; ++round) {
+    const std::vector<Row> left = generate(rng() % 30);
+    const std::vector<Row> right = generate(rng() % 30);
+    for (MergeJoinType type :
+         {MergeJoinType::kInner, MergeJoinType::kLeftOuter,
+          MergeJoinType::kRightOuter, MergeJoinType::kFull}) {
+      EXPECT_EQ(Sorted(Join(left, right, type)),
+                Sorted(Reference(left, right, type)))
+          << MergeJoinTypeName(type) << " round " << round;
+    }
+  }
+}
+
+TEST(MergeJoinTest, CompositeKeysAndPositions) {
+  const std::vector<Row> left = {Row({Value(1), Value("a")}),
+                                 Row({Value(1), Value("b")})};
+  const std::vector<Row> right = {Row({Value("a"), Value(1)}),
+                                  Row({Value("b"), Value(2)})};
+  MergeJoin join(std::make_shared<ConstantExecutor>(left), {0, 1},
+                 std::make_shared<ConstantExecutor>(right), {1, 0});
+  Row row;
+  RowPosition position;
+  ASSERT_TRUE(join.Next(&row, &position));
+  EXPECT_EQ(row, Row({Value(1), Value("a"), Value("a"), Value(1)}));
+  EXPECT_FALSE(join.Next(&row, &position));
+
+  EXPECT_THROW(MergeJoin(std::make_shared<ConstantExecutor>(left), {0},
+                         std::make_shared<ConstantExecutor>(right), {0, 1}),
+               std::invalid_argument);
+}
+
+}  // namespace
+}  // namespace tinylamb
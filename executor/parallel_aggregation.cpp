@@ -21,7 +21,8 @@ ParallelAggregationExecutor::ParallelAggregationExecutor(
     : child_(std::move(child)),
       input_schema_(std::move(input_schema)),
       aggregates_(std::move(aggregates)),
-      worker_count_(std::max<size_t>(1, worker_count)) {}
+      worker_count_(std::max<size_t>(1, worker_count)),
+      memory_(MemoryContext::Current().Child("aggregation")) {}
 
 ParallelAggregationExecutor::PartialState
 ParallelAggregationExecutor::MakeState() const {
@@ -29,6 +30,8 @@ ParallelAggregationExecutor::MakeState() const {
   state.values.resize(aggregates_.size());
   state.counts.resize(aggregates_.size(), 0);
   state.distinct_values.resize(aggregates_.size());
+  state.sketches.resize(aggregates_.size());
+  state.charge = QueryMemoryCharge(memory_);
   for (size_t index = 0; index < aggregates_.size(); ++index) {
     const AggregationType type =
         aggregates_[index].expression->AsAggregateExpression().GetType();
@@ -44,10 +47,17 @@ void ParallelAggregationExecutor::AccumulateValue(
   if (value.IsNull()) return;
   const auto& aggregate =
       aggregates_[index].expression->AsAggregateExpression();
-  if (apply_distinct && aggregate.Distinct() &&
-      !state->distinct_values[index].insert(value).second) {
+  if (aggregate.GetType() == AggregationType::kApproxCountDistinct) {
+    HyperLogLog& sketch = state->sketches[index];
+    const size_t before = sketch.Bytes();
+    sketch.Add(value);
+    if (before < sketch.Bytes()) state->charge.Add(sketch.Bytes() - before);
     return;
   }
+  if (apply_distinct && aggregate.Distinct()) {
+    if (!state->distinct_values[index].insert(value).second) return;
+    state->charge.Add(EstimateValueBytes(value));
+  }
   switch (aggregate.GetType()) {
     case AggregationType::kSum:
       state->values[index] = state->values[index].IsNull()
@@ -74,6 +84,8 @@ void ParallelAggregationExecutor::AccumulateValue(
     case AggregationType::kCount:
       ++state->values[index].value.int_value;
       break;
+    case AggregationType::kApproxCountDistinct:
+      break;
   }
 }
 
@@ -115,6 +127,15 @@ void ParallelAggregationExecutor::Merge(PartialState* destination,
   for (size_t index = 0; index < aggregates_.size(); ++index) {
     const auto& aggregate =
         aggregates_[index].expression->AsAggregateExpression();
+    if (aggregate.GetType() == AggregationType::kApproxCountDistinct) {
+      HyperLogLog& sketch = destination->sketches[index];
+      const size_t before = sketch.Bytes();
+      sketch.Merge(source.sketches[index]);
+      if (before < sketch.Bytes()) {
+        destination->charge.Add(sketch.Bytes() - before);
+      }
+      continue;
+    }
     if (aggregate.Distinct()) {
       for (const Value& value : source.distinct_values[index]) {
         AccumulateValue(destination, index, value, true);
@@ -153,6 +174,8 @@ void ParallelAggregationExecutor::Merge(PartialState* destination,
         destination->values[index].value.int_value +=
             source.values[index].value.int_value;
         break;
+      case AggregationType::kApproxCountDistinct:
+        break;
     }
   }
 }
@@ -161,6 +184,11 @@ Row ParallelAggregationExecutor::Finalize(PartialState state) const {
   for (size_t index = 0; index < aggregates_.size(); ++index) {
     const auto& aggregate =
         aggregates_[index].expression->AsAggregateExpression();
+    if (aggregate.GetType() == AggregationType::kApproxCountDistinct) {
+      state.values[index] =
+          Value(static_cast<int64_t>(state.sketches[index].Estimate()));
+      continue;
+    }
     if (aggregate.GetType() != AggregationType::kAvg) continue;
     if (state.counts[index] == 0) {
       state.values[index] = Value();
@@ -189,6 +217,7 @@ bool ParallelAggregationExecutor::Next(Row* destination,
   workers.reserve(worker_count_);
   for (size_t worker = 0; worker < worker_count_; ++worker) {
     workers.emplace_back([&, worker] {
+      const ScopedMemoryContext scope(memory_);
       try {
         DataChunk chunk;
         while (!stopped.load(std::memory_order_relaxed)) {
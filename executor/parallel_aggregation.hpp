@@ -9,7 +9,9 @@
 #include <vector>
 
 #include "executor/executor_base.hpp"
+#include "executor/query_memory.hpp"
 #include "expression/named_expression.hpp"
+#include "type/hyperloglog.hpp"
 #include "type/schema.hpp"
 
 namespace tinylamb {
@@ -17,6 +19,9 @@ namespace tinylamb {
 // Global aggregation with one independent state per worker followed by a
 // deterministic merge.  DISTINCT sets are merged by value, not by combining
 // partial counts, so duplicates spanning morsels remain correct.
+// APPROX_COUNT_DISTINCT keeps a HyperLogLog sketch per worker instead, whose
+// memory stays bounded however many distinct values a worker sees; merging
+// the sketches is exact in the same sense.
 class ParallelAggregationExecutor final : public ExecutorBase {
  public:
   ParallelAggregationExecutor(
@@ -36,6 +41,9 @@ class ParallelAggregationExecutor final : public ExecutorBase {
     std::vector<Value> values;
     std::vector<int64_t> counts;
     std::vector<std::unordered_set<Value>> distinct_values;
+    std::vector<HyperLogLog> sketches;
+    // Bytes held by `distinct_values` and `sketches`.
+    QueryMemoryCharge charge;
   };
 
   [[nodiscard]] PartialState MakeState() const;
@@ -49,6 +57,8 @@ class ParallelAggregationExecutor final : public ExecutorBase {
   Schema input_schema_;
   std::vector<NamedExpression> aggregates_;
   size_t worker_count_;
+  // "aggregation" account of the query this executor was built for.
+  std::shared_ptr<MemoryContext> memory_;
   bool executed_{false};
 };
 
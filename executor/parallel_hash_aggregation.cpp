@@ -0,0 +1,189 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/parallel_hash_aggregation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <iterator>
+#include <thread>
+
+#include "executor/join_hash_table.hpp"
+
+namespace tinylamb {
+namespace {
+
+size_t DefaultWorkerCap() {
+  if (const char* env = std::getenv("TINYLAMB_AGGREGATE_WORKERS");
+      env != nullptr) {
+    if (const size_t workers = std::strtoull(env, nullptr, 10); workers > 0) {
+      return workers;
+    }
+  }
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+std::atomic<size_t>& WorkerCap() {
+  static std::atomic<size_t> cap{DefaultWorkerCap()};
+  return cap;
+}
+
+std::string_view KeyOf(const FlatHashMap<std::string_view, uint32_t>& index,
+                       uint32_t group) {
+  return std::next(index.begin(), group)->key;
+}
+
+}  // namespace
+
+size_t AggregationWorkerCount(size_t morsels) {
+  return std::clamp<size_t>(WorkerCap().load(std::memory_order_relaxed), 1,
+                            std::max<size_t>(1, morsels));
+}
+
+void SetAggregationWorkersForTest(size_t workers) {
+  WorkerCap().store(workers == 0 ? DefaultWorkerCap() : workers,
+                    std::memory_order_relaxed);
+}
+
+ParallelHashAggregation::ParallelHashAggregation(
+    std::vector<AggregateSpec> specs, KeyFn key_of, UpdateFn update)
+    : specs_(std::move(specs)),
+      key_of_(std::move(key_of)),
+      update_(std::move(update)) {}
+
+void ParallelHashAggregation::Run(size_t morsels, size_t workers,
+                                  const ProduceFn& produce) {
+  workers = std::clamp<size_t>(workers, 1, std::max<size_t>(1, morsels));
+  // A few partitions per worker even out skew in the merge.
+  const size_t partitions = std::bit_ceil(workers) * 4;
+  partition_shift_ = 64 - std::countr_zero(partitions);
+  partitions_ = std::vector<Table>(partitions);
+  std::vector<Worker> local(workers);
+  for (Worker& worker : local) worker.passed.resize(partitions);
+
+  RunMorsels(morsels, 1, workers, [&](size_t w, size_t begin, size_t end) {
+    Worker* worker = &local[w];
+    const RowFn add = [&](const Row& row) { Accumulate(worker, row); };
+    for (size_t morsel = begin; morsel < end; ++morsel) produce(morsel, add);
+  });
+  RunMorsels(workers, 1, workers, [&](size_t, size_t w, size_t) {
+    if (!local[w].table.index.Empty()) Seal(&local[w]);
+  });
+  RunMorsels(partitions, 1, workers, [&](size_t, size_t partition, size_t) {
+    Merge(partition, &local);
+  });
+  for (const Worker& worker : local) {
+    input_rows_ += worker.input_rows;
+    passed_rows_ += worker.passed_rows;
+  }
+}
+
+void ParallelHashAggregation::ForEachGroup(const GroupFn& fn) const {
+  for (const Table& table : partitions_) {
+    for (size_t group = 0; group < table.representatives.size(); ++group) {
+      fn(table.representatives[group], &table.states[group * specs_.size()]);
+    }
+  }
+}
+
+size_t ParallelHashAggregation::Groups() const {
+  size_t groups = 0;
+  for (const Table& table : partitions_) {
+    groups += table.representatives.size();
+  }
+  return groups;
+}
+
+std::pair<uint32_t, bool> ParallelHashAggregation::FindOrAdd(
+    Table* table, std::string_view key) const {
+  auto [group, inserted] = table->index.TryEmplace(key);
+  if (!inserted) return {*group, false};
+  *group = static_cast<uint32_t>(table->representatives.size());
+  table->representatives.emplace_back();
+  for (const AggregateSpec& spec : specs_) {
+    table->states.emplace_back(spec.type, spec.distinct);
+  }
+  table->charge.Add(key.size() + sizeof(Row) +
+                    specs_.size() * sizeof(AggregateState));
+  return {*group, true};
+}
+
+void ParallelHashAggregation::Represent(Table* table, uint32_t group,
+                                        Row row) {
+  table->charge.Add(EstimateRowBytes(row));
+  table->representatives[group] = std::move(row);
+}
+
+void ParallelHashAggregation::Accumulate(Worker* worker,
+                                         const Row& row) const {
+  ++worker->input_rows;
+  key_of_(row, &worker->key);
+  if (worker->pass_through) {
+    ++worker->passed_rows;
+    PassedBatch& passed = worker->passed[PartitionOf(worker->key)];
+    passed.keys += worker->key;
+    passed.key_ends.push_back(passed.keys.size());
+    passed.rows.push_back(row);
+    passed.charge.Add(worker->key.size() + sizeof(size_t) +
+                      EstimateRowBytes(row));
+    return;
+  }
+  Table& table = worker->table;
+  const auto [group, inserted] = FindOrAdd(&table, worker->key);
+  if (inserted) Represent(&table, group, row);
+  update_(row, &table.states[group * specs_.size()]);
+  ++table.rows;
+  if (table.representatives.size() >= kPreaggregationGroups) {
+    if (table.rows <
+        table.representatives.size() * kMinPreaggregationReduction) {
+      worker->pass_through = true;
+    }
+    Seal(worker);
+  }
+}
+
+void ParallelHashAggregation::Seal(Worker* worker) const {
+  SealedTable sealed{std::move(worker->table),
+                     std::vector<std::vector<uint32_t>>(partitions_.size())};
+  worker->table = Table();
+  uint32_t group = 0;
+  for (const auto& entry : sealed.table.index) {
+    sealed.routes[PartitionOf(entry.key)].push_back(group++);
+  }
+  worker->sealed.push_back(std::move(sealed));
+}
+
+void ParallelHashAggregation::Merge(size_t partition,
+                                    std::vector<Worker>* workers) {
+  const size_t width = specs_.size();
+  Table& out = partitions_[partition];
+  for (Worker& worker : *workers) {
+    for (SealedTable& sealed : worker.sealed) {
+      Table& in = sealed.table;
+      for (const uint32_t from : sealed.routes[partition]) {
+        const auto [group, inserted] = FindOrAdd(&out, KeyOf(in.index, from));
+        AggregateState* into = &out.states[group * width];
+        AggregateState* states = &in.states[from * width];
+        if (inserted) {
+          Represent(&out, group, std::move(in.representatives[from]));
+          std::move(states, states + width, into);
+          continue;
+        }
+        for (size_t i = 0; i < width; ++i) into[i].Merge(std::move(states[i]));
+      }
+    }
+    PassedBatch& passed = worker.passed[partition];
+    size_t begin = 0;
+    for (size_t i = 0; i < passed.rows.size(); ++i) {
+      const std::string_view key(passed.keys.data() + begin,
+                                 passed.key_ends[i] - begin);
+      begin = passed.key_ends[i];
+      const auto [group, inserted] = FindOrAdd(&out, key);
+      update_(passed.rows[i], &out.states[group * width]);
+      if (inserted) Represent(&out, group, std::move(passed.rows[i]));
+    }
+    passed = PassedBatch();
+  }
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,133 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_PARALLEL_HASH_AGGREGATION_HPP
+#define TINYLAMB_EXECUTOR_PARALLEL_HASH_AGGREGATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "executor/aggregate_state.hpp"
+#include "executor/flat_hash_table.hpp"
+#include "executor/query_memory.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Threads for an aggregation over `morsels` morsels of input: at most one
+// per morsel, capped at the hardware concurrency.
+//
+// Config: TINYLAMB_AGGREGATE_WORKERS
+//   - unset: hardware concurrency
+//   - "1": aggregate on the query thread only
+[[nodiscard]] size_t AggregationWorkerCount(size_t morsels);
+// Test helper: replace the worker cap (0 = back to the default).
+void SetAggregationWorkersForTest(size_t workers);
+
+// Groups a thread-local pre-aggregation table holds before it is sealed and
+// handed to the merge; small enough to stay cache resident.
+inline constexpr size_t kPreaggregationGroups = size_t{1} << 14;
+// A worker whose full pre-aggregation table folded fewer input rows per group
+// than this stops pre-aggregating.
+inline constexpr size_t kMinPreaggregationReduction = 2;
+
+// Two-phase parallel hash aggregation.
+//
+// Phase one: every worker aggregates the morsels it claims into a
+// thread-local table. A full table is sealed and replaced by an empty one.
+// When a sealed table shows the keys barely repeat, the worker switches to
+// pass-through and forwards its remaining rows unaggregated, since the local
+// table would then only add work.
+//
+// Phase two: sealed groups and passed rows are split into partitions by key
+// hash. Each partition is merged by one worker into its final table, by
+// merging AggregateStates and aggregating the passed rows.
+class ParallelHashAggregation {
+ public:
+  // key_of(row, &key) replaces `key` with the group key of `row`. Keys are
+  // compared as bytes, so AppendFlatKey encodings work.
+  using KeyFn = std::function<void(const Row&, std::string*)>;
+  // update(row, states) adds `row` to its group's states, one per spec.
+  using UpdateFn = std::function<void(const Row&, AggregateState*)>;
+  using RowFn = std::function<void(const Row&)>;
+  // produce(morsel, add) calls add(row) for every input row of `morsel`.
+  using ProduceFn = std::function<void(size_t, const RowFn&)>;
+  using GroupFn =
+      std::function<void(const Row& representative, const AggregateState*)>;
+
+  ParallelHashAggregation(std::vector<AggregateSpec> specs, KeyFn key_of,
+                          UpdateFn update);
+
+  // Aggregates morsels [0, morsels) on up to `workers` threads. key_of,
+  // update and produce run on those threads.
+  void Run(size_t morsels, size_t workers, const ProduceFn& produce);
+
+  // Calls fn(representative, states) for every group. The representative is
+  // one input row of the group. Groups come partition by partition, so the
+  // order does not follow the input.
+  void ForEachGroup(const GroupFn& fn) const;
+
+  [[nodiscard]] size_t Groups() const;
+  [[nodiscard]] size_t InputRows() const { return input_rows_; }
+  // Input rows that skipped pre-aggregation.
+  [[nodiscard]] size_t PassedRows() const { return passed_rows_; }
+
+ private:
+  // Groups by key. Group g is the g-th entry of `index` and owns states
+  // [g * width, (g + 1) * width).
+  struct Table {
+    FlatHashMap<std::string_view, uint32_t> index;
+    std::vector<Row> representatives;
+    std::vector<AggregateState> states;
+    size_t rows{0};
+    QueryMemoryCharge charge;
+  };
+  // A sealed pre-aggregation table with its groups split by partition.
+  struct SealedTable {
+    Table table;
+    std::vector<std::vector<uint32_t>> routes;
+  };
+  // Rows one worker passed through to one partition, with their keys.
+  struct PassedBatch {
+    std::string keys;
+    std::vector<size_t> key_ends;
+    std::vector<Row> rows;
+    QueryMemoryCharge charge;
+  };
+  struct Worker {
+    Table table;
+    std::vector<SealedTable> sealed;
+    std::vector<PassedBatch> passed;
+    std::string key;
+    bool pass_through{false};
+    size_t input_rows{0};
+    size_t passed_rows{0};
+  };
+
+  [[nodiscard]] size_t PartitionOf(std::string_view key) const {
+    return FlatHash(key) >> partition_shift_;
+  }
+  // Returns the group of `key` and whether it was just created; a new
+  // group still needs its representative.
+  std::pair<uint32_t, bool> FindOrAdd(Table* table,
+                                      std::string_view key) const;
+  static void Represent(Table* table, uint32_t group, Row row);
+  void Accumulate(Worker* worker, const Row& row) const;
+  void Seal(Worker* worker) const;
+  void Merge(size_t partition, std::vector<Worker>* workers);
+
+  std::vector<AggregateSpec> specs_;
+  KeyFn key_of_;
+  UpdateFn update_;
+  int partition_shift_{64};
+  std::vector<Table> partitions_;
+  size_t input_rows_{0};
+  size_t passed_rows_{0};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_PARALLEL_HASH_AGGREGATION_HPP
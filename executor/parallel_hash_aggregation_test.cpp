@@ -0,0 +1,172 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/parallel_hash_aggregation.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+constexpr size_t kMorselRows = 1000;
+
+// Groups rows (key, value) by key computing COUNT(*), SUM(value),
+// AVG(value) and COUNT(DISTINCT value).
+class Aggregation {
+ public:
+  explicit Aggregation(std::vector<Row> rows) : rows_(std::move(rows)) {}
+
+  std::map<int64_t, std::vector<Value>> Run(size_t workers) {
+    aggregation_.Run((rows_.size() + kMorselRows - 1) / kMorselRows, workers,
+                     [&](size_t morsel, const auto& add) {
+                       const size_t end =
+                           std::min(rows_.size(), (morsel + 1) * kMorselRows);
+                       for (size_t i = morsel * kMorselRows; i < end; ++i) {
+                         add(rows_[i]);
+                       }
+                     });
+    std::map<int64_t, std::vector<Value>> groups;
+    aggregation_.ForEachGroup(
+        [&](const Row& representative, const AggregateState* states) {
+          std::vector<Value>& values =
+              groups[representative[0].value.int_value];
+          EXPECT_TRUE(values.empty());
+          for (size_t i = 0; i < 4; ++i) values.push_back(states[i].Finish());
+        });
+    EXPECT_EQ(aggregation_.Groups(), groups.size());
+    EXPECT_EQ(aggregation_.InputRows(), rows_.size());
+    return groups;
+  }
+
+  [[nodiscard]] size_t PassedRows() const {
+    return aggregation_.PassedRows();
+  }
+
+ private:
+  std::vector<Row> rows_;
+  ParallelHashAggregation aggregation_{
+      {{AggregationType::kCount, false},
+       {AggregationType::kSum, false},
+       {AggregationType::kAvg, false},
+       {AggregationType::kCount, true}},
+      [](const Row& row, std::string* key) {
+        key->clear();
+        AppendFlatKey(row[0], key);
+      },
+      [](const Row& row, AggregateState* states) {
+        states[0].Add(Value(1));
+        for (size_t i = 1; i < 4; ++i) states[i].Add(row[1]);
+      }};
+};
+
+std::map<int64_t, std::vector<Value>> Expected(const std::vector<Row>& rows) {
+  std::map<int64_t, std::vector<AggregateState>> states;
+  for (const Row& row : rows) {
+    auto [it, inserted] = states.try_emplace(row[0].value.int_value);
+    if (inserted) {
+      it->second.emplace_back(AggregationType::kCount, false);
+      it->second.emplace_back(AggregationType::kSum, false);
+      it->second.emplace_back(AggregationType::kAvg, false);
+      it->second.emplace_back(AggregationType::kCount, true);
+    }
+    it->second[0].Add(Value(1));
+    for (size_t i = 1; i < 4; ++i) it->second[i].Add(row[1]);
+  }
+  std::map<int64_t, std::vector<Value>> expected;
+  for (const auto& [key, group] : states) {
+    for (const AggregateState& state : group) {
+      expected[key].push_back(state.Finish());
+    }
+  }
+  return expected;
+}
+
+std::vector<Row> Rows(size_t count, int64_t keys) {
+  std::vector<Row> rows;
+  rows.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto n = static_cast<int64_t>(i);
+    rows.push_back(Row({Value(n * 7919 % keys), Value(n % 13)}));
+  }
+  return rows;
+}
+
+}  // namespace
+
+TEST(ParallelHashAggregationTest, FewGroupsPreaggregate) {
+  const std::vector<Row> rows = Rows(50000, 100);
+  Aggregation aggregation(rows);
+  EXPECT_EQ(aggregation.Run(4), Expected(rows));
+  EXPECT_EQ(aggregation.PassedRows(), 0U);
+}
+
+TEST(ParallelHashAggregationTest, HighCardinalityPassesRowsThrough) {
+  // Every key appears about once per worker, so the first full table of
+  // each worker makes it stop pre-aggregating.
+  const std::vector<Row> rows = Rows(120000, 60000);
+  Aggregation aggregation(rows);
+  EXPECT_EQ(aggregation.Run(3), Expected(rows));
+  EXPECT_GT(aggregation.PassedRows(), 0U);
+}
+
+TEST(ParallelHashAggregationTest, PassedRowsAreCharged) {
+  // Distinct keys only: after the first sealed table every row is passed
+  // through, and each must stay charged until the merge consumes it.
+  const std::vector<Row> rows = Rows(60000, 60000);
+  const std::shared_ptr<MemoryContext> query = MemoryContext::NewQuery(0);
+  const ScopedMemoryContext scope(query);
+  ParallelHashAggregation aggregation(
+      {{AggregationType::kCount, false}},
+      [](const Row& row, std::string* key) {
+        key->clear();
+        AppendFlatKey(row[0], key);
+      },
+      [](const Row&, AggregateState* states) { states[0].Add(Value(1)); });
+  std::vector<size_t> used;
+  aggregation.Run(rows.size() / kMorselRows, 1,
+                  [&](size_t morsel, const auto& add) {
+                    used.push_back(query->Used());
+                    for (size_t i = 0; i < kMorselRows; ++i) {
+                      add(rows[morsel * kMorselRows + i]);
+                    }
+                  });
+  ASSERT_EQ(aggregation.PassedRows(),
+            rows.size() - kPreaggregationGroups);
+  // Morsels 20.. are passed through entirely.
+  const size_t passed = (used.size() - 1 - 20) * kMorselRows;
+  EXPECT_GE(used.back() - used[20], passed * EstimateRowBytes(rows[0]));
+  EXPECT_EQ(aggregation.Groups(), rows.size());
+}
+
+TEST(ParallelHashAggregationTest, SerialRunMatches) {
+  const std::vector<Row> rows = Rows(30000, 40000);
+  Aggregation aggregation(rows);
+  EXPECT_EQ(aggregation.Run(1), Expected(rows));
+}
+
+TEST(ParallelHashAggregationTest, WorkerErrorsReachTheCaller) {
+  ParallelHashAggregation aggregation(
+      {{AggregationType::kSum, false}},
+      [](const Row&, std::string* key) { key->clear(); },
+      [](const Row& row, AggregateState* states) { states[0].Add(row[0]); });
+  const Row text({Value("x")});
+  EXPECT_THROW(aggregation.Run(8, 4,
+                               [&](size_t, const auto& add) { add(text); }),
+               std::runtime_error);
+}
+
+TEST(ParallelHashAggregationTest, WorkerCountFollowsMorsels) {
+  SetAggregationWorkersForTest(4);
+  EXPECT_EQ(AggregationWorkerCount(0), 1U);
+  EXPECT_EQ(AggregationWorkerCount(2), 2U);
+  EXPECT_EQ(AggregationWorkerCount(100), 4U);
+  SetAggregationWorkersForTest(0);
+}
+
+}  // namespace tinylamb
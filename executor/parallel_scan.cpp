@@ -48,6 +48,19 @@ void ParallelScan::Start(size_t batch_size) {
 }
 
 void ParallelScan::RunWorker(size_t batch_size) {
+  Scan(batch_size);
+  // Chunks hold copies of the rows; the row images cached for this thread
+  // are no longer referenced.
+  txn_->ForgetThreadReadCache();
+  {
+    std::scoped_lock lock(mutex_);
+    --active_workers_;
+  }
+  ready_cv_.notify_all();
+  space_cv_.notify_all();
+}
+
+void ParallelScan::Scan(size_t batch_size) {
   try {
     while (true) {
       const size_t morsel_index = next_morsel_.fetch_add(1);
@@ -91,12 +104,6 @@ void ParallelScan::RunWorker(size_t batch_size) {
     if (!worker_error_) worker_error_ = std::current_exception();
     cancelled_ = true;
   }
-  {
-    std::scoped_lock lock(mutex_);
-    --active_workers_;
-  }
-  ready_cv_.notify_all();
-  space_cv_.notify_all();
 }
 
 bool ParallelScan::Enqueue(DataChunk chunk) {
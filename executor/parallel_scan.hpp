@@ -39,6 +39,8 @@ class ParallelScan final : public ExecutorBase {
 
  private:
   void Start(size_t batch_size);
+  // Scans morsels into chunks until they run out or the scan is cancelled.
+  void Scan(size_t batch_size);
   void RunWorker(size_t batch_size);
   bool Enqueue(DataChunk chunk);
 
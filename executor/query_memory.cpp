@@ -1,15 +1,25 @@
 /** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
 #include "executor/query_memory.hpp"
 
+#include <algorithm>
 #include <cstdlib>
+#include <limits>
 #include <string>
+#include <utility>
 
 #include "type/value.hpp"
 
 namespace tinylamb {
 namespace {
 constexpr size_t kDefaultQueryMemoryBytes = size_t{1} << 30;  // 1 GiB
-}
+constexpr size_t kUnlimitedGrant = std::numeric_limits<size_t>::max();
+
+// Spill point of a context allowed `limit` bytes; matches the budget's 80%.
+size_t SoftLimit(size_t limit) { return limit / 5 * 4; }
+
+std::atomic<size_t> active_queries{0};
+thread_local std::shared_ptr<MemoryContext> current_context;
+}  // namespace
 
 size_t QueryMemoryBudget::LimitFromEnv() {
   const char* env = std::getenv("TINYLAMB_QUERY_MEMORY_BYTES");
@@ -71,6 +81,195 @@ void QueryMemoryBudget::Release(size_t bytes) {
   }
 }
 
+void MemoryContext::Account::Add(size_t added) {
+  const size_t now = bytes.fetch_add(added, std::memory_order_relaxed) + added;
+  size_t seen = peak.load(std::memory_order_relaxed);
+  while (seen < now &&
+         !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+  }
+}
+
+void MemoryContext::Account::Sub(size_t removed) {
+  size_t cur = bytes.load(std::memory_order_relaxed);
+  for (;;) {
+    const size_t next = cur > removed ? cur - removed : 0;
+    if (bytes.compare_exchange_weak(cur, next, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+MemoryContext::MemoryContext(Level level,
+                             std::shared_ptr<MemoryContext> parent,
+                             Account* account, size_t limit)
+    : level_(level),
+      parent_(std::move(parent)),
+      account_(account),
+      limit_(limit) {
+  if (account_ == nullptr) {
+    own_ = std::make_unique<Account>(level_ == Level::kProcess ? "process"
+                                                               : "query");
+    account_ = own_.get();
+  }
+}
+
+MemoryContext::~MemoryContext() {
+  if (level_ == Level::kQuery) {
+    active_queries.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+MemoryContext& MemoryContext::Process() {
+  // Never destroyed: charges may outlive static destruction order.
+  static auto* process = new std::shared_ptr<MemoryContext>(
+      new MemoryContext(Level::kProcess, nullptr, nullptr, 0));
+  return **process;
+}
+
+MemoryContext& MemoryContext::Current() {
+  return current_context ? *current_context : Process();
+}
+
+std::shared_ptr<MemoryContext> MemoryContext::ForQuery() {
+  MemoryContext& owner = Current().Owner();
+  if (owner.level_ == Level::kQuery) return owner.shared_from_this();
+  return NewQuery(QueryLimitFromEnv());
+}
+
+std::shared_ptr<MemoryContext> MemoryContext::NewQuery(size_t limit_bytes) {
+  active_queries.fetch_add(1, std::memory_order_relaxed);
+  return std::shared_ptr<MemoryContext>(new MemoryContext(
+      Level::kQuery, Process().shared_from_this(), nullptr, limit_bytes));
+}
+
+size_t MemoryContext::QueryLimitFromEnv() {
+  const char* env = std::getenv("TINYLAMB_QUERY_MEMORY_PER_QUERY_BYTES");
+  if (env == nullptr || env[0] == '\0') return 0;
+  return static_cast<size_t>(std::strtoull(env, nullptr, 10));
+}
+
+size_t MemoryContext::ActiveQueries() {
+  return active_queries.load(std::memory_order_relaxed);
+}
+
+MemoryContext& MemoryContext::Owner() {
+  return level_ == Level::kOperator ? *parent_ : *this;
+}
+
+const MemoryContext& MemoryContext::Owner() const {
+  return level_ == Level::kOperator ? *parent_ : *this;
+}
+
+std::shared_ptr<MemoryContext> MemoryContext::Child(std::string_view name) {
+  MemoryContext& owner = Owner();
+  Account* account = nullptr;
+  {
+    std::scoped_lock lock(owner.mu_);
+    auto found = owner.operators_.find(name);
+    if (found == owner.operators_.end()) {
+      found = owner.operators_
+                  .emplace(std::string(name),
+                           std::make_unique<Account>(std::string(name)))
+                  .first;
+    }
+    account = found->second.get();
+  }
+  return std::shared_ptr<MemoryContext>(new MemoryContext(
+      Level::kOperator, owner.shared_from_this(), account, 0));
+}
+
+std::string_view MemoryContext::Name() const { return account_->name; }
+
+size_t MemoryContext::Used() const {
+  if (level_ == Level::kProcess) return QueryMemoryBudget::Global().Used();
+  return account_->bytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryContext::Peak() const {
+  return account_->peak.load(std::memory_order_relaxed);
+}
+
+size_t MemoryContext::Grant() const {
+  const QueryMemoryBudget& budget = QueryMemoryBudget::Global();
+  switch (level_) {
+    case Level::kOperator:
+      return parent_->Grant();
+    case Level::kProcess:
+      return budget.Unlimited() ? kUnlimitedGrant : SoftLimit(budget.Limit());
+    case Level::kQuery:
+      break;
+  }
+  size_t limit = limit_;
+  if (!budget.Unlimited()) {
+    const size_t share =
+        budget.Limit() / std::max<size_t>(1, ActiveQueries());
+    limit = limit == 0 ? share : std::min(limit, share);
+  }
+  return limit == 0 ? kUnlimitedGrant : SoftLimit(limit);
+}
+
+bool MemoryContext::CanReserve(size_t bytes) const {
+  switch (level_) {
+    case Level::kOperator:
+      return parent_->CanReserve(bytes);
+    case Level::kProcess:
+      return QueryMemoryBudget::Global().CanReserve(bytes);
+    case Level::kQuery:
+      break;
+  }
+  if (bytes == 0) return true;
+  const size_t grant = Grant();
+  const size_t used = Used();
+  if (grant != kUnlimitedGrant && (used >= grant || grant - used < bytes)) {
+    return false;
+  }
+  return parent_->CanReserve(bytes);
+}
+
+void MemoryContext::Reserve(size_t bytes) {
+  if (bytes == 0) return;
+  if (level_ == Level::kProcess) {
+    account_->Add(bytes);
+    QueryMemoryBudget::Global().ReserveForced(bytes);
+    return;
+  }
+  account_->Add(bytes);
+  parent_->Reserve(bytes);
+}
+
+void MemoryContext::Release(size_t bytes) {
+  if (bytes == 0) return;
+  account_->Sub(bytes);
+  if (level_ == Level::kProcess) {
+    QueryMemoryBudget::Global().Release(bytes);
+    return;
+  }
+  parent_->Release(bytes);
+}
+
+std::vector<MemoryContext::Usage> MemoryContext::Breakdown() const {
+  const MemoryContext& owner = Owner();
+  std::vector<Usage> usage;
+  std::scoped_lock lock(owner.mu_);
+  usage.reserve(owner.operators_.size());
+  for (const auto& [name, account] : owner.operators_) {
+    usage.push_back({name, account->bytes.load(std::memory_order_relaxed),
+                     account->peak.load(std::memory_order_relaxed)});
+  }
+  return usage;
+}
+
+ScopedMemoryContext::ScopedMemoryContext(
+    std::shared_ptr<MemoryContext> context)
+    : previous_(std::exchange(current_context, std::move(context))) {}
+
+ScopedMemoryContext::ScopedMemoryContext(MemoryContext& context)
+    : ScopedMemoryContext(context.shared_from_this()) {}
+
+ScopedMemoryContext::~ScopedMemoryContext() {
+  current_context = std::move(previous_);
+}
+
 size_t EstimateValueBytes(const Value& value) {
   constexpr size_t kBase = 32;
   switch (value.type) {
@@ -95,15 +294,18 @@ size_t EstimateRowBytes(const Row& row) {
   return total;
 }
 
-QueryMemoryCharge::QueryMemoryCharge(size_t bytes) {
-  if (bytes != 0) {
-    QueryMemoryBudget::Global().ReserveForced(bytes);
-    bytes_ = bytes;
-  }
+QueryMemoryCharge::QueryMemoryCharge()
+    : context_(MemoryContext::Current().shared_from_this()) {}
+
+QueryMemoryCharge::QueryMemoryCharge(size_t bytes) : QueryMemoryCharge() {
+  Add(bytes);
 }
 
+QueryMemoryCharge::QueryMemoryCharge(std::shared_ptr<MemoryContext> context)
+    : context_(std::move(context)) {}
+
 QueryMemoryCharge::QueryMemoryCharge(QueryMemoryCharge&& other) noexcept
-    : bytes_(other.bytes_) {
+    : context_(other.context_), bytes_(other.bytes_) {
   other.bytes_ = 0;
 }
 
@@ -111,6 +313,7 @@ QueryMemoryCharge& QueryMemoryCharge::operator=(
     QueryMemoryCharge&& other) noexcept {
   if (this != &other) {
     ReleaseAll();
+    context_ = other.context_;
     bytes_ = other.bytes_;
     other.bytes_ = 0;
   }
@@ -123,7 +326,7 @@ void QueryMemoryCharge::Add(size_t bytes) {
   if (bytes == 0) {
     return;
   }
-  QueryMemoryBudget::Global().ReserveForced(bytes);
+  context_->Reserve(bytes);
   bytes_ += bytes;
 }
 
@@ -131,7 +334,7 @@ void QueryMemoryCharge::ReleaseAll() {
   if (bytes_ == 0) {
     return;
   }
-  QueryMemoryBudget::Global().Release(bytes_);
+  context_->Release(bytes_);
   bytes_ = 0;
 }
 
@@ -4,7 +4,13 @@
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "type/row.hpp"
 
@@ -46,14 +52,120 @@ class QueryMemoryBudget {
   static constexpr size_t kSoftFractionDen = 5;  // spill at 80%
 };
 
+// Memory accounts layered over the QueryMemoryBudget: the process at the
+// root, one context per query under it, and named operator accounts
+// ("relation", "hash_join", "sort", "aggregation") under each query.
+// Charges propagate to every ancestor, so the process total stays the
+// QueryMemoryBudget's usage.
+//
+// A query may only grow to its grant: 80% of the smaller of its own limit
+// and its fair share of the process budget, which is split evenly between
+// the queries alive at the time. A query past its grant is told to spill
+// while lighter queries keep running in memory. Operators see the grant of
+// their query.
+//
+// Config: TINYLAMB_QUERY_MEMORY_PER_QUERY_BYTES
+//   - unset or "0": queries are limited by their fair share only
+class MemoryContext : public std::enable_shared_from_this<MemoryContext> {
+ public:
+  enum class Level : uint8_t { kProcess, kQuery, kOperator };
+
+  // Bytes an account holds now and the most it held at once.
+  struct Usage {
+    std::string name;
+    size_t bytes{0};
+    size_t peak{0};
+  };
+
+  MemoryContext(const MemoryContext&) = delete;
+  MemoryContext& operator=(const MemoryContext&) = delete;
+  ~MemoryContext();
+
+  static MemoryContext& Process();
+  // The context charges made on this thread go to: the innermost
+  // ScopedMemoryContext, or Process() outside any.
+  static MemoryContext& Current();
+  // Context for a query starting on this thread. Statements nested in a
+  // running query, such as subqueries, share that query's context.
+  static std::shared_ptr<MemoryContext> ForQuery();
+  // A fresh query context under Process() capped at `limit_bytes`
+  // (0 = fair share only).
+  static std::shared_ptr<MemoryContext> NewQuery(size_t limit_bytes);
+  [[nodiscard]] static size_t QueryLimitFromEnv();
+
+  // Operator account `name` of this context's query (or of the process).
+  // Contexts with the same name share one account.
+  [[nodiscard]] std::shared_ptr<MemoryContext> Child(std::string_view name);
+
+  [[nodiscard]] Level GetLevel() const { return level_; }
+  [[nodiscard]] std::string_view Name() const;
+  [[nodiscard]] size_t Used() const;
+  [[nodiscard]] size_t Peak() const;
+  // Bytes the enclosing query may hold before it should spill;
+  // SIZE_MAX when nothing limits it.
+  [[nodiscard]] size_t Grant() const;
+  // Whether `bytes` more fit the grant and the process budget. Does not
+  // charge anything; pair with Reserve / QueryMemoryCharge::Add.
+  [[nodiscard]] bool CanReserve(size_t bytes) const;
+  void Reserve(size_t bytes);
+  void Release(size_t bytes);
+  // Operator accounts of this query, by name.
+  [[nodiscard]] std::vector<Usage> Breakdown() const;
+  // Queries currently holding a context.
+  [[nodiscard]] static size_t ActiveQueries();
+
+ private:
+  struct Account {
+    explicit Account(std::string account_name)
+        : name(std::move(account_name)) {}
+    void Add(size_t bytes);
+    void Sub(size_t bytes);
+    std::string name;
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> peak{0};
+  };
+
+  MemoryContext(Level level, std::shared_ptr<MemoryContext> parent,
+                Account* account, size_t limit);
+  [[nodiscard]] MemoryContext& Owner();
+  [[nodiscard]] const MemoryContext& Owner() const;
+
+  Level level_;
+  // Queries keep the process alive, operators their query.
+  std::shared_ptr<MemoryContext> parent_;
+  // Owned by this context for queries, by the query for operators; unused
+  // by the process, which accounts in QueryMemoryBudget.
+  Account* account_;
+  size_t limit_;
+  std::unique_ptr<Account> own_;
+  mutable std::mutex mu_;
+  std::map<std::string, std::unique_ptr<Account>, std::less<>> operators_;
+};
+
+// Makes `context` the current MemoryContext of this thread until destroyed.
+// Worker threads that charge on behalf of a query open one with the query
+// thread's context.
+class ScopedMemoryContext {
+ public:
+  explicit ScopedMemoryContext(std::shared_ptr<MemoryContext> context);
+  explicit ScopedMemoryContext(MemoryContext& context);
+  ScopedMemoryContext(const ScopedMemoryContext&) = delete;
+  ScopedMemoryContext& operator=(const ScopedMemoryContext&) = delete;
+  ~ScopedMemoryContext();
+
+ private:
+  std::shared_ptr<MemoryContext> previous_;
+};
+
 [[nodiscard]] size_t EstimateValueBytes(const Value& value);
 [[nodiscard]] size_t EstimateRowBytes(const Row& row);
 
-// RAII charge against the global budget.
+// RAII charge against a MemoryContext: the current one when not given.
 class QueryMemoryCharge {
  public:
-  QueryMemoryCharge() = default;
+  QueryMemoryCharge();
   explicit QueryMemoryCharge(size_t bytes);
+  explicit QueryMemoryCharge(std::shared_ptr<MemoryContext> context);
   QueryMemoryCharge(const QueryMemoryCharge&) = delete;
   QueryMemoryCharge& operator=(const QueryMemoryCharge&) = delete;
   QueryMemoryCharge(QueryMemoryCharge&& other) noexcept;
@@ -63,8 +175,10 @@ class QueryMemoryCharge {
   void Add(size_t bytes);
   void ReleaseAll();
   [[nodiscard]] size_t Bytes() const { return bytes_; }
+  [[nodiscard]] MemoryContext& Context() const { return *context_; }
 
  private:
+  std::shared_ptr<MemoryContext> context_;
   size_t bytes_{0};
 };
 
@@ -2,7 +2,10 @@
 #include "executor/query_memory.hpp"
 
 #include <cstdlib>
+#include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "type/row.hpp"
@@ -173,4 +176,82 @@ TEST(QueryMemoryTest, QueryMemoryChargeMove) {
   EXPECT_EQ(budget.Used(), 0U);
 }
 
+TEST(QueryMemoryTest, ContextsChargeTheirAncestors) {
+  QueryMemoryBudget& budget = QueryMemoryBudget::Global();
+  budget.ResetForTest(0);
+  std::shared_ptr<MemoryContext> query = MemoryContext::NewQuery(0);
+  EXPECT_EQ(query->GetLevel(), MemoryContext::Level::kQuery);
+  std::shared_ptr<MemoryContext> join = query->Child("hash_join");
+  EXPECT_EQ(join->GetLevel(), MemoryContext::Level::kOperator);
+  EXPECT_EQ(join->Name(), "hash_join");
+  {
+    QueryMemoryCharge charge(join);
+    charge.Add(300);
+    QueryMemoryCharge sort(query->Child("sort"));
+    sort.Add(50);
+    EXPECT_EQ(join->Used(), 300U);
+    EXPECT_EQ(query->Used(), 350U);
+    EXPECT_EQ(budget.Used(), 350U);
+  }
+  EXPECT_EQ(query->Used(), 0U);
+  EXPECT_EQ(query->Peak(), 350U);
+  EXPECT_EQ(budget.Used(), 0U);
+  // Contexts with the same name share one account.
+  query->Child("hash_join")->Reserve(10);
+  const std::vector<MemoryContext::Usage> usage = query->Breakdown();
+  ASSERT_EQ(usage.size(), 2U);
+  EXPECT_EQ(usage[0].name, "hash_join");
+  EXPECT_EQ(usage[0].bytes, 10U);
+  EXPECT_EQ(usage[0].peak, 300U);
+  EXPECT_EQ(usage[1].name, "sort");
+  EXPECT_EQ(usage[1].peak, 50U);
+  join->Release(10);
+  EXPECT_EQ(budget.Used(), 0U);
+}
+
+TEST(QueryMemoryTest, QueriesSplitTheBudgetFairly) {
+  QueryMemoryBudget& budget = QueryMemoryBudget::Global();
+  budget.ResetForTest(1000);
+  std::shared_ptr<MemoryContext> heavy = MemoryContext::NewQuery(0);
+  EXPECT_EQ(heavy->Grant(), 800U);
+  {
+    std::shared_ptr<MemoryContext> light = MemoryContext::NewQuery(0);
+    EXPECT_EQ(MemoryContext::ActiveQueries(), 2U);
+    EXPECT_EQ(heavy->Grant(), 400U);
+    QueryMemoryCharge charge(heavy->Child("sort"));
+    charge.Add(400);
+    // Only the query past its share is told to spill.
+    EXPECT_FALSE(heavy->Child("sort")->CanReserve(1));
+    EXPECT_TRUE(light->CanReserve(400));
+    EXPECT_FALSE(light->CanReserve(401));
+  }
+  EXPECT_EQ(MemoryContext::ActiveQueries(), 1U);
+  EXPECT_TRUE(heavy->CanReserve(800));
+
+  // A per-query limit below the fair share wins.
+  std::shared_ptr<MemoryContext> capped = MemoryContext::NewQuery(100);
+  EXPECT_EQ(capped->Grant(), 80U);
+  EXPECT_FALSE(capped->CanReserve(81));
+  budget.ResetForTest(0);
+  EXPECT_EQ(heavy->Grant(), std::numeric_limits<size_t>::max());
+  EXPECT_EQ(capped->Grant(), 80U);
+}
+
+TEST(QueryMemoryTest, ScopedContextRoutesCharges) {
+  QueryMemoryBudget::Global().ResetForTest(0);
+  EXPECT_EQ(&MemoryContext::Current(), &MemoryContext::Process());
+  std::shared_ptr<MemoryContext> query = MemoryContext::ForQuery();
+  {
+    const ScopedMemoryContext scope(query->Child("relation"));
+    EXPECT_EQ(MemoryContext::Current().Name(), "relation");
+    // Nested statements share the running query.
+    EXPECT_EQ(MemoryContext::ForQuery(), query);
+    QueryMemoryCharge charge(64);
+    EXPECT_EQ(query->Used(), 64U);
+  }
+  EXPECT_EQ(query->Used(), 0U);
+  EXPECT_EQ(&MemoryContext::Current(), &MemoryContext::Process());
+  EXPECT_NE(MemoryContext::ForQuery(), query);
+}
+
 }  // namespace tinylamb
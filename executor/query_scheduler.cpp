@@ -31,6 +31,21 @@ QueryScheduler::Lease QueryScheduler::Acquire(size_t cpu_slots,
   return Lease(this, cpu_slots, memory_bytes);
 }
 
+std::optional<QueryScheduler::Lease> QueryScheduler::TryAcquire(
+    size_t cpu_slots, size_t memory_bytes) {
+  cpu_slots = std::clamp<size_t>(cpu_slots, 1, cpu_capacity_);
+  memory_bytes = std::min(memory_bytes, memory_capacity_);
+  std::scoped_lock lock(mutex_);
+  if (next_ticket_ != serving_ticket_ ||
+      cpu_capacity_ < used_cpu_ + cpu_slots ||
+      memory_capacity_ < used_memory_ + memory_bytes) {
+    return std::nullopt;
+  }
+  used_cpu_ += cpu_slots;
+  used_memory_ += memory_bytes;
+  return Lease(this, cpu_slots, memory_bytes);
+}
+
 void QueryScheduler::Release(size_t cpu_slots, size_t memory_bytes) {
   {
     std::scoped_lock lock(mutex_);
@@ -79,24 +94,63 @@ void QueryScheduler::Lease::Release() {
   scheduler_ = nullptr;
 }
 
+namespace {
+thread_local QueryTaskSlots* current_task_slots = nullptr;
+}  // namespace
+
+bool QueryTaskSlots::TryTake() {
+  size_t spare = spare_.load(std::memory_order_acquire);
+  while (0 < spare) {
+    if (spare_.compare_exchange_weak(spare, spare - 1,
+                                     std::memory_order_acq_rel)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+QueryTaskSlots* QueryTaskSlots::Current() { return current_task_slots; }
+
+ScopedQueryTaskSlots::ScopedQueryTaskSlots(QueryTaskSlots* slots)
+    : previous_(std::exchange(current_task_slots, slots)) {}
+
+ScopedQueryTaskSlots::~ScopedQueryTaskSlots() {
+  current_task_slots = previous_;
+}
+
 void ScheduledExecutor::EnsureLease() {
   if (!lease_) {
     lease_ = std::make_unique<QueryScheduler::Lease>(
         scheduler_->Acquire(cpu_slots_, memory_bytes_));
+    task_slots_ = std::make_unique<QueryTaskSlots>(lease_->CpuSlots());
   }
 }
 
 bool ScheduledExecutor::Next(Row* destination, RowPosition* position) {
   EnsureLease();
-  const bool produced = child_->Next(destination, position);
-  if (!produced) lease_.reset();
+  bool produced = false;
+  {
+    const ScopedQueryTaskSlots slots(task_slots_.get());
+    produced = child_->Next(destination, position);
+  }
+  if (!produced) {
+    task_slots_.reset();
+    lease_.reset();
+  }
   return produced;
 }
 
 size_t ScheduledExecutor::NextBatch(DataChunk* destination, size_t max_rows) {
   EnsureLease();
-  const size_t produced = child_->NextBatch(destination, max_rows);
-  if (produced == 0) lease_.reset();
+  size_t produced = 0;
+  {
+    const ScopedQueryTaskSlots slots(task_slots_.get());
+    produced = child_->NextBatch(destination, max_rows);
+  }
+  if (produced == 0) {
+    task_slots_.reset();
+    lease_.reset();
+  }
   return produced;
 }
 
@@ -2,11 +2,13 @@
 #ifndef TINYLAMB_EXECUTOR_QUERY_SCHEDULER_HPP
 #define TINYLAMB_EXECUTOR_QUERY_SCHEDULER_HPP
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 
 #include "executor/executor_base.hpp"
 
@@ -23,6 +25,9 @@ class QueryScheduler {
     Lease& operator=(Lease&& other) noexcept;
     ~Lease();
     void Release();
+    [[nodiscard]] size_t CpuSlots() const {
+      return scheduler_ ? cpu_slots_ : 0;
+    }
 
    private:
     friend class QueryScheduler;
@@ -37,6 +42,10 @@ class QueryScheduler {
 
   QueryScheduler(size_t cpu_slots, size_t memory_bytes);
   [[nodiscard]] Lease Acquire(size_t cpu_slots, size_t memory_bytes);
+  // Like Acquire, but only grants a lease that fits right now and would not
+  // overtake a query already waiting; nullopt otherwise.
+  [[nodiscard]] std::optional<Lease> TryAcquire(size_t cpu_slots,
+                                                size_t memory_bytes);
   [[nodiscard]] size_t UsedCpuSlots() const;
   [[nodiscard]] size_t UsedMemoryBytes() const;
   [[nodiscard]] size_t CpuCapacity() const { return cpu_capacity_; }
@@ -57,8 +66,44 @@ class QueryScheduler {
   uint64_t serving_ticket_{0};
 };
 
+// CPU slots of a running query that concurrent subtasks may borrow. The
+// query's own thread keeps one slot; the others are lent out one at a time.
+class QueryTaskSlots {
+ public:
+  explicit QueryTaskSlots(size_t cpu_slots)
+      : spare_(cpu_slots == 0 ? 0 : cpu_slots - 1) {}
+  QueryTaskSlots(const QueryTaskSlots&) = delete;
+  QueryTaskSlots& operator=(const QueryTaskSlots&) = delete;
+
+  [[nodiscard]] bool TryTake();
+  void Give() { spare_.fetch_add(1, std::memory_order_acq_rel); }
+  [[nodiscard]] size_t Spare() const {
+    return spare_.load(std::memory_order_acquire);
+  }
+
+  // Slots of the query running on this thread; nullptr outside a query
+  // that holds a lease.
+  static QueryTaskSlots* Current();
+
+ private:
+  std::atomic<size_t> spare_;
+};
+
+// Makes `slots` the current thread's QueryTaskSlots until destroyed.
+class ScopedQueryTaskSlots {
+ public:
+  explicit ScopedQueryTaskSlots(QueryTaskSlots* slots);
+  ScopedQueryTaskSlots(const ScopedQueryTaskSlots&) = delete;
+  ScopedQueryTaskSlots& operator=(const ScopedQueryTaskSlots&) = delete;
+  ~ScopedQueryTaskSlots();
+
+ private:
+  QueryTaskSlots* previous_;
+};
+
 // Keeps a query-level lease from its first pull until exhaustion or executor
 // destruction, so every operator in the plan shares one CPU/memory budget.
+// While the child runs, the lease's CPU slots are its QueryTaskSlots.
 class ScheduledExecutor final : public ExecutorBase {
  public:
   ScheduledExecutor(Executor child, QueryScheduler& scheduler,
@@ -81,6 +126,7 @@ class ScheduledExecutor final : public ExecutorBase {
   size_t cpu_slots_;
   size_t memory_bytes_;
   std::unique_ptr<QueryScheduler::Lease> lease_;
+  std::unique_ptr<QueryTaskSlots> task_slots_;
 };
 
 }  // namespace tinylamb
@@ -139,6 +139,65 @@ TEST(QuerySchedulerTest, ScheduledExecutorDumpAndExplain) {
   EXPECT_NE(explain.str().find("ScheduledQuery"), std::string::npos);
 }
 
+TEST(QuerySchedulerTest, TryAcquireNeverWaits) {
+  QueryScheduler scheduler(2, 100);
+  auto first = scheduler.TryAcquire(1, 60);
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(first->CpuSlots(), 1U);
+  EXPECT_FALSE(scheduler.TryAcquire(1, 60).has_value());
+  auto second = scheduler.TryAcquire(1, 40);
+  ASSERT_TRUE(second.has_value());
+  EXPECT_FALSE(scheduler.TryAcquire(1, 0).has_value());
+  second->Release();
+  EXPECT_EQ(second->CpuSlots(), 0U);
+  EXPECT_EQ(scheduler.UsedCpuSlots(), 1U);
+}
+
+TEST(QuerySchedulerTest, QueryTaskSlotsLendAllButOne) {
+  QueryTaskSlots slots(3);
+  EXPECT_EQ(slots.Spare(), 2U);
+  EXPECT_TRUE(slots.TryTake());
+  EXPECT_TRUE(slots.TryTake());
+  EXPECT_FALSE(slots.TryTake());
+  slots.Give();
+  EXPECT_EQ(slots.Spare(), 1U);
+  EXPECT_EQ(QueryTaskSlots(0).Spare(), 0U);
+
+  EXPECT_EQ(QueryTaskSlots::Current(), nullptr);
+  {
+    ScopedQueryTaskSlots scope(&slots);
+    EXPECT_EQ(QueryTaskSlots::Current(), &slots);
+  }
+  EXPECT_EQ(QueryTaskSlots::Current(), nullptr);
+}
+
+TEST(QuerySchedulerTest, ScheduledExecutorLendsLeaseSlotsToChild) {
+  // Records the task slots visible while the child runs.
+  class SlotProbe final : public ExecutorBase {
+   public:
+    bool Next(Row* destination, RowPosition*) override {
+      if (done_) return false;
+      done_ = true;
+      QueryTaskSlots* slots = QueryTaskSlots::Current();
+      spare_ = slots == nullptr ? -1 : static_cast<int>(slots->Spare());
+      *destination = Row({Value(1)});
+      return true;
+    }
+    void Dump(std::ostream& o, int) const override { o << "SlotProbe"; }
+    int spare_{-2};
+
+   private:
+    bool done_{false};
+  };
+  QueryScheduler scheduler(4, 128);
+  auto probe = std::make_shared<SlotProbe>();
+  ScheduledExecutor executor(probe, scheduler, 3, 64);
+  Row row;
+  ASSERT_TRUE(executor.Next(&row, nullptr));
+  EXPECT_EQ(probe->spare_, 2);
+  EXPECT_EQ(QueryTaskSlots::Current(), nullptr);
+}
+
 TEST(QuerySchedulerTest, GlobalReturnsSameSingleton) {
   QueryScheduler& a = QueryScheduler::Global();
   QueryScheduler& b = QueryScheduler::Global();
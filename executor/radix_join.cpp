@@ -0,0 +1,220 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/radix_join.hpp"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "executor/hash_join_mode.hpp"
+
+namespace tinylamb {
+namespace {
+
+constexpr size_t kCacheLineBytes = 64;
+constexpr size_t kLineTuples = kCacheLineBytes / sizeof(RadixTuple);
+
+// Software write-combining buffer: tuples bound for one partition are staged
+// in a cache-line-sized line and stored to the partition a full line at a
+// time, so scattering to many partitions does not read-for-ownership a
+// different destination line per tuple.
+struct alignas(kCacheLineBytes) WriteCombiningLine {
+  RadixTuple tuples[kLineTuples];
+};
+
+struct PassScratch {
+  std::vector<WriteCombiningLine> lines;
+  std::vector<uint8_t> fill;
+};
+
+size_t CacheSize(int name, size_t fallback) {
+  const long bytes = sysconf(name);  // NOLINT(google-runtime-int)
+  return bytes > 0 ? static_cast<size_t>(bytes) : fallback;
+}
+
+size_t RadixThresholdFromEnv() {
+  if (const char* env = std::getenv("TINYLAMB_RADIX_JOIN_BYTES");
+      env != nullptr) {
+    return std::strtoull(env, nullptr, 10);
+  }
+  return CacheSize(_SC_LEVEL3_CACHE_SIZE,
+                   CacheSize(_SC_LEVEL2_CACHE_SIZE, size_t{8} << 20));
+}
+
+std::atomic<size_t>& RadixThreshold() {
+  static std::atomic<size_t> threshold{RadixThresholdFromEnv()};
+  return threshold;
+}
+
+size_t RadixOf(uint64_t hash, int shift, uint64_t mask) {
+  return static_cast<size_t>((hash >> shift) & mask);
+}
+
+// Adds the histogram of in[begin, end) for the radix at `shift` to `counts`.
+void CountRange(const RadixTuple* in, size_t begin, size_t end, int shift,
+                int bits, size_t* counts) {
+  const uint64_t mask = (uint64_t{1} << bits) - 1;
+  for (size_t i = begin; i < end; ++i) {
+    ++counts[RadixOf(in[i].hash, shift, mask)];
+  }
+}
+
+// Scatters in[begin, end) to `out`, writing partition p from cursors[p] on
+// and advancing the cursors.
+void ScatterRange(const RadixTuple* in, size_t begin, size_t end, int shift,
+                  int bits, size_t* cursors, RadixTuple* out,
+                  PassScratch* scratch) {
+  const size_t fanout = size_t{1} << bits;
+  const uint64_t mask = fanout - 1;
+  scratch->lines.resize(fanout);
+  scratch->fill.assign(fanout, 0);
+  WriteCombiningLine* lines = scratch->lines.data();
+  uint8_t* fill = scratch->fill.data();
+  for (size_t i = begin; i < end; ++i) {
+    const size_t partition = RadixOf(in[i].hash, shift, mask);
+    lines[partition].tuples[fill[partition]++] = in[i];
+    if (fill[partition] == kLineTuples) {
+      std::memcpy(out + cursors[partition], lines[partition].tuples,
+                  sizeof(WriteCombiningLine));
+      cursors[partition] += kLineTuples;
+      fill[partition] = 0;
+    }
+  }
+  for (size_t partition = 0; partition < fanout; ++partition) {
+    std::memcpy(out + cursors[partition], lines[partition].tuples,
+                fill[partition] * sizeof(RadixTuple));
+    cursors[partition] += fill[partition];
+  }
+}
+
+// First pass: in[0, count) is cut into one chunk per worker, every chunk
+// counts its radixes, and the prefix sums give each (chunk, partition) pair
+// its own stretch of `out`, so chunks scatter without synchronization and
+// the result stays stable.
+std::vector<size_t> FirstPass(const RadixTuple* in, size_t count,
+                              RadixTuple* out, int shift, int bits,
+                              size_t workers) {
+  const size_t fanout = size_t{1} << bits;
+  const size_t chunk_rows =
+      std::max(kJoinMorselRows, (count + workers - 1) / workers);
+  const size_t chunks = (count + chunk_rows - 1) / chunk_rows;
+  std::vector<std::vector<size_t>> cursors(chunks,
+                                           std::vector<size_t>(fanout));
+  RunMorsels(count, chunk_rows, workers, [&](size_t, size_t begin, size_t end) {
+    CountRange(in, begin, end, shift, bits, cursors[begin / chunk_rows].data());
+  });
+  std::vector<size_t> bounds(fanout + 1);
+  size_t offset = 0;
+  for (size_t partition = 0; partition < fanout; ++partition) {
+    bounds[partition] = offset;
+    for (std::vector<size_t>& chunk : cursors) {
+      const size_t rows = chunk[partition];
+      chunk[partition] = offset;
+      offset += rows;
+    }
+  }
+  bounds[fanout] = offset;
+  RunMorsels(count, chunk_rows, workers, [&](size_t, size_t begin, size_t end) {
+    PassScratch scratch;
+    ScatterRange(in, begin, end, shift, bits,
+                 cursors[begin / chunk_rows].data(), out, &scratch);
+  });
+  return bounds;
+}
+
+// Later passes: every partition of the previous pass is split on the next
+// radix by a single worker.
+std::vector<size_t> NextPass(const RadixTuple* in,
+                             const std::vector<size_t>& previous,
+                             RadixTuple* out, int shift, int bits,
+                             size_t workers) {
+  const size_t fanout = size_t{1} << bits;
+  const size_t ranges = previous.size() - 1;
+  std::vector<size_t> bounds(ranges * fanout + 1);
+  bounds.back() = previous.back();
+  RunMorsels(ranges, std::max<size_t>(1, ranges / (workers * 4)), workers,
+             [&](size_t, size_t first, size_t last) {
+               PassScratch scratch;
+               std::vector<size_t> cursors(fanout);
+               for (size_t range = first; range < last; ++range) {
+                 std::fill(cursors.begin(), cursors.end(), 0);
+                 CountRange(in, previous[range], previous[range + 1], shift,
+                            bits, cursors.data());
+                 size_t offset = previous[range];
+                 for (size_t partition = 0; partition < fanout; ++partition) {
+                   const size_t rows = cursors[partition];
+                   bounds[range * fanout + partition] = offset;
+                   cursors[partition] = offset;
+                   offset += rows;
+                 }
+                 ScatterRange(in, previous[range], previous[range + 1], shift,
+                              bits, cursors.data(), out, &scratch);
+               }
+             });
+  return bounds;
+}
+
+}  // namespace
+
+size_t RadixPartitionBytes() {
+  static const size_t bytes = CacheSize(_SC_LEVEL2_CACHE_SIZE, 256 << 10);
+  return bytes;
+}
+
+size_t RadixJoinThresholdBytes() {
+  return RadixThreshold().load(std::memory_order_relaxed);
+}
+
+void SetRadixJoinThresholdForTest(size_t bytes) {
+  RadixThreshold().store(bytes, std::memory_order_relaxed);
+}
+
+std::vector<int> RadixPassBits(size_t build_tuples, size_t partition_bytes) {
+  // A table keeps its load factor at or below 1/2.
+  const size_t table_bytes = build_tuples * 2 * sizeof(RadixTuple);
+  partition_bytes = std::max<size_t>(1, partition_bytes);
+  const size_t partitions = std::bit_ceil(std::max<size_t>(
+      1, (table_bytes + partition_bytes - 1) / partition_bytes));
+  const int bits = std::countr_zero(partitions);
+  if (bits == 0) return {};
+  const int passes = (bits + kMaxRadixBitsPerPass - 1) / kMaxRadixBitsPerPass;
+  std::vector<int> pass_bits(passes, bits / passes);
+  for (int i = 0; i < bits % passes; ++i) ++pass_bits[i];
+  return pass_bits;
+}
+
+std::vector<size_t> RadixPartition(std::vector<RadixTuple>* tuples,
+                                   const std::vector<int>& pass_bits,
+                                   size_t workers) {
+  if (pass_bits.empty()) return {0, tuples->size()};
+  std::vector<RadixTuple> scratch(tuples->size());
+  RadixTuple* in = tuples->data();
+  RadixTuple* out = scratch.data();
+  std::vector<size_t> bounds;
+  int consumed = 0;
+  for (const int bits : pass_bits) {
+    consumed += bits;
+    const int shift = 64 - consumed;
+    bounds = bounds.empty()
+                 ? FirstPass(in, tuples->size(), out, shift, bits, workers)
+                 : NextPass(in, bounds, out, shift, bits, workers);
+    std::swap(in, out);
+  }
+  if (in != tuples->data()) tuples->swap(scratch);
+  return bounds;
+}
+
+void RadixTable::Build(std::span<const RadixTuple> tuples) {
+  const size_t capacity =
+      std::bit_ceil(std::max<size_t>(2, tuples.size() * 2));
+  slots_.assign(capacity, RadixTuple{0, kEmpty});
+  mask_ = capacity - 1;
+  for (const RadixTuple& tuple : tuples) {
+    size_t slot = tuple.hash & mask_;
+    while (slots_[slot].index != kEmpty) slot = (slot + 1) & mask_;
+    slots_[slot] = tuple;
+  }
+}
+
+}  // namespace tinylamb
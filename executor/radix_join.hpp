@@ -0,0 +1,129 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_RADIX_JOIN_HPP
+#define TINYLAMB_EXECUTOR_RADIX_JOIN_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "executor/flat_hash_table.hpp"
+#include "executor/join_hash_table.hpp"
+
+namespace tinylamb {
+
+// One join input entry as the radix join moves it around: the FlatHash of its
+// join key and its index in the caller's input. Partitioning copies only
+// these 16-byte tuples, never rows.
+struct RadixTuple {
+  uint64_t hash;
+  uint64_t index;
+};
+
+// Fan-out of one partitioning pass. 2^10 write-combining lines take 64 KiB,
+// which together with the pass's output pages stays within L1/L2 and TLB
+// reach; wider splits take another pass instead.
+inline constexpr int kMaxRadixBitsPerPass = 10;
+
+// Per-core cache a build partition's table is sized to (L2 as reported by
+// the OS, 256 KiB when unknown).
+[[nodiscard]] size_t RadixPartitionBytes();
+
+// Radix bits per partitioning pass so the table of an average build partition
+// fits in `partition_bytes`; empty when the whole build already fits.
+[[nodiscard]] std::vector<int> RadixPassBits(size_t build_tuples,
+                                             size_t partition_bytes);
+
+// Reorders `tuples` by the top sum(pass_bits) bits of their hash, one pass
+// per entry of `pass_bits`, and returns the partition boundaries (partition
+// p is [bounds[p], bounds[p + 1])). Partitioning is stable. The first pass
+// splits the input across `workers` threads; later passes hand whole
+// partitions of the previous pass to workers.
+std::vector<size_t> RadixPartition(std::vector<RadixTuple>* tuples,
+                                   const std::vector<int>& pass_bits,
+                                   size_t workers);
+
+// Linear-probing hash table over one build partition. Slots hold the tuples
+// themselves, so a probe touches one cache line in the common case. Buckets
+// come from the low hash bits; partitions were cut on the high ones.
+class RadixTable {
+ public:
+  void Build(std::span<const RadixTuple> tuples);
+
+  // Calls fn(build_index) for every build tuple whose hash equals `hash`.
+  template <typename Fn>
+  void ForEachMatch(uint64_t hash, Fn&& fn) const {
+    for (size_t slot = hash & mask_; slots_[slot].index != kEmpty;
+         slot = (slot + 1) & mask_) {
+      if (slots_[slot].hash == hash) fn(slots_[slot].index);
+    }
+  }
+
+ private:
+  static constexpr uint64_t kEmpty = ~uint64_t{0};
+
+  std::vector<RadixTuple> slots_;
+  size_t mask_{0};
+};
+
+// Partitions of a radix join joined per wave: enough waves that only a slice
+// of the join output is buffered at once.
+inline constexpr size_t kRadixJoinWaves = 8;
+
+// Radix-partitioned hash join of `build` and `probe` tuples. Both sides are
+// partitioned with the same `pass_bits`; every build partition then gets a
+// cache-resident RadixTable that its probe partition runs against.
+// on_match(slot, probe_index, build_index) is called for each pair of equal
+// hashes (callers compare the actual keys). Partitions are joined in waves:
+// each of up to `workers` threads takes a contiguous slice of partitions and
+// reports matches under its own slot, and on_wave() runs on the calling
+// thread after every wave, so draining per-slot buffers there in slot order
+// yields a deterministic output order.
+template <typename OnMatch, typename OnWave>
+void RadixHashJoin(std::vector<RadixTuple> build,
+                   std::vector<RadixTuple> probe,
+                   const std::vector<int>& pass_bits, size_t workers,
+                   const OnMatch& on_match, const OnWave& on_wave) {
+  if (build.empty() || probe.empty()) return;
+  workers = std::max<size_t>(1, workers);
+  const std::vector<size_t> build_bounds =
+      RadixPartition(&build, pass_bits, workers);
+  const std::vector<size_t> probe_bounds =
+      RadixPartition(&probe, pass_bits, workers);
+  const size_t partitions = build_bounds.size() - 1;
+  workers = std::min(workers, partitions);
+  const size_t slice =
+      std::max<size_t>(1, partitions / (workers * kRadixJoinWaves));
+  for (size_t wave = 0; wave < partitions; wave += slice * workers) {
+    const size_t wave_end = std::min(partitions, wave + slice * workers);
+    RunMorsels(wave_end - wave, slice, workers,
+               [&](size_t, size_t begin, size_t end) {
+                 const size_t slot = begin / slice;
+                 RadixTable table;
+                 for (size_t p = wave + begin; p < wave + end; ++p) {
+                   const std::span<const RadixTuple> build_part(
+                       build.data() + build_bounds[p],
+                       build_bounds[p + 1] - build_bounds[p]);
+                   if (build_part.empty() ||
+                       probe_bounds[p] == probe_bounds[p + 1]) {
+                     continue;
+                   }
+                   table.Build(build_part);
+                   for (size_t i = probe_bounds[p]; i < probe_bounds[p + 1];
+                        ++i) {
+                     const RadixTuple& tuple = probe[i];
+                     table.ForEachMatch(tuple.hash, [&](uint64_t build_index) {
+                       on_match(slot, tuple.index, build_index);
+                     });
+                   }
+                 }
+               });
+    on_wave();
+  }
+}
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_RADIX_JOIN_HPP
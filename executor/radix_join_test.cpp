@@ -0,0 +1,127 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/radix_join.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "executor/hash_join_mode.hpp"
+#include "executor/query_memory.hpp"
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+std::vector<RadixTuple> Tuples(const std::vector<int64_t>& keys) {
+  std::vector<RadixTuple> tuples;
+  tuples.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    tuples.push_back({FlatHash(keys[i]), i});
+  }
+  return tuples;
+}
+
+}  // namespace
+
+TEST(RadixJoinTest, PassBitsSplitAcrossPasses) {
+  EXPECT_TRUE(RadixPassBits(100, 1 << 20).empty());
+  // 2^20 tuples * 32 table bytes / 2^16 bytes = 2^9 partitions: one pass.
+  EXPECT_EQ(RadixPassBits(1 << 20, 1 << 16), std::vector<int>({9}));
+  // Wider fan-outs are split as evenly as possible over several passes.
+  EXPECT_EQ(RadixPassBits(1 << 20, 1 << 12), std::vector<int>({7, 6}));
+  EXPECT_EQ(RadixPassBits(1 << 25, 1 << 10), std::vector<int>({10, 10}));
+  EXPECT_EQ(RadixPassBits(1 << 25, 1 << 9), std::vector<int>({7, 7, 7}));
+}
+
+TEST(RadixJoinTest, PartitionIsStableAndGroupsHighBits) {
+  std::vector<int64_t> keys(50000);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    keys[i] = static_cast<int64_t>(i % 997);
+  }
+  std::vector<RadixTuple> tuples = Tuples(keys);
+  const std::vector<int> pass_bits = {3, 4};
+  const std::vector<size_t> bounds = RadixPartition(&tuples, pass_bits, 3);
+  ASSERT_EQ(bounds.size(), (1U << 7) + 1);
+  EXPECT_EQ(bounds.front(), 0U);
+  EXPECT_EQ(bounds.back(), keys.size());
+  std::vector<bool> seen(keys.size());
+  for (size_t p = 0; p + 1 < bounds.size(); ++p) {
+    for (size_t i = bounds[p]; i < bounds[p + 1]; ++i) {
+      EXPECT_EQ(tuples[i].hash >> 57, p);
+      if (i > bounds[p]) {
+        EXPECT_LT(tuples[i - 1].index, tuples[i].index);
+      }
+      seen[tuples[i].index] = true;
+    }
+  }
+  EXPECT_TRUE(std::all_of(seen.begin(), seen.end(), [](bool s) { return s; }));
+}
+
+TEST(RadixJoinTest, TableFindsDuplicates) {
+  const std::vector<RadixTuple> tuples = Tuples({5, 7, 5, 9, 5});
+  RadixTable table;
+  table.Build(tuples);
+  std::vector<uint64_t> matches;
+  table.ForEachMatch(FlatHash(int64_t{5}),
+                     [&](uint64_t index) { matches.push_back(index); });
+  std::sort(matches.begin(), matches.end());
+  EXPECT_EQ(matches, std::vector<uint64_t>({0, 2, 4}));
+  size_t misses = 0;
+  table.ForEachMatch(FlatHash(int64_t{6}), [&](uint64_t) { ++misses; });
+  EXPECT_EQ(misses, 0U);
+}
+
+TEST(RadixJoinTest, JoinMatchesNestedLoopCounts) {
+  std::vector<int64_t> build_keys(20000);
+  std::vector<int64_t> probe_keys(30000);
+  for (size_t i = 0; i < build_keys.size(); ++i) {
+    build_keys[i] = static_cast<int64_t>(i % 5000);
+  }
+  for (size_t i = 0; i < probe_keys.size(); ++i) {
+    probe_keys[i] = static_cast<int64_t>(i % 7000);
+  }
+  std::map<std::pair<uint64_t, uint64_t>, size_t> pairs;
+  std::vector<std::vector<std::pair<uint64_t, uint64_t>>> slots(4);
+  std::vector<std::pair<uint64_t, uint64_t>> output;
+  size_t waves = 0;
+  RadixHashJoin(
+      Tuples(build_keys), Tuples(probe_keys), {4, 3}, 4,
+      [&](size_t slot, uint64_t probe, uint64_t build) {
+        ASSERT_LT(slot, slots.size());
+        if (probe_keys[probe] == build_keys[build]) {
+          slots[slot].emplace_back(probe, build);
+        }
+      },
+      [&] {
+        ++waves;
+        for (auto& slot : slots) {
+          output.insert(output.end(), slot.begin(), slot.end());
+          slot.clear();
+        }
+      });
+  EXPECT_GT(waves, 1U);
+  // 22000 probe rows have a key below 5000 and match 4 build rows each.
+  EXPECT_EQ(output.size(), 22000U * 4);
+  for (const auto& [probe, build] : output) {
+    EXPECT_EQ(probe_keys[probe], build_keys[build]);
+    EXPECT_EQ(++pairs[std::make_pair(probe, build)], 1U);
+  }
+}
+
+TEST(RadixJoinTest, PreferRadixAboveThresholdWithinBudget) {
+  const size_t previous = RadixJoinThresholdBytes();
+  SetRadixJoinThresholdForTest(1 << 20);
+  EXPECT_FALSE(PreferRadixHashJoin(1 << 19));
+  EXPECT_TRUE(PreferRadixHashJoin(4 << 20));
+  QueryMemoryBudget::Global().ResetForTest(1 << 20);
+  EXPECT_FALSE(PreferRadixHashJoin(4 << 20));
+  QueryMemoryBudget::Global().ResetForTest(0);
+  SetRadixJoinThresholdForTest(0);
+  EXPECT_FALSE(PreferRadixHashJoin(size_t{1} << 40));
+  SetRadixJoinThresholdForTest(previous);
+  EXPECT_EQ(HashJoinModeName(HashJoinMode::kRadix), "RadixHashJoin");
+}
+
+}  // namespace tinylamb
@@ -10,12 +10,15 @@
 #include <deque>
 #include <functional>
 #include <iomanip>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <ostream>
+#include <ranges>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -34,10 +37,12 @@
 #include "expression/function_call_expression.hpp"
 #include "expression/in_expression.hpp"
 #include "expression/interval_expression.hpp"
+#include "expression/like_matcher.hpp"
 #include "expression/query_expression.hpp"
 #include "expression/rewrite.hpp"
 #include "expression/unary_expression.hpp"
 #include "parser/ast.hpp"
+#include "table/runtime_filter.hpp"
 #include "table/table.hpp"
 #include "table/table_statistics.hpp"
 #include "type/column.hpp"
@@ -45,9 +50,26 @@
 #include "type/schema.hpp"
 #include "type/value.hpp"
 #include "type/date.hpp"
+#include "executor/adaptive_join_order.hpp"
+#include "executor/aggregate_state.hpp"
+#include "executor/external_sort.hpp"
+#include "executor/sort_key.hpp"
 #include "executor/hash_join_mode.hpp"
+#include "executor/flat_hash_table.hpp"
+#include "executor/join_hash_table.hpp"
+#include "executor/join_pipeline.hpp"
+#include "executor/decorrelation.hpp"
+#include "executor/late_materialization.hpp"
+#include "executor/parallel_hash_aggregation.hpp"
+#include "executor/spillable_hash_aggregation.hpp"
+#include "executor/top_n_heap.hpp"
+#include "executor/result_sink.hpp"
+#include "executor/radix_join.hpp"
+#include "executor/semi_join.hpp"
 #include "executor/query_memory.hpp"
 #include "executor/spill_file.hpp"
+#include "executor/subquery_task.hpp"
+#include "executor/table_sample.hpp"
 
 namespace tinylamb {
 namespace {
@@ -58,12 +80,25 @@ struct ExecutionRuntime;
 thread_local ExecutionRuntime* active_runtime = nullptr;
 void NoteRelationSpill();
 
+// Operator account Relations charge in the current query, looked up once
+// per thread and context.
+std::shared_ptr<MemoryContext> RelationMemory() {
+  thread_local std::weak_ptr<MemoryContext> owner;
+  thread_local std::shared_ptr<MemoryContext> account;
+  MemoryContext& current = MemoryContext::Current();
+  if (!account || owner.lock().get() != &current) {
+    account = current.Child("relation");
+    owner = current.weak_from_this();
+  }
+  return account;
+}
+
 struct Relation {
   Schema schema;
   std::vector<Row> rows;
   std::shared_ptr<SpillFile> spill;
   std::shared_ptr<SpillFile> spill_tail_;
-  size_t charged_bytes_{0};
+  QueryMemoryCharge charge_{RelationMemory()};
   size_t hash_joins{0};
   size_t hybrid_hash_joins{0};
   size_t in_memory_hash_joins{0};
@@ -85,12 +120,7 @@ struct Relation {
         join_comparisons(other.join_comparisons),
         peak_intermediate_rows(other.peak_intermediate_rows),
         spilled_rows_(other.spilled_rows_) {
-    for (const Row& row : rows) {
-      charged_bytes_ += EstimateRowBytes(row);
-    }
-    if (charged_bytes_ != 0) {
-      QueryMemoryBudget::Global().ReserveForced(charged_bytes_);
-    }
+    ChargeRows();
   }
   Relation& operator=(const Relation& other) {
     if (this != &other) {
@@ -106,59 +136,24 @@ struct Relation {
       join_comparisons = other.join_comparisons;
       peak_intermediate_rows = other.peak_intermediate_rows;
       spilled_rows_ = other.spilled_rows_;
-      charged_bytes_ = 0;
-      for (const Row& row : rows) {
-        charged_bytes_ += EstimateRowBytes(row);
-      }
-      if (charged_bytes_ != 0) {
-        QueryMemoryBudget::Global().ReserveForced(charged_bytes_);
-      }
-    }
-    return *this;
-  }
-  Relation(Relation&& other) noexcept
-      : schema(std::move(other.schema)),
-        rows(std::move(other.rows)),
-        spill(std::move(other.spill)),
-        spill_tail_(std::move(other.spill_tail_)),
-        charged_bytes_(other.charged_bytes_),
-        hash_joins(other.hash_joins),
-        hybrid_hash_joins(other.hybrid_hash_joins),
-        in_memory_hash_joins(other.in_memory_hash_joins),
-        nested_loop_joins(other.nested_loop_joins),
-        join_comparisons(other.join_comparisons),
-        peak_intermediate_rows(other.peak_intermediate_rows),
-        spilled_rows_(other.spilled_rows_) {
-    other.charged_bytes_ = 0;
-  }
-  Relation& operator=(Relation&& other) noexcept {
-    if (this != &other) {
-      ReleaseCharge();
-      schema = std::move(other.schema);
-      rows = std::move(other.rows);
-      spill = std::move(other.spill);
-      spill_tail_ = std::move(other.spill_tail_);
-      charged_bytes_ = other.charged_bytes_;
-      other.charged_bytes_ = 0;
-      hash_joins = other.hash_joins;
-      hybrid_hash_joins = other.hybrid_hash_joins;
-      in_memory_hash_joins = other.in_memory_hash_joins;
-      nested_loop_joins = other.nested_loop_joins;
-      join_comparisons = other.join_comparisons;
-      peak_intermediate_rows = other.peak_intermediate_rows;
-      spilled_rows_ = other.spilled_rows_;
+      ChargeRows();
     }
     return *this;
   }
-  ~Relation() { ReleaseCharge(); }
+  Relation(Relation&& other) noexcept = default;
+  Relation& operator=(Relation&& other) noexcept = default;
+  ~Relation() = default;
 
-  void ReleaseCharge() {
-    if (charged_bytes_ != 0) {
-      QueryMemoryBudget::Global().Release(charged_bytes_);
-      charged_bytes_ = 0;
+  void ChargeRows() {
+    size_t bytes = 0;
+    for (const Row& row : rows) {
+      bytes += EstimateRowBytes(row);
     }
+    charge_.Add(bytes);
   }
 
+  void ReleaseCharge() { charge_.ReleaseAll(); }
+
   void EnsureSpill() {
     if (spill) {
       return;
@@ -177,7 +172,7 @@ struct Relation {
 
   void AddRow(Row row) {
     const size_t bytes = EstimateRowBytes(row);
-    if (spill_tail_ || !QueryMemoryBudget::Global().CanReserve(bytes)) {
+    if (spill_tail_ || !charge_.Context().CanReserve(bytes)) {
       if (!spill_tail_) {
         EnsureSpill();
       }
@@ -187,8 +182,7 @@ struct Relation {
       ++spilled_rows_;
       return;
     }
-    QueryMemoryBudget::Global().ReserveForced(bytes);
-    charged_bytes_ += bytes;
+    charge_.Add(bytes);
     rows.push_back(std::move(row));
     peak_intermediate_rows = std::max(peak_intermediate_rows, rows.size());
   }
@@ -232,9 +226,24 @@ struct Scope {
 
 using CteMap = std::unordered_map<std::string, Relation>;
 
+// Push-based consumer of one row at a time. Operators feeding a RowSink never
+// materialize their output; only pipeline breakers hold rows.
+using RowSink = std::function<void(Row&&)>;
+
+// An expression whose column references were resolved once, before a row
+// loop, against the scope chain the loop evaluates it over. A bound
+// ColumnValue reads `slot` of the row `depth` scopes out; `children` follow
+// the order in which Evaluate() visits the expression's children.
+struct BoundExpression {
+  static constexpr uint8_t kUnbound = UINT8_MAX;
+  uint8_t depth{kUnbound};
+  slot_t slot{0};
+  std::vector<BoundExpression> children;
+};
+
 struct CorrelatedIndex {
   Schema schema;
-  std::unordered_multimap<std::string, Row> rows;
+  FlatMultiMap<std::string_view, Row> rows;
   std::vector<slot_t> local_columns;
   std::vector<ColumnName> outer_columns;
   std::vector<ColumnName> cache_outer_columns;
@@ -242,6 +251,45 @@ struct CorrelatedIndex {
   bool preaggregated{false};
 };
 
+// Values of an uncorrelated IN subquery. Plain integers, the common case,
+// get their own table; other values are keyed by their AppendFlatKey
+// encoding, which keeps Value::operator== semantics (a DATE never equals an
+// INT64 with the same payload). NULLs are only remembered, for NOT IN.
+class MembershipSet {
+ public:
+  void Reserve(size_t values) { integers_.Reserve(values); }
+  void Insert(const Value& value) {
+    if (value.IsNull()) {
+      has_null_ = true;
+      return;
+    }
+    if (value.type == ValueType::kInt64) {
+      integers_.Insert(value.value.int_value);
+      return;
+    }
+    std::string key;
+    AppendFlatKey(value, &key);
+    others_.Insert(key);
+  }
+  [[nodiscard]] bool Contains(const Value& value) const {
+    if (value.type == ValueType::kInt64) {
+      return integers_.Contains(value.value.int_value);
+    }
+    if (others_.Empty()) return false;
+    std::string key;
+    AppendFlatKey(value, &key);
+    return others_.Contains(key);
+  }
+  [[nodiscard]] bool HasNull() const { return has_null_; }
+
+ private:
+  FlatHashSet<int64_t> integers_;
+  FlatHashSet<std::string_view> others_;
+  bool has_null_{false};
+};
+
+struct PendingSubquery;
+
 struct ExecutionRuntime {
   std::unordered_map<std::string, Relation> base_relations;
   std::unordered_set<std::string> reusable_base_relations;
@@ -257,7 +305,7 @@ struct ExecutionRuntime {
       correlated_indexes;
   std::unordered_set<const SelectStatement*> unindexable_queries;
   std::unordered_map<const SelectStatement*, Relation> uncorrelated_results;
-  std::unordered_map<const SelectStatement*, std::unordered_set<Value>>
+  std::unordered_map<const SelectStatement*, MembershipSet>
       uncorrelated_membership;
   std::unordered_set<const SelectStatement*> noncacheable_queries;
   size_t correlated_index_builds{0};
@@ -283,14 +331,133 @@ struct ExecutionRuntime {
   size_t key_filter_scans{0};
   size_t key_filter_keys{0};
   size_t key_filter_rejected{0};
+  // Base-table scans given a Bloom and min/max RuntimeFilter by a join, the
+  // keys the filters were built from, and the probe rows they dropped.
+  size_t runtime_filter_scans{0};
+  size_t runtime_filter_keys{0};
+  size_t runtime_filter_rejected{0};
+  // Joined rows whose payload columns were fetched after the join, and the
+  // Table::Read calls that fetched them.
+  size_t late_materialized_rows{0};
+  size_t late_fetched_rows{0};
+  // Semi joins and (NULL-aware) anti joins run by FilterJoin.
+  size_t semi_joins{0};
+  size_t anti_joins{0};
+  // Joins re-planned because a materialized row count missed its estimate,
+  // joins that built on the intermediate instead, and one line per event.
+  size_t adaptive_replans{0};
+  size_t adaptive_build_swaps{0};
+  std::vector<std::string> adaptive_events;
+  // ColumnValue references resolved by Bind() before a row loop.
+  size_t column_binds{0};
+  // Rows the final join pushed straight into the query pipeline.
+  size_t pipelined_rows{0};
+  // In-memory joins whose build and probe ran on several threads.
+  size_t parallel_hash_joins{0};
+  // In-memory joins radix partitioned because the build outgrew the cache.
+  size_t radix_hash_joins{0};
+  // Aggregations run by ParallelHashAggregation, and the input rows of those
+  // that skipped thread-local pre-aggregation.
+  size_t parallel_aggregations{0};
+  size_t preaggregation_passed_rows{0};
+  // Partial groups GROUP BY wrote to spill partitions, the partitions it
+  // merged back, and the deepest level it had to split partitions to.
+  size_t aggregate_spilled_groups{0};
+  size_t aggregate_spill_partitions{0};
+  size_t aggregate_spill_depth{0};
+  // Sorted runs ORDER BY wrote, merge passes included, and the rows spilled
+  // to make them.
+  size_t sort_spilled_runs{0};
+  size_t sort_spilled_rows{0};
+  // ORDER BY ... LIMIT results kept in a TopNHeap instead of a full sort.
+  size_t top_n_sorts{0};
+  // Subqueries running as SubqueryTasks until their consumer takes the
+  // result, and how many ran that way.
+  std::unordered_map<const SelectStatement*, std::shared_ptr<PendingSubquery>>
+      pending_subqueries;
+  size_t concurrent_subqueries{0};
 };
 
+// Adds what a subquery's runtime counted to the runtime it ran under. The
+// subquery's uncorrelated results join the cache as well.
+void MergeRuntime(ExecutionRuntime&& from, ExecutionRuntime* into) {
+  for (auto& [statement, relation] : from.uncorrelated_results) {
+    into->uncorrelated_results.try_emplace(statement, std::move(relation));
+  }
+  into->correlated_index_builds += from.correlated_index_builds;
+  into->correlated_index_probes += from.correlated_index_probes;
+  into->correlated_result_cache_hits += from.correlated_result_cache_hits;
+  into->uncorrelated_cache_hits += from.uncorrelated_cache_hits;
+  into->uncorrelated_hash_builds += from.uncorrelated_hash_builds;
+  into->uncorrelated_hash_probes += from.uncorrelated_hash_probes;
+  into->scan_ms += from.scan_ms;
+  into->filter_ms += from.filter_ms;
+  into->join_ms += from.join_ms;
+  into->project_ms += from.project_ms;
+  into->sort_ms += from.sort_ms;
+  into->base_scan_cache_hits += from.base_scan_cache_hits;
+  into->aggregate_input_rows += from.aggregate_input_rows;
+  into->aggregate_groups += from.aggregate_groups;
+  into->aggregate_updates += from.aggregate_updates;
+  into->scan_rows += from.scan_rows;
+  into->scan_output_rows += from.scan_output_rows;
+  into->scan_values_decoded += from.scan_values_decoded;
+  into->scan_values_available += from.scan_values_available;
+  into->relation_spills += from.relation_spills;
+  into->key_filter_scans += from.key_filter_scans;
+  into->key_filter_keys += from.key_filter_keys;
+  into->key_filter_rejected += from.key_filter_rejected;
+  into->runtime_filter_scans += from.runtime_filter_scans;
+  into->runtime_filter_keys += from.runtime_filter_keys;
+  into->runtime_filter_rejected += from.runtime_filter_rejected;
+  into->late_materialized_rows += from.late_materialized_rows;
+  into->late_fetched_rows += from.late_fetched_rows;
+  into->semi_joins += from.semi_joins;
+  into->anti_joins += from.anti_joins;
+  into->adaptive_replans += from.adaptive_replans;
+  into->adaptive_build_swaps += from.adaptive_build_swaps;
+  std::ranges::move(from.adaptive_events,
+                    std::back_inserter(into->adaptive_events));
+  into->column_binds += from.column_binds;
+  into->pipelined_rows += from.pipelined_rows;
+  into->parallel_hash_joins += from.parallel_hash_joins;
+  into->radix_hash_joins += from.radix_hash_joins;
+  into->parallel_aggregations += from.parallel_aggregations;
+  into->preaggregation_passed_rows += from.preaggregation_passed_rows;
+  into->aggregate_spilled_groups += from.aggregate_spilled_groups;
+  into->aggregate_spill_partitions += from.aggregate_spill_partitions;
+  into->aggregate_spill_depth =
+      std::max(into->aggregate_spill_depth, from.aggregate_spill_depth);
+  into->sort_spilled_runs += from.sort_spilled_runs;
+  into->sort_spilled_rows += from.sort_spilled_rows;
+  into->top_n_sorts += from.top_n_sorts;
+  into->concurrent_subqueries += from.concurrent_subqueries;
+}
+
 void NoteRelationSpill() {
   if (active_runtime) {
     ++active_runtime->relation_spills;
   }
 }
 
+// Adds the spill counters of a finished `aggregation` to the runtime.
+void NoteAggregateSpills(const SpillableHashAggregation& aggregation) {
+  if (!active_runtime || aggregation.SpilledGroups() == 0) return;
+  NoteRelationSpill();
+  active_runtime->aggregate_spilled_groups += aggregation.SpilledGroups();
+  active_runtime->aggregate_spill_partitions += aggregation.SpillPartitions();
+  active_runtime->aggregate_spill_depth =
+      std::max(active_runtime->aggregate_spill_depth, aggregation.SpillDepth());
+}
+
+// Adds the spill counters of a finished ORDER BY `sort` to the runtime.
+void NoteSortSpills(const ExternalSort& sort) {
+  if (!active_runtime || sort.SpilledRuns() == 0) return;
+  NoteRelationSpill();
+  active_runtime->sort_spilled_runs += sort.SpilledRuns();
+  active_runtime->sort_spilled_rows += sort.SpilledRows();
+}
+
 double ElapsedMs(std::chrono::steady_clock::time_point begin) {
   return std::chrono::duration<double, std::milli>(
              std::chrono::steady_clock::now() - begin)
@@ -354,6 +521,7 @@ std::optional<Relation> ExecuteCorrelatedSingleSource(
 const Relation* ExecuteCachedUncorrelated(TransactionContext& context,
                                           const SelectStatement& statement,
                                           const CteMap& ctes);
+std::optional<Relation> TakeSubquery(const SelectStatement& statement);
 bool ExpressionUsesOnlyScopes(TransactionContext& context,
                               const Expression& expression,
                               const std::vector<Relation>& sources,
@@ -429,55 +597,96 @@ Value Lookup(const ColumnName& name, const Scope& scope) {
   throw std::runtime_error("column " + name.ToString() + " not found");
 }
 
-bool Like(std::string_view value, std::string_view pattern) {
-  // Fast paths for the common TPC-H shapes: 'foo%', '%foo', '%foo%'.
-  if (pattern == "%") return true;
-  if (pattern.empty()) return value.empty();
-  const bool leading = pattern.front() == '%';
-  const bool trailing = pattern.back() == '%';
-  if (leading || trailing) {
-    std::string_view core = pattern;
-    if (leading) core.remove_prefix(1);
-    if (trailing && !core.empty()) core.remove_suffix(1);
-    if (core.find('%') == std::string_view::npos &&
-        core.find('_') == std::string_view::npos) {
-      if (leading && trailing) {
-        return value.find(core) != std::string_view::npos;
-      }
-      if (trailing) {
-        return value.size() >= core.size() && value.substr(0, core.size()) == core;
-      }
-      if (leading) {
-        return value.size() >= core.size() &&
-               value.substr(value.size() - core.size()) == core;
-      }
-    }
-  }
-
-  size_t value_pos = 0;
-  size_t pattern_pos = 0;
-  size_t wildcard = std::string_view::npos;
-  size_t retry = 0;
-  while (value_pos < value.size()) {
-    if (pattern_pos < pattern.size() &&
-        (pattern[pattern_pos] == '_' ||
-         pattern[pattern_pos] == value[value_pos])) {
-      ++value_pos;
-      ++pattern_pos;
-    } else if (pattern_pos < pattern.size() && pattern[pattern_pos] == '%') {
-      wildcard = pattern_pos++;
-      retry = value_pos;
-    } else if (wildcard != std::string_view::npos) {
-      pattern_pos = wildcard + 1;
-      value_pos = ++retry;
-    } else {
-      return false;
+// Resolves the column references of `expression` for rows of `schema`
+// evaluated under `outer`, so Evaluate() loads each one by slot instead of
+// searching every scope by name. A reference that is missing or ambiguous
+// stays unbound and raises Lookup()'s error on the first row evaluated.
+// Subqueries are left alone; they bind their own row loops.
+BoundExpression Bind(const Expression& expression, const Schema& schema,
+                     const Scope* outer) {
+  BoundExpression bound;
+  if (!expression) return bound;
+  const auto bind_child = [&](const Expression& child) {
+    bound.children.push_back(Bind(child, schema, outer));
+  };
+  switch (expression->Type()) {
+    case TypeTag::kColumnValue: {
+      const ColumnName& name = expression->AsColumnValue().GetColumnName();
+      if (name.name == "*") break;
+      const Schema* current = &schema;
+      const Scope* next = outer;
+      for (uint8_t depth = 0; depth < BoundExpression::kUnbound; ++depth) {
+        if (current != nullptr) {
+          int offset = -1;
+          try {
+            offset = FindColumn(*current, name);
+          } catch (const std::runtime_error&) {
+            break;
+          }
+          if (offset >= 0) {
+            bound.depth = depth;
+            bound.slot = static_cast<slot_t>(offset);
+            if (active_runtime) ++active_runtime->column_binds;
+            break;
+          }
+        }
+        if (next == nullptr) break;
+        current = next->row ? next->schema : nullptr;
+        next = next->outer;
+      }
+      break;
+    }
+    case TypeTag::kBinaryExp: {
+      const auto& value = expression->AsBinaryExpression();
+      bind_child(value.Left());
+      bind_child(value.Right());
+      break;
     }
+    case TypeTag::kUnaryExp:
+      bind_child(expression->AsUnaryExpression().Child());
+      break;
+    case TypeTag::kCaseExp: {
+      const auto& value = expression->AsCaseExpression();
+      for (const auto& [condition, result] : value.when_clauses_) {
+        bind_child(condition);
+        bind_child(result);
+      }
+      bind_child(value.else_clause_);
+      break;
+    }
+    case TypeTag::kInExp: {
+      const auto& value = expression->AsInExpression();
+      bind_child(value.child_);
+      for (const Expression& item : value.list_) bind_child(item);
+      break;
+    }
+    case TypeTag::kFunctionCallExp:
+      for (const Expression& argument :
+           expression->AsFunctionCallExpression().Args()) {
+        bind_child(argument);
+      }
+      break;
+    case TypeTag::kQueryExp:
+      bind_child(expression->AsQueryExpression().Test());
+      break;
+    default:
+      break;
   }
-  while (pattern_pos < pattern.size() && pattern[pattern_pos] == '%') {
-    ++pattern_pos;
+  return bound;
+}
+
+std::vector<BoundExpression> Bind(const std::vector<Expression>& expressions,
+                                  const Schema& schema, const Scope* outer) {
+  std::vector<BoundExpression> bound;
+  bound.reserve(expressions.size());
+  for (const Expression& expression : expressions) {
+    bound.push_back(Bind(expression, schema, outer));
   }
-  return pattern_pos == pattern.size();
+  return bound;
+}
+
+const BoundExpression* BoundChild(const BoundExpression* bound, size_t i) {
+  return bound == nullptr ? nullptr : &bound->children[i];
 }
 
 Value Binary(BinaryOperation operation, const Value& left, const Value& right) {
@@ -496,8 +705,8 @@ Value Binary(BinaryOperation operation, const Value& left, const Value& right) {
     if (left.type != ValueType::kVarChar || right.type != ValueType::kVarChar) {
       throw std::runtime_error("LIKE requires string operands");
     }
-    const bool matched =
-        Like(left.value.varchar_value, right.value.varchar_value);
+    const bool matched = LikeMatcher(right.value.varchar_value)
+                             .Matches(left.value.varchar_value);
     return Value(operation == BinaryOperation::kLike ? matched : !matched);
   }
 
@@ -566,42 +775,13 @@ Value Binary(BinaryOperation operation, const Value& left, const Value& right) {
   throw std::runtime_error("unsupported binary operation");
 }
 
-bool ContainsAggregate(const Expression& expression) {
-  if (!expression) return false;
-  switch (expression->Type()) {
-    case TypeTag::kAggregateExp:
-      return true;
-    case TypeTag::kBinaryExp:
-      return ContainsAggregate(expression->AsBinaryExpression().Left()) ||
-             ContainsAggregate(expression->AsBinaryExpression().Right());
-    case TypeTag::kUnaryExp:
-      return ContainsAggregate(expression->AsUnaryExpression().Child());
-    case TypeTag::kCaseExp: {
-      const auto& value = expression->AsCaseExpression();
-      for (const auto& [condition, result] : value.when_clauses_) {
-        if (ContainsAggregate(condition) || ContainsAggregate(result))
-          return true;
-      }
-      return ContainsAggregate(value.else_clause_);
-    }
-    case TypeTag::kFunctionCallExp:
-      for (const Expression& argument :
-           expression->AsFunctionCallExpression().Args()) {
-        if (ContainsAggregate(argument)) return true;
-      }
-      return false;
-    default:
-      return false;
-  }
-}
-
 using AggregateResultMap =
     std::unordered_map<const AggregateExpression*, Value>;
 
 Value Evaluate(const Expression& expression, const Scope& scope,
                const AggregateResultMap* aggregates,
-               TransactionContext& context,
-               const CteMap& ctes);
+               TransactionContext& context, const CteMap& ctes,
+               const BoundExpression* bound = nullptr);
 
 Value Aggregate(const AggregateExpression& aggregate,
                 const AggregateResultMap& aggregates) {
@@ -627,91 +807,49 @@ void CollectAggregates(const Expression& expression,
   }
 }
 
-struct AggregateAccumulator {
+// AggregateState of one aggregate expression of the query.
+struct AggregateAccumulator : AggregateState {
   explicit AggregateAccumulator(const AggregateExpression* aggregate)
-      : expression(aggregate),
-        distinct(aggregate->Distinct()
-                     ? std::make_unique<std::unordered_set<Value>>()
-                     : nullptr) {}
-
-  void Add(const Value& value) {
-    if (value.IsNull()) return;
-    if (distinct) {
-      if (value.type == ValueType::kInt64 || value.type == ValueType::kDate) {
-        if (!distinct_ints) {
-          distinct_ints = std::make_unique<std::unordered_set<int64_t>>();
-          distinct_ints->reserve(distinct->size() + 8);
-          for (const Value& seen : *distinct) {
-            if (seen.type == ValueType::kInt64 || seen.type == ValueType::kDate) {
-              distinct_ints->insert(seen.value.int_value);
-            }
-          }
-          distinct.reset();
-        }
-        if (!distinct_ints->insert(value.value.int_value).second) return;
-      } else if (!distinct->insert(value).second) {
-        return;
-      }
-    }
-    switch (expression->GetType()) {
-      case AggregationType::kCount:
-        ++count;
-        break;
-      case AggregationType::kSum:
-      case AggregationType::kAvg:
-        total += Number(value);
-        total_is_double =
-            total_is_double || value.type == ValueType::kDouble;
-        ++count;
-        break;
-      case AggregationType::kMin:
-        if (extreme.IsNull() || value < extreme) extreme = value;
-        break;
-      case AggregationType::kMax:
-        if (extreme.IsNull() || extreme < value) extreme = value;
-        break;
-    }
-  }
-
-  Value Finish() const {
-    switch (expression->GetType()) {
-      case AggregationType::kCount:
-        return Value(count);
-      case AggregationType::kAvg:
-        return count == 0
-                   ? Value()
-                   : Value(total / static_cast<double>(count));
-      case AggregationType::kSum:
-        if (count == 0) return Value();
-        return total_is_double ? Value(total)
-                               : Value(static_cast<int64_t>(total));
-      case AggregationType::kMin:
-      case AggregationType::kMax:
-        return extreme;
-    }
-    return Value();
-  }
+      : AggregateState(aggregate->GetType(), aggregate->Distinct()),
+        expression(aggregate) {}
 
   const AggregateExpression* expression;
-  int64_t count = 0;
-  double total = 0.0;
-  bool total_is_double = false;
-  Value extreme;
-  std::unique_ptr<std::unordered_set<Value>> distinct;
-  std::unique_ptr<std::unordered_set<int64_t>> distinct_ints;
 };
 
+// Aggregate expressions of the SELECT list and HAVING clause, each once.
+std::vector<const AggregateExpression*> StatementAggregates(
+    const SelectStatement& statement) {
+  std::vector<const AggregateExpression*> aggregates;
+  std::unordered_set<const AggregateExpression*> seen;
+  for (const NamedExpression& projection : statement.SelectList()) {
+    CollectAggregates(projection.expression, &aggregates, &seen);
+  }
+  CollectAggregates(statement.Having(), &aggregates, &seen);
+  return aggregates;
+}
+
+std::vector<AggregateSpec> AggregateSpecs(
+    const std::vector<const AggregateExpression*>& aggregates) {
+  std::vector<AggregateSpec> specs;
+  specs.reserve(aggregates.size());
+  for (const AggregateExpression* aggregate : aggregates) {
+    specs.push_back({aggregate->GetType(), aggregate->Distinct()});
+  }
+  return specs;
+}
+
 Value EvaluateFunction(const FunctionCallExpression& call, const Scope& scope,
                        const AggregateResultMap* aggregates,
-                       TransactionContext& context, const CteMap& ctes) {
+                       TransactionContext& context, const CteMap& ctes,
+                       const BoundExpression* bound) {
   const std::string& name = call.FuncName();
   if (name == "date_add" || name == "date_sub") {
     if (call.Args().size() != 2 ||
         call.Args()[1]->Type() != TypeTag::kIntervalExp) {
       throw std::runtime_error("DATE_ADD/DATE_SUB arity");
     }
-    const Value date =
-        Evaluate(call.Args()[0], scope, aggregates, context, ctes);
+    const Value date = Evaluate(call.Args()[0], scope, aggregates, context,
+                                ctes, BoundChild(bound, 0));
     const auto& interval = call.Args()[1]->AsIntervalExpression();
     const int64_t amount = name == "date_sub" ? -interval.Amount()
                                                : interval.Amount();
@@ -724,9 +862,9 @@ Value EvaluateFunction(const FunctionCallExpression& call, const Scope& scope,
                : Value(FormatDateDays(result));
   }
   std::vector<Value> arguments;
-  for (const Expression& argument : call.Args()) {
-    arguments.push_back(
-        Evaluate(argument, scope, aggregates, context, ctes));
+  for (size_t i = 0; i < call.Args().size(); ++i) {
+    arguments.push_back(Evaluate(call.Args()[i], scope, aggregates, context,
+                                 ctes, BoundChild(bound, i)));
   }
   if (name == "substr" || name == "substring") {
     if (arguments.size() < 2 || arguments[0].IsNull()) return Value();
@@ -769,15 +907,33 @@ Value EvaluateFunction(const FunctionCallExpression& call, const Scope& scope,
     std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
     return Value(std::string(buffer));
   }
+  if (name == "sqrt") {
+    if (arguments.size() != 1) {
+      throw std::runtime_error("SQRT requires one argument");
+    }
+    if (arguments[0].IsNull()) return Value();
+    return Value(std::sqrt(Number(arguments[0])));
+  }
   throw std::runtime_error("unsupported function " + name);
 }
 
 Value Evaluate(const Expression& expression, const Scope& scope,
                const AggregateResultMap* aggregates,
-               TransactionContext& context,
-               const CteMap& ctes) {
+               TransactionContext& context, const CteMap& ctes,
+               const BoundExpression* bound) {
+  const auto evaluate = [&](const Expression& child, size_t i) {
+    return Evaluate(child, scope, aggregates, context, ctes,
+                    BoundChild(bound, i));
+  };
   switch (expression->Type()) {
     case TypeTag::kColumnValue: {
+      if (bound != nullptr && bound->depth != BoundExpression::kUnbound) {
+        const Scope* current = &scope;
+        for (uint8_t depth = 0; depth < bound->depth; ++depth) {
+          current = current->outer;
+        }
+        return (*current->row)[bound->slot];
+      }
       const ColumnName& name = expression->AsColumnValue().GetColumnName();
       if (name.name == "*") return Value(1);
       return Lookup(name, scope);
@@ -787,24 +943,28 @@ Value Evaluate(const Expression& expression, const Scope& scope,
     case TypeTag::kBinaryExp: {
       const auto& value = expression->AsBinaryExpression();
       if (value.Op() == BinaryOperation::kAnd) {
-        const Value left =
-            Evaluate(value.Left(), scope, aggregates, context, ctes);
+        const Value left = evaluate(value.Left(), 0);
         if (!Truthy(left)) return Value(false);
       }
       if (value.Op() == BinaryOperation::kOr) {
-        const Value left =
-            Evaluate(value.Left(), scope, aggregates, context, ctes);
+        const Value left = evaluate(value.Left(), 0);
         if (Truthy(left)) return Value(true);
       }
-      return Binary(value.Op(),
-                    Evaluate(value.Left(), scope, aggregates, context, ctes),
-                    Evaluate(value.Right(), scope, aggregates, context,
-                             ctes));
+      if (const LikeMatcher* like = value.LikePattern(); like != nullptr) {
+        const Value left = evaluate(value.Left(), 0);
+        if (left.IsNull()) return Value();
+        if (left.type != ValueType::kVarChar) {
+          throw std::runtime_error("LIKE requires string operands");
+        }
+        const bool matched = like->Matches(left.value.varchar_value);
+        return Value(value.Op() == BinaryOperation::kLike ? matched : !matched);
+      }
+      return Binary(value.Op(), evaluate(value.Left(), 0),
+                    evaluate(value.Right(), 1));
     }
     case TypeTag::kUnaryExp: {
       const auto& value = expression->AsUnaryExpression();
-      Value child =
-          Evaluate(value.Child(), scope, aggregates, context, ctes);
+      Value child = evaluate(value.Child(), 0);
       if (value.Op() == UnaryOperation::kIsNull) return Value(child.IsNull());
       if (value.Op() == UnaryOperation::kIsNotNull)
         return Value(!child.IsNull());
@@ -819,23 +979,19 @@ Value Evaluate(const Expression& expression, const Scope& scope,
       return Aggregate(expression->AsAggregateExpression(), *aggregates);
     case TypeTag::kCaseExp: {
       const auto& value = expression->AsCaseExpression();
+      size_t i = 0;
       for (const auto& [condition, result] : value.when_clauses_) {
-        if (Truthy(Evaluate(condition, scope, aggregates, context, ctes))) {
-          return Evaluate(result, scope, aggregates, context, ctes);
-        }
+        if (Truthy(evaluate(condition, i))) return evaluate(result, i + 1);
+        i += 2;
       }
-      return value.else_clause_
-                 ? Evaluate(value.else_clause_, scope, aggregates, context,
-                            ctes)
-                 : Value();
+      return value.else_clause_ ? evaluate(value.else_clause_, i) : Value();
     }
     case TypeTag::kInExp: {
       const auto& value = expression->AsInExpression();
-      const Value test =
-          Evaluate(value.child_, scope, aggregates, context, ctes);
-      for (const Expression& item : value.list_) {
+      const Value test = evaluate(value.child_, 0);
+      for (size_t i = 0; i < value.list_.size(); ++i) {
         if (Binary(BinaryOperation::kEquals, test,
-                   Evaluate(item, scope, aggregates, context, ctes))
+                   evaluate(value.list_[i], i + 1))
                 .Truthy()) {
           return Value(true);
         }
@@ -844,7 +1000,7 @@ Value Evaluate(const Expression& expression, const Scope& scope,
     }
     case TypeTag::kFunctionCallExp:
       return EvaluateFunction(expression->AsFunctionCallExpression(), scope,
-                              aggregates, context, ctes);
+                              aggregates, context, ctes, bound);
     case TypeTag::kQueryExp: {
       const auto& value = expression->AsQueryExpression();
       std::optional<Relation> indexed =
@@ -865,33 +1021,38 @@ Value Evaluate(const Expression& expression, const Scope& scope,
         return Value(value.Negated() ? !exists : exists);
       }
       if (value.Test()) {
-        const Value test =
-            Evaluate(value.Test(), scope, aggregates, context, ctes);
+        const Value test = evaluate(value.Test(), 0);
         bool found = false;
+        // Whether a NULL makes a failed search unknown rather than false.
+        bool unknown = false;
         if (uncorrelated && active_runtime) {
           auto [cached, inserted] =
               active_runtime->uncorrelated_membership.try_emplace(
                   value.Query().get());
           if (inserted) {
-            cached->second.reserve(relation->rows.size());
+            cached->second.Reserve(relation->rows.size());
             for (const Row& row : relation->rows) {
-              if (!row.values_.empty() && !row[0].IsNull()) {
-                cached->second.insert(row[0]);
-              }
+              if (!row.values_.empty()) cached->second.Insert(row[0]);
             }
             ++active_runtime->uncorrelated_hash_builds;
           }
           ++active_runtime->uncorrelated_hash_probes;
-          found = !test.IsNull() && cached->second.contains(test);
+          found = !test.IsNull() && cached->second.Contains(test);
+          unknown = cached->second.HasNull();
         } else {
           for (const Row& row : relation->rows) {
-            if (!row.values_.empty() &&
-                Truthy(Binary(BinaryOperation::kEquals, test, row[0]))) {
+            if (row.values_.empty()) continue;
+            if (row[0].IsNull()) unknown = true;
+            if (Truthy(Binary(BinaryOperation::kEquals, test, row[0]))) {
               found = true;
               break;
             }
           }
         }
+        // SQL's three-valued IN: no match against a NULL is unknown.
+        if (!found && !relation->rows.empty() && (unknown || test.IsNull())) {
+          return Value();
+        }
         return Value(value.Negated() ? !found : found);
       }
       if (relation->rows.empty() || relation->rows[0].values_.empty())
@@ -956,6 +1117,17 @@ void CollectStatementColumns(const SelectStatement& statement,
   }
 }
 
+// True when a name in `referenced` may denote `candidate`; unqualified
+// names match a column of any relation.
+bool References(const std::unordered_set<ColumnName>& referenced,
+                const ColumnName& candidate) {
+  return std::ranges::any_of(referenced, [&](const ColumnName& name) {
+    if (name.name == "*") return false;
+    return name.name == candidate.name &&
+           (name.schema.empty() || name.schema == candidate.schema);
+  });
+}
+
 std::vector<slot_t> RequiredColumns(const SelectStatement& statement,
                                     const Schema& schema,
                                     bool ignore_star = false) {
@@ -974,14 +1146,9 @@ std::vector<slot_t> RequiredColumns(const SelectStatement& statement,
   std::vector<slot_t> result;
   result.reserve(schema.ColumnCount());
   for (slot_t i = 0; i < schema.ColumnCount(); ++i) {
-    const ColumnName& candidate = schema.GetColumn(i).Name();
-    const bool needed =
-        selects_star || std::ranges::any_of(referenced, [&](const auto& name) {
-          if (name.name == "*") return false;
-          return name.name == candidate.name &&
-                 (name.schema.empty() || name.schema == candidate.schema);
-        });
-    if (needed) result.push_back(i);
+    if (selects_star || References(referenced, schema.GetColumn(i).Name())) {
+      result.push_back(i);
+    }
   }
   return result;
 }
@@ -1034,7 +1201,7 @@ std::string BaseRelationCacheKey(
 }
 
 bool ReusesBaseRelation(const SelectSource& source) {
-  return active_runtime &&
+  return active_runtime && !source.sample &&
          active_runtime->reusable_base_relations.contains(source.table);
 }
 
@@ -1261,11 +1428,14 @@ std::optional<SimpleComparePredicate> TryCompileSimpleCompare(
 struct CompiledScanFilter {
   std::vector<SimpleComparePredicate> simple;
   std::vector<Expression> residual;
+  // `residual` bound for rows of the compiled schema under the scan's outer
+  // scope.
+  std::vector<BoundExpression> bound_residual;
   bool all_simple{false};
 };
 
 CompiledScanFilter CompileScanFilter(const std::vector<Expression>& predicates,
-                                     const Schema& schema) {
+                                     const Schema& schema, const Scope* outer) {
   CompiledScanFilter compiled;
   compiled.all_simple = true;
   for (const Expression& predicate : predicates) {
@@ -1276,6 +1446,7 @@ CompiledScanFilter CompileScanFilter(const std::vector<Expression>& predicates,
       compiled.residual.push_back(predicate);
     }
   }
+  compiled.bound_residual = Bind(compiled.residual, schema, outer);
   return compiled;
 }
 
@@ -1287,8 +1458,9 @@ bool MatchScanFilter(const Row& row, const Schema& schema,
   }
   if (filter.residual.empty()) return true;
   Scope scope{&row, &schema, outer};
-  for (const Expression& predicate : filter.residual) {
-    if (!Truthy(Evaluate(predicate, scope, nullptr, context, ctes))) {
+  for (size_t i = 0; i < filter.residual.size(); ++i) {
+    if (!Truthy(Evaluate(filter.residual[i], scope, nullptr, context, ctes,
+                         &filter.bound_residual[i]))) {
       return false;
     }
   }
@@ -1305,7 +1477,8 @@ bool TryParallelTableScan(TransactionContext& context, Table& table,
                           const std::vector<slot_t>* projection,
                           const std::unordered_set<int64_t>* key_filter,
                           std::optional<slot_t> full_key_column,
-                          bool filter_during_scan,
+                          const RuntimeFilter* runtime_filter,
+                          bool row_positions, bool filter_during_scan,
                           const CompiledScanFilter* scan_filter,
                           const Schema& result_schema, const Scope* outer,
                           const CteMap& ctes, Relation* result) {
@@ -1338,7 +1511,7 @@ bool TryParallelTableScan(TransactionContext& context, Table& table,
             if (mi >= morsels.size()) break;
             Iterator iterator = table.BeginMorselScan(
                 context.txn_, morsels[mi], proj_opt, key_filter,
-                full_key_column);
+                full_key_column, runtime_filter);
             while (iterator.IsValid()) {
               ++shard_seen[w];
               bool matches = true;
@@ -1348,6 +1521,10 @@ bool TryParallelTableScan(TransactionContext& context, Table& table,
               }
               if (matches) {
                 local.push_back(*iterator);
+                if (row_positions) {
+                  local.back().values_.push_back(
+                      EncodeRowPosition(iterator.Position()));
+                }
                 ++shard_out[w];
               }
               ++iterator;
@@ -1357,6 +1534,7 @@ bool TryParallelTableScan(TransactionContext& context, Table& table,
           std::scoped_lock lock(error_mu);
           if (!error) error = std::current_exception();
         }
+        context.txn_.ForgetThreadReadCache();
       });
     }
   }
@@ -1377,21 +1555,28 @@ bool TryParallelTableScan(TransactionContext& context, Table& table,
   return true;
 }
 
+// Loads a source, dropping base-table rows that fail `scan_predicates` or
+// whose join key misses `int_key_filter` or `runtime_filter`; a caller
+// passes at most one of the two key filters. With `row_positions`, a base
+// table scan appends each row's encoded RowPosition as a last column named
+// kRowPositionColumn.
 Relation LoadSource(TransactionContext& context, const SelectSource& source,
                     const Scope* outer, const CteMap& ctes,
                     const std::vector<slot_t>* projection = nullptr,
                     const std::vector<Expression>* scan_predicates = nullptr,
                     const std::unordered_set<int64_t>* int_key_filter = nullptr,
-                    std::optional<slot_t> int_key_column = std::nullopt) {
+                    std::optional<slot_t> int_key_column = std::nullopt,
+                    const RuntimeFilter* runtime_filter = nullptr,
+                    bool row_positions = false) {
   Relation result;
   if (source.query) {
-    result = ExecuteQuery(context, *source.query, outer, ctes);
+    std::optional<Relation> started = TakeSubquery(*source.query);
+    result = started ? std::move(*started)
+                     : ExecuteQuery(context, *source.query, outer, ctes);
   } else if (const auto cte = ctes.find(source.table); cte != ctes.end()) {
     result = cte->second;
   } else {
-    const bool reusable =
-        active_runtime &&
-        active_runtime->reusable_base_relations.contains(source.table);
+    const bool reusable = ReusesBaseRelation(source);
     const std::string cache_key =
         BaseRelationCacheKey(source.table, projection);
     const bool filter_during_scan =
@@ -1399,6 +1584,20 @@ Relation LoadSource(TransactionContext& context, const SelectSource& source,
     const auto cached =
         reusable ? active_runtime->base_relations.find(cache_key)
                  : std::unordered_map<std::string, Relation>::iterator{};
+    // Key slots of `runtime_filter` in the (projected) rows of this source.
+    std::vector<slot_t> runtime_filter_slots;
+    if (runtime_filter) {
+      for (slot_t column : runtime_filter->Columns()) {
+        if (!projection) {
+          runtime_filter_slots.push_back(column);
+          continue;
+        }
+        const auto found =
+            std::find(projection->begin(), projection->end(), column);
+        runtime_filter_slots.push_back(
+            static_cast<slot_t>(std::distance(projection->begin(), found)));
+      }
+    }
     if (reusable && cached != active_runtime->base_relations.end()) {
       // Materialize only rows that survive this alias's local predicates so
       // we never deep-copy a multi-million-row cache and filter afterwards.
@@ -1413,12 +1612,17 @@ Relation LoadSource(TransactionContext& context, const SelectSource& source,
               return;
             }
           }
+          if (runtime_filter &&
+              !runtime_filter->MayContain(row, runtime_filter_slots)) {
+            runtime_filter->AddRejected(1);
+            return;
+          }
           result.AddRow(row);
         });
       } else {
         const auto filter_begin = std::chrono::steady_clock::now();
         const CompiledScanFilter scan_filter =
-            CompileScanFilter(*scan_predicates, cached_relation.schema);
+            CompileScanFilter(*scan_predicates, cached_relation.schema, outer);
         cached_relation.ForEachRow([&](const Row& row) {
           if (int_key_filter && int_key_column) {
             const Value& key = row[*int_key_column];
@@ -1427,6 +1631,11 @@ Relation LoadSource(TransactionContext& context, const SelectSource& source,
               return;
             }
           }
+          if (runtime_filter &&
+              !runtime_filter->MayContain(row, runtime_filter_slots)) {
+            runtime_filter->AddRejected(1);
+            return;
+          }
           if (MatchScanFilter(row, cached_relation.schema, scan_filter, outer,
                               context, ctes)) {
             result.AddRow(row);
@@ -1445,7 +1654,8 @@ Relation LoadSource(TransactionContext& context, const SelectSource& source,
                                  : table_schema;
       CompiledScanFilter scan_filter;
       if (filter_during_scan) {
-        scan_filter = CompileScanFilter(*scan_predicates, result.schema);
+        scan_filter =
+            CompileScanFilter(*scan_predicates, result.schema, outer);
       }
       const auto scan_begin = std::chrono::steady_clock::now();
       const auto filter_begin = scan_begin;
@@ -1458,31 +1668,35 @@ Relation LoadSource(TransactionContext& context, const SelectSource& source,
       } else if (int_key_filter && int_key_column && !projection) {
         full_key_column = *int_key_column;
       }
-      const bool parallel_ok = TryParallelTableScan(
-          context, *table.Value(), projection, int_key_filter, full_key_column,
-          filter_during_scan, filter_during_scan ? &scan_filter : nullptr,
-          result.schema, outer, ctes, &result);
-      if (!parallel_ok) {
-        Iterator iterator =
-            full_key_column
-                ? (projection
-                       ? table.Value()->BeginFullScan(context.txn_, *projection,
-                                                      int_key_filter,
-                                                      *full_key_column)
-                       : table.Value()->BeginFullScan(context.txn_,
-                                                      int_key_filter,
-                                                      *full_key_column))
-                : projection
-                      ? table.Value()->BeginFullScan(context.txn_, *projection)
-                      : table.Value()->BeginFullScan(context.txn_);
+      const bool parallel_ok =
+          !source.sample &&
+          TryParallelTableScan(context, *table.Value(), projection,
+                               int_key_filter, full_key_column, runtime_filter,
+                               row_positions, filter_during_scan,
+                               filter_during_scan ? &scan_filter : nullptr,
+                               result.schema, outer, ctes, &result);
+      // TABLESAMPLE SYSTEM scans only the sampled pages; BERNOULLI scans
+      // every page and keeps each row by a hash of its position.
+      const TableSample* sample = source.sample ? &*source.sample : nullptr;
+      const uint64_t sample_seed = sample ? TableSampleSeed(*sample) : 0;
+      const double row_fraction =
+          sample && sample->method == TableSample::Method::kBernoulli
+              ? sample->fraction
+              : 1.0;
+      std::optional<std::vector<slot_t>> scan_projection;
+      if (projection) scan_projection = *projection;
+      const auto drain = [&](Iterator iterator) {
         while (iterator.IsValid()) {
           if (active_runtime) {
             ++active_runtime->scan_rows;
             active_runtime->scan_values_available += table_schema.ColumnCount();
             active_runtime->scan_values_decoded += result.schema.ColumnCount();
           }
-          bool matches = true;
-          if (!full_key_column && int_key_filter && int_key_column) {
+          bool matches = row_fraction >= 1.0 ||
+                         SampleKeepsRow(row_fraction, sample_seed,
+                                        iterator.Position());
+          if (matches && !full_key_column && int_key_filter &&
+              int_key_column) {
             const Value& key = (*iterator)[*int_key_column];
             if (key.IsNull() ||
                 !int_key_filter->contains(key.value.int_value)) {
@@ -1494,25 +1708,57 @@ Relation LoadSource(TransactionContext& context, const SelectSource& source,
             matches = MatchScanFilter(*iterator, result.schema, scan_filter,
                                       outer, context, ctes);
           }
-          if (matches) {
+          if (matches && row_positions) {
+            Row row = *iterator;
+            row.values_.push_back(EncodeRowPosition(iterator.Position()));
+            result.AddRow(std::move(row));
+            if (active_runtime) ++active_runtime->scan_output_rows;
+          } else if (matches) {
             result.AddRow(*iterator);
             if (active_runtime) ++active_runtime->scan_output_rows;
           }
           ++iterator;
         }
+      };
+      if (sample) {
+        const double page_fraction =
+            sample->method == TableSample::Method::kSystem ? sample->fraction
+                                                           : 1.0;
+        for (const Table::ScanMorsel& morsel : table.Value()->BuildScanMorsels(
+                 context.txn_, 8, page_fraction, sample_seed)) {
+          drain(table.Value()->BeginMorselScan(
+              context.txn_, morsel, scan_projection,
+              full_key_column ? int_key_filter : nullptr, full_key_column,
+              full_key_column ? nullptr : runtime_filter));
+        }
+      } else if (!parallel_ok) {
+        drain(full_key_column
+                  ? (projection
+                         ? table.Value()->BeginFullScan(
+                               context.txn_, *projection, int_key_filter,
+                               *full_key_column)
+                         : table.Value()->BeginFullScan(
+                               context.txn_, int_key_filter, *full_key_column))
+                  : table.Value()->BeginFullScan(
+                        context.txn_, scan_projection, runtime_filter));
       }
       if (active_runtime) {
         active_runtime->scan_ms += ElapsedMs(scan_begin);
         if (filter_during_scan) {
           active_runtime->filter_ms += ElapsedMs(filter_begin);
         }
-        if (reusable && !int_key_filter) {
+        if (reusable && !int_key_filter && !runtime_filter) {
           active_runtime->base_relations.emplace(cache_key, result);
         }
       }
       if (reusable && scan_predicates && !scan_predicates->empty()) {
         FilterRelation(context, &result, *scan_predicates, outer, ctes);
       }
+      if (row_positions) {
+        result.schema = result.schema +
+                        Schema("", {Column(kRowPositionColumn,
+                                           ValueType::kInt64)});
+      }
     }
   }
   const std::string qualifier =
@@ -1633,7 +1879,7 @@ void FilterRelation(TransactionContext& context, Relation* relation,
   if (predicates.empty()) return;
   const auto filter_begin = std::chrono::steady_clock::now();
   const CompiledScanFilter scan_filter =
-      CompileScanFilter(predicates, relation->schema);
+      CompileScanFilter(predicates, relation->schema, outer);
   Relation filtered;
   filtered.schema = relation->schema;
   filtered.hash_joins = relation->hash_joins;
@@ -1726,52 +1972,91 @@ int64_t IntegerJoinKey(const Row& row, slot_t column) {
   return row[column].value.int_value;
 }
 
+bool IntegerPairJoinKey(const Schema& schema,
+                        const std::vector<slot_t>& columns) {
+  if (columns.size() != 2) return false;
+  return std::all_of(columns.begin(), columns.end(), [&](slot_t column) {
+    const ValueType type = schema.GetColumn(column).Type();
+    return type == ValueType::kInt64 || type == ValueType::kDate;
+  });
+}
+
+// Flat-table key of `columns` of `row` (see AppendFlatKey), written into a
+// caller-owned buffer so probes reuse its allocation.
+void EncodeJoinKeyInto(const Row& row, const std::vector<slot_t>& columns,
+                       std::string* key) {
+  key->clear();
+  for (const slot_t column : columns) AppendFlatKey(row[column], key);
+}
+
 std::string EncodeJoinKey(const Row& row, const std::vector<slot_t>& columns) {
-  return row.Extract(columns).EncodeMemcomparableFormat();
+  std::string key;
+  EncodeJoinKeyInto(row, columns, &key);
+  return key;
 }
 
-size_t EstimateJoinRows(const Relation& left, const Relation& right,
-                        const std::vector<Expression>& predicates) {
-  const std::vector<EqualityKey> keys =
-      EqualityKeys(left.schema, right.schema, predicates);
-  if (keys.empty()) {
-    if (left.rows.empty() || right.rows.empty()) return 0;
-    if (left.rows.size() >
-        std::numeric_limits<size_t>::max() / right.rows.size()) {
-      return std::numeric_limits<size_t>::max();
+// Same encoding for values gathered from outer scopes, so they probe tables
+// keyed by EncodeJoinKey.
+std::string EncodeValuesKey(const std::vector<Value>& values) {
+  std::string key;
+  for (const Value& value : values) AppendFlatKey(value, &key);
+  return key;
+}
+
+// Rows an inner join of a stream of `left` rows with `right` produces on the
+// predicates' equality keys, counted exactly as the stream's rows are added
+// one at a time; spilled rows of `right` are counted too. Without equality
+// keys, the cross product.
+class JoinRowEstimate {
+ public:
+  JoinRowEstimate(const Schema& left, Relation& right,
+                  const std::vector<Expression>& predicates)
+      : right_rows_(right.TotalRows()) {
+    std::vector<slot_t> right_columns;
+    for (const EqualityKey& key :
+         EqualityKeys(left, right.schema, predicates)) {
+      left_columns_.push_back(static_cast<slot_t>(key.left));
+      right_columns.push_back(static_cast<slot_t>(key.right));
     }
-    return left.rows.size() * right.rows.size();
-  }
-  std::vector<slot_t> left_columns;
-  std::vector<slot_t> right_columns;
-  for (const EqualityKey& key : keys) {
-    left_columns.push_back(static_cast<slot_t>(key.left));
-    right_columns.push_back(static_cast<slot_t>(key.right));
+    if (left_columns_.empty()) return;
+    right.FinishSpill();
+    frequencies_.reserve(right_rows_);
+    right.ForEachRow([&](const Row& row) {
+      if (!HasNullKey(row, right_columns)) {
+        ++frequencies_[row.Extract(right_columns).EncodeMemcomparableFormat()];
+      }
+    });
   }
-  std::unordered_map<std::string, size_t> frequencies;
-  frequencies.reserve(right.rows.size());
-  for (const Row& row : right.rows) {
-    if (!HasNullKey(row, right_columns)) {
-      ++frequencies[row.Extract(right_columns).EncodeMemcomparableFormat()];
+
+  void Add(const Row& left_row) {
+    if (left_columns_.empty()) {
+      rows_ = rows_ > std::numeric_limits<size_t>::max() - right_rows_
+                  ? std::numeric_limits<size_t>::max()
+                  : rows_ + right_rows_;
+      return;
     }
+    if (HasNullKey(left_row, left_columns_)) return;
+    const auto found = frequencies_.find(
+        left_row.Extract(left_columns_).EncodeMemcomparableFormat());
+    if (found != frequencies_.end()) rows_ += found->second;
   }
-  size_t estimate = 0;
-  for (const Row& row : left.rows) {
-    if (HasNullKey(row, left_columns)) continue;
-    const auto found =
-        frequencies.find(row.Extract(left_columns).EncodeMemcomparableFormat());
-    if (found != frequencies.end()) estimate += found->second;
-  }
-  return estimate;
-}
+
+  [[nodiscard]] size_t Rows() const { return rows_; }
+
+ private:
+  std::vector<slot_t> left_columns_;
+  std::unordered_map<std::string, size_t> frequencies_;
+  size_t right_rows_;
+  size_t rows_{0};
+};
 
 bool HasNullKey(const Row& row, const std::vector<slot_t>& columns) {
   return std::any_of(columns.begin(), columns.end(),
                      [&](slot_t column) { return row[column].IsNull(); });
 }
 
-size_t SpillPartitionOf(const std::string& key, size_t partitions) {
-  return std::hash<std::string>{}(key) % partitions;
+size_t SpillPartitionOf(std::string_view key, size_t partitions) {
+  return static_cast<size_t>(FlatHash(key) % partitions);
 }
 
 size_t SpillPartitionOf(int64_t key, size_t partitions) {
@@ -1779,11 +2064,13 @@ size_t SpillPartitionOf(int64_t key, size_t partitions) {
 }
 
 // DeWitt-style Hybrid Hash Join: keep partition 0 resident; spill the rest.
-Relation HybridHashJoin(
-    Relation left, Relation right, const std::vector<slot_t>& left_columns,
-    const std::vector<slot_t>& right_columns,
-    const std::function<bool(const Row&)>& matches, bool left_join,
-    size_t* join_comparisons) {
+// Joined rows are pushed to `emit` as they are produced.
+void HybridHashJoin(Relation left, Relation right,
+                    const std::vector<slot_t>& left_columns,
+                    const std::vector<slot_t>& right_columns,
+                    const std::function<bool(const Row&)>& matches,
+                    bool left_join, size_t* join_comparisons,
+                    const RowSink& emit) {
   size_t build_estimate = 0;
   if (right.HasSpill()) {
     build_estimate = right.TotalRows() * 128;
@@ -1793,7 +2080,7 @@ Relation HybridHashJoin(
     }
   }
   const size_t partitions = HybridPartitionCount(build_estimate);
-  QueryMemoryBudget& budget = QueryMemoryBudget::Global();
+  const MemoryContext& budget = MemoryContext::Current();
   const bool integer_key =
       SingleIntegerJoinKey(left.schema, left_columns) &&
       SingleIntegerJoinKey(right.schema, right_columns);
@@ -1841,52 +2128,44 @@ Relation HybridHashJoin(
   right.rows.shrink_to_fit();
   right.ReleaseCharge();
 
-  std::unordered_multimap<int64_t, const Row*> int_buckets;
-  std::unordered_multimap<std::string, const Row*> str_buckets;
+  FlatMultiMap<int64_t, const Row*> int_buckets;
+  FlatMultiMap<std::string_view, const Row*> str_buckets;
+  std::string key_buffer;
   if (integer_key) {
-    int_buckets.reserve(resident_right.size());
+    int_buckets.Reserve(resident_right.size());
     for (const Row& row : resident_right) {
-      int_buckets.emplace(IntegerJoinKey(row, right_key_column), &row);
+      int_buckets.Insert(IntegerJoinKey(row, right_key_column), &row);
     }
   } else {
-    str_buckets.reserve(resident_right.size());
+    str_buckets.Reserve(resident_right.size());
     for (const Row& row : resident_right) {
-      str_buckets.emplace(EncodeJoinKey(row, right_columns), &row);
+      EncodeJoinKeyInto(row, right_columns, &key_buffer);
+      str_buckets.Insert(key_buffer, &row);
     }
   }
 
-  Relation result;
-  result.schema = left.schema + right.schema;
   const size_t right_width = right.schema.ColumnCount();
 
   auto probe_resident = [&](const Row& left_row) {
     bool matched = false;
-    if (integer_key) {
-      const int64_t key = IntegerJoinKey(left_row, left_key_column);
-      const auto [begin, end] = int_buckets.equal_range(key);
-      for (auto iter = begin; iter != end; ++iter) {
-        ++(*join_comparisons);
-        Row combined = left_row + *iter->second;
-        if (matches(combined)) {
-          result.AddRow(std::move(combined));
-          matched = true;
-        }
+    auto probe_match = [&](const Row* right_row) {
+      ++(*join_comparisons);
+      Row combined = left_row + *right_row;
+      if (matches(combined)) {
+        emit(std::move(combined));
+        matched = true;
       }
+    };
+    if (integer_key) {
+      int_buckets.ForEachMatch(
+          IntegerJoinKey(left_row, left_key_column), probe_match);
     } else {
-      const std::string key = EncodeJoinKey(left_row, left_columns);
-      const auto [begin, end] = str_buckets.equal_range(key);
-      for (auto iter = begin; iter != end; ++iter) {
-        ++(*join_comparisons);
-        Row combined = left_row + *iter->second;
-        if (matches(combined)) {
-          result.AddRow(std::move(combined));
-          matched = true;
-        }
-      }
+      EncodeJoinKeyInto(left_row, left_columns, &key_buffer);
+      str_buckets.ForEachMatch(key_buffer, probe_match);
     }
     if (!matched && left_join) {
       std::vector<Value> nulls(right_width);
-      result.AddRow(left_row + Row(std::move(nulls)));
+      emit(left_row + Row(std::move(nulls)));
     }
   };
 
@@ -1894,7 +2173,7 @@ Relation HybridHashJoin(
     if (HasNullKey(left_row, left_columns)) {
       if (left_join) {
         std::vector<Value> nulls(right_width);
-        result.AddRow(left_row + Row(std::move(nulls)));
+        emit(left_row + Row(std::move(nulls)));
       }
       return;
     }
@@ -1909,8 +2188,8 @@ Relation HybridHashJoin(
   left.rows.shrink_to_fit();
   left.ReleaseCharge();
 
-  int_buckets.clear();
-  str_buckets.clear();
+  int_buckets = {};
+  str_buckets = {};
   if (!right_parts[0].Empty()) {
     for (const Row& row : resident_right) {
       right_parts[0].Append(row);
@@ -1934,100 +2213,311 @@ Relation HybridHashJoin(
     for (const Row& row : right_rows) {
       part_charge.Add(EstimateRowBytes(row));
     }
-    std::unordered_multimap<int64_t, const Row*> part_int_buckets;
-    std::unordered_multimap<std::string, const Row*> part_str_buckets;
+    FlatMultiMap<int64_t, const Row*> part_int_buckets;
+    FlatMultiMap<std::string_view, const Row*> part_str_buckets;
     if (integer_key) {
-      part_int_buckets.reserve(right_rows.size());
+      part_int_buckets.Reserve(right_rows.size());
       for (const Row& row : right_rows) {
-        part_int_buckets.emplace(IntegerJoinKey(row, right_key_column), &row);
+        part_int_buckets.Insert(IntegerJoinKey(row, right_key_column), &row);
       }
     } else {
-      part_str_buckets.reserve(right_rows.size());
+      part_str_buckets.Reserve(right_rows.size());
       for (const Row& row : right_rows) {
-        part_str_buckets.emplace(EncodeJoinKey(row, right_columns), &row);
+        EncodeJoinKeyInto(row, right_columns, &key_buffer);
+        part_str_buckets.Insert(key_buffer, &row);
       }
     }
     left_parts[part].ForEachRow([&](const Row& left_row) {
       bool matched = false;
-      if (integer_key) {
-        const int64_t key = IntegerJoinKey(left_row, left_key_column);
-        const auto [begin, end] = part_int_buckets.equal_range(key);
-        for (auto iter = begin; iter != end; ++iter) {
-          ++(*join_comparisons);
-          Row combined = left_row + *iter->second;
-          if (matches(combined)) {
-            result.AddRow(std::move(combined));
-            matched = true;
-          }
+      auto probe_match = [&](const Row* right_row) {
+        ++(*join_comparisons);
+        Row combined = left_row + *right_row;
+        if (matches(combined)) {
+          emit(std::move(combined));
+          matched = true;
         }
+      };
+      if (integer_key) {
+        part_int_buckets.ForEachMatch(
+            IntegerJoinKey(left_row, left_key_column), probe_match);
       } else {
-        const std::string key = EncodeJoinKey(left_row, left_columns);
-        const auto [begin, end] = part_str_buckets.equal_range(key);
-        for (auto iter = begin; iter != end; ++iter) {
-          ++(*join_comparisons);
-          Row combined = left_row + *iter->second;
-          if (matches(combined)) {
-            result.AddRow(std::move(combined));
-            matched = true;
-          }
-        }
+        EncodeJoinKeyInto(left_row, left_columns, &key_buffer);
+        part_str_buckets.ForEachMatch(key_buffer, probe_match);
       }
       if (!matched && left_join) {
         std::vector<Value> nulls(right_width);
-        result.AddRow(left_row + Row(std::move(nulls)));
+        emit(left_row + Row(std::move(nulls)));
       }
     });
   }
-  result.FinishSpill();
-  return result;
 }
 
-bool ShouldHybridJoin(const Relation& left, const Relation& right) {
-  if (left.HasSpill() || right.HasSpill()) {
+// Join key extractors for PartitionedJoinTable; NULL keys never match.
+struct IntegerKeyOf {
+  slot_t column;
+  bool operator()(const Row& row, int64_t* key) const {
+    if (row[column].IsNull()) return false;
+    *key = IntegerJoinKey(row, column);
     return true;
   }
-  // Rough hash-table estimate: keys + pointers for the build (right) side.
-  size_t estimate = 0;
-  for (const Row& row : right.rows) {
-    estimate += EstimateRowBytes(row) + 64;
+};
+
+struct IntegerPairKeyOf {
+  slot_t first;
+  slot_t second;
+  bool operator()(const Row& row, Int64Pair* key) const {
+    if (row[first].IsNull() || row[second].IsNull()) return false;
+    *key = {IntegerJoinKey(row, first), IntegerJoinKey(row, second)};
+    return true;
   }
-  return PreferHybridHashJoin(estimate);
-}
+};
 
-Relation Join(TransactionContext& context, Relation left, Relation right,
-              const SelectSource& source, const Scope* outer,
-              const CteMap& ctes) {
-  const auto join_begin = std::chrono::steady_clock::now();
-  Relation result;
-  result.schema = left.schema + right.schema;
-  result.hash_joins = left.hash_joins + right.hash_joins;
-  result.hybrid_hash_joins = left.hybrid_hash_joins + right.hybrid_hash_joins;
-  result.in_memory_hash_joins =
-      left.in_memory_hash_joins + right.in_memory_hash_joins;
-  result.nested_loop_joins = left.nested_loop_joins + right.nested_loop_joins;
-  result.join_comparisons = left.join_comparisons + right.join_comparisons;
-  result.peak_intermediate_rows =
-      std::max(left.peak_intermediate_rows, right.peak_intermediate_rows);
-  const std::vector<Expression> predicates =
-      SplitConjuncts(source.join_condition);
-  const std::vector<EqualityKey> equality_keys =
-      EqualityKeys(left.schema, right.schema, predicates);
-  const std::vector<Expression> residual =
-      ResidualJoinPredicates(left.schema, right.schema, predicates);
+struct EncodedKeyOf {
+  const std::vector<slot_t>* columns;
+  bool operator()(const Row& row, std::string* key) const {
+    if (HasNullKey(row, *columns)) return false;
+    EncodeJoinKeyInto(row, *columns, key);
+    return true;
+  }
+};
 
-  auto matches = [&](const Row& combined) {
-    if (residual.empty()) return true;
-    Scope scope{&combined, &result.schema, outer};
-    return std::all_of(
-        residual.begin(), residual.end(), [&](const Expression& predicate) {
-          return Truthy(Evaluate(predicate, scope, nullptr, context, ctes));
-        });
-  };
-  auto emit_unmatched = [&](const Row& left_row) {
-    if (source.join_type != JoinType::kLeft) return;
-    std::vector<Value> nulls(right.schema.ColumnCount());
-    result.AddRow(left_row + Row(std::move(nulls)));
-  };
+// Joined rows and key comparisons of one radix join slot, on their own cache
+// lines so slots filled by different threads do not share one.
+struct alignas(64) RadixJoinSlot {
+  std::vector<Row> rows;
+  size_t comparisons{0};
+};
+
+// Radix-partitioned join of fully resident inputs (see radix_join.hpp). The
+// output comes partition by partition rather than in `left` order; unmatched
+// rows of a left join follow at the end in `left` order.
+template <typename Key, typename KeyOf>
+void RadixRowJoin(const std::vector<Row>& left, const std::vector<Row>& right,
+                  const KeyOf& left_key, const KeyOf& right_key,
+                  const std::function<bool(const Row&)>& matches,
+                  bool left_join, size_t right_width, size_t workers,
+                  size_t* join_comparisons, const RowSink& emit) {
+  std::vector<Key> right_keys(right.size());
+  std::vector<RadixTuple> build;
+  build.reserve(right.size());
+  for (size_t i = 0; i < right.size(); ++i) {
+    if (right_key(right[i], &right_keys[i])) {
+      build.push_back({FlatHash(right_keys[i]), i});
+    }
+  }
+  std::vector<Key> left_keys(left.size());
+  std::vector<RadixTuple> probe;
+  probe.reserve(left.size());
+  for (size_t i = 0; i < left.size(); ++i) {
+    if (left_key(left[i], &left_keys[i])) {
+      probe.push_back({FlatHash(left_keys[i]), i});
+    }
+  }
+  // Each left row lives in exactly one partition, so only one thread ever
+  // writes its flag.
+  std::vector<uint8_t> matched(left_join ? left.size() : 0);
+  std::vector<RadixJoinSlot> slots(std::max<size_t>(1, workers));
+  const std::vector<int> pass_bits =
+      RadixPassBits(build.size(), RadixPartitionBytes());
+  RadixHashJoin(
+      std::move(build), std::move(probe), pass_bits, workers,
+      [&](size_t slot, uint64_t left_index, uint64_t right_index) {
+        if (!(left_keys[left_index] == right_keys[right_index])) return;
+        ++slots[slot].comparisons;
+        Row combined = left[left_index] + right[right_index];
+        if (matches(combined)) {
+          slots[slot].rows.push_back(std::move(combined));
+          if (left_join) matched[left_index] = 1;
+        }
+      },
+      [&] {
+        for (RadixJoinSlot& slot : slots) {
+          for (Row& row : slot.rows) emit(std::move(row));
+          slot.rows.clear();
+        }
+      });
+  for (const RadixJoinSlot& slot : slots) *join_comparisons += slot.comparisons;
+  for (size_t i = 0; i < matched.size(); ++i) {
+    if (matched[i] != 0) continue;
+    std::vector<Value> nulls(right_width);
+    emit(left[i] + Row(std::move(nulls)));
+  }
+  if (active_runtime) ++active_runtime->radix_hash_joins;
+}
+
+// Hash join of fully resident inputs: `right` is indexed, then `left` rows
+// are probed in order. With several workers the build is partitioned across
+// threads and the probe runs over morsels of `left`; `matches` must then be
+// safe to evaluate off the query thread. HashJoinMode::kRadix hands the join
+// to RadixRowJoin instead.
+template <typename Key, typename KeyOf>
+void InMemoryHashJoin(const std::vector<Row>& left,
+                      const std::vector<Row>& right, const KeyOf& left_key,
+                      const KeyOf& right_key,
+                      const std::function<bool(const Row&)>& matches,
+                      bool left_join, size_t right_width, HashJoinMode mode,
+                      size_t workers, size_t* join_comparisons,
+                      const RowSink& emit) {
+  if (mode == HashJoinMode::kRadix) {
+    RadixRowJoin<Key>(left, right, left_key, right_key, matches, left_join,
+                      right_width, workers, join_comparisons, emit);
+    return;
+  }
+  PartitionedJoinTable<Key> table;
+  table.Build(right, workers, right_key);
+  auto probe_row = [&](const Row& left_row, size_t* comparisons, auto&& out) {
+    bool matched = false;
+    Key key;
+    if (left_key(left_row, &key)) {
+      table.ForEachMatch(key, [&](const Row& right_row) {
+        ++*comparisons;
+        Row combined = left_row + right_row;
+        if (matches(combined)) {
+          out(std::move(combined));
+          matched = true;
+        }
+      });
+    }
+    if (!matched && left_join) {
+      std::vector<Value> nulls(right_width);
+      out(left_row + Row(std::move(nulls)));
+    }
+  };
+  if (workers <= 1) {
+    for (const Row& left_row : left) {
+      probe_row(left_row, join_comparisons, emit);
+    }
+    return;
+  }
+  std::atomic<size_t> comparisons{0};
+  ProbeMorsels(
+      left.size(), workers,
+      [&](size_t begin, size_t end, std::vector<Row>* out) {
+        size_t local = 0;
+        for (size_t i = begin; i < end; ++i) {
+          probe_row(left[i], &local,
+                    [&](Row&& row) { out->push_back(std::move(row)); });
+        }
+        comparisons += local;
+      },
+      emit);
+  *join_comparisons += comparisons;
+  if (active_runtime) ++active_runtime->parallel_hash_joins;
+}
+
+// InMemoryHashJoin on the narrowest flat key the join columns allow: one or
+// two integer columns hash as integers, anything else as an encoded string.
+void ResidentHashJoin(const Relation& left, const Relation& right,
+                      const std::vector<slot_t>& left_columns,
+                      const std::vector<slot_t>& right_columns,
+                      const std::function<bool(const Row&)>& matches,
+                      bool left_join, HashJoinMode mode, size_t workers,
+                      size_t* join_comparisons, const RowSink& emit) {
+  const size_t right_width = right.schema.ColumnCount();
+  if (SingleIntegerJoinKey(left.schema, left_columns) &&
+      SingleIntegerJoinKey(right.schema, right_columns)) {
+    InMemoryHashJoin<int64_t>(left.rows, right.rows,
+                              IntegerKeyOf{left_columns[0]},
+                              IntegerKeyOf{right_columns[0]}, matches,
+                              left_join, right_width, mode, workers,
+                              join_comparisons, emit);
+  } else if (IntegerPairJoinKey(left.schema, left_columns) &&
+             IntegerPairJoinKey(right.schema, right_columns)) {
+    InMemoryHashJoin<Int64Pair>(
+        left.rows, right.rows,
+        IntegerPairKeyOf{left_columns[0], left_columns[1]},
+        IntegerPairKeyOf{right_columns[0], right_columns[1]}, matches,
+        left_join, right_width, mode, workers, join_comparisons, emit);
+  } else {
+    InMemoryHashJoin<std::string>(
+        left.rows, right.rows, EncodedKeyOf{&left_columns},
+        EncodedKeyOf{&right_columns}, matches, left_join, right_width, mode,
+        workers, join_comparisons, emit);
+  }
+}
+
+// Workers for an in-memory join; residual predicates with subqueries need the
+// query thread's runtime, so those joins stay serial.
+size_t InMemoryJoinWorkers(const Relation& left, const Relation& right,
+                           const std::vector<Expression>& residual) {
+  if (std::any_of(residual.begin(), residual.end(),
+                  [](const Expression& predicate) {
+                    return ContainsQuery(predicate);
+                  })) {
+    return 1;
+  }
+  return JoinWorkerCount(std::max(left.rows.size(), right.rows.size()));
+}
+
+// Rough hash-table estimate: keys + pointers for the build side.
+size_t BuildTableBytes(const Relation& build) {
+  size_t estimate = 0;
+  for (const Row& row : build.rows) {
+    estimate += EstimateRowBytes(row) + 64;
+  }
+  return estimate;
+}
+
+// Whether `build` can stay resident as a JoinPipeline stage.
+bool ResidentBuild(const Relation& build) {
+  return !build.HasSpill() && !PreferHybridHashJoin(BuildTableBytes(build));
+}
+
+HashJoinMode ChooseHashJoinMode(const Relation& left, const Relation& right) {
+  if (left.HasSpill() || right.HasSpill()) {
+    return HashJoinMode::kHybrid;
+  }
+  const size_t estimate = BuildTableBytes(right);
+  if (PreferHybridHashJoin(estimate)) return HashJoinMode::kHybrid;
+  if (PreferRadixHashJoin(estimate)) return HashJoinMode::kRadix;
+  return HashJoinMode::kInMemory;
+}
+
+// Schema and inherited join counters of `left` joined with `right`, without
+// any rows.
+Relation JoinHeader(const Relation& left, const Relation& right) {
+  Relation header;
+  header.schema = left.schema + right.schema;
+  header.hash_joins = left.hash_joins + right.hash_joins;
+  header.hybrid_hash_joins = left.hybrid_hash_joins + right.hybrid_hash_joins;
+  header.in_memory_hash_joins =
+      left.in_memory_hash_joins + right.in_memory_hash_joins;
+  header.nested_loop_joins = left.nested_loop_joins + right.nested_loop_joins;
+  header.join_comparisons = left.join_comparisons + right.join_comparisons;
+  header.peak_intermediate_rows =
+      std::max(left.peak_intermediate_rows, right.peak_intermediate_rows);
+  return header;
+}
+
+Relation Join(TransactionContext& context, Relation left, Relation right,
+              const SelectSource& source, const Scope* outer,
+              const CteMap& ctes) {
+  const auto join_begin = std::chrono::steady_clock::now();
+  Relation result = JoinHeader(left, right);
+  const std::vector<Expression> predicates =
+      SplitConjuncts(source.join_condition);
+  const std::vector<EqualityKey> equality_keys =
+      EqualityKeys(left.schema, right.schema, predicates);
+  const std::vector<Expression> residual =
+      ResidualJoinPredicates(left.schema, right.schema, predicates);
+  const std::vector<BoundExpression> bound_residual =
+      Bind(residual, result.schema, outer);
+
+  auto matches = [&](const Row& combined) {
+    Scope scope{&combined, &result.schema, outer};
+    for (size_t i = 0; i < residual.size(); ++i) {
+      if (!Truthy(Evaluate(residual[i], scope, nullptr, context, ctes,
+                           &bound_residual[i]))) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto emit_unmatched = [&](const Row& left_row) {
+    if (source.join_type != JoinType::kLeft) return;
+    std::vector<Value> nulls(right.schema.ColumnCount());
+    result.AddRow(left_row + Row(std::move(nulls)));
+  };
 
   if (equality_keys.empty()) {
     ++result.nested_loop_joins;
@@ -2053,74 +2543,24 @@ Relation Join(TransactionContext& context, Relation left, Relation right,
       left_columns.push_back(static_cast<slot_t>(key.left));
       right_columns.push_back(static_cast<slot_t>(key.right));
     }
-    if (ShouldHybridJoin(left, right)) {
+    const HashJoinMode mode = ChooseHashJoinMode(left, right);
+    if (mode == HashJoinMode::kHybrid) {
       ++result.hybrid_hash_joins;
-      Relation joined =
-          HybridHashJoin(std::move(left), std::move(right), left_columns,
-                         right_columns, matches,
-                         source.join_type == JoinType::kLeft,
-                         &result.join_comparisons);
-      joined.hash_joins = result.hash_joins;
-      joined.hybrid_hash_joins = result.hybrid_hash_joins;
-      joined.in_memory_hash_joins = result.in_memory_hash_joins;
-      joined.nested_loop_joins = result.nested_loop_joins;
-      joined.join_comparisons = result.join_comparisons;
+      HybridHashJoin(std::move(left), std::move(right), left_columns,
+                     right_columns, matches,
+                     source.join_type == JoinType::kLeft,
+                     &result.join_comparisons,
+                     [&](Row&& row) { result.AddRow(std::move(row)); });
+      result.FinishSpill();
       if (active_runtime) active_runtime->join_ms += ElapsedMs(join_begin);
-      return joined;
+      return result;
     }
     ++result.in_memory_hash_joins;
-    const bool integer_key =
-        SingleIntegerJoinKey(left.schema, left_columns) &&
-        SingleIntegerJoinKey(right.schema, right_columns);
-    if (integer_key) {
-      std::unordered_multimap<int64_t, const Row*> buckets;
-      buckets.reserve(right.rows.size());
-      for (const Row& row : right.rows) {
-        if (!HasNullKey(row, right_columns)) {
-          buckets.emplace(IntegerJoinKey(row, right_columns[0]), &row);
-        }
-      }
-      for (const Row& left_row : left.rows) {
-        bool matched = false;
-        if (!HasNullKey(left_row, left_columns)) {
-          const int64_t key = IntegerJoinKey(left_row, left_columns[0]);
-          const auto [begin, end] = buckets.equal_range(key);
-          for (auto iter = begin; iter != end; ++iter) {
-            ++result.join_comparisons;
-            Row combined = left_row + *iter->second;
-            if (matches(combined)) {
-              result.AddRow(std::move(combined));
-              matched = true;
-            }
-          }
-        }
-        if (!matched) emit_unmatched(left_row);
-      }
-    } else {
-      std::unordered_multimap<std::string, const Row*> buckets;
-      buckets.reserve(right.rows.size());
-      for (const Row& row : right.rows) {
-        if (!HasNullKey(row, right_columns)) {
-          buckets.emplace(EncodeJoinKey(row, right_columns), &row);
-        }
-      }
-      for (const Row& left_row : left.rows) {
-        bool matched = false;
-        if (!HasNullKey(left_row, left_columns)) {
-          const std::string key = EncodeJoinKey(left_row, left_columns);
-          const auto [begin, end] = buckets.equal_range(key);
-          for (auto iter = begin; iter != end; ++iter) {
-            ++result.join_comparisons;
-            Row combined = left_row + *iter->second;
-            if (matches(combined)) {
-              result.AddRow(std::move(combined));
-              matched = true;
-            }
-          }
-        }
-        if (!matched) emit_unmatched(left_row);
-      }
-    }
+    const bool left_join = source.join_type == JoinType::kLeft;
+    const size_t workers = InMemoryJoinWorkers(left, right, residual);
+    ResidentHashJoin(left, right, left_columns, right_columns, matches,
+                     left_join, mode, workers, &result.join_comparisons,
+                     [&](Row&& row) { result.AddRow(std::move(row)); });
   }
   result.FinishSpill();
   result.peak_intermediate_rows =
@@ -2129,47 +2569,130 @@ Relation Join(TransactionContext& context, Relation left, Relation right,
   return result;
 }
 
-Relation InnerJoin(TransactionContext& context, Relation left, Relation right,
+bool IsFilterJoin(const SelectSource& source) {
+  return source.join_type == JoinType::kSemi ||
+         source.join_type == JoinType::kAnti ||
+         source.join_type == JoinType::kAntiNullAware;
+}
+
+SemiJoinKind SemiJoinKindOf(JoinType type) {
+  if (type == JoinType::kAnti) return SemiJoinKind::kAnti;
+  if (type == JoinType::kAntiNullAware) return SemiJoinKind::kNullAwareAnti;
+  return SemiJoinKind::kSemi;
+}
+
+// Semi or anti join of `probe` with the semi/anti `source`, loaded as `build`:
+// keeps each row of `probe` at most once and adds no columns. Probing stops at
+// the first build row matching the key and the residual join predicates.
+Relation FilterJoin(TransactionContext& context, Relation probe,
+                    Relation build, const SelectSource& source,
+                    const Scope* outer, const CteMap& ctes) {
+  const auto join_begin = std::chrono::steady_clock::now();
+  Relation result = JoinHeader(probe, build);
+  result.schema = probe.schema;
+  const Schema combined = probe.schema + build.schema;
+  const std::vector<Expression> predicates =
+      SplitConjuncts(source.join_condition);
+  std::vector<slot_t> probe_columns;
+  std::vector<slot_t> build_columns;
+  for (const EqualityKey& key :
+       EqualityKeys(probe.schema, build.schema, predicates)) {
+    probe_columns.push_back(static_cast<slot_t>(key.left));
+    build_columns.push_back(static_cast<slot_t>(key.right));
+  }
+  const std::vector<Expression> residual =
+      ResidualJoinPredicates(probe.schema, build.schema, predicates);
+  const std::vector<BoundExpression> bound_residual =
+      Bind(residual, combined, outer);
+  if (probe_columns.empty()) {
+    ++result.nested_loop_joins;
+  } else {
+    ++result.hash_joins;
+  }
+
+  SemiJoinTable table(SemiJoinKindOf(source.join_type),
+                      std::move(build_columns), !residual.empty());
+  build.FinishSpill();
+  build.ForEachRow([&](const Row& row) { table.Insert(row); });
+  build = Relation();
+
+  auto passes = [&](const Row& row) {
+    if (residual.empty()) return table.Passes(row, probe_columns);
+    return table.Passes(row, probe_columns, [&](const Row& candidate) {
+      ++result.join_comparisons;
+      const Row joined = row + candidate;
+      Scope scope{&joined, &combined, outer};
+      for (size_t i = 0; i < residual.size(); ++i) {
+        if (!Truthy(Evaluate(residual[i], scope, nullptr, context, ctes,
+                             &bound_residual[i]))) {
+          return false;
+        }
+      }
+      return true;
+    });
+  };
+  probe.FinishSpill();
+  for (Row& row : probe.rows) {
+    if (passes(row)) result.AddRow(std::move(row));
+  }
+  if (probe.HasSpill()) {
+    probe.rows.clear();
+    probe.ForEachRow([&](const Row& row) {
+      if (passes(row)) result.AddRow(Row(row));
+    });
+  }
+  result.FinishSpill();
+  if (active_runtime) {
+    if (table.Kind() == SemiJoinKind::kSemi) {
+      ++active_runtime->semi_joins;
+    } else {
+      ++active_runtime->anti_joins;
+    }
+    active_runtime->join_ms += ElapsedMs(join_begin);
+  }
+  return result;
+}
+
+// Inner join of `left` and `right` pushing every joined row to `emit`.
+// `result` must come from JoinHeader(left, right); its join counters are
+// updated but no rows are added to it.
+void InnerJoinInto(TransactionContext& context, Relation left, Relation right,
                    const std::vector<Expression>& predicates,
-                   const Scope* outer, const CteMap& ctes) {
+                   const Scope* outer, const CteMap& ctes, Relation* result,
+                   const RowSink& emit) {
   const auto join_begin = std::chrono::steady_clock::now();
-  Relation result;
-  result.schema = left.schema + right.schema;
-  result.hash_joins = left.hash_joins + right.hash_joins;
-  result.hybrid_hash_joins = left.hybrid_hash_joins + right.hybrid_hash_joins;
-  result.in_memory_hash_joins =
-      left.in_memory_hash_joins + right.in_memory_hash_joins;
-  result.nested_loop_joins = left.nested_loop_joins + right.nested_loop_joins;
-  result.join_comparisons = left.join_comparisons + right.join_comparisons;
-  result.peak_intermediate_rows =
-      std::max(left.peak_intermediate_rows, right.peak_intermediate_rows);
+  const ScopedMemoryContext memory(MemoryContext::Current().Child("hash_join"));
   const std::vector<EqualityKey> equality_keys =
       EqualityKeys(left.schema, right.schema, predicates);
   const std::vector<Expression> residual =
       ResidualJoinPredicates(left.schema, right.schema, predicates);
+  const std::vector<BoundExpression> bound_residual =
+      Bind(residual, result->schema, outer);
 
   auto matches = [&](const Row& combined) {
-    if (residual.empty()) return true;
-    Scope scope{&combined, &result.schema, outer};
-    return std::all_of(
-        residual.begin(), residual.end(), [&](const Expression& predicate) {
-          return Truthy(Evaluate(predicate, scope, nullptr, context, ctes));
-        });
+    Scope scope{&combined, &result->schema, outer};
+    for (size_t i = 0; i < residual.size(); ++i) {
+      if (!Truthy(Evaluate(residual[i], scope, nullptr, context, ctes,
+                           &bound_residual[i]))) {
+        return false;
+      }
+    }
+    return true;
   };
 
   if (equality_keys.empty()) {
-    ++result.nested_loop_joins;
+    ++result->nested_loop_joins;
     left.FinishSpill();
     right.FinishSpill();
     left.ForEachRow([&](const Row& left_row) {
       right.ForEachRow([&](const Row& right_row) {
-        ++result.join_comparisons;
+        ++result->join_comparisons;
         Row combined = left_row + right_row;
-        if (matches(combined)) result.AddRow(std::move(combined));
+        if (matches(combined)) emit(std::move(combined));
       });
     });
   } else {
-    ++result.hash_joins;
+    ++result->hash_joins;
     std::vector<slot_t> left_columns;
     std::vector<slot_t> right_columns;
     left_columns.reserve(equality_keys.size());
@@ -2178,63 +2701,31 @@ Relation InnerJoin(TransactionContext& context, Relation left, Relation right,
       left_columns.push_back(static_cast<slot_t>(key.left));
       right_columns.push_back(static_cast<slot_t>(key.right));
     }
-    if (ShouldHybridJoin(left, right)) {
-      ++result.hybrid_hash_joins;
-      Relation joined = HybridHashJoin(
-          std::move(left), std::move(right), left_columns, right_columns,
-          matches, false, &result.join_comparisons);
-      joined.hash_joins = result.hash_joins;
-      joined.hybrid_hash_joins = result.hybrid_hash_joins;
-      joined.in_memory_hash_joins = result.in_memory_hash_joins;
-      joined.nested_loop_joins = result.nested_loop_joins;
-      joined.join_comparisons = result.join_comparisons;
+    const HashJoinMode mode = ChooseHashJoinMode(left, right);
+    if (mode == HashJoinMode::kHybrid) {
+      ++result->hybrid_hash_joins;
+      HybridHashJoin(std::move(left), std::move(right), left_columns,
+                     right_columns, matches, false, &result->join_comparisons,
+                     emit);
       if (active_runtime) active_runtime->join_ms += ElapsedMs(join_begin);
-      return joined;
-    }
-    ++result.in_memory_hash_joins;
-    const bool integer_key =
-        SingleIntegerJoinKey(left.schema, left_columns) &&
-        SingleIntegerJoinKey(right.schema, right_columns);
-    if (integer_key) {
-      std::unordered_multimap<int64_t, const Row*> buckets;
-      buckets.reserve(right.rows.size());
-      for (const Row& row : right.rows) {
-        if (HasNullKey(row, right_columns)) continue;
-        buckets.emplace(IntegerJoinKey(row, right_columns[0]), &row);
-      }
-      for (const Row& left_row : left.rows) {
-        if (HasNullKey(left_row, left_columns)) continue;
-        const int64_t key = IntegerJoinKey(left_row, left_columns[0]);
-        const auto [begin, end] = buckets.equal_range(key);
-        for (auto iter = begin; iter != end; ++iter) {
-          ++result.join_comparisons;
-          Row combined = left_row + *iter->second;
-          if (matches(combined)) result.AddRow(std::move(combined));
-        }
-      }
-    } else {
-      std::unordered_multimap<std::string, const Row*> buckets;
-      buckets.reserve(right.rows.size());
-      for (const Row& row : right.rows) {
-        if (HasNullKey(row, right_columns)) continue;
-        buckets.emplace(EncodeJoinKey(row, right_columns), &row);
-      }
-      for (const Row& left_row : left.rows) {
-        if (HasNullKey(left_row, left_columns)) continue;
-        const std::string key = EncodeJoinKey(left_row, left_columns);
-        const auto [begin, end] = buckets.equal_range(key);
-        for (auto iter = begin; iter != end; ++iter) {
-          ++result.join_comparisons;
-          Row combined = left_row + *iter->second;
-          if (matches(combined)) result.AddRow(std::move(combined));
-        }
-      }
+      return;
     }
+    ++result->in_memory_hash_joins;
+    const size_t workers = InMemoryJoinWorkers(left, right, residual);
+    ResidentHashJoin(left, right, left_columns, right_columns, matches, false,
+                     mode, workers, &result->join_comparisons, emit);
   }
-  result.FinishSpill();
-  result.peak_intermediate_rows =
-      std::max(result.peak_intermediate_rows, result.TotalRows());
   if (active_runtime) active_runtime->join_ms += ElapsedMs(join_begin);
+}
+
+Relation InnerJoin(TransactionContext& context, Relation left, Relation right,
+                   const std::vector<Expression>& predicates,
+                   const Scope* outer, const CteMap& ctes) {
+  Relation result = JoinHeader(left, right);
+  InnerJoinInto(context, std::move(left), std::move(right), predicates, outer,
+                ctes, &result,
+                [&](Row&& row) { result.AddRow(std::move(row)); });
+  result.FinishSpill();
   return result;
 }
 
@@ -2244,15 +2735,345 @@ bool IsSubset(const std::unordered_set<size_t>& values,
                      [&](size_t value) { return superset.contains(value); });
 }
 
-Relation BuildInput(TransactionContext& context,
-                    const SelectStatement& statement, const Scope* outer,
-                    const CteMap& ctes, bool* where_fully_applied) {
+// Payload columns a deferred join leaves to a LateMaterializer.
+struct LatePlan {
+  // Header of the joined rows, which hold RowPositions instead of payload.
+  Relation header;
+  std::vector<LateMaterializer::Fetch> fetches;
+  std::vector<LateMaterializer::Column> layout;
+};
+
+// Head of a query pipeline: the FROM clause either as a materialized
+// relation, or, when it ends in inner joins, as a source whose rows stream
+// through those joins into the consumers. Joins against resident build sides
+// are JoinPipeline stages; a last join that has to spill is left to
+// InnerJoinInto as `build`, which is only set while `stages` is empty.
+struct PipelineInput {
+  explicit PipelineInput(Relation input) : relation(std::move(input)) {}
+
+  // Materialized rows, or the header (schema and join counters) of the
+  // deferred joins.
+  Relation relation;
+  std::optional<Relation> probe;
+  std::optional<Relation> build;
+  std::vector<Expression> join_predicates;
+  // Build sides of `stages`, which point into their rows.
+  std::deque<Relation> stage_builds;
+  JoinPipeline stages;
+  // Set when the deferred join's inputs carry RowPositions; `relation` then
+  // has the schema of the rows after their payload is fetched.
+  std::optional<LatePlan> late;
+};
+
+// Copies the join counters, but neither rows nor schema, of `from`.
+void CopyJoinCounters(const Relation& from, Relation* to) {
+  to->hash_joins = from.hash_joins;
+  to->hybrid_hash_joins = from.hybrid_hash_joins;
+  to->in_memory_hash_joins = from.in_memory_hash_joins;
+  to->nested_loop_joins = from.nested_loop_joins;
+  to->join_comparisons = from.join_comparisons;
+  to->peak_intermediate_rows = from.peak_intermediate_rows;
+}
+
+// Schema and join counters of `relation`, without its rows.
+Relation HeaderOf(const Relation& relation) {
+  Relation header;
+  header.schema = relation.schema;
+  CopyJoinCounters(relation, &header);
+  return header;
+}
+
+// Appends the inner join of rows of `probe` with `build` on `predicates` to
+// `stages`, keeping `build` in `builds`. `header` must already have the
+// joined schema; its join counters are updated.
+void AddJoinStage(TransactionContext& context, const Schema& probe,
+                  Relation build, const std::vector<Expression>& predicates,
+                  const Scope* outer, const CteMap& ctes, Relation* header,
+                  std::deque<Relation>* builds, JoinPipeline* stages) {
+  std::vector<slot_t> probe_columns;
+  std::vector<slot_t> build_columns;
+  for (const EqualityKey& key : EqualityKeys(probe, build.schema, predicates)) {
+    probe_columns.push_back(static_cast<slot_t>(key.left));
+    build_columns.push_back(static_cast<slot_t>(key.right));
+  }
+  std::vector<Expression> residual =
+      ResidualJoinPredicates(probe, build.schema, predicates);
+  JoinPipeline::MatchFn matches;
+  if (!residual.empty()) {
+    std::vector<BoundExpression> bound = Bind(residual, header->schema, outer);
+    matches = [&context, &ctes, outer, schema = header->schema,
+               residual = std::move(residual),
+               bound = std::move(bound)](const Row& combined) {
+      Scope scope{&combined, &schema, outer};
+      for (size_t i = 0; i < residual.size(); ++i) {
+        if (!Truthy(Evaluate(residual[i], scope, nullptr, context, ctes,
+                             &bound[i]))) {
+          return false;
+        }
+      }
+      return true;
+    };
+  }
+  const bool integer_key = SingleIntegerJoinKey(probe, probe_columns) &&
+                           SingleIntegerJoinKey(build.schema, build_columns);
+  builds->push_back(std::move(build));
+  if (probe_columns.empty()) {
+    ++header->nested_loop_joins;
+    stages->AddNestedLoopStage(builds->back().rows, std::move(matches));
+    return;
+  }
+  ++header->hash_joins;
+  ++header->in_memory_hash_joins;
+  stages->AddHashStage(builds->back().rows, std::move(probe_columns),
+                       std::move(build_columns), integer_key,
+                       std::move(matches));
+}
+
+// Streams every row of `source` through `stages` into `emit`. A resident
+// source is probed a morsel per worker; residual predicates of a stage never
+// run a subquery, so they need not stay on the query thread.
+void StreamJoin(Relation& source, const JoinPipeline& stages,
+                size_t* comparisons, const RowSink& emit) {
+  source.FinishSpill();
+  const size_t workers =
+      source.HasSpill() ? 1 : JoinWorkerCount(source.rows.size());
+  if (workers <= 1) {
+    source.ForEachRow(
+        [&](const Row& row) { stages.Probe(row, emit, comparisons); });
+    return;
+  }
+  std::atomic<size_t> probed{0};
+  ProbeMorsels(
+      source.rows.size(), workers,
+      [&](size_t begin, size_t end, std::vector<Row>* out) {
+        size_t local = 0;
+        for (size_t i = begin; i < end; ++i) {
+          stages.Probe(
+              source.rows[i],
+              [&](Row&& row) { out->push_back(std::move(row)); }, &local);
+        }
+        probed += local;
+      },
+      emit);
+  *comparisons += probed;
+}
+
+// Joined rows of `source` streamed through `stages`, with `header`'s schema
+// and join counters; a pipeline breaker.
+Relation MaterializeStream(Relation source, const JoinPipeline& stages,
+                           const Relation& header) {
+  const auto join_begin = std::chrono::steady_clock::now();
+  Relation joined = HeaderOf(header);
+  StreamJoin(source, stages, &joined.join_comparisons,
+             [&](Row&& row) { joined.AddRow(std::move(row)); });
+  joined.FinishSpill();
+  if (active_runtime) active_runtime->join_ms += ElapsedMs(join_begin);
+  return joined;
+}
+
+// Pushes every input row to `sink`, running the deferred joins if any.
+void ProduceRows(TransactionContext& context, PipelineInput& input,
+                 const Scope* outer, const CteMap& ctes, const RowSink& sink) {
+  if (input.probe) {
+    size_t pipelined = 0;
+    std::optional<LateMaterializer> late;
+    if (input.late) {
+      late.emplace(context.txn_, input.late->fetches, input.late->layout,
+                   sink);
+    }
+    Relation* header = late ? &input.late->header : &input.relation;
+    const RowSink emit = [&](Row&& row) {
+      ++pipelined;
+      if (late) {
+        late->Add(std::move(row));
+      } else {
+        sink(std::move(row));
+      }
+    };
+    if (input.build) {
+      InnerJoinInto(context, std::move(*input.probe), std::move(*input.build),
+                    input.join_predicates, outer, ctes, header, emit);
+    } else {
+      const auto join_begin = std::chrono::steady_clock::now();
+      StreamJoin(*input.probe, input.stages, &header->join_comparisons, emit);
+      if (active_runtime) active_runtime->join_ms += ElapsedMs(join_begin);
+    }
+    input.probe.reset();
+    input.build.reset();
+    input.stages = JoinPipeline();
+    input.stage_builds.clear();
+    if (late) {
+      late->Finish();
+      CopyJoinCounters(input.late->header, &input.relation);
+      if (active_runtime) {
+        active_runtime->late_materialized_rows += pipelined;
+        active_runtime->late_fetched_rows += late->FetchedRows();
+      }
+    }
+    if (active_runtime) active_runtime->pipelined_rows += pipelined;
+    return;
+  }
+  Relation& relation = input.relation;
+  relation.FinishSpill();
+  for (Row& row : relation.rows) sink(std::move(row));
+  relation.rows.clear();
+  relation.rows.shrink_to_fit();
+  relation.ReleaseCharge();
+  if (relation.spill) {
+    relation.spill->ForEachRow([&](const Row& row) { sink(Row(row)); });
+  }
+  if (relation.spill_tail_) {
+    relation.spill_tail_->ForEachRow([&](const Row& row) { sink(Row(row)); });
+  }
+}
+
+// Bloom and min/max filter on the join keys of base relation `idx`, built
+// from the smallest loaded neighbour joined to it by column equalities that
+// is itself selective: filtered by local predicates or a pushed key filter,
+// or derived from a subquery. Every equality with that neighbour becomes a
+// key column, so keys of any type and of several columns are covered. The
+// filter's columns are slots of `idx`'s table schema. Returns nullptr when
+// no neighbour qualifies; an unfiltered base table holds its whole key
+// domain, so a filter built from it would reject nothing.
+std::unique_ptr<RuntimeFilter> BuildJoinRuntimeFilter(
+    const SelectStatement& statement, size_t idx,
+    const std::vector<PredicateInfo>& predicates,
+    const std::vector<std::vector<Expression>>& local_predicates,
+    const std::vector<bool>& base_sources, const std::vector<bool>& loaded,
+    const std::vector<slot_t>& projection, std::vector<Relation>* relations) {
+  const auto joined_with = [&](const PredicateInfo& predicate)
+      -> std::optional<size_t> {
+    if (!predicate.resolved || predicate.contains_query ||
+        predicate.sources.size() != 2 || !predicate.sources.contains(idx) ||
+        !IsColumnEqualityPredicate(predicate.expression)) {
+      return std::nullopt;
+    }
+    size_t other = *predicate.sources.begin();
+    if (other == idx) other = *std::next(predicate.sources.begin());
+    if (!loaded[other]) return std::nullopt;
+    return other;
+  };
+  std::optional<size_t> driver;
+  for (const PredicateInfo& predicate : predicates) {
+    const std::optional<size_t> other = joined_with(predicate);
+    if (!other) continue;
+    const bool selective =
+        !base_sources[*other] || !local_predicates[*other].empty() ||
+        (active_runtime && active_runtime->table_key_filters.contains(
+                               statement.Sources()[*other].table));
+    if (!selective) continue;
+    if (!driver || (*relations)[*other].TotalRows() <
+                       (*relations)[*driver].TotalRows()) {
+      driver = other;
+    }
+  }
+  if (!driver || (*relations)[*driver].TotalRows() > kMaxRuntimeFilterKeys) {
+    return nullptr;
+  }
+  Relation& build = (*relations)[*driver];
+  const Schema& probe_schema = (*relations)[idx].schema;
+  std::vector<slot_t> probe_columns;
+  std::vector<slot_t> build_columns;
+  for (const PredicateInfo& predicate : predicates) {
+    if (joined_with(predicate) != driver) continue;
+    if (probe_columns.size() == kMaxRuntimeFilterColumns) break;
+    const BinaryExpression& binary =
+        predicate.expression->AsBinaryExpression();
+    const ColumnName& lhs = binary.Left()->AsColumnValue().GetColumnName();
+    const ColumnName& rhs = binary.Right()->AsColumnValue().GetColumnName();
+    std::optional<size_t> probe_column = LocalColumnOffset(probe_schema, lhs);
+    std::optional<size_t> build_column = LocalColumnOffset(build.schema, rhs);
+    if (!probe_column || !build_column) {
+      probe_column = LocalColumnOffset(probe_schema, rhs);
+      build_column = LocalColumnOffset(build.schema, lhs);
+    }
+    if (!probe_column || !build_column) continue;
+    const auto probe_slot = static_cast<slot_t>(*probe_column);
+    if (probe_schema.GetColumn(probe_slot).Type() !=
+            build.schema.GetColumn(*build_column).Type() ||
+        std::find(projection.begin(), projection.end(), probe_slot) ==
+            projection.end() ||
+        std::find(probe_columns.begin(), probe_columns.end(), probe_slot) !=
+            probe_columns.end()) {
+      continue;
+    }
+    probe_columns.push_back(probe_slot);
+    build_columns.push_back(static_cast<slot_t>(*build_column));
+  }
+  if (probe_columns.empty()) return nullptr;
+  auto filter = std::make_unique<RuntimeFilter>(std::move(probe_columns),
+                                                build.TotalRows());
+  build.FinishSpill();
+  build.ForEachRow(
+      [&](const Row& row) { filter->Insert(row, build_columns); });
+  return filter;
+}
+
+// Turns `input`, a deferred join of sources in `join_order`, into one that
+// fetches payload columns after the join. `scanned[i]` holds the table
+// columns source i was loaded with and `required[i]` those the query needs
+// from it, or nothing when source i was loaded whole; `loaded[i]` is the
+// schema source i was loaded with, RowPosition column included.
+void PlanLateMaterialization(TransactionContext& context,
+                             const SelectStatement& statement,
+                             const std::vector<size_t>& join_order,
+                             const std::vector<Schema>& loaded,
+                             const std::vector<std::vector<slot_t>>& scanned,
+                             const std::vector<std::vector<slot_t>>& required,
+                             PipelineInput* input) {
+  LatePlan plan{input->relation, {}, {}};
+  std::vector<Column> columns;
+  slot_t offset = 0;
+  for (size_t source : join_order) {
+    const Schema& schema = loaded[source];
+    if (required[source].empty()) {
+      for (slot_t i = 0; i < schema.ColumnCount(); ++i) {
+        plan.layout.push_back({LateMaterializer::kJoined,
+                               static_cast<slot_t>(offset + i)});
+        columns.push_back(schema.GetColumn(i));
+      }
+      offset += schema.ColumnCount();
+      continue;
+    }
+    const SelectSource& from = statement.Sources()[source];
+    std::shared_ptr<Table> table = context.GetTable(from.table).Value();
+    const std::string qualifier = from.alias.empty() ? from.table : from.alias;
+    const Schema wide =
+        QualifySchema(ProjectSchema(table->GetSchema(), required[source]),
+                      qualifier);
+    const size_t fetch = plan.fetches.size();
+    plan.fetches.push_back(
+        {table, static_cast<slot_t>(offset + scanned[source].size())});
+    for (size_t i = 0; i < required[source].size(); ++i) {
+      const slot_t column = required[source][i];
+      const auto found = std::find(scanned[source].begin(),
+                                   scanned[source].end(), column);
+      if (found == scanned[source].end()) {
+        plan.layout.push_back({fetch, column});
+      } else {
+        plan.layout.push_back(
+            {LateMaterializer::kJoined,
+             static_cast<slot_t>(
+                 offset + std::distance(scanned[source].begin(), found))});
+      }
+      columns.push_back(wide.GetColumn(i));
+    }
+    offset += schema.ColumnCount();
+  }
+  input->relation.schema = Schema("", std::move(columns));
+  input->late = std::move(plan);
+}
+
+PipelineInput BuildPipelineInput(TransactionContext& context,
+                                 const SelectStatement& statement,
+                                 const Scope* outer, const CteMap& ctes,
+                                 bool* where_fully_applied) {
   *where_fully_applied = false;
   if (statement.Sources().empty()) {
     Relation singleton;
     singleton.rows.emplace_back();
     singleton.peak_intermediate_rows = 1;
-    return singleton;
+    return PipelineInput(std::move(singleton));
   }
 
   std::vector<Relation> relations(statement.Sources().size());
@@ -2260,7 +3081,8 @@ Relation BuildInput(TransactionContext& context,
   std::vector<std::vector<slot_t>> projections(statement.Sources().size());
   for (size_t i = 0; i < statement.Sources().size(); ++i) {
     const SelectSource& source = statement.Sources()[i];
-    base_sources[i] = !source.query && !ctes.contains(source.table);
+    base_sources[i] = !source.query && !ctes.contains(source.table) &&
+                      !IsFilterJoin(source);
     if (!base_sources[i]) {
       relations[i] = LoadSource(context, source, outer, ctes);
       continue;
@@ -2318,23 +3140,104 @@ Relation BuildInput(TransactionContext& context,
     }
     Relation result = std::move(relations.front());
     for (size_t i = 1; i < relations.size(); ++i) {
-      result = Join(context, std::move(result), std::move(relations[i]),
-                    statement.Sources()[i], outer, ctes);
+      const SelectSource& source = statement.Sources()[i];
+      if (IsFilterJoin(source)) {
+        result = FilterJoin(context, std::move(result),
+                            std::move(relations[i]), source, outer, ctes);
+      } else {
+        result = Join(context, std::move(result), std::move(relations[i]),
+                      source, outer, ctes);
+      }
+    }
+    return PipelineInput(std::move(result));
+  }
+
+  // Semi and anti joins take no part in join ordering. Each one filters the
+  // relation that owns all its outer columns right after that relation is
+  // loaded, or the joined rows when its columns span several relations.
+  std::vector<std::optional<size_t>> filter_owners(relations.size());
+  std::vector<size_t> late_filters;
+  size_t joined_sources = 0;
+  for (size_t i = 0; i < relations.size(); ++i) {
+    if (!IsFilterJoin(statement.Sources()[i])) {
+      ++joined_sources;
+      continue;
+    }
+    std::unordered_set<size_t> owners;
+    bool resolved = true;
+    for (const PredicateInfo& predicate : AnalyzePredicates(
+             statement.Sources()[i].join_condition, relations)) {
+      resolved = resolved && predicate.resolved;
+      owners.insert(predicate.sources.begin(), predicate.sources.end());
+    }
+    owners.erase(i);
+    if (resolved && owners.size() == 1) {
+      filter_owners[i] = *owners.begin();
+    } else {
+      late_filters.push_back(i);
     }
-    return result;
   }
+  auto apply_filter_joins = [&](size_t owner) {
+    for (size_t i = 0; i < relations.size(); ++i) {
+      if (filter_owners[i] != owner) continue;
+      relations[owner] =
+          FilterJoin(context, std::move(relations[owner]),
+                     std::move(relations[i]), statement.Sources()[i], outer,
+                     ctes);
+    }
+  };
 
   std::vector<Expression> all_predicates =
       SplitConjuncts(statement.WhereClause());
   for (size_t i = 1; i < statement.Sources().size(); ++i) {
     const Expression& condition = statement.Sources()[i].join_condition;
-    if (condition) all_predicates.push_back(condition);
+    if (condition && !IsFilterJoin(statement.Sources()[i])) {
+      all_predicates.push_back(condition);
+    }
   }
   std::vector<PredicateInfo> predicates = AnalyzePredicates(
       all_predicates.empty() ? Expression() : CombineConjuncts(all_predicates),
       relations);
   const std::vector<PredicateInfo> where_predicates =
       AnalyzePredicates(statement.WhereClause(), relations);
+
+  // Late materialization: a base table whose required columns include
+  // VARCHAR payload that no predicate reads is scanned by its predicate
+  // columns plus RowPosition, and the payload is fetched after the last
+  // join for the surviving rows only.
+  std::vector<std::vector<slot_t>> late_columns(relations.size());
+  bool late = false;
+  if (joined_sources > 1 && late_filters.empty() &&
+      LateMaterializationEnabled()) {
+    std::unordered_set<ColumnName> predicate_columns;
+    for (const Expression& predicate : all_predicates) {
+      CollectExpressionColumns(predicate, &predicate_columns);
+    }
+    for (const SelectSource& source : statement.Sources()) {
+      if (IsFilterJoin(source)) {
+        CollectExpressionColumns(source.join_condition, &predicate_columns);
+      }
+    }
+    for (size_t i = 0; i < relations.size(); ++i) {
+      if (!base_sources[i] || ReusesBaseRelation(statement.Sources()[i])) {
+        continue;
+      }
+      std::vector<slot_t> scanned;
+      bool payload = false;
+      for (slot_t column : projections[i]) {
+        const Column& definition = relations[i].schema.GetColumn(column);
+        if (References(predicate_columns, definition.Name())) {
+          scanned.push_back(column);
+        } else if (definition.Type() == ValueType::kVarChar) {
+          payload = true;
+        }
+      }
+      if (!payload) continue;
+      late_columns[i] = std::move(projections[i]);
+      projections[i] = std::move(scanned);
+      late = true;
+    }
+  }
   auto locally_evaluable = [&](const PredicateInfo& predicate) {
     if (!predicate.resolved || predicate.sources.size() != 1) return false;
     if (!predicate.contains_query) return true;
@@ -2445,6 +3348,7 @@ Relation BuildInput(TransactionContext& context,
     if (!base_sources[idx]) {
       FilterRelation(context, &relations[idx], local_predicates[idx], outer,
                      ctes);
+      apply_filter_joins(idx);
       loaded[idx] = true;
       continue;
     }
@@ -2555,72 +3459,290 @@ Relation BuildInput(TransactionContext& context,
         }
       }
     }
+    // Without an exact integer key set, fall back to a Bloom and min/max
+    // filter, which takes any key type and multi-column keys.
+    std::unique_ptr<RuntimeFilter> runtime_filter;
+    if (!filter_ptr) {
+      runtime_filter = BuildJoinRuntimeFilter(
+          statement, idx, predicates, local_predicates, base_sources, loaded,
+          projections[idx], &relations);
+      if (runtime_filter && active_runtime) {
+        ++active_runtime->runtime_filter_scans;
+        active_runtime->runtime_filter_keys += runtime_filter->Keys();
+      }
+    }
     relations[idx] = LoadSource(context, statement.Sources()[idx], outer, ctes,
                                 &projections[idx], &local_predicates[idx],
-                                filter_ptr, filter_col);
+                                filter_ptr, filter_col, runtime_filter.get(),
+                                !late_columns[idx].empty());
+    if (runtime_filter && active_runtime) {
+      active_runtime->runtime_filter_rejected += runtime_filter->Rejected();
+    }
+    apply_filter_joins(idx);
     loaded[idx] = true;
   }
 
   size_t first = 0;
   for (size_t i = 1; i < relations.size(); ++i) {
-    if (relations[i].rows.size() < relations[first].rows.size()) first = i;
+    if (IsFilterJoin(statement.Sources()[i])) continue;
+    if (relations[i].TotalRows() < relations[first].TotalRows()) first = i;
+  }
+  std::vector<Schema> loaded_schemas;
+  if (late) {
+    for (const Relation& relation : relations) {
+      loaded_schemas.push_back(relation.schema);
+    }
   }
-  Relation result = std::move(relations[first]);
+  const auto applicable_for = [&](const std::unordered_set<size_t>& after,
+                                  size_t candidate) {
+    std::vector<Expression> applicable;
+    for (const PredicateInfo& predicate : predicates) {
+      if (!predicate.resolved || predicate.contains_query ||
+          predicate.sources.size() < 2 ||
+          !predicate.sources.contains(candidate) ||
+          !IsSubset(predicate.sources, after)) {
+        continue;
+      }
+      applicable.push_back(predicate.expression);
+    }
+    return applicable;
+  };
+  const auto name_of = [&](size_t source) {
+    const SelectSource& from = statement.Sources()[source];
+    return from.alias.empty() ? from.table : from.alias;
+  };
+  const auto names_of = [&](const std::vector<size_t>& sources) {
+    std::string names;
+    for (size_t source : sources) {
+      if (!names.empty()) names += ", ";
+      names += name_of(source);
+    }
+    return names;
+  };
+  const bool adaptive = AdaptiveJoinsEnabled();
+
+  // Sources in the column order of the joined rows; a swapped join puts the
+  // build side's columns first.
+  std::vector<size_t> join_order{first};
+  // Rows stream from `source` through `stages`, whose build sides stay
+  // resident; `header` has the schema and join counters of the rows leaving
+  // the last stage. Only a pipeline breaker materializes the joined rows: a
+  // build side too large to keep resident, a swapped join or a semi/anti
+  // join over several relations.
+  Relation source = std::move(relations[first]);
+  Relation header = HeaderOf(source);
+  std::deque<Relation> stage_builds;
+  JoinPipeline stages;
+  const auto materialize = [&] {
+    if (stages.Empty()) return;
+    source = MaterializeStream(std::move(source), stages, header);
+    stages = JoinPipeline();
+    stage_builds.clear();
+    header = HeaderOf(source);
+  };
   std::unordered_set<size_t> joined{first};
   std::unordered_set<size_t> remaining;
   for (size_t i = 0; i < relations.size(); ++i) {
-    if (i != first) remaining.insert(i);
+    if (i != first && !IsFilterJoin(statement.Sources()[i])) {
+      remaining.insert(i);
+    }
   }
 
+  // Rows the joined rows were estimated at before the last join.
+  size_t result_estimate = source.TotalRows();
+  size_t step = 0;
   while (!remaining.empty()) {
+    // Every candidate is estimated against the rows the joins so far
+    // actually produce, streamed once more through the stages, so an
+    // estimate the last join missed never carries into this choice.
+    struct Candidate {
+      size_t source;
+      bool connected;
+      JoinRowEstimate estimate;
+    };
+    std::vector<Candidate> candidates;
+    size_t result_rows = source.TotalRows();
+    if (remaining.size() > 1 || adaptive) {
+      for (size_t candidate : remaining) {
+        std::unordered_set<size_t> after = joined;
+        after.insert(candidate);
+        const std::vector<Expression> applicable =
+            applicable_for(after, candidate);
+        candidates.push_back(
+            {candidate, !applicable.empty(),
+             JoinRowEstimate(header.schema, relations[candidate],
+                             applicable)});
+      }
+      const auto observe = [&](const Row& row) {
+        for (Candidate& candidate : candidates) candidate.estimate.Add(row);
+      };
+      if (stages.Empty()) {
+        source.FinishSpill();
+        source.ForEachRow(observe);
+      } else {
+        result_rows = 0;
+        size_t comparisons = 0;
+        StreamJoin(source, stages, &comparisons, [&](Row&& row) {
+          ++result_rows;
+          observe(row);
+        });
+      }
+    }
+    std::string replan_event;
+    if (step > 0 && adaptive && active_runtime) {
+      const double q_error =
+          JoinQError(static_cast<double>(result_estimate),
+                     static_cast<double>(result_rows));
+      if (q_error > kAdaptiveJoinMaxQError) {
+        ++active_runtime->adaptive_replans;
+        std::ostringstream event;
+        event << "re-plan after join " << step << ": est~" << result_estimate
+              << " actual=" << result_rows << " (q-error " << std::fixed
+              << std::setprecision(1) << q_error << ")";
+        replan_event = event.str();
+      }
+    }
     size_t next = *remaining.begin();
-    size_t next_estimate = std::numeric_limits<size_t>::max();
-    bool next_connected = false;
-    for (size_t candidate : remaining) {
-      std::unordered_set<size_t> after = joined;
-      after.insert(candidate);
-      std::vector<Expression> applicable;
-      for (const PredicateInfo& predicate : predicates) {
-        if (!predicate.resolved || predicate.contains_query ||
-            predicate.sources.size() < 2 ||
-            !predicate.sources.contains(candidate) ||
-            !IsSubset(predicate.sources, after)) {
+    size_t next_estimate = 0;
+    if (!candidates.empty()) {
+      const Candidate* best = nullptr;
+      for (const Candidate& candidate : candidates) {
+        if (best == nullptr) {
+          best = &candidate;
           continue;
         }
-        applicable.push_back(predicate.expression);
-      }
-      const size_t estimate =
-          EstimateJoinRows(result, relations[candidate], applicable);
-      const bool connected = !applicable.empty();
-      const bool cheaper =
-          estimate < next_estimate ||
-          (estimate == next_estimate &&
-           relations[candidate].rows.size() < relations[next].rows.size());
-      if ((connected && !next_connected) ||
-          (connected == next_connected && cheaper)) {
-        next = candidate;
-        next_estimate = estimate;
-        next_connected = connected;
+        const size_t estimate = candidate.estimate.Rows();
+        const bool cheaper =
+            estimate < best->estimate.Rows() ||
+            (estimate == best->estimate.Rows() &&
+             relations[candidate.source].TotalRows() <
+                 relations[best->source].TotalRows());
+        if ((candidate.connected && !best->connected) ||
+            (candidate.connected == best->connected && cheaper)) {
+          best = &candidate;
+        }
       }
+      next = best->source;
+      next_estimate = best->estimate.Rows();
+    }
+    ++step;
+    if (!replan_event.empty()) {
+      active_runtime->adaptive_events.push_back(
+          std::move(replan_event) + ", next " + name_of(next));
     }
 
     std::unordered_set<size_t> after = joined;
     after.insert(next);
-    std::vector<Expression> applicable;
-    for (const PredicateInfo& predicate : predicates) {
-      if (!predicate.resolved || predicate.contains_query ||
-          predicate.sources.size() < 2 || !predicate.sources.contains(next) ||
-          !IsSubset(predicate.sources, after)) {
-        continue;
+    std::vector<Expression> applicable = applicable_for(after, next);
+    joined.insert(next);
+    remaining.erase(next);
+    const bool last = remaining.empty() && late_filters.empty();
+    // Joins build on their right input; hash the joined rows instead when
+    // they turned out much smaller than the relation joined into them.
+    const bool swap =
+        adaptive && 2 * result_rows < relations[next].TotalRows() &&
+        !EqualityKeys(header.schema, relations[next].schema, applicable)
+             .empty();
+    Relation build;
+    if (swap) {
+      materialize();
+      if (active_runtime) {
+        ++active_runtime->adaptive_build_swaps;
+        std::ostringstream event;
+        event << "swap at join " << step << ": build " << names_of(join_order)
+              << " (" << source.TotalRows() << " rows) instead of "
+              << name_of(next) << " (" << relations[next].TotalRows()
+              << " rows)";
+        if (JoinQError(static_cast<double>(result_estimate),
+                       static_cast<double>(source.TotalRows())) >
+                kAdaptiveJoinMaxQError &&
+            ChooseHashJoinMode(relations[next], source) ==
+                HashJoinMode::kHybrid &&
+            !PreferHybridHashJoin(
+                std::min(result_estimate,
+                         std::numeric_limits<size_t>::max() /
+                             kHashJoinRowBytesEstimate) *
+                kHashJoinRowBytesEstimate)) {
+          event << ", hybrid hash for " << source.TotalRows()
+                << " rows estimated at " << result_estimate;
+        }
+        active_runtime->adaptive_events.push_back(event.str());
       }
-      applicable.push_back(predicate.expression);
+      join_order.insert(join_order.begin(), next);
+      build = std::move(source);
+      source = std::move(relations[next]);
+      header = HeaderOf(source);
+    } else {
+      join_order.push_back(next);
+      build = std::move(relations[next]);
+    }
+    result_estimate = next_estimate;
+    // The last join of an unbroken stream is left to InnerJoinInto, which
+    // can also probe in parallel or radix-partition both inputs.
+    if (!(last && stages.Empty()) && ResidentBuild(build)) {
+      const Schema probe_schema = header.schema;
+      header = JoinHeader(header, build);
+      AddJoinStage(context, probe_schema, std::move(build), applicable, outer,
+                   ctes, &header, &stage_builds, &stages);
+      continue;
+    }
+    materialize();
+    if (last) {
+      // Leave the last join to the consumer so its output is never held.
+      PipelineInput input(JoinHeader(source, build));
+      input.probe = std::move(source);
+      input.build = std::move(build);
+      input.join_predicates = std::move(applicable);
+      if (late) {
+        PlanLateMaterialization(context, statement, join_order,
+                                loaded_schemas, projections, late_columns,
+                                &input);
+      }
+      return input;
     }
-    result = InnerJoin(context, std::move(result), std::move(relations[next]),
+    source = InnerJoin(context, std::move(source), std::move(build),
                        applicable, outer, ctes);
-    joined.insert(next);
-    remaining.erase(next);
+    header = HeaderOf(source);
   }
-  return result;
+  if (late_filters.empty() && !stages.Empty()) {
+    PipelineInput input(std::move(header));
+    input.probe = std::move(source);
+    input.stage_builds = std::move(stage_builds);
+    input.stages = std::move(stages);
+    if (late) {
+      PlanLateMaterialization(context, statement, join_order, loaded_schemas,
+                              projections, late_columns, &input);
+    }
+    return input;
+  }
+  materialize();
+  for (size_t i : late_filters) {
+    source = FilterJoin(context, std::move(source), std::move(relations[i]),
+                        statement.Sources()[i], outer, ctes);
+  }
+  return PipelineInput(std::move(source));
+}
+
+Relation BuildInput(TransactionContext& context,
+                    const SelectStatement& statement, const Scope* outer,
+                    const CteMap& ctes, bool* where_fully_applied) {
+  PipelineInput input =
+      BuildPipelineInput(context, statement, outer, ctes, where_fully_applied);
+  if (!input.probe) return std::move(input.relation);
+  if (input.late || !input.build) {
+    Relation joined;
+    joined.schema = input.relation.schema;
+    ProduceRows(context, input, outer, ctes,
+                [&](Row&& row) { joined.AddRow(std::move(row)); });
+    const size_t held_rows = joined.peak_intermediate_rows;
+    CopyJoinCounters(input.relation, &joined);
+    joined.peak_intermediate_rows =
+        std::max(joined.peak_intermediate_rows, held_rows);
+    joined.FinishSpill();
+    return joined;
+  }
+  return InnerJoin(context, std::move(*input.probe), std::move(*input.build),
+                   input.join_predicates, outer, ctes);
 }
 
 ValueType ValueTypeOf(const Value& value) { return value.type; }
@@ -2633,296 +3755,609 @@ std::string ProjectionName(const NamedExpression& projection, size_t index) {
   return "$expr" + std::to_string(index);
 }
 
-Relation Project(TransactionContext& context, const SelectStatement& statement,
-                 Relation input, const Scope* outer, const CteMap& ctes) {
-  const auto project_begin = std::chrono::steady_clock::now();
-  const bool grouped =
-      !statement.GroupBy().empty() ||
-      std::any_of(statement.SelectList().begin(), statement.SelectList().end(),
-                  [](const NamedExpression& projection) {
-                    return ContainsAggregate(projection.expression);
-                  }) ||
-      ContainsAggregate(statement.Having());
-  std::vector<const AggregateExpression*> aggregate_expressions;
-  std::unordered_set<const AggregateExpression*> seen_aggregates;
-  for (const NamedExpression& projection : statement.SelectList()) {
-    CollectAggregates(projection.expression, &aggregate_expressions,
-                      &seen_aggregates);
-  }
-  CollectAggregates(statement.Having(), &aggregate_expressions,
-                    &seen_aggregates);
+bool IsCountStar(const AggregateExpression& aggregate) {
+  return aggregate.GetType() == AggregationType::kCount &&
+         aggregate.Child()->Type() == TypeTag::kColumnValue &&
+         aggregate.Child()->AsColumnValue().GetColumnName().name == "*";
+}
 
-  struct GroupState {
-    Row representative;
-    size_t accumulator_offset{0};
-  };
-  std::deque<AggregateAccumulator> aggregate_states;
-  auto make_group = [&]() {
-    GroupState group;
-    group.accumulator_offset = aggregate_states.size();
-    for (const AggregateExpression* aggregate : aggregate_expressions) {
-      aggregate_states.emplace_back(aggregate);
-    }
-    return group;
-  };
+bool IsGroupedQuery(const SelectStatement& statement) {
+  return !statement.GroupBy().empty() ||
+         std::any_of(statement.SelectList().begin(),
+                     statement.SelectList().end(),
+                     [](const NamedExpression& projection) {
+                       return ContainsAggregate(projection.expression);
+                     }) ||
+         ContainsAggregate(statement.Having());
+}
 
-  std::vector<GroupState> groups;
-  if (grouped) {
-    input.FinishSpill();
-    auto accumulate_row = [&](Row& row, std::unordered_map<Row, size_t>* offsets,
-                              std::vector<GroupState>* local_groups,
-                              std::deque<AggregateAccumulator>* local_states) {
-      Scope scope{&row, &input.schema, outer};
-      std::vector<Value> key_values;
-      for (const Expression& key : statement.GroupBy()) {
-        key_values.push_back(Evaluate(key, scope, nullptr, context, ctes));
-      }
-      Row key(std::move(key_values));
-      auto [iter, inserted] = offsets->emplace(key, local_groups->size());
-      if (inserted) {
-        GroupState group;
-        group.accumulator_offset = local_states->size();
-        for (const AggregateExpression* aggregate : aggregate_expressions) {
-          local_states->emplace_back(aggregate);
-        }
-        local_groups->push_back(std::move(group));
+// Whether ORDER BY ... LIMIT keeps its first rows in a TopNHeap rather than
+// sorting the whole result.
+bool UsesTopN(const SelectStatement& statement) {
+  return !statement.OrderBy().empty() && statement.Limit() != 0 &&
+         statement.Offset() + statement.Limit() <= kMaxTopNRows;
+}
+
+// Tail of the query pipeline: projected rows on their way through a
+// ResultSink. The output columns take their types from the first row, and
+// ORDER BY keys are encoded against them as rows arrive, on the query
+// thread, so the sort itself can run on several threads even when an ORDER
+// BY key runs a subquery. Rows leaving the sink are collected into a
+// Relation unless Stream() makes the caller pull them with Next().
+class QueryOutput {
+ public:
+  QueryOutput(TransactionContext& context, const SelectStatement& statement,
+              const Scope* outer, const CteMap& ctes,
+              std::vector<Column> columns)
+      : context_(context),
+        statement_(statement),
+        outer_(outer),
+        ctes_(ctes),
+        columns_(std::move(columns)),
+        sink_(statement.Distinct(), statement.Offset(), statement.Limit()) {
+    output_.schema = Schema("", columns_);
+  }
+  QueryOutput(const QueryOutput&) = delete;
+  QueryOutput& operator=(const QueryOutput&) = delete;
+
+  void Stream() { collect_ = false; }
+
+  // Returns false once the result is complete.
+  bool Push(Row row) {
+    if (!typed_) {
+      // Column types follow the first projected row.
+      for (size_t i = 0; i < columns_.size(); ++i) {
+        columns_[i] = Column(columns_[i].Name(), ValueTypeOf(row[i]));
       }
-      GroupState& group = (*local_groups)[iter->second];
-      for (size_t i = 0; i < aggregate_expressions.size(); ++i) {
-        AggregateAccumulator& accumulator =
-            (*local_states)[group.accumulator_offset + i];
-        const AggregateExpression& aggregate = *accumulator.expression;
-        const bool count_star =
-            aggregate.GetType() == AggregationType::kCount &&
-            aggregate.Child()->Type() == TypeTag::kColumnValue &&
-            aggregate.Child()->AsColumnValue().GetColumnName().name == "*";
-        accumulator.Add(
-            count_star
-                ? Value(1)
-                : Evaluate(aggregate.Child(), scope, nullptr, context, ctes));
-        if (active_runtime) ++active_runtime->aggregate_updates;
-      }
-      if (inserted) group.representative = std::move(row);
-      if (active_runtime) ++active_runtime->aggregate_input_rows;
-    };
+      output_.schema = Schema("", columns_);
+      typed_ = true;
+      if (!statement_.OrderBy().empty()) StartSort();
+    }
+    const bool more = sink_.Push(std::move(row));
+    if (collect_) Collect();
+    return more;
+  }
 
-    const bool partition_agg =
-        !statement.GroupBy().empty() &&
-        (input.HasSpill() ||
-         !QueryMemoryBudget::Global().CanReserve(
-             std::max<size_t>(1, input.TotalRows()) * 128));
-    if (partition_agg) {
-      std::vector<SpillFile> parts(kSpillPartitions);
-      input.ForEachRow([&](const Row& row) {
-        Scope scope{&row, &input.schema, outer};
-        std::vector<Value> key_values;
-        for (const Expression& key : statement.GroupBy()) {
-          key_values.push_back(Evaluate(key, scope, nullptr, context, ctes));
-        }
-        Row key(std::move(key_values));
-        parts[SpillPartitionOf(key.EncodeMemcomparableFormat(),
-                               kSpillPartitions)]
-            .Append(row);
-      });
-      for (SpillFile& part : parts) {
-        part.FinishWriting();
-      }
-      input.rows.clear();
-      input.rows.shrink_to_fit();
-      input.ReleaseCharge();
-      for (size_t part = 0; part < kSpillPartitions; ++part) {
-        std::unordered_map<Row, size_t> offsets;
-        std::vector<GroupState> local_groups;
-        std::deque<AggregateAccumulator> local_states;
-        parts[part].ForEachRow([&](const Row& row) {
-          Row copy = row;
-          accumulate_row(copy, &offsets, &local_groups, &local_states);
+  void Finish() {
+    const auto sort_begin = std::chrono::steady_clock::now();
+    sink_.Finish();
+    if (sink_.Ordered() && active_runtime) {
+      if (sink_.TopN()) ++active_runtime->top_n_sorts;
+      if (sink_.Sort()) NoteSortSpills(*sink_.Sort());
+    }
+    if (collect_) Collect();
+    if (sink_.Ordered() && active_runtime) {
+      active_runtime->sort_ms += ElapsedMs(sort_begin);
+    }
+  }
+
+  bool Next(Row* row) { return sink_.Next(row); }
+
+  [[nodiscard]] size_t SortedRows() const { return sink_.SortedRows(); }
+
+  // The collected result with `input`'s join counters. `held_rows` is the
+  // largest number of rows a breaker upstream kept.
+  Relation TakeResult(const Relation& input, size_t held_rows) {
+    output_.FinishSpill();
+    output_.hash_joins = input.hash_joins;
+    output_.hybrid_hash_joins = input.hybrid_hash_joins;
+    output_.in_memory_hash_joins = input.in_memory_hash_joins;
+    output_.nested_loop_joins = input.nested_loop_joins;
+    output_.join_comparisons = input.join_comparisons;
+    output_.peak_intermediate_rows =
+        std::max({output_.peak_intermediate_rows, input.peak_intermediate_rows,
+                  held_rows, sink_.SortedRows()});
+    return std::move(output_);
+  }
+
+ private:
+  void StartSort() {
+    const size_t workers =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::vector<BoundExpression> bound;
+    for (const auto& term : statement_.OrderBy()) {
+      bound.push_back(Bind(term.expression, output_.schema, outer_));
+    }
+    sink_.OrderBy(
+        [this, bound = std::move(bound)](const Row& row, std::string* key) {
+          key->clear();
+          Scope scope{&row, &output_.schema, outer_};
+          for (size_t i = 0; i < bound.size(); ++i) {
+            const auto& term = statement_.OrderBy()[i];
+            AppendSortKey(Evaluate(term.expression, scope, nullptr, context_,
+                                   ctes_, &bound[i]),
+                          term.ascending, key);
+          }
+        },
+        UsesTopN(statement_), workers);
+  }
+
+  void Collect() {
+    Row row;
+    while (sink_.Next(&row)) output_.AddRow(std::move(row));
+  }
+
+  TransactionContext& context_;
+  const SelectStatement& statement_;
+  const Scope* outer_;
+  const CteMap& ctes_;
+  std::vector<Column> columns_;
+  bool typed_{false};
+  bool collect_{true};
+  ResultSink sink_;
+  Relation output_;
+};
+
+// Hash aggregation stage of the pipeline. Rows are aggregated by a
+// SpillableHashAggregation, which spills partial groups by key hash once the
+// query memory budget runs out. A materialized input can instead be
+// aggregated on several threads with AddParallel().
+class GroupedAggregation {
+ public:
+  using GroupSink =
+      std::function<void(const Row& representative,
+                         const AggregateResultMap& aggregates)>;
+
+  GroupedAggregation(TransactionContext& context,
+                     const SelectStatement& statement, const Schema& schema,
+                     const Scope* outer, const CteMap& ctes)
+      : context_(context),
+        statement_(statement),
+        schema_(schema),
+        outer_(outer),
+        ctes_(ctes),
+        aggregates_(StatementAggregates(statement)),
+        bound_group_by_(Bind(statement.GroupBy(), schema, outer)),
+        bound_arguments_(BindArguments(aggregates_, schema, outer)),
+        serial_(
+            AggregateSpecs(aggregates_),
+            [this](const Row& row, std::string* key) { GroupKey(row, key); },
+            [this](const Row& row, AggregateState* states) {
+              Update(row, states);
+            }) {}
+
+  void Add(const Row& row) {
+    if (active_runtime) {
+      ++active_runtime->aggregate_input_rows;
+      active_runtime->aggregate_updates += aggregates_.size();
+    }
+    serial_.Add(row);
+  }
+
+  // Aggregates the rows of `rows` that pass `where` with a
+  // ParallelHashAggregation on `workers` threads. Grouping keys, aggregate
+  // arguments and `where` are evaluated off the query thread, so none of
+  // them may contain a subquery.
+  void AddParallel(const std::vector<Row>& rows,
+                   const std::function<bool(const Row&)>& where,
+                   size_t workers) {
+    parallel_ = std::make_unique<ParallelHashAggregation>(
+        AggregateSpecs(aggregates_),
+        [this](const Row& row, std::string* key) { GroupKey(row, key); },
+        [this](const Row& row, AggregateState* states) {
+          Update(row, states);
         });
-        // Stash into the shared group vectors used by emit below.
-        const size_t base = groups.size();
-        for (GroupState& group : local_groups) {
-          group.accumulator_offset += aggregate_states.size();
-          groups.push_back(std::move(group));
-        }
-        for (AggregateAccumulator& state : local_states) {
-          aggregate_states.push_back(std::move(state));
-        }
-        (void)base;
+    parallel_->Run((rows.size() + kJoinMorselRows - 1) / kJoinMorselRows,
+                   workers, [&](size_t morsel, const auto& add) {
+                     const size_t end = std::min(
+                         rows.size(), (morsel + 1) * kJoinMorselRows);
+                     for (size_t i = morsel * kJoinMorselRows; i < end; ++i) {
+                       if (where(rows[i])) add(rows[i]);
+                     }
+                   });
+    if (active_runtime) {
+      ++active_runtime->parallel_aggregations;
+      active_runtime->preaggregation_passed_rows += parallel_->PassedRows();
+      active_runtime->aggregate_input_rows += parallel_->InputRows();
+      active_runtime->aggregate_updates +=
+          parallel_->InputRows() * aggregates_.size();
+    }
+  }
+
+  // Emits every group.
+  void Finish(const GroupSink& emit) {
+    size_t group_count = 0;
+    auto emit_states = [&](const Row& representative,
+                           const AggregateState* states) {
+      AggregateResultMap aggregate_results;
+      aggregate_results.reserve(aggregates_.size());
+      for (size_t i = 0; i < aggregates_.size(); ++i) {
+        aggregate_results.emplace(aggregates_[i], states[i].Finish());
       }
-    } else {
-      std::unordered_map<Row, size_t> offsets;
-      input.ForEachRow([&](const Row& row) {
-        Row copy = row;
-        accumulate_row(copy, &offsets, &groups, &aggregate_states);
-      });
-      if (input.TotalRows() == 0 && statement.GroupBy().empty()) {
-        groups.push_back(make_group());
+      emit(representative, aggregate_results);
+      ++group_count;
+    };
+    if (parallel_) {
+      peak_groups_ = parallel_->Groups();
+      parallel_->ForEachGroup(emit_states);
+      parallel_.reset();
+    }
+    serial_.Finish(emit_states);
+    NoteAggregateSpills(serial_);
+    peak_groups_ = std::max(peak_groups_, serial_.PeakGroups());
+    if (group_count == 0 && statement_.GroupBy().empty()) {
+      // An aggregate over no rows still produces one row.
+      std::vector<AggregateState> states;
+      for (const AggregateSpec& spec : AggregateSpecs(aggregates_)) {
+        states.emplace_back(spec.type, spec.distinct);
       }
+      emit_states(Row(), states.data());
+    }
+    if (active_runtime) active_runtime->aggregate_groups += group_count;
+  }
+
+  [[nodiscard]] size_t PeakGroups() const { return peak_groups_; }
+
+ private:
+  static std::vector<BoundExpression> BindArguments(
+      const std::vector<const AggregateExpression*>& aggregates,
+      const Schema& schema, const Scope* outer) {
+    std::vector<BoundExpression> bound;
+    bound.reserve(aggregates.size());
+    for (const AggregateExpression* aggregate : aggregates) {
+      bound.push_back(Bind(aggregate->Child(), schema, outer));
+    }
+    return bound;
+  }
+
+  void GroupKey(const Row& row, std::string* key) const {
+    Scope scope{&row, &schema_, outer_};
+    key->clear();
+    for (size_t i = 0; i < statement_.GroupBy().size(); ++i) {
+      AppendFlatKey(Evaluate(statement_.GroupBy()[i], scope, nullptr,
+                             context_, ctes_, &bound_group_by_[i]),
+                    key);
+    }
+  }
+
+  void Update(const Row& row, AggregateState* states) const {
+    Scope scope{&row, &schema_, outer_};
+    for (size_t i = 0; i < aggregates_.size(); ++i) {
+      const AggregateExpression& aggregate = *aggregates_[i];
+      states[i].Add(IsCountStar(aggregate)
+                        ? Value(1)
+                        : Evaluate(aggregate.Child(), scope, nullptr,
+                                   context_, ctes_, &bound_arguments_[i]));
     }
-    if (active_runtime) active_runtime->aggregate_groups += groups.size();
   }
 
-  Relation output;
-  output.hash_joins = input.hash_joins;
-  output.hybrid_hash_joins = input.hybrid_hash_joins;
-  output.in_memory_hash_joins = input.in_memory_hash_joins;
-  output.nested_loop_joins = input.nested_loop_joins;
-  output.join_comparisons = input.join_comparisons;
-  output.peak_intermediate_rows = input.peak_intermediate_rows;
-  std::vector<Column> output_columns;
+  TransactionContext& context_;
+  const SelectStatement& statement_;
+  const Schema& schema_;
+  const Scope* outer_;
+  const CteMap& ctes_;
+  std::vector<const AggregateExpression*> aggregates_;
+  // GROUP BY keys and aggregate arguments bound for rows of `schema_`.
+  std::vector<BoundExpression> bound_group_by_;
+  std::vector<BoundExpression> bound_arguments_;
+  SpillableHashAggregation serial_;
+  std::unique_ptr<ParallelHashAggregation> parallel_;
+  size_t peak_groups_{0};
+};
+
+// Threads to aggregate `input` with GroupedAggregation::AddParallel, or 1
+// when it has to go row by row: the rows stream from a join or a spill file,
+// or an expression evaluated per input row runs a subquery, which needs the
+// query thread's runtime.
+size_t GroupedAggregationWorkers(const SelectStatement& statement,
+                                 const PipelineInput& input, bool filter) {
+  if (input.probe || input.relation.HasSpill()) return 1;
+  if (filter && ContainsQuery(statement.WhereClause())) return 1;
+  if (std::ranges::any_of(statement.GroupBy(), ContainsQuery) ||
+      std::ranges::any_of(statement.SelectList(),
+                          [](const NamedExpression& projection) {
+                            return ContainsQuery(projection.expression);
+                          }) ||
+      ContainsQuery(statement.Having())) {
+    return 1;
+  }
+  return AggregationWorkerCount(
+      (input.relation.rows.size() + kJoinMorselRows - 1) / kJoinMorselRows);
+}
+
+std::vector<Column> OutputColumns(const SelectStatement& statement,
+                                  const Schema& input) {
+  std::vector<Column> columns;
   for (size_t i = 0; i < statement.SelectList().size(); ++i) {
     const NamedExpression& projection = statement.SelectList()[i];
     if (projection.expression->Type() == TypeTag::kColumnValue &&
         projection.expression->AsColumnValue().GetColumnName().name == "*") {
-      for (size_t column = 0; column < input.schema.ColumnCount(); ++column) {
-        output_columns.emplace_back(input.schema.GetColumn(column).Name().name,
-                                    input.schema.GetColumn(column).Type());
+      for (size_t column = 0; column < input.ColumnCount(); ++column) {
+        columns.emplace_back(input.GetColumn(column).Name().name,
+                             input.GetColumn(column).Type());
       }
     } else {
-      output_columns.emplace_back(ProjectionName(projection, i),
-                                  ValueType::kNull);
+      columns.emplace_back(ProjectionName(projection, i), ValueType::kNull);
     }
   }
+  return columns;
+}
 
-  auto emit = [&](const Row& representative,
-                  const AggregateResultMap* aggregates) {
-    Scope scope{&representative, &input.schema, outer};
-    if (statement.Having() &&
-        !Truthy(Evaluate(statement.Having(), scope, aggregates, context,
-                         ctes))) {
-      return;
+// Reads the rows of a Relation one at a time: the resident rows first,
+// moved out and released once read, then the spilled ones.
+class RelationReader {
+ public:
+  explicit RelationReader(Relation& relation) : relation_(relation) {
+    relation_.FinishSpill();
+  }
+
+  bool Next(Row* row) {
+    if (next_row_ < relation_.rows.size()) {
+      *row = std::move(relation_.rows[next_row_++]);
+      if (next_row_ == relation_.rows.size()) {
+        relation_.rows.clear();
+        relation_.rows.shrink_to_fit();
+        relation_.ReleaseCharge();
+        next_row_ = 0;
+      }
+      return true;
     }
-    std::vector<Value> values;
+    for (; next_file_ < 2; ++next_file_, reading_ = false) {
+      SpillFile* file = next_file_ == 0 ? relation_.spill.get()
+                                        : relation_.spill_tail_.get();
+      if (file == nullptr || file->Empty()) continue;
+      if (!reading_) {
+        file->StartReading();
+        reading_ = true;
+      }
+      if (file->ReadNext(row)) return true;
+    }
+    return false;
+  }
+
+ private:
+  Relation& relation_;
+  size_t next_row_{0};
+  size_t next_file_{0};
+  bool reading_{false};
+};
+
+// Runs WHERE, projection or grouped aggregation, DISTINCT, ORDER BY and
+// OFFSET/LIMIT over `input`; nothing between the FROM clause and the result
+// is materialized except by a pipeline breaker.
+//
+// Run() pushes the whole input through and returns the result. Next()
+// instead pulls one result row at a time, streaming source rows through the
+// joins only as far as the rows asked for need. A grouped query or a last
+// join that has to spill sees every row first, so Next() runs those to the
+// end on its first call. Pulled rows are produced on the query thread, and
+// their time, joins included, counts as project_ms.
+class SelectPipeline {
+ public:
+  SelectPipeline(TransactionContext& context, const SelectStatement& statement,
+                 PipelineInput input, const Scope* outer, const CteMap& ctes,
+                 bool apply_where)
+      : context_(context),
+        statement_(statement),
+        input_(std::move(input)),
+        outer_(outer),
+        ctes_(ctes),
+        filter_(apply_where && statement.WhereClause()),
+        output_(context, statement, outer, ctes,
+                OutputColumns(statement, input_.relation.schema)) {
+    const Schema& schema = input_.relation.schema;
+    if (filter_) bound_where_ = Bind(statement.WhereClause(), schema, outer);
+    bound_having_ = Bind(statement.Having(), schema, outer);
     for (const NamedExpression& projection : statement.SelectList()) {
+      bound_projections_.push_back(Bind(projection.expression, schema, outer));
+    }
+  }
+  SelectPipeline(const SelectPipeline&) = delete;
+  SelectPipeline& operator=(const SelectPipeline&) = delete;
+
+  Relation Run() {
+    const auto pipeline_begin = std::chrono::steady_clock::now();
+    const double join_ms_before = active_runtime ? active_runtime->join_ms : 0;
+    size_t held_rows = 0;
+    if (IsGroupedQuery(statement_)) {
+      // Only the serial aggregation spills, so an input whose groups may not
+      // fit in the budget stays on it.
+      const bool may_spill =
+          !statement_.GroupBy().empty() && !input_.probe &&
+          (input_.relation.HasSpill() ||
+           !MemoryContext::Current().CanReserve(
+               std::max<size_t>(1, input_.relation.TotalRows()) * 128));
+      const ScopedMemoryContext memory(
+          MemoryContext::Current().Child("aggregation"));
+      GroupedAggregation aggregation(context_, statement_,
+                                     input_.relation.schema, outer_, ctes_);
+      const size_t workers =
+          may_spill ? 1
+                    : GroupedAggregationWorkers(statement_, input_, filter_);
+      if (workers > 1) {
+        aggregation.AddParallel(
+            input_.relation.rows,
+            [this](const Row& row) { return PassesWhere(row); }, workers);
+        input_.relation.rows.clear();
+        input_.relation.rows.shrink_to_fit();
+        input_.relation.ReleaseCharge();
+      } else {
+        ProduceRows(context_, input_, outer_, ctes_, [&](Row&& row) {
+          if (PassesWhere(row)) aggregation.Add(row);
+        });
+      }
+      aggregation.Finish([&](const Row& representative,
+                             const AggregateResultMap& aggregates) {
+        Project(representative, &aggregates);
+      });
+      held_rows = aggregation.PeakGroups();
+    } else {
+      ProduceRows(context_, input_, outer_, ctes_, [&](Row&& row) {
+        if (PassesWhere(row)) Project(row, nullptr);
+      });
+    }
+    if (active_runtime) {
+      // Per-row work inside a streamed join is already counted in join_ms.
+      active_runtime->project_ms += ElapsedMs(pipeline_begin) -
+                                    (active_runtime->join_ms - join_ms_before);
+    }
+    output_.Finish();
+    return output_.TakeResult(input_.relation, held_rows);
+  }
+
+  bool Next(Row* row) {
+    if (!started_) Start();
+    if (reader_) return reader_->Next(row);
+    const auto pull_begin = std::chrono::steady_clock::now();
+    bool found = false;
+    while (!(found = output_.Next(row)) && !finished_) {
+      if (!more_ || !PullSource()) FinishStream();
+    }
+    if (active_runtime) active_runtime->project_ms += ElapsedMs(pull_begin);
+    return found;
+  }
+
+  // Schema, join counters and peak held rows of the result, once Next() has
+  // returned false.
+  [[nodiscard]] Relation Counters() const {
+    if (result_) return HeaderOf(*result_);
+    Relation counters = HeaderOf(input_.relation);
+    counters.peak_intermediate_rows =
+        std::max(counters.peak_intermediate_rows, output_.SortedRows());
+    return counters;
+  }
+
+ private:
+  bool PassesWhere(const Row& row) const {
+    if (!filter_) return true;
+    Scope scope{&row, &input_.relation.schema, outer_};
+    return Truthy(Evaluate(statement_.WhereClause(), scope, nullptr, context_,
+                           ctes_, &bound_where_));
+  }
+
+  // Returns false once the result is complete.
+  bool Project(const Row& representative,
+               const AggregateResultMap* aggregates) {
+    Scope scope{&representative, &input_.relation.schema, outer_};
+    if (statement_.Having() &&
+        !Truthy(Evaluate(statement_.Having(), scope, aggregates, context_,
+                         ctes_, &bound_having_))) {
+      return true;
+    }
+    std::vector<Value> values;
+    for (size_t i = 0; i < statement_.SelectList().size(); ++i) {
+      const NamedExpression& projection = statement_.SelectList()[i];
       if (projection.expression->Type() == TypeTag::kColumnValue &&
           projection.expression->AsColumnValue().GetColumnName().name == "*") {
         values.insert(values.end(), representative.values_.begin(),
                       representative.values_.end());
       } else {
         values.push_back(Evaluate(projection.expression, scope, aggregates,
-                                  context, ctes));
-      }
-    }
-    output.AddRow(Row(std::move(values)));
-  };
-
-  if (grouped) {
-    for (const GroupState& group : groups) {
-      AggregateResultMap aggregate_results;
-      aggregate_results.reserve(aggregate_expressions.size());
-      for (size_t i = 0; i < aggregate_expressions.size(); ++i) {
-        const AggregateAccumulator& accumulator =
-            aggregate_states[group.accumulator_offset + i];
-        aggregate_results.emplace(accumulator.expression,
-                                  accumulator.Finish());
+                                  context_, ctes_, &bound_projections_[i]));
       }
-      emit(group.representative, &aggregate_results);
     }
-  } else {
-    input.FinishSpill();
-    input.ForEachRow([&](const Row& row) { emit(row, nullptr); });
+    return output_.Push(Row(std::move(values)));
+  }
+
+  void Start() {
+    started_ = true;
+    if (IsGroupedQuery(statement_) ||
+        (input_.build && !ResidentBuild(*input_.build))) {
+      result_ = Run();
+      reader_.emplace(*result_);
+      return;
+    }
+    output_.Stream();
+    Relation& header = input_.late ? input_.late->header : input_.relation;
+    if (input_.build) {
+      const Schema probe_schema = input_.probe->schema;
+      AddJoinStage(context_, probe_schema, std::move(*input_.build),
+                   input_.join_predicates, outer_, ctes_, &header,
+                   &input_.stage_builds, &input_.stages);
+      input_.build.reset();
+    }
+    if (input_.late) {
+      late_.emplace(context_.txn_, input_.late->fetches, input_.late->layout,
+                    [this](Row&& row) { Consume(row); });
+    }
+    source_.emplace(input_.probe ? *input_.probe : input_.relation);
+  }
+
+  void Consume(const Row& row) {
+    if (PassesWhere(row) && !Project(row, nullptr)) more_ = false;
   }
-  output.FinishSpill();
-  if (!output.rows.empty()) {
-    for (size_t i = 0; i < output_columns.size(); ++i) {
-      output_columns[i] =
-          Column(output_columns[i].Name(), ValueTypeOf(output.rows[0][i]));
+
+  // Streams the next source row into the output; false at the end of the
+  // source.
+  bool PullSource() {
+    Row row;
+    if (!source_->Next(&row)) return false;
+    if (!input_.probe) {
+      Consume(row);
+      return true;
     }
+    Relation& header = late_ ? input_.late->header : input_.relation;
+    input_.stages.Probe(
+        row,
+        [this](Row&& joined) {
+          ++pipelined_;
+          if (late_) {
+            late_->Add(std::move(joined));
+          } else {
+            Consume(joined);
+          }
+        },
+        &header.join_comparisons);
+    return true;
   }
-  output.schema = Schema("", std::move(output_columns));
-  if (active_runtime) active_runtime->project_ms += ElapsedMs(project_begin);
-  return output;
+
+  void FinishStream() {
+    finished_ = true;
+    source_.reset();
+    if (late_) {
+      late_->Finish();
+      CopyJoinCounters(input_.late->header, &input_.relation);
+      if (active_runtime) {
+        active_runtime->late_materialized_rows += pipelined_;
+        active_runtime->late_fetched_rows += late_->FetchedRows();
+      }
+      late_.reset();
+    }
+    if (input_.probe && active_runtime) {
+      active_runtime->pipelined_rows += pipelined_;
+    }
+    input_.probe.reset();
+    input_.stages = JoinPipeline();
+    input_.stage_builds.clear();
+    output_.Finish();
+  }
+
+  TransactionContext& context_;
+  const SelectStatement& statement_;
+  PipelineInput input_;
+  const Scope* outer_;
+  const CteMap& ctes_;
+  const bool filter_;
+  QueryOutput output_;
+  BoundExpression bound_where_;
+  BoundExpression bound_having_;
+  std::vector<BoundExpression> bound_projections_;
+  bool started_{false};
+  bool finished_{false};
+  // False once the result needs no more rows.
+  bool more_{true};
+  std::optional<RelationReader> source_;
+  std::optional<LateMaterializer> late_;
+  size_t pipelined_{0};
+  // Result of Run() when Next() could not stream.
+  std::optional<Relation> result_;
+  std::optional<RelationReader> reader_;
+};
+
+Relation RunPipeline(TransactionContext& context,
+                     const SelectStatement& statement, PipelineInput input,
+                     const Scope* outer, const CteMap& ctes, bool apply_where) {
+  SelectPipeline pipeline(context, statement, std::move(input), outer, ctes,
+                          apply_where);
+  return pipeline.Run();
 }
 
 Relation FinishQuery(TransactionContext& context,
                      const SelectStatement& statement, Relation input,
                      const Scope* outer, const CteMap& ctes,
                      bool apply_where) {
-  if (apply_where && statement.WhereClause()) {
-    const auto filter_begin = std::chrono::steady_clock::now();
-    Relation filtered;
-    filtered.schema = input.schema;
-    filtered.hash_joins = input.hash_joins;
-    filtered.hybrid_hash_joins = input.hybrid_hash_joins;
-    filtered.in_memory_hash_joins = input.in_memory_hash_joins;
-    filtered.nested_loop_joins = input.nested_loop_joins;
-    filtered.join_comparisons = input.join_comparisons;
-    input.FinishSpill();
-    input.ForEachRow([&](const Row& row) {
-      Scope scope{&row, &input.schema, outer};
-      if (Truthy(Evaluate(statement.WhereClause(), scope, nullptr, context,
-                          ctes))) {
-        filtered.AddRow(row);
-      }
-    });
-    filtered.FinishSpill();
-    input = std::move(filtered);
-    if (active_runtime) active_runtime->filter_ms += ElapsedMs(filter_begin);
-  }
-
-  Relation output = Project(context, statement, std::move(input), outer, ctes);
-  if (statement.Distinct()) {
-    std::unordered_set<Row> seen;
-    Relation distinct;
-    distinct.schema = output.schema;
-    output.FinishSpill();
-    output.ForEachRow([&](const Row& row) {
-      if (seen.insert(row).second) distinct.AddRow(row);
-    });
-    distinct.FinishSpill();
-    output = std::move(distinct);
-  }
-  if (!statement.OrderBy().empty()) {
-    const auto sort_begin = std::chrono::steady_clock::now();
-    output.FinishSpill();
-    // External sort when the result does not fit the query memory budget.
-    std::vector<Row> sortable;
-    output.ForEachRow([&](const Row& row) { sortable.push_back(row); });
-    output.rows.clear();
-    output.ReleaseCharge();
-    std::stable_sort(
-        sortable.begin(), sortable.end(),
-        [&](const Row& left, const Row& right) {
-          Scope left_scope{&left, &output.schema, outer};
-          Scope right_scope{&right, &output.schema, outer};
-          for (const auto& key : statement.OrderBy()) {
-            const Value a =
-                Evaluate(key.expression, left_scope, nullptr, context, ctes);
-            const Value b =
-                Evaluate(key.expression, right_scope, nullptr, context, ctes);
-            if (a == b) continue;
-            if (a.IsNull()) return key.ascending;
-            if (b.IsNull()) return !key.ascending;
-            return key.ascending ? a < b : b < a;
-          }
-          return false;
-        });
-    for (Row& row : sortable) {
-      output.AddRow(std::move(row));
-    }
-    output.FinishSpill();
-    if (active_runtime) active_runtime->sort_ms += ElapsedMs(sort_begin);
-  }
-  output.FinishSpill();
-  std::vector<Row> all_rows;
-  output.ForEachRow([&](const Row& row) { all_rows.push_back(row); });
-  const size_t begin = std::min(statement.Offset(), all_rows.size());
-  const size_t available = all_rows.size() - begin;
-  const size_t count = statement.Limit() == 0
-                           ? available
-                           : std::min(statement.Limit(), available);
-  Relation limited;
-  limited.schema = output.schema;
-  limited.hash_joins = output.hash_joins;
-  limited.hybrid_hash_joins = output.hybrid_hash_joins;
-  limited.in_memory_hash_joins = output.in_memory_hash_joins;
-  limited.nested_loop_joins = output.nested_loop_joins;
-  limited.join_comparisons = output.join_comparisons;
-  for (size_t i = 0; i < count; ++i) {
-    limited.AddRow(std::move(all_rows[begin + i]));
-  }
-  limited.FinishSpill();
-  return limited;
+  return RunPipeline(context, statement, PipelineInput(std::move(input)),
+                     outer, ctes, apply_where);
 }
 
 std::optional<Relation> ExecuteCorrelatedSingleSource(
@@ -3097,10 +4532,16 @@ std::optional<Relation> ExecuteCorrelatedSingleSource(
       struct GroupAggs {
         std::vector<AggregateAccumulator> accumulators;
       };
-      std::unordered_map<int64_t, GroupAggs> int_groups;
-      std::unordered_map<std::string, GroupAggs> str_groups;
+      FlatHashMap<int64_t, GroupAggs> int_groups;
+      FlatHashMap<std::string_view, GroupAggs> str_groups;
+      std::string str_key;
       const CompiledScanFilter local_filter =
-          CompileScanFilter(local_predicates, source.schema);
+          CompileScanFilter(local_predicates, source.schema, nullptr);
+      std::vector<BoundExpression> bound_arguments;
+      for (const AggregateExpression* aggregate : aggregate_expressions) {
+        bound_arguments.push_back(
+            Bind(aggregate->Child(), source.schema, nullptr));
+      }
       source.ForEachRow([&](const Row& row) {
         if (HasNullKey(row, created->local_columns)) return;
         if (!MatchScanFilter(row, source.schema, local_filter, nullptr, context,
@@ -3108,14 +4549,12 @@ std::optional<Relation> ExecuteCorrelatedSingleSource(
           return;
         }
         GroupAggs* group = nullptr;
-        std::string str_key;
-        int64_t int_key = 0;
         if (integer_key) {
-          int_key = IntegerJoinKey(row, created->local_columns[0]);
-          group = &int_groups[int_key];
+          const int64_t key = IntegerJoinKey(row, created->local_columns[0]);
+          group = int_groups.TryEmplace(key).first;
         } else {
-          str_key = EncodeJoinKey(row, created->local_columns);
-          group = &str_groups[str_key];
+          EncodeJoinKeyInto(row, created->local_columns, &str_key);
+          group = str_groups.TryEmplace(str_key).first;
         }
         if (group->accumulators.empty()) {
           group->accumulators.reserve(aggregate_expressions.size());
@@ -3133,10 +4572,10 @@ std::optional<Relation> ExecuteCorrelatedSingleSource(
           group->accumulators[i].Add(
               count_star ? Value(1)
                          : Evaluate(aggregate.Child(), scope, nullptr, context,
-                                    ctes));
+                                    ctes, &bound_arguments[i]));
         }
       });
-      auto emit_group = [&](const std::string& key, GroupAggs& group) {
+      auto emit_group = [&](std::string key, GroupAggs& group) {
         AggregateResultMap aggregate_results;
         aggregate_results.reserve(group.accumulators.size());
         for (const AggregateAccumulator& accumulator : group.accumulators) {
@@ -3160,30 +4599,32 @@ std::optional<Relation> ExecuteCorrelatedSingleSource(
                                ValueTypeOf(finished.rows[0][i]));
         }
         finished.schema = Schema("", std::move(columns));
-        created->cached_results.emplace(key, std::move(finished));
+        created->cached_results.emplace(std::move(key), std::move(finished));
       };
       if (integer_key) {
         for (auto& [key, group] : int_groups) {
-          emit_group(Row({Value(key)}).EncodeMemcomparableFormat(), group);
+          emit_group(EncodeValuesKey({Value(key)}), group);
         }
       } else {
         for (auto& [key, group] : str_groups) {
-          emit_group(key, group);
+          emit_group(std::string(key), group);
         }
       }
     } else {
+      std::string str_key;
+      const std::vector<BoundExpression> bound_predicates =
+          Bind(local_predicates, source.schema, nullptr);
       source.ForEachRow([&](const Row& row) {
         if (HasNullKey(row, created->local_columns)) return;
-        if (!local_predicates.empty()) {
-          Scope scope{&row, &source.schema, nullptr};
-          for (const Expression& predicate : local_predicates) {
-            if (!Truthy(Evaluate(predicate, scope, nullptr, context, ctes))) {
-              return;
-            }
+        Scope scope{&row, &source.schema, nullptr};
+        for (size_t i = 0; i < local_predicates.size(); ++i) {
+          if (!Truthy(Evaluate(local_predicates[i], scope, nullptr, context,
+                               ctes, &bound_predicates[i]))) {
+            return;
           }
         }
-        const std::string key = EncodeJoinKey(row, created->local_columns);
-        created->rows.emplace(key, row);
+        EncodeJoinKeyInto(row, created->local_columns, &str_key);
+        created->rows.Insert(str_key, row);
       });
     }
     source.rows.clear();
@@ -3203,8 +4644,7 @@ std::optional<Relation> ExecuteCorrelatedSingleSource(
   for (const ColumnName& column : index->cache_outer_columns) {
     cache_values.push_back(Lookup(column, outer));
   }
-  const std::string cache_key =
-      Row(std::move(cache_values)).EncodeMemcomparableFormat();
+  const std::string cache_key = EncodeValuesKey(cache_values);
   if (const auto cached_result = index->cached_results.find(cache_key);
       cached_result != index->cached_results.end()) {
     ++active_runtime->correlated_result_cache_hits;
@@ -3229,14 +4669,11 @@ std::optional<Relation> ExecuteCorrelatedSingleSource(
     }
     outer_values.push_back(std::move(value));
   }
-  const std::string key =
-      Row(std::move(outer_values)).EncodeMemcomparableFormat();
+  const std::string key = EncodeValuesKey(outer_values);
   Relation candidates;
   candidates.schema = index->schema;
-  const auto [begin, end] = index->rows.equal_range(key);
-  for (auto iter = begin; iter != end; ++iter) {
-    candidates.rows.push_back(iter->second);
-  }
+  index->rows.ForEachMatch(
+      key, [&](const Row& row) { candidates.rows.push_back(row); });
   candidates.peak_intermediate_rows = candidates.rows.size();
   Relation result =
       FinishQuery(context, statement, std::move(candidates), &outer, ctes);
@@ -3340,19 +4777,16 @@ bool ExpressionsAreLocal(TransactionContext& context,
   return true;
 }
 
-const Relation* ExecuteCachedUncorrelated(TransactionContext& context,
-                                          const SelectStatement& statement,
-                                          const CteMap& ctes) {
+// Whether `statement` depends on nothing but base tables and `ctes`, so its
+// result can be cached for the whole query. Remembers statements that
+// cannot.
+bool CacheableUncorrelated(TransactionContext& context,
+                           const SelectStatement& statement,
+                           const CteMap& ctes) {
   if (!active_runtime ||
       active_runtime->noncacheable_queries.contains(&statement)) {
-    return nullptr;
-  }
-  const auto cached = active_runtime->uncorrelated_results.find(&statement);
-  if (cached != active_runtime->uncorrelated_results.end()) {
-    ++active_runtime->uncorrelated_cache_hits;
-    return &cached->second;
+    return false;
   }
-
   std::vector<Relation> schemas;
   schemas.reserve(statement.Sources().size());
   for (const SelectSource& source : statement.Sources()) {
@@ -3360,7 +4794,7 @@ const Relation* ExecuteCachedUncorrelated(TransactionContext& context,
     if (source.query) {
       if (!StatementUsesOnlyScopes(context, *source.query, {}, ctes)) {
         active_runtime->noncacheable_queries.insert(&statement);
-        return nullptr;
+        return false;
       }
       std::vector<Column> columns;
       columns.reserve(source.query->SelectList().size());
@@ -3370,7 +4804,7 @@ const Relation* ExecuteCachedUncorrelated(TransactionContext& context,
             projection.expression->AsColumnValue().GetColumnName().name ==
                 "*") {
           active_runtime->noncacheable_queries.insert(&statement);
-          return nullptr;
+          return false;
         }
         columns.emplace_back(ProjectionName(projection, i), ValueType::kNull);
       }
@@ -3381,7 +4815,7 @@ const Relation* ExecuteCachedUncorrelated(TransactionContext& context,
       StatusOr<std::shared_ptr<Table>> table = context.GetTable(source.table);
       if (!table.HasValue()) {
         active_runtime->noncacheable_queries.insert(&statement);
-        return nullptr;
+        return false;
       }
       metadata.schema = table.Value()->GetSchema();
     }
@@ -3394,22 +4828,268 @@ const Relation* ExecuteCachedUncorrelated(TransactionContext& context,
   }
   if (!ExpressionsAreLocal(context, statement, schemas, ctes)) {
     active_runtime->noncacheable_queries.insert(&statement);
+    return false;
+  }
+  return true;
+}
+
+// A subquery evaluated by a SubqueryTask under a runtime of its own, so the
+// caches and counters of the query thread are never shared between threads.
+struct PendingSubquery {
+  ExecutionRuntime runtime;
+  Relation result;
+  // Last, so destruction waits for the task before freeing what it uses.
+  std::unique_ptr<SubqueryTask> task;
+};
+
+// Whether a subtree may run concurrently with readers of `ctes`. A spilled
+// relation has one read cursor, so it cannot be read from two threads.
+bool ConcurrentlyReadable(const CteMap& ctes) {
+  return std::ranges::none_of(ctes, [](const auto& entry) {
+    return entry.second.HasSpill();
+  });
+}
+
+// Starts the uncorrelated `statement` as a SubqueryTask over `ctes`, which
+// must stay alive and unchanged until the result is taken. Returns false
+// when the query can spare no CPU slot; the consumer then executes the
+// statement itself.
+bool StartSubquery(TransactionContext& context,
+                   const SelectStatement& statement, const CteMap& ctes) {
+  if (!active_runtime ||
+      active_runtime->pending_subqueries.contains(&statement)) {
+    return false;
+  }
+  auto pending = std::make_shared<PendingSubquery>();
+  pending->runtime.root_statement = active_runtime->root_statement;
+  pending->runtime.reusable_base_relations =
+      active_runtime->reusable_base_relations;
+  pending->runtime.reusable_projections = active_runtime->reusable_projections;
+  pending->task = SubqueryTask::TryStart(
+      [&context, &statement, &ctes, subquery = pending.get()] {
+        active_runtime = &subquery->runtime;
+        subquery->result = ExecuteQuery(context, statement, nullptr, ctes);
+      });
+  if (!pending->task) return false;
+  ++active_runtime->concurrent_subqueries;
+  active_runtime->pending_subqueries.emplace(&statement, std::move(pending));
+  return true;
+}
+
+// Waits for the task started for `statement`, if any, and returns its
+// result; rethrows what the task threw.
+std::optional<Relation> TakeSubquery(const SelectStatement& statement) {
+  if (!active_runtime) return std::nullopt;
+  const auto found = active_runtime->pending_subqueries.find(&statement);
+  if (found == active_runtime->pending_subqueries.end()) return std::nullopt;
+  const std::shared_ptr<PendingSubquery> pending = std::move(found->second);
+  active_runtime->pending_subqueries.erase(found);
+  pending->task->Wait();
+  MergeRuntime(std::move(pending->runtime), active_runtime);
+  return std::move(pending->result);
+}
+
+// Subqueries one ExecuteQuery started. They read its CteMap, so they are
+// all finished before it returns, even when it throws; uncorrelated
+// results nobody took are still cached.
+class StartedSubqueries {
+ public:
+  StartedSubqueries() = default;
+  StartedSubqueries(const StartedSubqueries&) = delete;
+  StartedSubqueries& operator=(const StartedSubqueries&) = delete;
+  ~StartedSubqueries() {
+    for (const auto& [statement, cache] : started_) {
+      try {
+        std::optional<Relation> result = TakeSubquery(*statement);
+        if (result && cache) {
+          active_runtime->uncorrelated_results.try_emplace(
+              statement, std::move(*result));
+        }
+      } catch (...) {
+        // The consumer never asked for it; the error goes with it.
+      }
+    }
+  }
+
+  void Start(TransactionContext& context, const SelectStatement& statement,
+             const CteMap& ctes, bool cache) {
+    if (StartSubquery(context, statement, ctes)) {
+      started_.emplace_back(&statement, cache);
+    }
+  }
+
+ private:
+  std::vector<std::pair<const SelectStatement*, bool>> started_;
+};
+
+void CollectUncorrelatedQueries(TransactionContext& context,
+                                const Expression& expression,
+                                const CteMap& ctes,
+                                std::vector<const SelectStatement*>* out) {
+  if (!expression) return;
+  if (expression->Type() == TypeTag::kQueryExp) {
+    const QueryExpression& query = expression->AsQueryExpression();
+    const SelectStatement* statement = query.Query().get();
+    if (!active_runtime->uncorrelated_results.contains(statement) &&
+        std::ranges::find(*out, statement) == out->end() &&
+        CacheableUncorrelated(context, *statement, ctes)) {
+      out->push_back(statement);
+    }
+    CollectUncorrelatedQueries(context, query.Test(), ctes, out);
+    return;
+  }
+  for (const Expression& child : ExpressionChildren(expression)) {
+    CollectUncorrelatedQueries(context, child, ctes, out);
+  }
+}
+
+// Starts the derived tables and uncorrelated subqueries of a top-level
+// `statement` as concurrent tasks, to be joined where they are consumed:
+// LoadSource for derived tables, ExecuteCachedUncorrelated for subqueries.
+// Only worth a thread when two of them can overlap, or when a derived
+// table can load while the statement scans its other sources.
+void StartIndependentSubqueries(TransactionContext& context,
+                                const SelectStatement& statement,
+                                const CteMap& ctes,
+                                StartedSubqueries* started) {
+  if (!active_runtime || !ConcurrentSubqueriesEnabled() ||
+      !ConcurrentlyReadable(ctes)) {
+    return;
+  }
+  std::vector<const SelectStatement*> derived;
+  for (const SelectSource& source : statement.Sources()) {
+    if (source.query) derived.push_back(source.query.get());
+  }
+  std::vector<const SelectStatement*> uncorrelated;
+  for (const SelectSource& source : statement.Sources()) {
+    CollectUncorrelatedQueries(context, source.join_condition, ctes,
+                               &uncorrelated);
+  }
+  CollectUncorrelatedQueries(context, statement.WhereClause(), ctes,
+                             &uncorrelated);
+  for (const NamedExpression& item : statement.SelectList()) {
+    CollectUncorrelatedQueries(context, item.expression, ctes, &uncorrelated);
+  }
+  CollectUncorrelatedQueries(context, statement.Having(), ctes,
+                             &uncorrelated);
+  const bool other_sources = derived.size() < statement.Sources().size();
+  if (derived.size() + uncorrelated.size() < 2 &&
+      (derived.empty() || !other_sources)) {
+    return;
+  }
+  for (const SelectStatement* query : derived) {
+    started->Start(context, *query, ctes, false);
+  }
+  for (const SelectStatement* query : uncorrelated) {
+    started->Start(context, *query, ctes, true);
+  }
+}
+
+const Relation* ExecuteCachedUncorrelated(TransactionContext& context,
+                                          const SelectStatement& statement,
+                                          const CteMap& ctes) {
+  if (!active_runtime ||
+      active_runtime->noncacheable_queries.contains(&statement)) {
     return nullptr;
   }
-  Relation result = ExecuteQuery(context, statement, nullptr, ctes);
+  const auto cached = active_runtime->uncorrelated_results.find(&statement);
+  if (cached != active_runtime->uncorrelated_results.end()) {
+    ++active_runtime->uncorrelated_cache_hits;
+    return &cached->second;
+  }
+  std::optional<Relation> result = TakeSubquery(statement);
+  if (!result) {
+    if (!CacheableUncorrelated(context, statement, ctes)) return nullptr;
+    result = ExecuteQuery(context, statement, nullptr, ctes);
+  }
   auto [iter, inserted] = active_runtime->uncorrelated_results.emplace(
-      &statement, std::move(result));
+      &statement, std::move(*result));
   return &iter->second;
 }
 
+// Runs the WITH queries of `statement` into `ctes`. A query runs once the
+// others it reads are done; queries ready together run as concurrent
+// tasks.
+void ExecuteWithQueries(TransactionContext& context,
+                        const SelectStatement& statement, const Scope* outer,
+                        CteMap* ctes) {
+  std::vector<std::pair<std::string, const SelectStatement*>> waiting;
+  for (const auto& [name, query] : statement.WithQueries()) {
+    waiting.emplace_back(name, query.get());
+  }
+  std::ranges::sort(waiting);
+  std::vector<std::unordered_map<std::string, size_t>> reads(waiting.size());
+  for (size_t i = 0; i < waiting.size(); ++i) {
+    CountStatementTables(*waiting[i].second, &reads[i]);
+  }
+  std::vector<bool> done(waiting.size(), false);
+  size_t remaining = waiting.size();
+  while (0 < remaining) {
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < waiting.size(); ++i) {
+      const bool blocked =
+          done[i] || std::ranges::any_of(
+                         std::views::iota(size_t{0}, waiting.size()),
+                         [&](size_t j) {
+                           return j != i && !done[j] &&
+                                  reads[i].contains(waiting[j].first);
+                         });
+      if (!blocked) ready.push_back(i);
+    }
+    if (ready.empty()) {
+      // A cycle: fall back to running the rest one by one in name order.
+      for (size_t i = 0; i < waiting.size(); ++i) {
+        if (!done[i]) {
+          ready.push_back(i);
+          break;
+        }
+      }
+    }
+    std::vector<Relation> results(ready.size());
+    {
+      StartedSubqueries started;
+      if (outer == nullptr && 1 < ready.size() && active_runtime &&
+          ConcurrentSubqueriesEnabled() && ConcurrentlyReadable(*ctes)) {
+        for (size_t k = 1; k < ready.size(); ++k) {
+          started.Start(context, *waiting[ready[k]].second, *ctes, false);
+        }
+      }
+      for (size_t k = 0; k < ready.size(); ++k) {
+        const SelectStatement& query = *waiting[ready[k]].second;
+        std::optional<Relation> result = TakeSubquery(query);
+        results[k] = result ? std::move(*result)
+                            : ExecuteQuery(context, query, outer, *ctes);
+      }
+    }
+    for (size_t k = 0; k < ready.size(); ++k) {
+      (*ctes)[waiting[ready[k]].first] = std::move(results[k]);
+      done[ready[k]] = true;
+      --remaining;
+    }
+  }
+}
+
+// Runs the WITH queries of `statement` into `ctes`, which start as
+// `inherited_ctes`, and starts the independent subqueries of a top-level
+// query.
+void PrepareQuery(TransactionContext& context,
+                  const SelectStatement& statement, const Scope* outer,
+                  const CteMap& inherited_ctes, CteMap* ctes,
+                  StartedSubqueries* started) {
+  EnsureReusableProjections(context, active_runtime);
+  *ctes = inherited_ctes;
+  ExecuteWithQueries(context, statement, outer, ctes);
+  if (outer == nullptr) {
+    StartIndependentSubqueries(context, statement, *ctes, started);
+  }
+}
+
 Relation ExecuteQuery(TransactionContext& context,
                       const SelectStatement& statement, const Scope* outer,
                       const CteMap& inherited_ctes) {
-  EnsureReusableProjections(context, active_runtime);
-  CteMap ctes = inherited_ctes;
-  for (const auto& [name, query] : statement.WithQueries()) {
-    ctes[name] = ExecuteQuery(context, *query, outer, ctes);
-  }
+  CteMap ctes;
+  StartedSubqueries started;
+  PrepareQuery(context, statement, outer, inherited_ctes, &ctes, &started);
 
   // Single-table aggregation: filter and aggregate while scanning so we never
   // materialize millions of qualifying rows (TPC-H Q1/Q6/Q21-derived pattern).
@@ -3418,6 +5098,7 @@ Relation ExecuteQuery(TransactionContext& context,
   const bool stream_agg =
       outer == nullptr && statement.WithQueries().empty() &&
       statement.Sources().size() == 1 && !statement.Sources()[0].query &&
+      !statement.Sources()[0].sample &&
       !ctes.contains(statement.Sources()[0].table) &&
       (!statement.WhereClause() || !ContainsQuery(statement.WhereClause())) &&
       (!statement.GroupBy().empty() ||
@@ -3452,28 +5133,14 @@ Relation ExecuteQuery(TransactionContext& context,
     std::vector<Expression> scan_predicates =
         SplitConjuncts(statement.WhereClause());
     CompiledScanFilter scan_filter =
-        CompileScanFilter(scan_predicates, scan_schema);
+        CompileScanFilter(scan_predicates, scan_schema, outer);
 
     Relation input;
     input.schema = qualified_schema;
     // Project aggregates against the qualified schema; feed rows one at a time
     // without retaining them in input.rows.
-    std::vector<const AggregateExpression*> aggregate_expressions;
-    std::unordered_set<const AggregateExpression*> seen_aggregates;
-    for (const NamedExpression& projection_item : statement.SelectList()) {
-      CollectAggregates(projection_item.expression, &aggregate_expressions,
-                        &seen_aggregates);
-    }
-    CollectAggregates(statement.Having(), &aggregate_expressions,
-                      &seen_aggregates);
-
-    struct GroupState {
-      Row representative;
-      size_t accumulator_offset{0};
-    };
-    std::deque<AggregateAccumulator> aggregate_states;
-    std::vector<GroupState> groups;
-    std::unordered_map<Row, size_t> offsets;
+    const std::vector<const AggregateExpression*> aggregate_expressions =
+        StatementAggregates(statement);
 
     std::vector<std::optional<slot_t>> group_offsets;
     group_offsets.reserve(statement.GroupBy().size());
@@ -3516,49 +5183,83 @@ Relation ExecuteQuery(TransactionContext& context,
           aggregate.Child()->AsColumnValue().GetColumnName().name == "*";
     }
 
-    const auto scan_begin = std::chrono::steady_clock::now();
-    auto accumulate_row = [&](Row row) {
-      if (active_runtime) ++active_runtime->scan_output_rows;
-      Scope scope{&row, &input.schema, outer};
-      std::vector<Value> key_values;
-      key_values.reserve(statement.GroupBy().size());
+    const std::vector<BoundExpression> bound_group_by =
+        Bind(statement.GroupBy(), input.schema, outer);
+    std::vector<BoundExpression> bound_arguments;
+    for (const AggregateExpression* aggregate : aggregate_expressions) {
+      bound_arguments.push_back(
+          Bind(aggregate->Child(), input.schema, outer));
+    }
+
+    // Per-row work shared by the serial and the parallel aggregation; the
+    // parallel one runs it on worker threads.
+    auto key_of = [&](const Row& row, std::string* key) {
+      key->clear();
       if (group_keys_are_columns) {
         for (const auto& offset : group_offsets) {
-          key_values.push_back(row[*offset]);
-        }
-      } else {
-        for (const Expression& key : statement.GroupBy()) {
-          key_values.push_back(Evaluate(key, scope, nullptr, context, ctes));
+          AppendFlatKey(row[*offset], key);
         }
+        return;
       }
-      Row key(std::move(key_values));
-      auto [iter, inserted] = offsets.emplace(key, groups.size());
-      if (inserted) {
-        GroupState group;
-        group.accumulator_offset = aggregate_states.size();
-        for (const AggregateExpression* aggregate : aggregate_expressions) {
-          aggregate_states.emplace_back(aggregate);
-        }
-        group.representative = row;
-        groups.push_back(std::move(group));
+      Scope scope{&row, &input.schema, outer};
+      for (size_t i = 0; i < statement.GroupBy().size(); ++i) {
+        AppendFlatKey(Evaluate(statement.GroupBy()[i], scope, nullptr, context,
+                               ctes, &bound_group_by[i]),
+                      key);
       }
-      GroupState& group = groups[iter->second];
+    };
+    auto update = [&](const Row& row, AggregateState* states) {
+      Scope scope{&row, &input.schema, outer};
       for (size_t i = 0; i < aggregate_expressions.size(); ++i) {
-        AggregateAccumulator& accumulator =
-            aggregate_states[group.accumulator_offset + i];
         if (is_count_star[i]) {
-          accumulator.Add(Value(1));
+          states[i].Add(Value(1));
         } else if (aggregate_child_offsets[i]) {
-          accumulator.Add(row[*aggregate_child_offsets[i]]);
+          states[i].Add(row[*aggregate_child_offsets[i]]);
         } else {
-          accumulator.Add(Evaluate(aggregate_expressions[i]->Child(), scope,
-                                   nullptr, context, ctes));
+          states[i].Add(Evaluate(aggregate_expressions[i]->Child(), scope,
+                                 nullptr, context, ctes, &bound_arguments[i]));
         }
-        if (active_runtime) ++active_runtime->aggregate_updates;
       }
-      if (active_runtime) ++active_runtime->aggregate_input_rows;
     };
 
+    const auto scan_begin = std::chrono::steady_clock::now();
+    SpillableHashAggregation serial(AggregateSpecs(aggregate_expressions),
+                                    key_of, update);
+    auto accumulate_row = [&](const Row& row) {
+      if (active_runtime) {
+        ++active_runtime->scan_output_rows;
+        ++active_runtime->aggregate_input_rows;
+        active_runtime->aggregate_updates += aggregate_expressions.size();
+      }
+      serial.Add(row);
+    };
+
+    // Large inputs are aggregated by a ParallelHashAggregation instead, as
+    // long as no per-row expression runs a subquery.
+    const bool parallel_safe =
+        std::ranges::none_of(statement.GroupBy(), ContainsQuery) &&
+        std::ranges::none_of(aggregate_expressions,
+                             [](const AggregateExpression* aggregate) {
+                               return ContainsQuery(aggregate->Child());
+                             });
+    std::optional<ParallelHashAggregation> parallel;
+    auto aggregate_in_parallel =
+        [&](size_t morsels, size_t workers,
+            const ParallelHashAggregation::ProduceFn& produce) {
+          parallel.emplace(AggregateSpecs(aggregate_expressions), key_of,
+                           update);
+          parallel->Run(morsels, workers, produce);
+          if (active_runtime) {
+            ++active_runtime->parallel_aggregations;
+            active_runtime->preaggregation_passed_rows +=
+                parallel->PassedRows();
+            active_runtime->scan_output_rows += parallel->InputRows();
+            active_runtime->aggregate_input_rows += parallel->InputRows();
+            active_runtime->aggregate_updates +=
+                parallel->InputRows() * aggregate_expressions.size();
+          }
+        };
+
     if (reusable) {
       const std::string cache_key = BaseRelationCacheKey(
           source.table, projection.empty() ? nullptr : &projection);
@@ -3620,14 +5321,35 @@ Relation ExecuteQuery(TransactionContext& context,
       } else {
         ++active_runtime->base_scan_cache_hits;
       }
-      cached->second.FinishSpill();
-      cached->second.ForEachRow([&](const Row& row) {
-        if (!MatchScanFilter(row, scan_schema, scan_filter, outer, context,
-                             ctes)) {
-          return;
-        }
-        accumulate_row(row);
-      });
+      Relation& cached_relation = cached->second;
+      cached_relation.FinishSpill();
+      const std::vector<Row>& cached_rows = cached_relation.rows;
+      const size_t morsels =
+          (cached_rows.size() + kJoinMorselRows - 1) / kJoinMorselRows;
+      const size_t workers = parallel_safe && !cached_relation.HasSpill()
+                                 ? AggregationWorkerCount(morsels)
+                                 : 1;
+      if (workers > 1) {
+        aggregate_in_parallel(
+            morsels, workers, [&](size_t morsel, const auto& add) {
+              const size_t end = std::min(cached_rows.size(),
+                                          (morsel + 1) * kJoinMorselRows);
+              for (size_t i = morsel * kJoinMorselRows; i < end; ++i) {
+                if (MatchScanFilter(cached_rows[i], scan_schema, scan_filter,
+                                    outer, context, ctes)) {
+                  add(cached_rows[i]);
+                }
+              }
+            });
+      } else {
+        cached_relation.ForEachRow([&](const Row& row) {
+          if (!MatchScanFilter(row, scan_schema, scan_filter, outer, context,
+                               ctes)) {
+            return;
+          }
+          accumulate_row(row);
+        });
+      }
     } else {
       // Apply stashed key filters on the direct scan path too.
       const std::unordered_set<int64_t>* filter_ptr = nullptr;
@@ -3643,151 +5365,134 @@ Relation ExecuteQuery(TransactionContext& context,
           full_key_column = stored_col->second;
         }
       }
-      Iterator iterator =
-          full_key_column
-              ? (projection.empty()
-                     ? table.Value()->BeginFullScan(context.txn_, filter_ptr,
-                                                    *full_key_column)
-                     : table.Value()->BeginFullScan(context.txn_, projection,
-                                                    filter_ptr,
-                                                    *full_key_column))
-              : (projection.empty()
-                     ? table.Value()->BeginFullScan(context.txn_)
-                     : table.Value()->BeginFullScan(context.txn_, projection));
-      while (iterator.IsValid()) {
+      const std::vector<Table::ScanMorsel> morsels =
+          parallel_safe &&
+                  AggregationWorkerCount(std::numeric_limits<size_t>::max()) > 1
+              ? table.Value()->BuildScanMorsels(context.txn_, 8)
+              : std::vector<Table::ScanMorsel>();
+      const size_t workers = AggregationWorkerCount(morsels.size());
+      if (workers > 1) {
+        std::optional<std::vector<slot_t>> scan_projection;
+        if (!projection.empty()) scan_projection = projection;
+        std::atomic<size_t> scanned{0};
+        aggregate_in_parallel(
+            morsels.size(), workers, [&](size_t morsel, const auto& add) {
+              Iterator iterator = table.Value()->BeginMorselScan(
+                  context.txn_, morsels[morsel], scan_projection, filter_ptr,
+                  full_key_column);
+              size_t rows = 0;
+              for (; iterator.IsValid(); ++iterator) {
+                ++rows;
+                if (MatchScanFilter(*iterator, scan_schema, scan_filter, outer,
+                                    context, ctes)) {
+                  add(*iterator);
+                }
+              }
+              // The morsel's rows are aggregated; this worker's cached row
+              // images are no longer referenced.
+              context.txn_.ForgetThreadReadCache();
+              scanned += rows;
+            });
         if (active_runtime) {
-          ++active_runtime->scan_rows;
-          active_runtime->scan_values_available += table_schema.ColumnCount();
-          active_runtime->scan_values_decoded += scan_schema.ColumnCount();
+          active_runtime->scan_rows += scanned;
+          active_runtime->scan_values_available +=
+              scanned * table_schema.ColumnCount();
+          active_runtime->scan_values_decoded +=
+              scanned * scan_schema.ColumnCount();
         }
-        if (!MatchScanFilter(*iterator, scan_schema, scan_filter, outer, context,
-                             ctes)) {
+      } else {
+        const Table& scanned_table = *table.Value();
+        Iterator iterator =
+            full_key_column
+                ? (projection.empty()
+                       ? scanned_table.BeginFullScan(context.txn_, filter_ptr,
+                                                     *full_key_column)
+                       : scanned_table.BeginFullScan(context.txn_, projection,
+                                                     filter_ptr,
+                                                     *full_key_column))
+                : (projection.empty()
+                       ? scanned_table.BeginFullScan(context.txn_)
+                       : scanned_table.BeginFullScan(context.txn_, projection));
+        while (iterator.IsValid()) {
+          if (active_runtime) {
+            ++active_runtime->scan_rows;
+            active_runtime->scan_values_available += table_schema.ColumnCount();
+            active_runtime->scan_values_decoded += scan_schema.ColumnCount();
+          }
+          if (!MatchScanFilter(*iterator, scan_schema, scan_filter, outer,
+                               context, ctes)) {
+            ++iterator;
+            continue;
+          }
+          accumulate_row(*iterator);
           ++iterator;
-          continue;
         }
-        accumulate_row(*iterator);
-        ++iterator;
       }
     }
     if (active_runtime) {
       active_runtime->scan_ms += ElapsedMs(scan_begin);
       active_runtime->filter_ms += ElapsedMs(scan_begin);
-      active_runtime->aggregate_groups += groups.size();
-    }
-    if (groups.empty() && statement.GroupBy().empty()) {
-      GroupState group;
-      group.accumulator_offset = aggregate_states.size();
-      for (const AggregateExpression* aggregate : aggregate_expressions) {
-        aggregate_states.emplace_back(aggregate);
-      }
-      groups.push_back(std::move(group));
     }
 
-    Relation output;
-    output.schema = input.schema;
-    std::vector<Column> output_columns;
-    for (size_t i = 0; i < statement.SelectList().size(); ++i) {
-      const NamedExpression& projection_item = statement.SelectList()[i];
-      output_columns.emplace_back(ProjectionName(projection_item, i),
-                                  ValueType::kNull);
+    QueryOutput result(context, statement, outer, ctes,
+                      OutputColumns(statement, input.schema));
+    const BoundExpression bound_having =
+        Bind(statement.Having(), input.schema, outer);
+    std::vector<BoundExpression> bound_projections;
+    for (const NamedExpression& projection_item : statement.SelectList()) {
+      bound_projections.push_back(
+          Bind(projection_item.expression, input.schema, outer));
     }
-    for (const GroupState& group : groups) {
-      AggregateResultMap aggregate_results;
-      aggregate_results.reserve(aggregate_expressions.size());
-      for (size_t i = 0; i < aggregate_expressions.size(); ++i) {
-        aggregate_results.emplace(
-            aggregate_expressions[i],
-            aggregate_states[group.accumulator_offset + i].Finish());
-      }
-      Scope scope{&group.representative, &input.schema, outer};
+    auto emit_group = [&](const Row& representative,
+                          const AggregateResultMap& aggregate_results) {
+      Scope scope{&representative, &input.schema, outer};
       if (statement.Having() &&
           !Truthy(Evaluate(statement.Having(), scope, &aggregate_results,
-                           context, ctes))) {
-        continue;
+                           context, ctes, &bound_having))) {
+        return;
       }
       std::vector<Value> values;
       values.reserve(statement.SelectList().size());
-      for (const NamedExpression& projection_item : statement.SelectList()) {
-        values.push_back(Evaluate(projection_item.expression, scope,
-                                  &aggregate_results, context, ctes));
-      }
-      output.AddRow(Row(std::move(values)));
-    }
-    for (size_t i = 0; i < output_columns.size() && !output.rows.empty(); ++i) {
-      output_columns[i] =
-          Column(output_columns[i].Name(), ValueTypeOf(output.rows[0][i]));
-    }
-    output.schema = Schema("", std::move(output_columns));
-    output.FinishSpill();
-    // DISTINCT / ORDER BY / LIMIT without running Project again.
-    if (statement.Distinct()) {
-      std::unordered_set<Row> seen;
-      Relation distinct;
-      distinct.schema = output.schema;
-      output.ForEachRow([&](const Row& row) {
-        if (seen.insert(row).second) distinct.AddRow(row);
-      });
-      distinct.FinishSpill();
-      output = std::move(distinct);
-    }
-    if (!statement.OrderBy().empty()) {
-      const auto sort_begin = std::chrono::steady_clock::now();
-      output.FinishSpill();
-      std::vector<Row> sortable;
-      output.ForEachRow([&](const Row& row) { sortable.push_back(row); });
-      output.rows.clear();
-      output.ReleaseCharge();
-      std::stable_sort(
-          sortable.begin(), sortable.end(),
-          [&](const Row& left, const Row& right) {
-            Scope left_scope{&left, &output.schema, outer};
-            Scope right_scope{&right, &output.schema, outer};
-            for (const auto& key : statement.OrderBy()) {
-              const Value a =
-                  Evaluate(key.expression, left_scope, nullptr, context, ctes);
-              const Value b =
-                  Evaluate(key.expression, right_scope, nullptr, context, ctes);
-              if (a == b) continue;
-              if (a.IsNull()) return key.ascending;
-              if (b.IsNull()) return !key.ascending;
-              return key.ascending ? a < b : b < a;
-            }
-            return false;
-          });
-      for (Row& row : sortable) {
-        output.AddRow(std::move(row));
-      }
-      output.FinishSpill();
-      if (active_runtime) active_runtime->sort_ms += ElapsedMs(sort_begin);
-    }
-    output.FinishSpill();
-    std::vector<Row> all_rows;
-    output.ForEachRow([&](const Row& row) { all_rows.push_back(row); });
-    const size_t begin = std::min(statement.Offset(), all_rows.size());
-    const size_t available = all_rows.size() - begin;
-    const size_t count = statement.Limit() == 0
-                             ? available
-                             : std::min(statement.Limit(), available);
-    Relation limited;
-    limited.schema = output.schema;
-    limited.hash_joins = output.hash_joins;
-    limited.hybrid_hash_joins = output.hybrid_hash_joins;
-    limited.in_memory_hash_joins = output.in_memory_hash_joins;
-    limited.nested_loop_joins = output.nested_loop_joins;
-    limited.join_comparisons = output.join_comparisons;
-    limited.peak_intermediate_rows = output.peak_intermediate_rows;
-    for (size_t i = 0; i < count; ++i) {
-      limited.AddRow(std::move(all_rows[begin + i]));
-    }
-    limited.FinishSpill();
-    return limited;
+      for (size_t i = 0; i < statement.SelectList().size(); ++i) {
+        values.push_back(Evaluate(statement.SelectList()[i].expression, scope,
+                                  &aggregate_results, context, ctes,
+                                  &bound_projections[i]));
+      }
+      result.Push(Row(std::move(values)));
+    };
+    size_t group_count = 0;
+    auto emit_states = [&](const Row& representative,
+                           const AggregateState* states) {
+      AggregateResultMap aggregate_results;
+      aggregate_results.reserve(aggregate_expressions.size());
+      for (size_t i = 0; i < aggregate_expressions.size(); ++i) {
+        aggregate_results.emplace(aggregate_expressions[i],
+                                  states[i].Finish());
+      }
+      emit_group(representative, aggregate_results);
+      ++group_count;
+    };
+    if (parallel) parallel->ForEachGroup(emit_states);
+    serial.Finish(emit_states);
+    NoteAggregateSpills(serial);
+    if (group_count == 0 && statement.GroupBy().empty()) {
+      std::vector<AggregateState> states;
+      for (const AggregateSpec& spec : AggregateSpecs(aggregate_expressions)) {
+        states.emplace_back(spec.type, spec.distinct);
+      }
+      emit_states(Row(), states.data());
+    }
+    if (active_runtime) active_runtime->aggregate_groups += group_count;
+    const size_t held_groups = parallel ? parallel->Groups() : 0;
+    result.Finish();
+    return result.TakeResult(input,
+                             std::max(held_groups, serial.PeakGroups()));
   }
 
   bool where_fully_applied = false;
-  Relation input =
-      BuildInput(context, statement, outer, ctes, &where_fully_applied);
-
-  return FinishQuery(context, statement, std::move(input), outer, ctes,
+  PipelineInput input = BuildPipelineInput(context, statement, outer, ctes,
+                                           &where_fully_applied);
+  return RunPipeline(context, statement, std::move(input), outer, ctes,
                      !where_fully_applied);
 }
 
@@ -3891,11 +5596,22 @@ EstimatedPlanNode MakeScanNode(TransactionContext& context,
                     ? table.Value()->GetSchema()
                     : QualifySchema(table.Value()->GetSchema(), qualifier);
   node.rows = StatsRows(context, source.table, &node.rows_known);
+  if (source.sample) {
+    node.rows = static_cast<size_t>(static_cast<double>(node.rows) *
+                                    source.sample->fraction);
+  }
   std::ostringstream line;
   line << "SeqScan " << source.table;
   if (!source.alias.empty() && source.alias != source.table) {
     line << " AS " << source.alias;
   }
+  if (source.sample) {
+    line << " TABLESAMPLE "
+         << (source.sample->method == TableSample::Method::kSystem
+                 ? "SYSTEM"
+                 : "BERNOULLI")
+         << " (" << source.sample->fraction * 100 << ")";
+  }
   line << " rows~" << FormatRows(node);
   node.text = line.str();
   return node;
@@ -3929,6 +5645,10 @@ EstimatedPlanNode MakeJoinNode(EstimatedPlanNode left, EstimatedPlanNode right,
         head << " (~"
              << FormatBytes(right.rows * kHashJoinRowBytesEstimate) << ")";
       }
+    } else if (right.rows_known &&
+               PreferRadixHashJoin(right.rows * kHashJoinRowBytesEstimate)) {
+      head << "RadixHashJoin build~" << FormatRows(right) << " (~"
+           << FormatBytes(right.rows * kHashJoinRowBytesEstimate) << ")";
     } else {
       head << "HashJoin build~" << FormatRows(right);
       if (right.rows_known) {
@@ -3946,6 +5666,25 @@ EstimatedPlanNode MakeJoinNode(EstimatedPlanNode left, EstimatedPlanNode right,
   return out;
 }
 
+// Semi or anti join of `probe` with the filter source `build`.
+EstimatedPlanNode MakeFilterJoinNode(EstimatedPlanNode probe,
+                                     EstimatedPlanNode build,
+                                     const SelectSource& source) {
+  const std::vector<Expression> predicates =
+      SplitConjuncts(source.join_condition);
+  EstimatedPlanNode out;
+  out.schema = probe.schema;
+  out.rows = probe.rows;
+  out.rows_known = probe.rows_known;
+  std::ostringstream head;
+  head << SemiJoinKindName(SemiJoinKindOf(source.join_type)) << " keys="
+       << EqualityKeys(probe.schema, build.schema, predicates).size()
+       << " build~" << FormatRows(build) << " rows<=" << FormatRows(out);
+  out.text = head.str() + "\n" + IndentLines(probe.text, 2) + "\n" +
+             IndentLines(build.text, 2);
+  return out;
+}
+
 void WriteEstimatedPhysicalPlan(TransactionContext& context,
                                 const SelectStatement& statement,
                                 std::ostream& output, int indent) {
@@ -3972,6 +5711,11 @@ void WriteEstimatedPhysicalPlan(TransactionContext& context,
       plan = std::move(nodes.front());
       for (size_t i = 1; i < nodes.size(); ++i) {
         const SelectSource& source = statement.Sources()[i];
+        if (IsFilterJoin(source)) {
+          plan = MakeFilterJoinNode(std::move(plan), std::move(nodes[i]),
+                                    source);
+          continue;
+        }
         std::vector<Expression> predicates =
             SplitConjuncts(source.join_condition);
         const char* kind = "cross";
@@ -3987,7 +5731,8 @@ void WriteEstimatedPhysicalPlan(TransactionContext& context,
       std::vector<Expression> all_predicates =
           SplitConjuncts(statement.WhereClause());
       for (size_t i = 1; i < statement.Sources().size(); ++i) {
-        if (statement.Sources()[i].join_condition) {
+        if (statement.Sources()[i].join_condition &&
+            !IsFilterJoin(statement.Sources()[i])) {
           all_predicates.push_back(statement.Sources()[i].join_condition);
         }
       }
@@ -4000,15 +5745,41 @@ void WriteEstimatedPhysicalPlan(TransactionContext& context,
                                  : CombineConjuncts(all_predicates),
           schema_only);
 
+      // Semi and anti joins sit on the relation owning their outer columns,
+      // or on top of the joins when those columns span several relations.
+      std::vector<size_t> late_filters;
+      for (size_t i = 0; i < nodes.size(); ++i) {
+        const SelectSource& source = statement.Sources()[i];
+        if (!IsFilterJoin(source)) continue;
+        std::unordered_set<size_t> owners;
+        bool resolved = true;
+        for (const PredicateInfo& predicate :
+             AnalyzePredicates(source.join_condition, schema_only)) {
+          resolved = resolved && predicate.resolved;
+          owners.insert(predicate.sources.begin(), predicate.sources.end());
+        }
+        owners.erase(i);
+        if (resolved && owners.size() == 1) {
+          const size_t owner = *owners.begin();
+          nodes[owner] = MakeFilterJoinNode(std::move(nodes[owner]),
+                                            std::move(nodes[i]), source);
+        } else {
+          late_filters.push_back(i);
+        }
+      }
+
       size_t first = 0;
       for (size_t i = 1; i < nodes.size(); ++i) {
+        if (IsFilterJoin(statement.Sources()[i])) continue;
         if (nodes[i].rows < nodes[first].rows) first = i;
       }
       plan = std::move(nodes[first]);
       std::unordered_set<size_t> joined{first};
       std::unordered_set<size_t> remaining;
       for (size_t i = 0; i < nodes.size(); ++i) {
-        if (i != first) remaining.insert(i);
+        if (i != first && !IsFilterJoin(statement.Sources()[i])) {
+          remaining.insert(i);
+        }
       }
       while (!remaining.empty()) {
         size_t next = *remaining.begin();
@@ -4069,6 +5840,10 @@ void WriteEstimatedPhysicalPlan(TransactionContext& context,
         joined.insert(next);
         remaining.erase(next);
       }
+      for (size_t i : late_filters) {
+        plan = MakeFilterJoinNode(std::move(plan), std::move(nodes[i]),
+                                  statement.Sources()[i]);
+      }
     }
     output << IndentLines(plan.text, indent) << '\n';
   }
@@ -4082,10 +5857,15 @@ void WriteEstimatedPhysicalPlan(TransactionContext& context,
   }
   output << pad << "Project columns=" << statement.SelectList().size()
          << " distinct=" << (statement.Distinct() ? "true" : "false") << '\n';
-  if (!statement.OrderBy().empty()) {
+  if (UsesTopN(statement)) {
+    output << pad << "TopN keys=" << statement.OrderBy().size()
+           << " count=" << statement.Limit()
+           << " offset=" << statement.Offset() << '\n';
+  } else if (!statement.OrderBy().empty()) {
     output << pad << "Sort keys=" << statement.OrderBy().size() << '\n';
   }
-  if (statement.Limit() != 0 || statement.Offset() != 0) {
+  if (!UsesTopN(statement) &&
+      (statement.Limit() != 0 || statement.Offset() != 0)) {
     output << pad << "Limit count=" << statement.Limit()
            << " offset=" << statement.Offset() << '\n';
   }
@@ -4100,35 +5880,126 @@ void WriteEstimatedPhysicalPlan(TransactionContext& context,
   output << '\n';
 }
 
+// Makes `runtime` the thread's active runtime while the guard lives.
+class ScopedRuntime {
+ public:
+  explicit ScopedRuntime(ExecutionRuntime* runtime)
+      : previous_(active_runtime) {
+    active_runtime = runtime;
+  }
+  ScopedRuntime(const ScopedRuntime&) = delete;
+  ScopedRuntime& operator=(const ScopedRuntime&) = delete;
+  ~ScopedRuntime() { active_runtime = previous_; }
+
+ private:
+  ExecutionRuntime* previous_;
+};
+
 }  // namespace
 
+// A query whose result rows are being pulled: its runtime, the WITH query
+// results and started subqueries it reads, and either its SelectPipeline
+// or, for a grouped query, its materialized result.
+class RelationalExecutor::Cursor {
+ public:
+  Cursor() = default;
+  Cursor(const Cursor&) = delete;
+  Cursor& operator=(const Cursor&) = delete;
+  ~Cursor() {
+    // Started subqueries hand their results to the runtime as they go.
+    const ScopedRuntime scope(&runtime_);
+    reader_.reset();
+    result_.reset();
+    pipeline_.reset();
+    started_.reset();
+    ctes_.clear();
+  }
+
+  void Open(TransactionContext& context, const SelectStatement& statement) {
+    runtime_.root_statement = &statement;
+    std::unordered_map<std::string, size_t> table_counts;
+    CountStatementTables(statement, &table_counts);
+    for (const auto& [table, count] : table_counts) {
+      if (count > 1) runtime_.reusable_base_relations.insert(table);
+    }
+    const ScopedRuntime scope(&runtime_);
+    if (IsGroupedQuery(statement)) {
+      result_ = ExecuteQuery(context, statement, nullptr, {});
+      reader_.emplace(*result_);
+      return;
+    }
+    started_.emplace();
+    PrepareQuery(context, statement, nullptr, {}, &ctes_, &*started_);
+    bool where_fully_applied = false;
+    PipelineInput input = BuildPipelineInput(context, statement, nullptr,
+                                             ctes_, &where_fully_applied);
+    pipeline_.emplace(context, statement, std::move(input), nullptr, ctes_,
+                      !where_fully_applied);
+  }
+
+  bool Next(Row* row) {
+    const ScopedRuntime scope(&runtime_);
+    return pipeline_ ? pipeline_->Next(row) : reader_->Next(row);
+  }
+
+  [[nodiscard]] const ExecutionRuntime& Runtime() const { return runtime_; }
+  [[nodiscard]] ExecutionRuntime& Runtime() { return runtime_; }
+  // Join counters and peak held rows, once Next() has returned false.
+  [[nodiscard]] Relation Counters() const {
+    return pipeline_ ? pipeline_->Counters() : HeaderOf(*result_);
+  }
+
+ private:
+  ExecutionRuntime runtime_;
+  CteMap ctes_;
+  std::optional<StartedSubqueries> started_;
+  std::optional<SelectPipeline> pipeline_;
+  std::optional<Relation> result_;
+  std::optional<RelationReader> reader_;
+};
+
 RelationalExecutor::RelationalExecutor(
     TransactionContext& context,
     std::shared_ptr<const SelectStatement> statement)
-    : context_(&context), statement_(std::move(statement)), rows_() {}
+    : context_(&context), memory_(MemoryContext::ForQuery()) {
+  DecorrelatedQuery plan = Decorrelate(
+      std::move(statement),
+      [&context](const std::string& table) -> std::optional<Schema> {
+        StatusOr<std::shared_ptr<Table>> found = context.GetTable(table);
+        if (!found.HasValue()) return std::nullopt;
+        return found.Value()->GetSchema();
+      });
+  statement_ = std::move(plan.statement);
+  decorrelations_ = std::move(plan.rewrites);
+}
 
-void RelationalExecutor::Initialize() {
-  if (initialized_) return;
-  ExecutionRuntime runtime;
-  runtime.root_statement = statement_.get();
-  std::unordered_map<std::string, size_t> table_counts;
-  CountStatementTables(*statement_, &table_counts);
-  for (const auto& [table, count] : table_counts) {
-    if (count > 1) runtime.reusable_base_relations.insert(table);
-  }
-  ExecutionRuntime* previous_runtime = active_runtime;
-  active_runtime = &runtime;
-  Relation result;
+RelationalExecutor::~RelationalExecutor() = default;
+
+bool RelationalExecutor::Pull(Row* row) {
+  if (finished_) return false;
+  const ScopedMemoryContext memory(memory_);
   try {
-    result = ExecuteQuery(*context_, *statement_, nullptr, {});
+    if (!cursor_) {
+      cursor_ = std::make_unique<Cursor>();
+      cursor_->Open(*context_, *statement_);
+    }
+    if (cursor_->Next(row)) {
+      ++result_rows_;
+      return true;
+    }
   } catch (...) {
-    active_runtime = previous_runtime;
+    cursor_.reset();
     throw;
   }
-  active_runtime = previous_runtime;
-  result.FinishSpill();
-  rows_.clear();
-  result.ForEachRow([&](const Row& row) { rows_.push_back(row); });
+  Collect();
+  cursor_.reset();
+  finished_ = true;
+  return false;
+}
+
+void RelationalExecutor::Collect() {
+  const Relation result = cursor_->Counters();
+  const ExecutionRuntime& runtime = cursor_->Runtime();
   hash_joins_ = result.hash_joins;
   hybrid_hash_joins_ = result.hybrid_hash_joins;
   in_memory_hash_joins_ = result.in_memory_hash_joins;
@@ -4155,20 +6026,52 @@ void RelationalExecutor::Initialize() {
   scan_values_decoded_ = runtime.scan_values_decoded;
   scan_values_available_ = runtime.scan_values_available;
   relation_spills_ = runtime.relation_spills;
-  initialized_ = true;
+  column_binds_ = runtime.column_binds;
+  pipelined_rows_ = runtime.pipelined_rows;
+  parallel_hash_joins_ = runtime.parallel_hash_joins;
+  radix_hash_joins_ = runtime.radix_hash_joins;
+  parallel_aggregations_ = runtime.parallel_aggregations;
+  preaggregation_passed_rows_ = runtime.preaggregation_passed_rows;
+  aggregate_spilled_groups_ = runtime.aggregate_spilled_groups;
+  aggregate_spill_partitions_ = runtime.aggregate_spill_partitions;
+  aggregate_spill_depth_ = runtime.aggregate_spill_depth;
+  sort_spilled_runs_ = runtime.sort_spilled_runs;
+  sort_spilled_rows_ = runtime.sort_spilled_rows;
+  top_n_sorts_ = runtime.top_n_sorts;
+  runtime_filter_scans_ = runtime.runtime_filter_scans;
+  runtime_filter_rejected_ = runtime.runtime_filter_rejected;
+  late_materialized_rows_ = runtime.late_materialized_rows;
+  late_fetched_rows_ = runtime.late_fetched_rows;
+  semi_joins_ = runtime.semi_joins;
+  anti_joins_ = runtime.anti_joins;
+  adaptive_replans_ = runtime.adaptive_replans;
+  adaptive_build_swaps_ = runtime.adaptive_build_swaps;
+  adaptive_events_ = runtime.adaptive_events;
+  concurrent_subqueries_ = runtime.concurrent_subqueries;
+  memory_peak_ = memory_->Peak();
+  memory_grant_ = memory_->Grant();
+  memory_breakdown_ = memory_->Breakdown();
+}
+
+void RelationalExecutor::Finish() {
+  Row row;
+  while (Pull(&row)) buffered_.push_back(std::move(row));
 }
 
 bool RelationalExecutor::Next(Row* destination, RowPosition* position) {
-  Initialize();
-  if (offset_ >= rows_.size()) return false;
-  *destination = rows_[offset_++];
+  if (!buffered_.empty()) {
+    *destination = std::move(buffered_.front());
+    buffered_.pop_front();
+  } else if (!Pull(destination)) {
+    return false;
+  }
   if (position) *position = RowPosition();
   return true;
 }
 
 void RelationalExecutor::Dump(std::ostream& output, int) const {
-  const_cast<RelationalExecutor*>(this)->Initialize();
-  output << "RelationalExecutor(materialized=" << rows_.size()
+  const_cast<RelationalExecutor*>(this)->Finish();
+  output << "RelationalExecutor(rows=" << result_rows_
          << ", hash_joins=" << hash_joins_
          << ", hybrid_hash_joins=" << hybrid_hash_joins_
          << ", in_memory_hash_joins=" << in_memory_hash_joins_
@@ -4192,17 +6095,63 @@ void RelationalExecutor::Dump(std::ostream& output, int) const {
          << ", scan_rows=" << scan_rows_
          << ", scan_output_rows=" << scan_output_rows_
          << ", scan_values_decoded=" << scan_values_decoded_
-         << ", scan_values_available=" << scan_values_available_ << ")";
+         << ", scan_values_available=" << scan_values_available_
+         << ", column_binds=" << column_binds_
+         << ", pipelined_rows=" << pipelined_rows_
+         << ", parallel_hash_joins=" << parallel_hash_joins_
+         << ", radix_hash_joins=" << radix_hash_joins_
+         << ", parallel_aggregations=" << parallel_aggregations_
+         << ", preaggregation_passed_rows=" << preaggregation_passed_rows_
+         << ", aggregate_spilled_groups=" << aggregate_spilled_groups_
+         << ", aggregate_spill_partitions=" << aggregate_spill_partitions_
+         << ", aggregate_spill_depth=" << aggregate_spill_depth_
+         << ", sort_spilled_runs=" << sort_spilled_runs_
+         << ", sort_spilled_rows=" << sort_spilled_rows_
+         << ", top_n_sorts=" << top_n_sorts_
+         << ", runtime_filter_scans=" << runtime_filter_scans_
+         << ", runtime_filter_rejected=" << runtime_filter_rejected_
+         << ", late_materialized_rows=" << late_materialized_rows_
+         << ", late_fetched_rows=" << late_fetched_rows_
+         << ", semi_joins=" << semi_joins_ << ", anti_joins=" << anti_joins_
+         << ", adaptive_replans=" << adaptive_replans_
+         << ", adaptive_build_swaps=" << adaptive_build_swaps_
+         << ", concurrent_subqueries=" << concurrent_subqueries_
+         << ", memory_peak_bytes=" << memory_peak_
+         << ", decorrelated_subqueries=" << decorrelations_.size() << ")";
 }
 
 void RelationalExecutor::Explain(std::ostream& output, int) const {
   output << "Relational Physical Plan (estimated)\n";
+  for (const std::string& rewrite : decorrelations_) {
+    output << "  Decorrelate " << rewrite << '\n';
+  }
   WriteEstimatedPhysicalPlan(*context_, *statement_, output, 2);
-  if (initialized_) {
+  if (finished_) {
     output << "Actual Joins: hybrid_hash_joins=" << hybrid_hash_joins_
            << " in_memory_hash_joins=" << in_memory_hash_joins_
+           << " radix_hash_joins=" << radix_hash_joins_
            << " nested_loop_joins=" << nested_loop_joins_
+           << " semi_joins=" << semi_joins_ << " anti_joins=" << anti_joins_
            << " relation_spills=" << relation_spills_ << '\n';
+    output << "Adaptive Joins: replans=" << adaptive_replans_
+           << " build_swaps=" << adaptive_build_swaps_ << '\n';
+    for (const std::string& event : adaptive_events_) {
+      output << "  Adaptive " << event << '\n';
+    }
+    output << "Concurrent Subqueries: " << concurrent_subqueries_ << '\n';
+    output << "Actual Memory: peak=" << FormatBytes(memory_peak_)
+           << " grant="
+           << (memory_grant_ == std::numeric_limits<size_t>::max()
+                   ? "unlimited"
+                   : FormatBytes(memory_grant_));
+    for (const MemoryContext::Usage& usage : memory_breakdown_) {
+      output << ' ' << usage.name << '=' << FormatBytes(usage.peak);
+    }
+    output << '\n';
+    output << "Actual Aggregation: groups=" << aggregate_groups_
+           << " spilled_groups=" << aggregate_spilled_groups_
+           << " spill_partitions=" << aggregate_spill_partitions_
+           << " spill_depth=" << aggregate_spill_depth_ << '\n';
   }
 }
 
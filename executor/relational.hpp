@@ -2,10 +2,13 @@
 #ifndef TINYLAMB_RELATIONAL_EXECUTOR_HPP
 #define TINYLAMB_RELATIONAL_EXECUTOR_HPP
 
+#include <deque>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "executor/executor_base.hpp"
+#include "executor/query_memory.hpp"
 #include "type/row.hpp"
 
 namespace tinylamb {
@@ -17,18 +20,36 @@ class RelationalExecutor : public ExecutorBase {
  public:
   RelationalExecutor(TransactionContext& context,
                      std::shared_ptr<const SelectStatement> statement);
+  RelationalExecutor(const RelationalExecutor&) = delete;
+  RelationalExecutor& operator=(const RelationalExecutor&) = delete;
+  ~RelationalExecutor() override;
   bool Next(Row* destination, RowPosition* position) override;
   void Dump(std::ostream& output, int indent) const override;
   void Explain(std::ostream& output, int indent) const override;
 
  private:
-  void Initialize();
+  class Cursor;
+
+  // Pulls the next row from the cursor, opening it on the first call and
+  // collecting the statistics once the last row has been pulled.
+  bool Pull(Row* row);
+  void Collect();
+  // Runs the query to the end, buffering the rows not pulled yet.
+  void Finish();
 
   TransactionContext* context_;
+  // Account of this query, or of the query it runs inside.
+  std::shared_ptr<MemoryContext> memory_;
+  // The statement with correlated subqueries unnested where possible.
   std::shared_ptr<const SelectStatement> statement_;
-  std::vector<Row> rows_;
-  size_t offset_{0};
-  bool initialized_{false};
+  // One line per unnested subquery, for EXPLAIN.
+  std::vector<std::string> decorrelations_;
+  std::unique_ptr<Cursor> cursor_;
+  // Rows Finish() ran ahead of Next().
+  std::deque<Row> buffered_;
+  size_t result_rows_{0};
+  // Set once every row was produced; the statistics below are valid then.
+  bool finished_{false};
   size_t hash_joins_{0};
   size_t hybrid_hash_joins_{0};
   size_t in_memory_hash_joins_{0};
@@ -55,6 +76,35 @@ class RelationalExecutor : public ExecutorBase {
   size_t scan_output_rows_{0};
   size_t scan_values_decoded_{0};
   size_t scan_values_available_{0};
+  size_t column_binds_{0};
+  size_t pipelined_rows_{0};
+  size_t parallel_hash_joins_{0};
+  size_t radix_hash_joins_{0};
+  size_t parallel_aggregations_{0};
+  size_t preaggregation_passed_rows_{0};
+  size_t aggregate_spilled_groups_{0};
+  size_t aggregate_spill_partitions_{0};
+  size_t aggregate_spill_depth_{0};
+  size_t sort_spilled_runs_{0};
+  size_t sort_spilled_rows_{0};
+  size_t top_n_sorts_{0};
+  size_t runtime_filter_scans_{0};
+  size_t runtime_filter_rejected_{0};
+  size_t late_materialized_rows_{0};
+  size_t late_fetched_rows_{0};
+  size_t semi_joins_{0};
+  size_t anti_joins_{0};
+  size_t adaptive_replans_{0};
+  size_t adaptive_build_swaps_{0};
+  // One line per re-planned or swapped join, for EXPLAIN ANALYZE.
+  std::vector<std::string> adaptive_events_;
+  // WITH queries, derived tables and subqueries run as concurrent tasks.
+  size_t concurrent_subqueries_{0};
+  // Peak bytes the query held, its grant, and the peak of each operator
+  // account.
+  size_t memory_peak_{0};
+  size_t memory_grant_{0};
+  std::vector<MemoryContext::Usage> memory_breakdown_;
 };
 
 }  // namespace tinylamb
@@ -1 +1,294 @@
-// Stub -- to be implemented
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/random_string.hpp"
+#include "database/database.hpp"
+#include "database/transaction_context.hpp"
+#include "executor/adaptive_join_order.hpp"
+#include "executor/relational.hpp"
+#include "expression/expression.hpp"
+#include "expression/named_expression.hpp"
+#include "parser/ast.hpp"
+#include "table/table.hpp"
+#include "type/column.hpp"
+#include "type/row.hpp"
+#include "type/schema.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+constexpr int64_t kRows = 200;
+
+class RelationalBindingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    database_ =
+        std::make_unique<Database>("relational_extra_test-" + RandomString());
+    TransactionContext ctx = database_->BeginContext();
+    const Schema schema("t", {Column("a", ValueType::kInt64),
+                              Column("b", ValueType::kInt64)});
+    ASSERT_TRUE(database_->CreateTable(ctx, schema).HasValue());
+    std::shared_ptr<Table> table = ctx.GetTable("t").Value();
+    for (int64_t i = 0; i < kRows; ++i) {
+      ASSERT_TRUE(
+          table->Insert(ctx.txn_, Row({Value(i), Value(i % 3)})).HasValue());
+    }
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  void TearDown() override { database_->DeleteAll(); }
+
+  // u(c, d) with c = 0..29 and d = c % 3.
+  void CreateTableU() {
+    TransactionContext ctx = database_->BeginContext();
+    const Schema schema("u", {Column("c", ValueType::kInt64),
+                              Column("d", ValueType::kInt64)});
+    ASSERT_TRUE(database_->CreateTable(ctx, schema).HasValue());
+    std::shared_ptr<Table> table = ctx.GetTable("u").Value();
+    for (int64_t i = 0; i < 30; ++i) {
+      ASSERT_TRUE(
+          table->Insert(ctx.txn_, Row({Value(i), Value(i % 3)})).HasValue());
+    }
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+
+  std::unique_ptr<Database> database_;
+};
+
+// Value of `key` in the executor's Dump line.
+size_t DumpCounter(const RelationalExecutor& executor, std::string_view key) {
+  std::ostringstream dump;
+  executor.Dump(dump, 0);
+  const std::string text = dump.str();
+  const std::string prefix = std::string(key) + "=";
+  const size_t at = text.find(prefix);
+  EXPECT_NE(at, std::string::npos) << text;
+  return at == std::string::npos ? 0
+                                 : std::stoul(text.substr(at + prefix.size()));
+}
+
+size_t ColumnBinds(const RelationalExecutor& executor) {
+  return DumpCounter(executor, "column_binds");
+}
+
+TEST_F(RelationalBindingTest, NameOnlyMatchesBindOncePerStatement) {
+  // WITH w AS (SELECT a, b FROM t) SELECT w.a + w.b AS x FROM w AS v
+  //   WHERE w.a > -1
+  // The CTE's columns are qualified by the alias v, so `w.a` only resolves
+  // through the unqualified fallback.
+  const auto column = [](const std::string& name) {
+    return ColumnValueExp("w." + name);
+  };
+  auto cte = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("a"), NamedExpression("b")},
+      std::vector<std::string>{"t"}, nullptr);
+  auto select = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression(
+          "x", BinaryExpressionExp(column("a"), BinaryOperation::kAdd,
+                                   column("b")))},
+      std::vector<std::string>{"w"},
+      BinaryExpressionExp(column("a"), BinaryOperation::kGreaterThan,
+                          ConstantValueExp(Value(int64_t{-1}))));
+  select->SetSources({SelectSource{"w", "v", nullptr, JoinType::kCross,
+                                   nullptr, std::nullopt}});
+  select->AddWithQuery("w", cte);
+  select->MarkComplex();
+
+  TransactionContext ctx = database_->BeginContext();
+  RelationalExecutor executor(ctx, select);
+  Row row;
+  int64_t total = 0;
+  int64_t rows = 0;
+  while (executor.Next(&row, nullptr)) {
+    total += row[0].value.int_value;
+    ++rows;
+  }
+  EXPECT_EQ(rows, kRows);
+  EXPECT_EQ(total, kRows * (kRows - 1) / 2 + 199);
+  // Three references, each bound once; not once per row.
+  EXPECT_LE(ColumnBinds(executor), 8U);
+  EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+}
+
+TEST_F(RelationalBindingTest, OuterAndNestedReferencesBindOncePerLoop) {
+  // SELECT CASE WHEN o.b IN (0, 1) THEN o.a ELSE -o.a END AS x FROM t AS o
+  //   WHERE o.a < (SELECT COUNT(*) FROM u WHERE u.d = o.b)
+  CreateTableU();
+  auto count = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression(
+          "n", AggregateExpressionExp(AggregationType::kCount,
+                                      ColumnValueExp("*")))},
+      std::vector<std::string>{"u"},
+      BinaryExpressionExp(ColumnValueExp("u.d"), BinaryOperation::kEquals,
+                          ColumnValueExp("o.b")));
+  auto select = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression(
+          "x",
+          CaseExpressionExp(
+              {{InExpressionExp(ColumnValueExp("o.b"),
+                                {ConstantValueExp(Value(int64_t{0})),
+                                 ConstantValueExp(Value(int64_t{1}))}),
+                ColumnValueExp("o.a")}},
+              UnaryExpressionExp(ColumnValueExp("o.a"),
+                                 UnaryOperation::kMinus)))},
+      std::vector<std::string>{"t"},
+      BinaryExpressionExp(ColumnValueExp("o.a"), BinaryOperation::kLessThan,
+                          QueryExpressionExp(count)));
+  select->SetSources({SelectSource{"t", "o", nullptr, JoinType::kCross,
+                                   nullptr, std::nullopt}});
+  select->MarkComplex();
+
+  TransactionContext ctx = database_->BeginContext();
+  RelationalExecutor executor(ctx, select);
+  Row row;
+  int64_t total = 0;
+  int64_t rows = 0;
+  while (executor.Next(&row, nullptr)) {
+    total += row[0].value.int_value;
+    ++rows;
+  }
+  // Every b matches 10 rows of u, so a = 0..9 pass.
+  int64_t expected = 0;
+  for (int64_t a = 0; a < 10; ++a) expected += a % 3 == 2 ? -a : a;
+  EXPECT_EQ(rows, 10);
+  EXPECT_EQ(total, expected);
+  EXPECT_LE(ColumnBinds(executor), 16U);
+  EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+}
+
+TEST_F(RelationalBindingTest, AdaptiveJoinsOnlyAddBookkeeping) {
+  // SELECT x.a, y.a, u.c FROM u, t AS y, t AS x
+  //   WHERE u.c < 10 AND y.a = u.c AND u.c + y.b < 2 AND x.a = y.a
+  // u joins y first; the key estimate of 10 rows keeps only c = 0, so the
+  // join into x is reported as a re-plan and builds on the intermediate.
+  CreateTableU();
+  const auto conjunction = [](Expression lhs, Expression rhs) {
+    return BinaryExpressionExp(std::move(lhs), BinaryOperation::kAnd,
+                               std::move(rhs));
+  };
+  const auto constant = [](int64_t value) {
+    return ConstantValueExp(Value(value));
+  };
+  auto select = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("x.a"),
+                                   NamedExpression("y.a"),
+                                   NamedExpression("u.c")},
+      std::vector<std::string>{"u", "t", "t"},
+      conjunction(
+          conjunction(
+              BinaryExpressionExp(ColumnValueExp("u.c"),
+                                  BinaryOperation::kLessThan, constant(10)),
+              BinaryExpressionExp(ColumnValueExp("y.a"),
+                                  BinaryOperation::kEquals,
+                                  ColumnValueExp("u.c"))),
+          conjunction(
+              BinaryExpressionExp(
+                  BinaryExpressionExp(ColumnValueExp("u.c"),
+                                      BinaryOperation::kAdd,
+                                      ColumnValueExp("y.b")),
+                  BinaryOperation::kLessThan, constant(2)),
+              BinaryExpressionExp(ColumnValueExp("x.a"),
+                                  BinaryOperation::kEquals,
+                                  ColumnValueExp("y.a")))));
+  select->SetSources(
+      {SelectSource{"u", "", nullptr, JoinType::kCross, nullptr, std::nullopt},
+       SelectSource{"t", "y", nullptr, JoinType::kCross, nullptr,
+                    std::nullopt},
+       SelectSource{"t", "x", nullptr, JoinType::kCross, nullptr,
+                    std::nullopt}});
+  select->MarkComplex();
+
+  for (const bool adaptive : {true, false}) {
+    SCOPED_TRACE(adaptive);
+    SetAdaptiveJoinsForTest(adaptive ? 1 : 0);
+    TransactionContext ctx = database_->BeginContext();
+    RelationalExecutor executor(ctx, select);
+    Row row;
+    std::vector<Row> rows;
+    while (executor.Next(&row, nullptr)) rows.push_back(row);
+    ASSERT_EQ(rows.size(), 1U);
+    EXPECT_EQ(rows[0], Row({Value(int64_t{0}), Value(int64_t{0}),
+                            Value(int64_t{0})}));
+    EXPECT_EQ(DumpCounter(executor, "adaptive_replans"), adaptive ? 1U : 0U);
+    EXPECT_EQ(DumpCounter(executor, "adaptive_build_swaps"),
+              adaptive ? 1U : 0U);
+    EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  SetAdaptiveJoinsForTest(-1);
+}
+
+// SELECT p.c, q.c, r.c FROM u AS p, u AS q, u AS r
+//   WHERE p.d = q.d AND q.d = r.d
+std::shared_ptr<SelectStatement> ThreeWayJoin(size_t limit) {
+  const auto equals = [](const std::string& lhs, const std::string& rhs) {
+    return BinaryExpressionExp(ColumnValueExp(lhs), BinaryOperation::kEquals,
+                               ColumnValueExp(rhs));
+  };
+  auto select = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("p.c"),
+                                   NamedExpression("q.c"),
+                                   NamedExpression("r.c")},
+      std::vector<std::string>{"u", "u", "u"},
+      BinaryExpressionExp(equals("p.d", "q.d"), BinaryOperation::kAnd,
+                          equals("q.d", "r.d")),
+      std::vector<SelectStatement::OrderByTerm>{}, limit);
+  std::vector<SelectSource> sources;
+  for (const char* alias : {"p", "q", "r"}) {
+    sources.push_back(SelectSource{"u", alias, nullptr, JoinType::kCross,
+                                   nullptr, std::nullopt});
+  }
+  select->SetSources(std::move(sources));
+  select->MarkComplex();
+  return select;
+}
+
+TEST_F(RelationalBindingTest, JoinChainStreamsWithoutIntermediates) {
+  // p joins q into 300 rows and r into 3000; both joins build on a base
+  // table while p streams through them, so no join result is held.
+  CreateTableU();
+  TransactionContext ctx = database_->BeginContext();
+  RelationalExecutor executor(ctx, ThreeWayJoin(0));
+  Row row;
+  size_t rows = 0;
+  while (executor.Next(&row, nullptr)) {
+    ASSERT_EQ(row[0].value.int_value % 3, row[1].value.int_value % 3);
+    ASSERT_EQ(row[1].value.int_value % 3, row[2].value.int_value % 3);
+    ++rows;
+  }
+  EXPECT_EQ(rows, 3000U);
+  EXPECT_EQ(DumpCounter(executor, "hash_joins"), 2U);
+  EXPECT_EQ(DumpCounter(executor, "pipelined_rows"), 3000U);
+  EXPECT_LE(DumpCounter(executor, "peak_intermediate_rows"), 30U);
+  EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+}
+
+TEST_F(RelationalBindingTest, NextPullsOnlyTheRowsItNeeds) {
+  CreateTableU();
+  {
+    // Stopping after one row drops the rest of the pipeline.
+    TransactionContext ctx = database_->BeginContext();
+    RelationalExecutor executor(ctx, ThreeWayJoin(0));
+    Row row;
+    ASSERT_TRUE(executor.Next(&row, nullptr));
+    EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  TransactionContext ctx = database_->BeginContext();
+  RelationalExecutor executor(ctx, ThreeWayJoin(5));
+  Row row;
+  size_t rows = 0;
+  while (executor.Next(&row, nullptr)) ++rows;
+  EXPECT_EQ(rows, 5U);
+  // LIMIT stops the scan after the first probe row's 100 matches.
+  EXPECT_LE(DumpCounter(executor, "pipelined_rows"), 100U);
+  EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+}
+
+}  // namespace
+}  // namespace tinylamb
@@ -0,0 +1,81 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/result_sink.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "executor/query_memory.hpp"
+
+namespace tinylamb {
+
+ResultSink::ResultSink(bool distinct, size_t offset, size_t limit)
+    : distinct_(distinct), offset_(offset), limit_(limit) {}
+
+void ResultSink::OrderBy(SortKeyFn key_of, bool top_n, size_t workers) {
+  const ScopedMemoryContext memory(MemoryContext::Current().Child("sort"));
+  ordered_ = true;
+  if (top_n) {
+    top_n_ =
+        std::make_unique<TopNHeap>(std::move(key_of), offset_ + limit_, workers);
+  } else {
+    sort_ = std::make_unique<ExternalSort>(std::move(key_of), workers);
+  }
+}
+
+bool ResultSink::Push(Row row) {
+  if (finished_ || (!ordered_ && Full())) return false;
+  if (distinct_) {
+    seen_key_.clear();
+    AppendFlatKey(row, &seen_key_);
+    if (!seen_.Insert(seen_key_)) return true;
+  }
+  if (top_n_) {
+    top_n_->Add(std::move(row));
+    sorted_rows_ = std::min(top_n_->InputRows(), offset_ + limit_);
+    return true;
+  }
+  if (sort_) {
+    sort_->Add(std::move(row));
+    ++sorted_rows_;
+    return true;
+  }
+  Emit(std::move(row));
+  return !Full();
+}
+
+void ResultSink::Finish() {
+  if (finished_) return;
+  finished_ = true;
+  seen_.Clear();
+  if (top_n_) top_n_->Finish();
+  if (sort_) sort_->Finish();
+}
+
+bool ResultSink::Next(Row* row) {
+  while (ready_.empty() && finished_ && (sort_ || top_n_)) {
+    Row sorted;
+    if (Full() || !(top_n_ ? top_n_->Next(&sorted) : sort_->Next(&sorted))) {
+      // Release the sorted rows as soon as the result is complete.
+      sort_.reset();
+      top_n_.reset();
+      break;
+    }
+    Emit(std::move(sorted));
+  }
+  if (ready_.empty()) return false;
+  *row = std::move(ready_.front());
+  ready_.pop_front();
+  return true;
+}
+
+void ResultSink::Emit(Row row) {
+  if (skipped_ < offset_) {
+    ++skipped_;
+    return;
+  }
+  if (Full()) return;
+  ++emitted_;
+  ready_.push_back(std::move(row));
+}
+
+}  // namespace tinylamb
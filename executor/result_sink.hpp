@@ -0,0 +1,78 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_RESULT_SINK_HPP
+#define TINYLAMB_EXECUTOR_RESULT_SINK_HPP
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "executor/external_sort.hpp"
+#include "executor/flat_hash_table.hpp"
+#include "executor/sort_key.hpp"
+#include "executor/top_n_heap.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Tail of a query: rows arrive one at a time and pass DISTINCT, then either
+// the ORDER BY sort or OFFSET/LIMIT, so only rows that reach the result or
+// the sort are ever held. The sort is an ExternalSort, which spills sorted
+// runs once the query memory budget runs out, or a TopNHeap of the first
+// OFFSET + LIMIT rows.
+//
+// Result rows are pulled with Next(). Unordered rows can be pulled as soon
+// as they are pushed; sorted ones only after Finish().
+class ResultSink {
+ public:
+  // `limit` 0 means no LIMIT.
+  ResultSink(bool distinct, size_t offset, size_t limit);
+  ResultSink(const ResultSink&) = delete;
+  ResultSink& operator=(const ResultSink&) = delete;
+
+  // Orders the result by `key_of` before OFFSET/LIMIT, in a TopNHeap when
+  // `top_n`. Call before the first Push(); the sort keeps charging a "sort"
+  // child of the memory context current at this call.
+  void OrderBy(SortKeyFn key_of, bool top_n, size_t workers);
+
+  // Returns false once the result is complete, so the caller can stop
+  // producing rows.
+  bool Push(Row row);
+  // Ends the input and sorts.
+  void Finish();
+  bool Next(Row* row);
+
+  [[nodiscard]] bool Ordered() const { return ordered_; }
+  // Rows the sort held at its peak.
+  [[nodiscard]] size_t SortedRows() const { return sorted_rows_; }
+  // The ExternalSort until its last row is pulled; nullptr with a TopNHeap
+  // or without ORDER BY.
+  [[nodiscard]] const ExternalSort* Sort() const { return sort_.get(); }
+  [[nodiscard]] const TopNHeap* TopN() const { return top_n_.get(); }
+
+ private:
+  [[nodiscard]] bool Full() const {
+    return limit_ != 0 && emitted_ >= limit_;
+  }
+  // Applies OFFSET/LIMIT to an ordered or unordered row.
+  void Emit(Row row);
+
+  const bool distinct_;
+  const size_t offset_;
+  const size_t limit_;
+  FlatHashSet<std::string_view> seen_;
+  std::string seen_key_;
+  std::unique_ptr<ExternalSort> sort_;
+  std::unique_ptr<TopNHeap> top_n_;
+  bool ordered_{false};
+  size_t sorted_rows_{0};
+  bool finished_{false};
+  size_t skipped_{0};
+  size_t emitted_{0};
+  std::deque<Row> ready_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_RESULT_SINK_HPP
@@ -0,0 +1,65 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/result_sink.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+void KeyOf(const Row& row, std::string* key) {
+  key->clear();
+  AppendSortKey(row[0], /*ascending=*/false, key);
+}
+
+std::vector<Row> Drain(ResultSink& sink) {
+  std::vector<Row> rows;
+  Row row;
+  while (sink.Next(&row)) rows.push_back(row);
+  return rows;
+}
+
+std::vector<Row> Keys(std::initializer_list<int64_t> keys) {
+  std::vector<Row> rows;
+  for (int64_t key : keys) rows.push_back(Row({Value(key)}));
+  return rows;
+}
+
+}  // namespace
+
+TEST(ResultSinkTest, UnorderedRowsLeaveAsTheyArrive) {
+  ResultSink sink(/*distinct=*/true, /*offset=*/1, /*limit=*/2);
+  EXPECT_TRUE(sink.Push(Row({Value(5)})));
+  EXPECT_TRUE(sink.Push(Row({Value(5)})));
+  EXPECT_TRUE(sink.Push(Row({Value(7)})));
+  // The first distinct row is skipped by OFFSET; 7 is ready at once.
+  EXPECT_EQ(Drain(sink), Keys({7}));
+  EXPECT_FALSE(sink.Push(Row({Value(9)})));
+  EXPECT_FALSE(sink.Push(Row({Value(11)})));
+  sink.Finish();
+  EXPECT_EQ(Drain(sink), Keys({9}));
+}
+
+TEST(ResultSinkTest, OrderedRowsWaitForFinish) {
+  for (const bool top_n : {false, true}) {
+    ResultSink sink(/*distinct=*/false, /*offset=*/1, /*limit=*/3);
+    sink.OrderBy(KeyOf, top_n, 2);
+    for (int64_t key : {4, 9, 1, 7, 3, 8}) {
+      EXPECT_TRUE(sink.Push(Row({Value(key)})));
+    }
+    Row row;
+    EXPECT_FALSE(sink.Next(&row));
+    sink.Finish();
+    EXPECT_EQ(sink.Sort() != nullptr, !top_n);
+    EXPECT_EQ(Drain(sink), Keys({8, 7, 4})) << top_n;
+    EXPECT_EQ(sink.SortedRows(), top_n ? 4U : 6U);
+  }
+}
+
+}  // namespace tinylamb
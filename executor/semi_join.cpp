@@ -0,0 +1,89 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/semi_join.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace tinylamb {
+
+std::string_view SemiJoinKindName(SemiJoinKind kind) {
+  switch (kind) {
+    case SemiJoinKind::kSemi:
+      return "HashSemiJoin";
+    case SemiJoinKind::kAnti:
+      return "HashAntiJoin";
+    case SemiJoinKind::kNullAwareAnti:
+      return "NullAwareHashAntiJoin";
+  }
+  return "HashSemiJoin";
+}
+
+SemiJoinTable::SemiJoinTable(SemiJoinKind kind,
+                             std::vector<slot_t> build_columns, bool keep_rows)
+    : kind_(kind), build_columns_(std::move(build_columns)),
+      keep_rows_(keep_rows) {
+  if (kind_ == SemiJoinKind::kNullAwareAnti &&
+      (build_columns_.size() != 1 || keep_rows_)) {
+    throw std::invalid_argument(
+        "NOT IN anti join needs exactly one key column and no residual");
+  }
+}
+
+void SemiJoinTable::Insert(const Row& row) {
+  ++build_rows_;
+  if (row.AnyNull(build_columns_)) {
+    // NULL equals nothing; only NOT IN has to remember that it was there.
+    build_has_null_ = true;
+    return;
+  }
+  if (keep_rows_) {
+    charge_.Add(EstimateRowBytes(row));
+    rows_.Insert(Key(row, build_columns_), row);
+    return;
+  }
+  if (IntegerKeyed() && row[build_columns_[0]].type == ValueType::kInt64) {
+    if (integers_.Insert(row[build_columns_[0]].value.int_value)) {
+      charge_.Add(sizeof(int64_t));
+    }
+    return;
+  }
+  const std::string_view key = Key(row, build_columns_);
+  if (keys_.Insert(key)) charge_.Add(key.size());
+}
+
+bool SemiJoinTable::Passes(const Row& probe,
+                           const std::vector<slot_t>& probe_columns) const {
+  if (keep_rows_) {
+    return Passes(probe, probe_columns, [](const Row&) { return true; });
+  }
+  const std::optional<bool> verdict = NullVerdict(probe, probe_columns);
+  if (verdict) return *verdict;
+  bool matched = false;
+  if (IntegerKeyed() && probe[probe_columns[0]].type == ValueType::kInt64) {
+    matched = integers_.Contains(probe[probe_columns[0]].value.int_value);
+  } else if (!keys_.Empty()) {
+    matched = keys_.Contains(Key(probe, probe_columns));
+  }
+  return matched == (kind_ == SemiJoinKind::kSemi);
+}
+
+std::optional<bool> SemiJoinTable::NullVerdict(
+    const Row& probe, const std::vector<slot_t>& probe_columns) const {
+  if (kind_ == SemiJoinKind::kNullAwareAnti) {
+    // x NOT IN (empty) is true even for a NULL x.
+    if (build_rows_ == 0) return true;
+    if (build_has_null_ || probe.AnyNull(probe_columns)) return false;
+    return std::nullopt;
+  }
+  if (probe.AnyNull(probe_columns)) return kind_ == SemiJoinKind::kAnti;
+  return std::nullopt;
+}
+
+std::string_view SemiJoinTable::Key(const Row& row,
+                                    const std::vector<slot_t>& columns) const {
+  key_buffer_.clear();
+  for (const slot_t column : columns) AppendFlatKey(row[column], &key_buffer_);
+  return key_buffer_;
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,95 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_SEMI_JOIN_HPP
+#define TINYLAMB_EXECUTOR_SEMI_JOIN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/constants.hpp"
+#include "executor/flat_hash_table.hpp"
+#include "executor/query_memory.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Joins that only filter their probe side: each probe row is emitted at most
+// once and no build column reaches the output.
+enum class SemiJoinKind : uint8_t {
+  // EXISTS and IN: rows with a matching build row.
+  kSemi,
+  // NOT EXISTS: rows without a matching build row. A NULL key never matches,
+  // so its row passes.
+  kAnti,
+  // NOT IN over one key column: as kAnti, except that a NULL on either side
+  // makes the comparison unknown. Rows pass only when the build side is empty
+  // or when neither the probe key nor any build key is NULL and nothing
+  // matches.
+  kNullAwareAnti,
+};
+
+// Operator name shown by Dump and EXPLAIN.
+[[nodiscard]] std::string_view SemiJoinKindName(SemiJoinKind kind);
+
+// Build side of a hash semi or anti join. Keys of single-integer joins live in
+// a FlatHashSet<int64_t>; other keys are stored by their AppendFlatKey
+// encoding. With `keep_rows` the build rows are kept under their key so a
+// residual predicate can be checked against each candidate; probing stops at
+// the first candidate that satisfies it.
+//
+// Probing reuses a key buffer, so one table must not be probed from several
+// threads at once.
+class SemiJoinTable {
+ public:
+  SemiJoinTable(SemiJoinKind kind, std::vector<slot_t> build_columns,
+                bool keep_rows = false);
+
+  void Insert(const Row& row);
+
+  // Whether `probe` survives the join.
+  [[nodiscard]] bool Passes(const Row& probe,
+                            const std::vector<slot_t>& probe_columns) const;
+
+  // As above, where a build row with the same key only counts as a match when
+  // residual(const Row& build_row) holds. Requires `keep_rows`.
+  template <typename Residual>
+  [[nodiscard]] bool Passes(const Row& probe,
+                            const std::vector<slot_t>& probe_columns,
+                            Residual&& residual) const {
+    const std::optional<bool> verdict = NullVerdict(probe, probe_columns);
+    if (verdict) return *verdict;
+    return rows_.AnyMatch(Key(probe, probe_columns), residual) ==
+           (kind_ == SemiJoinKind::kSemi);
+  }
+
+  [[nodiscard]] SemiJoinKind Kind() const { return kind_; }
+  [[nodiscard]] size_t BuildRows() const { return build_rows_; }
+
+ private:
+  // The result for `probe` when it does not depend on matching keys.
+  [[nodiscard]] std::optional<bool> NullVerdict(
+      const Row& probe, const std::vector<slot_t>& probe_columns) const;
+  [[nodiscard]] std::string_view Key(
+      const Row& row, const std::vector<slot_t>& columns) const;
+  [[nodiscard]] bool IntegerKeyed() const {
+    return !keep_rows_ && build_columns_.size() == 1;
+  }
+
+  SemiJoinKind kind_;
+  std::vector<slot_t> build_columns_;
+  bool keep_rows_;
+  size_t build_rows_{0};
+  bool build_has_null_{false};
+  FlatHashSet<int64_t> integers_;
+  FlatHashSet<std::string_view> keys_;
+  FlatMultiMap<std::string_view, Row> rows_;
+  QueryMemoryCharge charge_;
+  mutable std::string key_buffer_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_SEMI_JOIN_HPP
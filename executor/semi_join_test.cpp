@@ -0,0 +1,138 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/semi_join.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "executor/constant_executor.hpp"
+#include "executor/hash_semi_join.hpp"
+#include "gtest/gtest.h"
+#include "page/row_position.hpp"
+
+namespace tinylamb {
+namespace {
+
+SemiJoinTable Build(SemiJoinKind kind, const std::vector<Row>& rows) {
+  SemiJoinTable table(kind, {0});
+  for (const Row& row : rows) table.Insert(row);
+  return table;
+}
+
+std::vector<Row> Drain(ExecutorBase& executor) {
+  std::vector<Row> rows;
+  Row row;
+  while (executor.Next(&row, nullptr)) rows.push_back(row);
+  return rows;
+}
+
+TEST(SemiJoinTest, SemiAndAntiSplitProbeRows) {
+  const std::vector<Row> build = {Row({Value(1)}), Row({Value(1)}),
+                                  Row({Value("a")}), Row({Value()})};
+  const SemiJoinTable semi = Build(SemiJoinKind::kSemi, build);
+  const SemiJoinTable anti = Build(SemiJoinKind::kAnti, build);
+  for (const Row& probe : {Row({Value(1)}), Row({Value("a")}),
+                           Row({Value(2)}), Row({Value("b")}),
+                           Row({Value()})}) {
+    EXPECT_NE(semi.Passes(probe, {0}), anti.Passes(probe, {0})) << probe;
+  }
+  EXPECT_TRUE(semi.Passes(Row({Value(1)}), {0}));
+  EXPECT_TRUE(semi.Passes(Row({Value("a")}), {0}));
+  // A NULL key matches nothing, not even a NULL build key.
+  EXPECT_FALSE(semi.Passes(Row({Value()}), {0}));
+  EXPECT_TRUE(anti.Passes(Row({Value()}), {0}));
+  EXPECT_EQ(semi.BuildRows(), 4U);
+}
+
+TEST(SemiJoinTest, NullAwareAntiFollowsNotIn) {
+  const SemiJoinTable empty = Build(SemiJoinKind::kNullAwareAnti, {});
+  EXPECT_TRUE(empty.Passes(Row({Value()}), {0}));
+  EXPECT_TRUE(empty.Passes(Row({Value(1)}), {0}));
+
+  const SemiJoinTable plain =
+      Build(SemiJoinKind::kNullAwareAnti, {Row({Value(1)}), Row({Value(2)})});
+  EXPECT_FALSE(plain.Passes(Row({Value(1)}), {0}));
+  EXPECT_TRUE(plain.Passes(Row({Value(3)}), {0}));
+  EXPECT_FALSE(plain.Passes(Row({Value()}), {0}));
+
+  // x NOT IN (1, NULL) is never true.
+  const SemiJoinTable with_null =
+      Build(SemiJoinKind::kNullAwareAnti, {Row({Value(1)}), Row({Value()})});
+  EXPECT_FALSE(with_null.Passes(Row({Value(3)}), {0}));
+
+  EXPECT_THROW(SemiJoinTable(SemiJoinKind::kNullAwareAnti, {0, 1}),
+               std::invalid_argument);
+}
+
+TEST(SemiJoinTest, ResidualStopsAtFirstQualifyingMatch) {
+  // EXISTS (... WHERE key = probe.key AND value <> probe.value)
+  SemiJoinTable table(SemiJoinKind::kSemi, {0}, true);
+  for (int64_t value = 0; value < 5; ++value) {
+    table.Insert(Row({Value(7), Value(value)}));
+  }
+  table.Insert(Row({Value(8), Value(1)}));
+  size_t checked = 0;
+  const auto differs = [&](const Row& probe) {
+    return [&checked, probe](const Row& build) {
+      ++checked;
+      return build[1] != probe[1];
+    };
+  };
+  const Row probe({Value(7), Value(0)});
+  EXPECT_TRUE(table.Passes(probe, {0}, differs(probe)));
+  EXPECT_EQ(checked, 2U);
+
+  checked = 0;
+  const Row lonely({Value(8), Value(1)});
+  EXPECT_FALSE(table.Passes(lonely, {0}, differs(lonely)));
+  EXPECT_EQ(checked, 1U);
+
+  SemiJoinTable anti(SemiJoinKind::kAnti, {0}, true);
+  anti.Insert(Row({Value(8), Value(1)}));
+  EXPECT_TRUE(anti.Passes(lonely, {0}, differs(lonely)));
+}
+
+TEST(SemiJoinTest, CompositeKeys) {
+  SemiJoinTable table(SemiJoinKind::kSemi, {0, 1});
+  table.Insert(Row({Value(1), Value("x")}));
+  EXPECT_TRUE(table.Passes(Row({Value("x"), Value(1)}), {1, 0}));
+  EXPECT_FALSE(table.Passes(Row({Value("y"), Value(1)}), {1, 0}));
+}
+
+TEST(SemiJoinTest, HashSemiJoinEmitsEachProbeRowOnce) {
+  auto left = std::make_shared<ConstantExecutor>(std::vector<Row>{
+      Row({Value(1), Value("a")}), Row({Value(2), Value("b")}),
+      Row({Value(3), Value("c")}), Row({Value(), Value("d")})});
+  auto right = std::make_shared<ConstantExecutor>(std::vector<Row>{
+      Row({Value(1)}), Row({Value(1)}), Row({Value(3)}), Row({Value(3)})});
+  HashSemiJoin semi(left, {0}, right, {0}, SemiJoinKind::kSemi);
+  EXPECT_EQ(Drain(semi), (std::vector<Row>{Row({Value(1), Value("a")}),
+                                           Row({Value(3), Value("c")})}));
+  std::stringstream ss;
+  semi.Dump(ss, 0);
+  EXPECT_NE(ss.str().find("HashSemiJoin: left: {0} right: {0}"),
+            std::string::npos);
+}
+
+TEST(SemiJoinTest, HashAntiJoinKinds) {
+  const std::vector<Row> left_rows = {Row({Value(1)}), Row({Value(2)}),
+                                      Row({Value()})};
+  const std::vector<Row> right_rows = {Row({Value(1)}), Row({Value()})};
+  HashSemiJoin anti(std::make_shared<ConstantExecutor>(left_rows), {0},
+                    std::make_shared<ConstantExecutor>(right_rows), {0},
+                    SemiJoinKind::kAnti);
+  EXPECT_EQ(Drain(anti), (std::vector<Row>{Row({Value(2)}), Row({Value()})}));
+
+  HashSemiJoin not_in(std::make_shared<ConstantExecutor>(left_rows), {0},
+                      std::make_shared<ConstantExecutor>(right_rows), {0},
+                      SemiJoinKind::kNullAwareAnti);
+  EXPECT_TRUE(Drain(not_in).empty());
+  std::stringstream ss;
+  not_in.Dump(ss, 0);
+  EXPECT_NE(ss.str().find("NullAwareHashAntiJoin"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace tinylamb
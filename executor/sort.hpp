@@ -3,11 +3,12 @@
 #define TINYLAMB_SORT_EXECUTOR_HPP
 
 #include <algorithm>
+#include <memory>
 #include <utility>
-#include <thread>
 #include <vector>
 
 #include "executor/executor_base.hpp"
+#include "executor/external_sort.hpp"
 #include "executor/query_memory.hpp"
 #include "expression/expression.hpp"
 #include "page/row_position.hpp"
@@ -26,20 +27,23 @@ class SortExecutor : public ExecutorBase {
       : source_(std::move(source)),
         schema_(std::move(schema)),
         keys_(std::move(keys)),
-        worker_count_(std::max<size_t>(1, worker_count)) {}
+        worker_count_(std::max<size_t>(1, worker_count)),
+        memory_(MemoryContext::Current().Child("sort")) {}
   bool Next(Row* dst, RowPosition* rp) override;
   void Dump(std::ostream& output, int indent) const override;
 
+  // Encodes the normalized sort key of `keys` over rows of `schema`.
+  static SortKeyFn KeyEncoder(std::vector<Key> keys, Schema schema);
+
  private:
   void Materialize();
   Executor source_;
   Schema schema_;
   std::vector<Key> keys_;
-  std::vector<std::pair<Row, RowPosition>> rows_;
-  size_t offset_{0};
-  bool materialized_{false};
+  std::unique_ptr<ExternalSort> sort_;
   size_t worker_count_;
-  QueryMemoryCharge rows_charge_;
+  // "sort" account of the query this sort was built for.
+  std::shared_ptr<MemoryContext> memory_;
 };
 }  // namespace tinylamb
 #endif
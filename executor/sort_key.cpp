@@ -0,0 +1,33 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/sort_key.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/env_endian.hpp"
+
+namespace tinylamb {
+
+void AppendSortKey(const Value& value, bool ascending, std::string* key) {
+  const size_t begin = key->size();
+  if (value.IsNull()) {
+    key->push_back(static_cast<char>(ValueType::kNull));
+  } else {
+    *key += value.EncodeMemcomparableFormat();
+  }
+  if (ascending) return;
+  for (size_t i = begin; i < key->size(); ++i) (*key)[i] = ~(*key)[i];
+}
+
+void SortKey::Seal() {
+  // Zero padding keeps the order: a shorter key that matches a longer one
+  // up to its end sorts first either way.
+  char prefix[16] = {};
+  std::memcpy(prefix, bytes.data(), std::min(bytes.size(), sizeof(prefix)));
+  std::memcpy(&head, prefix, sizeof(head));
+  std::memcpy(&tail, prefix + sizeof(head), sizeof(tail));
+  head = be64toh(head);
+  tail = be64toh(tail);
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,55 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_SORT_KEY_HPP
+#define TINYLAMB_EXECUTOR_SORT_KEY_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+
+// Normalized sort keys.
+//
+// A row's ORDER BY values are encoded once into a byte string whose
+// memcmp order is the sort order, so comparisons need neither expression
+// evaluation nor type dispatch. Each value is its
+// Value::EncodeMemcomparableFormat(), which is prefix free and starts with
+// a non-zero type tag; NULL is the zero kNull tag alone. Keys of several
+// columns therefore just concatenate. A descending column has all of its
+// bytes inverted, so NULL sorts first ascending and last descending.
+//
+// Unlike Value::operator==, doubles that differ by less than 1e-9 are not
+// equal keys; they order by value.
+
+// key_of(row, &key) replaces `key` with the sort key of `row`.
+using SortKeyFn = std::function<void(const Row&, std::string*)>;
+
+// Appends the sort key of `value` to `key`.
+void AppendSortKey(const Value& value, bool ascending, std::string* key);
+
+// A sort key whose first 16 bytes are also held inline as two big-endian
+// words, so most comparisons are two integer compares and never touch the
+// key's heap storage.
+struct SortKey {
+  std::string bytes;
+  uint64_t head{0};
+  uint64_t tail{0};
+
+  // Refreshes `head` and `tail` after `bytes` changed.
+  void Seal();
+  // Negative, zero or positive as this key sorts before, with or after
+  // `other`.
+  [[nodiscard]] int Compare(const SortKey& other) const {
+    if (head != other.head) return head < other.head ? -1 : 1;
+    if (tail != other.tail) return tail < other.tail ? -1 : 1;
+    return bytes.compare(other.bytes);
+  }
+  bool operator<(const SortKey& other) const { return Compare(other) < 0; }
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_SORT_KEY_HPP
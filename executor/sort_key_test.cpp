@@ -0,0 +1,65 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/sort_key.hpp"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+std::string Key(const std::vector<Value>& values,
+                const std::vector<bool>& ascending) {
+  std::string key;
+  for (size_t i = 0; i < values.size(); ++i) {
+    AppendSortKey(values[i], ascending[i], &key);
+  }
+  return key;
+}
+
+// Expects the keys of `values`, one column each, to be strictly increasing.
+void ExpectOrdered(const std::vector<Value>& values, bool ascending) {
+  for (size_t i = 1; i < values.size(); ++i) {
+    EXPECT_LT(Key({values[i - 1]}, {ascending}), Key({values[i]}, {ascending}))
+        << values[i - 1] << " vs " << values[i];
+  }
+}
+
+}  // namespace
+
+TEST(SortKeyTest, OrdersEachType) {
+  ExpectOrdered({Value(), Value(int64_t{-5}), Value(0), Value(3),
+                 Value(int64_t{1} << 40)},
+                true);
+  ExpectOrdered({Value(), Value(-2.5), Value(-0.25), Value(0.0), Value(1e-3),
+                 Value(7.75)},
+                true);
+  ExpectOrdered({Value(), Value(""), Value(std::string(1, '\0')), Value("a"),
+                 Value("abcdefgh"), Value("abcdefgh\x01"), Value("abd"),
+                 Value("b")},
+                true);
+  ExpectOrdered({Value(), Value::Date("1995-03-15"), Value::Date("1998-12-01")},
+                true);
+}
+
+TEST(SortKeyTest, DescendingPutsNullLast) {
+  ExpectOrdered({Value(9), Value(2), Value(int64_t{-1}), Value()}, false);
+  ExpectOrdered({Value("b"), Value("abc"), Value("ab"), Value("")}, false);
+}
+
+TEST(SortKeyTest, ColumnsCompareLeftToRight) {
+  const std::vector<bool> order = {true, false};
+  // A shorter string in the first column must not let the second column
+  // decide.
+  EXPECT_LT(Key({Value("ab"), Value(1)}, order),
+            Key({Value("abc"), Value(9)}, order));
+  EXPECT_LT(Key({Value("ab"), Value(9)}, order),
+            Key({Value("ab"), Value(1)}, order));
+  EXPECT_LT(Key({Value("ab"), Value(1)}, order),
+            Key({Value("ab"), Value()}, order));
+  EXPECT_EQ(Key({Value(2.5), Value("x")}, order),
+            Key({Value(2.5), Value("x")}, order));
+}
+
+}  // namespace tinylamb
@@ -1,18 +1,70 @@
 /** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
 #include "executor/spill_file.hpp"
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
 #include <random>
 #include <sstream>
 #include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 
-#include "common/decoder.hpp"
-#include "common/encoder.hpp"
-#include "common/log_message.hpp"
+#include "type/value.hpp"
+#include "type/value_type.hpp"
 
 namespace tinylamb {
+
+static_assert(std::endian::native == std::endian::little,
+              "spill encoding assumes a little-endian host");
+
+// Growable buffer aligned for block I/O.
+class SpillBuffer {
+ public:
+  SpillBuffer() = default;
+  SpillBuffer(const SpillBuffer&) = delete;
+  SpillBuffer& operator=(const SpillBuffer&) = delete;
+  ~SpillBuffer() { std::free(data); }
+
+  void Reserve(size_t bytes) {
+    if (bytes <= capacity) return;
+    size_t grown = std::max(bytes, capacity * 2);
+    grown = (grown + kSpillBlockAlignment - 1) / kSpillBlockAlignment *
+            kSpillBlockAlignment;
+    char* fresh =
+        static_cast<char*>(std::aligned_alloc(kSpillBlockAlignment, grown));
+    if (fresh == nullptr) throw std::bad_alloc();
+    if (size != 0) std::memcpy(fresh, data, size);
+    std::free(data);
+    data = fresh;
+    capacity = grown;
+  }
+
+  void Append(const void* src, size_t bytes) {
+    Reserve(size + bytes);
+    std::memcpy(data + size, src, bytes);
+    size += bytes;
+  }
+
+  char* data{nullptr};
+  size_t size{0};
+  size_t capacity{0};
+};
+
 namespace {
+
 std::string RandomSuffix() {
   static thread_local std::mt19937_64 rng{std::random_device{}()};
   std::uniform_int_distribution<uint64_t> dist;
@@ -20,8 +72,451 @@ std::string RandomSuffix() {
   oss << std::hex << dist(rng);
   return oss.str();
 }
+
+int DefaultIoThreads() {
+  const char* env = std::getenv("TINYLAMB_SPILL_IO_THREADS");
+  if (env == nullptr || env[0] == '\0') return 2;
+  char* end = nullptr;
+  const long threads = std::strtol(env, &end, 10);
+  if (*end != '\0' || threads < 0) return 2;
+  return static_cast<int>(std::min(threads, 64L));
+}
+
+std::atomic<int>& IoThreads() {
+  static std::atomic<int> threads{DefaultIoThreads()};
+  return threads;
+}
+
+// Worker threads shared by every spill file. Workers start on demand and
+// live for the rest of the process, so the pool is never destroyed.
+class SpillIoPool {
+ public:
+  static SpillIoPool& Instance() {
+    static auto* pool = new SpillIoPool();
+    return *pool;
+  }
+
+  std::future<void> Submit(std::function<void()> fn) {
+    std::packaged_task<void()> task(std::move(fn));
+    std::future<void> done = task.get_future();
+    const size_t threads = SpillIoThreads();
+    if (threads == 0) {
+      task();
+      return done;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (; workers_ < threads; ++workers_) {
+        std::thread([this] { Work(); }).detach();
+      }
+      queue_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+    return done;
+  }
+
+ private:
+  void Work() {
+    for (;;) {
+      std::packaged_task<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [&] { return !queue_.empty(); });
+        task = std::move(queue_.front());
+        queue_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::deque<std::packaged_task<void()>> queue_;
+  size_t workers_{0};
+};
+
+void WriteFully(int fd, const char* src, size_t bytes, uint64_t offset) {
+  while (0 < bytes) {
+    const ssize_t written =
+        ::pwrite(fd, src, bytes, static_cast<off_t>(offset));
+    if (written < 0 && errno == EINTR) continue;
+    if (written <= 0) {
+      throw std::runtime_error(std::string("spill write failed: ") +
+                               std::strerror(errno));
+    }
+    src += written;
+    bytes -= static_cast<size_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+}
+
+void ReadFully(int fd, char* dst, size_t bytes, uint64_t offset) {
+  while (0 < bytes) {
+    const ssize_t got = ::pread(fd, dst, bytes, static_cast<off_t>(offset));
+    if (got < 0 && errno == EINTR) continue;
+    if (got < 0) {
+      throw std::runtime_error(std::string("spill read failed: ") +
+                               std::strerror(errno));
+    }
+    if (got == 0) throw std::runtime_error("spill file truncated");
+    dst += got;
+    bytes -= static_cast<size_t>(got);
+    offset += static_cast<uint64_t>(got);
+  }
+}
+
+// Block header: magic, batch count, payload bytes. The block is padded with
+// zeros to a multiple of kSpillBlockAlignment.
+constexpr uint32_t kBlockMagic = 0x50534c54;  // "TLSP"
+constexpr size_t kBlockHeaderBytes = 16;
+
+// How a column stores its NULLs.
+constexpr uint8_t kNoNulls = 0;
+constexpr uint8_t kSomeNulls = 1;
+constexpr uint8_t kAllNull = 2;
+
+// How a VARCHAR column stores its values.
+constexpr uint8_t kPlainStrings = 0;
+constexpr uint8_t kDictionaryStrings = 1;
+
+template <typename T>
+void Put(SpillBuffer* out, T value) {
+  out->Append(&value, sizeof(value));
+}
+
+void PutVarint(SpillBuffer* out, uint64_t value) {
+  uint8_t bytes[10];
+  size_t length = 0;
+  while (0x80 <= value) {
+    bytes[length++] = static_cast<uint8_t>(value) | 0x80;
+    value >>= 7;
+  }
+  bytes[length++] = static_cast<uint8_t>(value);
+  out->Append(bytes, length);
+}
+
+// Frame of reference: the minimum, then each value's distance from it in the
+// fewest bytes that hold the largest distance.
+void PutIntegers(SpillBuffer* out, const std::vector<int64_t>& values) {
+  int64_t base = 0;
+  uint64_t range = 0;
+  if (!values.empty()) {
+    const auto [min, max] = std::ranges::minmax(values);
+    base = min;
+    range = static_cast<uint64_t>(max) - static_cast<uint64_t>(min);
+  }
+  const uint8_t width = range == 0                ? 0
+                        : range <= 0xff           ? 1
+                        : range <= 0xffff         ? 2
+                        : range <= 0xffffffffULL  ? 4
+                                                  : 8;
+  Put(out, base);
+  Put(out, width);
+  if (width == 0) return;
+  out->Reserve(out->size + values.size() * width);
+  for (int64_t value : values) {
+    const uint64_t delta =
+        static_cast<uint64_t>(value) - static_cast<uint64_t>(base);
+    std::memcpy(out->data + out->size, &delta, width);
+    out->size += width;
+  }
+}
+
+void PutStrings(SpillBuffer* out, const std::vector<std::string_view>& values) {
+  // A dictionary pays off once values repeat; give up on it as soon as more
+  // than half of them are distinct.
+  const size_t limit = std::min<size_t>(values.size() / 2, 0xffff);
+  std::unordered_map<std::string_view, uint16_t> codes;
+  std::vector<std::string_view> dictionary;
+  bool use_dictionary = 0 < limit;
+  for (size_t i = 0; use_dictionary && i < values.size(); ++i) {
+    if (codes.try_emplace(values[i], dictionary.size()).second) {
+      dictionary.push_back(values[i]);
+      use_dictionary = dictionary.size() <= limit;
+    }
+  }
+  if (!use_dictionary) {
+    Put(out, kPlainStrings);
+    for (std::string_view value : values) PutVarint(out, value.size());
+    for (std::string_view value : values) {
+      out->Append(value.data(), value.size());
+    }
+    return;
+  }
+  Put(out, kDictionaryStrings);
+  PutVarint(out, dictionary.size());
+  for (std::string_view value : dictionary) {
+    PutVarint(out, value.size());
+    out->Append(value.data(), value.size());
+  }
+  const uint8_t width = dictionary.size() <= 0x100 ? 1 : 2;
+  Put(out, width);
+  out->Reserve(out->size + values.size() * width);
+  for (std::string_view value : values) {
+    const uint16_t code = codes[value];
+    std::memcpy(out->data + out->size, &code, width);
+    out->size += width;
+  }
+}
+
+size_t CountNulls(const ColumnVector& column, size_t rows) {
+  size_t nulls = 0;
+  const std::vector<uint64_t>& bitmap = column.NullBitmap();
+  for (size_t word = 0; word * 64 < rows && word < bitmap.size(); ++word) {
+    uint64_t bits = bitmap[word];
+    if (rows < (word + 1) * 64) bits &= (uint64_t{1} << (rows % 64)) - 1;
+    nulls += static_cast<size_t>(std::popcount(bits));
+  }
+  return nulls;
+}
+
+void EncodeBatch(const DataChunk& chunk, bool positions, SpillBuffer* out) {
+  const size_t rows = chunk.Size();
+  Put(out, static_cast<uint32_t>(rows));
+  Put(out, static_cast<uint32_t>(chunk.ColumnCount()));
+  std::vector<int64_t> integers;
+  std::vector<std::string_view> strings;
+  for (size_t c = 0; c < chunk.ColumnCount(); ++c) {
+    const ColumnVector& column = chunk.ColumnAt(c);
+    const ValueType type = column.Type();
+    const size_t nulls = CountNulls(column, rows);
+    Put(out, static_cast<uint8_t>(type));
+    if (type == ValueType::kNull || nulls == rows) {
+      Put(out, kAllNull);
+      continue;
+    }
+    if (nulls == 0) {
+      Put(out, kNoNulls);
+    } else {
+      Put(out, kSomeNulls);
+      out->Append(column.NullBitmap().data(), (rows + 63) / 64 * 8);
+    }
+    switch (type) {
+      case ValueType::kInt64:
+      case ValueType::kDate:
+        integers.clear();
+        for (size_t i = 0; i < rows; ++i) {
+          if (!column.IsNull(i)) integers.push_back(column.IntegerData()[i]);
+        }
+        PutIntegers(out, integers);
+        break;
+      case ValueType::kDouble:
+        for (size_t i = 0; i < rows; ++i) {
+          if (!column.IsNull(i)) Put(out, column.DoubleData()[i]);
+        }
+        break;
+      case ValueType::kVarChar:
+        strings.clear();
+        for (size_t i = 0; i < rows; ++i) {
+          if (!column.IsNull(i)) strings.emplace_back(column.StringData()[i]);
+        }
+        PutStrings(out, strings);
+        break;
+      case ValueType::kNull:
+        break;
+    }
+  }
+  if (!positions) return;
+  std::vector<int64_t> slots;
+  integers.clear();
+  for (size_t i = 0; i < rows; ++i) {
+    integers.push_back(static_cast<int64_t>(chunk.PositionAt(i).page_id));
+    slots.push_back(chunk.PositionAt(i).slot);
+  }
+  PutIntegers(out, integers);
+  PutIntegers(out, slots);
+}
+
+// Bounds-checked reads over one block's payload.
+class Cursor {
+ public:
+  Cursor(const char* begin, const char* end) : at_(begin), end_(end) {}
+
+  [[nodiscard]] const char* At() const { return at_; }
+
+  const char* Take(size_t bytes) {
+    if (static_cast<size_t>(end_ - at_) < bytes) {
+      throw std::runtime_error("corrupt spill block");
+    }
+    const char* taken = at_;
+    at_ += bytes;
+    return taken;
+  }
+
+  template <typename T>
+  T Get() {
+    T value;
+    std::memcpy(&value, Take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  uint64_t GetVarint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const auto byte = Get<uint8_t>();
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) return value;
+    }
+    throw std::runtime_error("corrupt spill block");
+  }
+
+ private:
+  const char* at_;
+  const char* end_;
+};
+
+void GetIntegers(Cursor* in, size_t count, std::vector<int64_t>* out) {
+  const auto base = in->Get<int64_t>();
+  const auto width = in->Get<uint8_t>();
+  if (width != 0 && width != 1 && width != 2 && width != 4 && width != 8) {
+    throw std::runtime_error("corrupt spill block");
+  }
+  out->resize(count);
+  const char* packed = in->Take(count * width);
+  for (size_t i = 0; i < count; ++i) {
+    uint64_t delta = 0;
+    std::memcpy(&delta, packed + i * width, width);
+    (*out)[i] = static_cast<int64_t>(static_cast<uint64_t>(base) + delta);
+  }
+}
+
+void GetStrings(Cursor* in, size_t count, std::vector<std::string>* out) {
+  out->resize(count);
+  const auto encoding = in->Get<uint8_t>();
+  if (encoding == kPlainStrings) {
+    std::vector<uint64_t> lengths(count);
+    for (uint64_t& length : lengths) length = in->GetVarint();
+    for (size_t i = 0; i < count; ++i) {
+      (*out)[i].assign(in->Take(lengths[i]), lengths[i]);
+    }
+    return;
+  }
+  if (encoding != kDictionaryStrings) {
+    throw std::runtime_error("corrupt spill block");
+  }
+  std::vector<std::string_view> dictionary(in->GetVarint());
+  for (std::string_view& entry : dictionary) {
+    const uint64_t length = in->GetVarint();
+    entry = std::string_view(in->Take(length), length);
+  }
+  const auto width = in->Get<uint8_t>();
+  if (width != 1 && width != 2) throw std::runtime_error("corrupt spill block");
+  const char* packed = in->Take(count * width);
+  for (size_t i = 0; i < count; ++i) {
+    uint16_t code = 0;
+    std::memcpy(&code, packed + i * width, width);
+    if (dictionary.size() <= code) {
+      throw std::runtime_error("corrupt spill block");
+    }
+    (*out)[i] = dictionary[code];
+  }
+}
+
+// Decodes one batch at `in` straight into rows.
+void DecodeBatch(Cursor* in, bool positions, std::vector<Row>* rows,
+                 std::vector<RowPosition>* row_positions) {
+  const auto count = in->Get<uint32_t>();
+  const auto width = in->Get<uint32_t>();
+  rows->resize(count);
+  for (Row& row : *rows) row.values_.resize(width);
+  std::vector<uint64_t> bitmap;
+  std::vector<int64_t> integers;
+  std::vector<std::string> strings;
+  for (uint32_t c = 0; c < width; ++c) {
+    const auto type = static_cast<ValueType>(in->Get<uint8_t>());
+    const auto nulls = in->Get<uint8_t>();
+    if (nulls == kAllNull) continue;
+    const size_t words = (count + 63) / 64;
+    bitmap.assign(words, 0);
+    if (nulls == kSomeNulls) {
+      std::memcpy(bitmap.data(), in->Take(words * 8), words * 8);
+    } else if (nulls != kNoNulls) {
+      throw std::runtime_error("corrupt spill block");
+    }
+    const auto is_null = [&](size_t i) {
+      return (bitmap[i / 64] & (uint64_t{1} << (i % 64))) != 0;
+    };
+    size_t present = count;
+    for (size_t i = 0; i < count; ++i) present -= is_null(i) ? 1 : 0;
+    size_t next = 0;
+    switch (type) {
+      case ValueType::kInt64:
+      case ValueType::kDate:
+        GetIntegers(in, present, &integers);
+        for (size_t i = 0; i < count; ++i) {
+          if (is_null(i)) continue;
+          (*rows)[i].values_[c] = type == ValueType::kDate
+                                      ? Value::DateFromDays(integers[next++])
+                                      : Value(integers[next++]);
+        }
+        break;
+      case ValueType::kDouble:
+        for (size_t i = 0; i < count; ++i) {
+          if (!is_null(i)) (*rows)[i].values_[c] = Value(in->Get<double>());
+        }
+        break;
+      case ValueType::kVarChar:
+        GetStrings(in, present, &strings);
+        for (size_t i = 0; i < count; ++i) {
+          if (!is_null(i)) {
+            (*rows)[i].values_[c] = Value(std::move(strings[next++]));
+          }
+        }
+        break;
+      case ValueType::kNull:
+      default:
+        throw std::runtime_error("corrupt spill block");
+    }
+  }
+  if (!positions) return;
+  std::vector<int64_t> slots;
+  GetIntegers(in, count, &integers);
+  GetIntegers(in, count, &slots);
+  row_positions->resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    (*row_positions)[i] =
+        RowPosition(static_cast<page_id_t>(integers[i]),
+                    static_cast<slot_t>(slots[i]));
+  }
+}
+
+// Rough in-memory bytes of a row, used to cap batches of wide rows.
+size_t StagedBytes(const Row& row) {
+  size_t bytes = 0;
+  for (const Value& value : row.values_) {
+    bytes += sizeof(int64_t);
+    if (value.type == ValueType::kVarChar) {
+      bytes += value.value.varchar_value.size();
+    }
+  }
+  return bytes;
+}
+
+// Whether `row` can join `chunk` without changing a column's type.
+bool Fits(const DataChunk& chunk, const Row& row) {
+  if (chunk.ColumnCount() == 0 && chunk.Empty()) return true;
+  if (chunk.ColumnCount() != row.values_.size()) return false;
+  for (size_t i = 0; i < chunk.ColumnCount(); ++i) {
+    const ValueType have = chunk.ColumnAt(i).Type();
+    if (!row[i].IsNull() && have != ValueType::kNull &&
+        have != row[i].type) {
+      return false;
+    }
+  }
+  return true;
+}
+
 }  // namespace
 
+size_t SpillIoThreads() {
+  return static_cast<size_t>(IoThreads().load(std::memory_order_relaxed));
+}
+
+void SetSpillIoThreadsForTest(int threads) {
+  IoThreads().store(threads < 0 ? DefaultIoThreads() : threads,
+                    std::memory_order_relaxed);
+}
+
 std::filesystem::path SpillFile::TempDirectory() {
   if (const char* env = std::getenv("TINYLAMB_TEMP");
       env != nullptr && env[0] != '\0') {
@@ -36,59 +531,69 @@ SpillFile::SpillFile() {
   path_ = TempDirectory() / ("tinylamb-spill-" + RandomSuffix() + ".bin");
 }
 
-SpillFile::SpillFile(SpillFile&& other) noexcept
-    : path_(std::move(other.path_)),
-      stream_(std::move(other.stream_)),
-      count_(other.count_),
-      writing_(other.writing_),
-      finished_(other.finished_),
-      has_positions_(other.has_positions_) {
-  other.count_ = 0;
-  other.writing_ = false;
-  other.finished_ = false;
-}
+SpillFile::SpillFile(SpillFile&& other) noexcept { MoveFrom(other); }
 
 SpillFile& SpillFile::operator=(SpillFile&& other) noexcept {
   if (this != &other) {
-    if (!path_.empty() && std::filesystem::exists(path_)) {
+    Close();
+    if (!path_.empty()) {
       std::error_code ec;
       std::filesystem::remove(path_, ec);
     }
-    path_ = std::move(other.path_);
-    stream_ = std::move(other.stream_);
-    count_ = other.count_;
-    writing_ = other.writing_;
-    finished_ = other.finished_;
-    has_positions_ = other.has_positions_;
-    other.count_ = 0;
-    other.writing_ = false;
-    other.finished_ = false;
+    MoveFrom(other);
   }
   return *this;
 }
 
 SpillFile::~SpillFile() {
-  if (stream_.is_open()) {
-    stream_.close();
-  }
+  Close();
   if (!path_.empty()) {
     std::error_code ec;
     std::filesystem::remove(path_, ec);
   }
 }
 
-void SpillFile::OpenForWrite() {
-  if (writing_) {
-    return;
+void SpillFile::MoveFrom(SpillFile& other) noexcept {
+  path_ = std::move(other.path_);
+  other.path_.clear();
+  count_ = std::exchange(other.count_, 0);
+  finished_ = std::exchange(other.finished_, false);
+  has_positions_ = std::exchange(other.has_positions_, false);
+  pending_ = std::exchange(other.pending_, DataChunk());
+  pending_bytes_ = std::exchange(other.pending_bytes_, 0);
+  block_ = std::move(other.block_);
+  block_batches_ = std::exchange(other.block_batches_, 0);
+  spare_ = std::move(other.spare_);
+  write_ = std::move(other.write_);
+  write_fd_ = std::exchange(other.write_fd_, -1);
+  file_bytes_ = std::exchange(other.file_bytes_, 0);
+  blocks_ = std::exchange(other.blocks_, {});
+  read_fd_ = std::exchange(other.read_fd_, -1);
+  next_block_ = std::exchange(other.next_block_, 0);
+  fetched_ = std::move(other.fetched_);
+  read_ahead_ = std::move(other.read_ahead_);
+  reading_ = std::move(other.reading_);
+  read_offset_ = std::exchange(other.read_offset_, 0);
+  batches_left_ = std::exchange(other.batches_left_, 0);
+  batch_rows_ = std::exchange(other.batch_rows_, {});
+  batch_positions_ = std::exchange(other.batch_positions_, {});
+  batch_next_ = std::exchange(other.batch_next_, 0);
+}
+
+void SpillFile::Close() noexcept {
+  for (std::future<void>* io : {&write_, &read_ahead_}) {
+    if (!io->valid()) continue;
+    try {
+      io->get();
+    } catch (...) {
+      // Nothing left to report the failure to.
+    }
   }
-  stream_.open(path_, std::ios::binary | std::ios::out | std::ios::trunc);
-  if (!stream_) {
-    throw std::runtime_error("failed to create spill file: " + path_.string());
+  for (int* fd : {&write_fd_, &read_fd_}) {
+    if (*fd < 0) continue;
+    ::close(*fd);
+    *fd = -1;
   }
-  // Placeholder for count; rewritten in FinishWriting.
-  const uint64_t zero = 0;
-  stream_.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
-  writing_ = true;
 }
 
 void SpillFile::Append(const Row& row) {
@@ -98,10 +603,7 @@ void SpillFile::Append(const Row& row) {
   if (count_ > 0 && has_positions_) {
     throw std::runtime_error("SpillFile position mode mismatch");
   }
-  OpenForWrite();
-  Encoder enc(stream_);
-  enc << row;
-  ++count_;
+  Stage(row, RowPosition());
 }
 
 void SpillFile::Append(const Row& row, const RowPosition& position) {
@@ -112,36 +614,183 @@ void SpillFile::Append(const Row& row, const RowPosition& position) {
     throw std::runtime_error("SpillFile position mode mismatch");
   }
   has_positions_ = true;
-  OpenForWrite();
-  Encoder enc(stream_);
-  enc << row << position;
+  Stage(row, position);
+}
+
+void SpillFile::Stage(const Row& row, const RowPosition& position) {
+  if (!Fits(pending_, row)) {
+    // A column changed type (or the width changed): start a new batch.
+    FlushBatch();
+    pending_ = DataChunk();
+  }
+  pending_.Append(row, position);
+  pending_bytes_ += StagedBytes(row);
   ++count_;
+  if (kSpillBatchRows <= pending_.Size() ||
+      kSpillBlockBytes <= pending_bytes_) {
+    FlushBatch();
+  }
+}
+
+void SpillFile::FlushBatch() {
+  if (pending_.Empty()) return;
+  if (!block_) block_ = std::make_shared<SpillBuffer>();
+  if (block_batches_ == 0) {
+    block_->size = 0;
+    block_->Reserve(kSpillBlockBytes + kBlockHeaderBytes);
+    block_->size = kBlockHeaderBytes;
+  }
+  EncodeBatch(pending_, has_positions_, block_.get());
+  ++block_batches_;
+  pending_.Reset();
+  pending_bytes_ = 0;
+  if (kSpillBlockBytes <= block_->size) FlushBlock();
+}
+
+void SpillFile::FlushBlock() {
+  if (!block_ || block_batches_ == 0) return;
+  const uint64_t payload = block_->size - kBlockHeaderBytes;
+  std::memcpy(block_->data, &kBlockMagic, sizeof(kBlockMagic));
+  std::memcpy(block_->data + 4, &block_batches_, sizeof(block_batches_));
+  std::memcpy(block_->data + 8, &payload, sizeof(payload));
+  const size_t padded = (block_->size + kSpillBlockAlignment - 1) /
+                        kSpillBlockAlignment * kSpillBlockAlignment;
+  block_->Reserve(padded);
+  std::memset(block_->data + block_->size, 0, padded - block_->size);
+  block_->size = padded;
+  block_batches_ = 0;
+
+  // One write in flight: the previous block must land before its buffer is
+  // reused for the block after this one.
+  WaitForWrite();
+  if (write_fd_ < 0) {
+    write_fd_ = ::open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                       0600);
+    if (write_fd_ < 0) {
+      throw std::runtime_error("failed to create spill file: " +
+                               path_.string());
+    }
+  }
+  std::shared_ptr<SpillBuffer> written = std::move(block_);
+  block_ = std::move(spare_);
+  spare_ = written;
+  const int fd = write_fd_;
+  const uint64_t offset = file_bytes_;
+  blocks_.push_back({offset, padded});
+  file_bytes_ += padded;
+  write_ = SpillIoPool::Instance().Submit([written, fd, offset, padded] {
+    WriteFully(fd, written->data, padded, offset);
+  });
+}
+
+void SpillFile::WaitForWrite() {
+  if (write_.valid()) write_.get();
 }
 
 void SpillFile::FinishWriting() {
-  if (!writing_ || finished_) {
-    finished_ = true;
+  if (finished_) {
     return;
   }
-  stream_.seekp(0);
-  stream_.write(reinterpret_cast<const char*>(&count_), sizeof(count_));
-  stream_.flush();
-  stream_.close();
-  writing_ = false;
+  FlushBatch();
+  FlushBlock();
+  WaitForWrite();
+  if (write_fd_ >= 0) {
+    ::close(write_fd_);
+    write_fd_ = -1;
+  }
+  pending_ = DataChunk();
+  block_.reset();
+  spare_.reset();
   finished_ = true;
 }
 
-void SpillFile::EnsureReader() {
-  if (!finished_) {
-    FinishWriting();
-  }
-  if (stream_.is_open()) {
-    stream_.close();
+void SpillFile::OpenReader() {
+  FinishWriting();
+  if (read_ahead_.valid()) {
+    try {
+      read_ahead_.get();
+    } catch (...) {
+      // The fetch is discarded along with the reader it belonged to.
+    }
   }
-  stream_.open(path_, std::ios::binary | std::ios::in);
-  if (!stream_) {
+  if (read_fd_ >= 0) ::close(read_fd_);
+  batch_rows_.clear();
+  batch_positions_.clear();
+  batch_next_ = 0;
+  batches_left_ = 0;
+  next_block_ = 0;
+  read_fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+  if (read_fd_ < 0) {
     throw std::runtime_error("failed to open spill file: " + path_.string());
   }
+  FetchBlock();
+}
+
+void SpillFile::FetchBlock() {
+  if (blocks_.size() <= next_block_) return;
+  if (!fetched_) fetched_ = std::make_shared<SpillBuffer>();
+  const Extent extent = blocks_[next_block_];
+  std::shared_ptr<SpillBuffer> buffer = fetched_;
+  buffer->size = 0;
+  buffer->Reserve(extent.bytes);
+  buffer->size = extent.bytes;
+  const int fd = read_fd_;
+  read_ahead_ = SpillIoPool::Instance().Submit([buffer, fd, extent] {
+    ReadFully(fd, buffer->data, extent.bytes, extent.offset);
+  });
+}
+
+bool SpillFile::NextBatch() {
+  batch_rows_.clear();
+  batch_positions_.clear();
+  batch_next_ = 0;
+  if (read_fd_ < 0) return false;
+  if (batches_left_ == 0) {
+    if (blocks_.size() <= next_block_) {
+      ::close(read_fd_);
+      read_fd_ = -1;
+      return false;
+    }
+    read_ahead_.get();
+    std::swap(reading_, fetched_);
+    ++next_block_;
+    // Fetch the next block while this one is decoded.
+    FetchBlock();
+    uint32_t magic = 0;
+    uint64_t payload = 0;
+    std::memcpy(&magic, reading_->data, sizeof(magic));
+    std::memcpy(&batches_left_, reading_->data + 4, sizeof(batches_left_));
+    std::memcpy(&payload, reading_->data + 8, sizeof(payload));
+    if (magic != kBlockMagic || batches_left_ == 0 ||
+        reading_->size - kBlockHeaderBytes < payload) {
+      batches_left_ = 0;
+      throw std::runtime_error("corrupt spill block");
+    }
+    reading_->size = kBlockHeaderBytes + payload;
+    read_offset_ = kBlockHeaderBytes;
+  }
+  Cursor in(reading_->data + read_offset_, reading_->data + reading_->size);
+  DecodeBatch(&in, has_positions_, &batch_rows_, &batch_positions_);
+  read_offset_ = static_cast<size_t>(in.At() - reading_->data);
+  --batches_left_;
+  return true;
+}
+
+void SpillFile::StartReading() {
+  if (count_ == 0) return;
+  OpenReader();
+}
+
+bool SpillFile::ReadNext(Row* row, RowPosition* position) {
+  while (batch_rows_.size() <= batch_next_) {
+    if (!NextBatch()) return false;
+  }
+  *row = std::move(batch_rows_[batch_next_]);
+  if (has_positions_ && position != nullptr) {
+    *position = batch_positions_[batch_next_];
+  }
+  ++batch_next_;
+  return true;
 }
 
 std::vector<Row> SpillFile::ReadAllRows() {
@@ -151,16 +800,11 @@ std::vector<Row> SpillFile::ReadAllRows() {
   if (has_positions_) {
     throw std::runtime_error("ReadAllRows on positioned spill");
   }
-  EnsureReader();
-  uint64_t stored = 0;
-  stream_.read(reinterpret_cast<char*>(&stored), sizeof(stored));
-  Decoder dec(stream_);
+  OpenReader();
   std::vector<Row> rows;
-  rows.reserve(static_cast<size_t>(stored));
-  for (uint64_t i = 0; i < stored; ++i) {
-    Row row;
-    dec >> row;
-    rows.push_back(std::move(row));
+  rows.reserve(static_cast<size_t>(count_));
+  while (NextBatch()) {
+    std::ranges::move(batch_rows_, std::back_inserter(rows));
   }
   return rows;
 }
@@ -172,17 +816,13 @@ std::vector<std::pair<Row, RowPosition>> SpillFile::ReadAllPositioned() {
   if (!has_positions_) {
     throw std::runtime_error("ReadAllPositioned on row-only spill");
   }
-  EnsureReader();
-  uint64_t stored = 0;
-  stream_.read(reinterpret_cast<char*>(&stored), sizeof(stored));
-  Decoder dec(stream_);
+  OpenReader();
   std::vector<std::pair<Row, RowPosition>> rows;
-  rows.reserve(static_cast<size_t>(stored));
-  for (uint64_t i = 0; i < stored; ++i) {
-    Row row;
-    RowPosition position;
-    dec >> row >> position;
-    rows.emplace_back(std::move(row), position);
+  rows.reserve(static_cast<size_t>(count_));
+  while (NextBatch()) {
+    for (size_t i = 0; i < batch_rows_.size(); ++i) {
+      rows.emplace_back(std::move(batch_rows_[i]), batch_positions_[i]);
+    }
   }
   return rows;
 }
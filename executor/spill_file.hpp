@@ -2,22 +2,55 @@
 #ifndef TINYLAMB_SPILL_FILE_HPP
 #define TINYLAMB_SPILL_FILE_HPP
 
+#include <cstddef>
 #include <cstdint>
-#include <fstream>
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "common/decoder.hpp"
+#include "executor/data_chunk.hpp"
 #include "page/row_position.hpp"
 #include "type/row.hpp"
 
 namespace tinylamb {
 
+// Background threads that write spill blocks and read the next block ahead
+// of the reader.
+//
+// Config: TINYLAMB_SPILL_IO_THREADS
+//   - unset: 2
+//   - "0": spill I/O runs synchronously on the calling thread
+[[nodiscard]] size_t SpillIoThreads();
+
+// Test helper: overrides the thread count; -1 restores the environment
+// default.
+void SetSpillIoThreadsForTest(int threads);
+
+// Rows buffered per column batch before it is encoded.
+inline constexpr size_t kSpillBatchRows = kDefaultVectorSize;
+// Encoded batches are gathered into blocks of at least this many bytes,
+// written with one aligned write each.
+inline constexpr size_t kSpillBlockBytes = 64 * 1024;
+// Alignment of block buffers and of block offsets in the file.
+inline constexpr size_t kSpillBlockAlignment = 4096;
+
+// Aligned block buffer; defined in spill_file.cpp.
+class SpillBuffer;
+
 // Temporary on-disk row store for operator spill. Files live under
 // TINYLAMB_TEMP (or /tmp) and are deleted on destruction.
+//
+// Appended rows are buffered in a DataChunk and encoded a batch at a time,
+// column by column: integers and dates as frame-of-reference deltas packed
+// to the narrowest byte width, strings through a dictionary when values
+// repeat, NULLs as a bitmap. Batches are gathered into 4 KiB-aligned blocks
+// that background threads write while the next block fills; reads fetch the
+// next block while the current one is decoded.
 class SpillFile {
  public:
   SpillFile();
@@ -34,6 +67,8 @@ class SpillFile {
   [[nodiscard]] uint64_t Count() const { return count_; }
   [[nodiscard]] bool Empty() const { return count_ == 0; }
   [[nodiscard]] const std::filesystem::path& Path() const { return path_; }
+  // Bytes written to disk so far, block padding included.
+  [[nodiscard]] uint64_t DiskBytes() const { return file_bytes_; }
 
   // Sequential read of all rows (positions ignored if written without them).
   std::vector<Row> ReadAllRows();
@@ -48,29 +83,65 @@ class SpillFile {
     if (has_positions_) {
       throw std::runtime_error("ForEachRow on positioned spill");
     }
-    EnsureReader();
-    uint64_t stored = 0;
-    stream_.read(reinterpret_cast<char*>(&stored), sizeof(stored));
-    Decoder dec(stream_);
-    for (uint64_t i = 0; i < stored; ++i) {
-      Row row;
-      dec >> row;
-      fn(row);
+    OpenReader();
+    while (NextBatch()) {
+      for (Row& row : batch_rows_) fn(row);
     }
   }
 
+  // Reads rows one at a time: StartReading(), then ReadNext() until it
+  // returns false. Unlike ForEachRow, several files can be read in step.
+  void StartReading();
+  bool ReadNext(Row* row, RowPosition* position = nullptr);
+
   static std::filesystem::path TempDirectory();
 
  private:
-  void OpenForWrite();
-  void EnsureReader();
+  struct Extent {
+    uint64_t offset;
+    uint64_t bytes;
+  };
+
+  void Stage(const Row& row, const RowPosition& position);
+  void FlushBatch();
+  void FlushBlock();
+  void WaitForWrite();
+  void OpenReader();
+  void FetchBlock();
+  // Decodes the next batch into batch_rows_ / batch_positions_; false at the
+  // end of the file.
+  bool NextBatch();
+  // Waits for background I/O and closes both descriptors.
+  void Close() noexcept;
+  void MoveFrom(SpillFile& other) noexcept;
 
   std::filesystem::path path_;
-  std::fstream stream_;
   uint64_t count_{0};
-  bool writing_{false};
   bool finished_{false};
   bool has_positions_{false};
+
+  // Writing.
+  DataChunk pending_;
+  size_t pending_bytes_{0};
+  std::shared_ptr<SpillBuffer> block_;
+  uint32_t block_batches_{0};
+  std::shared_ptr<SpillBuffer> spare_;
+  std::future<void> write_;
+  int write_fd_{-1};
+  uint64_t file_bytes_{0};
+  std::vector<Extent> blocks_;
+
+  // Reading.
+  int read_fd_{-1};
+  size_t next_block_{0};
+  std::shared_ptr<SpillBuffer> fetched_;
+  std::future<void> read_ahead_;
+  std::shared_ptr<SpillBuffer> reading_;
+  size_t read_offset_{0};
+  uint32_t batches_left_{0};
+  std::vector<Row> batch_rows_;
+  std::vector<RowPosition> batch_positions_;
+  size_t batch_next_{0};
 };
 
 }  // namespace tinylamb
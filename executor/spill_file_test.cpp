@@ -4,6 +4,8 @@
 #include <cstdlib>
 #include <filesystem>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "type/row.hpp"
@@ -242,4 +244,94 @@ TEST(SpillFileTest, ReadAllFailsWhenFileDeleted) {
   EXPECT_THROW(spill.ReadAllRows(), std::runtime_error);
 }
 
+TEST(SpillFileTest, ReadNextInterleavesFiles) {
+  SpillFile left;
+  SpillFile right;
+  for (int i = 0; i < 3; ++i) {
+    left.Append(Row({Value(i)}), RowPosition(1, i));
+    right.Append(Row({Value(i + 10), Value("r")}));
+  }
+  left.StartReading();
+  right.StartReading();
+  Row row;
+  RowPosition position;
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(left.ReadNext(&row, &position));
+    EXPECT_EQ(row, Row({Value(i)}));
+    EXPECT_EQ(position, RowPosition(1, i));
+    ASSERT_TRUE(right.ReadNext(&row));
+    EXPECT_EQ(row, Row({Value(i + 10), Value("r")}));
+  }
+  EXPECT_FALSE(left.ReadNext(&row));
+  EXPECT_FALSE(right.ReadNext(&row));
+}
+
+TEST(SpillFileTest, MixedTypesAndNullsRoundTrip) {
+  std::vector<Row> written;
+  for (int i = 0; i < 3000; ++i) {
+    written.push_back(Row(
+        {i % 7 == 0 ? Value() : Value(int64_t{1} << 40 | i),
+         i % 5 == 0 ? Value() : Value("tag" + std::to_string(i % 3)),
+         Value(0.5 * i), Value::DateFromDays(19000 + i % 30),
+         Value("unique-" + std::to_string(i)), Value()}));
+  }
+  // A column changing type starts a new batch instead of failing.
+  written.push_back(Row({Value("text"), Value(1), Value(2), Value(3.0),
+                         Value(), Value(4)}));
+  written.push_back(Row({Value(-5), Value(), Value(), Value(), Value(),
+                         Value()}));
+  SpillFile spill;
+  for (const Row& row : written) spill.Append(row);
+  EXPECT_EQ(spill.ReadAllRows(), written);
+
+  std::vector<Row> streamed;
+  spill.ForEachRow([&](const Row& row) { streamed.push_back(row); });
+  EXPECT_EQ(streamed, written);
+}
+
+TEST(SpillFileTest, LargeSpillCompressesIntoAlignedBlocks) {
+  SpillFile spill;
+  constexpr int kRows = 200000;
+  for (int i = 0; i < kRows; ++i) {
+    spill.Append(
+        Row({Value(i), Value(i % 10), Value("k" + std::to_string(i % 4))}),
+        RowPosition(100 + i / 50, i % 50));
+  }
+  spill.FinishWriting();
+  EXPECT_EQ(spill.DiskBytes() % kSpillBlockAlignment, 0U);
+  EXPECT_GT(spill.DiskBytes(), kSpillBlockBytes);
+  // A row-at-a-time encoding needs well over 30 bytes per row here.
+  EXPECT_LT(spill.DiskBytes(), uint64_t{kRows} * 12);
+  EXPECT_EQ(std::filesystem::file_size(spill.Path()), spill.DiskBytes());
+
+  spill.StartReading();
+  Row row;
+  RowPosition position;
+  for (int i = 0; i < kRows; ++i) {
+    ASSERT_TRUE(spill.ReadNext(&row, &position));
+    ASSERT_EQ(row, Row({Value(i), Value(i % 10),
+                        Value("k" + std::to_string(i % 4))}));
+    ASSERT_EQ(position, RowPosition(100 + i / 50, i % 50));
+  }
+  EXPECT_FALSE(spill.ReadNext(&row, &position));
+}
+
+TEST(SpillFileTest, SynchronousIoMatchesBackgroundIo) {
+  const auto spill_rows = [](int threads) {
+    SetSpillIoThreadsForTest(threads);
+    SpillFile spill;
+    for (int i = 0; i < 50000; ++i) {
+      spill.Append(Row({Value(i * 3), Value(std::string(i % 50, 'x'))}));
+    }
+    std::vector<Row> rows = spill.ReadAllRows();
+    SetSpillIoThreadsForTest(-1);
+    return rows;
+  };
+  const std::vector<Row> sync = spill_rows(0);
+  EXPECT_EQ(SpillIoThreads(), 2U);
+  ASSERT_EQ(sync.size(), 50000U);
+  EXPECT_EQ(sync[49999], Row({Value(149997), Value(std::string(49, 'x'))}));
+  EXPECT_EQ(spill_rows(3), sync);
+}
+
 }  // namespace tinylamb
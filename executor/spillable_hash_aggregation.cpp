@@ -0,0 +1,165 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/spillable_hash_aggregation.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+namespace tinylamb {
+namespace {
+
+constexpr int kPartitionBits = std::countr_zero(kAggregateSpillPartitions);
+
+// Partition of `key` at spill `level`: each level takes the next
+// kPartitionBits of the hash from the top, so keys that shared a partition
+// at one level are split at the next.
+size_t PartitionAt(std::string_view key, size_t level) {
+  const auto shift = static_cast<int>(64 - kPartitionBits * (level + 1));
+  return (FlatHash(key) >> shift) & (kAggregateSpillPartitions - 1);
+}
+
+}  // namespace
+
+SpillableHashAggregation::SpillableHashAggregation(
+    std::vector<AggregateSpec> specs, KeyFn key_of, UpdateFn update)
+    : specs_(std::move(specs)),
+      key_of_(std::move(key_of)),
+      update_(std::move(update)),
+      has_distinct_(std::any_of(
+          specs_.begin(), specs_.end(),
+          [](const AggregateSpec& spec) { return spec.distinct; })) {}
+
+void SpillableHashAggregation::Add(const Row& row) {
+  key_of_(row, &key_);
+  const uint32_t group = FindOrAdd(&resident_, row, 0, &partitions_);
+  AggregateState* states = &resident_.states[group * specs_.size()];
+  const size_t before = DistinctBytes(states);
+  update_(row, states);
+  ChargeDistinct(&resident_, DistinctBytes(states) - before, 0, &partitions_);
+}
+
+void SpillableHashAggregation::Finish(const GroupFn& fn) {
+  if (partitions_.empty()) {
+    Emit(&resident_, fn);
+    return;
+  }
+  Spill(&resident_, 0, &partitions_);
+  MergePartitions(std::move(partitions_), 1, fn);
+  partitions_.clear();
+}
+
+uint32_t SpillableHashAggregation::FindOrAdd(Table* table, const Row& row,
+                                             size_t level,
+                                             std::vector<SpillFile>* spill) {
+  if (const uint32_t* found = table->index.Find(key_); found != nullptr) {
+    return *found;
+  }
+  const size_t bytes = EstimateRowBytes(row) + key_.size() +
+                       specs_.size() * sizeof(AggregateState);
+  if (level < kMaxAggregateSpillDepth &&
+      table->representatives.size() >= kMinSpilledGroups &&
+      !table->charge.Context().CanReserve(bytes)) {
+    Spill(table, level, spill);
+  }
+  if (table->representatives.empty()) {
+    representative_width_ = row.values_.size();
+  }
+  const auto group = static_cast<uint32_t>(table->representatives.size());
+  *table->index.TryEmplace(key_).first = group;
+  table->representatives.push_back(row);
+  for (const AggregateSpec& spec : specs_) {
+    table->states.emplace_back(spec.type, spec.distinct);
+  }
+  table->charge.Add(bytes);
+  return group;
+}
+
+void SpillableHashAggregation::ChargeDistinct(Table* table, size_t bytes,
+                                              size_t level,
+                                              std::vector<SpillFile>* spill) {
+  if (bytes == 0) return;
+  const bool spills = level < kMaxAggregateSpillDepth &&
+                      table->representatives.size() >= kMinSpilledGroups &&
+                      !table->charge.Context().CanReserve(bytes);
+  table->charge.Add(bytes);
+  if (spills) Spill(table, level, spill);
+}
+
+size_t SpillableHashAggregation::DistinctBytes(
+    const AggregateState* states) const {
+  if (!has_distinct_) return 0;
+  size_t bytes = 0;
+  for (size_t i = 0; i < specs_.size(); ++i) {
+    bytes += states[i].DistinctBytes();
+  }
+  return bytes;
+}
+
+void SpillableHashAggregation::Spill(Table* table, size_t level,
+                                     std::vector<SpillFile>* spill) {
+  if (spill->empty()) {
+    *spill = std::vector<SpillFile>(kAggregateSpillPartitions);
+  }
+  peak_groups_ = std::max(peak_groups_, table->representatives.size());
+  const size_t width = specs_.size();
+  std::vector<Value> values;
+  uint32_t group = 0;
+  for (const auto& entry : table->index) {
+    values = table->representatives[group].values_;
+    for (size_t i = 0; i < width; ++i) {
+      table->states[group * width + i].AppendSpilled(&values);
+    }
+    (*spill)[PartitionAt(entry.key, level)].Append(Row(std::move(values)));
+    ++group;
+  }
+  spilled_groups_ += group;
+  *table = Table();
+}
+
+void SpillableHashAggregation::MergePartitions(
+    std::vector<SpillFile> partitions, size_t level, const GroupFn& fn) {
+  const size_t width = specs_.size();
+  for (SpillFile& partition : partitions) {
+    partition.FinishWriting();
+    if (partition.Empty()) continue;
+    ++spill_partitions_;
+    spill_depth_ = std::max(spill_depth_, level);
+    Table table;
+    std::vector<SpillFile> deeper;
+    partition.ForEachRow([&](const Row& partial) {
+      const Row representative(std::vector<Value>(
+          partial.values_.begin(),
+          partial.values_.begin() +
+              static_cast<std::ptrdiff_t>(representative_width_)));
+      key_of_(representative, &key_);
+      const uint32_t group =
+          FindOrAdd(&table, representative, level, &deeper);
+      AggregateState* states = &table.states[group * width];
+      const size_t before = DistinctBytes(states);
+      size_t offset = representative_width_;
+      for (size_t i = 0; i < width; ++i) {
+        states[i].MergeSpilled(partial.values_, &offset);
+      }
+      ChargeDistinct(&table, DistinctBytes(states) - before, level, &deeper);
+    });
+    partition = SpillFile();
+    if (deeper.empty()) {
+      Emit(&table, fn);
+      continue;
+    }
+    Spill(&table, level, &deeper);
+    MergePartitions(std::move(deeper), level + 1, fn);
+  }
+}
+
+void SpillableHashAggregation::Emit(Table* table, const GroupFn& fn) {
+  peak_groups_ = std::max(peak_groups_, table->representatives.size());
+  groups_ += table->representatives.size();
+  for (size_t group = 0; group < table->representatives.size(); ++group) {
+    fn(table->representatives[group], &table->states[group * specs_.size()]);
+  }
+  *table = Table();
+}
+
+}  // namespace tinylamb
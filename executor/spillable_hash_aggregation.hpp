@@ -0,0 +1,120 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_SPILLABLE_HASH_AGGREGATION_HPP
+#define TINYLAMB_EXECUTOR_SPILLABLE_HASH_AGGREGATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "executor/aggregate_state.hpp"
+#include "executor/flat_hash_table.hpp"
+#include "executor/query_memory.hpp"
+#include "executor/spill_file.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Files a spill of partial groups is split into, by key hash.
+inline constexpr size_t kAggregateSpillPartitions = 32;
+// Spill levels below the first. A partition at this depth is merged in
+// memory whatever the budget says: by then its groups share so many hash
+// bits that splitting again would not shrink it.
+inline constexpr size_t kMaxAggregateSpillDepth = 4;
+// Fewest groups a table holds before it may spill, so a budget exhausted by
+// other operators does not turn every new group into a spill.
+inline constexpr size_t kMinSpilledGroups = 64;
+
+// Serial hash aggregation within the query memory budget.
+//
+// Groups live in a hash table charged to the QueryMemoryBudget. When a new
+// group does not fit, every resident group is written out as a partial
+// group, i.e. its representative row followed by its AggregateStates, to
+// the partition file its key hash picks, and the table starts over. Values
+// added to a DISTINCT aggregate of an existing group are charged and may
+// spill the table the same way. The
+// same key may then be spilled several times; Finish() merges each
+// partition on its own. A partition that still does not fit spills its
+// partial groups again by the next bits of the key hash.
+class SpillableHashAggregation {
+ public:
+  // key_of(row, &key) replaces `key` with the group key of `row`. It must
+  // give the same key for a group's representative row.
+  using KeyFn = std::function<void(const Row&, std::string*)>;
+  // update(row, states) adds `row` to its group's states, one per spec.
+  using UpdateFn = std::function<void(const Row&, AggregateState*)>;
+  using GroupFn =
+      std::function<void(const Row& representative, const AggregateState*)>;
+
+  SpillableHashAggregation(std::vector<AggregateSpec> specs, KeyFn key_of,
+                           UpdateFn update);
+
+  void Add(const Row& row);
+
+  // Calls fn(representative, states) once for every group. Groups that
+  // never spilled come in input order.
+  void Finish(const GroupFn& fn);
+
+  // Groups Finish() emitted.
+  [[nodiscard]] size_t Groups() const { return groups_; }
+  // Most groups held in memory at once.
+  [[nodiscard]] size_t PeakGroups() const { return peak_groups_; }
+  // Partial groups written to spill files, at every level.
+  [[nodiscard]] size_t SpilledGroups() const { return spilled_groups_; }
+  // Non-empty spill partitions merged by Finish().
+  [[nodiscard]] size_t SpillPartitions() const { return spill_partitions_; }
+  // Deepest spill level merged: 0 without spilling, 1 when every partition
+  // fit in memory, more when partitions were split again.
+  [[nodiscard]] size_t SpillDepth() const { return spill_depth_; }
+
+ private:
+  // Groups by key. Group g is the g-th entry of `index` and owns states
+  // [g * width, (g + 1) * width).
+  struct Table {
+    FlatHashMap<std::string_view, uint32_t> index;
+    std::vector<Row> representatives;
+    std::vector<AggregateState> states;
+    QueryMemoryCharge charge;
+  };
+
+  // Returns the group of `key` in `table`, creating it for `row`. At
+  // `level` < kMaxAggregateSpillDepth a new group that does not fit first
+  // spills the whole table to `spill` by the level's hash bits.
+  uint32_t FindOrAdd(Table* table, const Row& row, size_t level,
+                     std::vector<SpillFile>* spill);
+  // Charges the `bytes` a group's DISTINCT value sets in `table` just grew
+  // by. Past the budget it spills the table as FindOrAdd would for a new
+  // group.
+  void ChargeDistinct(Table* table, size_t bytes, size_t level,
+                      std::vector<SpillFile>* spill);
+  [[nodiscard]] size_t DistinctBytes(const AggregateState* states) const;
+  void Spill(Table* table, size_t level, std::vector<SpillFile>* spill);
+  // Merges the partial groups of each of `partitions`, written at
+  // `level` - 1, and emits them.
+  void MergePartitions(std::vector<SpillFile> partitions, size_t level,
+                       const GroupFn& fn);
+  void Emit(Table* table, const GroupFn& fn);
+
+  std::vector<AggregateSpec> specs_;
+  KeyFn key_of_;
+  UpdateFn update_;
+  // Whether some spec keeps DISTINCT values, which grow inside a group.
+  bool has_distinct_{false};
+  Table resident_;
+  std::vector<SpillFile> partitions_;
+  // Values of a representative row, so spilled partial groups can be
+  // split into representative and states.
+  size_t representative_width_{0};
+  std::string key_;
+  size_t groups_{0};
+  size_t peak_groups_{0};
+  size_t spilled_groups_{0};
+  size_t spill_partitions_{0};
+  size_t spill_depth_{0};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_SPILLABLE_HASH_AGGREGATION_HPP
@@ -0,0 +1,163 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/spillable_hash_aggregation.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "executor/executor_test_util.hpp"
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+const std::vector<AggregateSpec> kSpecs = {{AggregationType::kCount, false},
+                                           {AggregationType::kSum, false},
+                                           {AggregationType::kAvg, false},
+                                           {AggregationType::kMin, false},
+                                           {AggregationType::kCount, true}};
+
+void Update(const Row& row, AggregateState* states) {
+  states[0].Add(Value(1));
+  for (size_t i = 1; i < kSpecs.size(); ++i) states[i].Add(row[1]);
+}
+
+// Groups rows (key, value) by key computing COUNT(*), SUM(value),
+// AVG(value), MIN(value) and COUNT(DISTINCT value).
+std::map<int64_t, std::vector<Value>> Aggregate(
+    const std::vector<Row>& rows, SpillableHashAggregation* aggregation) {
+  for (const Row& row : rows) aggregation->Add(row);
+  std::map<int64_t, std::vector<Value>> groups;
+  aggregation->Finish(
+      [&](const Row& representative, const AggregateState* states) {
+        std::vector<Value>& values =
+            groups[representative[0].value.int_value];
+        EXPECT_TRUE(values.empty());
+        for (size_t i = 0; i < kSpecs.size(); ++i) {
+          values.push_back(states[i].Finish());
+        }
+      });
+  EXPECT_EQ(aggregation->Groups(), groups.size());
+  return groups;
+}
+
+std::map<int64_t, std::vector<Value>> Expected(const std::vector<Row>& rows) {
+  std::map<int64_t, std::vector<AggregateState>> states;
+  for (const Row& row : rows) {
+    auto [it, inserted] = states.try_emplace(row[0].value.int_value);
+    if (inserted) {
+      for (const AggregateSpec& spec : kSpecs) {
+        it->second.emplace_back(spec.type, spec.distinct);
+      }
+    }
+    Update(row, it->second.data());
+  }
+  std::map<int64_t, std::vector<Value>> expected;
+  for (const auto& [key, group] : states) {
+    for (const AggregateState& state : group) {
+      expected[key].push_back(state.Finish());
+    }
+  }
+  return expected;
+}
+
+// `count` rows over `keys` keys; every key comes back once per `keys` rows,
+// so its partial group is spilled again and again under a small budget.
+std::vector<Row> Rows(size_t count, int64_t keys) {
+  std::vector<Row> rows;
+  rows.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    const auto n = static_cast<int64_t>(i);
+    rows.push_back(Row({Value(n % keys), Value(n * 7919 % 11)}));
+  }
+  return rows;
+}
+
+SpillableHashAggregation MakeAggregation() {
+  return SpillableHashAggregation(
+      kSpecs,
+      [](const Row& row, std::string* key) {
+        key->clear();
+        AppendFlatKey(row[0], key);
+      },
+      Update);
+}
+
+}  // namespace
+
+TEST(SpillableHashAggregationTest, FitsInMemoryInInputOrder) {
+  ScopedQueryMemoryBudget budget(0);
+  const std::vector<Row> rows = Rows(1000, 100);
+  SpillableHashAggregation aggregation = MakeAggregation();
+  for (const Row& row : rows) aggregation.Add(row);
+  int64_t next = 0;
+  aggregation.Finish([&](const Row& representative, const AggregateState*) {
+    EXPECT_EQ(representative[0], Value(next++));
+  });
+  EXPECT_EQ(next, 100);
+  EXPECT_EQ(aggregation.SpilledGroups(), 0U);
+  EXPECT_EQ(aggregation.SpillDepth(), 0U);
+  EXPECT_EQ(aggregation.PeakGroups(), 100U);
+}
+
+TEST(SpillableHashAggregationTest, SpillsPartialGroupsUnderBudget) {
+  ScopedQueryMemoryBudget budget(1 << 20);
+  const std::vector<Row> rows = Rows(30000, 10000);
+  SpillableHashAggregation aggregation = MakeAggregation();
+  EXPECT_EQ(Aggregate(rows, &aggregation), Expected(rows));
+  EXPECT_GT(aggregation.SpilledGroups(), 10000U);
+  EXPECT_GT(aggregation.SpillPartitions(), 0U);
+  EXPECT_GE(aggregation.SpillDepth(), 1U);
+  EXPECT_LT(aggregation.PeakGroups(), 10000U);
+}
+
+TEST(SpillableHashAggregationTest, SplitsPartitionsThatStillDoNotFit) {
+  ScopedQueryMemoryBudget budget(16 << 10);
+  const std::vector<Row> rows = Rows(40000, 20000);
+  SpillableHashAggregation aggregation = MakeAggregation();
+  EXPECT_EQ(Aggregate(rows, &aggregation), Expected(rows));
+  EXPECT_GT(aggregation.SpillDepth(), 1U);
+  EXPECT_LE(aggregation.SpillDepth(), kMaxAggregateSpillDepth);
+}
+
+TEST(SpillableHashAggregationTest, SpilledTextKeysAndExtremes) {
+  ScopedQueryMemoryBudget budget(16 << 10);
+  SpillableHashAggregation aggregation(
+      {{AggregationType::kMax, false}, {AggregationType::kCount, true}},
+      [](const Row& row, std::string* key) {
+        key->clear();
+        AppendFlatKey(row[0], key);
+      },
+      [](const Row& row, AggregateState* states) {
+        states[0].Add(row[1]);
+        states[1].Add(row[1]);
+      });
+  for (int64_t i = 0; i < 5000; ++i) {
+    aggregation.Add(Row({Value("k" + std::to_string(i % 500)),
+                         Value("v" + std::to_string(i % 7))}));
+  }
+  size_t groups = 0;
+  aggregation.Finish([&](const Row&, const AggregateState* states) {
+    EXPECT_EQ(states[0].Finish(), Value("v6"));
+    EXPECT_EQ(states[1].Finish(), Value(int64_t{7}));
+    ++groups;
+  });
+  EXPECT_EQ(groups, 500U);
+  EXPECT_GT(aggregation.SpilledGroups(), 0U);
+}
+
+TEST(SpillableHashAggregationTest, GrowingDistinctSetsSpill) {
+  // Every group exists after the first 100 rows; the rest only add new
+  // values to their COUNT(DISTINCT) sets.
+  ScopedQueryMemoryBudget budget(256 << 10);
+  std::vector<Row> rows;
+  for (int64_t i = 0; i < 60000; ++i) {
+    rows.push_back(Row({Value(i % 100), Value(i)}));
+  }
+  SpillableHashAggregation aggregation = MakeAggregation();
+  EXPECT_EQ(Aggregate(rows, &aggregation), Expected(rows));
+  EXPECT_GT(aggregation.SpilledGroups(), 0U);
+}
+
+}  // namespace tinylamb
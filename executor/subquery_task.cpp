@@ -0,0 +1,68 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/subquery_task.hpp"
+
+#include <optional>
+#include <utility>
+
+#include "executor/feature_flag.hpp"
+#include "executor/query_memory.hpp"
+#include "executor/query_scheduler.hpp"
+
+namespace tinylamb {
+namespace {
+
+FeatureFlag& Flag() {
+  static FeatureFlag flag("TINYLAMB_CONCURRENT_SUBQUERIES");
+  return flag;
+}
+
+}  // namespace
+
+bool ConcurrentSubqueriesEnabled() { return Flag().Enabled(); }
+
+void SetConcurrentSubqueriesForTest(int enabled) { Flag().SetForTest(enabled); }
+
+std::unique_ptr<SubqueryTask> SubqueryTask::TryStart(
+    std::function<void()> fn) {
+  if (!ConcurrentSubqueriesEnabled()) return nullptr;
+  QueryTaskSlots* slots = QueryTaskSlots::Current();
+  std::optional<QueryScheduler::Lease> lease;
+  if (slots != nullptr) {
+    if (!slots->TryTake()) return nullptr;
+  } else {
+    // Outside a lease the query thread holds no slot of its own, so leave
+    // it one core.
+    QueryScheduler& global = QueryScheduler::Global();
+    if (global.CpuCapacity() < 2) return nullptr;
+    lease = global.TryAcquire(1, 0);
+    if (!lease) return nullptr;
+  }
+  std::unique_ptr<SubqueryTask> task(new SubqueryTask());
+  task->thread_ = std::thread(
+      [task = task.get(), fn = std::move(fn), slots, lease = std::move(lease),
+       memory = MemoryContext::Current().shared_from_this()]() mutable {
+        {
+          const ScopedQueryTaskSlots scoped_slots(slots);
+          const ScopedMemoryContext scoped_memory(std::move(memory));
+          try {
+            fn();
+          } catch (...) {
+            task->error_ = std::current_exception();
+          }
+        }
+        if (slots != nullptr) slots->Give();
+        if (lease) lease->Release();
+      });
+  return task;
+}
+
+SubqueryTask::~SubqueryTask() {
+  if (thread_.joinable()) thread_.join();
+}
+
+void SubqueryTask::Wait() {
+  if (thread_.joinable()) thread_.join();
+  if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,52 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_SUBQUERY_TASK_HPP
+#define TINYLAMB_EXECUTOR_SUBQUERY_TASK_HPP
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace tinylamb {
+
+// Whether the relational executor runs independent WITH queries, derived
+// tables and uncorrelated subqueries as concurrent tasks.
+//
+// Config: TINYLAMB_CONCURRENT_SUBQUERIES
+//   - unset: enabled
+//   - "0": evaluate them one after another on the query thread
+[[nodiscard]] bool ConcurrentSubqueriesEnabled();
+
+// Test helper: 1 enables, 0 disables, -1 restores the environment default.
+void SetConcurrentSubqueriesForTest(int enabled);
+
+// A query subtree running on a thread of its own. The thread holds one CPU
+// slot for as long as it runs: borrowed from the QueryTaskSlots of the
+// query's lease when there is one, otherwise a spare slot of
+// QueryScheduler::Global(). It charges the starting thread's MemoryContext
+// and lends subtasks from the same slots.
+class SubqueryTask {
+ public:
+  // Starts `fn`, or returns nullptr when concurrency is disabled or no slot
+  // is free; the caller then runs the subtree itself.
+  [[nodiscard]] static std::unique_ptr<SubqueryTask> TryStart(
+      std::function<void()> fn);
+
+  SubqueryTask(const SubqueryTask&) = delete;
+  SubqueryTask& operator=(const SubqueryTask&) = delete;
+  // Waits for the task; an exception it threw is dropped.
+  ~SubqueryTask();
+
+  // Waits for the task and rethrows what it threw.
+  void Wait();
+
+ private:
+  SubqueryTask() = default;
+
+  std::thread thread_;
+  std::exception_ptr error_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_SUBQUERY_TASK_HPP
@@ -0,0 +1,71 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/subquery_task.hpp"
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+#include "executor/query_scheduler.hpp"
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+TEST(SubqueryTaskTest, RunsBesideTheQueryThreadOnSpareSlots) {
+  QueryTaskSlots slots(2);
+  const ScopedQueryTaskSlots scope(&slots);
+  std::promise<void> started;
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  QueryTaskSlots* seen = nullptr;
+  std::unique_ptr<SubqueryTask> task = SubqueryTask::TryStart([&] {
+    seen = QueryTaskSlots::Current();
+    started.set_value();
+    released.wait();
+  });
+  ASSERT_NE(task, nullptr);
+  // Both threads are live at once: the task waits on this one.
+  started.get_future().wait();
+  EXPECT_EQ(slots.Spare(), 0U);
+  EXPECT_EQ(SubqueryTask::TryStart([] {}), nullptr);
+  release.set_value();
+  task->Wait();
+  EXPECT_EQ(seen, &slots);
+  EXPECT_EQ(slots.Spare(), 1U);
+}
+
+TEST(SubqueryTaskTest, NoSpareSlotRunsNothing) {
+  QueryTaskSlots slots(1);
+  const ScopedQueryTaskSlots scope(&slots);
+  bool ran = false;
+  EXPECT_EQ(SubqueryTask::TryStart([&] { ran = true; }), nullptr);
+  EXPECT_FALSE(ran);
+}
+
+TEST(SubqueryTaskTest, WaitRethrowsTheTaskError) {
+  QueryTaskSlots slots(2);
+  const ScopedQueryTaskSlots scope(&slots);
+  std::unique_ptr<SubqueryTask> task = SubqueryTask::TryStart(
+      [] { throw std::runtime_error("subquery failed"); });
+  ASSERT_NE(task, nullptr);
+  EXPECT_THROW(task->Wait(), std::runtime_error);
+  EXPECT_EQ(slots.Spare(), 1U);
+  // Rethrown once; the task is done.
+  EXPECT_NO_THROW(task->Wait());
+}
+
+TEST(SubqueryTaskTest, DisabledRunsNothing) {
+  QueryTaskSlots slots(4);
+  const ScopedQueryTaskSlots scope(&slots);
+  SetConcurrentSubqueriesForTest(0);
+  EXPECT_FALSE(ConcurrentSubqueriesEnabled());
+  EXPECT_EQ(SubqueryTask::TryStart([] {}), nullptr);
+  EXPECT_EQ(slots.Spare(), 3U);
+  SetConcurrentSubqueriesForTest(1);
+  EXPECT_TRUE(ConcurrentSubqueriesEnabled());
+  SetConcurrentSubqueriesForTest(-1);
+}
+
+}  // namespace
+}  // namespace tinylamb
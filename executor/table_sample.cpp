@@ -0,0 +1,259 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/table_sample.hpp"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/constants.hpp"
+#include "common/hash.hpp"
+#include "expression/aggregate_expression.hpp"
+#include "expression/expression.hpp"
+#include "expression/named_expression.hpp"
+#include "expression/query_expression.hpp"
+#include "expression/rewrite.hpp"
+#include "parser/ast.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+bool Scalable(const AggregateExpression& aggregate) {
+  return !aggregate.Distinct() &&
+         (aggregate.GetType() == AggregationType::kCount ||
+          aggregate.GetType() == AggregationType::kSum);
+}
+
+Expression Multiply(Expression left, Expression right) {
+  return BinaryExpressionExp(std::move(left), BinaryOperation::kMultiply,
+                             std::move(right));
+}
+
+Expression Constant(double value) { return ConstantValueExp(Value(value)); }
+
+Expression Sqrt(Expression argument) {
+  return FunctionCallExp("sqrt", {std::move(argument)});
+}
+
+// `expression` with every scalable aggregate multiplied by `factor`.
+Expression Scale(const Expression& expression, double factor) {
+  if (!expression || expression->Type() == TypeTag::kQueryExp) {
+    return expression;
+  }
+  if (expression->Type() == TypeTag::kAggregateExp) {
+    return Scalable(expression->AsAggregateExpression())
+               ? Multiply(expression, Constant(factor))
+               : expression;
+  }
+  std::vector<Expression> children = ExpressionChildren(expression);
+  bool changed = false;
+  for (Expression& child : children) {
+    Expression scaled = Scale(child, factor);
+    changed = changed || scaled != child;
+    child = std::move(scaled);
+  }
+  return changed ? WithExpressionChildren(expression, std::move(children))
+                 : expression;
+}
+
+// Standard error of the estimate `aggregate` yields over a sample taking
+// fraction `q` of the rows, or null when none is defined.
+Expression StandardError(const Expression& aggregate, double q) {
+  const AggregateExpression& call = aggregate->AsAggregateExpression();
+  if (call.Distinct()) return nullptr;
+  const Expression& x = call.Child();
+  const auto sum_of_squares = [&] {
+    return AggregateExpressionExp(AggregationType::kSum,
+                                  Multiply(Multiply(Constant(1.0), x), x));
+  };
+  switch (call.GetType()) {
+    case AggregationType::kCount:
+      return Multiply(Sqrt(Multiply(aggregate, Constant(1.0 - q))),
+                      Constant(1.0 / q));
+    case AggregationType::kSum:
+      return Multiply(Sqrt(Multiply(sum_of_squares(), Constant(1.0 - q))),
+                      Constant(1.0 / q));
+    case AggregationType::kAvg: {
+      const Expression count =
+          AggregateExpressionExp(AggregationType::kCount, x);
+      const Expression variance = BinaryExpressionExp(
+          BinaryExpressionExp(sum_of_squares(), BinaryOperation::kDivide,
+                              count),
+          BinaryOperation::kSubtract, Multiply(aggregate, aggregate));
+      // Rounding can leave the variance of equal values slightly negative.
+      return CaseExpressionExp(
+          {{BinaryExpressionExp(variance, BinaryOperation::kLessThan,
+                                Constant(0.0)),
+            Constant(0.0)}},
+          Sqrt(BinaryExpressionExp(Multiply(variance, Constant(1.0 - q)),
+                                   BinaryOperation::kDivide, count)));
+    }
+    default:
+      return nullptr;
+  }
+}
+
+// Sampling fraction behind the rows of each visible CTE.
+using CteFractions = std::unordered_map<std::string, double>;
+
+struct Estimated {
+  std::shared_ptr<SelectStatement> statement;
+  // Fraction of the full input the statement's rows stand for: 1 once
+  // they are aggregates or distinct values, which scaling already covers.
+  double fraction{1.0};
+};
+
+Estimated Estimate(const std::shared_ptr<SelectStatement>& select,
+                   bool top_level, const CteFractions& inherited);
+
+// `expression` with the statements of its subqueries estimated.
+Expression EstimateSubqueries(const Expression& expression,
+                              const CteFractions& ctes) {
+  if (!expression) return expression;
+  std::vector<Expression> children = ExpressionChildren(expression);
+  bool changed = false;
+  for (Expression& child : children) {
+    Expression estimated = EstimateSubqueries(child, ctes);
+    changed = changed || estimated != child;
+    child = std::move(estimated);
+  }
+  if (expression->Type() == TypeTag::kQueryExp) {
+    const QueryExpression& subquery = expression->AsQueryExpression();
+    std::shared_ptr<SelectStatement> query =
+        Estimate(subquery.Query(), false, ctes).statement;
+    if (query == subquery.Query() && !changed) return expression;
+    return QueryExpressionExp(std::move(query),
+                              children.empty() ? nullptr : children.front(),
+                              subquery.Exists(), subquery.Negated());
+  }
+  return changed ? WithExpressionChildren(expression, std::move(children))
+                 : expression;
+}
+
+Estimated Estimate(const std::shared_ptr<SelectStatement>& select,
+                   bool top_level, const CteFractions& inherited) {
+  bool changed = false;
+  CteFractions ctes = inherited;
+  std::vector<std::pair<std::string, std::shared_ptr<SelectStatement>>> with;
+  // CTEs may read one another; repeat until their fractions settle, which
+  // takes at most one pass per CTE.
+  for (size_t pass = 0; pass <= select->WithQueries().size(); ++pass) {
+    with.clear();
+    changed = false;
+    bool settled = true;
+    for (const auto& [name, query] : select->WithQueries()) {
+      Estimated estimated = Estimate(query, false, ctes);
+      const auto [cte, inserted] = ctes.try_emplace(name, estimated.fraction);
+      if (inserted || cte->second != estimated.fraction) {
+        cte->second = estimated.fraction;
+        settled = false;
+      }
+      changed = changed || estimated.statement != query;
+      with.emplace_back(name, std::move(estimated.statement));
+    }
+    if (settled) break;
+  }
+
+  std::vector<SelectSource> sources = select->Sources();
+  double fraction = 1.0;
+  for (SelectSource& source : sources) {
+    if (source.query) {
+      Estimated query = Estimate(source.query, false, ctes);
+      changed = changed || query.statement != source.query;
+      source.query = std::move(query.statement);
+      fraction *= query.fraction;
+    } else if (source.sample) {
+      fraction *= source.sample->fraction;
+    } else if (const auto cte = ctes.find(source.table); cte != ctes.end()) {
+      fraction *= cte->second;
+    }
+  }
+
+  const Expression where = EstimateSubqueries(select->WhereClause(), ctes);
+  const Expression having = EstimateSubqueries(select->Having(), ctes);
+  changed = changed || where != select->WhereClause() ||
+            having != select->Having();
+  std::vector<NamedExpression> list = select->SelectList();
+  for (NamedExpression& item : list) {
+    Expression expression = EstimateSubqueries(item.expression, ctes);
+    if (expression == item.expression) continue;
+    if (item.name.empty()) item.name = item.expression->ToString();
+    item.expression = std::move(expression);
+    changed = true;
+  }
+
+  bool aggregates = !select->GroupBy().empty() || ContainsAggregate(having);
+  for (const NamedExpression& item : list) {
+    aggregates = aggregates || ContainsAggregate(item.expression);
+  }
+  const bool scaled = aggregates && fraction < 1.0;
+  const double output =
+      aggregates || select->Distinct() ? 1.0 : fraction;
+  if (!scaled && !changed) return {select, output};
+
+  std::vector<NamedExpression> items;
+  std::vector<NamedExpression> errors;
+  for (const NamedExpression& item : list) {
+    if (!scaled) {
+      items.push_back(item);
+      continue;
+    }
+    // Keep the name the unscaled expression would have been shown under.
+    const std::string name =
+        item.name.empty() ? item.expression->ToString() : item.name;
+    Expression estimate = Scale(item.expression, 1.0 / fraction);
+    if (estimate != item.expression) {
+      items.emplace_back(name, std::move(estimate));
+    } else {
+      items.push_back(item);
+    }
+    if (top_level && item.expression->Type() == TypeTag::kAggregateExp) {
+      if (Expression error = StandardError(item.expression, fraction)) {
+        errors.emplace_back(name + kSampleErrorSuffix, std::move(error));
+      }
+    }
+  }
+  for (NamedExpression& error : errors) items.push_back(std::move(error));
+
+  auto result = std::make_shared<SelectStatement>(
+      std::move(items), select->FromClause(), where, select->OrderBy(),
+      select->Limit(), select->Offset(), select->Distinct());
+  for (const auto& [alias, table] : select->Aliases()) {
+    result->AddAlias(alias, table);
+  }
+  result->SetSources(std::move(sources));
+  if (!select->GroupBy().empty()) result->SetGroupBy(select->GroupBy());
+  if (having) {
+    result->SetHaving(scaled ? Scale(having, 1.0 / fraction) : having);
+  }
+  for (auto& [name, query] : with) {
+    result->AddWithQuery(name, std::move(query));
+  }
+  if (select->RequiresRelationalEvaluation()) result->MarkComplex();
+  return {result, output};
+}
+
+}  // namespace
+
+uint64_t TableSampleSeed(const TableSample& sample) {
+  if (sample.seed) return *sample.seed;
+  static thread_local std::mt19937_64 random{std::random_device{}()};
+  return random();
+}
+
+bool SampleKeepsRow(double fraction, uint64_t seed,
+                    const RowPosition& position) {
+  if (fraction >= 1.0) return true;
+  const uint64_t key =
+      Fmix64((position.page_id << 16) ^ position.slot ^ Fmix64(seed + 1));
+  return static_cast<double>(key >> 11) * 0x1.0p-53 < fraction;
+}
+
+std::shared_ptr<SelectStatement> EstimateFromSample(
+    std::shared_ptr<SelectStatement> select) {
+  return Estimate(select, true, {}).statement;
+}
+
+}  // namespace tinylamb
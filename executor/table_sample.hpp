@@ -0,0 +1,51 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_TABLE_SAMPLE_HPP
+#define TINYLAMB_EXECUTOR_TABLE_SAMPLE_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "page/row_position.hpp"
+
+namespace tinylamb {
+
+class SelectStatement;
+struct TableSample;
+
+// Suffix of the standard error column added after each estimated aggregate.
+inline constexpr const char* kSampleErrorSuffix = "_stderr";
+
+// Seed for one scan of `sample`: its REPEATABLE seed, else a random one.
+[[nodiscard]] uint64_t TableSampleSeed(const TableSample& sample);
+
+// Whether TABLESAMPLE BERNOULLI keeps the row at `position`: the position
+// and `seed` hashed to a point in [0, 1) below `fraction`. The same seed
+// always keeps the same rows of an unchanged table.
+[[nodiscard]] bool SampleKeepsRow(double fraction, uint64_t seed,
+                                  const RowPosition& position);
+
+// Turns the aggregates of every statement reading sampled tables into
+// estimates for the whole tables. With q the product of the sampling
+// fractions of a statement's sources, its non-DISTINCT COUNT and SUM in
+// the select list and HAVING are scaled by 1/q; AVG, MIN and MAX are left
+// as computed from the sample. A derived table or CTE passes the fraction
+// of its own sources on unless it aggregates or is DISTINCT. Subqueries in
+// expressions are estimated on their own.
+//
+// The top-level statement also gets one column named
+// `<item>` + kSampleErrorSuffix after the select list for each item that is
+// a COUNT, SUM or AVG, holding the estimate's standard error:
+//
+//   - COUNT: sqrt(n (1 - q)) / q
+//   - SUM:   sqrt((1 - q) SUM(x^2)) / q
+//   - AVG:   sqrt((1 - q) var(x) / n)
+//
+// These assume rows are sampled independently, which holds for BERNOULLI.
+// For SYSTEM they understate the error when the values on a page are
+// correlated. Returns `select` itself when nothing is sampled.
+[[nodiscard]] std::shared_ptr<SelectStatement> EstimateFromSample(
+    std::shared_ptr<SelectStatement> select);
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_TABLE_SAMPLE_HPP
@@ -0,0 +1,270 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/table_sample.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/random_string.hpp"
+#include "database/database.hpp"
+#include "database/transaction_context.hpp"
+#include "executor/relational.hpp"
+#include "expression/binary_expression.hpp"
+#include "expression/expression.hpp"
+#include "expression/named_expression.hpp"
+#include "expression/query_expression.hpp"
+#include "parser/ast.hpp"
+#include "table/table.hpp"
+#include "type/column.hpp"
+#include "type/row.hpp"
+#include "type/schema.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+constexpr int64_t kRows = 20000;
+
+// SELECT COUNT(*), SUM(a), AVG(a), MIN(a) FROM t TABLESAMPLE ... .
+std::shared_ptr<SelectStatement> SampledAggregates(TableSample sample) {
+  auto select = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{
+          NamedExpression("n", AggregateExpressionExp(AggregationType::kCount,
+                                                      ColumnValueExp("*"))),
+          NamedExpression("total", AggregateExpressionExp(
+                                       AggregationType::kSum,
+                                       ColumnValueExp("a"))),
+          NamedExpression("mean", AggregateExpressionExp(
+                                      AggregationType::kAvg,
+                                      ColumnValueExp("a"))),
+          NamedExpression("low", AggregateExpressionExp(AggregationType::kMin,
+                                                        ColumnValueExp("a")))},
+      std::vector<std::string>{"t"}, nullptr);
+  select->SetSources({SelectSource{"t", "t", nullptr, JoinType::kCross,
+                                   nullptr, sample}});
+  select->MarkComplex();
+  return select;
+}
+
+// SELECT a FROM t TABLESAMPLE ... .
+std::shared_ptr<SelectStatement> SampledRows(TableSample sample) {
+  auto select = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("a")},
+      std::vector<std::string>{"t"}, nullptr);
+  select->SetSources({SelectSource{"t", "t", nullptr, JoinType::kCross,
+                                   nullptr, sample}});
+  return select;
+}
+
+// SELECT COUNT(*) AS n FROM `source`, reading `derived` when given.
+std::shared_ptr<SelectStatement> CountOf(
+    const std::string& source,
+    std::shared_ptr<SelectStatement> derived = nullptr) {
+  auto select = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression(
+          "n", AggregateExpressionExp(AggregationType::kCount,
+                                      ColumnValueExp("*")))},
+      std::vector<std::string>{}, nullptr);
+  select->SetSources({SelectSource{derived ? "" : source, source,
+                                   std::move(derived), JoinType::kCross,
+                                   nullptr, std::nullopt}});
+  select->MarkComplex();
+  return select;
+}
+
+TEST(TableSampleTest, ScalesAggregatesAndAddsErrorColumns) {
+  const auto select = SampledAggregates(
+      {TableSample::Method::kBernoulli, 0.25, std::nullopt});
+  const auto estimated = EstimateFromSample(select);
+  ASSERT_NE(estimated, select);
+  const std::vector<NamedExpression>& items = estimated->SelectList();
+  ASSERT_EQ(items.size(), 7U);
+  EXPECT_EQ(items[0].expression->Type(), TypeTag::kBinaryExp);
+  EXPECT_EQ(items[1].expression->Type(), TypeTag::kBinaryExp);
+  // AVG and MIN need no scaling.
+  EXPECT_EQ(items[2].expression, select->SelectList()[2].expression);
+  EXPECT_EQ(items[3].expression, select->SelectList()[3].expression);
+  EXPECT_EQ(items[4].name, "n_stderr");
+  EXPECT_EQ(items[5].name, "total_stderr");
+  EXPECT_EQ(items[6].name, "mean_stderr");
+  EXPECT_EQ(estimated->Sources().size(), 1U);
+  EXPECT_TRUE(estimated->Sources()[0].sample);
+
+  // Nothing sampled, or nothing aggregated: the statement is kept.
+  auto plain = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression(
+          "n", AggregateExpressionExp(AggregationType::kCount,
+                                      ColumnValueExp("*")))},
+      std::vector<std::string>{"t"}, nullptr);
+  EXPECT_EQ(EstimateFromSample(plain), plain);
+  auto rows = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("a")},
+      std::vector<std::string>{"t"}, nullptr);
+  rows->SetSources({SelectSource{"t", "t", nullptr, JoinType::kCross, nullptr,
+                                 TableSample{}}});
+  EXPECT_EQ(EstimateFromSample(rows), rows);
+}
+
+TEST(TableSampleTest, ScalesThroughDerivedTablesCtesAndSubqueries) {
+  const TableSample sample{TableSample::Method::kBernoulli, 0.25,
+                           std::nullopt};
+  // SELECT COUNT(*) FROM (SELECT a FROM t TABLESAMPLE ...) d
+  const auto derived = CountOf("d", SampledRows(sample));
+  const auto from_derived = EstimateFromSample(derived);
+  ASSERT_EQ(from_derived->SelectList().size(), 2U);
+  EXPECT_EQ(from_derived->SelectList()[0].expression->Type(),
+            TypeTag::kBinaryExp);
+  EXPECT_EQ(from_derived->SelectList()[1].name, "n_stderr");
+
+  // WITH s AS (SELECT a FROM t TABLESAMPLE ...) SELECT COUNT(*) FROM s
+  const auto cte = CountOf("s");
+  cte->AddWithQuery("s", SampledRows(sample));
+  const auto from_cte = EstimateFromSample(cte);
+  ASSERT_EQ(from_cte->SelectList().size(), 2U);
+  EXPECT_EQ(from_cte->SelectList()[0].expression->Type(),
+            TypeTag::kBinaryExp);
+
+  // Groups of a sampled table are not a sample of anything: only the inner
+  // COUNT is scaled.
+  const auto grouped = SampledAggregates(sample);
+  grouped->SetGroupBy({ColumnValueExp("a")});
+  const auto over_groups = EstimateFromSample(CountOf("g", grouped));
+  ASSERT_EQ(over_groups->SelectList().size(), 1U);
+  EXPECT_EQ(over_groups->SelectList()[0].expression->Type(),
+            TypeTag::kAggregateExp);
+  EXPECT_EQ(over_groups->Sources()[0]
+                .query->SelectList()[0]
+                .expression->Type(),
+            TypeTag::kBinaryExp);
+
+  // SELECT a FROM u WHERE a < (SELECT COUNT(*) FROM t TABLESAMPLE ...)
+  const Expression subquery =
+      QueryExpressionExp(CountOf("s", SampledRows(sample)));
+  auto outer = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("a")},
+      std::vector<std::string>{"u"},
+      BinaryExpressionExp(ColumnValueExp("a"), BinaryOperation::kLessThan,
+                          subquery));
+  const auto with_subquery = EstimateFromSample(outer);
+  ASSERT_NE(with_subquery, outer);
+  const Expression& compared =
+      with_subquery->WhereClause()->AsBinaryExpression().Right();
+  ASSERT_EQ(compared->Type(), TypeTag::kQueryExp);
+  EXPECT_EQ(compared->AsQueryExpression()
+                .Query()
+                ->SelectList()[0]
+                .expression->Type(),
+            TypeTag::kBinaryExp);
+}
+
+TEST(TableSampleTest, RowSamplingKeepsAboutTheFraction) {
+  size_t kept = 0;
+  size_t again = 0;
+  for (page_id_t page = 1; page <= 100; ++page) {
+    for (slot_t slot = 0; slot < 100; ++slot) {
+      kept += SampleKeepsRow(0.3, 42, RowPosition(page, slot)) ? 1 : 0;
+      again += SampleKeepsRow(0.3, 42, RowPosition(page, slot)) ? 1 : 0;
+    }
+  }
+  EXPECT_EQ(kept, again);
+  EXPECT_NEAR(static_cast<double>(kept), 3000.0, 300.0);
+  EXPECT_TRUE(SampleKeepsRow(1.0, 42, RowPosition(1, 1)));
+}
+
+class TableSampleDatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    database_ =
+        std::make_unique<Database>("table_sample_test-" + RandomString());
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_TRUE(database_
+                    ->CreateTable(ctx,
+                                  Schema("t", {Column("a", ValueType::kInt64),
+                                               Column("pad",
+                                                      ValueType::kVarChar)}))
+                    .HasValue());
+    StatusOr<std::shared_ptr<Table>> table = ctx.GetTable("t");
+    ASSERT_TRUE(table.HasValue());
+    // Wide rows spread the table over enough pages to sample.
+    const std::string pad(100, 'x');
+    for (int64_t i = 0; i < kRows; ++i) {
+      const Row row({Value(i % 10), Value(std::string(pad))});
+      ASSERT_TRUE(table.Value()->Insert(ctx.txn_, row).HasValue());
+    }
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  void TearDown() override { database_->DeleteAll(); }
+
+  Row Run(const TableSample& sample) {
+    TransactionContext ctx = database_->BeginContext();
+    RelationalExecutor executor(ctx,
+                                EstimateFromSample(SampledAggregates(sample)));
+    Row row;
+    EXPECT_TRUE(executor.Next(&row, nullptr));
+    EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+    return row;
+  }
+
+  std::unique_ptr<Database> database_;
+};
+
+TEST_F(TableSampleDatabaseTest, BernoulliEstimatesWithinTheError) {
+  const Row row = Run({TableSample::Method::kBernoulli, 0.1, 7});
+  ASSERT_EQ(row.values_.size(), 7U);
+  const double count = row[0].value.double_value;
+  const double count_error = row[4].value.double_value;
+  // sqrt(n (1 - q)) / q with n near 2000.
+  EXPECT_NEAR(count_error, std::sqrt(count * 0.1 * 0.9) / 0.1, 1e-6);
+  EXPECT_NEAR(count, static_cast<double>(kRows), 4 * count_error);
+  EXPECT_NEAR(row[1].value.double_value, 4.5 * kRows,
+              4 * row[5].value.double_value);
+  EXPECT_NEAR(row[2].value.double_value, 4.5,
+              4 * row[6].value.double_value);
+  EXPECT_EQ(row[3], Value(0));
+  // The same seed samples the same rows.
+  EXPECT_EQ(Run({TableSample::Method::kBernoulli, 0.1, 7}), row);
+}
+
+TEST_F(TableSampleDatabaseTest, DerivedTablesAndCtesEstimateTheTable) {
+  const TableSample sample{TableSample::Method::kBernoulli, 0.1, 11};
+  const auto cte = CountOf("s");
+  cte->AddWithQuery("s", SampledRows(sample));
+  for (const auto& select : {CountOf("d", SampledRows(sample)), cte}) {
+    TransactionContext ctx = database_->BeginContext();
+    RelationalExecutor executor(ctx, EstimateFromSample(select));
+    Row row;
+    ASSERT_TRUE(executor.Next(&row, nullptr));
+    ASSERT_EQ(row.values_.size(), 2U);
+    EXPECT_NEAR(row[0].value.double_value, static_cast<double>(kRows),
+                4 * row[1].value.double_value);
+    EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+}
+
+TEST_F(TableSampleDatabaseTest, SystemReadsOnlySampledPages) {
+  // Sampling every page estimates nothing.
+  const Row full = Run({TableSample::Method::kSystem, 1.0, 3});
+  ASSERT_EQ(full.values_.size(), 4U);
+  EXPECT_EQ(full[0], Value(kRows));
+
+  TransactionContext ctx = database_->BeginContext();
+  std::shared_ptr<Table> table = ctx.GetTable("t").Value();
+  const size_t pages = table->BuildScanMorsels(ctx.txn_, 1).size();
+  const size_t sampled = table->BuildScanMorsels(ctx.txn_, 1, 0.5, 3).size();
+  ASSERT_GT(pages, 20U);
+  EXPECT_LT(sampled, pages);
+  EXPECT_GT(sampled, 0U);
+  ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+
+  const Row row = Run({TableSample::Method::kSystem, 0.5, 3});
+  // Every page holds about the same number of rows.
+  EXPECT_NEAR(row[0].value.double_value, static_cast<double>(kRows),
+              0.25 * kRows);
+}
+
+}  // namespace
+}  // namespace tinylamb
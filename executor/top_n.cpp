@@ -0,0 +1,36 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/top_n.hpp"
+
+#include <ostream>
+#include <utility>
+
+namespace tinylamb {
+
+void TopNExecutor::Materialize() {
+  heap_ = std::make_unique<TopNHeap>(SortExecutor::KeyEncoder(keys_, schema_),
+                                     offset_ + limit_, worker_count_);
+  Row row;
+  RowPosition position;
+  while (source_->Next(&row, &position)) {
+    heap_->Add(std::move(row), position);
+  }
+  heap_->Finish();
+  Row ignored;
+  for (size_t skipped = 0; skipped < offset_; ++skipped) {
+    if (!heap_->Next(&ignored)) break;
+  }
+}
+
+bool TopNExecutor::Next(Row* dst, RowPosition* rp) {
+  if (!heap_) Materialize();
+  return heap_->Next(dst, rp);
+}
+
+void TopNExecutor::Dump(std::ostream& output, int indent) const {
+  output << "TopN: " << limit_ << " offset " << offset_ << " ("
+         << worker_count_ << " workers)\n"
+         << std::string(indent + 2, ' ');
+  source_->Dump(output, indent + 2);
+}
+
+}  // namespace tinylamb
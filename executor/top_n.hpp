@@ -0,0 +1,45 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_TOP_N_EXECUTOR_HPP
+#define TINYLAMB_TOP_N_EXECUTOR_HPP
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "executor/executor_base.hpp"
+#include "executor/sort.hpp"
+#include "executor/top_n_heap.hpp"
+#include "page/row_position.hpp"
+#include "type/row.hpp"
+#include "type/schema.hpp"
+
+namespace tinylamb {
+// Sort followed by Limit, fused: keeps only the first `offset` + `limit`
+// rows of the sort in a TopNHeap instead of sorting the whole input.
+class TopNExecutor : public ExecutorBase {
+ public:
+  TopNExecutor(Executor source, Schema schema,
+               std::vector<SortExecutor::Key> keys, size_t limit,
+               size_t offset, size_t worker_count = 1)
+      : source_(std::move(source)),
+        schema_(std::move(schema)),
+        keys_(std::move(keys)),
+        limit_(limit),
+        offset_(offset),
+        worker_count_(std::max<size_t>(1, worker_count)) {}
+  bool Next(Row* dst, RowPosition* rp) override;
+  void Dump(std::ostream& output, int indent) const override;
+
+ private:
+  void Materialize();
+  Executor source_;
+  Schema schema_;
+  std::vector<SortExecutor::Key> keys_;
+  size_t limit_;
+  size_t offset_;
+  size_t worker_count_;
+  std::unique_ptr<TopNHeap> heap_;
+};
+}  // namespace tinylamb
+#endif
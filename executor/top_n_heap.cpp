@@ -0,0 +1,107 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/top_n_heap.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "executor/join_hash_table.hpp"
+
+namespace tinylamb {
+
+TopNHeap::TopNHeap(Less less, size_t limit, size_t workers)
+    : less_(std::move(less)),
+      limit_(limit),
+      workers_(std::max<size_t>(1, workers)),
+      heaps_(workers_) {}
+
+TopNHeap::TopNHeap(SortKeyFn key_of, size_t limit, size_t workers)
+    : key_of_(std::move(key_of)),
+      limit_(limit),
+      workers_(std::max<size_t>(1, workers)),
+      heaps_(workers_) {}
+
+void TopNHeap::Add(Row row, const RowPosition& position) {
+  Entry entry{std::move(row), position, sequence_++, {}};
+  if (key_of_) {
+    key_of_(entry.row, &entry.key.bytes);
+    entry.key.Seal();
+  }
+  if (workers_ == 1) {
+    Offer(&heaps_[0], std::move(entry));
+    return;
+  }
+  batch_.push_back(std::move(entry));
+  if (batch_.size() >= workers_ * kJoinMorselRows) Flush();
+}
+
+void TopNHeap::Finish() {
+  finished_ = true;
+  Flush();
+  Heap& result = heaps_[0];
+  for (size_t worker = 1; worker < heaps_.size(); ++worker) {
+    for (Entry& entry : heaps_[worker].entries) {
+      Offer(&result, std::move(entry));
+    }
+    heaps_[worker] = Heap();
+  }
+  std::sort_heap(result.entries.begin(), result.entries.end(),
+                 [this](const Entry& left, const Entry& right) {
+                   return Before(left, right);
+                 });
+}
+
+bool TopNHeap::Next(Row* row, RowPosition* position) {
+  if (!finished_) Finish();
+  Heap& result = heaps_[0];
+  if (offset_ >= result.entries.size()) {
+    if (!result.entries.empty()) result = Heap();
+    return false;
+  }
+  Entry& entry = result.entries[offset_++];
+  *row = std::move(entry.row);
+  if (position != nullptr) *position = entry.position;
+  return true;
+}
+
+bool TopNHeap::Before(const Entry& left, const Entry& right) const {
+  if (key_of_) {
+    const int order = left.key.Compare(right.key);
+    if (order != 0) return order < 0;
+  } else {
+    if (less_(left.row, right.row)) return true;
+    if (less_(right.row, left.row)) return false;
+  }
+  return left.sequence < right.sequence;
+}
+
+void TopNHeap::Offer(Heap* heap, Entry&& entry) const {
+  if (limit_ == 0) return;
+  const auto before = [this](const Entry& left, const Entry& right) {
+    return Before(left, right);
+  };
+  std::vector<Entry>& entries = heap->entries;
+  if (entries.size() < limit_) {
+    heap->charge.Add(EstimateRowBytes(entry.row) + sizeof(Entry) +
+                     entry.key.bytes.size());
+    entries.push_back(std::move(entry));
+    std::push_heap(entries.begin(), entries.end(), before);
+    return;
+  }
+  if (!Before(entry, entries.front())) return;
+  std::pop_heap(entries.begin(), entries.end(), before);
+  entries.back() = std::move(entry);
+  std::push_heap(entries.begin(), entries.end(), before);
+}
+
+void TopNHeap::Flush() {
+  if (batch_.empty()) return;
+  RunMorsels(batch_.size(), kJoinMorselRows, workers_,
+             [&](size_t worker, size_t begin, size_t end) {
+               for (size_t i = begin; i < end; ++i) {
+                 Offer(&heaps_[worker], std::move(batch_[i]));
+               }
+             });
+  batch_.clear();
+}
+
+}  // namespace tinylamb
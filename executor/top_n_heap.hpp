@@ -0,0 +1,79 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXECUTOR_TOP_N_HEAP_HPP
+#define TINYLAMB_EXECUTOR_TOP_N_HEAP_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "executor/external_sort.hpp"
+#include "executor/query_memory.hpp"
+#include "page/row_position.hpp"
+#include "type/row.hpp"
+
+namespace tinylamb {
+
+// Most rows an ORDER BY ... LIMIT keeps in a TopNHeap, OFFSET included.
+// Larger limits sort everything with ExternalSort, which may spill.
+inline constexpr size_t kMaxTopNRows = 1 << 16;
+
+// The first `limit` rows of a stable sort, kept in bounded heaps.
+//
+// Every worker owns a max-heap of at most `limit` rows whose top is the row
+// that sorts last; a new row either replaces it or is dropped at once, so
+// memory stays O(limit) whatever the input size. With several workers the
+// rows are handed out in batches of morsels, and Finish() merges the worker
+// heaps into one. Equal rows keep their input order, as in ExternalSort.
+//
+// Rows are ordered by a comparator or by normalized sort keys, which are
+// encoded once per row in Add().
+class TopNHeap {
+ public:
+  using Less = ExternalSort::Less;
+
+  TopNHeap(Less less, size_t limit, size_t workers);
+  TopNHeap(SortKeyFn key_of, size_t limit, size_t workers);
+  TopNHeap(const TopNHeap&) = delete;
+  TopNHeap& operator=(const TopNHeap&) = delete;
+
+  void Add(Row row, const RowPosition& position = RowPosition());
+  // Ends the input. The kept rows then come out in order from Next().
+  void Finish();
+  bool Next(Row* row, RowPosition* position = nullptr);
+
+  // Rows passed to Add().
+  [[nodiscard]] size_t InputRows() const { return sequence_; }
+
+ private:
+  struct Entry {
+    Row row;
+    RowPosition position;
+    size_t sequence;
+    // Normalized sort key; empty when ordering by `less_`.
+    SortKey key;
+  };
+  struct Heap {
+    std::vector<Entry> entries;
+    QueryMemoryCharge charge;
+  };
+
+  // True when `left` sorts before `right`.
+  [[nodiscard]] bool Before(const Entry& left, const Entry& right) const;
+  void Offer(Heap* heap, Entry&& entry) const;
+  // Offers the batched rows to the worker heaps.
+  void Flush();
+
+  Less less_;
+  SortKeyFn key_of_;
+  size_t limit_;
+  size_t workers_;
+  std::vector<Heap> heaps_;
+  std::vector<Entry> batch_;
+  size_t sequence_{0};
+  size_t offset_{0};
+  bool finished_{false};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXECUTOR_TOP_N_HEAP_HPP
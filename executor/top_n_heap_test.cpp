@@ -0,0 +1,86 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "executor/top_n_heap.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "executor/executor_test_util.hpp"
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+namespace {
+
+bool KeyLess(const Row& left, const Row& right) { return left[0] < right[0]; }
+
+std::vector<Row> Expected(std::vector<Row> rows, size_t limit) {
+  std::stable_sort(rows.begin(), rows.end(), KeyLess);
+  rows.resize(std::min(rows.size(), limit));
+  return rows;
+}
+
+std::vector<Row> TopN(const std::vector<Row>& rows, size_t limit,
+                      size_t workers) {
+  TopNHeap heap(KeyLess, limit, workers);
+  for (const Row& row : rows) heap.Add(row);
+  heap.Finish();
+  EXPECT_EQ(heap.InputRows(), rows.size());
+  std::vector<Row> kept;
+  Row row;
+  while (heap.Next(&row)) kept.push_back(row);
+  return kept;
+}
+
+}  // namespace
+
+TEST(TopNHeapTest, KeepsFirstRowsInStableOrder) {
+  const std::vector<Row> rows = ScrambledRows(5000, 37);
+  EXPECT_EQ(TopN(rows, 300, 1), Expected(rows, 300));
+}
+
+TEST(TopNHeapTest, MergesWorkerHeaps) {
+  const std::vector<Row> rows = ScrambledRows(50000, 1009);
+  EXPECT_EQ(TopN(rows, 100, 4), Expected(rows, 100));
+  EXPECT_EQ(TopN(rows, 1, 3), Expected(rows, 1));
+}
+
+TEST(TopNHeapTest, OrdersByNormalizedKeys) {
+  const std::vector<Row> rows = ScrambledRows(20000, 503);
+  TopNHeap heap(
+      [](const Row& row, std::string* key) {
+        key->clear();
+        AppendSortKey(row[0], true, key);
+      },
+      50, 2);
+  for (const Row& row : rows) heap.Add(row);
+  std::vector<Row> kept;
+  Row row;
+  while (heap.Next(&row)) kept.push_back(row);
+  EXPECT_EQ(kept, Expected(rows, 50));
+}
+
+TEST(TopNHeapTest, ShortInputAndZeroLimit) {
+  const std::vector<Row> rows = ScrambledRows(20, 5);
+  EXPECT_EQ(TopN(rows, 100, 2), Expected(rows, 100));
+  EXPECT_TRUE(TopN(rows, 0, 2).empty());
+}
+
+TEST(TopNHeapTest, KeepsPositions) {
+  TopNHeap heap(
+      [](const Row& left, const Row& right) { return right[0] < left[0]; }, 3,
+      1);
+  for (int64_t i = 0; i < 10; ++i) {
+    heap.Add(Row({Value(i % 4)}), RowPosition(static_cast<page_id_t>(i), 0));
+  }
+  Row row;
+  RowPosition position;
+  std::vector<page_id_t> pages;
+  while (heap.Next(&row, &position)) {
+    EXPECT_EQ(row[0], Value(static_cast<int64_t>(position.page_id % 4)));
+    pages.push_back(position.page_id);
+  }
+  EXPECT_EQ(pages, (std::vector<page_id_t>{3, 7, 2}));
+}
+
+}  // namespace tinylamb
@@ -37,7 +37,8 @@ Value AggregateExpression::Evaluate(const Row&, const Schema&) const {
 }
 
 Type AggregateExpression::ResultType(const Schema& schema) const {
-  if (type_ == AggregationType::kCount) {
+  if (type_ == AggregationType::kCount ||
+      type_ == AggregationType::kApproxCountDistinct) {
     return tinylamb::Type(TypeTag::kBigInt);
   }
   if (type_ == AggregationType::kAvg) {
@@ -48,7 +49,8 @@ Type AggregateExpression::ResultType(const Schema& schema) const {
 
 Type AggregateExpression::ResultType(const Schema& left,
                                      const Schema& right) const {
-  if (type_ == AggregationType::kCount) {
+  if (type_ == AggregationType::kCount ||
+      type_ == AggregationType::kApproxCountDistinct) {
     return tinylamb::Type(TypeTag::kBigInt);
   }
   if (type_ == AggregationType::kAvg) {
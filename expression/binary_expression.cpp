@@ -20,6 +20,7 @@
 #include <stdexcept>
 #include <unordered_set>
 
+#include "expression/constant_value.hpp"
 #include "type/schema.hpp"
 
 namespace tinylamb {
@@ -31,35 +32,34 @@ std::unordered_set<ColumnName> BinaryExpression::TouchedColumns() const {
 }
 namespace {
 
-bool Like(std::string_view value, std::string_view pattern) {
-  size_t value_pos = 0;
-  size_t pattern_pos = 0;
-  size_t wildcard = std::string_view::npos;
-  size_t retry = 0;
-  while (value_pos < value.size()) {
-    if (pattern_pos < pattern.size() &&
-        (pattern[pattern_pos] == '_' ||
-         pattern[pattern_pos] == value[value_pos])) {
-      ++value_pos;
-      ++pattern_pos;
-    } else if (pattern_pos < pattern.size() && pattern[pattern_pos] == '%') {
-      wildcard = pattern_pos++;
-      retry = value_pos;
-    } else if (wildcard != std::string_view::npos) {
-      pattern_pos = wildcard + 1;
-      value_pos = ++retry;
-    } else {
-      return false;
-    }
-  }
-  while (pattern_pos < pattern.size() && pattern[pattern_pos] == '%') {
-    ++pattern_pos;
+Value LikeResult(BinaryOperation op, bool matched) {
+  return Value(op == BinaryOperation::kLike ? matched : !matched);
+}
+
+Value MatchLike(BinaryOperation op, const LikeMatcher& matcher,
+                const Value& value) {
+  if (value.IsNull()) return Value();
+  if (value.type != ValueType::kVarChar) {
+    throw std::runtime_error("LIKE requires strings");
   }
-  return pattern_pos == pattern.size();
+  return LikeResult(op, matcher.Matches(value.value.varchar_value));
 }
 
 }  // namespace
 
+BinaryExpression::BinaryExpression(Expression left, BinaryOperation op,
+                                   Expression right)
+    : left_(std::move(left)), right_(std::move(right)), op_(op) {
+  if ((op_ == BinaryOperation::kLike || op_ == BinaryOperation::kNotLike) &&
+      right_->Type() == TypeTag::kConstantValue) {
+    const Value pattern =
+        dynamic_cast<const ConstantValue&>(*right_).GetValue();
+    if (pattern.type == ValueType::kVarChar) {
+      like_ = std::make_shared<const LikeMatcher>(pattern.value.varchar_value);
+    }
+  }
+}
+
 Value EvaluateBinary(BinaryOperation op, const Value& left,
                      const Value& right) {
   if (op == BinaryOperation::kAnd) {
@@ -87,9 +87,8 @@ Value EvaluateBinary(BinaryOperation op, const Value& left,
     if (left.type != ValueType::kVarChar || right.type != ValueType::kVarChar) {
       throw std::runtime_error("LIKE requires strings");
     }
-    const bool matched =
-        Like(left.value.varchar_value, right.value.varchar_value);
-    return Value(op == BinaryOperation::kLike ? matched : !matched);
+    return LikeResult(op, LikeMatcher(right.value.varchar_value)
+                              .Matches(left.value.varchar_value));
   }
   const bool numeric =
       (left.type == ValueType::kInt64 || left.type == ValueType::kDouble) &&
@@ -165,6 +164,9 @@ Value EvaluateBinary(BinaryOperation op, const Value& left,
 }
 
 Value BinaryExpression::Evaluate(const Row& row, const Schema& schema) const {
+  if (like_ != nullptr) {
+    return MatchLike(op_, *like_, left_->Evaluate(row, schema));
+  }
   return EvaluateBinary(op_, left_->Evaluate(row, schema),
                         right_->Evaluate(row, schema));
 }
@@ -172,6 +174,10 @@ Value BinaryExpression::Evaluate(const Row& row, const Schema& schema) const {
 Value BinaryExpression::Evaluate(const Row* left, const Schema& left_schema,
                                  const Row* right,
                                  const Schema& right_schema) const {
+  if (like_ != nullptr) {
+    return MatchLike(op_, *like_,
+                     left_->Evaluate(left, left_schema, right, right_schema));
+  }
   return EvaluateBinary(
       op_, left_->Evaluate(left, left_schema, right, right_schema),
       right_->Evaluate(left, left_schema, right, right_schema));
@@ -21,6 +21,7 @@
 #include <utility>
 
 #include "expression/expression.hpp"
+#include "expression/like_matcher.hpp"
 
 namespace tinylamb {
 
@@ -29,8 +30,7 @@ namespace tinylamb {
 
 class BinaryExpression : public ExpressionBase {
  public:
-  BinaryExpression(Expression left, BinaryOperation op, Expression right)
-      : left_(std::move(left)), right_(std::move(right)), op_(op) {}
+  BinaryExpression(Expression left, BinaryOperation op, Expression right);
   [[nodiscard]] TypeTag Type() const override { return TypeTag::kBinaryExp; }
   [[nodiscard]] Value Evaluate(const Row& row,
                                const Schema& schema) const override;
@@ -43,6 +43,9 @@ class BinaryExpression : public ExpressionBase {
   [[nodiscard]] BinaryOperation Op() const { return op_; }
   [[nodiscard]] const Expression& Left() const { return left_; }
   [[nodiscard]] const Expression& Right() const { return right_; }
+  // Non-null for LIKE / NOT LIKE against a constant pattern, which is compiled
+  // once here instead of being re-parsed for every row.
+  [[nodiscard]] const LikeMatcher* LikePattern() const { return like_.get(); }
   std::string ToString() const override;
   void Dump(std::ostream& o) const override;
   [[nodiscard]] std::unordered_set<ColumnName> TouchedColumns() const override;
@@ -51,6 +54,7 @@ class BinaryExpression : public ExpressionBase {
   Expression left_;
   Expression right_;
   BinaryOperation op_;
+  std::shared_ptr<const LikeMatcher> like_;
 };
 
 }  // namespace tinylamb
@@ -64,6 +64,15 @@ bool CompileNode(const Expression& expression, const Schema& schema,
     }
     case TypeTag::kBinaryExp: {
       const BinaryExpression& binary = expression->AsBinaryExpression();
+      if (const LikeMatcher* like = binary.LikePattern();
+          like != nullptr && ValueTypeFor(binary.Left()->ResultType(schema)) ==
+                                 ValueType::kVarChar) {
+        if (!CompileNode(binary.Left(), schema, program)) return false;
+        program->AddInstruction({BytecodeOp::kLikeVarchar,
+                                 program->AddLikeMatcher(like->Pattern()),
+                                 binary.Op()});
+        return true;
+      }
       if (!CompileNode(binary.Left(), schema, program) ||
           !CompileNode(binary.Right(), schema, program)) {
         return false;
@@ -119,6 +128,23 @@ std::optional<BytecodeProgram> BytecodeCompiler::Compile(
 
 ColumnVector BytecodeProgram::EvaluateBatch(const DataChunk& input) const {
   ColumnVector result(result_type_, input.Size());
+  if (instructions_.size() == 2 &&
+      instructions_[0].opcode == BytecodeOp::kLoadColumn &&
+      instructions_[1].opcode == BytecodeOp::kLikeVarchar) {
+    // `column LIKE 'pattern'` matches the whole vector in one pass.
+    const ColumnVector& column = input.ColumnAt(instructions_[0].operand);
+    std::vector<uint8_t> matched(input.Size());
+    like_matchers_[instructions_[1].operand].MatchBatch(column, matched.data());
+    const bool negate = instructions_[1].binary == BinaryOperation::kNotLike;
+    for (size_t row = 0; row < input.Size(); ++row) {
+      if (column.IsNull(row)) {
+        result.Append(Value());
+      } else {
+        result.Append(Value(static_cast<int64_t>(matched[row] != 0) ^ negate));
+      }
+    }
+    return result;
+  }
   std::vector<Value> stack;
   stack.reserve(instructions_.size());
   for (size_t row = 0; row < input.Size(); ++row) {
@@ -142,6 +168,19 @@ ColumnVector BytecodeProgram::EvaluateBatch(const DataChunk& input) const {
           stack.push_back(EvaluateBinary(instruction.binary, left, right));
           break;
         }
+        case BytecodeOp::kLikeVarchar: {
+          Value& value = stack.back();
+          if (value.IsNull()) break;
+          if (value.type != ValueType::kVarChar) {
+            throw std::runtime_error("LIKE requires strings");
+          }
+          const bool matched = like_matchers_[instruction.operand].Matches(
+              value.value.varchar_value);
+          value = Value(instruction.binary == BinaryOperation::kLike
+                            ? matched
+                            : !matched);
+          break;
+        }
         case BytecodeOp::kUnaryInt64:
         case BytecodeOp::kUnaryDouble: {
           Value child = std::move(stack.back());
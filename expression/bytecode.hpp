@@ -8,6 +8,7 @@
 
 #include "executor/data_chunk.hpp"
 #include "expression/expression.hpp"
+#include "expression/like_matcher.hpp"
 #include "type/schema.hpp"
 
 namespace tinylamb {
@@ -19,6 +20,9 @@ enum class BytecodeOp : uint8_t {
   kBinaryDouble,
   kBinaryVarchar,
   kBinaryDate,
+  // LIKE / NOT LIKE against a constant pattern; operand indexes the
+  // program's precompiled matchers.
+  kLikeVarchar,
   kUnaryInt64,
   kUnaryDouble,
 };
@@ -47,12 +51,17 @@ class BytecodeProgram {
     constants_.push_back(std::move(value));
     return static_cast<uint16_t>(constants_.size() - 1);
   }
+  [[nodiscard]] uint16_t AddLikeMatcher(std::string_view pattern) {
+    like_matchers_.emplace_back(pattern);
+    return static_cast<uint16_t>(like_matchers_.size() - 1);
+  }
   void SetResultType(ValueType type) { result_type_ = type; }
 
  private:
   friend class BytecodeCompiler;
   std::vector<BytecodeInstruction> instructions_;
   std::vector<Value> constants_;
+  std::vector<LikeMatcher> like_matchers_;
   ValueType result_type_{ValueType::kNull};
 };
 
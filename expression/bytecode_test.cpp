@@ -63,4 +63,23 @@ TEST(BytecodeTest, DateComparisonUsesTypedDateOpcode) {
   EXPECT_EQ(program->EvaluateBatch(input).ValueAt(0), Value(true));
 }
 
+TEST(BytecodeTest, ConstantLikePatternCompilesToMatcher) {
+  const Schema schema("comments", {Column("comment", ValueType::kVarChar)});
+  DataChunk input(schema);
+  input.Append(Row({Value("special packages requests")}));
+  input.Append(Row({Value("ordinary")}));
+  input.Append(Row({Value()}));
+  Expression predicate = BinaryExpressionExp(
+      ColumnValueExp("comment"), BinaryOperation::kNotLike,
+      ConstantValueExp(Value("%special%requests%")));
+  auto program = BytecodeCompiler::Compile(predicate, schema);
+  ASSERT_TRUE(program);
+  ASSERT_EQ(program->Instructions().size(), 2U);
+  EXPECT_EQ(program->Instructions().back().opcode, BytecodeOp::kLikeVarchar);
+  const ColumnVector output = program->EvaluateBatch(input);
+  EXPECT_EQ(output.ValueAt(0), Value(false));
+  EXPECT_EQ(output.ValueAt(1), Value(true));
+  EXPECT_TRUE(output.ValueAt(2).IsNull());
+}
+
 }  // namespace tinylamb
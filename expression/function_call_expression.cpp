@@ -17,6 +17,7 @@
 #include "expression/function_call_expression.hpp"
 
 #include <chrono>
+#include <cmath>
 #include <cstdio>
 #include <ctime>
 #include <iomanip>
@@ -101,6 +102,19 @@ Value ExecuteFunction(const std::string& name,
     output << std::put_time(&utc, "%Y-%m-%d %H:%M:%S");
     return Value(output.str());
   }
+  if (name == "sqrt") {
+    if (values.size() != 1) {
+      throw std::runtime_error("SQRT requires one argument");
+    }
+    if (values[0].IsNull()) return Value();
+    if (values[0].type == ValueType::kInt64) {
+      return Value(std::sqrt(static_cast<double>(values[0].value.int_value)));
+    }
+    if (values[0].type != ValueType::kDouble) {
+      throw std::runtime_error("SQRT requires a numeric argument");
+    }
+    return Value(std::sqrt(values[0].value.double_value));
+  }
   throw std::runtime_error("Function calls are not yet executable: " + name);
 }
 }  // namespace
@@ -196,6 +210,9 @@ Type FunctionCallExpression::ResultType(const Schema& schema) const {
   if (func_name_ == "date_add" || func_name_ == "date_sub") {
     return args_[0]->ResultType(schema);
   }
+  if (func_name_ == "sqrt") {
+    return tinylamb::Type(TypeTag::kDouble);
+  }
   if (func_name_.starts_with("extract_")) {
     return tinylamb::Type(TypeTag::kBigInt);
   }
@@ -214,6 +231,9 @@ Type FunctionCallExpression::ResultType(const Schema& left,
   if (func_name_ == "date_add" || func_name_ == "date_sub") {
     return args_[0]->ResultType(left, right);
   }
+  if (func_name_ == "sqrt") {
+    return tinylamb::Type(TypeTag::kDouble);
+  }
   if (func_name_.starts_with("extract_")) {
     return tinylamb::Type(TypeTag::kBigInt);
   }
@@ -1,12 +1,27 @@
 /** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
 #include "expression/jit.hpp"
 
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
 #include <mutex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+#include <sys/stat.h>
+#include <unistd.h>
 
 #ifdef TINYLAMB_HAS_LLVM
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 #include <llvm/IR/BasicBlock.h>
@@ -14,20 +29,148 @@
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
+#include <llvm/Object/ObjectFile.h>
 #include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/xxhash.h>
 #endif
 
 namespace tinylamb {
+namespace {
+
+std::mutex cache_directory_mu;
+std::optional<std::filesystem::path> cache_directory_override;
+
+std::filesystem::path CacheDirectoryFromEnv() {
+  const char* env = std::getenv("TINYLAMB_JIT_CACHE_DIR");
+  if (env == nullptr) return {};
+  const std::string_view value(env);
+  if (value.empty() || value == "0") return {};
+  return std::filesystem::path(value);
+}
+
+#ifdef TINYLAMB_HAS_LLVM
+// Cached objects are executed as code, so only trust entries that nobody but
+// the current user could have written.
+bool OwnedAndPrivate(const struct stat& info) {
+  return info.st_uid == geteuid() && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+// Creates `directory` as 0700 when missing. Refuses symlinks and directories
+// owned by another user or writable by group/others.
+bool PrepareCacheDirectory(const std::filesystem::path& directory) {
+  if (::mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) return false;
+  struct stat info {};
+  if (::lstat(directory.c_str(), &info) != 0) return false;
+  return S_ISDIR(info.st_mode) && OwnedAndPrivate(info);
+}
+
+// ORC object cache backed by one file per compiled module. The target string
+// is folded into the key so objects never leak across CPUs or triples.
+class JitObjectCache : public llvm::ObjectCache {
+ public:
+  explicit JitObjectCache(std::filesystem::path directory)
+      : directory_(std::move(directory)) {}
+
+  void SetTarget(std::string target) { target_ = std::move(target); }
+  [[nodiscard]] bool Hit() const { return hit_; }
+
+  // Drops the object served by getObject() after it failed to link.
+  void DiscardHit() {
+    if (!hit_) return;
+    std::error_code ec;
+    std::filesystem::remove(pending_path_, ec);
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(
+      const llvm::Module* module) override {
+    // Codegen mutates the module, so the key is taken from the IR seen here
+    // and reused when the freshly compiled object is stored.
+    pending_path_ = PathFor(*module);
+    struct stat info {};
+    if (::lstat(pending_path_.c_str(), &info) != 0) return nullptr;
+    if (!S_ISREG(info.st_mode) || !OwnedAndPrivate(info)) return nullptr;
+    auto buffer = llvm::MemoryBuffer::getFile(pending_path_.string(),
+                                              /*IsText=*/false,
+                                              /*RequiresNullTerminator=*/false);
+    if (!buffer) return nullptr;
+    // A truncated or foreign file is recompiled and overwritten.
+    auto parsed = llvm::object::ObjectFile::createObjectFile(
+        (*buffer)->getMemBufferRef());
+    if (!parsed) {
+      llvm::consumeError(parsed.takeError());
+      return nullptr;
+    }
+    hit_ = true;
+    return std::move(*buffer);
+  }
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef object) override {
+    const std::filesystem::path path =
+        pending_path_.empty() ? PathFor(*module) : pending_path_;
+    // Write to a private name and rename so concurrent processes never observe
+    // a torn object file.
+    static std::atomic<uint64_t> sequence{0};
+    std::ostringstream temp_name;
+    temp_name << path.filename().string() << ".tmp."
+              << std::hash<std::thread::id>{}(std::this_thread::get_id())
+              << '.' << sequence.fetch_add(1);
+    const std::filesystem::path temp = directory_ / temp_name.str();
+    std::error_code ec;
+    {
+      std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+      if (!out) return;
+      out.write(object.getBufferStart(),
+                static_cast<std::streamsize>(object.getBufferSize()));
+      if (!out) {
+        out.close();
+        std::filesystem::remove(temp, ec);
+        return;
+      }
+    }
+    std::filesystem::permissions(temp, std::filesystem::perms::owner_read |
+                                           std::filesystem::perms::owner_write,
+                                 ec);
+    if (!ec) std::filesystem::rename(temp, path, ec);
+    if (ec) std::filesystem::remove(temp, ec);
+  }
+
+ private:
+  [[nodiscard]] std::filesystem::path PathFor(const llvm::Module& module) const {
+    std::string key;
+    llvm::raw_string_ostream stream(key);
+    module.print(stream, nullptr);
+    stream << '\0' << target_;
+    stream.flush();
+    std::ostringstream name;
+    name << module.getName().str() << '-' << std::hex
+         << llvm::xxHash64(key) << ".o";
+    return directory_ / name.str();
+  }
+
+  std::filesystem::path directory_;
+  std::filesystem::path pending_path_;
+  std::string target_;
+  bool hit_{false};
+};
+#endif
+
+}  // namespace
 
 struct JitInt64Kernels::Impl {
 #ifdef TINYLAMB_HAS_LLVM
+  // Declared before `jit` so the cache outlives the compile layer using it.
+  std::unique_ptr<JitObjectCache> cache;
   std::unique_ptr<llvm::orc::LLJIT> jit;
 #endif
   FilterFn filter{nullptr};
   ProjectionFn projection{nullptr};
   SumFn sum{nullptr};
   double compile_ms{0};
+  bool loaded_from_cache{false};
 };
 
 #ifdef TINYLAMB_HAS_LLVM
@@ -41,20 +184,50 @@ void InitializeLlvm() {
   });
 }
 
-std::unique_ptr<JitInt64Kernels::Impl> CreateImpl(
-    std::unique_ptr<llvm::Module> module,
-    std::unique_ptr<llvm::LLVMContext> context, std::string_view symbol) {
+using ModuleBuilder =
+    std::function<std::unique_ptr<llvm::Module>(llvm::LLVMContext&)>;
+
+std::unique_ptr<JitInt64Kernels::Impl> Link(
+    const ModuleBuilder& build, std::string_view symbol,
+    std::filesystem::path directory) {
   auto impl = std::make_unique<JitInt64Kernels::Impl>();
-  auto jit = llvm::orc::LLJITBuilder().create();
-  if (!jit) return nullptr;
+  llvm::orc::LLJITBuilder builder;
+  if (!directory.empty()) {
+    impl->cache = std::make_unique<JitObjectCache>(std::move(directory));
+    JitObjectCache* cache = impl->cache.get();
+    builder.setCompileFunctionCreator(
+        [cache](llvm::orc::JITTargetMachineBuilder machine)
+            -> llvm::Expected<
+                std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+          cache->SetTarget(machine.getTargetTriple().str() + '|' +
+                           machine.getCPU() + '|' +
+                           machine.getFeatures().getString());
+          auto target = machine.createTargetMachine();
+          if (!target) return target.takeError();
+          return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(
+              std::move(*target), cache);
+        });
+  }
+  auto jit = builder.create();
+  if (!jit) {
+    llvm::consumeError(jit.takeError());
+    return nullptr;
+  }
   impl->jit = std::move(*jit);
-  if (llvm::Error error = impl->jit->addIRModule(
-          llvm::orc::ThreadSafeModule(std::move(module), std::move(context)))) {
+  auto context = std::make_unique<llvm::LLVMContext>();
+  std::unique_ptr<llvm::Module> module = build(*context);
+  auto fail = [&impl](llvm::Error error) {
     llvm::consumeError(std::move(error));
+    if (impl->cache) impl->cache->DiscardHit();
     return nullptr;
+  };
+  if (llvm::Error error = impl->jit->addIRModule(
+          llvm::orc::ThreadSafeModule(std::move(module), std::move(context)))) {
+    return fail(std::move(error));
   }
   auto address = impl->jit->lookup(symbol);
-  if (!address) return nullptr;
+  if (!address) return fail(address.takeError());
+  impl->loaded_from_cache = impl->cache && impl->cache->Hit();
   if (symbol == "tinylamb_filter") {
     impl->filter = address->toPtr<JitInt64Kernels::FilterFn>();
   } else if (symbol == "tinylamb_project") {
@@ -65,6 +238,19 @@ std::unique_ptr<JitInt64Kernels::Impl> CreateImpl(
   return impl;
 }
 
+// Links through the object cache when one is configured and usable, and
+// falls back to plain codegen whenever a cached object fails to load or link.
+std::unique_ptr<JitInt64Kernels::Impl> CreateImpl(const ModuleBuilder& build,
+                                                  std::string_view symbol) {
+  std::filesystem::path directory = JitInt64Kernels::CacheDirectory();
+  if (!directory.empty() && !PrepareCacheDirectory(directory)) {
+    directory.clear();
+  }
+  if (directory.empty()) return Link(build, symbol, {});
+  if (auto impl = Link(build, symbol, std::move(directory))) return impl;
+  return Link(build, symbol, {});
+}
+
 llvm::Value* Comparison(llvm::IRBuilder<>& builder, BinaryOperation operation,
                         llvm::Value* left, llvm::Value* right) {
   switch (operation) {
@@ -104,46 +290,47 @@ std::optional<JitInt64Kernels> JitInt64Kernels::CompileFilter(
   if (!IsComparison(operation)) return std::nullopt;
   InitializeLlvm();
   const auto begin = std::chrono::steady_clock::now();
-  auto context = std::make_unique<llvm::LLVMContext>();
-  auto module = std::make_unique<llvm::Module>("tinylamb_filter", *context);
-  llvm::IRBuilder<> builder(*context);
-  llvm::Type* i64 = builder.getInt64Ty();
-  llvm::Type* i8 = builder.getInt8Ty();
-  auto* type = llvm::FunctionType::get(
-      builder.getVoidTy(),
-      {llvm::PointerType::getUnqual(*context),
-       llvm::PointerType::getUnqual(*context), i64, i64},
-      false);
-  auto* function = llvm::Function::Create(
-      type, llvm::Function::ExternalLinkage, "tinylamb_filter", *module);
-  auto argument = function->arg_begin();
-  llvm::Value* input = argument++;
-  llvm::Value* output = argument++;
-  llvm::Value* count = argument++;
-  llvm::Value* constant = argument++;
-  auto* entry = llvm::BasicBlock::Create(*context, "entry", function);
-  auto* loop = llvm::BasicBlock::Create(*context, "loop", function);
-  auto* body = llvm::BasicBlock::Create(*context, "body", function);
-  auto* exit = llvm::BasicBlock::Create(*context, "exit", function);
-  builder.SetInsertPoint(entry);
-  builder.CreateBr(loop);
-  builder.SetInsertPoint(loop);
-  auto* index = builder.CreatePHI(i64, 2, "index");
-  index->addIncoming(builder.getInt64(0), entry);
-  builder.CreateCondBr(builder.CreateICmpULT(index, count), body, exit);
-  builder.SetInsertPoint(body);
-  auto* input_ptr = builder.CreateGEP(i64, input, index);
-  auto* value = builder.CreateLoad(i64, input_ptr);
-  auto* compared = Comparison(builder, operation, value, constant);
-  auto* output_ptr = builder.CreateGEP(i8, output, index);
-  builder.CreateStore(builder.CreateZExt(compared, i8), output_ptr);
-  auto* next = builder.CreateAdd(index, builder.getInt64(1));
-  builder.CreateBr(loop);
-  index->addIncoming(next, body);
-  builder.SetInsertPoint(exit);
-  builder.CreateRetVoid();
-  auto impl = CreateImpl(std::move(module), std::move(context),
-                         "tinylamb_filter");
+  auto build = [operation](llvm::LLVMContext& context) {
+    auto module = std::make_unique<llvm::Module>("tinylamb_filter", context);
+    llvm::IRBuilder<> builder(context);
+    llvm::Type* i64 = builder.getInt64Ty();
+    llvm::Type* i8 = builder.getInt8Ty();
+    auto* type = llvm::FunctionType::get(
+        builder.getVoidTy(),
+        {llvm::PointerType::getUnqual(context),
+         llvm::PointerType::getUnqual(context), i64, i64},
+        false);
+    auto* function = llvm::Function::Create(
+        type, llvm::Function::ExternalLinkage, "tinylamb_filter", *module);
+    auto argument = function->arg_begin();
+    llvm::Value* input = argument++;
+    llvm::Value* output = argument++;
+    llvm::Value* count = argument++;
+    llvm::Value* constant = argument++;
+    auto* entry = llvm::BasicBlock::Create(context, "entry", function);
+    auto* loop = llvm::BasicBlock::Create(context, "loop", function);
+    auto* body = llvm::BasicBlock::Create(context, "body", function);
+    auto* exit = llvm::BasicBlock::Create(context, "exit", function);
+    builder.SetInsertPoint(entry);
+    builder.CreateBr(loop);
+    builder.SetInsertPoint(loop);
+    auto* index = builder.CreatePHI(i64, 2, "index");
+    index->addIncoming(builder.getInt64(0), entry);
+    builder.CreateCondBr(builder.CreateICmpULT(index, count), body, exit);
+    builder.SetInsertPoint(body);
+    auto* input_ptr = builder.CreateGEP(i64, input, index);
+    auto* value = builder.CreateLoad(i64, input_ptr);
+    auto* compared = Comparison(builder, operation, value, constant);
+    auto* output_ptr = builder.CreateGEP(i8, output, index);
+    builder.CreateStore(builder.CreateZExt(compared, i8), output_ptr);
+    auto* next = builder.CreateAdd(index, builder.getInt64(1));
+    builder.CreateBr(loop);
+    index->addIncoming(next, body);
+    builder.SetInsertPoint(exit);
+    builder.CreateRetVoid();
+    return module;
+  };
+  auto impl = CreateImpl(build, "tinylamb_filter");
   if (!impl) return std::nullopt;
   impl->compile_ms = std::chrono::duration<double, std::milli>(
                          std::chrono::steady_clock::now() - begin)
@@ -158,43 +345,45 @@ std::optional<JitInt64Kernels> JitInt64Kernels::CompileProjection() {
 #else
   InitializeLlvm();
   const auto begin = std::chrono::steady_clock::now();
-  auto context = std::make_unique<llvm::LLVMContext>();
-  auto module = std::make_unique<llvm::Module>("tinylamb_project", *context);
-  llvm::IRBuilder<> builder(*context);
-  llvm::Type* i64 = builder.getInt64Ty();
-  auto* type = llvm::FunctionType::get(
-      builder.getVoidTy(),
-      {llvm::PointerType::getUnqual(*context),
-       llvm::PointerType::getUnqual(*context), i64, i64, i64}, false);
-  auto* function = llvm::Function::Create(
-      type, llvm::Function::ExternalLinkage, "tinylamb_project", *module);
-  auto argument = function->arg_begin();
-  llvm::Value* input = argument++;
-  llvm::Value* output = argument++;
-  llvm::Value* count = argument++;
-  llvm::Value* multiplier = argument++;
-  llvm::Value* addend = argument++;
-  auto* entry = llvm::BasicBlock::Create(*context, "entry", function);
-  auto* loop = llvm::BasicBlock::Create(*context, "loop", function);
-  auto* body = llvm::BasicBlock::Create(*context, "body", function);
-  auto* exit = llvm::BasicBlock::Create(*context, "exit", function);
-  builder.SetInsertPoint(entry);
-  builder.CreateBr(loop);
-  builder.SetInsertPoint(loop);
-  auto* index = builder.CreatePHI(i64, 2);
-  index->addIncoming(builder.getInt64(0), entry);
-  builder.CreateCondBr(builder.CreateICmpULT(index, count), body, exit);
-  builder.SetInsertPoint(body);
-  auto* value = builder.CreateLoad(i64, builder.CreateGEP(i64, input, index));
-  auto* projected = builder.CreateAdd(builder.CreateMul(value, multiplier), addend);
-  builder.CreateStore(projected, builder.CreateGEP(i64, output, index));
-  auto* next = builder.CreateAdd(index, builder.getInt64(1));
-  builder.CreateBr(loop);
-  index->addIncoming(next, body);
-  builder.SetInsertPoint(exit);
-  builder.CreateRetVoid();
-  auto impl = CreateImpl(std::move(module), std::move(context),
-                         "tinylamb_project");
+  auto build = [](llvm::LLVMContext& context) {
+    auto module = std::make_unique<llvm::Module>("tinylamb_project", context);
+    llvm::IRBuilder<> builder(context);
+    llvm::Type* i64 = builder.getInt64Ty();
+    auto* type = llvm::FunctionType::get(
+        builder.getVoidTy(),
+        {llvm::PointerType::getUnqual(context),
+         llvm::PointerType::getUnqual(context), i64, i64, i64}, false);
+    auto* function = llvm::Function::Create(
+        type, llvm::Function::ExternalLinkage, "tinylamb_project", *module);
+    auto argument = function->arg_begin();
+    llvm::Value* input = argument++;
+    llvm::Value* output = argument++;
+    llvm::Value* count = argument++;
+    llvm::Value* multiplier = argument++;
+    llvm::Value* addend = argument++;
+    auto* entry = llvm::BasicBlock::Create(context, "entry", function);
+    auto* loop = llvm::BasicBlock::Create(context, "loop", function);
+    auto* body = llvm::BasicBlock::Create(context, "body", function);
+    auto* exit = llvm::BasicBlock::Create(context, "exit", function);
+    builder.SetInsertPoint(entry);
+    builder.CreateBr(loop);
+    builder.SetInsertPoint(loop);
+    auto* index = builder.CreatePHI(i64, 2);
+    index->addIncoming(builder.getInt64(0), entry);
+    builder.CreateCondBr(builder.CreateICmpULT(index, count), body, exit);
+    builder.SetInsertPoint(body);
+    auto* value = builder.CreateLoad(i64, builder.CreateGEP(i64, input, index));
+    auto* projected =
+        builder.CreateAdd(builder.CreateMul(value, multiplier), addend);
+    builder.CreateStore(projected, builder.CreateGEP(i64, output, index));
+    auto* next = builder.CreateAdd(index, builder.getInt64(1));
+    builder.CreateBr(loop);
+    index->addIncoming(next, body);
+    builder.SetInsertPoint(exit);
+    builder.CreateRetVoid();
+    return module;
+  };
+  auto impl = CreateImpl(build, "tinylamb_project");
   if (!impl) return std::nullopt;
   impl->compile_ms = std::chrono::duration<double, std::milli>(
                          std::chrono::steady_clock::now() - begin).count();
@@ -208,39 +397,41 @@ std::optional<JitInt64Kernels> JitInt64Kernels::CompileSum() {
 #else
   InitializeLlvm();
   const auto begin = std::chrono::steady_clock::now();
-  auto context = std::make_unique<llvm::LLVMContext>();
-  auto module = std::make_unique<llvm::Module>("tinylamb_sum", *context);
-  llvm::IRBuilder<> builder(*context);
-  llvm::Type* i64 = builder.getInt64Ty();
-  auto* type = llvm::FunctionType::get(
-      i64, {llvm::PointerType::getUnqual(*context), i64}, false);
-  auto* function = llvm::Function::Create(
-      type, llvm::Function::ExternalLinkage, "tinylamb_sum", *module);
-  auto argument = function->arg_begin();
-  llvm::Value* input = argument++;
-  llvm::Value* count = argument++;
-  auto* entry = llvm::BasicBlock::Create(*context, "entry", function);
-  auto* loop = llvm::BasicBlock::Create(*context, "loop", function);
-  auto* body = llvm::BasicBlock::Create(*context, "body", function);
-  auto* exit = llvm::BasicBlock::Create(*context, "exit", function);
-  builder.SetInsertPoint(entry);
-  builder.CreateBr(loop);
-  builder.SetInsertPoint(loop);
-  auto* index = builder.CreatePHI(i64, 2);
-  auto* total = builder.CreatePHI(i64, 2);
-  index->addIncoming(builder.getInt64(0), entry);
-  total->addIncoming(builder.getInt64(0), entry);
-  builder.CreateCondBr(builder.CreateICmpULT(index, count), body, exit);
-  builder.SetInsertPoint(body);
-  auto* value = builder.CreateLoad(i64, builder.CreateGEP(i64, input, index));
-  auto* next_total = builder.CreateAdd(total, value);
-  auto* next = builder.CreateAdd(index, builder.getInt64(1));
-  builder.CreateBr(loop);
-  index->addIncoming(next, body);
-  total->addIncoming(next_total, body);
-  builder.SetInsertPoint(exit);
-  builder.CreateRet(total);
-  auto impl = CreateImpl(std::move(module), std::move(context), "tinylamb_sum");
+  auto build = [](llvm::LLVMContext& context) {
+    auto module = std::make_unique<llvm::Module>("tinylamb_sum", context);
+    llvm::IRBuilder<> builder(context);
+    llvm::Type* i64 = builder.getInt64Ty();
+    auto* type = llvm::FunctionType::get(
+        i64, {llvm::PointerType::getUnqual(context), i64}, false);
+    auto* function = llvm::Function::Create(
+        type, llvm::Function::ExternalLinkage, "tinylamb_sum", *module);
+    auto argument = function->arg_begin();
+    llvm::Value* input = argument++;
+    llvm::Value* count = argument++;
+    auto* entry = llvm::BasicBlock::Create(context, "entry", function);
+    auto* loop = llvm::BasicBlock::Create(context, "loop", function);
+    auto* body = llvm::BasicBlock::Create(context, "body", function);
+    auto* exit = llvm::BasicBlock::Create(context, "exit", function);
+    builder.SetInsertPoint(entry);
+    builder.CreateBr(loop);
+    builder.SetInsertPoint(loop);
+    auto* index = builder.CreatePHI(i64, 2);
+    auto* total = builder.CreatePHI(i64, 2);
+    index->addIncoming(builder.getInt64(0), entry);
+    total->addIncoming(builder.getInt64(0), entry);
+    builder.CreateCondBr(builder.CreateICmpULT(index, count), body, exit);
+    builder.SetInsertPoint(body);
+    auto* value = builder.CreateLoad(i64, builder.CreateGEP(i64, input, index));
+    auto* next_total = builder.CreateAdd(total, value);
+    auto* next = builder.CreateAdd(index, builder.getInt64(1));
+    builder.CreateBr(loop);
+    index->addIncoming(next, body);
+    total->addIncoming(next_total, body);
+    builder.SetInsertPoint(exit);
+    builder.CreateRet(total);
+    return module;
+  };
+  auto impl = CreateImpl(build, "tinylamb_sum");
   if (!impl) return std::nullopt;
   impl->compile_ms = std::chrono::duration<double, std::milli>(
                          std::chrono::steady_clock::now() - begin).count();
@@ -267,5 +458,21 @@ int64_t JitInt64Kernels::Sum(const int64_t* input, size_t count) const {
 double JitInt64Kernels::CompileMilliseconds() const {
   return impl_ ? impl_->compile_ms : 0.0;
 }
+bool JitInt64Kernels::LoadedFromCache() const {
+  return impl_ && impl_->loaded_from_cache;
+}
+
+std::filesystem::path JitInt64Kernels::CacheDirectory() {
+  std::scoped_lock lock(cache_directory_mu);
+  if (!cache_directory_override) {
+    cache_directory_override = CacheDirectoryFromEnv();
+  }
+  return *cache_directory_override;
+}
+
+void JitInt64Kernels::SetCacheDirectory(std::filesystem::path directory) {
+  std::scoped_lock lock(cache_directory_mu);
+  cache_directory_override = std::move(directory);
+}
 
 }  // namespace tinylamb
@@ -4,6 +4,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <optional>
 
@@ -11,6 +12,14 @@
 
 namespace tinylamb {
 
+// Compiled kernels are persisted through an ORC ObjectCache so that
+// one-statement CLI processes and warm benchmark runs skip codegen. Objects are
+// keyed by the kernel IR hash, target triple, host CPU and CPU features.
+//
+// Config: TINYLAMB_JIT_CACHE_DIR
+//   - unset, "" or "0": disabled
+//   - path: created as 0700; ignored unless owned by the current user and not
+//     writable by group/others. Unreadable or invalid objects are recompiled.
 class JitInt64Kernels {
  public:
   struct Impl;
@@ -33,6 +42,13 @@ class JitInt64Kernels {
                int64_t multiplier, int64_t addend) const;
   [[nodiscard]] int64_t Sum(const int64_t* input, size_t count) const;
   [[nodiscard]] double CompileMilliseconds() const;
+  // True when the object code came from the on-disk cache instead of codegen.
+  [[nodiscard]] bool LoadedFromCache() const;
+
+  // Empty path when the object cache is disabled.
+  static std::filesystem::path CacheDirectory();
+  // Test/benchmark helper: override the cache directory (empty = disabled).
+  static void SetCacheDirectory(std::filesystem::path directory);
 
  private:
   explicit JitInt64Kernels(std::unique_ptr<Impl> impl);
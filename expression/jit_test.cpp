@@ -1,7 +1,10 @@
 /** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
 #include "expression/jit.hpp"
 
+#include <filesystem>
+#include <fstream>
 #include <numeric>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -117,4 +120,72 @@ TEST(JitTest, WrongKernelUsageThrows) {
                std::logic_error);
 }
 
+TEST(JitTest, ObjectCacheServesSecondCompileFromDisk) {
+  const std::filesystem::path previous = JitInt64Kernels::CacheDirectory();
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() /
+      ("tinylamb-jit-cache-test-" +
+       std::to_string(reinterpret_cast<uintptr_t>(&previous)));
+  std::filesystem::remove_all(directory);
+  JitInt64Kernels::SetCacheDirectory(directory);
+
+  // Act -- the first compile populates the cache, the second reuses it.
+  auto cold = JitInt64Kernels::CompileFilter(BinaryOperation::kLessThan);
+  auto warm = JitInt64Kernels::CompileFilter(BinaryOperation::kLessThan);
+  auto other = JitInt64Kernels::CompileFilter(BinaryOperation::kGreaterThan);
+
+  // Assert -- only identical IR hits, and cached code behaves identically.
+  ASSERT_TRUE(cold);
+  ASSERT_TRUE(warm);
+  ASSERT_TRUE(other);
+  EXPECT_FALSE(cold->LoadedFromCache());
+  EXPECT_TRUE(warm->LoadedFromCache());
+  EXPECT_FALSE(other->LoadedFromCache());
+  std::vector<int64_t> input{-3, 0, 4, 9};
+  std::vector<uint8_t> selected(input.size());
+  warm->Filter(input.data(), selected.data(), input.size(), 4);
+  EXPECT_EQ(selected, (std::vector<uint8_t>{1, 1, 0, 0}));
+
+  JitInt64Kernels::SetCacheDirectory(previous);
+  std::filesystem::remove_all(directory);
+}
+
+TEST(JitTest, CorruptCachedObjectFallsBackToCodegen) {
+  const std::filesystem::path previous = JitInt64Kernels::CacheDirectory();
+  const std::filesystem::path directory =
+      std::filesystem::temp_directory_path() /
+      ("tinylamb-jit-corrupt-test-" +
+       std::to_string(reinterpret_cast<uintptr_t>(&previous)));
+  std::filesystem::remove_all(directory);
+  JitInt64Kernels::SetCacheDirectory(directory);
+  ASSERT_TRUE(JitInt64Kernels::CompileSum());
+  for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+    std::ofstream(entry.path(), std::ios::binary | std::ios::trunc)
+        << "not an object file";
+  }
+
+  // Act -- the planted object is rejected and the kernel is compiled again.
+  auto sum = JitInt64Kernels::CompileSum();
+
+  // Assert
+  ASSERT_TRUE(sum);
+  EXPECT_FALSE(sum->LoadedFromCache());
+  std::vector<int64_t> input{1, 2, 3};
+  EXPECT_EQ(sum->Sum(input.data(), input.size()), 6);
+
+  JitInt64Kernels::SetCacheDirectory(previous);
+  std::filesystem::remove_all(directory);
+}
+
+TEST(JitTest, EmptyCacheDirectoryDisablesObjectCache) {
+  const std::filesystem::path previous = JitInt64Kernels::CacheDirectory();
+  JitInt64Kernels::SetCacheDirectory({});
+  auto first = JitInt64Kernels::CompileSum();
+  auto second = JitInt64Kernels::CompileSum();
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_FALSE(second->LoadedFromCache());
+  JitInt64Kernels::SetCacheDirectory(previous);
+}
+
 }  // namespace tinylamb
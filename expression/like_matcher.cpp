@@ -0,0 +1,205 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "expression/like_matcher.hpp"
+
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "executor/data_chunk.hpp"
+
+namespace tinylamb {
+
+size_t FindSubstring(std::string_view haystack, std::string_view needle) {
+  const size_t length = needle.size();
+  if (length == 0) return 0;
+  if (haystack.size() < length) return std::string_view::npos;
+  const char* data = haystack.data();
+  if (length == 1) {
+    const void* hit = std::memchr(data, needle.front(), haystack.size());
+    return hit == nullptr ? std::string_view::npos
+                          : static_cast<size_t>(
+                                static_cast<const char*>(hit) - data);
+  }
+  const size_t candidates = haystack.size() - length + 1;
+  size_t position = 0;
+#if defined(__SSE2__)
+  const __m128i first = _mm_set1_epi8(needle.front());
+  const __m128i last = _mm_set1_epi8(needle.back());
+  for (; position + 16 <= candidates; position += 16) {
+    const __m128i head = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + position));
+    const __m128i tail = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(data + position + length - 1));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last))));
+    while (mask != 0) {
+      const size_t offset = position + std::countr_zero(mask);
+      if (std::memcmp(data + offset + 1, needle.data() + 1, length - 2) == 0) {
+        return offset;
+      }
+      mask &= mask - 1;
+    }
+  }
+#endif
+  while (position < candidates) {
+    const void* hit =
+        std::memchr(data + position, needle.front(), candidates - position);
+    if (hit == nullptr) return std::string_view::npos;
+    position = static_cast<size_t>(static_cast<const char*>(hit) - data);
+    if (std::memcmp(data + position + 1, needle.data() + 1, length - 1) == 0) {
+      return position;
+    }
+    ++position;
+  }
+  return std::string_view::npos;
+}
+
+LikeMatcher::LikeMatcher(std::string_view pattern) : pattern_(pattern) {
+  if (pattern.find('_') != std::string_view::npos) {
+    shape_ = Shape::kGeneric;
+    return;
+  }
+  const size_t first_wildcard = pattern.find('%');
+  if (first_wildcard == std::string_view::npos) {
+    shape_ = Shape::kExact;
+    prefix_ = pattern;
+    return;
+  }
+  const size_t last_wildcard = pattern.rfind('%');
+  prefix_ = pattern.substr(0, first_wildcard);
+  suffix_ = pattern.substr(last_wildcard + 1);
+  std::string_view middle =
+      pattern.substr(first_wildcard, last_wildcard - first_wildcard);
+  while (!middle.empty()) {
+    const size_t end = middle.find('%');
+    if (end != 0) segments_.emplace_back(middle.substr(0, end));
+    if (end == std::string_view::npos) break;
+    middle.remove_prefix(end + 1);
+  }
+  if (prefix_.empty() && suffix_.empty()) {
+    shape_ = segments_.empty()        ? Shape::kAny
+             : segments_.size() == 1 ? Shape::kContains
+                                     : Shape::kSegments;
+  } else if (segments_.empty() && suffix_.empty()) {
+    shape_ = Shape::kPrefix;
+  } else if (segments_.empty() && prefix_.empty()) {
+    shape_ = Shape::kSuffix;
+  } else {
+    shape_ = Shape::kSegments;
+  }
+}
+
+bool LikeMatcher::Matches(std::string_view value) const {
+  switch (shape_) {
+    case Shape::kAny:
+      return true;
+    case Shape::kExact:
+      return value == prefix_;
+    case Shape::kPrefix:
+      return value.starts_with(prefix_);
+    case Shape::kSuffix:
+      return value.ends_with(suffix_);
+    case Shape::kContains:
+      return FindSubstring(value, segments_.front()) != std::string_view::npos;
+    case Shape::kSegments:
+      return MatchSegments(value);
+    case Shape::kGeneric:
+      return MatchGeneric(value);
+  }
+  return false;
+}
+
+void LikeMatcher::MatchBatch(const ColumnVector& input,
+                             uint8_t* output) const {
+  if (input.Type() == ValueType::kNull) {
+    std::memset(output, 0, input.Size());
+    return;
+  }
+  if (input.Type() != ValueType::kVarChar) {
+    throw std::runtime_error("LIKE requires strings");
+  }
+  const std::vector<std::string>& strings = input.StringData();
+  // Dispatch on the shape once per batch so the per-row loop stays tight.
+  const auto run = [&](auto&& match) {
+    for (size_t i = 0; i < input.Size(); ++i) {
+      output[i] = !input.IsNull(i) && match(std::string_view(strings[i]));
+    }
+  };
+  switch (shape_) {
+    case Shape::kAny:
+      run([](std::string_view) { return true; });
+      return;
+    case Shape::kExact:
+      run([&](std::string_view value) { return value == prefix_; });
+      return;
+    case Shape::kPrefix:
+      run([&](std::string_view value) { return value.starts_with(prefix_); });
+      return;
+    case Shape::kSuffix:
+      run([&](std::string_view value) { return value.ends_with(suffix_); });
+      return;
+    case Shape::kContains: {
+      const std::string_view needle = segments_.front();
+      run([&](std::string_view value) {
+        return FindSubstring(value, needle) != std::string_view::npos;
+      });
+      return;
+    }
+    case Shape::kSegments:
+      run([&](std::string_view value) { return MatchSegments(value); });
+      return;
+    case Shape::kGeneric:
+      run([&](std::string_view value) { return MatchGeneric(value); });
+      return;
+  }
+}
+
+bool LikeMatcher::MatchSegments(std::string_view value) const {
+  if (value.size() < prefix_.size() + suffix_.size() ||
+      !value.starts_with(prefix_) || !value.ends_with(suffix_)) {
+    return false;
+  }
+  std::string_view window = value.substr(
+      prefix_.size(), value.size() - prefix_.size() - suffix_.size());
+  // Leftmost matches are always safe for literal segments separated by '%'.
+  for (const std::string& segment : segments_) {
+    const size_t found = FindSubstring(window, segment);
+    if (found == std::string_view::npos) return false;
+    window.remove_prefix(found + segment.size());
+  }
+  return true;
+}
+
+bool LikeMatcher::MatchGeneric(std::string_view value) const {
+  const std::string_view pattern = pattern_;
+  size_t value_pos = 0;
+  size_t pattern_pos = 0;
+  size_t wildcard = std::string_view::npos;
+  size_t retry = 0;
+  while (value_pos < value.size()) {
+    if (pattern_pos < pattern.size() &&
+        (pattern[pattern_pos] == '_' ||
+         pattern[pattern_pos] == value[value_pos])) {
+      ++value_pos;
+      ++pattern_pos;
+    } else if (pattern_pos < pattern.size() && pattern[pattern_pos] == '%') {
+      wildcard = pattern_pos++;
+      retry = value_pos;
+    } else if (wildcard != std::string_view::npos) {
+      pattern_pos = wildcard + 1;
+      value_pos = ++retry;
+    } else {
+      return false;
+    }
+  }
+  while (pattern_pos < pattern.size() && pattern[pattern_pos] == '%') {
+    ++pattern_pos;
+  }
+  return pattern_pos == pattern.size();
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,59 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_EXPRESSION_LIKE_MATCHER_HPP
+#define TINYLAMB_EXPRESSION_LIKE_MATCHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tinylamb {
+
+class ColumnVector;
+
+// Leftmost occurrence of `needle` in `haystack`, or npos. Candidate positions
+// are found 16 bytes at a time by matching the first and last needle byte
+// (SSE2), then verified with memcmp; other targets fall back to memchr.
+[[nodiscard]] size_t FindSubstring(std::string_view haystack,
+                                   std::string_view needle);
+
+// A LIKE pattern parsed once into a specialized matcher. Patterns made only of
+// literals and '%' are split into an anchored prefix, anchored suffix and
+// unanchored middle segments that are searched left to right; patterns using
+// '_' keep the generic backtracking matcher.
+class LikeMatcher {
+ public:
+  enum class Shape : uint8_t {
+    kAny,       // '%'
+    kExact,     // 'abc'
+    kPrefix,    // 'abc%'
+    kSuffix,    // '%abc'
+    kContains,  // '%abc%'
+    kSegments,  // 'a%b%c', '%special%requests%'
+    kGeneric,   // anything using '_'
+  };
+
+  explicit LikeMatcher(std::string_view pattern);
+
+  [[nodiscard]] bool Matches(std::string_view value) const;
+  // Evaluates every row of a VARCHAR vector; NULL rows produce 0.
+  void MatchBatch(const ColumnVector& input, uint8_t* output) const;
+
+  [[nodiscard]] Shape GetShape() const { return shape_; }
+  [[nodiscard]] const std::string& Pattern() const { return pattern_; }
+
+ private:
+  [[nodiscard]] bool MatchSegments(std::string_view value) const;
+  [[nodiscard]] bool MatchGeneric(std::string_view value) const;
+
+  std::string pattern_;
+  Shape shape_{Shape::kGeneric};
+  std::string prefix_;
+  std::string suffix_;
+  std::vector<std::string> segments_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_EXPRESSION_LIKE_MATCHER_HPP
@@ -0,0 +1,72 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "expression/like_matcher.hpp"
+
+#include <string>
+#include <vector>
+
+#include "executor/data_chunk.hpp"
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+
+TEST(LikeMatcherTest, ClassifiesPatternShapes) {
+  EXPECT_EQ(LikeMatcher("%").GetShape(), LikeMatcher::Shape::kAny);
+  EXPECT_EQ(LikeMatcher("%%").GetShape(), LikeMatcher::Shape::kAny);
+  EXPECT_EQ(LikeMatcher("abc").GetShape(), LikeMatcher::Shape::kExact);
+  EXPECT_EQ(LikeMatcher("abc%").GetShape(), LikeMatcher::Shape::kPrefix);
+  EXPECT_EQ(LikeMatcher("%abc").GetShape(), LikeMatcher::Shape::kSuffix);
+  EXPECT_EQ(LikeMatcher("%abc%").GetShape(), LikeMatcher::Shape::kContains);
+  EXPECT_EQ(LikeMatcher("%special%requests%").GetShape(),
+            LikeMatcher::Shape::kSegments);
+  EXPECT_EQ(LikeMatcher("a%c").GetShape(), LikeMatcher::Shape::kSegments);
+  EXPECT_EQ(LikeMatcher("a_c%").GetShape(), LikeMatcher::Shape::kGeneric);
+}
+
+TEST(LikeMatcherTest, MatchesLikeSemantics) {
+  const std::vector<std::string> patterns = {
+      "%",   "",      "abc",   "abc%",  "%abc",    "%abc%", "a%c",
+      "a%%c", "%b%b%", "ab%ba", "a_c",  "%a_c%",   "_%_",   "%aa%aa%"};
+  const std::vector<std::string> values = {
+      "", "a", "abc", "abcabc", "xabcx", "ac", "aac", "abba", "aba", "aaaa",
+      "aaaaa", "bb", "abxba"};
+  for (const std::string& pattern : patterns) {
+    const LikeMatcher matcher(pattern);
+    const LikeMatcher reference("_" + pattern);  // forces kGeneric
+    for (const std::string& value : values) {
+      EXPECT_EQ(matcher.Matches(value), reference.Matches("x" + value))
+          << "'" << value << "' LIKE '" << pattern << "'";
+    }
+  }
+  EXPECT_FALSE(LikeMatcher("ab%ba").Matches("aba"));
+  EXPECT_TRUE(LikeMatcher("%special%requests%")
+                  .Matches("carefully special pending requests"));
+  EXPECT_FALSE(LikeMatcher("%special%requests%")
+                   .Matches("requests are special"));
+}
+
+TEST(LikeMatcherTest, FindSubstringAcrossVectorBoundaries) {
+  std::string haystack(100, 'a');
+  haystack.replace(37, 3, "xyz");
+  EXPECT_EQ(FindSubstring(haystack, "xyz"), 37U);
+  EXPECT_EQ(FindSubstring(haystack, "ax"), 36U);
+  EXPECT_EQ(FindSubstring(haystack, "zz"), std::string_view::npos);
+  EXPECT_EQ(FindSubstring(haystack, "a"), 0U);
+  EXPECT_EQ(FindSubstring(haystack, ""), 0U);
+  haystack.back() = 'q';
+  EXPECT_EQ(FindSubstring(haystack, "aq"), 98U);
+  EXPECT_EQ(FindSubstring("short", "shorter"), std::string_view::npos);
+}
+
+TEST(LikeMatcherTest, MatchBatchTreatsNullAsNoMatch) {
+  ColumnVector input(ValueType::kVarChar);
+  input.Append(Value("special requests"));
+  input.Append(Value());
+  input.Append(Value("requests special"));
+  uint8_t output[3] = {9, 9, 9};
+  LikeMatcher("%special%requests%").MatchBatch(input, output);
+  EXPECT_EQ(output[0], 1);
+  EXPECT_EQ(output[1], 0);
+  EXPECT_EQ(output[2], 0);
+}
+
+}  // namespace tinylamb
@@ -449,4 +449,13 @@ bool ReferencesOnly(const Expression& expression,
   return true;
 }
 
+bool ContainsAggregate(const Expression& expression) {
+  if (!expression) return false;
+  if (expression->Type() == TypeTag::kAggregateExp) return true;
+  for (const Expression& child : ExpressionChildren(expression)) {
+    if (ContainsAggregate(child)) return true;
+  }
+  return false;
+}
+
 }  // namespace tinylamb
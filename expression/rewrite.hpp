@@ -130,6 +130,8 @@ class ExpressionRewriter {
 [[nodiscard]] bool ReferencesOnly(
     const Expression& expression,
     const std::unordered_set<std::string>& relation_names);
+// Whether an aggregate call occurs in `expression`, outside subquery bodies.
+[[nodiscard]] bool ContainsAggregate(const Expression& expression);
 
 }  // namespace tinylamb
 
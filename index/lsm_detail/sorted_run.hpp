@@ -64,13 +64,13 @@ struct LSMValue {
 };
 
 class SortedRun {
+ public:
   static std::string HeadString(uint32_t in) {
     std::string out(4, 0);
     *(reinterpret_cast<uint32_t*>(out.data())) = be32toh(in);
     return out;
   }
 
- public:
   struct Entry {
     constexpr static size_t kIndirectThreshold = 12;
     Entry() = default;
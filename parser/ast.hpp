@@ -17,7 +17,9 @@
 #ifndef TINYLAMB_AST_HPP
 #define TINYLAMB_AST_HPP
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <unordered_map>
@@ -31,7 +33,21 @@ namespace tinylamb {
 
 class SelectStatement;
 
-enum class JoinType { kCross, kInner, kLeft };
+// kSemi, kAnti and kAntiNullAware never come from SQL text: the decorrelation
+// rewrite attaches EXISTS, NOT EXISTS and NOT IN subqueries as such sources.
+// They only filter the rows of the other sources and add no columns.
+enum class JoinType { kCross, kInner, kLeft, kSemi, kAnti, kAntiNullAware };
+
+// TABLESAMPLE on a base table source. SYSTEM keeps whole pages, BERNOULLI
+// keeps single rows, each with probability `fraction`.
+struct TableSample {
+  enum class Method { kSystem, kBernoulli };
+  Method method{Method::kSystem};
+  // In (0, 1]: the percentage written in SQL divided by 100.
+  double fraction{1.0};
+  // REPEATABLE (seed); without one every execution draws a new sample.
+  std::optional<uint64_t> seed;
+};
 
 struct SelectSource {
   std::string table;
@@ -39,6 +55,7 @@ struct SelectSource {
   std::shared_ptr<SelectStatement> query;
   JoinType join_type{JoinType::kCross};
   Expression join_condition;
+  std::optional<TableSample> sample;
 };
 
 enum class StatementType {
@@ -49,6 +66,8 @@ enum class StatementType {
   kUpdate,
   kDelete,
   kAnalyze,
+  kCreateMaterializedView,
+  kDropMaterializedView,
 };
 
 inline std::string StatementTypeName(StatementType t) {
@@ -67,6 +86,10 @@ inline std::string StatementTypeName(StatementType t) {
       return "Delete";
     case StatementType::kAnalyze:
       return "Analyze";
+    case StatementType::kCreateMaterializedView:
+      return "CreateMaterializedView";
+    case StatementType::kDropMaterializedView:
+      return "DropMaterializedView";
   }
   return "Unknown";
 }
@@ -146,7 +169,8 @@ class SelectStatement : public Statement {
         distinct_(distinct) {
     for (const std::string& table : from_clause_) {
       sources_.push_back(
-          SelectSource{table, table, nullptr, JoinType::kCross, nullptr});
+          SelectSource{table, table, nullptr, JoinType::kCross, nullptr,
+                       std::nullopt});
     }
   }
 
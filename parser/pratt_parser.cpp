@@ -186,7 +186,8 @@ Expression PrattParser::ParsePrimary() {
       std::transform(upper_name.begin(), upper_name.end(), upper_name.begin(),
                      ::toupper);
       if (upper_name == "COUNT" || upper_name == "SUM" || upper_name == "AVG" ||
-          upper_name == "MIN" || upper_name == "MAX") {
+          upper_name == "MIN" || upper_name == "MAX" ||
+          upper_name == "APPROX_COUNT_DISTINCT") {
         if (args.size() != 1) {
           throw std::runtime_error("aggregate function requires one argument");
         }
@@ -195,6 +196,9 @@ Expression PrattParser::ParsePrimary() {
         if (upper_name == "AVG") type = AggregationType::kAvg;
         if (upper_name == "MIN") type = AggregationType::kMin;
         if (upper_name == "MAX") type = AggregationType::kMax;
+        if (upper_name == "APPROX_COUNT_DISTINCT") {
+          type = AggregationType::kApproxCountDistinct;
+        }
         return AggregateExpressionExp(type, args[0], distinct);
       }
       return FunctionCallExp(func_name, std::move(args));
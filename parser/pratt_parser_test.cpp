@@ -317,6 +317,10 @@ TEST(ExpressionParserTest, AggregateFunctions) {
   ASSERT_EQ(sum->AsAggregateExpression().GetType(), AggregationType::kSum);
   ASSERT_EQ(sum->AsAggregateExpression().Child()->ToString(), "a");
   ASSERT_FALSE(sum->AsAggregateExpression().Distinct());
+  ASSERT_EQ(ParseExpressionString("APPROX_COUNT_DISTINCT(a)")
+                ->AsAggregateExpression()
+                .GetType(),
+            AggregationType::kApproxCountDistinct);
 }
 
 TEST(ExpressionParserTest, AggregateCountStar) {
@@ -77,6 +77,8 @@ Schema AggregationPlan::GenerateSchema() const {
     if (expression.GetType() == AggregationType::kAvg) {
       type = ValueType::kDouble;
     } else if (expression.GetType() != AggregationType::kCount &&
+               expression.GetType() !=
+                   AggregationType::kApproxCountDistinct &&
                expression.Child()->Type() == TypeTag::kColumnValue) {
       const int offset = child_->GetSchema().Offset(
           expression.Child()->AsColumnValue().GetColumnName());
@@ -51,6 +51,15 @@ Value FirstOrNull(const std::vector<Value>& keys) {
   return keys.empty() ? Value() : keys.front();
 }
 
+// Statistics of the rows between the keys; an unbounded scan reads them all.
+TableStatistics RangeStats(const TableStatistics& ts, const Index& index,
+                           const std::vector<Value>& begin_key,
+                           const std::vector<Value>& end_key) {
+  if (begin_key.empty() && end_key.empty()) return ts;
+  return ts.TransformBy(index.sc_.key_[0], FirstOrNull(begin_key),
+                        FirstOrNull(end_key));
+}
+
 }  // namespace
 
 IndexOnlyScanPlan::IndexOnlyScanPlan(const Table& table, const Index& index,
@@ -61,8 +70,7 @@ IndexOnlyScanPlan::IndexOnlyScanPlan(const Table& table, const Index& index,
                                      std::vector<ColumnName> provided_order)
     : table_(table),
       index_(index),
-      stats_(ts.TransformBy(index.sc_.key_[0], FirstOrNull(begin_key),
-                            FirstOrNull(end_key))),
+      stats_(RangeStats(ts, index, begin_key, end_key)),
       begin_key_(std::move(begin_key)),
       end_key_(std::move(end_key)),
       ascending_(ascending),
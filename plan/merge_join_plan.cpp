@@ -0,0 +1,136 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "plan/merge_join_plan.hpp"
+
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+#include "common/constants.hpp"
+#include "database/transaction_context.hpp"
+#include "executor/hash_join.hpp"
+#include "executor/merge_join.hpp"
+#include "expression/column_value.hpp"
+
+namespace tinylamb {
+namespace {
+
+bool SameColumn(const ColumnName& wanted, const ColumnName& column) {
+  return wanted.name == column.name &&
+         (wanted.schema.empty() || wanted.schema == column.schema);
+}
+
+std::vector<slot_t> Offsets(const Schema& schema,
+                            const std::vector<ColumnName>& columns) {
+  std::vector<slot_t> offsets;
+  offsets.reserve(columns.size());
+  for (const ColumnName& column : columns) {
+    offsets.push_back(static_cast<slot_t>(schema.Offset(column)));
+  }
+  return offsets;
+}
+
+std::vector<Expression> ColumnExpressions(
+    const std::vector<ColumnName>& columns) {
+  std::vector<Expression> expressions;
+  expressions.reserve(columns.size());
+  for (const ColumnName& column : columns) {
+    expressions.push_back(ColumnValueExp(column));
+  }
+  return expressions;
+}
+
+}  // namespace
+
+MergeJoinPlan::MergeJoinPlan(Plan left_src, std::vector<ColumnName> left_cols,
+                             Plan right_src,
+                             std::vector<ColumnName> right_cols)
+    : left_src_(std::move(left_src)),
+      right_src_(std::move(right_src)),
+      left_cols_(std::move(left_cols)),
+      right_cols_(std::move(right_cols)),
+      output_schema_(left_src_->GetSchema() + right_src_->GetSchema()),
+      stats_(left_src_->GetStats().ScaleToRows(EmitRowCount())) {
+  stats_.Concat(right_src_->GetStats().ScaleToRows(EmitRowCount()));
+}
+
+bool MergeJoinPlan::InputsOrdered(const Plan& left,
+                                  const std::vector<ColumnName>& left_cols,
+                                  const Plan& right,
+                                  const std::vector<ColumnName>& right_cols) {
+  const std::vector<bool> ascending(left_cols.size(), true);
+  return !left_cols.empty() &&
+         left->IsOrderedBy(ColumnExpressions(left_cols), ascending) &&
+         right->IsOrderedBy(ColumnExpressions(right_cols), ascending);
+}
+
+Executor MergeJoinPlan::EmitExecutor(TransactionContext& ctx) const {
+  std::vector<slot_t> left = Offsets(left_src_->GetSchema(), left_cols_);
+  std::vector<slot_t> right = Offsets(right_src_->GetSchema(), right_cols_);
+  if (ctx.txn_.IndexKeysMayBeStale()) {
+    // Index scans fall back to unordered full scans here.
+    return std::make_shared<HashJoin>(left_src_->EmitExecutor(ctx),
+                                      std::move(left),
+                                      right_src_->EmitExecutor(ctx),
+                                      std::move(right));
+  }
+  return std::make_shared<MergeJoin>(left_src_->EmitExecutor(ctx),
+                                     std::move(left),
+                                     right_src_->EmitExecutor(ctx),
+                                     std::move(right));
+}
+
+size_t MergeJoinPlan::AccessRowCount() const {
+  // One pass over each input and no build side.
+  return left_src_->AccessRowCount() + right_src_->AccessRowCount();
+}
+
+size_t MergeJoinPlan::EmitRowCount() const {
+  return std::min(left_src_->EmitRowCount(), right_src_->EmitRowCount());
+}
+
+bool MergeJoinPlan::IsOrderedBy(const std::vector<Expression>& expressions,
+                                const std::vector<bool>& ascending) const {
+  // Output follows the left input, and a right join column equals its left
+  // partner on every emitted row.
+  std::vector<Expression> on_left;
+  on_left.reserve(expressions.size());
+  for (const Expression& expression : expressions) {
+    Expression translated = expression;
+    if (expression->Type() == TypeTag::kColumnValue) {
+      const ColumnName& column = expression->AsColumnValue().GetColumnName();
+      for (size_t i = 0; i < right_cols_.size(); ++i) {
+        if (SameColumn(column, right_cols_[i])) {
+          translated = ColumnValueExp(left_cols_[i]);
+          break;
+        }
+      }
+    }
+    on_left.push_back(std::move(translated));
+  }
+  return left_src_->IsOrderedBy(on_left, ascending);
+}
+
+void MergeJoinPlan::Dump(std::ostream& o, int indent) const {
+  o << ToString();
+  o << "\n" << Indent(indent + 2);
+  left_src_->Dump(o, indent + 2);
+  o << "\n" << Indent(indent + 2);
+  right_src_->Dump(o, indent + 2);
+}
+
+std::string MergeJoinPlan::ToString() const {
+  std::string s = "Product: Merge Join left:{";
+  for (size_t i = 0; i < left_cols_.size(); ++i) {
+    if (0 < i) s += ", ";
+    s += left_cols_[i].ToString();
+  }
+  s += "} right:{";
+  for (size_t i = 0; i < right_cols_.size(); ++i) {
+    if (0 < i) s += ", ";
+    s += right_cols_[i].ToString();
+  }
+  s += "}  (estimated cost: " + std::to_string(EmitRowCount()) + ")";
+  return s;
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,62 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_MERGE_JOIN_PLAN_HPP
+#define TINYLAMB_MERGE_JOIN_PLAN_HPP
+
+#include <string>
+#include <vector>
+
+#include "plan/plan.hpp"
+#include "table/table_statistics.hpp"
+#include "type/column_name.hpp"
+#include "type/schema.hpp"
+
+namespace tinylamb {
+
+// Inner equi-join of two plans that are both ordered ascending on their join
+// columns. Emits a MergeJoin, which keeps the order of `left_src`.
+class MergeJoinPlan final : public PlanBase {
+ public:
+  MergeJoinPlan(Plan left_src, std::vector<ColumnName> left_cols,
+                Plan right_src, std::vector<ColumnName> right_cols);
+  MergeJoinPlan(const MergeJoinPlan&) = delete;
+  MergeJoinPlan(MergeJoinPlan&&) = delete;
+  MergeJoinPlan& operator=(const MergeJoinPlan&) = delete;
+  MergeJoinPlan& operator=(MergeJoinPlan&&) = delete;
+  ~MergeJoinPlan() override = default;
+
+  Executor EmitExecutor(TransactionContext& ctx) const override;
+
+  [[nodiscard]] const Table* ScanSource() const override { return nullptr; }
+  [[nodiscard]] const Schema& GetSchema() const override {
+    return output_schema_;
+  }
+  [[nodiscard]] const TableStatistics& GetStats() const override {
+    return stats_;
+  }
+
+  [[nodiscard]] size_t AccessRowCount() const override;
+  [[nodiscard]] size_t EmitRowCount() const override;
+  [[nodiscard]] bool IsOrderedBy(
+      const std::vector<Expression>& expressions,
+      const std::vector<bool>& ascending) const override;
+  void Dump(std::ostream& o, int indent) const override;
+  [[nodiscard]] std::string ToString() const override;
+
+  // Whether both inputs deliver rows in ascending join-key order, which is
+  // what a merge join needs.
+  [[nodiscard]] static bool InputsOrdered(
+      const Plan& left, const std::vector<ColumnName>& left_cols,
+      const Plan& right, const std::vector<ColumnName>& right_cols);
+
+ private:
+  Plan left_src_;
+  Plan right_src_;
+  std::vector<ColumnName> left_cols_;
+  std::vector<ColumnName> right_cols_;
+  Schema output_schema_;
+  TableStatistics stats_;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_MERGE_JOIN_PLAN_HPP
@@ -41,6 +41,7 @@
 #include "index_scan_plan.hpp"
 #include "plan/cascades.hpp"
 #include "plan/plan.hpp"
+#include "plan/merge_join_plan.hpp"
 #include "product_plan.hpp"
 #include "projection_plan.hpp"
 #include "query/query_data.hpp"
@@ -140,18 +141,11 @@ Plan BuildIndexScan(const Table& table, const Index& index,
       ascending, predicate, std::move(provided_order));
 }
 
-std::vector<Plan> ScanCandidates(const std::vector<NamedExpression>& select,
-                                 const Table& table,
-                                 const Expression& predicate,
-                                 const TableStatistics& statistics,
-                                 bool require_row_position,
-                                 bool include_indexes, bool include_full_scan,
-                                 [[maybe_unused]] const std::vector<Expression>&
-                                     order_expressions,
-                                 [[maybe_unused]] const std::vector<bool>&
-                                     order_ascending) {
-  const Schema& schema = table.GetSchema();
-  std::unordered_map<slot_t, Range> ranges;
+// Column-versus-constant comparisons of `predicate` on `schema`, recording
+// the range each one implies for its column.
+std::vector<Expression> CollectRanges(
+    const Expression& predicate, const Schema& schema,
+    std::unordered_map<slot_t, Range>* ranges) {
   std::vector<Expression> range_predicates;
   for (const Expression& conjunct : SplitConjuncts(predicate)) {
     if (conjunct->Type() != TypeTag::kBinaryExp) continue;
@@ -174,10 +168,27 @@ std::vector<Plan> ScanCandidates(const std::vector<NamedExpression>& select,
     if (!column || !constant) continue;
     const int offset = schema.Offset(column->GetColumnName());
     if (offset < 0) continue;
-    ranges[static_cast<slot_t>(offset)].Update(binary.Op(),
-                                               constant->GetValue(), direction);
+    (*ranges)[static_cast<slot_t>(offset)].Update(
+        binary.Op(), constant->GetValue(), direction);
     range_predicates.push_back(conjunct);
   }
+  return range_predicates;
+}
+
+std::vector<Plan> ScanCandidates(const std::vector<NamedExpression>& select,
+                                 const Table& table,
+                                 const Expression& predicate,
+                                 const TableStatistics& statistics,
+                                 bool require_row_position,
+                                 bool include_indexes, bool include_full_scan,
+                                 [[maybe_unused]] const std::vector<Expression>&
+                                     order_expressions,
+                                 [[maybe_unused]] const std::vector<bool>&
+                                     order_ascending) {
+  const Schema& schema = table.GetSchema();
+  std::unordered_map<slot_t, Range> ranges;
+  const std::vector<Expression> range_predicates =
+      CollectRanges(predicate, schema, &ranges);
 
   const Expression pushed_predicate = CombineConjuncts(range_predicates);
   std::vector<Plan> candidates;
@@ -260,10 +271,47 @@ std::vector<Plan> ScanCandidates(const std::vector<NamedExpression>& select,
   return candidates;
 }
 
-std::vector<Plan> JoinCandidates(TransactionContext& context,
-                                 const Expression& predicate, const Plan& left,
-                                 const Plan& right, bool include_hash,
-                                 bool include_index, bool include_cross) {
+// Scans of every index whose leading key column is `column`, over the whole
+// key range so that rows arrive in ascending `column` order for a merge join.
+// The column-versus-constant comparisons of `predicate` are applied on top.
+std::vector<Plan> OrderedScanCandidates(
+    const std::vector<NamedExpression>& select, const Table& table,
+    const Expression& predicate, const TableStatistics& statistics,
+    bool require_row_position, const ColumnName& column) {
+  const Schema& schema = table.GetSchema();
+  const int column_offset = schema.Offset(column);
+  if (column_offset < 0) return {};
+  std::unordered_map<slot_t, Range> ranges;
+  const std::vector<Expression> range_predicates =
+      CollectRanges(predicate, schema, &ranges);
+  const Expression pushed_predicate = CombineConjuncts(range_predicates);
+  std::vector<Plan> candidates;
+  for (size_t index_offset = 0; index_offset < table.IndexCount();
+       ++index_offset) {
+    const Index& index = table.GetIndex(index_offset);
+    if (index.sc_.key_.front() != static_cast<slot_t>(column_offset)) continue;
+    std::vector<ColumnName> provided_order;
+    for (const slot_t key : index.sc_.key_) {
+      provided_order.push_back(schema.GetColumn(key).Name());
+    }
+    Plan candidate =
+        BuildIndexScan(table, index, statistics, {}, {}, true,
+                       pushed_predicate, select, require_row_position,
+                       std::move(provided_order));
+    if (!range_predicates.empty()) {
+      candidate = std::make_shared<SelectionPlan>(candidate, pushed_predicate,
+                                                  statistics);
+    }
+    if (select.size() != candidate->GetSchema().ColumnCount()) {
+      candidate = std::make_shared<ProjectionPlan>(candidate, select);
+    }
+    candidates.push_back(std::move(candidate));
+  }
+  return candidates;
+}
+
+std::vector<std::pair<ColumnName, ColumnName>> JoinEqualities(
+    const Expression& predicate, const Plan& left, const Plan& right) {
   std::vector<std::pair<ColumnName, ColumnName>> equalities;
   for (const Expression& conjunct : SplitConjuncts(predicate)) {
     if (conjunct->Type() != TypeTag::kBinaryExp) continue;
@@ -283,7 +331,15 @@ std::vector<Plan> JoinCandidates(TransactionContext& context,
       equalities.emplace_back(rhs, lhs);
     }
   }
+  return equalities;
+}
 
+std::vector<Plan> JoinCandidates(TransactionContext& context,
+                                 const Expression& predicate, const Plan& left,
+                                 const Plan& right, bool include_hash,
+                                 bool include_index, bool include_cross) {
+  const std::vector<std::pair<ColumnName, ColumnName>> equalities =
+      JoinEqualities(predicate, left, right);
   std::vector<Plan> candidates;
   if (include_cross) {
     candidates.push_back(std::make_shared<ProductPlan>(left, right));
@@ -298,12 +354,15 @@ std::vector<Plan> JoinCandidates(TransactionContext& context,
   }
 
   if (include_hash) {
-    // Offer both physical strategies; AccessRowCount penalizes in-memory when
-    // the estimated build footprint exceeds the query memory soft budget.
+    // Offer every physical strategy; AccessRowCount penalizes in-memory when
+    // the estimated build footprint exceeds the cache (radix wins) or the
+    // query memory soft budget (hybrid wins).
     candidates.push_back(std::make_shared<ProductPlan>(
         left, left_columns, right, right_columns, HashJoinMode::kInMemory));
     candidates.push_back(std::make_shared<ProductPlan>(
         left, left_columns, right, right_columns, HashJoinMode::kHybrid));
+    candidates.push_back(std::make_shared<ProductPlan>(
+        left, left_columns, right, right_columns, HashJoinMode::kRadix));
   }
 
   if (include_index) {
@@ -326,6 +385,44 @@ std::vector<Plan> JoinCandidates(TransactionContext& context,
   return candidates;
 }
 
+// Merge joins on the equalities of `predicate`. An input that is not already
+// ordered on its join column is replaced by `ordered_input(is_left, column)`
+// when that returns a plan. Keys beyond the merged ones are left to the
+// predicate the optimizer keeps above the joins.
+std::vector<Plan> MergeJoinCandidates(
+    const Expression& predicate, const Plan& left, const Plan& right,
+    const std::function<Plan(bool, const ColumnName&)>& ordered_input) {
+  const std::vector<std::pair<ColumnName, ColumnName>> equalities =
+      JoinEqualities(predicate, left, right);
+  std::vector<Plan> candidates;
+  std::vector<ColumnName> left_columns;
+  std::vector<ColumnName> right_columns;
+  for (const auto& [left_column, right_column] : equalities) {
+    left_columns.push_back(left_column);
+    right_columns.push_back(right_column);
+  }
+  if (1 < equalities.size() &&
+      MergeJoinPlan::InputsOrdered(left, left_columns, right, right_columns)) {
+    candidates.push_back(std::make_shared<MergeJoinPlan>(
+        left, left_columns, right, right_columns));
+  }
+  const auto ordered = [&](const Plan& plan, bool is_left,
+                           const ColumnName& column) -> Plan {
+    if (plan->IsOrderedBy({ColumnValueExp(column)}, {true})) return plan;
+    return ordered_input(is_left, column);
+  };
+  for (const auto& [left_column, right_column] : equalities) {
+    Plan ordered_left = ordered(left, true, left_column);
+    if (!ordered_left) continue;
+    Plan ordered_right = ordered(right, false, right_column);
+    if (!ordered_right) continue;
+    candidates.push_back(std::make_shared<MergeJoinPlan>(
+        std::move(ordered_left), std::vector<ColumnName>{left_column},
+        std::move(ordered_right), std::vector<ColumnName>{right_column}));
+  }
+  return candidates;
+}
+
 std::vector<NamedExpression> ExpandSelect(const QueryData& query,
                                           TransactionContext& context) {
   const bool has_star =
@@ -358,6 +455,9 @@ struct OptimizerImplementContext {
   std::function<std::vector<cascades::PlanAlternative>(
       const std::vector<cascades::BestPlan>&, bool, bool, bool)>
       join_alternatives;
+  std::function<std::vector<cascades::PlanAlternative>(
+      const std::vector<cascades::BestPlan>&)>
+      merge_join_alternatives;
 };
 
 thread_local OptimizerImplementContext* tls_implement = nullptr;
@@ -384,6 +484,15 @@ const cascades::ImplementationRuleSet& DefaultImplementationRules() {
           return tls_implement->scan_alternatives(logical, required, false,
                                                   true);
         }));
+    // Ahead of hash_join so that, at equal cost, inputs that are already in
+    // key order are merged rather than hashed.
+    built.Add(cascades::ImplementationRule(
+        "merge_join", Join(),
+        [](const cascades::Bindings&, const cascades::LogicalExpression&,
+           const std::vector<cascades::BestPlan>& children,
+           const cascades::PhysicalProperties&) {
+          return tls_implement->merge_join_alternatives(children);
+        }));
     built.Add(cascades::ImplementationRule(
         "hash_join", Join(),
         [](const cascades::Bindings&, const cascades::LogicalExpression&,
@@ -465,24 +574,28 @@ StatusOr<Plan> Optimizer::Optimize(const QueryData& query,
     }
     return result;
   };
+  const auto scan_projection = [&](const Table& table) {
+    std::vector<NamedExpression> projection;
+    for (size_t i = 0; i < table.GetSchema().ColumnCount(); ++i) {
+      const Column& table_column = table.GetSchema().GetColumn(i);
+      if (std::ranges::any_of(touched, [&](const ColumnName& column) {
+            return table_column.Name().name == column.name &&
+                   (column.schema.empty() ||
+                    column.schema == table.GetSchema().Name());
+          })) {
+        projection.emplace_back(table_column.Name());
+      }
+    }
+    return projection;
+  };
   const auto scan_alternatives =
       [&](const cascades::LogicalExpression& logical,
           const cascades::PhysicalProperties& required, bool indexes,
           bool full_scan) {
         const Table& table = *tables.at(logical.table);
-        std::vector<NamedExpression> projection;
-        for (size_t i = 0; i < table.GetSchema().ColumnCount(); ++i) {
-          const Column& table_column = table.GetSchema().GetColumn(i);
-          if (std::ranges::any_of(touched, [&](const ColumnName& column) {
-                return table_column.Name().name == column.name &&
-                       (column.schema.empty() ||
-                        column.schema == table.GetSchema().Name());
-              })) {
-            projection.emplace_back(table_column.Name());
-          }
-        }
         return to_alternatives(ScanCandidates(
-            projection, table, predicate, *statistics.at(logical.table),
+            scan_projection(table), table, predicate,
+            *statistics.at(logical.table),
             required.require_row_position, indexes, full_scan,
             query.order_expressions_, query.order_ascending_));
       };
@@ -496,10 +609,39 @@ StatusOr<Plan> Optimizer::Optimize(const QueryData& query,
             JoinCandidates(context, predicate, children[0].plan,
                            children[1].plan, hash, index, cross));
       };
+  const auto merge_join_alternatives =
+      [&](const std::vector<cascades::BestPlan>& children) {
+        if (children.size() != 2) {
+          return std::vector<cascades::PlanAlternative>{};
+        }
+        // A single-table input can be re-read through an index on its join
+        // column; the cheapest such scan is used.
+        const auto ordered_input = [&](bool is_left,
+                                       const ColumnName& column) -> Plan {
+          const cascades::Group& group =
+              search.GetMemo().Get(children[is_left ? 0 : 1].group);
+          if (group.relations.size() != 1) return nullptr;
+          const std::string& relation = group.relations.front();
+          const Table& table = *tables.at(relation);
+          Plan best;
+          for (Plan& candidate : OrderedScanCandidates(
+                   scan_projection(table), table, predicate,
+                   *statistics.at(relation), properties.require_row_position,
+                   column)) {
+            if (!best || candidate->AccessRowCount() < best->AccessRowCount()) {
+              best = std::move(candidate);
+            }
+          }
+          return best;
+        };
+        return to_alternatives(MergeJoinCandidates(
+            predicate, children[0].plan, children[1].plan, ordered_input));
+      };
 
   OptimizerImplementContext implement_context;
   implement_context.scan_alternatives = scan_alternatives;
   implement_context.join_alternatives = join_alternatives;
+  implement_context.merge_join_alternatives = merge_join_alternatives;
   tls_implement = &implement_context;
   struct TlsClear {
     ~TlsClear() { tls_implement = nullptr; }
@@ -16,10 +16,12 @@
 
 #include "plan/optimizer.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "common/constants.hpp"
 #include "common/random_string.hpp"
@@ -685,4 +687,52 @@ TEST_F(OptimizerTest, ExtraImplementationRuleIsRegistered) {
   EXPECT_FALSE(executor->Next(&row, nullptr));
   ASSERT_SUCCESS(context.PreCommit());
 }
+
+TEST_F(OptimizerTest, JoinOnIndexedKeysUsesMergeJoin) {
+  // Arrange: both Sc1.c1 and Sc2.d1 lead a unique index, so both inputs can
+  // arrive in join-key order.
+  QueryData query{
+      {"Sc1", "Sc2"},
+      BinaryExpressionExp(ColumnValueExp("c1"), BinaryOperation::kEquals,
+                          ColumnValueExp("d1")),
+      {NamedExpression("c1"), NamedExpression("d3")}};
+  TransactionContext context = rs_->BeginContext();
+  ASSERT_SUCCESS(query.Rewrite(context));
+  const auto run = [&](const Plan& plan) {
+    Executor executor = plan->EmitExecutor(context);
+    std::vector<Row> rows;
+    Row row;
+    while (executor->Next(&row, nullptr)) rows.push_back(row);
+    return rows;
+  };
+
+  // Act
+  ASSIGN_OR_ASSERT_FAIL(Plan, merge_plan, Optimizer::Optimize(query, context));
+  OptimizerOptions without_merge = OptimizerOptions::Default();
+  without_merge.disabled_implementation_rules.insert("merge_join");
+  ASSIGN_OR_ASSERT_FAIL(Plan, hash_plan,
+                        Optimizer::Optimize(query, context, without_merge));
+
+  // Assert: the merge join streams rows in key order and agrees with the
+  // hash join.
+  std::ostringstream merge_dump;
+  merge_dump << merge_plan;
+  EXPECT_NE(merge_dump.str().find("Merge Join"), std::string::npos)
+      << merge_dump.str();
+  std::ostringstream hash_dump;
+  hash_dump << hash_plan;
+  EXPECT_EQ(hash_dump.str().find("Merge Join"), std::string::npos);
+  const std::vector<Row> merged = run(merge_plan);
+  ASSERT_EQ(merged.size(), 100U);
+  for (size_t i = 0; i < merged.size(); ++i) {
+    EXPECT_EQ(merged[i], Row({Value(static_cast<int64_t>(i)),
+                              Value("d3-" + std::to_string(i % 10))}));
+  }
+  std::vector<Row> hashed = run(hash_plan);
+  std::ranges::sort(hashed, [](const Row& a, const Row& b) {
+    return a[0] < b[0];
+  });
+  EXPECT_EQ(hashed, merged);
+  ASSERT_SUCCESS(context.PreCommit());
+}
 }  // namespace tinylamb
@@ -482,6 +482,37 @@ TEST_F(PlanTest, ProductHybridHashJoinPreferredUnderTinyBudget) {
   QueryMemoryBudget::Global().ResetForTest(0);
 }
 
+TEST_F(PlanTest, ProductRadixHashJoinPreferredAboveCache) {
+  auto ctx = rs_->BeginContext();
+  ASSIGN_OR_ASSERT_FAIL(std::shared_ptr<Table>, tbl1, ctx.GetTable("Sc1"));
+  ASSIGN_OR_ASSERT_FAIL(std::shared_ptr<Table>, tbl2, ctx.GetTable("Sc2"));
+  TableStatistics left_ts((Schema()));
+  TableStatistics right_ts((Schema()));
+  left_ts = left_ts.ScaleToRows(10'000);
+  right_ts = right_ts.ScaleToRows(10'000);
+  auto left = std::make_shared<FullScanPlan>(*tbl1, left_ts);
+  auto right = std::make_shared<FullScanPlan>(*tbl2, right_ts);
+
+  // A 64 KiB "cache" is far below the ~1.2 MiB build estimate.
+  const size_t threshold = RadixJoinThresholdBytes();
+  SetRadixJoinThresholdForTest(64 * 1024);
+  Plan in_memory(new ProductPlan(left, {ColumnName("Sc1.c1")}, right,
+                                 {ColumnName("Sc2.d1")},
+                                 HashJoinMode::kInMemory));
+  Plan hybrid(new ProductPlan(left, {ColumnName("Sc1.c1")}, right,
+                              {ColumnName("Sc2.d1")}, HashJoinMode::kHybrid));
+  Plan radix(new ProductPlan(left, {ColumnName("Sc1.c1")}, right,
+                             {ColumnName("Sc2.d1")}, HashJoinMode::kRadix));
+  EXPECT_GT(in_memory->AccessRowCount(), radix->AccessRowCount());
+  EXPECT_GT(hybrid->AccessRowCount(), radix->AccessRowCount());
+  EXPECT_NE(radix->ToString().find("Radix Hash Join"), std::string::npos);
+
+  // Below the threshold the plain in-memory table stays cheapest.
+  SetRadixJoinThresholdForTest(0);
+  EXPECT_LT(in_memory->AccessRowCount(), radix->AccessRowCount());
+  SetRadixJoinThresholdForTest(threshold);
+}
+
 TEST_F(PlanTest, ProductIndexJoinAccessors) {
   // Arrange -- begin context, get Sc1 and Sc2 tables and the Sc2PK index
   auto ctx = rs_->BeginContext();
@@ -162,6 +162,14 @@ size_t ProductPlan::AccessRowCount() const {
   if (PreferHybridHashJoin(build_bytes)) {
     return base * 1000;
   }
+  if (hash_mode_ == HashJoinMode::kRadix) {
+    // Partitioning passes over both inputs (~1.25x scan cost).
+    return base + base / 4;
+  }
+  // A build table larger than the cache misses on nearly every probe.
+  if (PreferRadixHashJoin(build_bytes)) {
+    return base * 2;
+  }
   return base;
 }
 
@@ -185,6 +193,8 @@ void ProductPlan::Dump(std::ostream& o, int indent) const {
     o << "Index Join ";
   } else if (hash_mode_ == HashJoinMode::kHybrid) {
     o << "Hybrid Hash Join ";
+  } else if (hash_mode_ == HashJoinMode::kRadix) {
+    o << "Radix Hash Join ";
   } else {
     o << "Hash Join ";
   }
@@ -226,6 +236,8 @@ std::string ProductPlan::ToString() const {
     s += "Index Join ";
   } else if (hash_mode_ == HashJoinMode::kHybrid) {
     s += "Hybrid Hash Join ";
+  } else if (hash_mode_ == HashJoinMode::kRadix) {
+    s += "Radix Hash Join ";
   } else {
     s += "Hash Join ";
   }
@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -469,4 +470,39 @@ TEST(GoogleSqlAstTest, UnsupportedExpressionKindsThrow) {
   }
 }
 
+TEST(GoogleSqlAstTest, TableSampleClause) {
+  // The dump GoogleSQL prints for
+  //   SELECT a FROM t TABLESAMPLE BERNOULLI (2.5 PERCENT) REPEATABLE (7);
+  StatusOr<std::unique_ptr<GoogleSqlAstNode>> ast = GoogleSqlAstParser::Parse(
+      "QueryStatement [0-66]\n"
+      "  Query [0-66]\n"
+      "    Select [0-66]\n"
+      "      SelectList [7-8]\n"
+      "        SelectColumn [7-8]\n"
+      "          PathExpression [7-8]\n"
+      "            Identifier(a) [7-8]\n"
+      "      FromClause [9-66]\n"
+      "        TablePathExpression [14-66]\n"
+      "          PathExpression [14-15]\n"
+      "            Identifier(t) [14-15]\n"
+      "          SampleClause [16-66]\n"
+      "            Identifier(BERNOULLI) [28-37]\n"
+      "            SampleSize(PERCENT) [39-50]\n"
+      "              FloatLiteral(2.5) [39-42]\n"
+      "            SampleSuffix [52-66]\n"
+      "              RepeatableClause [52-66]\n"
+      "                IntLiteral(7) [64-65]\n");
+  ASSERT_TRUE(ast.HasValue());
+  std::unique_ptr<Statement> statement =
+      GoogleSqlAstVisitor::Visit(*ast.Value());
+  const auto& select = dynamic_cast<const SelectStatement&>(*statement);
+  EXPECT_TRUE(select.RequiresRelationalEvaluation());
+  ASSERT_EQ(select.Sources().size(), 1);
+  const std::optional<TableSample>& sample = select.Sources()[0].sample;
+  ASSERT_TRUE(sample);
+  EXPECT_EQ(sample->method, TableSample::Method::kBernoulli);
+  EXPECT_DOUBLE_EQ(sample->fraction, 0.025);
+  EXPECT_EQ(sample->seed, 7U);
+}
+
 }  // namespace tinylamb
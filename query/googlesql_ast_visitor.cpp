@@ -191,7 +191,7 @@ Expression VisitFunction(const GoogleSqlAstNode& node) {
     arguments.push_back(VisitExpression(*node.children[i]));
   }
   if (name == "count" || name == "sum" || name == "avg" || name == "min" ||
-      name == "max") {
+      name == "max" || name == "approx_count_distinct") {
     if (arguments.size() != 1) {
       throw std::runtime_error("GoogleSQL AST: aggregate arity");
     }
@@ -200,6 +200,9 @@ Expression VisitFunction(const GoogleSqlAstNode& node) {
     if (name == "avg") type = AggregationType::kAvg;
     if (name == "min") type = AggregationType::kMin;
     if (name == "max") type = AggregationType::kMax;
+    if (name == "approx_count_distinct") {
+      type = AggregationType::kApproxCountDistinct;
+    }
     return AggregateExpressionExp(
         type, std::move(arguments[0]),
         node.detail.find("distinct=true") != std::string::npos);
@@ -341,6 +344,53 @@ Expression VisitExpression(const GoogleSqlAstNode& node) {
                            node.kind);
 }
 
+// The first node of `kind` under `node`, searched depth first.
+const GoogleSqlAstNode* Descendant(const GoogleSqlAstNode& node,
+                                   std::string_view kind) {
+  for (const auto& child : node.children) {
+    if (child->kind == kind) return child.get();
+    if (const GoogleSqlAstNode* found = Descendant(*child, kind)) return found;
+  }
+  return nullptr;
+}
+
+// TABLESAMPLE SYSTEM | BERNOULLI (percent [PERCENT]) [REPEATABLE (seed)].
+TableSample VisitSampleClause(const GoogleSqlAstNode& node) {
+  TableSample sample;
+  const GoogleSqlAstNode* method = node.Child("Identifier");
+  if (!method) throw std::runtime_error("GoogleSQL AST: sample without method");
+  const std::string name = Lower(Identifier(*method));
+  if (name == "system") {
+    sample.method = TableSample::Method::kSystem;
+  } else if (name == "bernoulli") {
+    sample.method = TableSample::Method::kBernoulli;
+  } else {
+    throw std::runtime_error("unsupported TABLESAMPLE method " + name);
+  }
+  const GoogleSqlAstNode* size = node.Child("SampleSize");
+  if (!size || size->children.empty()) {
+    throw std::runtime_error("GoogleSQL AST: sample without size");
+  }
+  if (size->detail.find("ROWS") != std::string::npos) {
+    throw std::runtime_error("TABLESAMPLE supports PERCENT sizes only");
+  }
+  const GoogleSqlAstNode& percent = *size->children.front();
+  if (percent.kind != "IntLiteral" && percent.kind != "FloatLiteral") {
+    throw std::runtime_error("TABLESAMPLE percentage must be a literal");
+  }
+  sample.fraction = std::stod(percent.detail) / 100.0;
+  if (!(sample.fraction > 0.0 && sample.fraction <= 1.0)) {
+    throw std::runtime_error("TABLESAMPLE percentage must be in (0, 100]");
+  }
+  if (const GoogleSqlAstNode* repeatable =
+          Descendant(node, "RepeatableClause")) {
+    const GoogleSqlAstNode* seed = repeatable->Child("IntLiteral");
+    if (!seed) throw std::runtime_error("REPEATABLE seed must be an integer");
+    sample.seed = static_cast<uint64_t>(std::stoll(seed->detail));
+  }
+  return sample;
+}
+
 SelectSource VisitTableSource(const GoogleSqlAstNode& node, JoinType join_type,
                               Expression join_condition) {
   SelectSource source;
@@ -352,6 +402,9 @@ SelectSource VisitTableSource(const GoogleSqlAstNode& node, JoinType join_type,
     if (!path) throw std::runtime_error("GoogleSQL AST: table without path");
     source.table = Path(*path);
     if (source.alias.empty()) source.alias = source.table;
+    if (const GoogleSqlAstNode* sample = node.Child("SampleClause")) {
+      source.sample = VisitSampleClause(*sample);
+    }
   } else if (node.kind == "TableSubquery") {
     const GoogleSqlAstNode* query = node.Child("Query");
     if (!query)
@@ -464,7 +517,13 @@ std::shared_ptr<SelectStatement> VisitQuery(const GoogleSqlAstNode& query) {
       std::move(order_by), limit, offset,
       select->detail.find("distinct=true") != std::string::npos);
   statement->SetSources(std::move(sources));
-  if (statement->Sources().size() > 1) statement->MarkComplex();
+  if (statement->Sources().size() > 1 ||
+      std::any_of(statement->Sources().begin(), statement->Sources().end(),
+                  [](const SelectSource& source) {
+                    return source.sample.has_value();
+                  })) {
+    statement->MarkComplex();
+  }
 
   if (const GoogleSqlAstNode* group = select->Child("GroupBy")) {
     std::vector<Expression> expressions;
@@ -0,0 +1,218 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+
+#include "query/result_cache.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+#include "common/constants.hpp"
+#include "common/encoder.hpp"
+#include "executor/query_memory.hpp"
+#include "expression/expression.hpp"
+#include "expression/function_call_expression.hpp"
+#include "expression/named_expression.hpp"
+#include "expression/query_expression.hpp"
+#include "expression/rewrite.hpp"
+#include "parser/ast.hpp"
+
+namespace tinylamb {
+namespace {
+
+size_t CapacityFromEnv() {
+  const char* env = std::getenv("TINYLAMB_RESULT_CACHE_BYTES");
+  if (env == nullptr || env[0] == '\0') return 0;
+  return static_cast<size_t>(std::strtoull(env, nullptr, 10));
+}
+
+// Key, bookkeeping and list node of an entry, on top of its rows.
+constexpr size_t kEntryOverheadBytes = 128;
+
+void CollectStatementTables(const SelectStatement& statement,
+                            ResultCacheTables* out);
+
+void CollectExpressionTables(const Expression& expression,
+                             ResultCacheTables* out) {
+  if (!expression) return;
+  if (expression->Type() == TypeTag::kQueryExp) {
+    CollectStatementTables(*expression->AsQueryExpression().Query(), out);
+  } else if (expression->Type() == TypeTag::kFunctionCallExp &&
+             expression->AsFunctionCallExpression().FuncName() ==
+                 "current_timestamp") {
+    out->cacheable = false;
+  }
+  for (const Expression& child : ExpressionChildren(expression)) {
+    CollectExpressionTables(child, out);
+  }
+}
+
+void CollectStatementTables(const SelectStatement& statement,
+                            ResultCacheTables* out) {
+  for (const auto& [name, query] : statement.WithQueries()) {
+    CollectStatementTables(*query, out);
+  }
+  for (const std::string& table : statement.FromClause()) {
+    out->tables.push_back(table);
+  }
+  for (const SelectSource& source : statement.Sources()) {
+    if (source.query) {
+      CollectStatementTables(*source.query, out);
+    } else {
+      out->tables.push_back(source.table);
+    }
+    // Without REPEATABLE each execution samples different rows.
+    if (source.sample && !source.sample->seed) out->cacheable = false;
+    CollectExpressionTables(source.join_condition, out);
+  }
+  for (const NamedExpression& item : statement.SelectList()) {
+    CollectExpressionTables(item.expression, out);
+  }
+  CollectExpressionTables(statement.WhereClause(), out);
+  for (const Expression& group : statement.GroupBy()) {
+    CollectExpressionTables(group, out);
+  }
+  CollectExpressionTables(statement.Having(), out);
+  for (const SelectStatement::OrderByTerm& term : statement.OrderBy()) {
+    CollectExpressionTables(term.expression, out);
+  }
+}
+
+}  // namespace
+
+QueryResultCache& QueryResultCache::Global() {
+  static QueryResultCache instance(CapacityFromEnv());
+  return instance;
+}
+
+bool QueryResultCache::Enabled() const { return Capacity() != 0; }
+
+size_t QueryResultCache::Capacity() const {
+  std::scoped_lock lock(mutex_);
+  return capacity_;
+}
+
+std::string QueryResultCache::Key(uint64_t database,
+                                  const std::string& fingerprint,
+                                  const std::vector<Value>& parameters) {
+  std::stringstream key;
+  Encoder encoder(key);
+  encoder << database << fingerprint;
+  for (const Value& parameter : parameters) {
+    encoder << parameter;
+  }
+  return key.str();
+}
+
+std::shared_ptr<const std::vector<Row>> QueryResultCache::Lookup(
+    const std::string& key, const std::vector<uint64_t>& versions,
+    uint64_t snapshot) {
+  std::scoped_lock lock(mutex_);
+  const auto found = entries_.find(key);
+  if (found == entries_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  if (found->second.versions != versions) {
+    Erase(found);
+    ++stats_.invalidations;
+    ++stats_.misses;
+    return nullptr;
+  }
+  if (snapshot < found->second.valid_from) {
+    ++stats_.misses;
+    return nullptr;
+  }
+  recency_.splice(recency_.begin(), recency_, found->second.recency);
+  ++stats_.hits;
+  return found->second.rows;
+}
+
+void QueryResultCache::Store(const std::string& key,
+                             std::vector<uint64_t> versions,
+                             std::vector<Row> rows) {
+  size_t bytes = kEntryOverheadBytes + key.size();
+  for (const Row& row : rows) bytes += EstimateRowBytes(row);
+  std::scoped_lock lock(mutex_);
+  if (capacity_ == 0 || capacity_ / 4 < bytes) return;
+  if (const auto found = entries_.find(key); found != entries_.end()) {
+    Erase(found);
+  }
+  while (capacity_ < bytes_ + bytes) {
+    Erase(entries_.find(recency_.back()));
+    ++stats_.evictions;
+  }
+  recency_.push_front(key);
+  Entry entry;
+  entry.valid_from =
+      versions.empty() ? 0 : *std::ranges::max_element(versions);
+  entry.versions = std::move(versions);
+  entry.rows = std::make_shared<const std::vector<Row>>(std::move(rows));
+  entry.bytes = bytes;
+  entry.recency = recency_.begin();
+  entries_.emplace(key, std::move(entry));
+  bytes_ += bytes;
+  ++stats_.stores;
+}
+
+QueryResultCache::Stats QueryResultCache::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  Stats stats = stats_;
+  stats.entries = entries_.size();
+  stats.bytes = bytes_;
+  return stats;
+}
+
+void QueryResultCache::ResetForTest(size_t capacity_bytes) {
+  std::scoped_lock lock(mutex_);
+  capacity_ = capacity_bytes;
+  bytes_ = 0;
+  entries_.clear();
+  recency_.clear();
+  stats_ = Stats{};
+}
+
+void QueryResultCache::Erase(
+    std::unordered_map<std::string, Entry>::iterator entry) {
+  bytes_ -= entry->second.bytes;
+  recency_.erase(entry->second.recency);
+  entries_.erase(entry);
+}
+
+ResultCacheTables CollectResultCacheTables(const SelectStatement& statement) {
+  ResultCacheTables out;
+  CollectStatementTables(statement, &out);
+  std::ranges::sort(out.tables);
+  const auto duplicates = std::ranges::unique(out.tables);
+  out.tables.erase(duplicates.begin(), duplicates.end());
+  return out;
+}
+
+bool ResultCacheFill::Next(Row* destination, RowPosition* position) {
+  if (!child_->Next(destination, position)) {
+    if (!done_) {
+      done_ = true;
+      store_(std::move(rows_));
+    }
+    return false;
+  }
+  if (!done_) {
+    bytes_ += EstimateRowBytes(*destination);
+    if (max_bytes_ < bytes_) {
+      done_ = true;
+      rows_ = {};
+    } else {
+      rows_.push_back(*destination);
+    }
+  }
+  return true;
+}
+
+void ResultCacheFill::Dump(std::ostream& o, int indent) const {
+  o << "ResultCacheFill: rows " << rows_.size() << "\n"
+    << Indent(static_cast<size_t>(indent + 2));
+  child_->Dump(o, indent + 2);
+}
+
+}  // namespace tinylamb
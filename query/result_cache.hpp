@@ -0,0 +1,139 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+
+#ifndef TINYLAMB_QUERY_RESULT_CACHE_HPP
+#define TINYLAMB_QUERY_RESULT_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "executor/executor_base.hpp"
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+
+class SelectStatement;
+
+// Process-wide cache of SELECT results, keyed by database, SQL template
+// fingerprint and literal parameters.
+//
+// Each entry remembers the commit timestamp of the last write to every table
+// the query read (TransactionManager::TableCommitTimestamps). A lookup with
+// different timestamps finds the entry stale and drops it, so a committed
+// write to any referenced table invalidates every result that read it. A
+// reader whose snapshot predates one of those writes misses without
+// dropping the entry. Entries are evicted least recently used first once
+// their estimated bytes pass the capacity.
+//
+// Config: TINYLAMB_RESULT_CACHE_BYTES
+//   - unset or "0": disabled
+class QueryResultCache {
+ public:
+  struct Stats {
+    size_t hits{0};
+    size_t misses{0};
+    size_t stores{0};
+    size_t evictions{0};
+    size_t invalidations{0};
+    size_t entries{0};
+    size_t bytes{0};
+  };
+
+  explicit QueryResultCache(size_t capacity_bytes)
+      : capacity_(capacity_bytes) {}
+  QueryResultCache(const QueryResultCache&) = delete;
+  QueryResultCache& operator=(const QueryResultCache&) = delete;
+
+  static QueryResultCache& Global();
+
+  [[nodiscard]] bool Enabled() const;
+  [[nodiscard]] size_t Capacity() const;
+
+  [[nodiscard]] static std::string Key(uint64_t database,
+                                       const std::string& fingerprint,
+                                       const std::vector<Value>& parameters);
+
+  // Rows stored under `key` when the referenced tables were last written at
+  // `versions` and a reader at `snapshot` sees those writes; nullptr
+  // otherwise.
+  [[nodiscard]] std::shared_ptr<const std::vector<Row>> Lookup(
+      const std::string& key, const std::vector<uint64_t>& versions,
+      uint64_t snapshot);
+  // Caches `rows` as read at `versions`. Results larger than a quarter of
+  // the capacity are not kept, so one report cannot flush the cache.
+  void Store(const std::string& key, std::vector<uint64_t> versions,
+             std::vector<Row> rows);
+
+  [[nodiscard]] Stats GetStats() const;
+
+  // Test helper: drops every entry and counter and sets the capacity
+  // (0 disables).
+  void ResetForTest(size_t capacity_bytes);
+
+ private:
+  struct Entry {
+    std::vector<uint64_t> versions;
+    // Readers need a snapshot at least this recent: max(versions).
+    uint64_t valid_from{0};
+    std::shared_ptr<const std::vector<Row>> rows;
+    size_t bytes{0};
+    std::list<std::string>::iterator recency;
+  };
+
+  void Erase(std::unordered_map<std::string, Entry>::iterator entry);
+
+  mutable std::mutex mutex_;
+  size_t capacity_;
+  size_t bytes_{0};
+  std::unordered_map<std::string, Entry> entries_;
+  // Most recently used first.
+  std::list<std::string> recency_;
+  Stats stats_;
+};
+
+// Tables `statement` reads, including those of WITH queries, derived tables
+// and subqueries, sorted and unique. `cacheable` is false when the result
+// depends on more than those tables, as with CURRENT_TIMESTAMP or a
+// TABLESAMPLE without REPEATABLE.
+struct ResultCacheTables {
+  bool cacheable{true};
+  std::vector<std::string> tables;
+};
+[[nodiscard]] ResultCacheTables CollectResultCacheTables(
+    const SelectStatement& statement);
+
+// Passes its child's rows through and hands a copy of all of them to
+// `store` once the child is exhausted, so a cache miss fills the cache
+// without running the query twice.
+class ResultCacheFill final : public ExecutorBase {
+ public:
+  using StoreFn = std::function<void(std::vector<Row>)>;
+
+  ResultCacheFill(Executor child, StoreFn store, size_t max_bytes)
+      : child_(std::move(child)),
+        store_(std::move(store)),
+        max_bytes_(max_bytes) {}
+
+  bool Next(Row* destination, RowPosition* position) override;
+  void Dump(std::ostream& o, int indent) const override;
+
+ private:
+  Executor child_;
+  StoreFn store_;
+  size_t max_bytes_;
+  std::vector<Row> rows_;
+  size_t bytes_{0};
+  // Set once the result outgrew max_bytes_ or was handed to store_.
+  bool done_{false};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_QUERY_RESULT_CACHE_HPP
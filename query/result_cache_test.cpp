@@ -0,0 +1,242 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "query/result_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "common/random_string.hpp"
+#include "database/database.hpp"
+#include "database/transaction_context.hpp"
+#include "executor/constant_executor.hpp"
+#include "expression/expression.hpp"
+#include "expression/named_expression.hpp"
+#include "parser/ast.hpp"
+#include "query/googlesql_frontend.hpp"
+#include "query/sql_engine.hpp"
+#include "table/table.hpp"
+#include "transaction/transaction_manager.hpp"
+#include "type/row.hpp"
+#include "type/schema.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+namespace {
+
+std::vector<Row> Rows(int64_t count) {
+  std::vector<Row> rows;
+  for (int64_t i = 0; i < count; ++i) rows.emplace_back(Row({Value(i)}));
+  return rows;
+}
+
+TEST(QueryResultCacheTest, HitsOnlyWhileTablesAreUnchanged) {
+  QueryResultCache cache(1 << 20);
+  const std::string key =
+      QueryResultCache::Key(1, "SELECT a FROM t WHERE b = ?", {Value(3)});
+  EXPECT_NE(key, QueryResultCache::Key(1, "SELECT a FROM t WHERE b = ?",
+                                       {Value(4)}));
+  EXPECT_NE(key, QueryResultCache::Key(2, "SELECT a FROM t WHERE b = ?",
+                                       {Value(3)}));
+  EXPECT_EQ(cache.Lookup(key, {5}, 5), nullptr);
+
+  cache.Store(key, {5}, Rows(3));
+  const auto hit = cache.Lookup(key, {5}, 7);
+  ASSERT_NE(hit, nullptr);
+  EXPECT_EQ(hit->size(), 3U);
+  // An older snapshot does not see the write the result reflects.
+  EXPECT_EQ(cache.Lookup(key, {5}, 4), nullptr);
+  EXPECT_EQ(cache.GetStats().entries, 1U);
+  // A later commit to the table drops the entry.
+  EXPECT_EQ(cache.Lookup(key, {8}, 8), nullptr);
+
+  const QueryResultCache::Stats stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 1U);
+  EXPECT_EQ(stats.misses, 3U);
+  EXPECT_EQ(stats.stores, 1U);
+  EXPECT_EQ(stats.invalidations, 1U);
+  EXPECT_EQ(stats.entries, 0U);
+  EXPECT_EQ(stats.bytes, 0U);
+}
+
+TEST(QueryResultCacheTest, EvictsLeastRecentlyUsedWithinBytes) {
+  QueryResultCache cache(4096);
+  cache.Store("a", {}, Rows(4));
+  cache.Store("b", {}, Rows(4));
+  cache.Store("c", {}, Rows(4));
+  ASSERT_NE(cache.Lookup("a", {}, 0), nullptr);
+  // Too large to keep: more than a quarter of the capacity.
+  cache.Store("huge", {}, Rows(64));
+  EXPECT_EQ(cache.GetStats().stores, 3U);
+  for (int i = 0; cache.GetStats().evictions == 0; ++i) {
+    ASSERT_LT(i, 100);
+    cache.Store("d" + std::to_string(i), {}, Rows(4));
+  }
+  // "b" was the least recently used; "a" was touched after it.
+  EXPECT_EQ(cache.Lookup("b", {}, 0), nullptr);
+  EXPECT_NE(cache.Lookup("a", {}, 0), nullptr);
+  EXPECT_LE(cache.GetStats().bytes, cache.Capacity());
+
+  cache.ResetForTest(0);
+  EXPECT_FALSE(cache.Enabled());
+  cache.Store("a", {}, Rows(1));
+  EXPECT_EQ(cache.GetStats().entries, 0U);
+}
+
+TEST(QueryResultCacheTest, CollectsEveryReferencedTable) {
+  auto inner = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("id")},
+      std::vector<std::string>{"dim"}, nullptr);
+  auto derived = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("k")},
+      std::vector<std::string>{"fact"}, nullptr);
+  auto with = std::make_shared<SelectStatement>(
+      std::vector<NamedExpression>{NamedExpression("k")},
+      std::vector<std::string>{"other"}, nullptr);
+  SelectStatement select({NamedExpression("k")}, {},
+                         QueryExpressionExp(inner, ColumnValueExp("k")));
+  select.SetSources(
+      {SelectSource{"w", "w", nullptr, JoinType::kCross, nullptr,
+                    std::nullopt},
+       SelectSource{"", "x", derived, JoinType::kCross, nullptr, std::nullopt},
+       SelectSource{"dim", "d", nullptr, JoinType::kCross, nullptr,
+                    std::nullopt}});
+  select.AddWithQuery("w", with);
+  const ResultCacheTables tables = CollectResultCacheTables(select);
+  EXPECT_TRUE(tables.cacheable);
+  EXPECT_EQ(tables.tables,
+            (std::vector<std::string>{"dim", "fact", "other", "w"}));
+
+  SelectStatement now(
+      {NamedExpression("t", FunctionCallExp("current_timestamp", {}))},
+      {"dim"}, nullptr);
+  EXPECT_FALSE(CollectResultCacheTables(now).cacheable);
+}
+
+TEST(QueryResultCacheTest, FillStoresOnlyCompleteResults) {
+  std::vector<Row> stored;
+  size_t calls = 0;
+  ResultCacheFill fill(std::make_shared<ConstantExecutor>(Rows(3)),
+                       [&](std::vector<Row> rows) {
+                         stored = std::move(rows);
+                         ++calls;
+                       },
+                       1 << 20);
+  Row row;
+  while (fill.Next(&row, nullptr)) {
+  }
+  EXPECT_FALSE(fill.Next(&row, nullptr));
+  EXPECT_EQ(calls, 1U);
+  EXPECT_EQ(stored.size(), 3U);
+
+  ResultCacheFill small(
+      std::make_shared<ConstantExecutor>(Rows(100)),
+      [&](std::vector<Row> rows) {
+        EXPECT_TRUE(rows.empty());
+        ++calls;
+      },
+      256);
+  size_t passed = 0;
+  while (small.Next(&row, nullptr)) ++passed;
+  EXPECT_EQ(passed, 100U);
+  EXPECT_EQ(calls, 1U);
+}
+
+class ResultCacheDatabaseTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    database_ = std::make_unique<Database>("result_cache_test-" +
+                                           RandomString());
+    QueryResultCache::Global().ResetForTest(1 << 20);
+  }
+  void TearDown() override {
+    QueryResultCache::Global().ResetForTest(0);
+    database_->DeleteAll();
+  }
+
+  std::vector<Row> Run(TransactionContext& context, const std::string& sql) {
+    SqlEngine engine(*database_);
+    StatusOr<Executor> result = engine.Prepare(context, sql);
+    EXPECT_EQ(result.GetStatus(), Status::kSuccess) << sql << "\n"
+                                                    << engine.LastError();
+    if (!result.HasValue()) return {};
+    std::vector<Row> rows;
+    Row row;
+    while (result.Value()->Next(&row, nullptr)) rows.push_back(row);
+    return rows;
+  }
+
+  std::unique_ptr<Database> database_;
+};
+
+TEST_F(ResultCacheDatabaseTest, CommitAdvancesTableTimestamps) {
+  {
+    TransactionContext ctx = database_->BeginContext();
+    ASSERT_TRUE(database_
+                    ->CreateTable(ctx, Schema("t", {Column("a",
+                                                           ValueType::kInt64)}))
+                    .HasValue());
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  TransactionContext reader = database_->BeginContext();
+  TransactionManager* manager = reader.txn_.GetTransactionManager();
+  const std::vector<uint64_t> created =
+      manager->TableCommitTimestamps({"t", "unknown"});
+  EXPECT_GT(created[0], 0U);
+  EXPECT_EQ(created[1], 0U);
+  EXPECT_FALSE(reader.txn_.HasWrites());
+
+  TransactionContext writer = database_->BeginContext();
+  ASSERT_TRUE(writer.GetTable("t").Value()->Insert(writer.txn_,
+                                                   Row({Value(1)}))
+                  .HasValue());
+  EXPECT_TRUE(writer.txn_.HasWrites());
+  // Uncommitted writes are invisible to other readers.
+  EXPECT_EQ(manager->TableCommitTimestamps({"t"})[0], created[0]);
+  ASSERT_EQ(writer.PreCommit(), Status::kSuccess);
+  EXPECT_GT(manager->TableCommitTimestamps({"t"})[0], created[0]);
+  EXPECT_EQ(manager->TableCommitTimestamps({"t"})[0],
+            manager->CurrentCommitTimestamp());
+  ASSERT_EQ(reader.PreCommit(), Status::kSuccess);
+}
+
+TEST_F(ResultCacheDatabaseTest, RepeatedSelectHitsUntilTableChanges) {
+  if (!GoogleSqlFrontend::Available()) {
+    GTEST_SKIP() << "GoogleSQL parser disabled for this platform";
+  }
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Run(ctx, "CREATE TABLE t (a INT64, b INT64);");
+    Run(ctx, "INSERT INTO t VALUES (1, 10), (2, 20), (3, 10);");
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  const auto select = [&](int64_t b) {
+    TransactionContext ctx = database_->BeginContext();
+    std::vector<Row> rows =
+        Run(ctx, "SELECT a FROM t WHERE b = " + std::to_string(b) + ";");
+    EXPECT_EQ(ctx.PreCommit(), Status::kSuccess);
+    return rows.size();
+  };
+  EXPECT_EQ(select(10), 2U);
+  EXPECT_EQ(select(10), 2U);
+  EXPECT_EQ(select(20), 1U);
+  EXPECT_EQ(QueryResultCache::Global().GetStats().hits, 1U);
+
+  {
+    TransactionContext ctx = database_->BeginContext();
+    Run(ctx, "INSERT INTO t VALUES (4, 10);");
+    // The writer's own reads neither use nor fill the cache.
+    EXPECT_EQ(Run(ctx, "SELECT a FROM t WHERE b = 10;").size(), 3U);
+    ASSERT_EQ(ctx.PreCommit(), Status::kSuccess);
+  }
+  EXPECT_EQ(select(10), 3U);
+  EXPECT_EQ(select(10), 3U);
+  const QueryResultCache::Stats stats = QueryResultCache::Global().GetStats();
+  EXPECT_EQ(stats.hits, 2U);
+  EXPECT_EQ(stats.invalidations, 1U);
+}
+
+}  // namespace
+}  // namespace tinylamb
@@ -15,6 +15,7 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -27,8 +28,11 @@
 #include "executor/insert.hpp"
 #include "executor/limit.hpp"
 #include "executor/projection.hpp"
+#include "executor/query_memory.hpp"
 #include "executor/relational.hpp"
 #include "executor/sort.hpp"
+#include "executor/table_sample.hpp"
+#include "executor/top_n.hpp"
 #include "executor/update.hpp"
 #include "expression/constant_value.hpp"
 #include "parser/ast.hpp"
@@ -38,9 +42,11 @@
 #include "query/googlesql_ast_visitor.hpp"
 #include "query/googlesql_frontend.hpp"
 #include "query/query_data.hpp"
+#include "query/result_cache.hpp"
 #include "query/sql_template.hpp"
 #include "table/table.hpp"
 #include "table/table_statistics.hpp"
+#include "transaction/transaction_manager.hpp"
 #include "type/row.hpp"
 #include "type/schema.hpp"
 #include "type/value.hpp"
@@ -208,6 +214,117 @@ std::optional<AnalyzeRequest> ParseAnalyze(std::string_view sql) {
   return request;
 }
 
+// CREATE MATERIALIZED VIEW name AS <select>;  DROP MATERIALIZED VIEW name;
+struct MaterializedViewRequest {
+  bool create{true};
+  std::string name;
+  std::string_view query;
+};
+
+std::optional<MaterializedViewRequest> ParseMaterializedView(
+    std::string_view sql) {
+  auto trim = [](std::string_view value) {
+    while (!value.empty() &&
+           std::isspace(static_cast<unsigned char>(value.front()))) {
+      value.remove_prefix(1);
+    }
+    while (!value.empty() &&
+           std::isspace(static_cast<unsigned char>(value.back()))) {
+      value.remove_suffix(1);
+    }
+    return value;
+  };
+  auto consume = [&](std::string_view* input, std::string_view keyword) {
+    *input = trim(*input);
+    if (input->size() < keyword.size()) return false;
+    for (size_t i = 0; i < keyword.size(); ++i) {
+      if (std::toupper(static_cast<unsigned char>((*input)[i])) != keyword[i]) {
+        return false;
+      }
+    }
+    if (input->size() != keyword.size() &&
+        !std::isspace(static_cast<unsigned char>((*input)[keyword.size()])) &&
+        (*input)[keyword.size()] != ';') {
+      return false;
+    }
+    input->remove_prefix(keyword.size());
+    return true;
+  };
+
+  std::string_view remainder = sql;
+  MaterializedViewRequest request;
+  if (consume(&remainder, "DROP")) {
+    request.create = false;
+  } else if (!consume(&remainder, "CREATE")) {
+    return std::nullopt;
+  }
+  if (!consume(&remainder, "MATERIALIZED") || !consume(&remainder, "VIEW")) {
+    return std::nullopt;
+  }
+  remainder = trim(remainder);
+  size_t length = 0;
+  while (length < remainder.size() &&
+         (std::isalnum(static_cast<unsigned char>(remainder[length])) ||
+          remainder[length] == '_')) {
+    ++length;
+  }
+  request.name = std::string(remainder.substr(0, length));
+  remainder.remove_prefix(length);
+  if (request.create) {
+    if (!consume(&remainder, "AS")) request.name.clear();
+    request.query = trim(remainder);
+  } else {
+    remainder = trim(remainder);
+    if (!remainder.empty() && remainder != ";") request.name.clear();
+  }
+  return request;
+}
+
+// A result cache hit, or how to fill the cache on a miss.
+struct CachedSelect {
+  std::shared_ptr<const std::vector<Row>> rows;
+  ResultCacheFill::StoreFn fill;
+};
+
+// Consults the result cache for a SELECT bound from `templated`. Returns
+// nullopt when the cache does not apply: it is disabled, the transaction
+// has uncommitted writes its result would reflect, or the query reads more
+// than its tables.
+std::optional<CachedSelect> LookupCachedSelect(TransactionContext& ctx,
+                                               const SelectStatement& select,
+                                               const SqlTemplate* templated,
+                                               bool explaining) {
+  QueryResultCache& cache = QueryResultCache::Global();
+  TransactionManager* manager = ctx.txn_.GetTransactionManager();
+  if (templated == nullptr || explaining || manager == nullptr ||
+      ctx.txn_.HasWrites() || !cache.Enabled()) {
+    return std::nullopt;
+  }
+  ResultCacheTables tables = CollectResultCacheTables(select);
+  if (!tables.cacheable) return std::nullopt;
+  std::string key = QueryResultCache::Key(
+      manager->InstanceId(), templated->fingerprint, templated->parameters);
+  const uint64_t snapshot = ctx.txn_.SnapshotTimestamp();
+  CachedSelect cached;
+  cached.rows = cache.Lookup(
+      key, manager->TableCommitTimestamps(tables.tables), snapshot);
+  if (cached.rows) return cached;
+  cached.fill = [&cache, &txn = ctx.txn_, manager, snapshot,
+                 key = std::move(key),
+                 tables = std::move(tables.tables)](std::vector<Row> rows) {
+    // Keep the result only if this snapshot saw every committed write to
+    // the tables, so it is what any later reader would compute.
+    std::vector<uint64_t> versions = manager->TableCommitTimestamps(tables);
+    if (txn.HasWrites() ||
+        std::ranges::any_of(versions,
+                            [&](uint64_t ts) { return snapshot < ts; })) {
+      return;
+    }
+    cache.Store(key, std::move(versions), std::move(rows));
+  };
+  return cached;
+}
+
 StatusOr<Executor> ExecuteAnalyze(Database& database, TransactionContext& ctx,
                                   const AnalyzeRequest& request) {
   std::vector<std::string> tables = request.tables;
@@ -244,7 +361,9 @@ StatusOr<Executor> SqlEngine::Prepare(TransactionContext& ctx,
       return Status::kUnknown;
     }
     const auto planning_start = std::chrono::steady_clock::now();
+    explaining_ = true;
     StatusOr<Executor> prepared = Prepare(ctx, explain->query);
+    explaining_ = false;
     const auto planning_end = std::chrono::steady_clock::now();
     if (!prepared.HasValue()) return prepared.GetStatus();
     if (!last_statement_type_ ||
@@ -292,13 +411,18 @@ StatusOr<Executor> SqlEngine::Prepare(TransactionContext& ctx,
     }
     return executed;
   }
+  if (const std::optional<MaterializedViewRequest> view =
+          ParseMaterializedView(sql)) {
+    return PrepareMaterializedView(ctx, view->create, view->name, view->query);
+  }
   const SqlTemplate templated = ExtractSqlTemplate(sql);
   if (templated.templatable) {
     if (const std::shared_ptr<Statement> cached =
             FindTemplate(templated.fingerprint)) {
       try {
         return PrepareStatement(
-            ctx, BindStatementLiterals(*cached, templated.parameters));
+            ctx, BindStatementLiterals(*cached, templated.parameters),
+            &templated);
       } catch (const std::exception&) {
         // Literal shape drifted from the cached tree; parse the original SQL.
       }
@@ -321,7 +445,8 @@ StatusOr<Executor> SqlEngine::Prepare(TransactionContext& ctx,
       } catch (const std::exception&) {
       }
     }
-    return PrepareStatement(ctx, std::move(statement));
+    return PrepareStatement(ctx, std::move(statement),
+                            templated.templatable ? &templated : nullptr);
   } catch (const std::exception& error) {
     last_error_ = error.what();
     return Status::kUnknown;
@@ -329,8 +454,11 @@ StatusOr<Executor> SqlEngine::Prepare(TransactionContext& ctx,
 }
 
 StatusOr<Executor> SqlEngine::PrepareStatement(
-    TransactionContext& ctx, std::unique_ptr<Statement> statement) {
+    TransactionContext& ctx, std::unique_ptr<Statement> statement,
+    const SqlTemplate* templated) {
   last_statement_type_ = statement->Type();
+  // Operators built below charge this statement's memory account.
+  const ScopedMemoryContext memory(MemoryContext::ForQuery());
   switch (statement->Type()) {
     case StatementType::kCreateTable: {
       const auto& create =
@@ -405,15 +533,35 @@ StatusOr<Executor> SqlEngine::PrepareStatement(
           std::make_shared<ConstantExecutor>(std::move(rows))));
     }
     case StatementType::kSelect: {
-      auto select = std::shared_ptr<SelectStatement>(
-          static_cast<SelectStatement*>(statement.release()));
+      auto select = EstimateFromSample(std::shared_ptr<SelectStatement>(
+          static_cast<SelectStatement*>(statement.release())));
       result_column_names_.reserve(select->SelectList().size());
       for (const NamedExpression& item : select->SelectList()) {
         result_column_names_.push_back(
             item.name.empty() ? item.expression->ToString() : item.name);
       }
+      if (!explaining_) {
+        if (std::optional<std::vector<Row>> rows =
+                database_->GetMaterializedViews().Answer(ctx, *select)) {
+          return Executor(std::make_shared<ConstantExecutor>(std::move(*rows)));
+        }
+      }
+      ResultCacheFill::StoreFn fill;
+      if (std::optional<CachedSelect> cached =
+              LookupCachedSelect(ctx, *select, templated, explaining_)) {
+        if (cached->rows) {
+          return Executor(std::make_shared<ConstantExecutor>(*cached->rows));
+        }
+        fill = std::move(cached->fill);
+      }
+      const auto finish = [&](Executor executor) {
+        if (!fill) return executor;
+        return Executor(std::make_shared<ResultCacheFill>(
+            std::move(executor), std::move(fill),
+            QueryResultCache::Global().Capacity() / 4));
+      };
       if (select->RequiresRelationalEvaluation()) {
-        return Executor(std::make_shared<RelationalExecutor>(ctx, select));
+        return finish(std::make_shared<RelationalExecutor>(ctx, select));
       }
       QueryData query;
       query.from_ = select->FromClause();
@@ -449,6 +597,7 @@ StatusOr<Executor> SqlEngine::PrepareStatement(
       if (select->Distinct()) {
         executor = std::make_shared<DistinctExecutor>(std::move(executor));
       }
+      bool limited = select->Limit() != 0 || select->Offset() != 0;
       if (!select->OrderBy().empty() &&
           !plan->IsOrderedBy(query.order_expressions_, query.order_ascending_)) {
         std::vector<SortExecutor::Key> keys;
@@ -456,10 +605,20 @@ StatusOr<Executor> SqlEngine::PrepareStatement(
         for (size_t i = 0; i < select->OrderBy().size(); ++i) {
           keys.push_back({sort_expressions[i], sort_ascending[i]});
         }
-        executor = std::make_shared<SortExecutor>(
-            std::move(executor), plan->GetSchema(), std::move(keys));
+        if (select->Limit() != 0 &&
+            select->Offset() + select->Limit() <= kMaxTopNRows) {
+          executor = std::make_shared<TopNExecutor>(
+              std::move(executor), plan->GetSchema(), std::move(keys),
+              select->Limit(), select->Offset(),
+              std::thread::hardware_concurrency());
+          limited = false;
+        } else {
+          executor = std::make_shared<SortExecutor>(
+              std::move(executor), plan->GetSchema(), std::move(keys),
+              std::thread::hardware_concurrency());
+        }
       }
-      if (select->Limit() != 0 || select->Offset() != 0) {
+      if (limited) {
         executor = std::make_shared<LimitExecutor>(
             std::move(executor), select->Limit(), select->Offset());
       }
@@ -472,7 +631,7 @@ StatusOr<Executor> SqlEngine::PrepareStatement(
         executor = std::make_shared<Projection>(
             std::move(visible), plan->GetSchema(), std::move(executor));
       }
-      return executor;
+      return finish(std::move(executor));
     }
     case StatementType::kUpdate: {
       const auto& update = dynamic_cast<const UpdateStatement&>(*statement);
@@ -535,8 +694,59 @@ StatusOr<Executor> SqlEngine::PrepareStatement(
     case StatementType::kAnalyze:
       last_error_ = "ANALYZE is handled before statement binding";
       return Status::kNotImplemented;
+    case StatementType::kCreateMaterializedView:
+    case StatementType::kDropMaterializedView:
+      last_error_ = "materialized views are handled before statement binding";
+      return Status::kNotImplemented;
   }
   return Status::kNotImplemented;
 }
 
+StatusOr<Executor> SqlEngine::PrepareMaterializedView(TransactionContext& ctx,
+                                                      bool create,
+                                                      const std::string& name,
+                                                      std::string_view query) {
+  last_statement_type_ = create ? StatementType::kCreateMaterializedView
+                                : StatementType::kDropMaterializedView;
+  if (name.empty()) {
+    last_error_ = create ? "expected CREATE MATERIALIZED VIEW name AS query"
+                         : "expected DROP MATERIALIZED VIEW name";
+    return Status::kUnknown;
+  }
+  if (!create) {
+    const Status dropped = database_->DropMaterializedView(name);
+    if (dropped != Status::kSuccess) {
+      last_error_ = "unknown materialized view: " + name;
+      return dropped;
+    }
+    return Executor(std::make_shared<ConstantExecutor>(
+        Row({Value("DROP MATERIALIZED VIEW"), Value(0)})));
+  }
+  GoogleSqlParseResult parsed = GoogleSqlFrontend::Parse(query);
+  if (!parsed.ok) {
+    last_error_ = std::move(parsed.error);
+    return Status::kUnknown;
+  }
+  try {
+    ASSIGN_OR_RETURN(std::unique_ptr<GoogleSqlAstNode>, ast,
+                     GoogleSqlAstParser::Parse(parsed.ast));
+    std::unique_ptr<Statement> statement = GoogleSqlAstVisitor::Visit(*ast);
+    if (statement->Type() != StatementType::kSelect) {
+      last_error_ = "a materialized view must be defined by a SELECT";
+      return Status::kUnknown;
+    }
+    const Status created = database_->CreateMaterializedView(
+        ctx, name, static_cast<const SelectStatement&>(*statement));
+    if (created != Status::kSuccess) {
+      last_error_ = "cannot create materialized view " + name;
+      return created;
+    }
+  } catch (const std::exception& error) {
+    last_error_ = error.what();
+    return Status::kUnknown;
+  }
+  return Executor(std::make_shared<ConstantExecutor>(
+      Row({Value("CREATE MATERIALIZED VIEW"), Value(0)})));
+}
+
 }  // namespace tinylamb
@@ -21,11 +21,15 @@ class Database;
 class Statement;
 class TransactionContext;
 enum class StatementType;
+struct SqlTemplate;
 
 class SqlEngine {
  public:
   explicit SqlEngine(Database& database) : database_(&database) {}
 
+  // SELECTs are answered from a materialized view that matches them, or
+  // from QueryResultCache::Global() when it is enabled and holds a result
+  // that is still current for `ctx`.
   StatusOr<Executor> Prepare(TransactionContext& ctx, std::string_view sql);
   [[nodiscard]] const std::string& LastError() const { return last_error_; }
   [[nodiscard]] const std::optional<StatementType>& LastStatementType() const {
@@ -36,13 +40,24 @@ class SqlEngine {
   }
 
  private:
+  // `templated` names the SQL template the statement was bound from, if
+  // any; only those SELECTs use the result cache.
   StatusOr<Executor> PrepareStatement(TransactionContext& ctx,
-                                      std::unique_ptr<Statement> statement);
+                                      std::unique_ptr<Statement> statement,
+                                      const SqlTemplate* templated = nullptr);
+
+  // CREATE or DROP MATERIALIZED VIEW `name`; `query` is the definition.
+  StatusOr<Executor> PrepareMaterializedView(TransactionContext& ctx,
+                                             bool create,
+                                             const std::string& name,
+                                             std::string_view query);
 
   Database* database_;
   std::string last_error_;
   std::optional<StatementType> last_statement_type_;
   std::vector<std::string> result_column_names_;
+  // EXPLAIN shows the plan, so it neither reads nor fills the result cache.
+  bool explaining_{false};
 };
 
 }  // namespace tinylamb
@@ -506,6 +506,45 @@ TEST_F(SqlEngineTpchTest, PrunesScanColumnsAndFiltersBeforeMaterialization) {
   EXPECT_EQ(context.PreCommit(), Status::kSuccess);
 }
 
+TEST_F(SqlEngineTpchTest, BindsColumnReferencesOncePerStatement) {
+  TransactionContext context = database_->BeginContext();
+  Run(context, "CREATE TABLE readings (g INT64, v INT64, w INT64);");
+  std::ostringstream insert;
+  insert << "INSERT INTO readings VALUES ";
+  constexpr int kRows = 128;
+  for (int i = 0; i < kRows; ++i) {
+    if (i != 0) insert << ",";
+    insert << "(" << i % 4 << "," << i << ",1)";
+  }
+  insert << ";";
+  Run(context, insert.str());
+
+  SqlEngine engine(*database_);
+  StatusOr<Executor> prepared = engine.Prepare(
+      context,
+      "SELECT g, SUM(v * 2 + w) AS total FROM readings "
+      "WHERE v + w > 0 GROUP BY g ORDER BY g;");
+  ASSERT_TRUE(prepared.HasValue()) << engine.LastError();
+  std::ostringstream profile;
+  prepared.Value()->Dump(profile, 0);
+  const std::string dump = profile.str();
+  const size_t binds_at = dump.find("column_binds=");
+  ASSERT_NE(binds_at, std::string::npos) << dump;
+  // Each ColumnValue node resolves once, not once per row.
+  EXPECT_LE(std::stoul(dump.substr(binds_at + 13)), 8U) << dump;
+
+  Row row;
+  int64_t expected[4] = {0, 0, 0, 0};
+  for (int i = 0; i < kRows; ++i) expected[i % 4] += i * 2 + 1;
+  for (int64_t group = 0; group < 4; ++group) {
+    ASSERT_TRUE(prepared.Value()->Next(&row, nullptr));
+    EXPECT_EQ(row[0], Value(group));
+    EXPECT_EQ(row[1], Value(expected[group]));
+  }
+  EXPECT_FALSE(prepared.Value()->Next(&row, nullptr));
+  EXPECT_EQ(context.PreCommit(), Status::kSuccess);
+}
+
 TEST_F(SqlEngineTpchTest, UsesHashJoinsWithoutMaterializingCartesianProducts) {
   TransactionContext context = database_->BeginContext();
   CreateSchema(context);
@@ -262,6 +262,15 @@ SqlTemplate ExtractSqlTemplate(std::string_view sql) {
       }
       continue;
     }
+    // Sample sizes and seeds are not expressions: keep them in the text.
+    if (KeywordAt(sql, i, "TABLESAMPLE") || KeywordAt(sql, i, "REPEATABLE")) {
+      const size_t close = sql.find(')', i);
+      const size_t end = close == std::string_view::npos ? sql.size()
+                                                         : close + 1;
+      result.fingerprint.append(sql.substr(i, end - i));
+      i = end;
+      continue;
+    }
     if (KeywordAt(sql, i, "CREATE") || KeywordAt(sql, i, "DROP")) {
       result.templatable = false;
     }
@@ -362,6 +371,8 @@ std::unique_ptr<Statement> BindStatementLiterals(
     case StatementType::kCreateTable:
     case StatementType::kDropTable:
     case StatementType::kAnalyze:
+    case StatementType::kCreateMaterializedView:
+    case StatementType::kDropMaterializedView:
       throw std::runtime_error("SQL template does not bind DDL");
   }
   if (index != parameters.size()) {
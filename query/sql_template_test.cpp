@@ -48,6 +48,17 @@ TEST(SqlTemplateTest, LeavesLimitAndStringsTyped) {
   EXPECT_EQ(extracted.parameters[0], Value(std::string("Last#4")));
 }
 
+TEST(SqlTemplateTest, KeepsTableSampleSizesInFingerprint) {
+  const SqlTemplate extracted = ExtractSqlTemplate(
+      "SELECT SUM(a) FROM t TABLESAMPLE SYSTEM (2.5) REPEATABLE (7) "
+      "WHERE b = 3;");
+  EXPECT_NE(extracted.fingerprint.find("TABLESAMPLE SYSTEM (2.5)"),
+            std::string::npos);
+  EXPECT_NE(extracted.fingerprint.find("REPEATABLE (7)"), std::string::npos);
+  ASSERT_EQ(extracted.parameters.size(), 1);
+  EXPECT_EQ(extracted.parameters[0], Value(3));
+}
+
 TEST(SqlTemplateTest, BindsCachedSelectTree) {
   if (!GoogleSqlFrontend::Available()) {
     GTEST_SKIP() << "GoogleSQL parser disabled for this platform";
@@ -82,6 +82,10 @@ std::string CommandTag(StatementType type, int64_t affected_rows) {
       return "DELETE " + std::to_string(affected_rows);
     case StatementType::kAnalyze:
       return "ANALYZE";
+    case StatementType::kCreateMaterializedView:
+      return "CREATE MATERIALIZED VIEW";
+    case StatementType::kDropMaterializedView:
+      return "DROP MATERIALIZED VIEW";
   }
   return "OK";
 }
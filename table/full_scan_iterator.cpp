@@ -25,6 +25,7 @@
 #include "iterator_base.hpp"
 #include "page/page_manager.hpp"
 #include "page/page_ref.hpp"
+#include "table/runtime_filter.hpp"
 #include "table/table.hpp"
 #include "transaction/transaction.hpp"
 
@@ -34,13 +35,14 @@ FullScanIterator::FullScanIterator(
     const Table* table, Transaction* txn,
     std::optional<std::vector<slot_t>> projection,
     const std::unordered_set<int64_t>* key_filter,
-    std::optional<slot_t> key_column)
+    std::optional<slot_t> key_column, const RuntimeFilter* runtime_filter)
     : table_(table),
       txn_(txn),
       pos_(table_->first_pid_, 0),
       projection_(std::move(projection)),
       key_filter_(key_filter),
-      key_column_(key_column) {
+      key_column_(key_column),
+      runtime_filter_(runtime_filter) {
   page_ = std::make_unique<PageRef>(txn->GetPageManager()->GetPage(
       pos_.page_id, txn->IsReadOnly()));
   SeekVisibleRow();
@@ -50,14 +52,15 @@ FullScanIterator::FullScanIterator(
     const Table* table, Transaction* txn, std::vector<page_id_t> pages,
     std::optional<std::vector<slot_t>> projection,
     const std::unordered_set<int64_t>* key_filter,
-    std::optional<slot_t> key_column)
+    std::optional<slot_t> key_column, const RuntimeFilter* runtime_filter)
     : table_(table),
       txn_(txn),
       pos_(pages.empty() ? ~0ULL : pages.front(), 0),
       projection_(std::move(projection)),
       pages_(std::move(pages)),
       key_filter_(key_filter),
-      key_column_(key_column) {
+      key_column_(key_column),
+      runtime_filter_(runtime_filter) {
   if (!pos_.IsValid()) return;
   page_ = std::make_unique<PageRef>(txn->GetPageManager()->GetPage(
       pos_.page_id, txn->IsReadOnly()));
@@ -88,6 +91,12 @@ void FullScanIterator::SeekVisibleRow() {
             continue;
           }
         }
+        if (runtime_filter_ && !runtime_filter_->MayContainSerialized(
+                                   row.Value().data(), table_->GetSchema())) {
+          ++runtime_rejected_;
+          ++pos_.slot;
+          continue;
+        }
         DeserializeCurrent(row.Value());
         if (!txn_->IsReadOnly()) {
           page_.reset();
@@ -103,6 +112,10 @@ void FullScanIterator::SeekVisibleRow() {
 }
 
 bool FullScanIterator::AdvancePage() {
+  if (runtime_rejected_ != 0) {
+    runtime_filter_->AddRejected(runtime_rejected_);
+    runtime_rejected_ = 0;
+  }
   page_id_t next_page = 0;
   if (pages_) {
     ++page_index_;
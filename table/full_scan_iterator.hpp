@@ -28,6 +28,7 @@
 #include "type/row.hpp"
 
 namespace tinylamb {
+class RuntimeFilter;
 class Table;
 class Transaction;
 
@@ -57,12 +58,14 @@ class FullScanIterator : public IteratorBase {
   FullScanIterator(const Table* table, Transaction* txn,
                    std::optional<std::vector<slot_t>> projection = std::nullopt,
                    const std::unordered_set<int64_t>* key_filter = nullptr,
-                   std::optional<slot_t> key_column = std::nullopt);
+                   std::optional<slot_t> key_column = std::nullopt,
+                   const RuntimeFilter* runtime_filter = nullptr);
   FullScanIterator(const Table* table, Transaction* txn,
                    std::vector<page_id_t> pages,
                    std::optional<std::vector<slot_t>> projection,
                    const std::unordered_set<int64_t>* key_filter = nullptr,
-                   std::optional<slot_t> key_column = std::nullopt);
+                   std::optional<slot_t> key_column = std::nullopt,
+                   const RuntimeFilter* runtime_filter = nullptr);
 
   void DeserializeCurrent(std::string_view row);
   void SeekVisibleRow();
@@ -78,6 +81,10 @@ class FullScanIterator : public IteratorBase {
   size_t page_index_{0};
   const std::unordered_set<int64_t>* key_filter_{nullptr};
   std::optional<slot_t> key_column_;
+  // Rows failing the filter are skipped before they are decoded; the count
+  // is handed to the filter at the end of every page.
+  const RuntimeFilter* runtime_filter_{nullptr};
+  size_t runtime_rejected_{0};
 };
 
 }  // namespace tinylamb
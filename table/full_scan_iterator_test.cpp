@@ -19,7 +19,9 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "common/constants.hpp"
 #include "common/log_message.hpp"
@@ -32,6 +34,7 @@
 #include "iterator.hpp"
 #include "page/page_manager.hpp"
 #include "recovery/recovery_manager.hpp"
+#include "table/runtime_filter.hpp"
 #include "table/table.hpp"
 #include "transaction/transaction_manager.hpp"
 #include "type/constraint.hpp"
@@ -207,6 +210,35 @@ TEST_F(FullScanIteratorTest, MorselScanIteratesOnlyRequestedPages) {
   ASSERT_SUCCESS(ctx.PreCommit());
 }
 
+TEST_F(FullScanIteratorTest, ScansSkipRowsRejectedByRuntimeFilter) {
+  TransactionContext ctx = db_->BeginContext();
+  ASSIGN_OR_ASSERT_FAIL(Table, table, db_->GetTable(ctx, "SampleTable"));
+  for (int i = 0; i < 130; ++i) {
+    ASSERT_SUCCESS(table.Insert(ctx.txn_,
+                                Row({Value(i), Value("v" + std::to_string(i)),
+                                     Value(0.1 + i)}))
+                       .GetStatus());
+  }
+  RuntimeFilter filter({1}, 3);
+  for (int i : {5, 64, 99}) {
+    filter.Insert(Row({Value("v" + std::to_string(i))}), {0});
+  }
+
+  std::vector<int64_t> keys;
+  for (const Table::ScanMorsel& morsel : table.BuildScanMorsels(ctx.txn_, 2)) {
+    Iterator it = table.BeginMorselScan(ctx.txn_, morsel, std::vector<slot_t>{0},
+                                        nullptr, std::nullopt, &filter);
+    for (; it.IsValid(); ++it) keys.push_back((*it)[0].value.int_value);
+  }
+  EXPECT_EQ(keys, (std::vector<int64_t>{5, 64, 99}));
+  EXPECT_EQ(filter.Rejected(), 127U);
+
+  Iterator full = table.BeginFullScan(ctx.txn_, std::nullopt, &filter);
+  ASSERT_TRUE(full.IsValid());
+  EXPECT_EQ((*full)[1], Value("v5"));
+  ASSERT_SUCCESS(ctx.PreCommit());
+}
+
 TEST_F(FullScanIteratorTest, EmptyTableScanYieldsNoRows) {
   TransactionContext ctx = db_->BeginContext();
   ASSIGN_OR_ASSERT_FAIL(Table, table, db_->GetTable(ctx, "SampleTable"));
@@ -0,0 +1,136 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "table/runtime_filter.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "common/hash.hpp"
+#include "type/schema.hpp"
+
+namespace tinylamb {
+
+namespace {
+
+// Odd multipliers picking one bit per word of a block (as in Parquet's
+// split-block Bloom filter).
+constexpr std::array<uint32_t, 8> kSalts = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+// Doubles closer than this are equal under Value::operator==.
+constexpr double kDoubleTolerance = 1e-9;
+
+uint64_t ValueBits(const Value& value) {
+  switch (value.type) {
+    case ValueType::kInt64:
+    case ValueType::kDate:
+      return static_cast<uint64_t>(value.value.int_value);
+    case ValueType::kDouble:
+      // Value::operator== takes doubles within kDoubleTolerance as equal,
+      // which no hash of the bits can respect. Only the bounds check them.
+      return 0;
+    case ValueType::kVarChar:
+      return std::hash<std::string_view>()(value.value.varchar_value);
+    case ValueType::kNull:
+      break;
+  }
+  return 0;
+}
+
+}  // namespace
+
+RuntimeFilter::RuntimeFilter(std::vector<slot_t> columns, size_t expected_keys)
+    : columns_(std::move(columns)),
+      min_(columns_.size()),
+      max_(columns_.size()) {
+  if (columns_.empty() || columns_.size() > kMaxRuntimeFilterColumns) {
+    throw std::invalid_argument("runtime filter needs 1 to " +
+                                std::to_string(kMaxRuntimeFilterColumns) +
+                                " key columns");
+  }
+  const size_t keys = std::clamp<size_t>(expected_keys, 1,
+                                         kMaxRuntimeFilterKeys);
+  const size_t bits = keys * kRuntimeFilterBitsPerKey;
+  blocks_.resize(std::bit_ceil((bits + 255) / 256), Block{});
+}
+
+void RuntimeFilter::Insert(const Row& row, const std::vector<slot_t>& slots) {
+  for (slot_t slot : slots) {
+    if (row[slot].IsNull()) return;
+  }
+  Key key{};
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    key[i] = &row[slots[i]];
+    if (keys_ == 0 || *key[i] < min_[i]) min_[i] = *key[i];
+    if (keys_ == 0 || max_[i] < *key[i]) max_[i] = *key[i];
+  }
+  const uint64_t hash = Hash(key);
+  Block& block = blocks_[BlockIndex(hash)];
+  const auto low = static_cast<uint32_t>(hash);
+  for (size_t word = 0; word < block.size(); ++word) {
+    block[word] |= 1U << ((low * kSalts[word]) >> 27);
+  }
+  ++keys_;
+}
+
+bool RuntimeFilter::MayContain(const Row& row,
+                               const std::vector<slot_t>& slots) const {
+  Key key{};
+  for (size_t i = 0; i < columns_.size(); ++i) key[i] = &row[slots[i]];
+  return Probe(key);
+}
+
+bool RuntimeFilter::MayContainSerialized(const char* row,
+                                         const Schema& schema) const {
+  std::array<Value, kMaxRuntimeFilterColumns> values;
+  if (!Row::PeekColumns(row, schema, columns_, values.data())) return false;
+  Key key{};
+  for (size_t i = 0; i < columns_.size(); ++i) key[i] = &values[i];
+  return Probe(key);
+}
+
+bool RuntimeFilter::Probe(const Key& key) const {
+  if (keys_ == 0) return false;
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    const Value& value = *key[i];
+    if (value.type != min_[i].type) return false;
+    if (value.type == ValueType::kDouble) {
+      const double probe = value.value.double_value;
+      if (probe < min_[i].value.double_value - kDoubleTolerance ||
+          max_[i].value.double_value + kDoubleTolerance < probe) {
+        return false;
+      }
+    } else if (value < min_[i] || max_[i] < value) {
+      return false;
+    }
+  }
+  const uint64_t hash = Hash(key);
+  const Block& block = blocks_[BlockIndex(hash)];
+  const auto low = static_cast<uint32_t>(hash);
+  for (size_t word = 0; word < block.size(); ++word) {
+    if ((block[word] & (1U << ((low * kSalts[word]) >> 27))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint64_t RuntimeFilter::Hash(const Key& key) const {
+  constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+  uint64_t hash = 0;
+  for (size_t i = 0; i < columns_.size(); ++i) {
+    hash = Fmix64(hash * kGolden ^ ValueBits(*key[i]));
+  }
+  return hash;
+}
+
+size_t RuntimeFilter::BlockIndex(uint64_t hash) const {
+  return (hash >> 32) & (blocks_.size() - 1);
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,81 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#ifndef TINYLAMB_TABLE_RUNTIME_FILTER_HPP
+#define TINYLAMB_TABLE_RUNTIME_FILTER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "common/constants.hpp"
+#include "type/row.hpp"
+#include "type/value.hpp"
+
+namespace tinylamb {
+class Schema;
+
+// Bits of Bloom filter per expected key; about 0.5% false positives.
+inline constexpr size_t kRuntimeFilterBitsPerKey = 16;
+// Most columns of a RuntimeFilter key.
+inline constexpr size_t kMaxRuntimeFilterColumns = 4;
+// Most keys a RuntimeFilter is built for, bounding it to 64 MiB.
+inline constexpr size_t kMaxRuntimeFilterKeys = size_t{1} << 25;
+
+// Join keys of a hash-join build side, checked by scans of the probe table.
+//
+// A split-block Bloom filter answers whether a key may occur on the build
+// side: every key sets one bit in each 32-bit word of a single 32-byte
+// block, so a probe touches one cache line. Per-column min/max bounds reject
+// keys outside the build range before hashing. A key may have any number of
+// columns of any type; keys containing NULL never match, as in an inner
+// equi-join. DOUBLE columns follow Value::operator==, which lets nearly
+// equal doubles match, so only their bounds are checked. The filter has
+// false positives, so the join itself must still compare keys.
+class RuntimeFilter {
+ public:
+  // `columns` are the key slots of the probe table's schema, in key order.
+  RuntimeFilter(std::vector<slot_t> columns, size_t expected_keys);
+  RuntimeFilter(const RuntimeFilter&) = delete;
+  RuntimeFilter& operator=(const RuntimeFilter&) = delete;
+
+  // Adds the key made of `slots` of `row`, one slot per key column.
+  void Insert(const Row& row, const std::vector<slot_t>& slots);
+  [[nodiscard]] bool MayContain(const Row& row,
+                                const std::vector<slot_t>& slots) const;
+  // Checks the key columns of `row` serialized with `schema`, the probe
+  // table's schema, without decoding the rest of the row.
+  [[nodiscard]] bool MayContainSerialized(const char* row,
+                                          const Schema& schema) const;
+
+  [[nodiscard]] const std::vector<slot_t>& Columns() const { return columns_; }
+  [[nodiscard]] size_t Keys() const { return keys_; }
+  [[nodiscard]] size_t Bytes() const { return blocks_.size() * sizeof(Block); }
+
+  // Probe rows scans dropped because of this filter.
+  void AddRejected(size_t rows) const {
+    rejected_.fetch_add(rows, std::memory_order_relaxed);
+  }
+  [[nodiscard]] size_t Rejected() const {
+    return rejected_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  using Block = std::array<uint32_t, 8>;
+  using Key = std::array<const Value*, kMaxRuntimeFilterColumns>;
+
+  [[nodiscard]] bool Probe(const Key& key) const;
+  [[nodiscard]] uint64_t Hash(const Key& key) const;
+  [[nodiscard]] size_t BlockIndex(uint64_t hash) const;
+
+  std::vector<slot_t> columns_;
+  std::vector<Block> blocks_;
+  std::vector<Value> min_;
+  std::vector<Value> max_;
+  size_t keys_{0};
+  mutable std::atomic<size_t> rejected_{0};
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_TABLE_RUNTIME_FILTER_HPP
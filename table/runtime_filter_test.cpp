@@ -0,0 +1,81 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "table/runtime_filter.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "type/column.hpp"
+#include "type/row.hpp"
+#include "type/schema.hpp"
+
+namespace tinylamb {
+
+TEST(RuntimeFilterTest, KeepsEveryInsertedKey) {
+  RuntimeFilter filter({0, 1}, 10000);
+  for (int64_t i = 0; i < 10000; i += 2) {
+    filter.Insert(Row({Value(i), Value("k" + std::to_string(i % 97))}), {0, 1});
+  }
+  size_t false_positives = 0;
+  for (int64_t i = 0; i < 10000; ++i) {
+    const bool found = filter.MayContain(
+        Row({Value(i), Value("k" + std::to_string(i % 97))}), {0, 1});
+    if (i % 2 == 0) {
+      ASSERT_TRUE(found) << i;
+    } else if (found) {
+      ++false_positives;
+    }
+  }
+  EXPECT_EQ(filter.Keys(), 5000U);
+  EXPECT_LT(false_positives, 100U);
+}
+
+TEST(RuntimeFilterTest, RejectsNullsAndKeysOutsideRange) {
+  RuntimeFilter filter({0}, 4);
+  filter.Insert(Row({Value(1.5)}), {0});
+  filter.Insert(Row({Value(-0.0)}), {0});
+  filter.Insert(Row({Value()}), {0});
+  EXPECT_EQ(filter.Keys(), 2U);
+  EXPECT_TRUE(filter.MayContain(Row({Value(1.5)}), {0}));
+  EXPECT_TRUE(filter.MayContain(Row({Value(0.0)}), {0}));
+  EXPECT_FALSE(filter.MayContain(Row({Value()}), {0}));
+  EXPECT_FALSE(filter.MayContain(Row({Value(2.0)}), {0}));
+  EXPECT_FALSE(filter.MayContain(Row({Value(-1.0)}), {0}));
+
+  RuntimeFilter empty({0}, 0);
+  EXPECT_FALSE(empty.MayContain(Row({Value(1)}), {0}));
+}
+
+TEST(RuntimeFilterTest, DoublesMatchAsValueEqualityDoes) {
+  RuntimeFilter filter({0, 1}, 4);
+  filter.Insert(Row({Value(1), Value(1.5)}), {0, 1});
+  filter.Insert(Row({Value(2), Value(3.0)}), {0, 1});
+  const Row near({Value(2), Value(3.0 + 5e-10)});
+  ASSERT_EQ(near[1], Value(3.0));
+  EXPECT_TRUE(filter.MayContain(near, {0, 1}));
+  EXPECT_TRUE(filter.MayContain(Row({Value(1), Value(1.5 - 5e-10)}), {0, 1}));
+  EXPECT_FALSE(filter.MayContain(Row({Value(2), Value(3.001)}), {0, 1}));
+  EXPECT_FALSE(filter.MayContain(Row({Value(5), Value(1.5)}), {0, 1}));
+}
+
+TEST(RuntimeFilterTest, ChecksSerializedRowsWithoutDecoding) {
+  const Schema schema("t", {Column("a", ValueType::kInt64),
+                            Column("b", ValueType::kVarChar),
+                            Column("c", ValueType::kDate)});
+  RuntimeFilter filter({2, 1}, 2);
+  filter.Insert(Row({Value::DateFromDays(10), Value("x")}), {0, 1});
+  filter.Insert(Row({Value::DateFromDays(20), Value("y")}), {0, 1});
+  const auto may_contain = [&](const Row& row) {
+    std::string buffer(row.Size(), '\0');
+    row.Serialize(buffer.data());
+    return filter.MayContainSerialized(buffer.data(), schema);
+  };
+  EXPECT_TRUE(may_contain(Row({Value(1), Value("x"), Value::DateFromDays(10)})));
+  EXPECT_TRUE(may_contain(Row({Value(2), Value("y"), Value::DateFromDays(20)})));
+  EXPECT_FALSE(
+      may_contain(Row({Value(3), Value("y"), Value::DateFromDays(30)})));
+  EXPECT_FALSE(may_contain(Row({Value(4), Value(), Value::DateFromDays(10)})));
+}
+
+}  // namespace tinylamb
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -27,6 +28,7 @@
 #include "common/constants.hpp"
 #include "common/decoder.hpp"
 #include "common/encoder.hpp"
+#include "common/hash.hpp"
 #include "common/status_or.hpp"
 #include "full_scan_iterator.hpp"
 #include "index/b_plus_tree.hpp"
@@ -36,11 +38,23 @@
 #include "page/page_manager.hpp"
 #include "page/page_type.hpp"
 #include "page/row_position.hpp"
+#include "transaction/table_write_observer.hpp"
 #include "transaction/transaction.hpp"
+#include "transaction/transaction_manager.hpp"
 #include "type/row.hpp"
 #include "type/value.hpp"
 
 namespace tinylamb {
+namespace {
+
+// Whether TABLESAMPLE SYSTEM keeps `page_id`: its id and the seed hashed to
+// a point in [0, 1) below `fraction`.
+bool PageSampled(page_id_t page_id, double fraction, uint64_t seed) {
+  const uint64_t key = Fmix64(page_id ^ (seed * 0x9E3779B97F4A7C15ULL));
+  return static_cast<double>(key >> 11) * 0x1.0p-53 < fraction;
+}
+
+}  // namespace
 
 Encoder& operator<<(Encoder& e, const Table::IndexValueType& v) {
   e << v.pos << v.include;
@@ -70,7 +84,22 @@ Status Table::CreateIndex(Transaction& txn, const IndexSchema& idx) {
   return Status::kSuccess;
 }
 
+namespace {
+
+// The observer to report a write to `table` to, if it watches that table.
+TableWriteObserver* WriteObserver(const Transaction& txn,
+                                  std::string_view table) {
+  TransactionManager* manager = txn.GetTransactionManager();
+  if (manager == nullptr) return nullptr;
+  TableWriteObserver* observer = manager->GetTableWriteObserver();
+  if (observer == nullptr || !observer->Observes(table)) return nullptr;
+  return observer;
+}
+
+}  // namespace
+
 StatusOr<RowPosition> Table::Insert(Transaction& txn, const Row& row) {
+  txn.NoteTableWrite(schema_.Name());
   PageRef ref = txn.GetPageManager()->GetPage(last_pid_);
   std::string serialized_row(row.Size(), ' ');
   row.Serialize(serialized_row.data());
@@ -119,6 +148,9 @@ StatusOr<RowPosition> Table::Insert(Transaction& txn, const Row& row) {
       return status;
     }
   }
+  if (TableWriteObserver* observer = WriteObserver(txn, schema_.Name())) {
+    observer->RowWritten(txn, schema_.Name(), nullptr, &row);
+  }
   return rp;
 }
 
@@ -136,8 +168,16 @@ StatusOr<RowPosition> Table::Update(Transaction& txn, const RowPosition& pos,
   if (!txn.AddWriteSet(pos)) {
     return Status::kConflicts;
   }
+  txn.NoteTableWrite(schema_.Name());
   ASSIGN_OR_RETURN(Row, original_row, Read(txn, pos));
   RowPosition new_pos = pos;
+  TableWriteObserver* observer = WriteObserver(txn, schema_.Name());
+  const auto updated = [&] {
+    if (observer != nullptr) {
+      observer->RowWritten(txn, schema_.Name(), &original_row, &row);
+    }
+    return new_pos;
+  };
   bool indexes_unchanged = true;
   for (const auto& idx : indexes_) {
     if (!IndexCoversUnchanged(idx, original_row, row)) {
@@ -150,7 +190,7 @@ StatusOr<RowPosition> Table::Update(Transaction& txn, const RowPosition& pos,
   PageRef page = txn.GetPageManager()->GetPage(new_pos.page_id);
   Status s = page->Update(txn, new_pos.slot, serialized_row);
   if (s == Status::kSuccess && indexes_unchanged) {
-    return new_pos;
+    return updated();
   }
   if (s == Status::kSuccess) {
     for (const auto& idx : indexes_) {
@@ -159,7 +199,7 @@ StatusOr<RowPosition> Table::Update(Transaction& txn, const RowPosition& pos,
     for (const auto& idx : indexes_) {
       RETURN_IF_FAIL(IndexInsert(txn, idx, row, new_pos));
     }
-    return new_pos;
+    return updated();
   }
   if (s != Status::kNoSpace) return s;
   for (const auto& idx : indexes_) {
@@ -195,17 +235,29 @@ StatusOr<RowPosition> Table::Update(Transaction& txn, const RowPosition& pos,
   for (const auto& idx : indexes_) {
     RETURN_IF_FAIL(IndexInsert(txn, idx, row, new_pos));
   }
-  return new_pos;
+  return updated();
 }
 
 Status Table::Delete(Transaction& txn, RowPosition pos) {
   if (!txn.AddWriteSet(pos)) {
     return Status::kConflicts;
   }
+  txn.NoteTableWrite(schema_.Name());
+  TableWriteObserver* observer = WriteObserver(txn, schema_.Name());
+  Row deleted;
+  if (observer != nullptr) {
+    ASSIGN_OR_RETURN(Row, original_row, Read(txn, pos));
+    deleted = std::move(original_row);
+  }
   for (const auto& idx : indexes_) {
     RETURN_IF_FAIL(IndexDelete(txn, idx, pos));
   }
-  return txn.GetPageManager()->GetPage(pos.page_id)->Delete(txn, pos.slot);
+  RETURN_IF_FAIL(
+      txn.GetPageManager()->GetPage(pos.page_id)->Delete(txn, pos.slot));
+  if (observer != nullptr) {
+    observer->RowWritten(txn, schema_.Name(), &deleted, nullptr);
+  }
+  return Status::kSuccess;
 }
 
 StatusOr<Row> Table::Read(Transaction& txn, RowPosition pos) const {
@@ -302,26 +354,37 @@ Iterator Table::BeginFullScan(Transaction& txn,
                                        key_column));
 }
 
+Iterator Table::BeginFullScan(Transaction& txn,
+                              std::optional<std::vector<slot_t>> projection,
+                              const RuntimeFilter* runtime_filter) const {
+  return Iterator(new FullScanIterator(this, &txn, std::move(projection),
+                                       nullptr, std::nullopt, runtime_filter));
+}
+
 Iterator Table::BeginMorselScan(
     Transaction& txn, const ScanMorsel& pages,
     std::optional<std::vector<slot_t>> projection,
     const std::unordered_set<int64_t>* key_filter,
-    std::optional<slot_t> key_column) const {
+    std::optional<slot_t> key_column,
+    const RuntimeFilter* runtime_filter) const {
   return Iterator(new FullScanIterator(this, &txn, pages, std::move(projection),
-                                       key_filter, key_column));
+                                       key_filter, key_column, runtime_filter));
 }
 
 std::vector<Table::ScanMorsel> Table::BuildScanMorsels(
-    Transaction& txn, size_t pages_per_morsel) const {
+    Transaction& txn, size_t pages_per_morsel, double page_fraction,
+    uint64_t seed) const {
   pages_per_morsel = std::max<size_t>(1, pages_per_morsel);
   std::vector<ScanMorsel> morsels;
   page_id_t page_id = first_pid_;
   while (page_id != 0) {
-    if (morsels.empty() || morsels.back().size() == pages_per_morsel) {
-      morsels.emplace_back();
-      morsels.back().reserve(pages_per_morsel);
+    if (page_fraction >= 1.0 || PageSampled(page_id, page_fraction, seed)) {
+      if (morsels.empty() || morsels.back().size() == pages_per_morsel) {
+        morsels.emplace_back();
+        morsels.back().reserve(pages_per_morsel);
+      }
+      morsels.back().push_back(page_id);
     }
-    morsels.back().push_back(page_id);
     PageRef page = txn.GetPageManager()->GetPage(page_id, true);
     page_id = page->body.row_page.next_page_id_;
   }
@@ -19,6 +19,7 @@
 
 #include <unordered_map>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <unordered_set>
 #include <utility>
@@ -85,13 +86,22 @@ class Table {
   Iterator BeginFullScan(Transaction& txn,
                          const std::unordered_set<int64_t>* key_filter,
                          slot_t key_column) const;
+  // Skips rows `runtime_filter` rejects before decoding them.
+  Iterator BeginFullScan(Transaction& txn,
+                         std::optional<std::vector<slot_t>> projection,
+                         const RuntimeFilter* runtime_filter) const;
   Iterator BeginMorselScan(
       Transaction& txn, const ScanMorsel& pages,
       std::optional<std::vector<slot_t>> projection = std::nullopt,
       const std::unordered_set<int64_t>* key_filter = nullptr,
-      std::optional<slot_t> key_column = std::nullopt) const;
+      std::optional<slot_t> key_column = std::nullopt,
+      const RuntimeFilter* runtime_filter = nullptr) const;
+  // With `page_fraction` below 1 keeps each page with that probability, as
+  // decided by a hash of its id and `seed`, for TABLESAMPLE SYSTEM. Pages
+  // left out are still visited to follow the chain but never decoded.
   [[nodiscard]] std::vector<ScanMorsel> BuildScanMorsels(
-      Transaction& txn, size_t pages_per_morsel = 8) const;
+      Transaction& txn, size_t pages_per_morsel = 8,
+      double page_fraction = 1.0, uint64_t seed = 0) const;
   Iterator BeginIndexScan(Transaction& txn, const Index& index,
                           const Value& begin = Value(),
                           const Value& end = Value(),
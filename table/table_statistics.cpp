@@ -18,11 +18,14 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <optional>
 #include <ostream>
+#include <random>
 #include <ranges>
 #include <stdexcept>
 #include <string>
@@ -39,6 +42,7 @@
 #include "expression/unary_expression.hpp"
 #include "table/table.hpp"
 #include "transaction/transaction.hpp"
+#include "type/hyperloglog.hpp"
 #include "type/row.hpp"
 
 namespace tinylamb {
@@ -79,6 +83,24 @@ struct CollectedColumn {
   std::vector<ValueFrequency> most_common;
 };
 
+size_t ScaleCount(size_t count, double multiplier) {
+  if (count == 0 || multiplier <= 0) return 0;
+  const long double scaled = static_cast<long double>(count) * multiplier;
+  if (scaled >= std::numeric_limits<size_t>::max()) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return static_cast<size_t>(std::llround(scaled));
+}
+
+// Column values seen by TableStatistics::Update(). Frequencies are counted
+// exactly until the column shows more than kExactDistinctValueCount distinct
+// values. Past that the frequency map is dropped: the histogram and most
+// common values come from a uniform sample of kSampledValueCount values
+// (Vitter's Algorithm R, seeded so statistics are reproducible) and the
+// distinct count from a HyperLogLog sketch, so a high-cardinality column is
+// collected in bounded memory. Row counts and boundary values stay exact.
+// Sketch, sample and boundaries are only maintained past the switch; while
+// exact they would repeat what the frequency map already knows.
 class ColumnCollector {
  public:
   explicit ColumnCollector(ValueType type) : type_(type) {}
@@ -91,23 +113,67 @@ class ColumnCollector {
     if (value.type != type_) {
       throw std::runtime_error("column statistics type mismatch");
     }
-    ++frequencies_[value];
+    ++non_null_count_;
+    if (exact_) {
+      ++frequencies_[value];
+      if (frequencies_.size() > kExactDistinctValueCount) Approximate();
+      return;
+    }
+    distinct_.Add(value);
+    AddBoundary(value, 1);
+    Sample(value, non_null_count_);
   }
 
   [[nodiscard]] CollectedColumn Finish() const {
     CollectedColumn result;
     result.null_count = null_count_;
-    result.distinct_count = frequencies_.size();
+    result.non_null_count = non_null_count_;
+    if (exact_) {
+      // The boundaries are the ends of the frequency map.
+      const size_t boundary =
+          std::min(kBoundaryValueCount, frequencies_.size());
+      for (auto it = frequencies_.begin();
+           result.lowest.size() < boundary; ++it) {
+        result.lowest.push_back(ValueFrequency{it->first, it->second});
+      }
+      for (auto it = std::prev(frequencies_.end(),
+                               static_cast<std::ptrdiff_t>(boundary));
+           it != frequencies_.end(); ++it) {
+        result.highest.push_back(ValueFrequency{it->first, it->second});
+      }
+    } else {
+      for (const auto& [value, count] : lowest_) {
+        result.lowest.push_back(ValueFrequency{value, count});
+      }
+      for (const auto& [value, count] : highest_) {
+        result.highest.push_back(ValueFrequency{value, count});
+      }
+    }
 
+    std::map<Value, size_t, ValueLess> sampled;
+    if (!exact_) {
+      for (const Value& value : sample_) ++sampled[value];
+    }
+    const std::map<Value, size_t, ValueLess>& frequencies =
+        exact_ ? frequencies_ : sampled;
     std::vector<ValueFrequency> values;
-    values.reserve(frequencies_.size());
-    for (const auto& [value, count] : frequencies_) {
+    values.reserve(frequencies.size());
+    for (const auto& [value, count] : frequencies) {
       values.push_back(ValueFrequency{value, count});
-      result.non_null_count += count;
     }
-    const size_t boundary_count = std::min(kBoundaryValueCount, values.size());
-    result.lowest.assign(values.begin(), values.begin() + boundary_count);
-    result.highest.assign(values.end() - boundary_count, values.end());
+    // Sampled counts and distinct counts are scaled up to the whole column.
+    double multiplier = 1;
+    double distinct_multiplier = 1;
+    if (exact_) {
+      result.distinct_count = frequencies_.size();
+    } else {
+      result.distinct_count =
+          std::clamp<size_t>(distinct_.Estimate(), sampled.size(),
+                             non_null_count_);
+      multiplier = static_cast<double>(non_null_count_) / sample_.size();
+      distinct_multiplier =
+          static_cast<double>(result.distinct_count) / sampled.size();
+    }
 
     result.most_common = values;
     std::ranges::sort(result.most_common, [](const ValueFrequency& left,
@@ -120,14 +186,17 @@ class ColumnCollector {
     if (result.most_common.size() > kMostCommonValueCount) {
       result.most_common.resize(kMostCommonValueCount);
     }
+    for (ValueFrequency& frequency : result.most_common) {
+      frequency.count = ScaleCount(frequency.count, multiplier);
+    }
     CompactFrequencies(&result.lowest);
     CompactFrequencies(&result.highest);
     CompactFrequencies(&result.most_common);
 
     if (values.empty()) return result;
+    const size_t total = exact_ ? non_null_count_ : sample_.size();
     const size_t bucket_target = std::max<size_t>(
-        1, (result.non_null_count + kHistogramBucketCount - 1) /
-               kHistogramBucketCount);
+        1, (total + kHistogramBucketCount - 1) / kHistogramBucketCount);
     HistogramBucket bucket;
     for (const ValueFrequency& frequency : values) {
       if (bucket.distinct > 0 && bucket.count >= bucket_target &&
@@ -141,7 +210,16 @@ class ColumnCollector {
       ++bucket.distinct;
     }
     result.histogram.push_back(std::move(bucket));
+    if (!exact_) {
+      // The sample may miss the extremes; the boundary values have them.
+      result.histogram.front().lower = lowest_.begin()->first;
+      result.histogram.back().upper = highest_.rbegin()->first;
+    }
     for (HistogramBucket& histogram_bucket : result.histogram) {
+      histogram_bucket.count = ScaleCount(histogram_bucket.count, multiplier);
+      histogram_bucket.distinct = std::clamp<size_t>(
+          ScaleCount(histogram_bucket.distinct, distinct_multiplier), 1,
+          histogram_bucket.count);
       histogram_bucket.lower = CompactValue(histogram_bucket.lower);
       histogram_bucket.upper = CompactValue(histogram_bucket.upper);
     }
@@ -149,9 +227,59 @@ class ColumnCollector {
   }
 
  private:
+  // Leaves exact mode. The sketch, boundaries and sample are seeded from
+  // the frequency map as if they had seen every value so far, which the
+  // exact mode never paid for per value.
+  void Approximate() {
+    exact_ = false;
+    size_t seen = 0;
+    for (const auto& [value, count] : frequencies_) {
+      distinct_.Add(value);
+      AddBoundary(value, count);
+      for (size_t i = 0; i < count; ++i) Sample(value, ++seen);
+    }
+    frequencies_.clear();
+  }
+
+  // Keeps the kBoundaryValueCount lowest and highest values with their
+  // counts. A value once pushed out never returns, so the counts are exact.
+  void AddBoundary(const Value& value, size_t count) {
+    if (lowest_.size() < kBoundaryValueCount ||
+        !ValueLess{}(lowest_.rbegin()->first, value)) {
+      lowest_[value] += count;
+      if (lowest_.size() > kBoundaryValueCount) {
+        lowest_.erase(std::prev(lowest_.end()));
+      }
+    }
+    if (highest_.size() < kBoundaryValueCount ||
+        !ValueLess{}(value, highest_.begin()->first)) {
+      highest_[value] += count;
+      if (highest_.size() > kBoundaryValueCount) {
+        highest_.erase(highest_.begin());
+      }
+    }
+  }
+
+  // Algorithm R step for the `seen`-th non-NULL value.
+  void Sample(const Value& value, size_t seen) {
+    if (sample_.size() < kSampledValueCount) {
+      sample_.push_back(value);
+    } else if (const uint64_t slot = random_() % seen;
+               slot < kSampledValueCount) {
+      sample_[slot] = value;
+    }
+  }
+
   ValueType type_;
   size_t null_count_{0};
+  size_t non_null_count_{0};
+  bool exact_{true};
   std::map<Value, size_t, ValueLess> frequencies_;
+  std::map<Value, size_t, ValueLess> lowest_;
+  std::map<Value, size_t, ValueLess> highest_;
+  std::vector<Value> sample_;
+  std::mt19937_64 random_{kStatisticsMagic};
+  HyperLogLog distinct_;
 };
 
 bool SameValue(const Value& left, const Value& right) {
@@ -182,15 +310,6 @@ long double Position(const Value& value) {
   return 0;
 }
 
-size_t ScaleCount(size_t count, double multiplier) {
-  if (count == 0 || multiplier <= 0) return 0;
-  const long double scaled = static_cast<long double>(count) * multiplier;
-  if (scaled >= std::numeric_limits<size_t>::max()) {
-    return std::numeric_limits<size_t>::max();
-  }
-  return static_cast<size_t>(std::llround(scaled));
-}
-
 std::optional<Value> CoerceValue(const Value& value, ValueType type) {
   if (value.IsNull()) return std::nullopt;
   if (value.type == type) return value;
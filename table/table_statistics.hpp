@@ -36,6 +36,10 @@ class TableStatistics;
 inline constexpr size_t kHistogramBucketCount = 16;
 inline constexpr size_t kBoundaryValueCount = 5;
 inline constexpr size_t kMostCommonValueCount = 5;
+// A column with more distinct values than this is summarized from a sample
+// of kSampledValueCount values, with a HyperLogLog distinct count.
+inline constexpr size_t kExactDistinctValueCount = 1 << 14;
+inline constexpr size_t kSampledValueCount = 1 << 14;
 
 struct ValueFrequency {
   Value value;
@@ -235,6 +235,51 @@ TEST_F(TableStatisticsTest, UsesSkewAndNullsForSelectivity) {
   ASSERT_SUCCESS(context.PreCommit());
 }
 
+TEST_F(TableStatisticsTest, SketchesHighCardinalityColumns) {
+  constexpr int kRows = 40000;
+  {
+    TransactionContext context = db_->BeginContext();
+    ASSIGN_OR_ASSERT_FAIL(
+        Table, table,
+        db_->CreateTable(context,
+                         Schema("Wide", {Column("id", ValueType::kInt64),
+                                         Column("hot", ValueType::kInt64)})));
+    for (int i = 0; i < kRows; ++i) {
+      ASSERT_SUCCESS(
+          table.Insert(context.txn_, Row({Value(i), Value(i % 4 == 0 ? 1 : i)}))
+              .GetStatus());
+    }
+    ASSERT_SUCCESS(context.PreCommit());
+  }
+  TransactionContext context = db_->BeginContext();
+  ASSERT_SUCCESS(db_->RefreshStatistics(context, "Wide"));
+  ASSIGN_OR_ASSERT_FAIL(TableStatistics, statistics,
+                        db_->GetStatistics(context, "Wide"));
+  ASSERT_GT(static_cast<size_t>(kRows), kExactDistinctValueCount);
+
+  const ColumnStats& id = statistics.Column(0);
+  EXPECT_EQ(id.NonNullCount(), kRows);
+  EXPECT_NEAR(static_cast<double>(id.Distinct()), kRows, 0.03 * kRows);
+  // Boundary values are exact even though the rest is sampled.
+  ASSERT_EQ(id.LowestValues().size(), kBoundaryValueCount);
+  EXPECT_EQ(id.LowestValues().front(), (ValueFrequency{Value(0), 1}));
+  EXPECT_EQ(id.HighestValues().back(), (ValueFrequency{Value(kRows - 1), 1}));
+  ASSERT_EQ(id.Histogram().size(), kHistogramBucketCount);
+  EXPECT_EQ(id.Histogram().front().lower, Value(0));
+  EXPECT_EQ(id.Histogram().back().upper, Value(kRows - 1));
+  EXPECT_NEAR(statistics.EstimateCount(0, Value(0), Value(kRows / 2)),
+              kRows / 2.0, 0.05 * kRows);
+
+  const ColumnStats& hot = statistics.Column(1);
+  EXPECT_NEAR(static_cast<double>(hot.Distinct()), kRows * 3 / 4 + 1,
+              0.03 * kRows);
+  ASSERT_FALSE(hot.MostCommonValues().empty());
+  EXPECT_EQ(hot.MostCommonValues().front().value, Value(1));
+  EXPECT_NEAR(static_cast<double>(hot.MostCommonValues().front().count),
+              kRows / 4.0, 0.05 * kRows);
+  ASSERT_SUCCESS(context.PreCommit());
+}
+
 TEST_F(TableStatisticsTest, PersistsWideTableAsSeparateColumnEntries) {
   {
     TransactionContext context = db_->BeginContext();
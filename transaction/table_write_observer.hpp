@@ -0,0 +1,41 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+
+#ifndef TINYLAMB_TRANSACTION_TABLE_WRITE_OBSERVER_HPP
+#define TINYLAMB_TRANSACTION_TABLE_WRITE_OBSERVER_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace tinylamb {
+
+struct Row;
+class Transaction;
+
+// Sees every row written to the tables it observes, inside the writing
+// transaction, and learns how that transaction ended. Installed on a
+// TransactionManager; Table calls it from Insert, Update and Delete.
+class TableWriteObserver {
+ public:
+  virtual ~TableWriteObserver() = default;
+
+  // Whether writes to `table` are reported at all. Called on every write,
+  // so it must be cheap.
+  [[nodiscard]] virtual bool Observes(std::string_view table) const = 0;
+
+  // One successful row write by `txn`: `before` is null for an insert,
+  // `after` is null for a delete.
+  virtual void RowWritten(const Transaction& txn, std::string_view table,
+                          const Row* before, const Row* after) = 0;
+
+  // `txn`, which wrote at least one table, committed at `commit_ts` or
+  // aborted (nullopt). A commit is reported under the lock that publishes
+  // its timestamp, so a transaction beginning afterwards with a snapshot at
+  // or past `commit_ts` never sees the observer without it.
+  virtual void TransactionFinished(const Transaction& txn,
+                                   std::optional<uint64_t> commit_ts) = 0;
+};
+
+}  // namespace tinylamb
+
+#endif  // TINYLAMB_TRANSACTION_TABLE_WRITE_OBSERVER_HPP
@@ -70,10 +70,16 @@ bool Transaction::AddReadSet(const RowPosition& rp) {
   assert(!IsFinished());
   // MV2PL readers use snapshot-visible row versions and therefore never take
   // a lock that conflicts with a writer's exclusive lock.
+  std::scoped_lock state_guard(*read_state_mutex_);
   read_set_.insert(rp);
   return true;
 }
 
+void Transaction::NoteTableWrite(std::string_view table) {
+  assert(!IsFinished());
+  written_tables_.emplace(table);
+}
+
 bool Transaction::AddWriteSet(const RowPosition& rp) {
   assert(!IsFinished());
   if (read_only_) return false;
@@ -92,7 +98,7 @@ StatusOr<std::string_view> Transaction::ReadVersion(
     const RowPosition& rp, std::optional<std::string_view> physical) {
   assert(!IsFinished());
   std::scoped_lock state_guard(*read_state_mutex_);
-  AddReadSet(rp);
+  read_set_.insert(rp);
   if (!transaction_manager_) {
     if (!physical) return Status::kNotExists;
     return *physical;
@@ -100,24 +106,30 @@ StatusOr<std::string_view> Transaction::ReadVersion(
   StatusOr<std::string> visible =
       transaction_manager_->ReadVersion(*this, rp, physical);
   if (!visible.HasValue()) return visible.GetStatus();
+  auto& cache = version_read_cache_[std::this_thread::get_id()];
   auto [iter, inserted] =
-      version_read_cache_.insert_or_assign(rp, std::move(visible.Value()));
+      cache.insert_or_assign(rp, std::move(visible.Value()));
   constexpr size_t kMaxVersionReadCache = 4096;
-  if (version_read_cache_.size() > kMaxVersionReadCache) {
+  if (cache.size() > kMaxVersionReadCache) {
     std::string keep = std::move(iter->second);
-    version_read_cache_.clear();
-    iter = version_read_cache_.insert_or_assign(rp, std::move(keep)).first;
+    cache.clear();
+    iter = cache.insert_or_assign(rp, std::move(keep)).first;
   }
   return std::string_view(iter->second);
 }
 
+void Transaction::ForgetThreadReadCache() {
+  std::scoped_lock state_guard(*read_state_mutex_);
+  version_read_cache_.erase(std::this_thread::get_id());
+}
+
 void Transaction::RegisterVersionWrite(const RowPosition& rp,
                                        std::optional<std::string_view> before,
                                        std::optional<std::string_view> after) {
   std::scoped_lock state_guard(*read_state_mutex_);
   if (!transaction_manager_) return;
   transaction_manager_->RegisterVersionWrite(*this, rp, before, after);
-  version_read_cache_.erase(rp);
+  for (auto& [thread, cache] : version_read_cache_) cache.erase(rp);
 }
 
 bool Transaction::RequiresHistoricalRead() const {
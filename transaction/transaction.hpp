@@ -22,6 +22,7 @@
 #include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -63,6 +64,7 @@ class Transaction final {
     read_set_ = std::move(o.read_set_);
     write_set_ = std::move(o.write_set_);
     version_read_cache_ = std::move(o.version_read_cache_);
+    written_tables_ = std::move(o.written_tables_);
     prev_lsn_ = o.prev_lsn_;
     status_ = o.status_;
     transaction_manager_ = o.transaction_manager_;
@@ -82,6 +84,9 @@ class Transaction final {
   bool AddWriteSet(const RowPosition& rp);
   StatusOr<std::string_view> ReadVersion(
       const RowPosition& rp, std::optional<std::string_view> physical);
+  // Drops the row images ReadVersion kept for the calling thread. Scan
+  // workers call it before exiting so their entries do not outlive them.
+  void ForgetThreadReadCache();
   void RegisterVersionWrite(const RowPosition& rp,
                             std::optional<std::string_view> before,
                             std::optional<std::string_view> after);
@@ -92,6 +97,17 @@ class Transaction final {
   [[nodiscard]] bool IndexKeysMayBeStale() const;
   [[nodiscard]] bool IsReadOnly() const { return read_only_; }
 
+  // Records that this transaction changed `table`; its commit advances the
+  // table's commit timestamp (TransactionManager::TableCommitTimestamps).
+  void NoteTableWrite(std::string_view table);
+  [[nodiscard]] bool WroteTable(std::string_view table) const {
+    return written_tables_.contains(std::string(table));
+  }
+  // Whether this transaction wrote anything it has not committed yet.
+  [[nodiscard]] bool HasWrites() const {
+    return !write_set_.empty() || !written_tables_.empty();
+  }
+
   Status PreCommit();
   void Abort();
 
@@ -131,6 +147,9 @@ class Transaction final {
   PageManager* GetPageManager() {
     return transaction_manager_->GetPageManager();
   }
+  [[nodiscard]] TransactionManager* GetTransactionManager() const {
+    return transaction_manager_;
+  }
   friend std::ostream& operator<<(std::ostream& o, const Transaction& t) {
     o << "Transaction(id=" << t.txn_id_ << ", status=" << t.status_
       << ", prev_lsn=" << t.prev_lsn_ << ", read_set=" << t.read_set_.size()
@@ -150,7 +169,13 @@ class Transaction final {
 
   std::unordered_set<RowPosition> read_set_{};
   std::unordered_set<RowPosition> write_set_{};
-  std::unordered_map<RowPosition, std::string> version_read_cache_{};
+  std::unordered_set<std::string> written_tables_{};
+  // Row images returned by ReadVersion, kept per reading thread: a returned
+  // view stays valid until the same thread reads again, so one scan worker
+  // trimming its cache never frees a row another worker is still decoding.
+  std::unordered_map<std::thread::id,
+                     std::unordered_map<RowPosition, std::string>>
+      version_read_cache_{};
   // A read-only query may hand page morsels to multiple scan workers.  The
   // version cache and read set are transaction-local, so guard them while
   // preserving a single MVCC snapshot across those workers.
@@ -31,10 +31,28 @@
 #include "recovery/log_record.hpp"
 #include "recovery/logger.hpp"
 #include "transaction/lock_manager.hpp"
+#include "transaction/table_write_observer.hpp"
 #include "transaction/transaction.hpp"
 
 namespace tinylamb {
 
+uint64_t TransactionManager::NextInstanceId() {
+  static std::atomic<uint64_t> next_instance{1};
+  return next_instance.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> TransactionManager::TableCommitTimestamps(
+    const std::vector<std::string>& tables) const {
+  std::vector<uint64_t> timestamps;
+  timestamps.reserve(tables.size());
+  std::scoped_lock lk(transaction_table_lock);
+  for (const std::string& table : tables) {
+    const auto found = table_commit_ts_.find(table);
+    timestamps.push_back(found == table_commit_ts_.end() ? 0 : found->second);
+  }
+  return timestamps;
+}
+
 Transaction TransactionManager::Begin(bool read_only) {
   txn_id_t new_txn_id = next_txn_id_.fetch_add(1);
   Transaction new_txn(new_txn_id, this, read_only);
@@ -87,6 +105,10 @@ void TransactionManager::Abort(Transaction& txn) {
     prev = lr.prev_lsn;
   }
   AbortVersions(txn);
+  if (TableWriteObserver* observer = GetTableWriteObserver();
+      observer != nullptr && !txn.written_tables_.empty()) {
+    observer->TransactionFinished(txn, std::nullopt);
+  }
   txn.SetStatus(TransactionStatus::kAborted);
   LogRecord abort_log(txn.prev_lsn_, txn.txn_id_, LogType::kCommit);
   txn.prev_lsn_ = logger_->AddLog(abort_log.Serialize());
@@ -175,6 +197,13 @@ void TransactionManager::CommitVersions(Transaction& txn) {
       std::max(max_committed_begin_ts_.load(std::memory_order_relaxed),
                commit_ts),
       std::memory_order_release);
+  for (const std::string& table : txn.written_tables_) {
+    table_commit_ts_.insert_or_assign(table, commit_ts);
+  }
+  if (TableWriteObserver* observer = GetTableWriteObserver();
+      observer != nullptr && !txn.written_tables_.empty()) {
+    observer->TransactionFinished(txn, commit_ts);
+  }
   for (const RowPosition& rp : txn.write_set_) {
     VersionShard& shard = version_shards_[VersionShardIndex(rp)];
     const auto found = shard.versions.find(rp);
@@ -24,6 +24,8 @@
 #include <optional>
 #include <ostream>
 #include <shared_mutex>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -39,6 +41,7 @@ class Logger;
 class PageManager;
 class Transaction;
 class RecoveryManager;
+class TableWriteObserver;
 enum class TransactionStatus : uint_fast8_t;
 struct FosterPair;
 struct LogRecord;
@@ -48,7 +51,11 @@ class TransactionManager {
  public:
   TransactionManager(LockManager* lm, PageManager* pm, Logger* l,
                      RecoveryManager* r)
-      : lock_manager_(lm), page_manager_(pm), logger_(l), recovery_(r) {}
+      : instance_id_(NextInstanceId()),
+        lock_manager_(lm),
+        page_manager_(pm),
+        logger_(l),
+        recovery_(r) {}
 
   Transaction Begin(bool read_only = false);
 
@@ -89,6 +96,26 @@ class TransactionManager {
   [[nodiscard]] uint64_t CurrentCommitTimestamp() const {
     return commit_timestamp_.load();
   }
+  // ID the next Begin() hands out; every transaction begun earlier has a
+  // smaller one.
+  [[nodiscard]] txn_id_t NextTransactionId() const {
+    return next_txn_id_.load();
+  }
+  // Process-unique identity of this manager, so state keyed by table name
+  // never mixes two databases.
+  [[nodiscard]] uint64_t InstanceId() const { return instance_id_; }
+  // Commit timestamp of the last committed transaction that wrote each of
+  // `tables`; 0 for tables not written since this manager started.
+  [[nodiscard]] std::vector<uint64_t> TableCommitTimestamps(
+      const std::vector<std::string>& tables) const;
+  // Installs the observer of table writes (nullptr removes it). It must
+  // outlive every transaction of this manager.
+  void SetTableWriteObserver(TableWriteObserver* observer) {
+    table_write_observer_.store(observer, std::memory_order_release);
+  }
+  [[nodiscard]] TableWriteObserver* GetTableWriteObserver() const {
+    return table_write_observer_.load(std::memory_order_acquire);
+  }
   StatusOr<std::string> ReadVersion(
       const Transaction& txn, const RowPosition& rp,
       std::optional<std::string_view> physical) const;
@@ -134,6 +161,7 @@ class TransactionManager {
   void AbortVersions(Transaction& txn);
   void ReleaseLocksAndForget(Transaction& txn);
   void GarbageCollectVersions();
+  static uint64_t NextInstanceId();
 
   static constexpr size_t kVersionShardCount = 64;
 
@@ -152,6 +180,10 @@ class TransactionManager {
   std::atomic<int> pending_txn_count_{0};
   mutable std::array<VersionShard, kVersionShardCount> version_shards_;
   std::unordered_map<txn_id_t, uint64_t> active_snapshots_;
+  // Guarded by transaction_table_lock, like the commit timestamp.
+  std::unordered_map<std::string, uint64_t> table_commit_ts_;
+  std::atomic<TableWriteObserver*> table_write_observer_{nullptr};
+  const uint64_t instance_id_;
   LockManager* const lock_manager_;
   PageManager* const page_manager_;
   Logger* const logger_;
@@ -0,0 +1,180 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "type/hyperloglog.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "common/hash.hpp"
+
+namespace tinylamb {
+namespace {
+
+constexpr char kSparseTag = 's';
+constexpr char kDenseTag = 'd';
+
+// sigma(x) = x + sum_{k>=1} x^(2^k) 2^(k-1), Ertl (2017) eq. 15.
+double Sigma(double x) {
+  if (x == 1.0) return std::numeric_limits<double>::infinity();
+  double y = 1.0;
+  double z = x;
+  double previous;
+  do {
+    x *= x;
+    previous = z;
+    z += x * y;
+    y += y;
+  } while (z != previous);
+  return z;
+}
+
+// tau(x) = (1 - x - sum_{k>=1} (1 - x^(2^-k))^2 2^-k) / 3, Ertl (2017)
+// eq. 16.
+double Tau(double x) {
+  if (x == 0.0 || x == 1.0) return 0.0;
+  double y = 1.0;
+  double z = 1.0 - x;
+  double previous;
+  do {
+    x = std::sqrt(x);
+    previous = z;
+    y *= 0.5;
+    z -= (1.0 - x) * (1.0 - x) * y;
+  } while (z != previous);
+  return z / 3.0;
+}
+
+}  // namespace
+
+HyperLogLog::HyperLogLog(int precision) : precision_(precision) {
+  if (precision < kMinPrecision || kMaxPrecision < precision) {
+    throw std::invalid_argument("HyperLogLog precision out of range: " +
+                                std::to_string(precision));
+  }
+}
+
+void HyperLogLog::Add(const Value& value) {
+  if (value.IsNull()) return;
+  Insert(Hash(value));
+}
+
+void HyperLogLog::AddHash(uint64_t hash) { Insert(hash); }
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+  if (other.precision_ != precision_) {
+    throw std::invalid_argument("HyperLogLog precisions differ");
+  }
+  if (other.IsSparse()) {
+    for (uint64_t hash : other.sparse_) Insert(hash);
+    return;
+  }
+  ToDense();
+  for (size_t i = 0; i < registers_.size(); ++i) {
+    registers_[i] = std::max(registers_[i], other.registers_[i]);
+  }
+}
+
+uint64_t HyperLogLog::Estimate() const {
+  if (IsSparse()) {
+    if (sorted_ == sparse_.size()) return sparse_.size();
+    std::vector<uint64_t> hashes = sparse_;
+    std::sort(hashes.begin(), hashes.end());
+    return std::unique(hashes.begin(), hashes.end()) - hashes.begin();
+  }
+  const int q = 64 - precision_;
+  std::vector<uint32_t> histogram(q + 2, 0);
+  for (uint8_t rank : registers_) ++histogram[rank];
+  const auto m = static_cast<double>(RegisterCount());
+  double z = m * Tau(1.0 - histogram[q + 1] / m);
+  for (int k = q; k >= 1; --k) z = 0.5 * (z + histogram[k]);
+  z += m * Sigma(histogram[0] / m);
+  return std::llround(m * m / (2.0 * std::log(2.0) * z));
+}
+
+size_t HyperLogLog::Bytes() const {
+  return registers_.size() + sparse_.capacity() * sizeof(uint64_t);
+}
+
+std::string HyperLogLog::Serialize() const {
+  std::string serialized;
+  serialized.push_back(static_cast<char>(precision_));
+  if (!IsSparse()) {
+    serialized.push_back(kDenseTag);
+    serialized.append(registers_.begin(), registers_.end());
+    return serialized;
+  }
+  std::vector<uint64_t> hashes = sparse_;
+  std::sort(hashes.begin(), hashes.end());
+  hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  serialized.push_back(kSparseTag);
+  serialized.resize(2 + hashes.size() * sizeof(uint64_t));
+  std::memcpy(serialized.data() + 2, hashes.data(),
+              hashes.size() * sizeof(uint64_t));
+  return serialized;
+}
+
+void HyperLogLog::MergeSerialized(std::string_view serialized) {
+  if (serialized.size() < 2 || serialized[0] != precision_) {
+    throw std::invalid_argument("HyperLogLog precisions differ");
+  }
+  const std::string_view payload = serialized.substr(2);
+  if (serialized[1] == kSparseTag &&
+      payload.size() % sizeof(uint64_t) == 0) {
+    for (size_t at = 0; at < payload.size(); at += sizeof(uint64_t)) {
+      uint64_t hash;
+      std::memcpy(&hash, payload.data() + at, sizeof(hash));
+      Insert(hash);
+    }
+    return;
+  }
+  if (serialized[1] != kDenseTag || payload.size() != RegisterCount()) {
+    throw std::invalid_argument("malformed HyperLogLog sketch");
+  }
+  ToDense();
+  for (size_t i = 0; i < registers_.size(); ++i) {
+    registers_[i] =
+        std::max(registers_[i], static_cast<uint8_t>(payload[i]));
+  }
+}
+
+uint64_t HyperLogLog::Hash(const Value& value) {
+  return Fmix64(std::hash<Value>()(value));
+}
+
+void HyperLogLog::Insert(uint64_t hash) {
+  if (IsSparse()) {
+    sparse_.push_back(hash);
+    if (sparse_.size() >= 2 * SparseLimit()) Compact();
+    return;
+  }
+  const size_t index = hash >> (64 - precision_);
+  const uint64_t rest = hash << precision_;
+  const auto rank = static_cast<uint8_t>(
+      rest == 0 ? 64 - precision_ + 1 : std::countl_zero(rest) + 1);
+  registers_[index] = std::max(registers_[index], rank);
+}
+
+void HyperLogLog::Compact() {
+  std::sort(sparse_.begin() + static_cast<ptrdiff_t>(sorted_), sparse_.end());
+  std::inplace_merge(sparse_.begin(),
+                     sparse_.begin() + static_cast<ptrdiff_t>(sorted_),
+                     sparse_.end());
+  sparse_.erase(std::unique(sparse_.begin(), sparse_.end()), sparse_.end());
+  sorted_ = sparse_.size();
+  if (SparseLimit() < sparse_.size()) ToDense();
+}
+
+void HyperLogLog::ToDense() {
+  if (!IsSparse()) return;
+  std::vector<uint64_t> hashes;
+  hashes.swap(sparse_);
+  sorted_ = 0;
+  registers_.assign(RegisterCount(), 0);
+  for (uint64_t hash : hashes) Insert(hash);
+}
+
+}  // namespace tinylamb
@@ -0,0 +1,81 @@
+/** Copyright 2026 KUMAZAKI Hiroki. Licensed under Apache-2.0. */
+#include "type/hyperloglog.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace tinylamb {
+
+TEST(HyperLogLogTest, SmallSketchesCountExactly) {
+  HyperLogLog sketch;
+  EXPECT_EQ(sketch.Estimate(), 0U);
+  sketch.Add(Value());
+  EXPECT_EQ(sketch.Estimate(), 0U);
+  for (int round = 0; round < 3; ++round) {
+    for (int64_t i = 0; i < 500; ++i) sketch.Add(Value(i));
+  }
+  sketch.Add(Value("500"));
+  EXPECT_TRUE(sketch.IsSparse());
+  EXPECT_EQ(sketch.Estimate(), 501U);
+}
+
+TEST(HyperLogLogTest, EstimatesWithinTheStandardError) {
+  for (const int64_t distinct : {2000, 20000, 300000}) {
+    HyperLogLog sketch(12);
+    for (int64_t i = 0; i < distinct; ++i) {
+      sketch.Add(Value(i));
+      if (i % 3 == 0) sketch.Add(Value(i));
+    }
+    EXPECT_FALSE(sketch.IsSparse());
+    EXPECT_EQ(sketch.Bytes(), 4096U);
+    // 1.04 / sqrt(4096) is 1.6%; allow four standard errors.
+    EXPECT_NEAR(static_cast<double>(sketch.Estimate()),
+                static_cast<double>(distinct), 0.065 * distinct)
+        << distinct;
+  }
+}
+
+TEST(HyperLogLogTest, MergeCountsOverlapsOnce) {
+  HyperLogLog low(10);
+  HyperLogLog high(10);
+  HyperLogLog few(10);
+  for (int64_t i = 0; i < 60000; ++i) low.Add(Value(i));
+  for (int64_t i = 30000; i < 90000; ++i) high.Add(Value(i));
+  for (int64_t i = 0; i < 10; ++i) few.Add(Value(1000000 + i));
+
+  HyperLogLog whole(10);
+  for (int64_t i = 0; i < 90000; ++i) whole.Add(Value(i));
+  for (int64_t i = 0; i < 10; ++i) whole.Add(Value(1000000 + i));
+  low.Merge(high);
+  low.Merge(few);
+  // Register-wise maxima are exactly the sketch of the union.
+  EXPECT_EQ(low.Serialize(), whole.Serialize());
+
+  HyperLogLog other(12);
+  EXPECT_THROW(low.Merge(other), std::invalid_argument);
+  EXPECT_THROW(HyperLogLog(3), std::invalid_argument);
+}
+
+TEST(HyperLogLogTest, SerializedSketchesMerge) {
+  HyperLogLog sparse;
+  HyperLogLog dense;
+  for (int64_t i = 0; i < 100; ++i) sparse.Add(Value("s" + std::to_string(i)));
+  for (int64_t i = 0; i < 50000; ++i) dense.Add(Value(i * 0.5));
+
+  HyperLogLog restored;
+  restored.MergeSerialized(sparse.Serialize());
+  EXPECT_TRUE(restored.IsSparse());
+  EXPECT_EQ(restored.Estimate(), 100U);
+  restored.MergeSerialized(dense.Serialize());
+  dense.Merge(sparse);
+  EXPECT_EQ(restored.Estimate(), dense.Estimate());
+
+  EXPECT_THROW(restored.MergeSerialized("x"), std::invalid_argument);
+  EXPECT_THROW(restored.MergeSerialized(HyperLogLog(8).Serialize()),
+               std::invalid_argument);
+}
+
+}  // namespace tinylamb
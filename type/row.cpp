@@ -158,6 +158,37 @@ std::optional<int64_t> Row::TryPeekInteger(const char* src, const Schema& sc,
   return std::nullopt;
 }
 
+bool Row::PeekColumns(const char* src, const Schema& sc,
+                      const std::vector<slot_t>& columns, Value* out) {
+  constexpr slot_t kNullBitmapFlag = slot_t{1} << 15;
+  slot_t encoded_count;
+  src += DeserializeSlot(src, &encoded_count);
+  const bool has_null = (encoded_count & kNullBitmapFlag) != 0;
+  const slot_t count = encoded_count & ~kNullBitmapFlag;
+  slot_t last = 0;
+  for (slot_t column : columns) {
+    if (column >= count) return false;
+    last = std::max(last, column);
+  }
+  const char* bitmap = nullptr;
+  if (has_null) {
+    bitmap = src;
+    src += (count + 7) / 8;
+  }
+  for (slot_t i = 0; i <= last; ++i) {
+    const bool is_null =
+        has_null && (bitmap[i / 8] & static_cast<char>(1U << (i % 8))) != 0;
+    const ValueType type = sc.GetColumn(i).Type();
+    for (size_t k = 0; k < columns.size(); ++k) {
+      if (columns[k] != i) continue;
+      out[k] = Value();
+      if (!is_null) out[k].Deserialize(src, type);
+    }
+    if (!is_null) src += Value::SkipSerialized(src, type);
+  }
+  return true;
+}
+
 size_t Row::Size() const {
   const bool has_null =
       std::any_of(values_.begin(), values_.end(),
@@ -201,6 +232,13 @@ Row Row::Extract(const std::vector<slot_t>& elms) const {
   return Row(extracted);
 }
 
+bool Row::AnyNull(const std::vector<slot_t>& columns) const {
+  for (const slot_t column : columns) {
+    if (values_[column].IsNull()) return true;
+  }
+  return false;
+}
+
 Row Row::operator+(const Row& rhs) const {
   std::vector v(values_);
   v.reserve(v.size() + rhs.Size());
@@ -46,12 +46,20 @@ struct Row {
   // Read a single INT64/DATE column without materializing other values.
   [[nodiscard]] static std::optional<int64_t> TryPeekInteger(
       const char* src, const Schema& sc, slot_t column);
+  // Read `columns` into `out` (one Value per column, NULL as Value()) without
+  // materializing other values. VARCHAR values view `src`. Returns false if
+  // a column is past the end of the row.
+  static bool PeekColumns(const char* src, const Schema& sc,
+                          const std::vector<slot_t>& columns, Value* out);
   [[nodiscard]] size_t Size() const;
   [[nodiscard]] std::string EncodeMemcomparableFormat() const;
   void DecodeMemcomparableFormat(std::string_view src);
   void Clear() { values_.clear(); }
   [[nodiscard]] bool IsValid() const { return !values_.empty(); }
   [[nodiscard]] Row Extract(const std::vector<slot_t>& elms) const;
+  // Whether any of `columns` holds NULL, e.g. a join key that matches
+  // nothing.
+  [[nodiscard]] bool AnyNull(const std::vector<slot_t>& columns) const;
   Row operator+(const Row& rhs) const;
 
   bool operator==(const Row& rhs) const = default;
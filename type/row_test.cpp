@@ -97,4 +97,11 @@ TEST(RowTest, SerializeRoundTripPreservesDateAndBinaryText) {
   EXPECT_TRUE(restored[4].IsNull());
 }
 
+TEST(RowTest, AnyNullLooksOnlyAtTheGivenColumns) {
+  const Row row({Value(1), Value(), Value("x")});
+  EXPECT_FALSE(row.AnyNull({0, 2}));
+  EXPECT_TRUE(row.AnyNull({2, 1}));
+  EXPECT_FALSE(row.AnyNull({}));
+}
+
 }  // namespace tinylamb
@@ -54,6 +54,8 @@ std::string ToString(AggregationType type) {
       return "MIN";
     case AggregationType::kMax:
       return "MAX";
+    case AggregationType::kApproxCountDistinct:
+      return "APPROX_COUNT_DISTINCT";
     default:
       return "UNKNOWN";
   }
@@ -39,6 +39,8 @@ enum class AggregationType : int {
   kAvg,
   kMin,
   kMax,
+  // HyperLogLog estimate of COUNT(DISTINCT ...).
+  kApproxCountDistinct,
 };
 
 std::string ToString(AggregationType type);